@@ -269,19 +269,19 @@ at_status_t fCmdBuild_QISEND_WRITE_DATA_BG96(atparser_context_t *p_atp_ctxt,
   /* only for raw command, set parameters */
   if (p_atp_ctxt->current_atcmd.type == ATTYPE_RAW_CMD)
   {
-    if (p_modem_ctxt->SID_ctxt.socketSendData_struct.p_buffer_addr_send != NULL)
-    {
-      uint32_t str_size = p_modem_ctxt->SID_ctxt.socketSendData_struct.buffer_size;
-      (void) memcpy((void *)p_atp_ctxt->current_atcmd.params,
-                    (const CS_CHAR_t *)p_modem_ctxt->SID_ctxt.socketSendData_struct.p_buffer_addr_send,
-                    (size_t) str_size);
+    uint32_t str_size;
 
+    /* gather the data to send directly in the raw command (single buffer or buffers list) */
+    if (atcm_socket_write_send_data(&p_modem_ctxt->SID_ctxt.socketSendData_struct,
+                                    p_atp_ctxt->current_atcmd.params,
+                                    AT_FALSE,
+                                    &str_size) == ATSTATUS_OK)
+    {
       /* set raw command size */
       p_atp_ctxt->current_atcmd.raw_cmd_size = str_size;
     }
     else
     {
-      PRINT_ERR("ERROR, send buffer is a NULL ptr !!!")
       retval = ATSTATUS_ERROR;
     }
   }
@@ -287,6 +287,7 @@ void ATCustom_BG96_init(atparser_context_t *p_atp_ctxt)
   /* ###########################  START CUSTOMIZATION PART  ########################### */
   BG96_ctxt.modem_LUT_size = SIZE_ATCMD_BG96_LUT;
   BG96_ctxt.p_modem_LUT = (const atcustom_LUT_t *)ATCMD_BG96_LUT;
+  atcm_build_LUT_index(&BG96_ctxt);
 
   /* override default termination string for AT command: <CR> */
   (void) sprintf((CRC_CHAR_t *)p_atp_ctxt->endstr, "\r");
@@ -244,6 +244,7 @@ void ATCustom_MONARCH_init(atparser_context_t *p_atp_ctxt)
   /* ###########################  START CUSTOMIZATION PART  ########################### */
   SEQMONARCH_ctxt.modem_LUT_size = SIZE_ATCMD_SEQMONARCH_LUT;
   SEQMONARCH_ctxt.p_modem_LUT = (const atcustom_LUT_t *)ATCMD_SEQMONARCH_LUT;
+  atcm_build_LUT_index(&SEQMONARCH_ctxt);
 
   /* set default termination char for AT command: <CR> */
   (void) sprintf((CRC_CHAR_t *)p_atp_ctxt->endstr, "\r");
@@ -39,6 +39,8 @@ extern "C" {
 /* device specific parameters */
 #define MODEM_MAX_SOCKET_TX_DATA_SIZE   CONFIG_MODEM_MAX_SOCKET_TX_DATA_SIZE
 #define MODEM_MAX_SOCKET_RX_DATA_SIZE   CONFIG_MODEM_MAX_SOCKET_RX_DATA_SIZE
+#define TYPE1SC_MAX_SOCKET_PACKET_SIZE  ((uint32_t)1500U) /* max. packet size accepted by %SOCKETCMD="ALLOCATE" */
+#define TYPE1SC_SOCKETDATA_SEND_OVERHEAD ((uint32_t)80U)  /* %SOCKETDATA="SEND" parameters except HEX data */
 #define TYPE1SC_PING_LENGTH             ((uint16_t)56U)
 #define TYPE1SC_ACTIVATE_PING_REPORT    (1)
 
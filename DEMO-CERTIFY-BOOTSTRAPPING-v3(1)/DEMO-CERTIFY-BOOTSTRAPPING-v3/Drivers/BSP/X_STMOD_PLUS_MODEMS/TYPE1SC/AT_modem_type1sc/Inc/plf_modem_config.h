@@ -45,9 +45,18 @@ extern "C" {
 /* to update when modem socket mode will be implemented */
 #define UDP_SERVICE_SUPPORTED                (1U)
 #define CONFIG_MODEM_UDP_SERVICE_CONNECT_IP  ((uint8_t *)"0.0.0.0")
-#define CONFIG_MODEM_MAX_SOCKET_TX_DATA_SIZE ((uint32_t)710U) /* sendto managed, remote IP/port should be send
-                                                                 IPv6/IPv4: protocol around 80/50 bytes
-                                                                 data send in ASCII format:(1500-80)/2 = 710 */
+#if !defined CONFIG_MODEM_MAX_SOCKET_TX_DATA_SIZE
+#define CONFIG_MODEM_MAX_SOCKET_TX_DATA_SIZE ((uint32_t)1460U) /* sendto managed, remote IP/port should be send
+                                                                  IPv6/IPv4: protocol around 80/50 bytes
+                                                                  data send in ASCII format: 2 digits per byte
+                                                                  1460: one TCP segment (or UDP datagram without
+                                                                  IP fragmentation) on a 1500 bytes MTU,
+                                                                  below the modem packet size (1500)
+                                                                  needs ATCMD_MAX_CMD_SIZE >= (2 * size) + 80 */
+#endif /* !defined CONFIG_MODEM_MAX_SOCKET_TX_DATA_SIZE */
+/* AT command size needed to send CONFIG_MODEM_MAX_SOCKET_TX_DATA_SIZE bytes in HEX format
+   used for ATCMD_MAX_CMD_SIZE with modem sockets (AT parser and AT core command buffers) */
+#define CONFIG_MODEM_MAX_AT_CMD_SIZE ((uint16_t)((2U * CONFIG_MODEM_MAX_SOCKET_TX_DATA_SIZE) + 80U))
 #define CONFIG_MODEM_MAX_SOCKET_RX_DATA_SIZE ((uint32_t)750U) /* receivefrom managed, remote IP/port should be received
                                                                  IPv6/IPv4: protocol around 80/50 bytes
                                                                  data received in ASCII format:(1600-80)/2 = 760 */
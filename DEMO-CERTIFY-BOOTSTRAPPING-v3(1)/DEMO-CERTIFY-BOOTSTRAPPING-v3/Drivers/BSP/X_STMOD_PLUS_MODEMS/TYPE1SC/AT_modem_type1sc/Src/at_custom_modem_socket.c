@@ -83,10 +83,6 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* Private function prototypes -----------------------------------------------*/
-static uint8_t convertToASCII(uint8_t nbr);
-static void convertCharToHEX(uint8_t val, uint8_t *p_msd, uint8_t *p_lsd);
-static at_status_t convertDigitToValue(uint8_t digit, uint8_t *res);
-static at_status_t convertHEXToChar(uint8_t MSD, uint8_t LSD, uint8_t *res);
 
 /* Functions Definition ------------------------------------------------------*/
 
@@ -164,6 +160,11 @@ at_status_t fCmdBuild_SOCKETCMD_ALLOCATE(atparser_context_t *p_atp_ctxt, atcusto
       PRINT_INFO("user cid = %d, PDP modem cid = %d", (uint8_t)p_modem_ctxt->socket_ctxt.socket_info->conf_id,
                  pdp_modem_cid)
 
+      /* <param7> */
+      /* request the biggest packet size allowed by the modem, to send data in as few commands as possible */
+      uint32_t packet_size = (MODEM_MAX_SOCKET_TX_DATA_SIZE > TYPE1SC_MAX_SOCKET_PACKET_SIZE) ?
+                             TYPE1SC_MAX_SOCKET_PACKET_SIZE : MODEM_MAX_SOCKET_TX_DATA_SIZE;
+
       /* <param3> */
       /* set the right string for socket open mode client / server */
       atsocket_servicetype_t service_type_index;
@@ -194,7 +195,7 @@ at_status_t fCmdBuild_SOCKETCMD_ALLOCATE(atparser_context_t *p_atp_ctxt, atcusto
                        type1sc_array_ALLOCATE_service_type[service_type_index],
                        p_modem_ctxt->socket_ctxt.socket_info->ip_addr_value,
                        p_modem_ctxt->socket_ctxt.socket_info->local_port,
-                       CONFIG_MODEM_MAX_SOCKET_TX_DATA_SIZE);
+                       packet_size);
       }
       else
       {
@@ -206,7 +207,7 @@ at_status_t fCmdBuild_SOCKETCMD_ALLOCATE(atparser_context_t *p_atp_ctxt, atcusto
                        p_modem_ctxt->socket_ctxt.socket_info->ip_addr_value,
                        p_modem_ctxt->socket_ctxt.socket_info->remote_port,
                        p_modem_ctxt->socket_ctxt.socket_info->local_port,
-                       CONFIG_MODEM_MAX_SOCKET_TX_DATA_SIZE);
+                       packet_size);
       }
     }
     else
@@ -352,41 +353,30 @@ at_status_t fCmdBuild_SOCKETDATA_SEND(atparser_context_t *p_atp_ctxt, atcustom_m
     * <param4>: string, destination IPv4 or IPv6 address(in quotes) for UDP datagram only
     * <param5>: decimal, destination port number (1-65535) for UDP datagram only
     */
-    if (p_modem_ctxt->SID_ctxt.socketSendData_struct.p_buffer_addr_send != NULL)
+    if ((p_modem_ctxt->SID_ctxt.socketSendData_struct.p_buffer_addr_send != NULL)
+        || (p_modem_ctxt->SID_ctxt.socketSendData_struct.p_iov != NULL))
     {
       uint32_t socketID = atcm_socket_get_modem_cid(p_modem_ctxt,
                                                     p_modem_ctxt->SID_ctxt.socketSendData_struct.socket_handle);
       uint16_t str_size = (uint16_t) p_modem_ctxt->SID_ctxt.socketSendData_struct.buffer_size;
 
-      /* Convert buffer in HEX format */
-
       /* build first part of the command: AT%SOCKETDATA="SEND",<param1>,<param2>," */
       (void) sprintf((CRC_CHAR_t *)p_atp_ctxt->current_atcmd.params, "\"SEND\",%ld,%d,\"",
                      socketID,
                      str_size);
 
-      /* now copy the buffer */
+      /* now convert the buffer (or gather the buffers list) in HEX format directly in the command parameters
+       * (example 'A' is converted to '41')
+       */
       uint16_t cmd_params_size = (uint16_t) strlen((CRC_CHAR_t *)&p_atp_ctxt->current_atcmd.params);
-      for (uint16_t idx = 0U; idx < str_size; idx++)
-      {
-        /* char by char */
-        uint8_t onechar = p_modem_ctxt->SID_ctxt.socketSendData_struct.p_buffer_addr_send[idx];
-        PRINT_DBG("[ %c -> HEX= %2x / DEC= %2d]", onechar, onechar, onechar)
-
-        /* convert this char to its hexadecimal value (example 'A' is converted to '65') - ASCII */
-        uint8_t ms;
-        uint8_t ls;
-        convertCharToHEX(onechar, &ms, &ls);
-        (void) memcpy((void *) &p_atp_ctxt->current_atcmd.params[cmd_params_size + (2U * idx)],
-                      (const CS_CHAR_t *)&ms,
-                      1);
-        (void) memcpy((void *) &p_atp_ctxt->current_atcmd.params[cmd_params_size + (1U + (2U * idx))],
-                      (const CS_CHAR_t *)&ls,
-                      1);
-      }
+      uint32_t hexa_size;
+      (void) atcm_socket_write_send_data(&p_modem_ctxt->SID_ctxt.socketSendData_struct,
+                                         &p_atp_ctxt->current_atcmd.params[cmd_params_size],
+                                         AT_TRUE,
+                                         &hexa_size);
 
       /* Don't use strlen for next instruction due to data buffer */
-      cmd_params_size += (2U * str_size);
+      cmd_params_size += (uint16_t) hexa_size;
 
       /* For UDP socket and if provided
          copy ,<remoteIP>,<remote_port> and close the data string with "  */
@@ -762,29 +752,19 @@ at_action_rsp_t fRspAnalyze_SOCKETDATA(at_context_t *p_at_ctxt, atcustom_modem_c
       /* check that received data size does not exceed client buffer size */
       if (data_size <= p_modem_ctxt->socket_ctxt.socketReceivedata.max_buffer_size)
       {
-        uint16_t idx;
-        for (idx = 0U; ((idx < data_size) && (retval != ATACTION_RSP_ERROR)); idx++)
+        /* convert received buffer from HEX to binary format, directly in client buffer
+        * example: if we receive 48545450, take digits 2 by 2 and convert them
+        *          to their hexa value
+        *           => 48 = 0x48 = H
+        *           => 54 = 0x54 = T
+        *           => 54 = 0x54 = T
+        *           => 50 = 0x50 = P
+        */
+        if (ATutil_convertHexaStringToBuffer(&p_msg_in->buffer[element_infos->str_start_idx + 1U],
+                                             data_size,
+                                             p_modem_ctxt->socket_ctxt.socketReceivedata.p_buffer_addr_rcv) != 0U)
         {
-          /* convert received buffer from HEX to ASCII format
-          * example: if we receive 48545450, take digits 2 by 2 and convert them
-          *          to their hexa value
-          *           => 48 = 0x48 = H
-          *           => 54 = 0x54 = T
-          *           => 54 = 0x54 = T
-          *           => 50 = 0x50 = P
-          */
-          uint8_t conVal;
-          if (convertHEXToChar((uint8_t)p_msg_in->buffer[element_infos->str_start_idx + 1U + (idx * 2U)],
-                               (uint8_t)p_msg_in->buffer[element_infos->str_start_idx + 2U + (idx * 2U)],
-                               &conVal) == ATSTATUS_OK)
-          {
-            /* recopy data to client buffer */
-            p_modem_ctxt->socket_ctxt.socketReceivedata.p_buffer_addr_rcv[idx] = conVal;
-          }
-          else
-          {
-            retval = ATACTION_RSP_ERROR;
-          }
+          retval = ATACTION_RSP_ERROR;
         }
 
         /* finally, update buffer client size */
@@ -1071,111 +1051,6 @@ void clear_ping_resp_struct(atcustom_modem_context_t *p_modem_ctxt)
   /* p_modem_ctxt->persist.ping_resp_urc.index is unchanged */
 }
 
-/* *********************** */
-
-/**
-  * @brief  Convert a number to its ASCII value.
-  * @param  nbr Number to convert.
-  * @retval corresponding ASCII value.
-  */
-static uint8_t convertToASCII(uint8_t nbr)
-{
-  uint8_t ascii;
-
-  if (nbr <= 9U)
-  {
-    ascii = nbr + 48U;
-  }
-  else
-  {
-    ascii = nbr + 87U; /* 87 = 97 -10 (where 97 correspond to 'a') */
-  }
-  return (ascii);
-}
-
-/**
-  * @brief  Convert a character to its HEX value
-  *         for example 'A' is converted to '65' where msd='6' and lsd='5'
-  * @param  val Character to convert.
-  * @param  p_msb ptr to Most significant Digit of HEX value
-  * @param  p_lsb ptr to Less significant Digit of HEX value
-  * @retval none.
-  */
-static void convertCharToHEX(uint8_t val, uint8_t *p_msd, uint8_t *p_lsd)
-{
-  *p_msd = convertToASCII(val / 16U);
-  *p_lsd = convertToASCII(val % 16U);
-}
-
-/**
-  * @brief  Convert an hexa number (from 0 to F) to its ASCII value
-  * @param  digit Value to convert.
-  * @param  p_res ptr to converted value.
-  * @retval at_status_t.
-  */
-static at_status_t convertDigitToValue(uint8_t digit, uint8_t *p_res)
-{
-  at_status_t retval = ATSTATUS_OK;
-
-  if ((digit >= 48U) && (digit <= 57U))
-  {
-    /* 0 to 9 */
-    *p_res = digit - 48U;
-  }
-  else if ((digit >= 97U) && (digit <= 102U))
-  {
-    /* a to f */
-    *p_res = digit - 87U; /* 87 = -97+10 */
-  }
-  else if ((digit >= 65U) && (digit <= 70U))
-  {
-    /* A to F */
-    *p_res = digit - 55U; /* 55 = -65+10*/
-  }
-  else
-  {
-    *p_res = 0;
-    retval = ATSTATUS_ERROR;
-  }
-  return (retval);
-}
-
-/**
-  * @brief  Convert a HEX to its Char value
-  *         for example '65' (where msd='6' and lsd='5') is converted to 'A'
-  * @param  msd Most significant Digit of HEX value .
-  * @param  lsd Less significant Digit of HEX value.
-  * @param  p_conv ptr to converted Character value.
-  * @retval at_status_t.
-  */
-static at_status_t convertHEXToChar(uint8_t msd, uint8_t lsd, uint8_t *p_conv)
-{
-  at_status_t retval = ATSTATUS_OK;
-  uint8_t convMSD;
-  uint8_t convLSD;
-
-  /* convert Most significant digit */
-  if (convertDigitToValue(msd, &convMSD) == ATSTATUS_OK)
-  {
-    /* convert Less significant digit */
-    if (convertDigitToValue(lsd, &convLSD) == ATSTATUS_OK)
-    {
-      /* compute converted char value */
-      *p_conv = (convMSD << 4) + convLSD;
-    }
-    else
-    {
-      retval = ATSTATUS_ERROR;
-    }
-  }
-  else
-  {
-    retval = ATSTATUS_ERROR;
-  }
-  return (retval);
-}
-
-
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
 
 
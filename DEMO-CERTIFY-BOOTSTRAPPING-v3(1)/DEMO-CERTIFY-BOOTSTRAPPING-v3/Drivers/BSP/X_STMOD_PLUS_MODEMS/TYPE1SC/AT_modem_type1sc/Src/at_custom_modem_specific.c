@@ -254,6 +254,7 @@ void ATCustom_TYPE1SC_init(atparser_context_t *p_atp_ctxt)
   /* ###########################  START CUSTOMIZATION PART  ########################### */
   TYPE1SC_ctxt.modem_LUT_size = SIZE_ATCMD_TYPE1SC_LUT;
   TYPE1SC_ctxt.p_modem_LUT = (const atcustom_LUT_t *)ATCMD_TYPE1SC_LUT;
+  atcm_build_LUT_index(&TYPE1SC_ctxt);
 
   /* override default termination string for AT command: <CR> */
   (void) sprintf((CRC_CHAR_t *)p_atp_ctxt->endstr, "\r");
@@ -1155,7 +1156,7 @@ at_status_t ATCustom_TYPE1SC_getCmd(at_context_t *p_at_ctxt, uint32_t *p_ATcmdTi
   {
     if (p_atp_ctxt->step == 0U)
     {
-      /* Check data size to send */
+      /* Check data size to send (data are sent in HEX format: 2 characters per byte) */
       if (TYPE1SC_ctxt.SID_ctxt.socketSendData_struct.buffer_size > MODEM_MAX_SOCKET_TX_DATA_SIZE)
       {
         PRINT_ERR("Data size to send %ld exceed maximum size %ld",
@@ -1164,6 +1165,15 @@ at_status_t ATCustom_TYPE1SC_getCmd(at_context_t *p_at_ctxt, uint32_t *p_ATcmdTi
         atcm_program_NO_MORE_CMD(p_atp_ctxt);
         retval = ATSTATUS_ERROR;
       }
+      else if (((2U * TYPE1SC_ctxt.SID_ctxt.socketSendData_struct.buffer_size) + TYPE1SC_SOCKETDATA_SEND_OVERHEAD)
+               > (uint32_t) ATCMD_MAX_CMD_SIZE)
+      {
+        PRINT_ERR("Data size to send %ld exceed AT command buffer size %d",
+                  TYPE1SC_ctxt.SID_ctxt.socketSendData_struct.buffer_size,
+                  ATCMD_MAX_CMD_SIZE)
+        atcm_program_NO_MORE_CMD(p_atp_ctxt);
+        retval = ATSTATUS_ERROR;
+      }
       else
       {
         atcm_program_AT_CMD(&TYPE1SC_ctxt, p_atp_ctxt, ATTYPE_WRITE_CMD, (CMD_ID_t) CMD_AT_SOCKETDATA_SEND, FINAL_CMD);
@@ -1919,6 +1929,17 @@ at_status_t ATCustom_TYPE1SC_get_rsp(atparser_context_t *p_atp_ctxt, at_buf_t *p
       type1sc_modem_reset(&TYPE1SC_ctxt);
       break;
 
+    case SID_CS_SOCKET_CLOSE:
+      /* socket ID deleted: the modem can give it again to another socket handle,
+      *  URC with this socket ID must not be routed to this socket handle anymore
+      */
+      if (TYPE1SC_ctxt.socket_ctxt.socket_info != NULL)
+      {
+        (void) atcm_socket_set_modem_cid(&TYPE1SC_ctxt, TYPE1SC_ctxt.socket_ctxt.socket_info->socket_handle,
+                                         (uint32_t)UNDEFINED_MODEM_SOCKET_ID);
+      }
+      break;
+
 #if (TYPE1SC_ACTIVATE_PING_REPORT == 1)
     case SID_CS_PING_IP_ADDRESS:
     {
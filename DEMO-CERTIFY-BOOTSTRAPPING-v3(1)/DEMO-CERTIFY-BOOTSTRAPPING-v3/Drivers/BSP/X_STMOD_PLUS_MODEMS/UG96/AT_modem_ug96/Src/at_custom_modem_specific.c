@@ -226,6 +226,7 @@ void ATCustom_UG96_init(atparser_context_t *p_atp_ctxt)
   /* ###########################  START CUSTOMIZATION PART  ########################### */
   UG96_ctxt.modem_LUT_size = SIZE_ATCMD_UG96_LUT;
   UG96_ctxt.p_modem_LUT = (const atcustom_LUT_t *)ATCMD_UG96_LUT;
+  atcm_build_LUT_index(&UG96_ctxt);
 
   /* override default termination string for AT command: <CR> */
   (void) sprintf((CRC_CHAR_t *)p_atp_ctxt->endstr, "\r");
@@ -38,11 +38,17 @@ extern "C" {
 
 /* Define buffers max sizes */
 #define ATCMD_MAX_NAME_SIZE  ((uint16_t) 32U)
+#if !defined ATCMD_MAX_CMD_SIZE
 #if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
+#if defined CONFIG_MODEM_MAX_AT_CMD_SIZE
+#define ATCMD_MAX_CMD_SIZE   CONFIG_MODEM_MAX_AT_CMD_SIZE /* socket data sent in the AT command */
+#else
 #define ATCMD_MAX_CMD_SIZE   ((uint16_t) 1600U)
+#endif /* defined CONFIG_MODEM_MAX_AT_CMD_SIZE */
 #else
 #define ATCMD_MAX_CMD_SIZE   ((uint16_t) 128U)
 #endif /* USE_SOCKETS_TYPE */
+#endif /* !defined ATCMD_MAX_CMD_SIZE */
 
 #define ATCMD_MAX_BUF_SIZE   ((uint16_t) 128U) /* this is the maximum size allowed for p_cmd_in_buf and p_rsp_buf
                                                * which are buffers shared between ATCore and upper layer.
@@ -39,6 +39,11 @@ extern "C" {
 #define MODEM_PDP_MAX_APN_SIZE     ((uint32_t) 64U)
 #define MODEM_MAX_NB_PDP_CTXT      ((uint8_t) CS_PDN_CONFIG_MAX + 1U) /* max. nbr of local PDP context configs */
 
+/* LUT index: hash table used to retrieve a received command in the modem LUT */
+#define ATCM_LUT_INDEX_HASH_SIZE   ((uint16_t) 64U)   /* nbr of hash buckets, must be a power of 2 */
+#define ATCM_LUT_INDEX_MAX_ENTRIES ((uint16_t) 128U)  /* max. nbr of LUT entries which can be indexed */
+#define ATCM_LUT_INDEX_NONE        ((uint8_t) 0xFFU)  /* end of bucket chain */
+
 /* Exported types ------------------------------------------------------------*/
 typedef enum
 {
@@ -282,10 +287,23 @@ typedef struct
 
 } atcustom_SOCKET_context_t;
 
+/* atcustom_LUT_index_t is a hash index of the modem LUT command strings
+*   built once at modem init, used to analyze each received line
+*   entries of a bucket are chained in LUT order (first LUT match wins)
+*/
+typedef struct
+{
+  at_bool_t ready;                                      /* index has been built for current LUT */
+  uint8_t   bucket_head[ATCM_LUT_INDEX_HASH_SIZE];      /* first LUT entry of each bucket */
+  uint8_t   next_entry[ATCM_LUT_INDEX_MAX_ENTRIES];     /* next LUT entry in the same bucket */
+  uint8_t   cmd_str_len[ATCM_LUT_INDEX_MAX_ENTRIES];    /* precomputed strlen of each LUT cmd_str */
+} atcustom_LUT_index_t;
+
 typedef struct
 {
   uint32_t                           modem_LUT_size;
   const struct atcustom_LUT_struct   *p_modem_LUT;
+  atcustom_LUT_index_t               LUT_index;
 
   /* received command syntax analysis: state of automaton which analyzes cmd syntax */
   atcustom_modem_SyntaxAutomatonState_t   state_SyntaxAutomaton;
@@ -371,6 +389,7 @@ void atcm_reset_SID_context(atcustom_SID_context_t *p_sid_ctxt);
 void atcm_reset_CMD_context(atcustom_CMD_context_t *p_cmd_ctxt);
 void atcm_reset_SOCKET_context(atcustom_modem_context_t *p_modem_ctxt);
 
+void atcm_build_LUT_index(atcustom_modem_context_t *p_modem_ctxt);
 at_status_t atcm_searchCmdInLUT(atcustom_modem_context_t *p_modem_ctxt,
                                 const atparser_context_t  *p_atp_ctxt,
                                 const IPC_RxMessage_t *p_msg_in,
@@ -0,0 +1,128 @@
+/**
+  ******************************************************************************
+  * @file    at_recorder.h
+  * @author  artworkTrackingMAP
+  * @brief   Header for at_recorder.c module
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef AT_RECORDER_H
+#define AT_RECORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "plf_config.h"
+
+#if (USE_AT_RECORDER == 1)
+
+#include <stdint.h>
+#include "at_core.h"
+#include "at_parser.h"
+
+/**
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                    ##### How to use AT Recorder module #####
+  ==============================================================================
+
+  When USE_AT_RECORDER == 1, ATCore records each AT command of a transaction:
+    - SID, command id and name, timeout given by the modem (atcm_get_CmdTimeout),
+    - send time, delay of the first response and of the final response,
+    - bytes sent and received, number of responses,
+    - CPU cycles spent in ATParser_parse_rsp() (DWT cycle counter),
+    - outcome: OK, ERROR, TIMEOUT or TEMPO (optional answer not received).
+  The last AT_RECORDER_RECORDS commands are kept in a RAM ring.
+  The responses themselves are kept in a second ring of AT_RECORDER_RSP_BUFFER_SIZE bytes
+  (URC included): the modem simulator replays them to the whole stack on host
+  (IPC_SIM_replay(), see Projects/.../Cellular/Host/Test/test_at_replay.c).
+
+  Command console:
+    atrec dump  : dump the rings - lines starting with "ATREC"
+    atrec clear : empty the rings
+    atrec on|off: start/stop the recording (started at init)
+
+  The dump is decoded on host by Core/AT_Core/Utilities/at_recorder_report.py.
+  Dump lines:
+    ATREC H <format> <core clock Hz> <tick ms> <records> <lost responses>
+    ATREC T <seq> <sid> <cmd id> <name> <timeout> <start> <first> <final> <tx> <rx> <nb rsp>
+            <outcome> <parse cycles> <parse cycles max>
+    ATREC R <seq> <size> <parse cycles> <action>
+    ATREC D <hexadecimal bytes of the last R line - several lines if needed>
+    ATREC E
+  <first> and <final> are delays in ms from <start>, -1 if no response.
+  <seq> of an R line is the T record being processed, -1 for a response received outside.
+
+  @endverbatim
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/* Number of AT commands kept in the ring */
+#if !defined AT_RECORDER_RECORDS
+#define AT_RECORDER_RECORDS          (32U)
+#endif /* !defined AT_RECORDER_RECORDS */
+
+/* Size of the ring of responses - 0U: responses are not kept */
+#if !defined AT_RECORDER_RSP_BUFFER_SIZE
+#define AT_RECORDER_RSP_BUFFER_SIZE  (2048U)
+#endif /* !defined AT_RECORDER_RSP_BUFFER_SIZE */
+
+/* Number of characters of the command name kept in a record */
+#define AT_RECORDER_NAME_SIZE        (12U)
+
+/* Outcome of an AT command */
+#define AT_RECORDER_ONGOING          ((uint8_t)0U) /* no final response yet               */
+#define AT_RECORDER_OK               ((uint8_t)1U) /* final response received             */
+#define AT_RECORDER_ERROR            ((uint8_t)2U) /* error response or error at sending  */
+#define AT_RECORDER_TIMEOUT          ((uint8_t)3U) /* mandatory response not received     */
+#define AT_RECORDER_TEMPO            ((uint8_t)4U) /* optional response not received      */
+
+/* Exported types ------------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+
+/**
+  * @brief  Initialize the recorder and declare its console command
+  * @note   Called by AT_init()
+  */
+void ATRecorder_init(void);
+
+/**
+  * @brief  Dump the rings on the trace output (lines starting with "ATREC")
+  * @note   Called by the "atrec dump" console command
+  */
+void ATRecorder_dump(void);
+
+/*** Internal use only - Not an Application Interface - called by ATCore ******/
+
+/* Start a record: a command is going to be sent (tx_size 0: tempo only) */
+void ATRecorder_cmd_start(at_handle_t athandle, const at_context_t *p_at_ctxt, at_msg_t msg_in_id,
+                          uint32_t timeout, uint16_t tx_size);
+
+/* No response received before timeout for the current record */
+void ATRecorder_cmd_timeout(at_handle_t athandle);
+
+/* End the current record with the action returned by the answer processing */
+void ATRecorder_cmd_end(at_handle_t athandle, at_status_t status, at_action_rsp_t action_rsp);
+
+/* A response has been parsed - to call before IPC_release() */
+void ATRecorder_rsp(at_handle_t athandle, const IPC_RxMessage_t *p_msg, uint32_t parse_cycles,
+                    at_action_rsp_t action);
+
+/* Current value of the cycle counter used to measure the parser */
+uint32_t ATRecorder_get_cycles(void);
+
+#endif /* USE_AT_RECORDER == 1 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AT_RECORDER_H */
+
+/******************************** END OF FILE *********************************/
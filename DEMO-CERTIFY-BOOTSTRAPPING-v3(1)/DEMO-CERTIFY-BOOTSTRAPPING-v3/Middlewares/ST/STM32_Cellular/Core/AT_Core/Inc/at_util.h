@@ -44,6 +44,8 @@ void     ATutil_convertStringToUpperCase(uint8_t *p_string, uint16_t size);
 uint8_t  ATutil_isNegative(const uint8_t *p_string, uint16_t size);
 uint8_t  ATutil_convert_uint8_to_binary_string(uint32_t value, uint8_t nbBits, uint8_t sizeStr, uint8_t *binStr);
 uint16_t ATutil_remove_quotes(const uint8_t *p_Src, uint16_t srcSize, uint8_t *p_Dst, uint16_t dstSize);
+void     ATutil_convertBufferToHexaString(const uint8_t *p_Src, uint16_t srcSize, uint8_t *p_Dst);
+uint8_t  ATutil_convertHexaStringToBuffer(const uint8_t *p_Src, uint16_t dstSize, uint8_t *p_Dst);
 
 #ifdef __cplusplus
 }
@@ -28,6 +28,9 @@
 #include "plf_config.h"
 /* following file added to check SID for DATA suspend/resume cases */
 #include "cellular_service_int.h"
+#if (USE_AT_RECORDER == 1)
+#include "at_recorder.h"
+#endif /* USE_AT_RECORDER == 1 */
 
 /* Private typedef -----------------------------------------------------------*/
 
@@ -35,9 +38,10 @@
 #if (USE_TRACE_ATCORE == 1U)
 #if (USE_PRINTF  == 0U)
 #include "trace_interface.h"
-#define TRACE_INFO(format, args...) TRACE_PRINT(DBG_CHAN_ATCMD, DBL_LVL_P0, "ATCore:" format "\n\r", ## args)
-#define TRACE_DBG(format, args...)  TRACE_PRINT(DBG_CHAN_ATCMD, DBL_LVL_P1, "ATCore:" format "\n\r", ## args)
-#define TRACE_ERR(format, args...)  TRACE_PRINT(DBG_CHAN_ATCMD, DBL_LVL_ERR, "ATCore ERROR:" format "\n\r", ## args)
+/* Tokenized if TRACE_IF_TOKENIZED == 1U: ATCore traces must keep integer arguments only */
+#define TRACE_INFO(format, args...) TRACE_TOKEN(DBG_CHAN_ATCMD, DBL_LVL_P0, "ATCore:" format "\n\r", ## args)
+#define TRACE_DBG(format, args...)  TRACE_TOKEN(DBG_CHAN_ATCMD, DBL_LVL_P1, "ATCore:" format "\n\r", ## args)
+#define TRACE_ERR(format, args...)  TRACE_TOKEN(DBG_CHAN_ATCMD, DBL_LVL_ERR, "ATCore ERROR:" format "\n\r", ## args)
 #else
 #define TRACE_INFO(format, args...)  (void) printf("ATCore:" format "\n\r", ## args);
 #define TRACE_DBG(...)   __NOP(); /* Nothing to do */
@@ -154,6 +158,10 @@ at_status_t  AT_init(void)
       (void) memset((void *)&at_context[idx].parser, 0, sizeof(atparser_context_t));
     }
 
+#if (USE_AT_RECORDER == 1)
+    ATRecorder_init();
+#endif /* USE_AT_RECORDER == 1 */
+
     AT_Core_initialized = 1U;
     retval = ATSTATUS_OK;
   }
@@ -493,6 +501,8 @@ at_status_t  AT_getevent(at_handle_t athandle, at_buf_t *p_rsp_buf)
 
   /* Parse the response */
   action = ATParser_parse_rsp(&at_context[athandle], &msgFromIPC[athandle]);
+  /* message content is not used after parsing: free it in IPC */
+  (void) IPC_release(at_context[athandle].ipc_handle);
 
   TRACE_DBG("RAW ACTION (get_event) = 0x%x", action)
 
@@ -705,6 +715,9 @@ static at_action_rsp_t process_answer(at_handle_t athandle, at_action_send_t act
     if (waitIPCstatus != ATSTATUS_OK)
     {
       (void) IPC_abort(at_context[athandle].ipc_handle);
+#if (USE_AT_RECORDER == 1)
+      ATRecorder_cmd_timeout(athandle);
+#endif /* USE_AT_RECORDER == 1 */
 
       /* No response received before timeout */
       if ((action_send & ATACTION_SEND_WAIT_MANDATORY_RSP) != 0U)
@@ -776,6 +789,8 @@ static at_action_rsp_t process_answer(at_handle_t athandle, at_action_send_t act
       /* Treat the received response */
       /* Parse the response */
       action_rsp = ATParser_parse_rsp(&at_context[athandle], &msgFromIPC[athandle]);
+      /* message content is not used after parsing: free it in IPC */
+      (void) IPC_release(at_context[athandle].ipc_handle);
 
       /* analyze the response (check data mode flag) */
       action_rsp = analyze_action_result(athandle, action_rsp);
@@ -856,6 +871,10 @@ static at_status_t process_AT_transaction(at_handle_t athandle, at_msg_t msg_in_
     }
     else
     {
+#if (USE_AT_RECORDER == 1)
+      ATRecorder_cmd_start(athandle, &at_context[athandle], msg_in_id, at_cmd_timeout, build_atcmd_size);
+#endif /* USE_AT_RECORDER == 1 */
+
       /* Send AT command through IPC if a valid command is available */
       if (build_atcmd_size > 0U)
       {
@@ -901,6 +920,10 @@ static at_status_t process_AT_transaction(at_handle_t athandle, at_msg_t msg_in_
           retval = ATSTATUS_ERROR;
         }
       }
+
+#if (USE_AT_RECORDER == 1)
+      ATRecorder_cmd_end(athandle, retval, action_rsp);
+#endif /* USE_AT_RECORDER == 1 */
     }
 
     /* check if an error occurred */
@@ -1153,6 +1176,9 @@ static void ATCoreTaskBody(void *argument)
   at_action_rsp_t action;
   rtosalStatus status;
   uint32_t msg = 0;
+#if (USE_AT_RECORDER == 1)
+  uint32_t parse_cycles;
+#endif /* USE_AT_RECORDER == 1 */
 
   static at_buf_t urc_buf[ATCMD_MAX_BUF_SIZE]; /* buffer size not optimized yet */
 
@@ -1195,7 +1221,15 @@ static void ATCoreTaskBody(void *argument)
         IRQ_ENABLE();
 
         /* Parse the response */
+#if (USE_AT_RECORDER == 1)
+        parse_cycles = ATRecorder_get_cycles();
+        action = ATParser_parse_rsp(&at_context[athandle], &msgFromIPC[athandle]);
+        ATRecorder_rsp(athandle, &msgFromIPC[athandle], ATRecorder_get_cycles() - parse_cycles, action);
+#else
         action = ATParser_parse_rsp(&at_context[athandle], &msgFromIPC[athandle]);
+#endif /* USE_AT_RECORDER == 1 */
+        /* message content is not used after parsing: free it in IPC */
+        (void) IPC_release(&ipcHandleTab[athandle]);
 
         /* analyze the response (check data mode flag) */
         action = analyze_action_result(athandle, action);
@@ -66,6 +66,7 @@ static void reserve_user_modem_cid(atcustom_persistent_context_t *p_persistent_c
                                    uint8_t reserved_modem_cid);
 static void affect_modem_cid(atcustom_persistent_context_t *p_persistent_ctxt,
                              CS_PDN_conf_id_t conf_id);
+static uint16_t LUT_index_hash(const uint8_t *p_str, uint16_t str_size);
 
 /* Private function Definition -----------------------------------------------*/
 /*
@@ -146,6 +147,21 @@ static void affect_modem_cid(atcustom_persistent_context_t *p_persistent_ctxt, C
   return;
 }
 
+/*
+*  Compute the LUT index bucket of a command string
+*/
+static uint16_t LUT_index_hash(const uint8_t *p_str, uint16_t str_size)
+{
+  /* mix string length and characters (multiplicative hash) */
+  uint32_t hash = (uint32_t) str_size;
+  for (uint16_t i = 0U; i < str_size; i++)
+  {
+    hash = (hash * 31U) + (uint32_t) p_str[i];
+  }
+
+  return ((uint16_t)(hash & ((uint32_t) ATCM_LUT_INDEX_HASH_SIZE - 1U)));
+}
+
 /* Functions Definition ------------------------------------------------------*/
 /**
   * @brief  Put IP Address infos for the selected PDP config
@@ -1709,6 +1725,48 @@ void atcm_reset_SOCKET_context(atcustom_modem_context_t *p_modem_ctxt)
   p_modem_ctxt->socket_ctxt.socket_RxData_state = SocketRxDataState_not_started;
 }
 
+/**
+  * @brief  Build the hash index of the modem LUT command strings.
+  *         Must be called once the modem LUT has been set in the modem context.
+  *         If the LUT is too big to be indexed, atcm_searchCmdInLUT keeps using a linear search.
+  * @param  p_modem_ctxt
+  * @retval none
+  */
+void atcm_build_LUT_index(atcustom_modem_context_t *p_modem_ctxt)
+{
+  atcustom_LUT_index_t *p_index = &p_modem_ctxt->LUT_index;
+
+  p_index->ready = AT_FALSE;
+  (void) memset((void *)p_index->bucket_head, (int32_t) ATCM_LUT_INDEX_NONE, sizeof(p_index->bucket_head));
+
+  if (p_modem_ctxt->modem_LUT_size <= (uint32_t) ATCM_LUT_INDEX_MAX_ENTRIES)
+  {
+    /* insert entries from last to first so that each bucket is chained in LUT order */
+    uint16_t i = (uint16_t) p_modem_ctxt->modem_LUT_size;
+    while (i > 0U)
+    {
+      i--;
+      const AT_CHAR_t *p_cmd_str = (p_modem_ctxt->p_modem_LUT)[i].cmd_str;
+      uint16_t str_size = (uint16_t) strlen((const CRC_CHAR_t *)p_cmd_str);
+      p_index->cmd_str_len[i] = (uint8_t) str_size;
+      p_index->next_entry[i] = ATCM_LUT_INDEX_NONE;
+
+      /* empty strings are never searched */
+      if (str_size > 0U)
+      {
+        uint16_t bucket = LUT_index_hash(p_cmd_str, str_size);
+        p_index->next_entry[i] = p_index->bucket_head[bucket];
+        p_index->bucket_head[bucket] = (uint8_t) i;
+      }
+    }
+    p_index->ready = AT_TRUE;
+  }
+  else
+  {
+    PRINT_ERR("LUT too big to be indexed (%ld entries)", p_modem_ctxt->modem_LUT_size)
+  }
+}
+
 /**
   * @brief  atcm_searchCmdInLUT
   * @param  p_modem_ctxt
@@ -1734,6 +1792,40 @@ at_status_t atcm_searchCmdInLUT(atcustom_modem_context_t *p_modem_ctxt,
     /* null size string */
     retval = ATSTATUS_OK;
   }
+  else if (p_modem_ctxt->LUT_index.ready == AT_TRUE)
+  {
+    /* search in LUT index the ID corresponding to command received */
+    const atcustom_LUT_index_t *p_index = &p_modem_ctxt->LUT_index;
+    const uint8_t *p_str = &(p_msg_in->buffer[element_infos->str_start_idx]);
+    uint8_t entry = ATCM_LUT_INDEX_NONE;
+
+    /* a string longer than LUT cmd_str can not be found: no need to hash it */
+    if (element_infos->str_size < ATCMD_MAX_NAME_SIZE)
+    {
+      entry = p_index->bucket_head[LUT_index_hash(p_str, element_infos->str_size)];
+    }
+
+    /* entries are chained in LUT order: first match is the same as a linear LUT search */
+    while ((entry != ATCM_LUT_INDEX_NONE) && (retval != ATSTATUS_OK))
+    {
+      /* compare strings size first then strings content */
+      if (((uint16_t) p_index->cmd_str_len[entry] == element_infos->str_size) &&
+          (0 == memcmp((const void *) p_str,
+                       (const AT_CHAR_t *)(p_modem_ctxt->p_modem_LUT)[entry].cmd_str,
+                       (size_t) element_infos->str_size)))
+      {
+        PRINT_DBG("we received LUT#%ld : %s \r\n", (p_modem_ctxt->p_modem_LUT)[entry].cmd_id,
+                  (p_modem_ctxt->p_modem_LUT)[entry].cmd_str)
+
+        element_infos->cmd_id_received = (p_modem_ctxt->p_modem_LUT)[entry].cmd_id;
+        retval = ATSTATUS_OK;
+      }
+      else
+      {
+        entry = p_index->next_entry[entry];
+      }
+    }
+  }
   else
   {
     /* search in LUT the ID corresponding to command received */
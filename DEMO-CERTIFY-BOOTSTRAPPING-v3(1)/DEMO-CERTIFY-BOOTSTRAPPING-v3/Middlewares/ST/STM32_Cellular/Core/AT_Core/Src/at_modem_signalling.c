@@ -1210,7 +1210,7 @@ at_status_t fCmdBuild_CPSMS(atparser_context_t *p_atp_ctxt, atcustom_modem_conte
      *   other values shall be interpreted as mutliples of 1 minute
      *
      * exple:
-     * AT+CPSMS=1,,,00000100,00001111
+     * AT+CPSMS=1,,,�00000100�,�00001111�
      * Set the requested T3412 value to 40 minutes, and set the requested T3324 value to 30 seconds
     */
 
@@ -1313,7 +1313,7 @@ at_status_t fCmdBuild_CEDRXS(atparser_context_t *p_atp_ctxt, atcustom_modem_cont
      *                        cf Table 10.5.5.32 from TS 24.008
      *
      * exple:
-     * AT+CEDRX=1,5,0000
+     * AT+CEDRX=1,5,�0000�
      * Set the requested e-I-DRX value to 5.12 second
     */
 
@@ -1621,9 +1621,13 @@ at_action_rsp_t fRspAnalyze_CGMR(at_context_t *p_at_ctxt, atcustom_modem_context
     PRINT_DBG("Revision:")
     PRINT_BUF((const uint8_t *)&p_msg_in->buffer[element_infos->str_start_idx], element_infos->str_size)
 
-    (void) memcpy((void *) & (p_modem_ctxt->SID_ctxt.device_info->u.revision),
-                  (const void *)&p_msg_in->buffer[element_infos->str_start_idx],
-                  (size_t)element_infos->str_size);
+    /* no device_info when the revision is read by the modem init sequence (not a CS_get_device_info request) */
+    if (p_modem_ctxt->SID_ctxt.device_info != NULL)
+    {
+      (void) memcpy((void *) & (p_modem_ctxt->SID_ctxt.device_info->u.revision),
+                    (const void *)&p_msg_in->buffer[element_infos->str_start_idx],
+                    (size_t)element_infos->str_size);
+    }
   }
 
   return (retval);
@@ -372,4 +372,65 @@ at_status_t atcm_socket_set_connected(atcustom_modem_context_t *p_modem_ctxt, so
   return (retval);
 }
 
+/**
+  * @brief  This function writes the data to send (single buffer or gathered buffers) in the AT command,
+  *         in raw format or converted in hexadecimal string (2 characters per byte)
+  * @note   The data are gathered directly from the client buffers: no intermediate copy
+  * @param  p_send_data data to send, received with SID_CS_SEND_DATA
+  * @param  p_dst AT command parameters where the data are written
+  * @param  hexa AT_TRUE to convert data in hexadecimal string
+  * @param  p_size number of characters written in p_dst
+  */
+at_status_t atcm_socket_write_send_data(const csint_socket_data_buffer_t *p_send_data, uint8_t *p_dst,
+                                        at_bool_t hexa, uint32_t *p_size)
+{
+  at_status_t retval = ATSTATUS_OK;
+  uint32_t size = 0U;
+
+  PRINT_API("enter atcm_socket_write_send_data()")
+
+  if (p_send_data->p_buffer_addr_send != NULL)
+  {
+    if (hexa == AT_TRUE)
+    {
+      ATutil_convertBufferToHexaString(p_send_data->p_buffer_addr_send, (uint16_t) p_send_data->buffer_size, p_dst);
+      size = 2U * p_send_data->buffer_size;
+    }
+    else
+    {
+      (void) memcpy((void *)p_dst, (const void *)p_send_data->p_buffer_addr_send, (size_t) p_send_data->buffer_size);
+      size = p_send_data->buffer_size;
+    }
+  }
+  else if ((p_send_data->p_iov != NULL) && (p_send_data->iov_nb <= CS_IOV_MAX))
+  {
+    for (uint8_t i = 0U; i < p_send_data->iov_nb; i++)
+    {
+      uint32_t length = p_send_data->p_iov[i].length;
+      if (length == 0U)
+      {
+        /* empty buffer: nothing to gather */
+      }
+      else if (hexa == AT_TRUE)
+      {
+        ATutil_convertBufferToHexaString(p_send_data->p_iov[i].p_buf, (uint16_t) length, &p_dst[size]);
+        size += 2U * length;
+      }
+      else
+      {
+        (void) memcpy((void *)&p_dst[size], (const void *)p_send_data->p_iov[i].p_buf, (size_t) length);
+        size += length;
+      }
+    }
+  }
+  else
+  {
+    PRINT_ERR("ERROR, send buffer is a NULL ptr !!!")
+    retval = ATSTATUS_ERROR;
+  }
+
+  *p_size = size;
+  return (retval);
+}
+
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
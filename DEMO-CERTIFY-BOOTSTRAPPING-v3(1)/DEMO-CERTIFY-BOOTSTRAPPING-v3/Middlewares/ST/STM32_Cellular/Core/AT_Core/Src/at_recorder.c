@@ -0,0 +1,566 @@
+/**
+  ******************************************************************************
+  * @file    at_recorder.c
+  * @author  artworkTrackingMAP
+  * @brief   Record of the AT transactions timings in RAM
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "plf_config.h"
+
+#if (USE_AT_RECORDER == 1)
+
+#include <stdbool.h>
+#include <string.h>
+#include "at_recorder.h"
+#include "rtosal.h"
+
+#if (USE_CMD_CONSOLE == 1)
+#include "cmd.h"
+#endif /* USE_CMD_CONSOLE == 1 */
+
+#if (RTOS_USED == 0)
+#error "AT recorder needs RTOS_USED == 1"
+#endif /* RTOS_USED == 0 */
+
+/* Private macros ------------------------------------------------------------*/
+#if (USE_PRINTF == 0U)
+#include "trace_interface.h"
+#define PRINT_FORCE(format, args...) \
+  TRACE_PRINT_FORCE(DBG_CHAN_ATCMD, DBL_LVL_P0, "" format "\n\r", ## args)
+#else
+#define PRINT_FORCE(format, args...) (void)printf("" format "\n\r", ## args);
+#endif /* USE_PRINTF  == 0U */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef char ATREC_CHAR_t; /* used in stdio.h and string.h service call */
+
+/* One AT command of a transaction */
+typedef struct
+{
+  uint16_t seq;                               /* sequence number of the record          */
+  at_msg_t sid;                               /* SID of the transaction                 */
+  uint32_t cmd_id;                            /* AT command id                          */
+  uint8_t  name[AT_RECORDER_NAME_SIZE];       /* first characters of the command name   */
+  uint32_t timeout;                           /* timeout of the command in ms           */
+  uint32_t start;                             /* tick before sending the command        */
+  uint32_t first;                             /* delay of the first response            */
+  uint32_t final;                             /* delay of the final response            */
+  uint16_t tx;                                /* bytes sent                             */
+  uint16_t rx;                                /* bytes received                         */
+  uint16_t rsp_nb;                            /* number of responses (URC excluded)     */
+  uint8_t  outcome;                           /* AT_RECORDER_xxx                        */
+  bool     timeout_occurred;                  /* a wait expired before the answer       */
+  uint32_t parse_cycles;                      /* total parser cycles for the responses  */
+  uint32_t parse_cycles_max;                  /* max parser cycles for one response     */
+} at_recorder_record_t;
+
+/* Private defines -----------------------------------------------------------*/
+#define ATREC_FORMAT            (1U)          /* version of the dump format             */
+#define ATREC_NO_DELAY          (0xFFFFFFFFU) /* no response received: dumped as -1     */
+#define ATREC_NO_SEQ            (0xFFFFU)     /* response received outside a record     */
+
+#if (AT_RECORDER_RSP_BUFFER_SIZE != 0U)
+/* Response entry header: seq (2) + size (2) + stored size (2) + action (2) + parse cycles (4) */
+#define ATREC_RSP_HEADER_SIZE   (12U)
+/* A response bigger than a quarter of the ring is truncated */
+#define ATREC_RSP_MAX_STORED    (AT_RECORDER_RSP_BUFFER_SIZE / 4U)
+#endif /* AT_RECORDER_RSP_BUFFER_SIZE != 0U */
+
+/* Number of response bytes per dump line */
+#define ATREC_DUMP_BYTES_PER_LINE  (32U)
+
+/* Private variables ---------------------------------------------------------*/
+static osMutexId ATRecorderMutexHandle = NULL;
+static bool atrec_enabled;
+
+static at_recorder_record_t atrec_records[AT_RECORDER_RECORDS];
+static uint32_t atrec_record_nb;              /* number of records started since clear */
+static at_recorder_record_t *p_atrec_current; /* record of the command in progress     */
+static at_handle_t atrec_current_handle;      /* ATCore handle of this command         */
+
+#if (AT_RECORDER_RSP_BUFFER_SIZE != 0U)
+static uint8_t  atrec_rsp_buffer[AT_RECORDER_RSP_BUFFER_SIZE];
+static uint32_t atrec_rsp_write;              /* offset of the next entry - never wrapped */
+static uint32_t atrec_rsp_oldest;             /* offset of the oldest entry              */
+static uint32_t atrec_rsp_lost;               /* entries overwritten before a dump       */
+#endif /* AT_RECORDER_RSP_BUFFER_SIZE != 0U */
+
+#if (USE_CMD_CONSOLE == 1)
+static uint8_t *atrec_cmd_label = (uint8_t *)"atrec";
+#endif /* USE_CMD_CONSOLE == 1 */
+
+/* Global variables ----------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void atrec_clear(void);
+#if (AT_RECORDER_RSP_BUFFER_SIZE != 0U)
+static void atrec_rsp_copy_in(uint32_t offset, const uint8_t *p_data, uint32_t size);
+static void atrec_rsp_copy_out(uint32_t offset, uint8_t *p_data, uint32_t size);
+static void atrec_rsp_add(uint16_t seq, const IPC_RxMessage_t *p_msg, uint32_t parse_cycles,
+                          at_action_rsp_t action);
+#endif /* AT_RECORDER_RSP_BUFFER_SIZE != 0U */
+#if (USE_CMD_CONSOLE == 1)
+static void atrec_cmd_help(void);
+static cmd_status_t atrec_cmd(uint8_t *cmd_line_p);
+#endif /* USE_CMD_CONSOLE == 1 */
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Empty the rings
+  * @note   Called with the mutex acquired or before the first record
+  * @param  -
+  * @retval -
+  */
+static void atrec_clear(void)
+{
+  atrec_record_nb = 0U;
+  p_atrec_current = NULL;
+  atrec_current_handle = AT_HANDLE_INVALID;
+#if (AT_RECORDER_RSP_BUFFER_SIZE != 0U)
+  atrec_rsp_write = 0U;
+  atrec_rsp_oldest = 0U;
+  atrec_rsp_lost = 0U;
+#endif /* AT_RECORDER_RSP_BUFFER_SIZE != 0U */
+}
+
+#if (AT_RECORDER_RSP_BUFFER_SIZE != 0U)
+/**
+  * @brief  Copy data in the ring of responses
+  * @param  offset - where to copy (wrapped to the ring size)
+  * @param  p_data - data to copy
+  * @param  size   - size of the data
+  * @retval -
+  */
+static void atrec_rsp_copy_in(uint32_t offset, const uint8_t *p_data, uint32_t size)
+{
+  uint32_t index = offset % AT_RECORDER_RSP_BUFFER_SIZE;
+  uint32_t first_part = AT_RECORDER_RSP_BUFFER_SIZE - index;
+
+  if (size <= first_part)
+  {
+    (void)memcpy((void *)&atrec_rsp_buffer[index], (const void *)p_data, size);
+  }
+  else
+  {
+    (void)memcpy((void *)&atrec_rsp_buffer[index], (const void *)p_data, first_part);
+    (void)memcpy((void *)&atrec_rsp_buffer[0], (const void *)&p_data[first_part], size - first_part);
+  }
+}
+
+/**
+  * @brief  Copy data from the ring of responses
+  * @param  offset - where to read (wrapped to the ring size)
+  * @param  p_data - destination
+  * @param  size   - size of the data
+  * @retval -
+  */
+static void atrec_rsp_copy_out(uint32_t offset, uint8_t *p_data, uint32_t size)
+{
+  uint32_t index = offset % AT_RECORDER_RSP_BUFFER_SIZE;
+  uint32_t first_part = AT_RECORDER_RSP_BUFFER_SIZE - index;
+
+  if (size <= first_part)
+  {
+    (void)memcpy((void *)p_data, (const void *)&atrec_rsp_buffer[index], size);
+  }
+  else
+  {
+    (void)memcpy((void *)p_data, (const void *)&atrec_rsp_buffer[index], first_part);
+    (void)memcpy((void *)&p_data[first_part], (const void *)&atrec_rsp_buffer[0], size - first_part);
+  }
+}
+
+/**
+  * @brief  Add a response in the ring - the oldest responses are overwritten if needed
+  * @note   Called with the mutex acquired
+  * @param  seq          - sequence number of the record, ATREC_NO_SEQ if none
+  * @param  p_msg        - response received
+  * @param  parse_cycles - cycles spent in the parser for this response
+  * @param  action       - action returned by the parser
+  * @retval -
+  */
+static void atrec_rsp_add(uint16_t seq, const IPC_RxMessage_t *p_msg, uint32_t parse_cycles,
+                          at_action_rsp_t action)
+{
+  uint8_t header[ATREC_RSP_HEADER_SIZE];
+  uint16_t stored = (p_msg->size > ATREC_RSP_MAX_STORED) ? (uint16_t)ATREC_RSP_MAX_STORED : p_msg->size;
+  uint32_t entry_size = ATREC_RSP_HEADER_SIZE + (uint32_t)stored;
+
+  /* Free the room needed: drop the oldest entries */
+  while ((atrec_rsp_write + entry_size - atrec_rsp_oldest) > AT_RECORDER_RSP_BUFFER_SIZE)
+  {
+    atrec_rsp_copy_out(atrec_rsp_oldest, header, ATREC_RSP_HEADER_SIZE);
+    atrec_rsp_oldest += ATREC_RSP_HEADER_SIZE + ((uint32_t)header[4] | ((uint32_t)header[5] << 8));
+    atrec_rsp_lost++;
+  }
+
+  header[0] = (uint8_t)(seq & 0xFFU);
+  header[1] = (uint8_t)(seq >> 8);
+  header[2] = (uint8_t)(p_msg->size & 0xFFU);
+  header[3] = (uint8_t)(p_msg->size >> 8);
+  header[4] = (uint8_t)(stored & 0xFFU);
+  header[5] = (uint8_t)(stored >> 8);
+  header[6] = (uint8_t)(action & 0xFFU);
+  header[7] = (uint8_t)(action >> 8);
+  header[8] = (uint8_t)(parse_cycles & 0xFFU);
+  header[9] = (uint8_t)((parse_cycles >> 8) & 0xFFU);
+  header[10] = (uint8_t)((parse_cycles >> 16) & 0xFFU);
+  header[11] = (uint8_t)(parse_cycles >> 24);
+
+  atrec_rsp_copy_in(atrec_rsp_write, header, ATREC_RSP_HEADER_SIZE);
+  atrec_rsp_copy_in(atrec_rsp_write + ATREC_RSP_HEADER_SIZE, p_msg->buffer, (uint32_t)stored);
+  atrec_rsp_write += entry_size;
+}
+#endif /* AT_RECORDER_RSP_BUFFER_SIZE != 0U */
+
+#if (USE_CMD_CONSOLE == 1)
+/**
+  * @brief  help cmd management
+  * @param  -
+  * @retval -
+  */
+static void atrec_cmd_help(void)
+{
+  CMD_print_help((uint8_t *)"AT Recorder");
+  PRINT_FORCE("%s dump   : dump the AT commands recorded (decode with at_recorder_report.py)", atrec_cmd_label)
+  PRINT_FORCE("%s clear  : clear the AT commands recorded", atrec_cmd_label)
+  PRINT_FORCE("%s on|off : start/stop the recording", atrec_cmd_label)
+  PRINT_FORCE("%s help   : display this help", atrec_cmd_label)
+}
+
+/**
+  * @brief  cmd management
+  * @param  cmd_line_p - command parameters
+  * @retval cmd_status_t - status of cmd management
+  */
+static cmd_status_t atrec_cmd(uint8_t *cmd_line_p)
+{
+  const uint8_t *cmd_p;
+  const uint8_t *arg_p;
+
+  PRINT_FORCE()
+
+  cmd_p = (uint8_t *)strtok((ATREC_CHAR_t *)cmd_line_p, " \t");
+
+  if (cmd_p != NULL)
+  {
+    if (strncmp((const ATREC_CHAR_t *)cmd_p, (const ATREC_CHAR_t *)atrec_cmd_label,
+                strlen((const ATREC_CHAR_t *)cmd_p)) == 0)
+    {
+      arg_p = (uint8_t *)strtok(NULL, " \t");
+      if (arg_p == NULL)
+      {
+        PRINT_FORCE("ATREC: Missing parameters. Usage:")
+        atrec_cmd_help();
+      }
+      else if (strcmp((const ATREC_CHAR_t *)arg_p, "dump") == 0)
+      {
+        ATRecorder_dump();
+      }
+      else if (strcmp((const ATREC_CHAR_t *)arg_p, "clear") == 0)
+      {
+        (void)rtosalMutexAcquire(ATRecorderMutexHandle, RTOSAL_WAIT_FOREVER);
+        atrec_clear();
+        (void)rtosalMutexRelease(ATRecorderMutexHandle);
+        PRINT_FORCE("ATREC: cleared")
+      }
+      else if (strcmp((const ATREC_CHAR_t *)arg_p, "on") == 0)
+      {
+        atrec_enabled = true;
+        PRINT_FORCE("ATREC: recording on")
+      }
+      else if (strcmp((const ATREC_CHAR_t *)arg_p, "off") == 0)
+      {
+        atrec_enabled = false;
+        PRINT_FORCE("ATREC: recording off")
+      }
+      else if (strcmp((const ATREC_CHAR_t *)arg_p, "help") == 0)
+      {
+        atrec_cmd_help();
+      }
+      else
+      {
+        PRINT_FORCE("ATREC: Unrecognised parameter \"%s\". Usage:", (const ATREC_CHAR_t *)arg_p)
+        atrec_cmd_help();
+      }
+    }
+  }
+
+  return CMD_OK;
+}
+#endif /* USE_CMD_CONSOLE == 1 */
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief  Initialize the recorder and declare its console command
+  * @param  -
+  * @retval -
+  */
+void ATRecorder_init(void)
+{
+  if (ATRecorderMutexHandle == NULL)
+  {
+    ATRecorderMutexHandle = rtosalMutexNew(NULL);
+  }
+  atrec_clear();
+  atrec_enabled = (ATRecorderMutexHandle != NULL);
+
+  /* Cycle counter used to measure the parser - not reset: may be shared */
+  if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0U)
+  {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+
+#if (USE_CMD_CONSOLE == 1)
+  CMD_Declare(atrec_cmd_label, atrec_cmd, (uint8_t *)"AT recorder");
+#endif /* USE_CMD_CONSOLE == 1 */
+}
+
+/**
+  * @brief  Dump the rings in the format read by at_recorder_report.py
+  * @note   Recording is suspended during the dump
+  * @param  -
+  * @retval -
+  */
+void ATRecorder_dump(void)
+{
+  bool enabled = atrec_enabled;
+  uint32_t first_record;
+  const at_recorder_record_t *p_record;
+#if (AT_RECORDER_RSP_BUFFER_SIZE != 0U)
+  static const ATREC_CHAR_t hexa[] = "0123456789abcdef";
+  ATREC_CHAR_t line[(2U * ATREC_DUMP_BYTES_PER_LINE) + 1U];
+  uint8_t header[ATREC_RSP_HEADER_SIZE];
+  uint8_t data[ATREC_DUMP_BYTES_PER_LINE];
+  uint32_t offset;
+  uint32_t stored;
+  uint32_t done;
+  uint32_t len;
+#endif /* AT_RECORDER_RSP_BUFFER_SIZE != 0U */
+
+  /* Suspend the recording then wait the end of an update in progress */
+  atrec_enabled = false;
+  (void)rtosalMutexAcquire(ATRecorderMutexHandle, RTOSAL_WAIT_FOREVER);
+  (void)rtosalMutexRelease(ATRecorderMutexHandle);
+
+  first_record = (atrec_record_nb > AT_RECORDER_RECORDS) ? (atrec_record_nb - AT_RECORDER_RECORDS) : 0U;
+#if (AT_RECORDER_RSP_BUFFER_SIZE != 0U)
+  PRINT_FORCE("ATREC H %u %lu %lu %lu %lu", ATREC_FORMAT, SystemCoreClock, HAL_GetTick(),
+              atrec_record_nb - first_record, atrec_rsp_lost)
+#else
+  PRINT_FORCE("ATREC H %u %lu %lu %lu 0", ATREC_FORMAT, SystemCoreClock, HAL_GetTick(),
+              atrec_record_nb - first_record)
+#endif /* AT_RECORDER_RSP_BUFFER_SIZE != 0U */
+
+  for (uint32_t i = first_record; i < atrec_record_nb; i++)
+  {
+    p_record = &atrec_records[i % AT_RECORDER_RECORDS];
+    PRINT_FORCE("ATREC T %u %u %lu %s %lu %lu %ld %ld %u %u %u %u %lu %lu",
+                p_record->seq, p_record->sid, p_record->cmd_id,
+                (p_record->name[0] != 0U) ? (const ATREC_CHAR_t *)p_record->name : "-",
+                p_record->timeout, p_record->start, (long)(int32_t)p_record->first, (long)(int32_t)p_record->final,
+                p_record->tx, p_record->rx, p_record->rsp_nb, p_record->outcome,
+                p_record->parse_cycles, p_record->parse_cycles_max)
+  }
+
+#if (AT_RECORDER_RSP_BUFFER_SIZE != 0U)
+  offset = atrec_rsp_oldest;
+  while (offset < atrec_rsp_write)
+  {
+    atrec_rsp_copy_out(offset, header, ATREC_RSP_HEADER_SIZE);
+    stored = (uint32_t)header[4] | ((uint32_t)header[5] << 8);
+    PRINT_FORCE("ATREC R %ld %u %lu %u",
+                ((header[0] == 0xFFU) && (header[1] == 0xFFU)) ? (long)(-1)
+                : (long)((uint32_t)header[0] | ((uint32_t)header[1] << 8)),
+                (uint16_t)((uint16_t)header[2] | ((uint16_t)header[3] << 8)),
+                (uint32_t)header[8] | ((uint32_t)header[9] << 8)
+                | ((uint32_t)header[10] << 16) | ((uint32_t)header[11] << 24),
+                (uint16_t)((uint16_t)header[6] | ((uint16_t)header[7] << 8)))
+    offset += ATREC_RSP_HEADER_SIZE;
+
+    for (done = 0U; done < stored; done += len)
+    {
+      len = ((stored - done) > ATREC_DUMP_BYTES_PER_LINE) ? ATREC_DUMP_BYTES_PER_LINE : (stored - done);
+      atrec_rsp_copy_out(offset + done, data, len);
+      for (uint32_t j = 0U; j < len; j++)
+      {
+        line[2U * j] = hexa[data[j] >> 4];
+        line[(2U * j) + 1U] = hexa[data[j] & 0x0FU];
+      }
+      line[2U * len] = (ATREC_CHAR_t)0x00;
+      PRINT_FORCE("ATREC D %s", line)
+    }
+    offset += stored;
+  }
+#endif /* AT_RECORDER_RSP_BUFFER_SIZE != 0U */
+
+  PRINT_FORCE("ATREC E")
+
+  atrec_enabled = enabled;
+}
+
+/**
+  * @brief  Start a record: a command is going to be sent
+  * @param  athandle  - ATCore handle
+  * @param  p_at_ctxt - AT context with the command to send
+  * @param  msg_in_id - SID of the transaction
+  * @param  timeout   - timeout of the command in ms
+  * @param  tx_size   - size of the command, 0 if nothing is sent (tempo only)
+  * @retval -
+  */
+void ATRecorder_cmd_start(at_handle_t athandle, const at_context_t *p_at_ctxt, at_msg_t msg_in_id,
+                          uint32_t timeout, uint16_t tx_size)
+{
+  at_recorder_record_t *p_record;
+  uint8_t i;
+
+  if (atrec_enabled == true)
+  {
+    (void)rtosalMutexAcquire(ATRecorderMutexHandle, RTOSAL_WAIT_FOREVER);
+    p_record = &atrec_records[atrec_record_nb % AT_RECORDER_RECORDS];
+    p_record->seq = (uint16_t)(atrec_record_nb % ATREC_NO_SEQ);
+    p_record->sid = msg_in_id;
+    p_record->cmd_id = p_at_ctxt->parser.current_atcmd.id;
+    /* name is dumped as a single word */
+    for (i = 0U; (i < (AT_RECORDER_NAME_SIZE - 1U)) && (p_at_ctxt->parser.current_atcmd.name[i] != 0U); i++)
+    {
+      p_record->name[i] = (p_at_ctxt->parser.current_atcmd.name[i] == (uint8_t)' ') ?
+                          (uint8_t)'_' : p_at_ctxt->parser.current_atcmd.name[i];
+    }
+    p_record->name[i] = 0U;
+    p_record->timeout = timeout;
+    p_record->start = HAL_GetTick();
+    p_record->first = ATREC_NO_DELAY;
+    p_record->final = ATREC_NO_DELAY;
+    p_record->tx = tx_size;
+    p_record->rx = 0U;
+    p_record->rsp_nb = 0U;
+    p_record->outcome = AT_RECORDER_ONGOING;
+    p_record->timeout_occurred = false;
+    p_record->parse_cycles = 0U;
+    p_record->parse_cycles_max = 0U;
+    p_atrec_current = p_record;
+    atrec_current_handle = athandle;
+    atrec_record_nb++;
+    (void)rtosalMutexRelease(ATRecorderMutexHandle);
+  }
+}
+
+/**
+  * @brief  No response received before timeout for the current record
+  * @param  athandle - ATCore handle
+  * @retval -
+  */
+void ATRecorder_cmd_timeout(at_handle_t athandle)
+{
+  /* p_atrec_current is only set by the thread calling AT_sendcmd: checked again under mutex */
+  if (p_atrec_current != NULL)
+  {
+    (void)rtosalMutexAcquire(ATRecorderMutexHandle, RTOSAL_WAIT_FOREVER);
+    if ((p_atrec_current != NULL) && (atrec_current_handle == athandle))
+    {
+      p_atrec_current->timeout_occurred = true;
+    }
+    (void)rtosalMutexRelease(ATRecorderMutexHandle);
+  }
+}
+
+/**
+  * @brief  End the current record
+  * @param  athandle   - ATCore handle
+  * @param  status     - status of the command sending and answer processing
+  * @param  action_rsp - action returned by the answer processing
+  * @retval -
+  */
+void ATRecorder_cmd_end(at_handle_t athandle, at_status_t status, at_action_rsp_t action_rsp)
+{
+  /* p_atrec_current is only set by the thread calling AT_sendcmd: checked again under mutex */
+  if (p_atrec_current != NULL)
+  {
+    (void)rtosalMutexAcquire(ATRecorderMutexHandle, RTOSAL_WAIT_FOREVER);
+    if ((p_atrec_current != NULL) && (atrec_current_handle == athandle))
+    {
+      if (p_atrec_current->timeout_occurred == true)
+      {
+        p_atrec_current->outcome = (action_rsp == ATACTION_RSP_ERROR) ? AT_RECORDER_TIMEOUT : AT_RECORDER_TEMPO;
+      }
+      else if ((status != ATSTATUS_OK) || (action_rsp == ATACTION_RSP_ERROR))
+      {
+        p_atrec_current->outcome = AT_RECORDER_ERROR;
+      }
+      else
+      {
+        p_atrec_current->outcome = AT_RECORDER_OK;
+      }
+      p_atrec_current = NULL;
+      atrec_current_handle = AT_HANDLE_INVALID;
+    }
+    (void)rtosalMutexRelease(ATRecorderMutexHandle);
+  }
+}
+
+/**
+  * @brief  A response has been parsed
+  * @note   Called before IPC_release(): message content is still valid
+  * @param  athandle     - ATCore handle
+  * @param  p_msg        - response received
+  * @param  parse_cycles - cycles spent in ATParser_parse_rsp() for this response
+  * @param  action       - action returned by the parser
+  * @retval -
+  */
+void ATRecorder_rsp(at_handle_t athandle, const IPC_RxMessage_t *p_msg, uint32_t parse_cycles,
+                    at_action_rsp_t action)
+{
+  at_recorder_record_t *p_record;
+  at_action_rsp_t clean_action = (at_action_rsp_t)(action & ~(at_action_rsp_t)ATACTION_RSP_FLAG_DATA_MODE);
+  uint32_t delay;
+
+  if (atrec_enabled == true)
+  {
+    (void)rtosalMutexAcquire(ATRecorderMutexHandle, RTOSAL_WAIT_FOREVER);
+    p_record = NULL;
+    /* URC are not part of the command */
+    if ((p_atrec_current != NULL) && (atrec_current_handle == athandle)
+        && (clean_action != ATACTION_RSP_URC_FORWARDED) && (clean_action != ATACTION_RSP_URC_IGNORED))
+    {
+      p_record = p_atrec_current;
+      delay = HAL_GetTick() - p_record->start;
+      if (p_record->first == ATREC_NO_DELAY)
+      {
+        p_record->first = delay;
+      }
+      if ((clean_action == ATACTION_RSP_FRC_END) || (clean_action == ATACTION_RSP_FRC_CONTINUE)
+          || (clean_action == ATACTION_RSP_ERROR))
+      {
+        p_record->final = delay;
+      }
+      p_record->rx += p_msg->size;
+      p_record->rsp_nb++;
+      p_record->parse_cycles += parse_cycles;
+      if (parse_cycles > p_record->parse_cycles_max)
+      {
+        p_record->parse_cycles_max = parse_cycles;
+      }
+    }
+#if (AT_RECORDER_RSP_BUFFER_SIZE != 0U)
+    atrec_rsp_add((p_record != NULL) ? p_record->seq : (uint16_t)ATREC_NO_SEQ, p_msg, parse_cycles, action);
+#endif /* AT_RECORDER_RSP_BUFFER_SIZE != 0U */
+    (void)rtosalMutexRelease(ATRecorderMutexHandle);
+  }
+}
+
+/**
+  * @brief  Current value of the cycle counter
+  * @param  -
+  * @retval uint32_t - DWT cycle counter
+  */
+uint32_t ATRecorder_get_cycles(void)
+{
+  return DWT->CYCCNT;
+}
+
+#endif /* USE_AT_RECORDER == 1 */
+
+/******************************** END OF FILE *********************************/
@@ -28,6 +28,34 @@
 #define MAX_64BITS_STRING_SIZE (16U) /* = max string size for a 64bits value (FFFF.FFFF.FFFF.FFFF) */
 /* Private macros ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+/* hexadecimal digits used for encoding (lower case, as expected by the modems) */
+static const uint8_t ATUTIL_HEXA_DIGIT_CHAR[16] =
+{
+  0x30U, 0x31U, 0x32U, 0x33U, 0x34U, 0x35U, 0x36U, 0x37U, 0x38U, 0x39U, /* '0' to '9' */
+  0x61U, 0x62U, 0x63U, 0x64U, 0x65U, 0x66U                              /* 'a' to 'f' */
+};
+
+/* value of each ASCII character as an hexadecimal digit ('0'-'9', 'a'-'f', 'A'-'F'), 0xFF if not a digit */
+static const uint8_t ATUTIL_HEXA_DIGIT_VALUE[256] =
+{
+  0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+  0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU
+};
+
 /* Global variables ----------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 
@@ -344,4 +372,75 @@ uint16_t ATutil_remove_quotes(const uint8_t *p_Src, uint16_t srcSize, uint8_t *p
   return (dest_idx);
 }
 
+/**
+  * @brief  Convert a binary buffer to its HEX string (2 digits per byte, no end string character)
+  *         example: the buffer {0x48, 0x54} is converted to the string 4854
+  *         Bytes are converted by groups of 4 to limit loop overhead.
+  * @param  p_Src ptr to binary buffer to convert.
+  * @param  srcSize size of p_Src buffer.
+  * @param  p_Dst ptr to HEX string (size should be equal or greater than 2 * srcSize).
+  * @retval none.
+  */
+void ATutil_convertBufferToHexaString(const uint8_t *p_Src, uint16_t srcSize, uint8_t *p_Dst)
+{
+  uint16_t src_idx = 0U;
+  uint8_t *p_out = p_Dst;
+
+  /* convert 4 bytes (= 8 digits) at a time */
+  while ((src_idx + 4U) <= srcSize)
+  {
+    uint32_t word = ((uint32_t)p_Src[src_idx] << 24) | ((uint32_t)p_Src[src_idx + 1U] << 16) |
+                    ((uint32_t)p_Src[src_idx + 2U] << 8) | (uint32_t)p_Src[src_idx + 3U];
+    p_out[0] = ATUTIL_HEXA_DIGIT_CHAR[(word >> 28) & 0x0FU];
+    p_out[1] = ATUTIL_HEXA_DIGIT_CHAR[(word >> 24) & 0x0FU];
+    p_out[2] = ATUTIL_HEXA_DIGIT_CHAR[(word >> 20) & 0x0FU];
+    p_out[3] = ATUTIL_HEXA_DIGIT_CHAR[(word >> 16) & 0x0FU];
+    p_out[4] = ATUTIL_HEXA_DIGIT_CHAR[(word >> 12) & 0x0FU];
+    p_out[5] = ATUTIL_HEXA_DIGIT_CHAR[(word >> 8) & 0x0FU];
+    p_out[6] = ATUTIL_HEXA_DIGIT_CHAR[(word >> 4) & 0x0FU];
+    p_out[7] = ATUTIL_HEXA_DIGIT_CHAR[word & 0x0FU];
+    p_out = &p_out[8];
+    src_idx += 4U;
+  }
+
+  /* convert remaining bytes */
+  while (src_idx < srcSize)
+  {
+    p_out[0] = ATUTIL_HEXA_DIGIT_CHAR[p_Src[src_idx] >> 4];
+    p_out[1] = ATUTIL_HEXA_DIGIT_CHAR[p_Src[src_idx] & 0x0FU];
+    p_out = &p_out[2];
+    src_idx++;
+  }
+}
+
+/**
+  * @brief  Convert a HEX string (2 digits per byte, upper or lower case) to a binary buffer
+  *         example: the string 4854 is converted to the buffer {0x48, 0x54}
+  * @param  p_Src ptr to HEX string to convert.
+  * @param  dstSize number of bytes to decode (p_Src must contain at least 2 * dstSize digits).
+  * @param  p_Dst ptr to binary buffer (size should be equal or greater than dstSize).
+  * @retval 0 if no error, 1 if a non-hexadecimal digit has been found.
+  */
+uint8_t ATutil_convertHexaStringToBuffer(const uint8_t *p_Src, uint16_t dstSize, uint8_t *p_Dst)
+{
+  uint8_t retval = 0U;
+  uint8_t invalid = 0U;
+
+  for (uint16_t idx = 0U; idx < dstSize; idx++)
+  {
+    uint8_t msd = ATUTIL_HEXA_DIGIT_VALUE[p_Src[2U * idx]];
+    uint8_t lsd = ATUTIL_HEXA_DIGIT_VALUE[p_Src[(2U * idx) + 1U]];
+    /* invalid digits (0xFF) are detected once at the end of the loop */
+    invalid |= (msd | lsd);
+    p_Dst[idx] = (uint8_t)((uint8_t)(msd << 4) | (lsd & 0x0FU));
+  }
+
+  if ((invalid & 0xF0U) != 0U)
+  {
+    retval = 1U;
+  }
+
+  return (retval);
+}
+
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""Report the AT commands timings recorded by at_recorder (USE_AT_RECORDER == 1).
+
+The input is a console log containing the output of the "atrec dump" command.
+Per command name, the report gives the delay of the final response compared
+to the timeout of the command, and the CPU time spent in ATParser_parse_rsp().
+
+The recorded responses can be extracted in a session file to replay them:
+  each response is: seq (int16), size (uint16), action (uint16), parse cycles
+  (uint32), stored size (uint16), then the stored bytes - all little endian.
+
+Examples:
+  at_recorder_report.py console.log
+  at_recorder_report.py --sort parse --top 10 console.log
+  at_recorder_report.py --records --session session.bin console.log
+"""
+
+import argparse
+import struct
+import sys
+
+DUMP_FORMAT = 1             # ATREC_FORMAT
+OUTCOMES = {0: "ONGOING", 1: "OK", 2: "ERROR", 3: "TIMEOUT", 4: "TEMPO"}
+
+
+class Record:
+    """One AT command recorded (ATREC T line)."""
+
+    def __init__(self, fields):
+        (self.seq, self.sid, self.cmd_id) = (int(fields[0]), int(fields[1]), int(fields[2]))
+        self.name = fields[3]
+        (self.timeout, self.start, self.first, self.final, self.tx, self.rx, self.rsp_nb,
+         self.outcome, self.parse_cycles, self.parse_cycles_max) = [int(value) for value in fields[4:14]]
+
+
+class Response:
+    """One response recorded (ATREC R line and its ATREC D lines)."""
+
+    def __init__(self, fields):
+        (self.seq, self.size, self.parse_cycles, self.action) = [int(value) for value in fields[0:4]]
+        self.data = bytearray()
+
+
+def read_dump(stream):
+    """Return (header, records, responses) of the last dump found in the log."""
+    header, records, responses = None, [], []
+    for raw_line in stream:
+        line = raw_line.decode("latin-1") if isinstance(raw_line, bytes) else raw_line
+        position = line.find("ATREC ")
+        if position < 0:
+            continue
+        fields = line[position:].split()
+        if len(fields) < 2:
+            continue
+        kind, fields = fields[1], fields[2:]
+        if kind == "H":
+            # a new dump: keep the last one only
+            header = {"format": int(fields[0]), "clock": int(fields[1]), "tick": int(fields[2]),
+                      "records": int(fields[3]), "lost": int(fields[4])}
+            if header["format"] != DUMP_FORMAT:
+                raise ValueError("dump format %d not supported" % header["format"])
+            records, responses = [], []
+        elif kind == "T" and len(fields) >= 14:
+            records.append(Record(fields))
+        elif kind == "R" and len(fields) >= 4:
+            responses.append(Response(fields))
+        elif kind == "D" and responses and len(fields) >= 1:
+            responses[-1].data += bytes.fromhex(fields[0])
+    if header is None:
+        raise ValueError("no \"atrec dump\" output found")
+    return header, records, responses
+
+
+def cycles_to_us(cycles, clock):
+    """Convert CPU cycles to microseconds."""
+    return (cycles * 1000000.0) / clock if clock else 0.0
+
+
+def report(header, records, sort_key, top, output):
+    """Per command name statistics."""
+    stats = {}
+    for record in records:
+        entry = stats.setdefault(record.name, {"nb": 0, "outcomes": {}, "final_sum": 0, "final_nb": 0,
+                                               "final_max": 0, "timeout": 0, "parse": 0, "parse_max": 0,
+                                               "rsp_nb": 0, "rx": 0})
+        entry["nb"] += 1
+        outcome = OUTCOMES.get(record.outcome, str(record.outcome))
+        entry["outcomes"][outcome] = entry["outcomes"].get(outcome, 0) + 1
+        if record.final >= 0:
+            entry["final_sum"] += record.final
+            entry["final_nb"] += 1
+            entry["final_max"] = max(entry["final_max"], record.final)
+        elif outcome == "TIMEOUT":
+            # the whole timeout has been waited
+            entry["final_max"] = max(entry["final_max"], record.timeout)
+        entry["timeout"] = max(entry["timeout"], record.timeout)
+        entry["parse"] += record.parse_cycles
+        entry["parse_max"] = max(entry["parse_max"], record.parse_cycles_max)
+        entry["rsp_nb"] += record.rsp_nb
+        entry["rx"] += record.rx
+
+    def margin(entry):
+        return (100.0 * entry["final_max"]) / entry["timeout"] if entry["timeout"] else 0.0
+
+    keys = {"latency": lambda name: stats[name]["final_max"],
+            "margin": lambda name: margin(stats[name]),
+            "parse": lambda name: stats[name]["parse_max"],
+            "count": lambda name: stats[name]["nb"]}
+    names = sorted(stats, key=keys[sort_key], reverse=True)
+    if top:
+        names = names[:top]
+
+    output.write("%d commands recorded, %d responses lost, core clock %d Hz\n"
+                 % (len(records), header["lost"], header["clock"]))
+    output.write("%-12s %5s %9s %9s %9s %6s %9s %9s %7s  %s\n"
+                 % ("command", "nb", "avg(ms)", "max(ms)", "tmo(ms)", "max%", "parse(us)", "pmax(us)",
+                    "rx", "outcomes"))
+    for name in names:
+        entry = stats[name]
+        average = entry["final_sum"] / entry["final_nb"] if entry["final_nb"] else -1
+        parse_average = entry["parse"] / entry["rsp_nb"] if entry["rsp_nb"] else 0
+        outcomes = " ".join("%s:%d" % item for item in sorted(entry["outcomes"].items()))
+        output.write("%-12s %5d %9.1f %9d %9d %5.1f%% %9.1f %9.1f %7d  %s\n"
+                     % (name, entry["nb"], average, entry["final_max"], entry["timeout"], margin(entry),
+                        cycles_to_us(parse_average, header["clock"]),
+                        cycles_to_us(entry["parse_max"], header["clock"]), entry["rx"], outcomes))
+
+
+def list_records(header, records, output):
+    """One line per AT command, in order."""
+    for record in records:
+        output.write("%5d t=%8d sid=%4d %-12s tmo=%6d first=%6d final=%6d tx=%4d rx=%5d rsp=%2d "
+                     "parse=%8.1fus %s\n"
+                     % (record.seq, record.start, record.sid, record.name, record.timeout, record.first,
+                        record.final, record.tx, record.rx, record.rsp_nb,
+                        cycles_to_us(record.parse_cycles, header["clock"]),
+                        OUTCOMES.get(record.outcome, str(record.outcome))))
+
+
+def write_session(path, responses):
+    """Write the recorded responses in a binary session file."""
+    with open(path, "wb") as session:
+        for response in responses:
+            session.write(struct.pack("<hHHIH", response.seq, response.size, response.action,
+                                      response.parse_cycles, len(response.data)))
+            session.write(response.data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--sort", choices=("latency", "margin", "parse", "count"), default="latency",
+                        help="sort the commands by max delay, max delay/timeout, max parse time or number")
+    parser.add_argument("--top", type=int, default=0, help="number of commands reported (default: all)")
+    parser.add_argument("--records", action="store_true", help="also list each AT command recorded")
+    parser.add_argument("--session", metavar="FILE", help="write the recorded responses in a session file")
+    parser.add_argument("log", nargs="?", help="console log with the \"atrec dump\" output (default: stdin)")
+    args = parser.parse_args()
+
+    if args.log:
+        with open(args.log, "r", encoding="latin-1") as log:
+            header, records, responses = read_dump(log)
+    else:
+        header, records, responses = read_dump(sys.stdin)
+
+    if args.records:
+        list_records(header, records, sys.stdout)
+    report(header, records, args.sort, args.top, sys.stdout)
+    if args.session:
+        write_session(args.session, responses)
+
+
+if __name__ == "__main__":
+    main()
@@ -46,6 +46,7 @@ extern "C" {
 #define MAX_DIRECT_CMD_SIZE      ((uint16_t)(ATCMD_MAX_BUF_SIZE - 10U))
 
 #define CS_INVALID_SOCKET_HANDLE ((socket_handle_t)-1)
+#define CS_IOV_MAX               (8U)  /* maximum number of buffers gathered by CDS_socket_send_iov */
 
 /* Exported types ------------------------------------------------------------*/
 typedef int32_t socket_handle_t;
@@ -178,6 +179,13 @@ typedef enum
   CS_IPAT_IPV6,          /* IPV6 */
 } CS_IPaddrType_t;
 
+/* One buffer of a gathered send (see CDS_socket_send_iov) */
+typedef struct
+{
+  const CS_CHAR_t *p_buf;
+  uint32_t        length;
+} CS_IOVec_t;
+
 typedef enum
 {
   CS_SOL_IP        = 0,
@@ -464,6 +472,9 @@ CS_Status_t CDS_socket_connect(socket_handle_t sockHandle,
 CS_Status_t CDS_socket_send(socket_handle_t sockHandle,
                             const CS_CHAR_t *p_buf,
                             uint32_t length);
+CS_Status_t CDS_socket_send_iov(socket_handle_t sockHandle,
+                                const CS_IOVec_t *p_iov,
+                                uint8_t iov_nb);
 CS_Status_t CDS_socket_sendto(socket_handle_t sockHandle,
                               const CS_CHAR_t *p_buf,
                               uint32_t length,
@@ -227,6 +227,8 @@ typedef struct
 {
   socket_handle_t  socket_handle;
   const CS_CHAR_t  *p_buffer_addr_send; /* send buffer (const) */
+  const CS_IOVec_t *p_iov;              /* send buffers to gather, used when p_buffer_addr_send is NULL */
+  uint8_t          iov_nb;              /* number of send buffers in p_iov */
   CS_CHAR_t        *p_buffer_addr_rcv;  /* receive buffer */
   uint32_t         buffer_size;         /* real buffer size */
   uint32_t         max_buffer_size;     /* maximum buffer size allowed by client - used on for RX data */
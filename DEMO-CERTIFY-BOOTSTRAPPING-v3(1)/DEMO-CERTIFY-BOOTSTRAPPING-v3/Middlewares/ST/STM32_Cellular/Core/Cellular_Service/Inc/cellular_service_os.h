@@ -31,6 +31,31 @@ extern "C" {
 
 /* Exported constants --------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
+/* AT transaction classes, by decreasing priority.
+   The modem has only one AT channel: each osCDS_xxx / osCS_xxx call is a transaction that waits
+   for the channel. Waiting transactions are served by class priority and in order of arrival
+   inside a class, so the transactions of several sockets are interleaved on the channel.
+   A class is served at most CSOS_BURST_MAX times in a row when a lower priority class waits. */
+typedef enum
+{
+  CSOS_CLASS_DATA    = 0, /* socket data transfer                          */
+  CSOS_CLASS_CONTROL = 1, /* modem, network, PDN and socket management      */
+  CSOS_CLASS_POLLING = 2, /* periodical modem polling (signal quality)      */
+  CSOS_CLASS_NB      = 3
+} csos_class_t;
+
+typedef struct
+{
+  uint32_t transactions;   /* number of transactions requested            */
+  uint32_t waited;         /* number of transactions that had to wait     */
+  uint32_t wait_time_sum;  /* total wait time in ms                       */
+  uint32_t wait_time_max;  /* max wait time in ms                         */
+  uint16_t depth;          /* number of transactions currently waiting    */
+  uint16_t depth_max;      /* max number of transactions waiting          */
+  uint32_t boosts;         /* number of times a waiting transaction raised
+                              the priority of the channel owner           */
+} csos_sched_stat_t;
+
 /* External variables --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
 
@@ -38,9 +63,17 @@ extern "C" {
 /* Cellular Service Library Init */
 CS_Bool_t osCDS_cellular_service_init(void);
 
+/**
+  * @brief  Get the AT transaction scheduler statistics of a class
+  * @param  sched_class - class
+  * @param  p_stat      - statistics of the class
+  * @retval -
+  */
+void osCDS_get_sched_stat(csos_class_t sched_class, csos_sched_stat_t *p_stat);
+
 /**
   * @brief  Read the actual signal quality seen by Modem .
-  * @note   Call CS_get_signal_quality with mutex access protection
+  * @note   Call CS_get_signal_quality through the AT transaction scheduler
   * @param  same parameters as the CS_get_signal_quality function
   * @retval CS_Status_t
   */
@@ -83,7 +116,7 @@ CS_Status_t osCDS_socket_set_callbacks(socket_handle_t sockHandle,
   * @brief  Define configurable options for a created socket.
   * @note   This function is called to configure one parameter at a time.
   *         If a parameter is not configured with this function, a default value will be applied.
-  * @note   Call CDS_socket_set_option with mutex access protection
+  * @note   Call CDS_socket_set_option through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_set_option function
   * @retval CS_Status_t
   */
@@ -96,7 +129,7 @@ CS_Status_t osCDS_socket_set_option(socket_handle_t sockHandle,
   * @brief  Retrieve configurable options for a created socket.
   * @note   This function is called for one parameter at a time.
   * @note   Function not implemented yet
-  * @note   Call CDS_socket_get_option with mutex access protection
+  * @note   Call CDS_socket_get_option through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_get_option function
   * @retval CS_Status_t
   */
@@ -105,7 +138,7 @@ CS_Status_t osCDS_socket_get_option(void);
 /**
   * @brief  Bind the socket to a local port.
   * @note   If this function is not called, default local port value = 0 will be used.
-  * @note   Call CDS_socket_bind with mutex access protection
+  * @note   Call CDS_socket_bind through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_bind function
   * @retval CS_Status_t
   */
@@ -116,7 +149,7 @@ CS_Status_t osCDS_socket_bind(socket_handle_t sockHandle,
   * @brief  Connect to a remote server (for socket client mode).
   * @note   This function is blocking until the connection is setup or when the timeout to wait
   *         for socket connection expires.
-  * @note   Call CDS_socket_connect with mutex access protection
+  * @note   Call CDS_socket_connect through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_connect function
   * @retval CS_Status_t
   */
@@ -128,7 +161,7 @@ CS_Status_t osCDS_socket_connect(socket_handle_t sockHandle,
 /**
   * @brief  Listen to clients (for socket server mode).
   * @note   Function not implemented yet
-  * @note   Call CDS_socket_listen with mutex access protection
+  * @note   Call CDS_socket_listen through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_listen function
   * @retval CS_Status_t
   */
@@ -138,7 +171,7 @@ CS_Status_t osCDS_socket_listen(socket_handle_t sockHandle);
   * @brief  Send data over a socket to a remote server.
   * @note   This function is blocking until the data is transferred or when the
   *         timeout to wait for transmission expires.
-  * @note   Call CDS_socket_send with mutex access protection
+  * @note   Call CDS_socket_send through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_send function
   * @retval CS_Status_t
   */
@@ -146,10 +179,22 @@ CS_Status_t osCDS_socket_send(socket_handle_t sockHandle,
                               const CS_CHAR_t *p_buf,
                               uint32_t length);
 
+/**
+  * @brief  Send data gathered from several buffers over a socket to a remote server.
+  * @note   This function is blocking until the data is transferred or when the
+  *         timeout to wait for transmission expires.
+  * @note   Call CDS_socket_send_iov through the AT transaction scheduler
+  * @param  same parameters as the CDS_socket_send_iov function
+  * @retval CS_Status_t
+  */
+CS_Status_t osCDS_socket_send_iov(socket_handle_t sockHandle,
+                                  const CS_IOVec_t *p_iov,
+                                  uint8_t iov_nb);
+
 /**
   * @brief  Receive data from the connected remote server.
   * @note   This function is blocking until expected data length is received or a receive timeout has expired.
-  * @note   Call CDS_socket_receive with mutex access protection
+  * @note   Call CDS_socket_receive through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_receive function
   * @retval Size of received data (in bytes).
   */
@@ -161,7 +206,7 @@ int32_t osCDS_socket_receive(socket_handle_t sockHandle,
   * @brief  Send data over a socket to a remote server.
   * @note   This function is blocking until the data is transferred or when the
   *         timeout to wait for transmission expires.
-  * @note   Call CDS_socket_sendto with mutex access protection
+  * @note   Call CDS_socket_sendto through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_sendto function
   * @retval CS_Status_t
   */
@@ -175,7 +220,7 @@ CS_Status_t osCDS_socket_sendto(socket_handle_t sockHandle,
 /**
   * @brief  Receive data from the connected remote server.
   * @note   This function is blocking until expected data length is received or a receive timeout has expired.
-  * @note   Call CDS_socket_receivefrom with mutex access protection
+  * @note   Call CDS_socket_receivefrom through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_receivefrom function
   * @retval Size of received data (in bytes).
   */
@@ -192,7 +237,7 @@ CS_Status_t osCDS_socket_cnx_status(socket_handle_t sockHandle,
 /**
   * @brief  Get connection status for a given socket.
   * @note   If a PDN is activated at socket creation, the socket will not be deactivated at socket closure.
-  * @note   Call CDS_socket_cnx_status with mutex access protection
+  * @note   Call CDS_socket_cnx_status through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_cnx_status function
   * @retval CS_Status_t
   */
@@ -204,7 +249,7 @@ CS_Status_t osCDS_socket_close(socket_handle_t sockHandle,
    ========================================================= */
 /**
   * @brief  Read the latest registration state to the Cellular Network.
-  * @note   Call CS_get_net_status with mutex access protection
+  * @note   Call CS_get_net_status through the AT transaction scheduler
   * @param  same parameters as the CS_get_net_status function
   * @retval CS_Status_t
   */
@@ -212,7 +257,7 @@ CS_Status_t osCDS_get_net_status(CS_RegistrationStatus_t *p_reg_status);
 
 /**
   * @brief  Return information related to modem status.
-  * @note   Call CS_get_device_info with mutex access protection
+  * @note   Call CS_get_device_info through the AT transaction scheduler
   * @param  same parameters as the CS_get_device_info function
   * @retval CS_Status_t
   */
@@ -232,7 +277,7 @@ CS_Status_t osCDS_subscribe_net_event(CS_UrcEvent_t event,
 /**
   * @brief  Register to specified modem events.
   * @note   This function should be called once with all requested events.
-  * @note   Call CS_subscribe_modem_event with mutex access protection
+  * @note   Call CS_subscribe_modem_event through the AT transaction scheduler
   * @param  same parameters as the CS_subscribe_modem_event function
   *         change on requested event.
   * @retval CS_Status_t
@@ -242,7 +287,7 @@ CS_Status_t osCDS_subscribe_modem_event(CS_ModemEvent_t events_mask,
 
 /**
   * @brief  Power ON the modem
-  * @note   Call CS_power_on with mutex access protection
+  * @note   Call CS_power_on through the AT transaction scheduler
   * @param  none
   * @retval CS_Status_t
   */
@@ -250,7 +295,7 @@ CS_Status_t osCDS_power_on(void);
 
 /**
   * @brief  Power OFF the modem
-  * @note   Call CS_power_off with mutex access protection
+  * @note   Call CS_power_off through the AT transaction scheduler
   * @param  none
   * @retval CS_Status_t
   */
@@ -258,7 +303,7 @@ CS_Status_t osCDS_power_off(void);
 
 /**
   * @brief  Request to reset the device.
-  * @note   Call CS_reset with mutex access protection
+  * @note   Call CS_reset through the AT transaction scheduler
   * @param  same parameters as the CS_reset function
   * @retval CS_Status_t
   */
@@ -267,7 +312,7 @@ CS_Status_t osCDS_reset(CS_Reset_t rst_type);
 /**
   * @brief  Initialize the service and configures the Modem FW functionalities
   * @note   Used to provide PIN code (if any) and modem function level.
-  * @note   Call CS_init_modem with mutex access protection
+  * @note   Call CS_init_modem through the AT transaction scheduler
   * @param  same parameters as the CS_init_modem function
   * @retval CS_Status_t
   */
@@ -279,7 +324,7 @@ CS_Status_t osCDS_init_modem(CS_ModemInit_t init,
   * @brief  Request the Modem to register to the Cellular Network.
   * @note   This function is used to select the operator. It returns a detailed
   *         network registration status.
-  * @note   Call CS_register_net with mutex access protection
+  * @note   Call CS_register_net through the AT transaction scheduler
   * @param  same parameters as the CS_register_net function
   * @retval CS_Status_t
   */
@@ -288,7 +333,7 @@ CS_Status_t osCDS_register_net(CS_OperatorSelector_t *p_operator,
 
 /**
   * @brief  Request for packet attach status.
-  * @note   Call CDS_socket_set_callbacks with mutex access protection
+  * @note   Call CDS_socket_set_callbacks through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_set_callbacks function
   * @retval CS_Status_t
   */
@@ -296,7 +341,7 @@ CS_Status_t osCDS_get_attach_status(CS_PSattach_t *p_attach);
 
 /**
   * @brief  Request attach to packet domain.
-  * @note   Call CS_attach_PS_domain with mutex access protection
+  * @note   Call CS_attach_PS_domain through the AT transaction scheduler
   * @param  none.
   * @retval CS_Status_t
   */
@@ -308,7 +353,7 @@ CS_Status_t osCDS_define_pdn(CS_PDN_conf_id_t cid,
 
 /**
   * @brief  Define internet data profile for a configuration identifier
-  * @note   Call CS_define_pdn with mutex access protection
+  * @note   Call CS_define_pdn through the AT transaction scheduler
   * @param  same parameters as the CS_define_pdn function
   * @retval CS_Status_t
   */
@@ -318,7 +363,7 @@ CS_Status_t osCDS_register_pdn_event(CS_PDN_conf_id_t cid,
 /**
   * @brief  Select a PDN among of defined configuration identifier(s) as the default.
   * @note   By default, PDN_PREDEF_CONFIG is considered as the default PDN.
-  * @note   Call CS_set_default_pdn with mutex access protection
+  * @note   Call CS_set_default_pdn through the AT transaction scheduler
   * @param  same parameters as the CS_set_default_pdn function
   * @retval CS_Status_t
   */
@@ -328,7 +373,7 @@ CS_Status_t osCDS_set_default_pdn(CS_PDN_conf_id_t cid);
   * @brief  Activates a PDN (Packet Data Network Gateway) allowing communication with internet.
   * @note   This function triggers the allocation of IP public WAN to the device.
   * @note   Only one PDN can be activated at a time.
-  * @note   Call CS_activate_pdn with mutex access protection
+  * @note   Call CS_activate_pdn through the AT transaction scheduler
   * @param  same parameters as the CS_activate_pdn function
   * @retval CS_Status_t
   */
@@ -336,7 +381,7 @@ CS_Status_t osCDS_activate_pdn(CS_PDN_conf_id_t cid);
 
 /**
   * @brief  Request to suspend DATA mode.
-  * @note   Call CS_suspend_data with mutex access protection
+  * @note   Call CS_suspend_data through the AT transaction scheduler
   * @param  none
   * @retval CS_Status_t
   */
@@ -344,7 +389,7 @@ CS_Status_t osCDS_suspend_data(void);
 
 /**
   * @brief  Request to resume DATA mode.
-  * @note   Call CS_resume_data with mutex access protection
+  * @note   Call CS_resume_data through the AT transaction scheduler
   * @param  none
   * @retval CS_Status_t
   */
@@ -353,7 +398,7 @@ CS_Status_t osCDS_resume_data(void);
 /**
   * @brief  DNS request
   * @note   Get IP address of the specified hostname
-  * @note   Call CS_dns_request with mutex access protection
+  * @note   Call CS_dns_request through the AT transaction scheduler
   * @param  same parameters as the CS_dns_request function
   * @retval CS_Status_t
   */
@@ -364,7 +409,7 @@ CS_Status_t osCDS_dns_request(CS_PDN_conf_id_t cid,
 /**
   * @brief  Ping an IP address on the network
   * @note   Usually, the command AT is sent and OK is expected as response
-  * @note   Call CDS_ping with mutex access protection
+  * @note   Call CDS_ping through the AT transaction scheduler
   * @param  same parameters as the CDS_ping function
   * @retval CS_Status_t
   */
@@ -375,7 +420,7 @@ CS_Status_t osCDS_ping(CS_PDN_conf_id_t cid,
 /**
   * @brief  Send a string will which be sended as it is to the modem (termination char will be added automatically)
   * @note   The termination char will be automatically added by the lower layer
-  * @note   Call CS_direct_cmd with mutex access protection
+  * @note   Call CS_direct_cmd through the AT transaction scheduler
   * @param  same parameters as the CS_direct_cmd function
   * @retval CS_Status_t
   */
@@ -384,7 +429,7 @@ CS_Status_t osCDS_direct_cmd(CS_direct_cmd_tx_t *direct_cmd_tx,
 
 /**
   * @brief  Get the IP address allocated to the device for a given PDN.
-  * @note   Call CDS_get_dev_IP_address with mutex access protection
+  * @note   Call CDS_get_dev_IP_address through the AT transaction scheduler
   * @param  same parameters as the osCDS_get_dev_IP_address function
   * @retval CS_Status_t
   */
@@ -395,7 +440,7 @@ CS_Status_t osCDS_get_dev_IP_address(CS_PDN_conf_id_t cid,
 /**
   * @brief  Select SIM slot to use.
   * @note   Only one SIM slot is active at a time.
-  *         Call CS_sim_select with mutex access protection
+  *         Call CS_sim_select through the AT transaction scheduler
   * @param  same parameters as the CS_sim_select function
   * @retval CS_Status_t
   */
@@ -403,7 +448,7 @@ CS_Status_t osCS_sim_select(CS_SimSlot_t simSelected);
 
 /**
   * @brief  Send a SIM generic command to the modem
-  * @note   Call CS_sim_generic_access with mutex access protection
+  * @note   Call CS_sim_generic_access through the AT transaction scheduler
   * @param  sim_generic_access pointer on different buffers:
   *         command to send, response received
   *         size in bytes for all these buffers
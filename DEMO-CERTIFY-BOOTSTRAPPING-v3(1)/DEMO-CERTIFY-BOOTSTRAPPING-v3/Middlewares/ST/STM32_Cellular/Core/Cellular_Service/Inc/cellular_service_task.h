@@ -279,6 +279,7 @@ typedef uint16_t cst_network_status_t;
 
 /* External variables --------------------------------------------------------*/
 extern bool CST_polling_active;            /* modem polling activation flag */
+extern bool CST_signal_quality_urc;        /* modem reports signal quality changes by URC */
 #if (( USE_TRACE_CELLULAR_SERVICE == 1) || ( USE_CMD_CONSOLE == 1 ))
 extern const uint8_t *CST_StateName[CST_MAX_STATE];
 #endif /* (( USE_TRACE_CELLULAR_SERVICE == 1) || ( USE_CMD_CONSOLE == 1 )) */
@@ -640,6 +640,13 @@ CS_Status_t CS_subscribe_net_event(CS_UrcEvent_t event, cellular_urc_callback_t
     {
       retval = CELLULAR_ERROR;
     }
+
+    if ((retval == CELLULAR_ERROR) && (event == CS_URCEVENT_SIGNAL_QUALITY))
+    {
+      /* not supported by the modem (e.g. TYPE1SC): no URC will come, the caller has to poll */
+      urc_signal_quality_callback = NULL;
+      cs_ctxt_urc_subscription.signal_quality = CELLULAR_FALSE;
+    }
   }
 
   if (retval == CELLULAR_ERROR)
@@ -1554,6 +1561,90 @@ CS_Status_t CDS_socket_send(socket_handle_t sockHandle,
   return (retval);
 }
 
+/**
+  * @brief  Send data gathered from several buffers over a socket to a remote server.
+  * @note   This function is blocking until the data is transferred or when the
+  *         timeout to wait for transmission expires.
+  * @note   The buffers are sent as one block: the modem driver gathers them directly
+  *         in the AT command, without intermediate copy.
+  * @param  sockHandle Handle of the socket
+  * @param  p_iov Pointer to the buffers to transfer (must remain valid until the function returns).
+  * @param  iov_nb Number of buffers (1 to CS_IOV_MAX).
+  * @retval CS_Status_t
+  */
+CS_Status_t CDS_socket_send_iov(socket_handle_t sockHandle,
+                                const CS_IOVec_t *p_iov,
+                                uint8_t iov_nb)
+{
+  CS_Status_t retval = CELLULAR_ERROR;
+  uint32_t length = 0U;
+  CS_Bool_t iov_ok = (((p_iov != NULL) && (iov_nb != 0U) && (iov_nb <= CS_IOV_MAX)) ?
+                      CELLULAR_TRUE : CELLULAR_FALSE);
+
+  /* compute total length and check buffers */
+  for (uint8_t i = 0U; (i < iov_nb) && (iov_ok == CELLULAR_TRUE); i++)
+  {
+    if ((p_iov[i].p_buf == NULL) && (p_iov[i].length != 0U))
+    {
+      iov_ok = CELLULAR_FALSE;
+    }
+    else
+    {
+      length += p_iov[i].length;
+    }
+  }
+  PRINT_API("CDS_socket_send_iov (iov@=%p - iov_nb = %d - length = %ld)", p_iov, iov_nb, length)
+
+  if ((iov_ok == CELLULAR_FALSE) || (length == 0U))
+  {
+    PRINT_ERR("<Cellular_Service> invalid buffers")
+  }
+  /* check that size does not exceed maximum buffers size */
+  else if (length > DEFAULT_IP_MAX_PACKET_SIZE)
+  {
+    PRINT_ERR("<Cellular_Service> buffer size %ld exceed maximum value %d",
+              length,
+              DEFAULT_IP_MAX_PACKET_SIZE)
+  }
+  /* check that socket has been allocated */
+  else if (cs_ctxt_sockets_info[sockHandle].state != SOCKETSTATE_CONNECTED)
+  {
+    PRINT_ERR("<Cellular_Service> socket not connected (state=%d) for handle %ld (send)",
+              cs_ctxt_sockets_info[sockHandle].state,
+              sockHandle)
+  }
+  else
+  {
+    csint_socket_data_buffer_t send_data_struct;
+    (void) memset((void *)&send_data_struct, 0, sizeof(csint_socket_data_buffer_t));
+    send_data_struct.socket_handle = sockHandle;
+    /* p_buffer_addr_send already reset: the modem driver gathers p_iov */
+    send_data_struct.p_iov = p_iov;
+    send_data_struct.iov_nb = iov_nb;
+    send_data_struct.buffer_size = length;
+    send_data_struct.max_buffer_size = length;
+    if (DATAPACK_writeStruct(&cmd_buf[0],
+                             (uint16_t) CSMT_SOCKET_DATA_BUFFER,
+                             (uint16_t) sizeof(csint_socket_data_buffer_t),
+                             (void *)&send_data_struct) == DATAPACK_OK)
+    {
+      at_status_t err;
+      err = AT_sendcmd(_Adapter_Handle, (at_msg_t) SID_CS_SEND_DATA, &cmd_buf[0], &rsp_buf[0]);
+      if (err == ATSTATUS_OK)
+      {
+        PRINT_DBG("<Cellular_Service> socket data sent")
+        retval = CELLULAR_OK;
+      }
+    }
+  }
+
+  if (retval == CELLULAR_ERROR)
+  {
+    PRINT_ERR("<Cellular_Service> error when sending data to socket")
+  }
+  return (retval);
+}
+
 /**
   * @brief  Send data over a socket to a remote server.
   * @note   This function is blocking until the data is transferred or when the
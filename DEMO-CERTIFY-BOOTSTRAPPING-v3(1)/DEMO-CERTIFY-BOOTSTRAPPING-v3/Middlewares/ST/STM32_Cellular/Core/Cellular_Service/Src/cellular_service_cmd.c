@@ -210,6 +210,7 @@ static void CST_HelpCmd(void)
   PRINT_FORCE("%s info    (Displays modem information)", CST_cmd_label)
   PRINT_FORCE("%s targetstate [off|sim|full] (set modem state)", CST_cmd_label)
   PRINT_FORCE("%s polling [on|off]  (enable/disable periodical modem polling)", CST_cmd_label)
+  PRINT_FORCE("%s sched  (Displays AT transaction scheduler statistics)", CST_cmd_label)
   PRINT_FORCE("%s cmd  (switch to command mode)", CST_cmd_label)
   PRINT_FORCE("%s data  (switch to data mode)", CST_cmd_label)
   PRINT_FORCE("%s apnconf [<apn> [<cid> [<username> <password>]]]]  (update apn configuration of active sim slot)",
@@ -756,6 +757,28 @@ static cmd_status_t CST_cmd(uint8_t *cmd_line_p)
           CST_HelpCmd();
         }
       }
+      else if (memcmp((CRC_CHAR_t *)argv_p[0], "sched", crs_strlen(argv_p[0])) == 0)
+      {
+        /* 'cst sched' command: displays AT transaction scheduler statistics */
+        static const uint8_t *const CST_SchedClassName_p[CSOS_CLASS_NB] =
+        {
+          ((const uint8_t *)"data"),
+          ((const uint8_t *)"control"),
+          ((const uint8_t *)"polling"),
+        };
+        csos_sched_stat_t sched_stat;
+        uint8_t class_idx;
+
+        PRINT_FORCE("class    transac.   waited  depth  max depth  wait avg(ms)  wait max(ms)   boosts")
+        for (class_idx = 0U; class_idx < (uint8_t)CSOS_CLASS_NB; class_idx++)
+        {
+          osCDS_get_sched_stat((csos_class_t)class_idx, &sched_stat);
+          PRINT_FORCE("%-8s %8ld %8ld %6d %10d %13ld %13ld %8ld", CST_SchedClassName_p[class_idx],
+                      sched_stat.transactions, sched_stat.waited, sched_stat.depth, sched_stat.depth_max,
+                      (sched_stat.waited == 0U) ? 0U : (sched_stat.wait_time_sum / sched_stat.waited),
+                      sched_stat.wait_time_max, sched_stat.boosts)
+        }
+      }
       else
       {
         /* Bad cst command: displays help  */
@@ -18,6 +18,7 @@
   */
 
 /* Includes ------------------------------------------------------------------*/
+#include <string.h>
 #include "rtosal.h"
 #include "error_handler.h"
 #include "cellular_service_task.h"
@@ -25,23 +26,311 @@
 
 
 /* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  osSemaphoreId     sem;    /* transactions of the class wait on it until the channel is handed over */
+  csos_sched_stat_t stat;
+} csos_class_ctx_t;
 
 /* Private defines -----------------------------------------------------------*/
+/* Max consecutive transactions granted to a class while a lower priority class is waiting:
+   avoids starvation of the control and polling transactions by a continuous data transfer */
+#if !defined CSOS_BURST_MAX
+#define CSOS_BURST_MAX (4U)
+#endif /* !defined CSOS_BURST_MAX */
+
+/* Number of thread priority levels (osPriorityIdle to osPriorityRealtime) */
+#define CSOS_PRIORITY_NB ((uint32_t)((int32_t)osPriorityRealtime - (int32_t)osPriorityIdle) + 1U)
 
 /* Private macros ------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
+/* Protects the scheduler state only: held during a few instructions, never during an AT transaction */
 static osMutexId CellularServiceMutexHandle;
 static osMutexId CellularServiceGeneralMutexHandle;
 
+static bool             csos_channel_busy;           /* an AT transaction is on-going */
+static csos_class_ctx_t csos_class[CSOS_CLASS_NB];
+static csos_class_t     csos_burst_class;            /* class of the last transactions granted */
+static uint8_t          csos_burst_count;            /* consecutive transactions granted to csos_burst_class */
+
+/* Priority inheritance: the channel is handed over through semaphores, so the RTOS cannot do it.
+   While a transaction of a higher priority thread waits, the owner runs at this priority */
+static osThreadId       csos_owner;                  /* thread of the on-going transaction, NULL during hand over */
+static osPriority       csos_owner_priority;         /* priority of csos_owner outside the transaction */
+static osPriority       csos_owner_boost;            /* current priority of csos_owner */
+static uint16_t         csos_waiting[CSOS_PRIORITY_NB]; /* transactions waiting by thread priority level */
+
 /* Global variables ----------------------------------------------------------*/
 
 /* Private function prototypes -----------------------------------------------*/
+static csos_class_t csos_next_class(void);
+static void csos_set_burst(csos_class_t sched_class);
+static uint32_t csos_priority_index(osPriority priority);
+static osPriority csos_waiting_priority_max(void);
+static bool csos_boost_owner(osPriority priority);
+static void csos_set_owner(osThreadId thread_id, osPriority priority);
+static void csos_acquire(csos_class_t sched_class);
+static void csos_release(void);
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Select the next class to get the AT channel
+  * @note   Called with CellularServiceMutexHandle acquired
+  * @param  -
+  * @retval csos_class_t - class to serve (CSOS_CLASS_NB if no transaction is waiting)
+  */
+static csos_class_t csos_next_class(void)
+{
+  csos_class_t next = CSOS_CLASS_NB;
+  uint8_t i;
+
+  for (i = 0U; i < (uint8_t)CSOS_CLASS_NB; i++)
+  {
+    if (csos_class[i].stat.depth != 0U)
+    {
+      if (next == CSOS_CLASS_NB)
+      {
+        /* highest priority class waiting */
+        next = (csos_class_t)i;
+      }
+      else if ((next == csos_burst_class) && (csos_burst_count >= CSOS_BURST_MAX))
+      {
+        /* burst max reached: give its turn to a lower priority class */
+        next = (csos_class_t)i;
+        break;
+      }
+      else
+      {
+        /* lower priority class keeps waiting */
+      }
+    }
+  }
+
+  return (next);
+}
+
+/**
+  * @brief  Count the consecutive transactions granted to a class
+  * @note   Called with CellularServiceMutexHandle acquired
+  * @param  sched_class - class granted
+  * @retval -
+  */
+static void csos_set_burst(csos_class_t sched_class)
+{
+  if (sched_class == csos_burst_class)
+  {
+    if (csos_burst_count < CSOS_BURST_MAX)
+    {
+      csos_burst_count++;
+    }
+  }
+  else
+  {
+    csos_burst_class = sched_class;
+    csos_burst_count = 1U;
+  }
+}
+
+/**
+  * @brief  Get the level of a thread priority in csos_waiting
+  * @param  priority - thread priority
+  * @retval uint32_t - index in csos_waiting
+  */
+static uint32_t csos_priority_index(osPriority priority)
+{
+  uint32_t index = 0U;
+
+  if ((int32_t)priority >= (int32_t)osPriorityRealtime)
+  {
+    index = CSOS_PRIORITY_NB - 1U;
+  }
+  else if ((int32_t)priority > (int32_t)osPriorityIdle)
+  {
+    index = (uint32_t)((int32_t)priority - (int32_t)osPriorityIdle);
+  }
+  else
+  {
+    /* lowest level */
+  }
+
+  return (index);
+}
+
+/**
+  * @brief  Get the highest priority of the threads waiting for the AT channel
+  * @note   Called with CellularServiceMutexHandle acquired
+  * @param  -
+  * @retval osPriority - highest priority waiting (osPriorityIdle if no transaction is waiting)
+  */
+static osPriority csos_waiting_priority_max(void)
+{
+  uint32_t index = CSOS_PRIORITY_NB - 1U;
+
+  while ((index > 0U) && (csos_waiting[index] == 0U))
+  {
+    index--;
+  }
+
+  return ((osPriority)((int32_t)osPriorityIdle + (int32_t)index));
+}
+
+/**
+  * @brief  Raise the priority of the AT channel owner
+  * @note   Called with CellularServiceMutexHandle acquired
+  * @param  priority - priority of a waiting transaction
+  * @retval bool - true if the owner priority has been raised
+  */
+static bool csos_boost_owner(osPriority priority)
+{
+  bool boosted = false;
+
+  /* no owner during a hand over: the next owner boosts itself */
+  if ((csos_owner != NULL) && ((int32_t)priority > (int32_t)csos_owner_boost))
+  {
+    if (rtosalThreadSetPriority(csos_owner, priority) == osOK)
+    {
+      csos_owner_boost = priority;
+      boosted = true;
+    }
+  }
+
+  return (boosted);
+}
+
+/**
+  * @brief  Record the thread that got the AT channel
+  * @note   Called with CellularServiceMutexHandle acquired.
+  *         The new owner is raised at once to the highest priority still waiting.
+  * @param  thread_id - thread of the transaction
+  * @param  priority  - thread priority outside the transaction
+  * @retval -
+  */
+static void csos_set_owner(osThreadId thread_id, osPriority priority)
+{
+  csos_owner = thread_id;
+  csos_owner_priority = priority;
+  csos_owner_boost = priority;
+  (void)csos_boost_owner(csos_waiting_priority_max());
+}
+
+/**
+  * @brief  Wait for the AT channel before a transaction
+  * @note   Transactions are served by class priority (data, control then polling),
+  *         in order of arrival inside a class.
+  *         While the transaction waits, the owner of the channel runs at least at the caller priority.
+  * @param  sched_class - class of the transaction
+  * @retval -
+  */
+static void csos_acquire(csos_class_t sched_class)
+{
+  csos_sched_stat_t *p_stat = &csos_class[sched_class].stat;
+  uint32_t start_tick = HAL_GetTick();
+  osThreadId thread_id = rtosalThreadGetId();
+  osPriority priority = rtosalThreadGetPriority(thread_id);
+  uint32_t wait_time;
+  bool wait;
+
+  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  p_stat->transactions++;
+  if (csos_channel_busy == false)
+  {
+    csos_channel_busy = true;
+    csos_set_burst(sched_class);
+    csos_set_owner(thread_id, priority);
+    wait = false;
+  }
+  else
+  {
+    p_stat->depth++;
+    if (p_stat->depth > p_stat->depth_max)
+    {
+      p_stat->depth_max = p_stat->depth;
+    }
+    csos_waiting[csos_priority_index(priority)]++;
+    if (csos_boost_owner(priority) == true)
+    {
+      p_stat->boosts++;
+    }
+    wait = true;
+  }
+  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+
+  if (wait == true)
+  {
+    /* channel is handed over by csos_release() */
+    (void)rtosalSemaphoreAcquire(csos_class[sched_class].sem, RTOSAL_WAIT_FOREVER);
+    wait_time = HAL_GetTick() - start_tick;
+
+    (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+    p_stat->waited++;
+    p_stat->wait_time_sum += wait_time;
+    if (wait_time > p_stat->wait_time_max)
+    {
+      p_stat->wait_time_max = wait_time;
+    }
+    csos_waiting[csos_priority_index(priority)]--;
+    csos_set_owner(thread_id, priority);
+    (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  }
+}
+
+/**
+  * @brief  Release the AT channel at the end of a transaction
+  * @note   The channel is handed over to the next transaction waiting, if any.
+  *         The caller gets back its own priority.
+  * @param  -
+  * @retval -
+  */
+static void csos_release(void)
+{
+  csos_class_t next;
+
+  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  if (csos_owner_boost != csos_owner_priority)
+  {
+    (void)rtosalThreadSetPriority(csos_owner, csos_owner_priority);
+  }
+  csos_owner = NULL;
+  next = csos_next_class();
+  if (next != CSOS_CLASS_NB)
+  {
+    /* channel stays busy: ownership is transferred */
+    csos_class[next].stat.depth--;
+    csos_set_burst(next);
+  }
+  else
+  {
+    csos_channel_busy = false;
+  }
+  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+
+  if (next != CSOS_CLASS_NB)
+  {
+    (void)rtosalSemaphoreRelease(csos_class[next].sem);
+  }
+}
 
 /* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief  Get the AT transaction scheduler statistics of a class
+  * @param  sched_class - class
+  * @param  p_stat      - statistics of the class
+  * @retval -
+  */
+void osCDS_get_sched_stat(csos_class_t sched_class, csos_sched_stat_t *p_stat)
+{
+  if (sched_class < CSOS_CLASS_NB)
+  {
+    (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+    *p_stat = csos_class[sched_class].stat;
+    (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  }
+}
+
 /**
   * @brief  Read the actual signal quality seen by Modem .
-  * @note   Call CS_get_signal_quality with mutex access protection
+  * @note   Call CS_get_signal_quality through the AT transaction scheduler
   * @param  same parameters as the CS_get_signal_quality function
   * @retval CS_Status_t
   */
@@ -49,18 +338,18 @@ CS_Status_t osCS_get_signal_quality(CS_SignalQuality_t *p_sig_qual)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_POLLING);
 
   result = CS_get_signal_quality(p_sig_qual);
 
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
 
 /**
   * @brief  Allocate a socket among of the free sockets (maximum 6 sockets)
-  * @note   Call CDS_socket_create with mutex access protection
+  * @note   Call CDS_socket_create through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_create function
   * @retval Socket handle which references allocated socket
   */
@@ -70,12 +359,12 @@ socket_handle_t osCDS_socket_create(CS_IPaddrType_t addr_type,
 {
   socket_handle_t socket_handle;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
 
   socket_handle = CDS_socket_create(addr_type,
                                     protocol,
                                     cid);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (socket_handle);
 }
@@ -83,7 +372,7 @@ socket_handle_t osCDS_socket_create(CS_IPaddrType_t addr_type,
 /**
   * @brief  Set the callbacks to use when data are received or sent.
   * @note   This function has to be called before to use a socket.
-  * @note   Call CDS_socket_set_callbacks with mutex access protection
+  * @note   Call CDS_socket_set_callbacks through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_set_callbacks function
   * @retval CS_Status_t
   */
@@ -94,14 +383,14 @@ CS_Status_t osCDS_socket_set_callbacks(socket_handle_t sockHandle,
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
 
   result = CDS_socket_set_callbacks(sockHandle,
                                     data_ready_cb,
                                     data_sent_cb,
                                     remote_close_cb);
 
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -110,7 +399,7 @@ CS_Status_t osCDS_socket_set_callbacks(socket_handle_t sockHandle,
   * @brief  Define configurable options for a created socket.
   * @note   This function is called to configure one parameter at a time.
   *         If a parameter is not configured with this function, a default value will be applied.
-  * @note   Call CDS_socket_set_option with mutex access protection
+  * @note   Call CDS_socket_set_option through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_set_option function
   * @retval CS_Status_t
   */
@@ -122,14 +411,14 @@ CS_Status_t osCDS_socket_set_option(socket_handle_t sockHandle,
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
 
   result = CDS_socket_set_option(sockHandle,
                                  opt_level,
                                  opt_name,
                                  p_opt_val);
 
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -138,7 +427,7 @@ CS_Status_t osCDS_socket_set_option(socket_handle_t sockHandle,
   * @brief  Retrieve configurable options for a created socket.
   * @note   This function is called for one parameter at a time.
   * @note   Function not implemented yet
-  * @note   Call CDS_socket_get_option with mutex access protection
+  * @note   Call CDS_socket_get_option through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_get_option function
   * @retval CS_Status_t
   */
@@ -149,11 +438,11 @@ CS_Status_t osCDS_socket_get_option(void)
 
   if (CST_get_state() == CST_MODEM_DATA_READY_STATE)
   {
-    (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+    csos_acquire(CSOS_CLASS_CONTROL);
 
     result = CDS_socket_get_option();
 
-    (void)rtosalMutexRelease(CellularServiceMutexHandle);
+    csos_release();
   }
 
   return (result);
@@ -162,7 +451,7 @@ CS_Status_t osCDS_socket_get_option(void)
 /**
   * @brief  Bind the socket to a local port.
   * @note   If this function is not called, default local port value = 0 will be used.
-  * @note   Call CDS_socket_bind with mutex access protection
+  * @note   Call CDS_socket_bind through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_bind function
   * @retval CS_Status_t
   */
@@ -173,12 +462,12 @@ CS_Status_t osCDS_socket_bind(socket_handle_t sockHandle,
 
   if (CST_get_state() == CST_MODEM_DATA_READY_STATE)
   {
-    (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+    csos_acquire(CSOS_CLASS_CONTROL);
 
     result = CDS_socket_bind(sockHandle,
                              local_port);
 
-    (void)rtosalMutexRelease(CellularServiceMutexHandle);
+    csos_release();
   }
 
   return (result);
@@ -188,7 +477,7 @@ CS_Status_t osCDS_socket_bind(socket_handle_t sockHandle,
   * @brief  Connect to a remote server (for socket client mode).
   * @note   This function is blocking until the connection is setup or when the timeout to wait
   *         for socket connection expires.
-  * @note   Call CDS_socket_connect with mutex access protection
+  * @note   Call CDS_socket_connect through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_connect function
   * @retval CS_Status_t
   */
@@ -201,14 +490,14 @@ CS_Status_t osCDS_socket_connect(socket_handle_t sockHandle,
 
   if (CST_get_state() == CST_MODEM_DATA_READY_STATE)
   {
-    (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+    csos_acquire(CSOS_CLASS_CONTROL);
 
     result = CDS_socket_connect(sockHandle,
                                 addr_type,
                                 p_ip_addr_value,
                                 remote_port);
 
-    (void)rtosalMutexRelease(CellularServiceMutexHandle);
+    csos_release();
   }
 
   return (result);
@@ -217,7 +506,7 @@ CS_Status_t osCDS_socket_connect(socket_handle_t sockHandle,
 /**
   * @brief  Listen to clients (for socket server mode).
   * @note   Function not implemented yet
-  * @note   Call CDS_socket_listen with mutex access protection
+  * @note   Call CDS_socket_listen through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_listen function
   * @retval CS_Status_t
   */
@@ -227,11 +516,11 @@ CS_Status_t osCDS_socket_listen(socket_handle_t sockHandle)
 
   if (CST_get_state() == CST_MODEM_DATA_READY_STATE)
   {
-    (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+    csos_acquire(CSOS_CLASS_CONTROL);
 
     result = CDS_socket_listen(sockHandle);
 
-    (void)rtosalMutexRelease(CellularServiceMutexHandle);
+    csos_release();
   }
 
   return (result);
@@ -241,7 +530,7 @@ CS_Status_t osCDS_socket_listen(socket_handle_t sockHandle)
   * @brief  Send data over a socket to a remote server.
   * @note   This function is blocking until the data is transferred or when the
   *         timeout to wait for transmission expires.
-  * @note   Call CDS_socket_send with mutex access protection
+  * @note   Call CDS_socket_send through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_send function
   * @retval CS_Status_t
   */
@@ -253,13 +542,41 @@ CS_Status_t osCDS_socket_send(socket_handle_t sockHandle,
 
   if (CST_get_state() == CST_MODEM_DATA_READY_STATE)
   {
-    (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+    csos_acquire(CSOS_CLASS_DATA);
 
     result = CDS_socket_send(sockHandle,
                              p_buf,
                              length);
 
-    (void)rtosalMutexRelease(CellularServiceMutexHandle);
+    csos_release();
+  }
+
+  return (result);
+}
+
+/**
+  * @brief  Send data gathered from several buffers over a socket to a remote server.
+  * @note   This function is blocking until the data is transferred or when the
+  *         timeout to wait for transmission expires.
+  * @note   Call CDS_socket_send_iov through the AT transaction scheduler
+  * @param  same parameters as the CDS_socket_send_iov function
+  * @retval CS_Status_t
+  */
+CS_Status_t osCDS_socket_send_iov(socket_handle_t sockHandle,
+                                  const CS_IOVec_t *p_iov,
+                                  uint8_t iov_nb)
+{
+  CS_Status_t result = CELLULAR_ERROR;
+
+  if (CST_get_state() == CST_MODEM_DATA_READY_STATE)
+  {
+    csos_acquire(CSOS_CLASS_DATA);
+
+    result = CDS_socket_send_iov(sockHandle,
+                                 p_iov,
+                                 iov_nb);
+
+    csos_release();
   }
 
   return (result);
@@ -268,7 +585,7 @@ CS_Status_t osCDS_socket_send(socket_handle_t sockHandle,
 /**
   * @brief  Receive data from the connected remote server.
   * @note   This function is blocking until expected data length is received or a receive timeout has expired.
-  * @note   Call CDS_socket_receive with mutex access protection
+  * @note   Call CDS_socket_receive through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_receive function
   * @retval Size of received data (in bytes).
   */
@@ -281,13 +598,13 @@ int32_t osCDS_socket_receive(socket_handle_t sockHandle,
   result = 0;
   if (CST_get_state() == CST_MODEM_DATA_READY_STATE)
   {
-    (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+    csos_acquire(CSOS_CLASS_DATA);
 
     result = CDS_socket_receive(sockHandle,
                                 p_buf,
                                 max_buf_length);
 
-    (void)rtosalMutexRelease(CellularServiceMutexHandle);
+    csos_release();
   }
 
   return (result);
@@ -297,7 +614,7 @@ int32_t osCDS_socket_receive(socket_handle_t sockHandle,
   * @brief  Send data over a socket to a remote server.
   * @note   This function is blocking until the data is transferred or when the
   *         timeout to wait for transmission expires.
-  * @note   Call CDS_socket_sendto with mutex access protection
+  * @note   Call CDS_socket_sendto through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_sendto function
   * @retval CS_Status_t
   */
@@ -313,7 +630,7 @@ CS_Status_t osCDS_socket_sendto(socket_handle_t sockHandle,
 
   if (CST_get_state() == CST_MODEM_DATA_READY_STATE)
   {
-    (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+    csos_acquire(CSOS_CLASS_DATA);
 
     result = CDS_socket_sendto(sockHandle,
                                p_buf,
@@ -322,7 +639,7 @@ CS_Status_t osCDS_socket_sendto(socket_handle_t sockHandle,
                                p_ip_addr_value,
                                remote_port);
 
-    (void)rtosalMutexRelease(CellularServiceMutexHandle);
+    csos_release();
   }
 
   return (result);
@@ -331,7 +648,7 @@ CS_Status_t osCDS_socket_sendto(socket_handle_t sockHandle,
 /**
   * @brief  Receive data from the connected remote server.
   * @note   This function is blocking until expected data length is received or a receive timeout has expired.
-  * @note   Call CDS_socket_receivefrom with mutex access protection
+  * @note   Call CDS_socket_receivefrom through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_receivefrom function
   * @retval Size of received data (in bytes).
   */
@@ -347,7 +664,7 @@ int32_t osCDS_socket_receivefrom(socket_handle_t sockHandle,
   result = 0;
   if (CST_get_state() == CST_MODEM_DATA_READY_STATE)
   {
-    (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+    csos_acquire(CSOS_CLASS_DATA);
 
     result = CDS_socket_receivefrom(sockHandle,
                                     p_buf,
@@ -356,7 +673,7 @@ int32_t osCDS_socket_receivefrom(socket_handle_t sockHandle,
                                     p_ip_addr_value,
                                     p_remote_port);
 
-    (void)rtosalMutexRelease(CellularServiceMutexHandle);
+    csos_release();
   }
 
   return (result);
@@ -365,7 +682,7 @@ int32_t osCDS_socket_receivefrom(socket_handle_t sockHandle,
 /**
   * @brief  Free a socket handle.
   * @note   If a PDN is activated at socket creation, the socket will not be deactivated at socket closure.
-  * @note   Call CDS_socket_close with mutex access protection
+  * @note   Call CDS_socket_close through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_close function
   * @retval CS_Status_t
   */
@@ -374,12 +691,12 @@ CS_Status_t osCDS_socket_close(socket_handle_t sockHandle,
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
 
   result = CDS_socket_close(sockHandle,
                             force);
 
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -387,7 +704,7 @@ CS_Status_t osCDS_socket_close(socket_handle_t sockHandle,
 /**
   * @brief  Get connection status for a given socket.
   * @note   If a PDN is activated at socket creation, the socket will not be deactivated at socket closure.
-  * @note   Call CDS_socket_cnx_status with mutex access protection
+  * @note   Call CDS_socket_cnx_status through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_cnx_status function
   * @retval CS_Status_t
   */
@@ -396,12 +713,12 @@ CS_Status_t osCDS_socket_cnx_status(socket_handle_t sockHandle,
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
 
   result = CDS_socket_cnx_status(sockHandle,
                                  infos);
 
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -415,6 +732,7 @@ CS_Bool_t osCDS_cellular_service_init(void)
 {
   static CS_Bool_t CellularServiceInitialized = CELLULAR_FALSE;
   CS_Bool_t result;
+  uint8_t i;
 
   result = CELLULAR_TRUE;
   if (CellularServiceInitialized == CELLULAR_FALSE)
@@ -433,6 +751,27 @@ CS_Bool_t osCDS_cellular_service_init(void)
       /* Platform is reset */
       ERROR_Handler(DBG_CHAN_CELLULAR_SERVICE, 2, ERROR_FATAL);
     }
+    for (i = 0U; i < (uint8_t)CSOS_CLASS_NB; i++)
+    {
+      (void)memset((void *)&csos_class[i].stat, 0, sizeof(csos_sched_stat_t));
+      /* semaphore created with its token: take it, csos_release() gives it back */
+      csos_class[i].sem = rtosalSemaphoreNew((const rtosal_char_t *)"CSOS_SEM_CLASS", 1U);
+      if (csos_class[i].sem == NULL)
+      {
+        result = CELLULAR_FALSE;
+        /* Platform is reset */
+        ERROR_Handler(DBG_CHAN_CELLULAR_SERVICE, 3, ERROR_FATAL);
+      }
+      else
+      {
+        (void)rtosalSemaphoreAcquire(csos_class[i].sem, RTOSAL_WAIT_FOREVER);
+      }
+    }
+    csos_channel_busy = false;
+    csos_burst_class = CSOS_CLASS_NB;
+    csos_burst_count = 0U;
+    csos_owner = NULL;
+    (void)memset((void *)csos_waiting, 0, sizeof(csos_waiting));
 
     /* To do next line of code not done under if result == CELLULAR_TRUE
        because if result == CELLULAR_FALSE platform is reset (avoid quality error)
@@ -450,7 +789,7 @@ CS_Bool_t osCDS_cellular_service_init(void)
 
 /**
   * @brief  Read the latest registration state to the Cellular Network.
-  * @note   Call CS_get_net_status with mutex access protection
+  * @note   Call CS_get_net_status through the AT transaction scheduler
   * @param  same parameters as the CS_get_net_status function
   * @retval CS_Status_t
   */
@@ -458,16 +797,16 @@ CS_Status_t osCDS_get_net_status(CS_RegistrationStatus_t *p_reg_status)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_get_net_status(p_reg_status);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
 
 /**
   * @brief  Return information related to modem status.
-  * @note   Call CS_get_device_info with mutex access protection
+  * @note   Call CS_get_device_info through the AT transaction scheduler
   * @param  same parameters as the CS_get_device_info function
   * @retval CS_Status_t
   */
@@ -475,9 +814,9 @@ CS_Status_t osCDS_get_device_info(CS_DeviceInfo_t *p_devinfo)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_get_device_info(p_devinfo);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -494,9 +833,9 @@ CS_Status_t osCDS_subscribe_net_event(CS_UrcEvent_t event, cellular_urc_callback
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_subscribe_net_event(event,  urc_callback);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -504,7 +843,7 @@ CS_Status_t osCDS_subscribe_net_event(CS_UrcEvent_t event, cellular_urc_callback
 /**
   * @brief  Register to specified modem events.
   * @note   This function should be called once with all requested events.
-  * @note   Call CS_subscribe_modem_event with mutex access protection
+  * @note   Call CS_subscribe_modem_event through the AT transaction scheduler
   * @param  same parameters as the CS_subscribe_modem_event function
   *         change on requested event.
   * @retval CS_Status_t
@@ -513,16 +852,16 @@ CS_Status_t osCDS_subscribe_modem_event(CS_ModemEvent_t events_mask, cellular_mo
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_subscribe_modem_event(events_mask, modem_evt_cb);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
 
 /**
   * @brief  Power ON the modem
-  * @note   Call CS_power_on with mutex access protection
+  * @note   Call CS_power_on through the AT transaction scheduler
   * @param  none
   * @retval CS_Status_t
   */
@@ -530,16 +869,16 @@ CS_Status_t osCDS_power_on(void)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_power_on();
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
 
 /**
   * @brief  Power OFF the modem
-  * @note   Call CS_power_off with mutex access protection
+  * @note   Call CS_power_off through the AT transaction scheduler
   * @param  none
   * @retval CS_Status_t
   */
@@ -547,16 +886,16 @@ CS_Status_t osCDS_power_off(void)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_power_off();
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
 
 /**
   * @brief  Request to reset the device.
-  * @note   Call CS_reset with mutex access protection
+  * @note   Call CS_reset through the AT transaction scheduler
   * @param  same parameters as the CS_reset function
   * @retval CS_Status_t
   */
@@ -564,9 +903,9 @@ CS_Status_t osCDS_reset(CS_Reset_t rst_type)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_reset(rst_type);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -574,7 +913,7 @@ CS_Status_t osCDS_reset(CS_Reset_t rst_type)
 /**
   * @brief  Initialize the service and configures the Modem FW functionalities
   * @note   Used to provide PIN code (if any) and modem function level.
-  * @note   Call CS_init_modem with mutex access protection
+  * @note   Call CS_init_modem through the AT transaction scheduler
   * @param  same parameters as the CS_init_modem function
   * @retval CS_Status_t
   */
@@ -584,9 +923,9 @@ CS_Status_t osCDS_init_modem(CS_ModemInit_t init,
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_init_modem(init,  reset, pin_code);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -615,7 +954,7 @@ void osCCS_get_release_cs_resource(void)
   * @brief  Request the Modem to register to the Cellular Network.
   * @note   This function is used to select the operator. It returns a detailed
   *         network registration status.
-  * @note   Call CS_register_net with mutex access protection
+  * @note   Call CS_register_net through the AT transaction scheduler
   * @param  same parameters as the CS_register_net function
   * @retval CS_Status_t
   */
@@ -624,16 +963,16 @@ CS_Status_t osCDS_register_net(CS_OperatorSelector_t *p_operator,
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_register_net(p_operator, p_reg_status);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
 
 /**
   * @brief  Request for packet attach status.
-  * @note   Call CDS_socket_set_callbacks with mutex access protection
+  * @note   Call CDS_socket_set_callbacks through the AT transaction scheduler
   * @param  same parameters as the CDS_socket_set_callbacks function
   * @retval CS_Status_t
   */
@@ -641,9 +980,9 @@ CS_Status_t osCDS_get_attach_status(CS_PSattach_t *p_attach)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_get_attach_status(p_attach);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -651,7 +990,7 @@ CS_Status_t osCDS_get_attach_status(CS_PSattach_t *p_attach)
 
 /**
   * @brief  Request attach to packet domain.
-  * @note   Call CS_attach_PS_domain with mutex access protection
+  * @note   Call CS_attach_PS_domain through the AT transaction scheduler
   * @param  none.
   * @retval CS_Status_t
   */
@@ -659,9 +998,9 @@ CS_Status_t osCDS_attach_PS_domain(void)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_attach_PS_domain();
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -669,7 +1008,7 @@ CS_Status_t osCDS_attach_PS_domain(void)
 
 /**
   * @brief  Define internet data profile for a configuration identifier
-  * @note   Call CS_define_pdn with mutex access protection
+  * @note   Call CS_define_pdn through the AT transaction scheduler
   * @param  same parameters as the CS_define_pdn function
   * @retval CS_Status_t
   */
@@ -679,9 +1018,9 @@ CS_Status_t osCDS_define_pdn(CS_PDN_conf_id_t cid,
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_define_pdn(cid, apn, pdn_conf);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -691,7 +1030,7 @@ CS_Status_t osCDS_define_pdn(CS_PDN_conf_id_t cid,
   * @note   This function is used to register to an event related to a PDN
   *         Only explicit config id (CS_PDN_USER_CONFIG_1 to CS_PDN_USER_CONFIG_5) are
   *         supported and CS_PDN_PREDEF_CONFIG
-  * @note   Call CS_register_pdn_event with mutex access protection
+  * @note   Call CS_register_pdn_event through the AT transaction scheduler
   * @param  same parameters as the CS_register_pdn_event function
   * @retval CS_Status_t
   */
@@ -700,9 +1039,9 @@ CS_Status_t osCDS_register_pdn_event(CS_PDN_conf_id_t cid,
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_register_pdn_event(cid,  pdn_event_callback);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -710,7 +1049,7 @@ CS_Status_t osCDS_register_pdn_event(CS_PDN_conf_id_t cid,
 /**
   * @brief  Select a PDN among of defined configuration identifier(s) as the default.
   * @note   By default, PDN_PREDEF_CONFIG is considered as the default PDN.
-  * @note   Call CS_set_default_pdn with mutex access protection
+  * @note   Call CS_set_default_pdn through the AT transaction scheduler
   * @param  same parameters as the CS_set_default_pdn function
   * @retval CS_Status_t
   */
@@ -718,9 +1057,9 @@ CS_Status_t osCDS_set_default_pdn(CS_PDN_conf_id_t cid)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_set_default_pdn(cid);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -729,7 +1068,7 @@ CS_Status_t osCDS_set_default_pdn(CS_PDN_conf_id_t cid)
   * @brief  Activates a PDN (Packet Data Network Gateway) allowing communication with internet.
   * @note   This function triggers the allocation of IP public WAN to the device.
   * @note   Only one PDN can be activated at a time.
-  * @note   Call CS_activate_pdn with mutex access protection
+  * @note   Call CS_activate_pdn through the AT transaction scheduler
   * @param  same parameters as the CS_activate_pdn function
   * @retval CS_Status_t
   */
@@ -737,9 +1076,9 @@ CS_Status_t osCDS_activate_pdn(CS_PDN_conf_id_t cid)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_activate_pdn(cid);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -747,7 +1086,7 @@ CS_Status_t osCDS_activate_pdn(CS_PDN_conf_id_t cid)
 
 /**
   * @brief  Request to suspend DATA mode.
-  * @note   Call CS_suspend_data with mutex access protection
+  * @note   Call CS_suspend_data through the AT transaction scheduler
   * @param  none
   * @retval CS_Status_t
   */
@@ -755,16 +1094,16 @@ CS_Status_t osCDS_suspend_data(void)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_suspend_data();
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
 
 /**
   * @brief  Request to resume DATA mode.
-  * @note   Call CS_resume_data with mutex access protection
+  * @note   Call CS_resume_data through the AT transaction scheduler
   * @param  none
   * @retval CS_Status_t
   */
@@ -772,9 +1111,9 @@ CS_Status_t osCDS_resume_data(void)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_resume_data();
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -783,7 +1122,7 @@ CS_Status_t osCDS_resume_data(void)
 /**
   * @brief  DNS request
   * @note   Get IP address of the specified hostname
-  * @note   Call CS_dns_request with mutex access protection
+  * @note   Call CS_dns_request through the AT transaction scheduler
   * @param  same parameters as the CS_dns_request function
   * @retval CS_Status_t
   */
@@ -793,9 +1132,9 @@ CS_Status_t osCDS_dns_request(CS_PDN_conf_id_t cid,
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_dns_request(cid, dns_req, dns_resp);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -804,7 +1143,7 @@ CS_Status_t osCDS_dns_request(CS_PDN_conf_id_t cid,
 /**
   * @brief  Ping an IP address on the network
   * @note   Usually, the command AT is sent and OK is expected as response
-  * @note   Call CDS_ping with mutex access protection
+  * @note   Call CDS_ping through the AT transaction scheduler
   * @param  same parameters as the CDS_ping function
   * @retval CS_Status_t
   */
@@ -814,9 +1153,9 @@ CS_Status_t osCDS_ping(CS_PDN_conf_id_t cid,
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CDS_ping(cid, ping_params, cs_ping_rsp_cb);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -825,7 +1164,7 @@ CS_Status_t osCDS_ping(CS_PDN_conf_id_t cid,
 /**
   * @brief  Send a string will which be sended as it is to the modem (termination char will be added automatically)
   * @note   The termination char will be automatically added by the lower layer
-  * @note   Call CS_direct_cmd with mutex access protection
+  * @note   Call CS_direct_cmd through the AT transaction scheduler
   * @param  same parameters as the CS_direct_cmd function
   * @retval CS_Status_t
   */
@@ -834,16 +1173,16 @@ CS_Status_t osCDS_direct_cmd(CS_direct_cmd_tx_t *direct_cmd_tx,
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result =  CS_direct_cmd(direct_cmd_tx, direct_cmd_callback);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
 
 /**
   * @brief  Get the IP address allocated to the device for a given PDN.
-  * @note   Call osCDS_get_dev_IP_address with mutex access protection
+  * @note   Call osCDS_get_dev_IP_address through the AT transaction scheduler
   * @param  same parameters as the osCDS_get_dev_IP_address function
   * @retval CS_Status_t
   */
@@ -853,9 +1192,9 @@ CS_Status_t osCDS_get_dev_IP_address(CS_PDN_conf_id_t cid,
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_get_dev_IP_address(cid, ip_addr_type, p_ip_addr_value);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -864,7 +1203,7 @@ CS_Status_t osCDS_get_dev_IP_address(CS_PDN_conf_id_t cid,
 /**
   * @brief  Select SIM slot to use.
   * @note   Only one SIM slot is active at a time.
-  *         Call CS_sim_select with mutex access protection
+  *         Call CS_sim_select through the AT transaction scheduler
   * @param  same parameters as the CS_sim_select function
   * @retval CS_Status_t
   */
@@ -872,16 +1211,16 @@ CS_Status_t osCS_sim_select(CS_SimSlot_t simSelected)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_sim_select(simSelected);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
 
 /**
   * @brief  Send a SIM generic command to the modem
-  * @note   Call CS_sim_generic_access with mutex access protection
+  * @note   Call CS_sim_generic_access through the AT transaction scheduler
   * @param  sim_generic_access pointer on different buffers:\n
   *         command to send, response received\n
   *         size in bytes for all these buffers
@@ -891,9 +1230,9 @@ int32_t osCS_sim_generic_access(CS_sim_generic_access_t *sim_generic_access)
 {
   int32_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_sim_generic_access(sim_generic_access);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -913,9 +1252,9 @@ CS_Status_t osCS_InitPowerConfig(CS_init_power_config_t *p_power_config)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_InitPowerConfig(p_power_config);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -930,9 +1269,9 @@ CS_Status_t osCS_PowerWakeup(CS_wakeup_origin_t wakeup_origin)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_PowerWakeup(wakeup_origin);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -948,9 +1287,9 @@ CS_Status_t osCS_SleepCancel(void)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_SleepCancel();
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -965,9 +1304,9 @@ CS_Status_t osCS_SleepRequest(void)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_SleepRequest();
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -982,9 +1321,9 @@ CS_Status_t osCS_SleepComplete(void)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_SleepComplete();
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -999,9 +1338,9 @@ CS_Status_t osCS_SetPowerConfig(CS_set_power_config_t *p_power_config)
 {
   CS_Status_t result;
 
-  (void)rtosalMutexAcquire(CellularServiceMutexHandle, RTOSAL_WAIT_FOREVER);
+  csos_acquire(CSOS_CLASS_CONTROL);
   result = CS_SetPowerConfig(p_power_config);
-  (void)rtosalMutexRelease(CellularServiceMutexHandle);
+  csos_release();
 
   return (result);
 }
@@ -62,6 +62,21 @@
 
 #define CST_MODEM_POLLING_PERIOD_DEFAULT 5000U
 
+/* Adaptive modem polling in data ready state:
+   the polling period is doubled at each poll while the signal level is stable, up to the max period,
+   and goes back to the configured period when the signal level moves or on a network event */
+#if !defined CST_MODEM_POLLING_PERIOD_MAX
+#define CST_MODEM_POLLING_PERIOD_MAX      (60000U)  /* 1 min */
+#endif /* !defined CST_MODEM_POLLING_PERIOD_MAX */
+/* max period when the modem reports the signal quality changes by URC: polling is only a safety net */
+#if !defined CST_MODEM_POLLING_PERIOD_MAX_URC
+#define CST_MODEM_POLLING_PERIOD_MAX_URC  (300000U) /* 5 min */
+#endif /* !defined CST_MODEM_POLLING_PERIOD_MAX_URC */
+/* signal level variation (in dB) considered as a move */
+#if !defined CST_POLLING_SIGNAL_DELTA_DB
+#define CST_POLLING_SIGNAL_DELTA_DB       (4)
+#endif /* !defined CST_POLLING_SIGNAL_DELTA_DB */
+
 /* delay for PND activation retry */
 #define CST_PDN_ACTIVATE_RETRY_DELAY 30000U
 
@@ -148,6 +163,11 @@ static void CST_modem_activate_pdn_mngt(void);
 static void CST_cellular_data_fail_mngt(void);
 static void CST_pdn_event_mngt(void);
 static void CST_polling_timer_mngt(void);
+static void CST_polling_period_set(uint32_t period);
+#if (CST_MODEM_POLLING_PERIOD != 0)
+static void CST_polling_period_adapt(void);
+#endif /* CST_MODEM_POLLING_PERIOD != 0 */
+static void CST_modem_urc_mngt(void);
 static void CST_apn_set_new_config_mngt(void);
 static void CST_data_mode_target_state_event_mngt(void);
 static void CST_sim_only_target_state_event_mngt(void);
@@ -180,6 +200,12 @@ static void CST_cellular_service_task(void *argument);
 /* Global variables ----------------------------------------------------------*/
 bool CST_polling_active;            /* modem polling activation flag */
 static bool CST_polling_on_going;   /* modem polling already asked, and on going */
+bool CST_signal_quality_urc;        /* modem reports signal quality changes by URC */
+
+static osTimerId cst_polling_timer_handle = NULL;
+static uint32_t  cst_polling_period_min;   /* configured polling period         */
+static uint32_t  cst_polling_period;       /* current adaptive polling period   */
+static int32_t   cst_polling_level_db;     /* signal level at the previous poll */
 
 uint8_t *CST_SimSlotName_p[3] =
 {
@@ -917,6 +943,9 @@ static void  CST_data_ready_state_network_event_mngt(void)
 {
   cst_network_status_t ret;
 
+  /* network event: signal level may change, polls again at the configured period */
+  CST_polling_period_set(cst_polling_period_min);
+
   /* get network status */
   ret = CST_get_network_status();
 
@@ -1350,6 +1379,7 @@ static void CST_polling_timer_mngt(void)
       /* For instance disable the signal polling to test suspend resume  */
       (void)CST_set_signal_quality();
 #endif /* (USE_SOCKETS_TYPE == USE_SOCKETS_LWIP) */
+      CST_polling_period_adapt();
       CST_polling_on_going = false;
     }
     else
@@ -1360,6 +1390,66 @@ static void CST_polling_timer_mngt(void)
 #endif /* CST_MODEM_POLLING_PERIOD != 0) */
 }
 
+/**
+  * @brief  changes the modem polling period
+  * @param  period - new polling period in ms
+  * @retval -
+  */
+static void CST_polling_period_set(uint32_t period)
+{
+  if ((period != cst_polling_period) && (cst_polling_timer_handle != NULL))
+  {
+    cst_polling_period = period;
+    /* timer restarted with the new period */
+    (void)rtosalTimerStart(cst_polling_timer_handle, cst_polling_period);
+    PRINT_CELLULAR_SERVICE("Modem polling period: %ld ms\n\r", cst_polling_period)
+  }
+}
+
+#if (CST_MODEM_POLLING_PERIOD != 0)
+/**
+  * @brief  adapts the modem polling period to the signal level variation
+  * @param  -
+  * @retval -
+  */
+static void CST_polling_period_adapt(void)
+{
+  uint32_t period_max;
+  int32_t  delta;
+
+  period_max = (CST_signal_quality_urc == true) ? CST_MODEM_POLLING_PERIOD_MAX_URC : CST_MODEM_POLLING_PERIOD_MAX;
+  delta = cst_cellular_info.cs_signal_level_db - cst_polling_level_db;
+  cst_polling_level_db = cst_cellular_info.cs_signal_level_db;
+
+  if ((delta >= CST_POLLING_SIGNAL_DELTA_DB) || (delta <= -CST_POLLING_SIGNAL_DELTA_DB))
+  {
+    /* signal level moves: follows it closely */
+    CST_polling_period_set(cst_polling_period_min);
+  }
+  else if (cst_polling_period < (period_max / 2U))
+  {
+    /* signal level stable: backs off */
+    CST_polling_period_set(cst_polling_period * 2U);
+  }
+  else
+  {
+    CST_polling_period_set(period_max);
+  }
+}
+#endif /* CST_MODEM_POLLING_PERIOD != 0 */
+
+/**
+  * @brief  modem URC management: signal quality changed
+  * @param  -
+  * @retval -
+  */
+static void CST_modem_urc_mngt(void)
+{
+  /* reads the new signal level now, then polls at the configured period */
+  CST_polling_period_set(cst_polling_period_min);
+  CST_polling_timer_mngt();
+}
+
 /**
   * @brief  new apn config requested by application : set it in Data Cache
   * @param  -
@@ -1601,6 +1691,7 @@ static void CST_waiting_for_signal_quality_ok_state(cst_autom_event_t autom_even
   switch (autom_event)
   {
     case CST_POLLING_TIMER_EVENT:
+    case CST_MODEM_URC_EVENT:
     case CST_SIGNAL_QUALITY_TO_CHECK_EVENT:
       CST_signal_quality_test_mngt();
       break;
@@ -1822,6 +1913,10 @@ static void CST_data_ready_state(cst_autom_event_t autom_event)
       CST_polling_timer_mngt();
       break;
 
+    case CST_MODEM_URC_EVENT:
+      CST_modem_urc_mngt();
+      break;
+
     case CST_CELLULAR_DATA_FAIL_EVENT:
       CST_cellular_data_fail_mngt();
       break;
@@ -2447,6 +2542,12 @@ void CST_set_state(CST_autom_state_t new_state)
   cst_context.current_state = new_state;
   PRINT_CELLULAR_SERVICE("-----> New State: %s <-----\n\r", CST_StateName[new_state])
 
+  if (new_state != CST_MODEM_DATA_READY_STATE)
+  {
+    /* adaptive polling only in data ready state */
+    CST_polling_period_set(cst_polling_period_min);
+  }
+
 #if (USE_CELLULAR_SERVICE_TASK_TEST == 1)
   /* instrumentation code to test automaton */
   CSTE_cellular_service_task_test(cst_context.current_state);
@@ -2559,7 +2660,6 @@ CS_Status_t CST_cellular_service_start(void)
 {
   static osThreadId cst_cellular_service_thread_id = NULL;
   dc_nfmc_info_t nfmc_info;
-  uint32_t cst_polling_period;
   dc_com_status_t dc_ret;
   uint32_t       cs_ret;
   CS_Status_t    cst_ret;
@@ -2569,8 +2669,6 @@ CS_Status_t CST_cellular_service_start(void)
   cst_ret = CELLULAR_OK;
   cs_ret  = 0U;
 
-  osTimerId         cst_polling_timer_handle;
-
 #if (USE_CMD_CONSOLE == 1)
   (void)CST_cmd_cellular_service_start();
 #endif /*  (USE_CMD_CONSOLE == 1) */
@@ -2648,10 +2746,12 @@ CS_Status_t CST_cellular_service_start(void)
   /* creates and start modem polling timer */
   cst_polling_timer_handle = rtosalTimerNew(NULL, (os_ptimer)CST_polling_timer_callback, osTimerPeriodic, NULL);
 #if (CST_MODEM_POLLING_PERIOD == 0)
-  cst_polling_period = CST_MODEM_POLLING_PERIOD_DEFAULT;
+  cst_polling_period_min = CST_MODEM_POLLING_PERIOD_DEFAULT;
 #else
-  cst_polling_period = CST_MODEM_POLLING_PERIOD;
+  cst_polling_period_min = CST_MODEM_POLLING_PERIOD;
 #endif /* (CST_MODEM_POLLING_PERIOD == 1) */
+  cst_polling_period = cst_polling_period_min;
+  cst_polling_level_db = (int32_t)DC_NO_ATTACHED;
   os_ret = rtosalTimerStart(cst_polling_timer_handle, cst_polling_period);
   if (os_ret != osOK)
   {
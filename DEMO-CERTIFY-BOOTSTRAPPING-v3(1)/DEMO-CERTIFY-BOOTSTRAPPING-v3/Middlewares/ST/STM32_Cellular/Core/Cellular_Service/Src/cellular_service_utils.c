@@ -114,6 +114,13 @@ static void CST_network_reg_callback(void);
   */
 static void CST_location_info_callback(void);
 
+/**
+  * @brief  signal quality URC callback
+  * @param  -
+  * @retval -
+  */
+static void CST_signal_quality_callback(void);
+
 /**
   * @brief  modem event callback
   * @param  event - modem event
@@ -250,6 +257,17 @@ static void CST_network_reg_callback(void)
   CST_send_message(CST_MESSAGE_CS_EVENT, CST_NETWORK_CALLBACK_EVENT);
 }
 
+/**
+  * @brief  signal quality URC callback
+  * @param  -
+  * @retval -
+  */
+static void CST_signal_quality_callback(void)
+{
+  /* sends a message to automaton */
+  CST_send_message(CST_MESSAGE_CS_EVENT, CST_MODEM_URC_EVENT);
+}
+
 /**
   * @brief  location info callback callback
   * @param  -
@@ -578,6 +596,14 @@ static void CST_subscribe_all_net_events(void)
   (void)osCDS_subscribe_net_event(CS_URCEVENT_EPS_LOCATION_INFO, CST_location_info_callback);
   (void)osCDS_subscribe_net_event(CS_URCEVENT_GPRS_LOCATION_INFO, CST_location_info_callback);
   (void)osCDS_subscribe_net_event(CS_URCEVENT_CS_LOCATION_INFO, CST_location_info_callback);
+  /* not supported by all modems: if not, signal quality is only polled */
+  PRINT_CELLULAR_SERVICE("Subscribe URC events: Signal quality\n\r")
+  CST_signal_quality_urc = (osCDS_subscribe_net_event(CS_URCEVENT_SIGNAL_QUALITY,
+                                                      CST_signal_quality_callback) == CELLULAR_OK);
+  if (CST_signal_quality_urc == false)
+  {
+    PRINT_CELLULAR_SERVICE("Signal quality URC not supported: polling only\n\r")
+  }
 }
 
 /**
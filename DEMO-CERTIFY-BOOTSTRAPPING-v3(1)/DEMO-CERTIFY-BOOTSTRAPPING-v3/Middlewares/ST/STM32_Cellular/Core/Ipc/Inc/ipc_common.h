@@ -146,12 +146,23 @@ typedef struct
   uint16_t    size;
 } IPC_RxHeader_t;
 
+/* Message received: no copy, buffer points to the message in the RX FIFO
+ * (or to a linear copy if the message wraps at the end of the RX FIFO).
+ * Valid until IPC_release() is called.
+ */
 typedef struct
 {
-  uint8_t     buffer[IPC_RXBUF_MAXSIZE];
+  uint8_t     *buffer;
   uint16_t    size;
 } IPC_RxMessage_t;
 
+/* Message location in the RX FIFO: 2 parts if the message wraps at the end of the RX FIFO */
+typedef struct
+{
+  uint8_t     *p_part[2];
+  uint16_t    part_size[2];
+} IPC_RxMessageView_t;
+
 typedef struct
 {
   uint8_t      data[IPC_RXBUF_MAXSIZE];
@@ -230,6 +241,7 @@ IPC_Status_t IPC_abort(IPC_Handle_t *hipc);
 IPC_Handle_t *IPC_get_other_channel(IPC_Handle_t *hipc);
 IPC_Status_t IPC_send(IPC_Handle_t *hipc, uint8_t *p_TxBuffer, uint16_t bufsize);
 IPC_Status_t IPC_receive(IPC_Handle_t *hipc, IPC_RxMessage_t *p_msg);
+IPC_Status_t IPC_release(IPC_Handle_t *hipc);
 IPC_Status_t IPC_streamReceive(IPC_Handle_t *hipc, uint8_t *p_buffer, int16_t *p_len);
 void IPC_DumpRXQueue(IPC_Handle_t *hipc, uint8_t readable);
 
@@ -39,7 +39,11 @@ extern "C" {
 /* Exported functions ------------------------------------------------------- */
 void IPC_RXFIFO_init(IPC_Handle_t *hipc);
 void IPC_RXFIFO_writeCharacter(IPC_Handle_t *hipc, uint8_t rxChar);
-int16_t IPC_RXFIFO_read(IPC_Handle_t *hipc, IPC_RxMessage_t *pMsg);
+#if (IPC_USE_UART_DMA == 1U)
+uint16_t IPC_RXFIFO_writeBuffer(IPC_Handle_t *hipc, const uint8_t *p_data, uint16_t size);
+#endif /* IPC_USE_UART_DMA == 1U */
+int16_t IPC_RXFIFO_getMsg(IPC_Handle_t *hipc, IPC_RxMessageView_t *pView);
+void IPC_RXFIFO_releaseMsg(IPC_Handle_t *hipc);
 #if (IPC_USE_STREAM_MODE == 1U)
 void IPC_RXFIFO_stream_init(IPC_Handle_t *hipc);
 void IPC_RXFIFO_writeStream(IPC_Handle_t *hipc, uint8_t rxChar);
@@ -0,0 +1,65 @@
+/**
+  ******************************************************************************
+  * @file    ipc_sim.h
+  * @author  artworkTrackingMAP
+  * @brief   Header for ipc_sim.c module
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef IPC_SIM_H
+#define IPC_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "ipc_common.h"
+
+#if (USE_MODEM_SIMULATOR == 1)
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t cmd_count;        /* number of AT commands received */
+  uint32_t tx_bytes;         /* socket bytes sent by the host (%SOCKETDATA="SEND") */
+  uint32_t tx_count;         /* number of socket sends (%SOCKETDATA="SEND") */
+  uint32_t rx_bytes;         /* socket bytes read by the host (%SOCKETDATA="RECEIVE") */
+  uint32_t rx_count;         /* number of socket reads (%SOCKETDATA="RECEIVE") */
+  uint32_t lost_packets;     /* echoed packets dropped by loss simulation */
+  uint32_t paused_ms;        /* time spent waiting for free space in the IPC RX FIFO */
+  uint32_t csq_count;        /* number of signal quality requests (AT+CSQ) */
+  uint32_t dns_count;        /* number of DNS requests (AT%DNSRSLV) */
+  uint32_t replay_unmatched; /* AT commands without a recorded response to replay */
+} IPC_SIM_Statistics_t;
+
+/* Recorded modem response, see IPC_SIM_replay() */
+typedef struct
+{
+  const uint8_t *p_cmd;      /* AT command answered (without "AT"), NULL: sent after the previous response */
+  const uint8_t *p_data;     /* bytes sent by the modem */
+  uint16_t size;
+  uint8_t  replayed;         /* set to 1 by the simulator when sent */
+} IPC_SIM_ReplayRsp_t;
+
+/* External variables --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported functions ------------------------------------------------------- */
+IPC_Status_t IPC_SIM_start(IPC_Handle_t *hipc);
+IPC_Status_t IPC_SIM_send(IPC_Handle_t *hipc, const uint8_t *p_TxBuffer, uint16_t bufsize);
+void IPC_SIM_getStatistics(IPC_SIM_Statistics_t *p_stats);
+void IPC_SIM_setSignalQuality(uint8_t rssi);
+void IPC_SIM_replay(IPC_SIM_ReplayRsp_t *p_rsp, uint16_t nb);
+
+#endif /* USE_MODEM_SIMULATOR == 1 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IPC_SIM_H */
+
+/******************************** END OF FILE *********************************/
@@ -49,6 +49,7 @@ IPC_Status_t IPC_UART_abort(IPC_Handle_t *hipc);
 IPC_Handle_t *IPC_UART_get_other_channel(const IPC_Handle_t *hipc);
 IPC_Status_t IPC_UART_send(IPC_Handle_t *hipc, uint8_t *p_TxBuffer, uint16_t bufsize);
 IPC_Status_t IPC_UART_receive(IPC_Handle_t *hipc, IPC_RxMessage_t *p_msg);
+IPC_Status_t IPC_UART_release(IPC_Handle_t *hipc);
 IPC_Status_t IPC_UART_streamReceive(IPC_Handle_t *hipc,  uint8_t *p_buffer, int16_t *p_len);
 void IPC_UART_rearm_RX_IT(IPC_Handle_t *hipc);
 
@@ -59,6 +60,10 @@ void IPC_UART_DumpRXQueue(const IPC_Handle_t *hipc, uint8_t readable);
 void IPC_UART_RxCpltCallback(UART_HandleTypeDef *UartHandle);
 void IPC_UART_TxCpltCallback(UART_HandleTypeDef *UartHandle);
 void IPC_UART_ErrorCallback(UART_HandleTypeDef *UartHandle);
+#if (IPC_USE_UART_DMA == 1U)
+void IPC_UART_RxHalfCpltCallback(UART_HandleTypeDef *UartHandle);
+void IPC_UART_IdleLineIRQHandler(UART_HandleTypeDef *UartHandle);
+#endif /* IPC_USE_UART_DMA == 1U */
 
 #ifdef __cplusplus
 }
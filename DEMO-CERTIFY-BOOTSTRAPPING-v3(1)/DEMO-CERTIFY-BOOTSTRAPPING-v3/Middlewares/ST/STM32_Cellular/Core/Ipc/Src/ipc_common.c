@@ -298,6 +298,28 @@ IPC_Status_t IPC_receive(IPC_Handle_t *hipc, IPC_RxMessage_t *p_msg)
   return (status);
 }
 
+/**
+  * @brief  Release the message returned by IPC_receive().
+  * @note   Its place in the RX FIFO is freed: message content must not be accessed anymore.
+  * @param  hipc IPC handle.
+  * @retval status
+  */
+IPC_Status_t IPC_release(IPC_Handle_t *hipc)
+{
+  IPC_Status_t status;
+
+  if (hipc != NULL)
+  {
+    status = IPC_UART_release(hipc);
+  }
+  else
+  {
+    status = IPC_ERROR;
+  }
+
+  return (status);
+}
+
 /**
   * @brief  Receive a data buffer from a channel.
   * @param  hipc IPC handle.
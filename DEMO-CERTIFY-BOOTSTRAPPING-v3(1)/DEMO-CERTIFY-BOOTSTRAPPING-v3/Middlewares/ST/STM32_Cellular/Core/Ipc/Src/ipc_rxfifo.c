@@ -19,6 +19,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <string.h>
+#include <stdbool.h>
 #include "ipc_rxfifo.h"
 #include "ipc_common.h"
 #include "plf_config.h"
@@ -64,10 +65,14 @@ typedef char IPC_TYPE_CHAR_t;
 
 /* Private function prototypes -----------------------------------------------*/
 static void RXFIFO_incrementTail(IPC_Handle_t *hipc, uint16_t inc_size);
-static void RXFIFO_incrementHead(IPC_Handle_t *hipc);
+static void RXFIFO_incrementHead(IPC_Handle_t *hipc, uint16_t inc_size);
+static void RXFIFO_endOfMsg(IPC_Handle_t *hipc);
 static void RXFIFO_updateMsgHeader(IPC_Handle_t *hipc);
 static void RXFIFO_prepareNextMsgHeader(IPC_Handle_t *hipc);
 static void RXFIFO_rearm_RX_IT(IPC_Handle_t *hipc);
+#if (IPC_USE_UART_DMA == 1U)
+static uint16_t RXFIFO_findDelimiter(const uint8_t *p_data, uint16_t size);
+#endif /* IPC_USE_UART_DMA == 1U */
 
 /* Functions Definition ------------------------------------------------------*/
 /**
@@ -114,7 +119,7 @@ void IPC_RXFIFO_writeCharacter(IPC_Handle_t *hipc, uint8_t rxChar)
     hipc->dbgRxQueue.msg_info_queue[hipc->dbgRxQueue.queue_pos].size = hipc->RxQueue.current_msg_size;
 #endif /* DBG_IPC_RX_FIFO */
 
-    RXFIFO_incrementHead(hipc);
+    RXFIFO_incrementHead(hipc, 1U);
 
     if (hipc->State != IPC_STATE_PAUSED)
     {
@@ -125,36 +130,101 @@ void IPC_RXFIFO_writeCharacter(IPC_Handle_t *hipc, uint8_t rxChar)
     /* check if the char received is an end of message */
     if ((*hipc->CheckEndOfMsgCallback)(rxChar) == 1U)
     {
-      hipc->RxQueue.nb_unread_msg++;
-
-      /* update header for message received */
-      RXFIFO_updateMsgHeader(hipc);
+      RXFIFO_endOfMsg(hipc);
+    }
+  }
+}
 
-      /* save start position of next message */
-      hipc->RxQueue.current_msg_index = hipc->RxQueue.index_write;
+#if (IPC_USE_UART_DMA == 1U)
+/**
+  * @brief  Write a block of chars in the IPC RX FIFO.
+  * @note   Same result as IPC_RXFIFO_writeCharacter() called for each char, but data are copied
+  *         by chunks and the end of message callback is only called for <CR> and <LF>.
+  *         The modem end of message automaton must ignore all other characters.
+  * @note   Writing stops when the IPC is paused (RX FIFO almost full).
+  *         Remaining chars have to be written again after resume.
+  * @param  hipc IPC handle.
+  * @param  p_data chars to write.
+  * @param  size number of chars to write.
+  * @retval number of chars written.
+  */
+uint16_t IPC_RXFIFO_writeBuffer(IPC_Handle_t *hipc, const uint8_t *p_data, uint16_t size)
+{
+  uint16_t written = 0U;
+  uint16_t chunk_size;
+  uint16_t free_bytes;
+  uint16_t first_part;
+  bool end_of_chunk;
 
-      /* reset current msg size */
-      hipc->RxQueue.current_msg_size = 0U;
+  if (hipc != NULL)
+  {
+    while ((written < size) && (hipc->State != IPC_STATE_PAUSED))
+    {
+      /* chunk ends with the next <CR> or <LF> (included) or with the data */
+      chunk_size = RXFIFO_findDelimiter(&p_data[written], size - written);
+      end_of_chunk = true;
 
-      /* reserve place for next msg header */
-      RXFIFO_prepareNextMsgHeader(hipc);
+      /* do not fill the FIFO above the pause threshold */
+      free_bytes = IPC_RXFIFO_getFreeBytes(hipc);
+      if (free_bytes <= IPC_RXBUF_THRESHOLD)
+      {
+        chunk_size = 0U;
+        hipc->State = IPC_STATE_PAUSED;
+      }
+      else if (chunk_size > (free_bytes - IPC_RXBUF_THRESHOLD))
+      {
+        chunk_size = free_bytes - IPC_RXBUF_THRESHOLD;
+        end_of_chunk = false;
+      }
+      else
+      {
+        /* the whole chunk fits in the FIFO */
+      }
 
-      /* msg received: call client callback */
-      (* hipc->RxClientCallback)((IPC_Handle_t *)hipc);
+      if (chunk_size != 0U)
+      {
+        /* copy chunk, in 2 parts if it loops back to the start of the circular buffer */
+        first_part = IPC_RXBUF_MAXSIZE - hipc->RxQueue.index_write;
+        if (first_part > chunk_size)
+        {
+          first_part = chunk_size;
+        }
+        (void) memcpy((void *)&hipc->RxQueue.data[hipc->RxQueue.index_write],
+                      (const void *)&p_data[written], (size_t)first_part);
+        (void) memcpy((void *)&hipc->RxQueue.data[0],
+                      (const void *)&p_data[written + first_part], (size_t)chunk_size - first_part);
+
+        hipc->RxQueue.current_msg_size += chunk_size;
+#if (DBG_IPC_RX_FIFO == 1U)
+        hipc->dbgRxQueue.msg_info_queue[hipc->dbgRxQueue.queue_pos].size = hipc->RxQueue.current_msg_size;
+#endif /* DBG_IPC_RX_FIFO */
+        RXFIFO_incrementHead(hipc, chunk_size);
+        written += chunk_size;
+
+        /* only the last char of a complete chunk can be an end of message */
+        if ((end_of_chunk == true) && ((*hipc->CheckEndOfMsgCallback)(p_data[written - 1U]) == 1U))
+        {
+          RXFIFO_endOfMsg(hipc);
+        }
+      }
     }
   }
+
+  return (written);
 }
+#endif /* IPC_USE_UART_DMA == 1U */
 
 /**
-  * @brief  Read first unread message in the IPC RX FIFO.
+  * @brief  Get first unread message in the IPC RX FIFO (without copy).
+  * @note   Message stays in the IPC RX FIFO until IPC_RXFIFO_releaseMsg() is called.
   * @param  hipc IPC handle.
-  * @param  pMsg ptr to the message read from IPC RX FIFO.
-  * @retval message size (-1 if an error occurred).
+  * @param  pView ptr to the message location in the IPC RX FIFO.
+  * @retval number of unread messages after this one (-1 if an error occurred).
   */
-int16_t IPC_RXFIFO_read(IPC_Handle_t *hipc, IPC_RxMessage_t *pMsg)
+int16_t IPC_RXFIFO_getMsg(IPC_Handle_t *hipc, IPC_RxMessageView_t *pView)
 {
   int16_t retval;
-  uint16_t oversize;
+  uint16_t data_pos;
   IPC_RxHeader_t header;
 
   if (hipc != NULL)
@@ -173,45 +243,60 @@ int16_t IPC_RXFIFO_read(IPC_Handle_t *hipc, IPC_RxMessage_t *pMsg)
     }
     else
     {
-      /* jump header */
-      RXFIFO_incrementTail(hipc, IPC_RXMSG_HEADER_SIZE);
+      /* message data are after the header */
+      data_pos = (hipc->RxQueue.index_read + IPC_RXMSG_HEADER_SIZE) % IPC_RXBUF_MAXSIZE;
 
 #if (DBG_IPC_RX_FIFO == 1U)
-      PRINT_DBG(" *** data pos=%d ", hipc->RxQueue.index_read)
+      PRINT_DBG(" *** data pos=%d ", data_pos)
       PRINT_DBG(" *** size=%d ", header.size)
-      PRINT_DBG(" *** free bytes before read=%d ", hipc->dbgRxQueue.free_bytes)
 #endif /* DBG_IPC_RX_FIFO */
 
-      /* update size in output structure */
-      pMsg->size = header.size;
-
-      /* copy msg content to output structure */
-      if ((hipc->RxQueue.index_read + header.size) > IPC_RXBUF_MAXSIZE)
+      pView->p_part[0] = &hipc->RxQueue.data[data_pos];
+      if ((data_pos + header.size) > IPC_RXBUF_MAXSIZE)
       {
         /* message is split in 2 parts in the circular buffer */
-        oversize = (hipc->RxQueue.index_read + header.size - IPC_RXBUF_MAXSIZE);
-        uint16_t remaining_size = header.size - oversize;
-        (void) memcpy((void *) & (pMsg->buffer[0]),
-                      (void *) & (hipc->RxQueue.data[hipc->RxQueue.index_read]),
-                      (size_t) remaining_size);
-        (void) memcpy((void *) & (pMsg->buffer[header.size - oversize]),
-                      (void *) & (hipc->RxQueue.data[0]),
-                      (size_t) oversize);
-
-#if (DBG_IPC_RX_FIFO == 1U)
-        PRINT_DBG("override end of buffer")
-#endif /* DBG_IPC_RX_FIFO */
+        pView->part_size[0] = IPC_RXBUF_MAXSIZE - data_pos;
+        pView->p_part[1] = &hipc->RxQueue.data[0];
+        pView->part_size[1] = header.size - pView->part_size[0];
       }
       else
       {
         /* message is contiguous in the circular buffer */
-        (void) memcpy((void *)pMsg->buffer,
-                      (void *) & (hipc->RxQueue.data[hipc->RxQueue.index_read]),
-                      (size_t) header.size);
+        pView->part_size[0] = header.size;
+        pView->p_part[1] = NULL;
+        pView->part_size[1] = 0U;
       }
 
+      /* return number of unread messages after this one */
+      retval = (int16_t)hipc->RxQueue.nb_unread_msg - 1;
+    }
+  }
+  else
+  {
+    /* error: hipc is NULL */
+    retval = -1;
+  }
+
+  return (retval);
+}
+
+/**
+  * @brief  Release first unread message in the IPC RX FIFO.
+  * @note   To call once the message returned by IPC_RXFIFO_getMsg() has been processed.
+  * @param  hipc IPC handle.
+  * @retval none.
+  */
+void IPC_RXFIFO_releaseMsg(IPC_Handle_t *hipc)
+{
+  IPC_RxHeader_t header;
+
+  if (hipc != NULL)
+  {
+    IPC_RXFIFO_readMsgHeader_at_pos(hipc, &header, hipc->RxQueue.index_read);
+    if ((header.complete == 1U) && (hipc->RxQueue.nb_unread_msg != 0U))
+    {
       /* increment tail index to the next message */
-      RXFIFO_incrementTail(hipc, header.size);
+      RXFIFO_incrementTail(hipc, IPC_RXMSG_HEADER_SIZE + header.size);
 
 #if (DBG_IPC_RX_FIFO == 1U)
       /* update free_bytes infos */
@@ -221,18 +306,8 @@ int16_t IPC_RXFIFO_read(IPC_Handle_t *hipc, IPC_RxMessage_t *pMsg)
 
       /* msg has been read */
       hipc->RxQueue.nb_unread_msg--;
-
-      /* return number of unread messages */
-      retval = (int16_t)hipc->RxQueue.nb_unread_msg;
     }
   }
-  else
-  {
-    /* error: hipc is NULL */
-    retval = -1;
-  }
-
-  return (retval);
 }
 
 #if (IPC_USE_STREAM_MODE == 1U)
@@ -443,13 +518,14 @@ static void RXFIFO_incrementTail(IPC_Handle_t *hipc, uint16_t inc_size)
 /**
   * @brief  Increment IPC RX FIFO Head for next message Header.
   * @param  hipc IPC handle.
+  * @param  inc_size Size to increment.
   * @retval none.
   */
-static void RXFIFO_incrementHead(IPC_Handle_t *hipc)
+static void RXFIFO_incrementHead(IPC_Handle_t *hipc, uint16_t inc_size)
 {
   uint16_t free_bytes;
 
-  hipc->RxQueue.index_write = (hipc->RxQueue.index_write + 1U) % IPC_RXBUF_MAXSIZE;
+  hipc->RxQueue.index_write = (hipc->RxQueue.index_write + inc_size) % IPC_RXBUF_MAXSIZE;
   free_bytes = IPC_RXFIFO_getFreeBytes(hipc);
 
 #if (DBG_IPC_RX_FIFO == 1U)
@@ -466,6 +542,31 @@ static void RXFIFO_incrementHead(IPC_Handle_t *hipc)
   }
 }
 
+/**
+  * @brief  Close current message when its last char has been received.
+  * @param  hipc IPC handle.
+  * @retval none.
+  */
+static void RXFIFO_endOfMsg(IPC_Handle_t *hipc)
+{
+  hipc->RxQueue.nb_unread_msg++;
+
+  /* update header for message received */
+  RXFIFO_updateMsgHeader(hipc);
+
+  /* save start position of next message */
+  hipc->RxQueue.current_msg_index = hipc->RxQueue.index_write;
+
+  /* reset current msg size */
+  hipc->RxQueue.current_msg_size = 0U;
+
+  /* reserve place for next msg header */
+  RXFIFO_prepareNextMsgHeader(hipc);
+
+  /* msg received: call client callback */
+  (* hipc->RxClientCallback)((IPC_Handle_t *)hipc);
+}
+
 /**
   * @brief  Update current message Header.
   * @param  hipc IPC handle.
@@ -509,7 +610,7 @@ static void RXFIFO_prepareNextMsgHeader(IPC_Handle_t *hipc)
   {
     /* clean data and increment head */
     hipc->RxQueue.data[hipc->RxQueue.index_write] = 0U;
-    RXFIFO_incrementHead(hipc);
+    RXFIFO_incrementHead(hipc, 1U);
   }
 }
 
@@ -521,5 +622,36 @@ static void RXFIFO_rearm_RX_IT(IPC_Handle_t *hipc)
   __NOP();
 #endif /* IPC_USE_UART == 1U */
 }
+
+#if (IPC_USE_UART_DMA == 1U)
+/**
+  * @brief  Find the first <CR> or <LF> in a block of chars.
+  * @note   Uses memchr() which is faster than a char by char loop on long messages (HEX data).
+  * @param  p_data chars to analyze.
+  * @param  size number of chars.
+  * @retval number of chars up to and including the delimiter (size if no delimiter found).
+  */
+static uint16_t RXFIFO_findDelimiter(const uint8_t *p_data, uint16_t size)
+{
+  const uint8_t *p_cr;
+  const uint8_t *p_lf;
+  uint16_t length = size;
+
+  p_cr = (const uint8_t *)memchr((const void *)p_data, (int32_t)'\r', (size_t)size);
+  if (p_cr != NULL)
+  {
+    /* <CR><LF>: search <LF> only before <CR> */
+    length = (uint16_t)(p_cr - p_data) + 1U;
+  }
+  p_lf = (const uint8_t *)memchr((const void *)p_data, (int32_t)'\n', (size_t)length);
+  if (p_lf != NULL)
+  {
+    length = (uint16_t)(p_lf - p_data) + 1U;
+  }
+
+  return (length);
+}
+#endif /* IPC_USE_UART_DMA == 1U */
+
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
 
@@ -0,0 +1,981 @@
+/**
+  ******************************************************************************
+  * @file    ipc_sim.c
+  * @author  artworkTrackingMAP
+  * @brief   This file provides a simulated IPC device playing the Type1SC
+  *          AT dialect, used instead of the modem UART to measure the
+  *          cellular stack without SIM nor antenna.
+  * @note    Instead of playing the Type1SC dialect, the simulator can replay
+  *          the modem responses recorded by at_recorder.c (IPC_SIM_replay).
+  * @note    Socket data sent to the simulator is echoed back on the same
+  *          socket (as an echo server) after a configurable network latency.
+  *          With IPC_SIM_TCP_BRIDGE (POSIX host build), a TCP socket whose remote
+  *          port has a server listening on the local host is bridged to it.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "ipc_sim.h"
+#include "plf_config.h"
+
+#if (USE_MODEM_SIMULATOR == 1)
+
+#include "rtosal.h"
+#include "at_util.h"
+
+#if (IPC_SIM_TCP_BRIDGE == 1U)
+#if !defined RTOSAL_POSIX
+#error "IPC_SIM_TCP_BRIDGE needs the POSIX host build"
+#endif /* !defined RTOSAL_POSIX */
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif /* IPC_SIM_TCP_BRIDGE == 1U */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef char IPC_SIM_CHAR_t;
+
+/* Simulated modem socket */
+typedef struct
+{
+  uint8_t  allocated;
+  uint8_t  activated;
+  uint8_t  is_udp;
+  uint16_t remote_port;
+  uint16_t local_port;
+  IPC_SIM_CHAR_t remote_ip[IPC_SIM_IP_ADDR_MAXSIZE];
+  uint16_t rx_available;         /* bytes readable by AT%SOCKETDATA="RECEIVE" */
+  uint16_t rx_in_flight;         /* echoed bytes not yet delivered (network latency) */
+  uint32_t rx_due_tick;          /* tick when in flight bytes are delivered */
+#if (IPC_SIM_TCP_BRIDGE == 1U)
+  int32_t  bridge_fd;            /* local host TCP connection, -1: echo, -2: closed by the server */
+#endif /* IPC_SIM_TCP_BRIDGE == 1U */
+  uint8_t  rx_buffer[IPC_SIM_SOCKET_RXBUF_SIZE];
+} ipc_sim_socket_t;
+
+/* Response table entry: AT command (without "AT" prefix) and information response */
+typedef struct
+{
+  const IPC_SIM_CHAR_t *p_cmd;
+  const IPC_SIM_CHAR_t *p_rsp;
+} ipc_sim_rsp_t;
+
+/* Private defines -----------------------------------------------------------*/
+#define IPC_SIM_MSG_CMD          (1U)   /* a complete AT command is available */
+#define IPC_SIM_MAX_PARAMS       (10U)
+#define IPC_SIM_BITS_PER_CHAR    (10U)  /* 1 start bit + 8 data bits + 1 stop bit */
+#define IPC_SIM_BOOT_DELAY       (100U) /* delay before %BOOTEV (in ms) */
+#define IPC_SIM_RSP_MAXSIZE      ((2U * IPC_SIM_SOCKET_RXBUF_SIZE) + 96U)
+#define IPC_SIM_BRIDGE_NONE      (-1)   /* socket not bridged: echo */
+#define IPC_SIM_BRIDGE_CLOSED    (-2)   /* bridged connection closed by the local host server */
+
+/* Private macros ------------------------------------------------------------*/
+#if (USE_TRACE_IPC == 1U)
+#if (USE_PRINTF == 0U)
+#include "trace_interface.h"
+#define PRINT_INFO(format, args...) TRACE_PRINT(DBG_CHAN_IPC, DBL_LVL_P0, "IPC SIM:" format "\n\r", ## args)
+#define PRINT_DBG(format, args...)  TRACE_PRINT(DBG_CHAN_IPC, DBL_LVL_P1, "IPC SIM:" format "\n\r", ## args)
+#define PRINT_ERR(format, args...)  TRACE_PRINT(DBG_CHAN_IPC, DBL_LVL_ERR, "IPC SIM ERROR:" format "\n\r", ## args)
+#else
+#define PRINT_INFO(format, args...)  (void) printf("IPC SIM:" format "\n\r", ## args);
+#define PRINT_DBG(...)   __NOP(); /* Nothing to do */
+#define PRINT_ERR(format, args...)   (void) printf("IPC SIM ERROR:" format "\n\r", ## args);
+#endif /* USE_PRINTF */
+#else
+#define PRINT_INFO(...)  __NOP(); /* Nothing to do */
+#define PRINT_DBG(...)   __NOP(); /* Nothing to do */
+#define PRINT_ERR(...)   __NOP(); /* Nothing to do */
+#endif /* USE_TRACE_IPC */
+
+/* Private variables ---------------------------------------------------------*/
+/* Information responses of the simulated modem
+ * commands not listed here and not managed by a specific function are answered with OK only
+ * Warning: most specific command first (table is searched in order)
+ */
+static const ipc_sim_rsp_t ipc_sim_rsp_table[] =
+{
+  {"+CGSN=",    "+CGSN: \"354000000000001\""},
+  {"+CGSN",     "354000000000001"},
+  {"+GSN",      "354000000000001"},
+  {"+CGMI",     "SIMULATOR"},
+  {"+CGMM",     "TYPE1SC-SIM"},
+  {"+CGMR",     "SIM_1.0"},
+  {"+CIMI",     "001010000000001"},
+  {"%CCID",     "%CCID: 89000000000000000001"},
+  {"+CPIN?",    "+CPIN: READY"},
+  {"+CFUN?",    "+CFUN: 1"},
+  {"+COPS?",    "+COPS: 0,0,\"SIMULATOR\",7"},
+  {"+CEREG?",   "+CEREG: 2,1"},
+  {"+CREG?",    "+CREG: 0,1"},
+  {"+CGREG?",   "+CGREG: 0,1"},
+  {"+CGATT?",   "+CGATT: 1"},
+  {"+CGPADDR",  "+CGPADDR: 1,\"" IPC_SIM_LOCAL_IP_ADDR "\""},
+};
+#define IPC_SIM_RSP_TABLE_SIZE ((uint8_t)(sizeof(ipc_sim_rsp_table) / sizeof(ipc_sim_rsp_t)))
+
+static osThreadId    ipc_sim_thread_id = NULL;
+static osMessageQId  ipc_sim_queue_id = NULL;
+static osMutexId     ipc_sim_cmd_mutex_id = NULL;
+static IPC_Device_t  ipc_sim_device;
+
+/* command received from the host: filled by IPC_SIM_send(), consumed by the simulator thread */
+static uint8_t  ipc_sim_cmd_received[IPC_SIM_CMD_MAXSIZE];
+static uint16_t ipc_sim_cmd_received_size = 0U;
+/* command being processed by the simulator thread */
+static IPC_SIM_CHAR_t ipc_sim_cmd[IPC_SIM_CMD_MAXSIZE + 1U];
+/* response being built by the simulator thread */
+static IPC_SIM_CHAR_t ipc_sim_rsp[IPC_SIM_RSP_MAXSIZE];
+
+static ipc_sim_socket_t ipc_sim_sockets[IPC_SIM_MAX_SOCKETS];
+static uint32_t ipc_sim_registration_due_tick = 0U;
+#if (IPC_SIM_LOSS_PER_MILLE != 0U)
+static uint32_t ipc_sim_random_seed = 0x12345678U;
+#endif /* IPC_SIM_LOSS_PER_MILLE != 0U */
+static IPC_SIM_Statistics_t ipc_sim_stats;
+static uint8_t ipc_sim_csq_rssi = 20U; /* +CSQ <rssi>: 20 is -73 dBm */
+#if (IPC_SIM_TCP_BRIDGE == 1U)
+static uint8_t ipc_sim_bridge_buffer[IPC_SIM_SOCKET_RXBUF_SIZE];
+#endif /* IPC_SIM_TCP_BRIDGE == 1U */
+/* recorded responses replayed instead of the Type1SC dialect, NULL: no replay */
+static IPC_SIM_ReplayRsp_t *p_ipc_sim_replay = NULL;
+static uint16_t ipc_sim_replay_nb = 0U;
+
+/* Global variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+static void ipc_sim_thread(void const *p_argument);
+static void ipc_sim_output(const IPC_SIM_CHAR_t *p_buf, uint16_t size);
+static void ipc_sim_output_line(const IPC_SIM_CHAR_t *p_line);
+static void ipc_sim_process_cmd(void);
+static uint8_t ipc_sim_split_params(IPC_SIM_CHAR_t *p_params, IPC_SIM_CHAR_t *p_argv[]);
+static ipc_sim_socket_t *ipc_sim_get_socket(const IPC_SIM_CHAR_t *p_id);
+static bool ipc_sim_socketcmd(IPC_SIM_CHAR_t *p_params);
+static bool ipc_sim_socketdata(IPC_SIM_CHAR_t *p_params);
+static void ipc_sim_process_events(void);
+static uint32_t ipc_sim_next_event_delay(void);
+static bool ipc_sim_is_lost(void);
+static void ipc_sim_replay_from(uint16_t first);
+static bool ipc_sim_replay_cmd(const IPC_SIM_CHAR_t *p_body);
+#if (IPC_SIM_TCP_BRIDGE == 1U)
+static void ipc_sim_bridge_open(ipc_sim_socket_t *p_socket);
+static void ipc_sim_bridge_close(ipc_sim_socket_t *p_socket);
+static bool ipc_sim_bridge_send(ipc_sim_socket_t *p_socket, const IPC_SIM_CHAR_t *p_hex, uint16_t length);
+static void ipc_sim_bridge_receive(uint8_t idx);
+#endif /* IPC_SIM_TCP_BRIDGE == 1U */
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief  Start the simulated modem (replace the UART reception start).
+  * @note   The simulator thread is created at first call with the highest priority
+  *         so that, as the UART interrupt, it is never preempted by the IPC reader.
+  * @param  hipc IPC handle.
+  * @retval status
+  */
+IPC_Status_t IPC_SIM_start(IPC_Handle_t *hipc)
+{
+  IPC_Status_t retval = IPC_OK;
+
+  ipc_sim_device = hipc->Device_ID;
+
+  if (ipc_sim_thread_id == NULL)
+  {
+    (void) memset((void *)ipc_sim_sockets, 0, sizeof(ipc_sim_sockets));
+    (void) memset((void *)&ipc_sim_stats, 0, sizeof(ipc_sim_stats));
+
+    ipc_sim_cmd_mutex_id = rtosalMutexNew((const rtosal_char_t *)"IPC_SIM_MUT_CMD");
+    ipc_sim_queue_id = rtosalMessageQueueNew((const rtosal_char_t *)"IPC_SIM_QUE_CMD", 4U);
+    if ((ipc_sim_cmd_mutex_id == NULL) || (ipc_sim_queue_id == NULL))
+    {
+      PRINT_ERR("simulator resources creation error")
+      retval = IPC_ERROR;
+    }
+    else
+    {
+      ipc_sim_thread_id = rtosalThreadNew((const rtosal_char_t *)"IPC_SIM", (os_pthread)ipc_sim_thread,
+                                          IPC_SIM_THREAD_PRIO, USED_IPC_SIM_THREAD_STACK_SIZE, NULL);
+      if (ipc_sim_thread_id == NULL)
+      {
+        PRINT_ERR("simulator thread creation error")
+        retval = IPC_ERROR;
+      }
+    }
+  }
+
+  return (retval);
+}
+
+/**
+  * @brief  Send data to the simulated modem (replace the UART transmission).
+  * @note   TX complete callback is called immediately.
+  * @param  hipc IPC handle.
+  * @param  p_TxBuffer Pointer to the data buffer to transfer.
+  * @param  bufsize Length of the data buffer.
+  * @retval status
+  */
+IPC_Status_t IPC_SIM_send(IPC_Handle_t *hipc, const uint8_t *p_TxBuffer, uint16_t bufsize)
+{
+  IPC_Status_t retval = IPC_OK;
+  bool cmd_complete = false;
+
+  (void) rtosalMutexAcquire(ipc_sim_cmd_mutex_id, RTOSAL_WAIT_FOREVER);
+  if ((ipc_sim_cmd_received_size + bufsize) <= IPC_SIM_CMD_MAXSIZE)
+  {
+    (void) memcpy((void *)&ipc_sim_cmd_received[ipc_sim_cmd_received_size], (const void *)p_TxBuffer,
+                  (size_t)bufsize);
+    ipc_sim_cmd_received_size += bufsize;
+    cmd_complete = (memchr((const void *)p_TxBuffer, (int32_t)'\r', (size_t)bufsize) != NULL);
+  }
+  else
+  {
+    PRINT_ERR("command too long for the simulator (%d bytes)", ipc_sim_cmd_received_size + bufsize)
+    ipc_sim_cmd_received_size = 0U;
+    retval = IPC_ERROR;
+  }
+  (void) rtosalMutexRelease(ipc_sim_cmd_mutex_id);
+
+  if (cmd_complete == true)
+  {
+    (void) rtosalMessageQueuePut(ipc_sim_queue_id, IPC_SIM_MSG_CMD, 0U);
+  }
+
+  /* transmission is immediate */
+  if (retval == IPC_OK)
+  {
+    hipc->TxClientCallback(hipc);
+  }
+
+  return (retval);
+}
+
+/**
+  * @brief  Set the signal quality answered to AT+CSQ.
+  * @param  rssi +CSQ <rssi> value (0 to 31, 99 if not known).
+  * @retval none
+  */
+void IPC_SIM_setSignalQuality(uint8_t rssi)
+{
+  ipc_sim_csq_rssi = rssi;
+}
+
+/**
+  * @brief  Replay recorded modem responses instead of playing the Type1SC dialect.
+  * @note   To call before the modem is started. An AT command is answered with the first
+  *         response not yet sent recorded for it, followed by the responses recorded after
+  *         it without command (URC, other lines of the answer). The responses recorded
+  *         before the first command are sent at modem boot.
+  * @param  p_rsp responses in the order they have been recorded.
+  * @param  nb number of responses.
+  * @retval none
+  */
+void IPC_SIM_replay(IPC_SIM_ReplayRsp_t *p_rsp, uint16_t nb)
+{
+  p_ipc_sim_replay = p_rsp;
+  ipc_sim_replay_nb = nb;
+}
+
+/**
+  * @brief  Get the simulator statistics.
+  * @param  p_stats statistics copy.
+  * @retval none
+  */
+void IPC_SIM_getStatistics(IPC_SIM_Statistics_t *p_stats)
+{
+  if (p_stats != NULL)
+  {
+    *p_stats = ipc_sim_stats;
+  }
+}
+
+/* Private function Definition -----------------------------------------------*/
+/**
+  * @brief  Simulator thread: answer AT commands and deliver delayed events.
+  * @param  p_argument - unused
+  * @retval none
+  */
+static void ipc_sim_thread(void const *p_argument)
+{
+  uint32_t msg;
+
+  UNUSED(p_argument);
+
+  /* modem boot indication */
+  (void) rtosalDelay(IPC_SIM_BOOT_DELAY);
+  if (p_ipc_sim_replay != NULL)
+  {
+    if ((ipc_sim_replay_nb != 0U) && (p_ipc_sim_replay[0].p_cmd == NULL))
+    {
+      ipc_sim_replay_from(0U);
+    }
+  }
+  else
+  {
+    ipc_sim_output_line("%BOOTEV:0");
+  }
+
+  for (;;)
+  {
+    msg = 0U;
+    (void) rtosalMessageQueueGet(ipc_sim_queue_id, &msg, ipc_sim_next_event_delay());
+    if (msg == IPC_SIM_MSG_CMD)
+    {
+      ipc_sim_process_cmd();
+    }
+    ipc_sim_process_events();
+  }
+}
+
+/**
+  * @brief  Write characters in the IPC RX FIFO at the simulated baud rate.
+  * @note   Waits while the IPC is paused (RX FIFO almost full), as UART reception does.
+  * @param  p_buf buffer to write.
+  * @param  size buffer size.
+  * @retval none
+  */
+static void ipc_sim_output(const IPC_SIM_CHAR_t *p_buf, uint16_t size)
+{
+  IPC_Handle_t *hipc;
+  uint32_t burst = (uint32_t)IPC_SIM_BAUDRATE / (IPC_SIM_BITS_PER_CHAR * 1000U); /* characters per ms */
+  uint32_t sent_in_burst = 0U;
+  uint16_t idx;
+
+  for (idx = 0U; idx < size; idx++)
+  {
+    hipc = IPC_DevicesList[ipc_sim_device].h_current_channel;
+    while ((hipc != NULL) && (hipc->State == IPC_STATE_PAUSED))
+    {
+      (void) rtosalDelay(1U);
+      ipc_sim_stats.paused_ms++;
+      hipc = IPC_DevicesList[ipc_sim_device].h_current_channel;
+    }
+    if (hipc != NULL)
+    {
+      hipc->RxFifoWrite(hipc, (uint8_t)p_buf[idx]);
+    }
+
+    sent_in_burst++;
+    if ((burst != 0U) && (sent_in_burst >= burst))
+    {
+      (void) rtosalDelay(1U);
+      sent_in_burst = 0U;
+    }
+  }
+}
+
+/**
+  * @brief  Write a response line <CR><LF>line<CR><LF>.
+  * @param  p_line line to write (null terminated).
+  * @retval none
+  */
+static void ipc_sim_output_line(const IPC_SIM_CHAR_t *p_line)
+{
+  ipc_sim_output("\r\n", 2U);
+  ipc_sim_output(p_line, (uint16_t)strlen(p_line));
+  ipc_sim_output("\r\n", 2U);
+}
+
+/**
+  * @brief  Process the AT command received.
+  * @retval none
+  */
+static void ipc_sim_process_cmd(void)
+{
+  IPC_SIM_CHAR_t *p_end;
+  IPC_SIM_CHAR_t *p_body;
+  uint16_t size;
+  uint8_t idx;
+  bool ok = true;
+  bool found = false;
+
+  /* take the first complete command */
+  (void) rtosalMutexAcquire(ipc_sim_cmd_mutex_id, RTOSAL_WAIT_FOREVER);
+  p_end = (IPC_SIM_CHAR_t *)memchr((const void *)ipc_sim_cmd_received, (int32_t)'\r',
+                                   (size_t)ipc_sim_cmd_received_size);
+  if (p_end != NULL)
+  {
+    size = (uint16_t)(p_end - (IPC_SIM_CHAR_t *)ipc_sim_cmd_received);
+    (void) memcpy((void *)ipc_sim_cmd, (const void *)ipc_sim_cmd_received, (size_t)size);
+    ipc_sim_cmd[size] = '\0';
+    ipc_sim_cmd_received_size -= (size + 1U);
+    (void) memmove((void *)ipc_sim_cmd_received, (const void *)&ipc_sim_cmd_received[size + 1U],
+                   (size_t)ipc_sim_cmd_received_size);
+    if (memchr((const void *)ipc_sim_cmd_received, (int32_t)'\r', (size_t)ipc_sim_cmd_received_size) != NULL)
+    {
+      /* another command is already available */
+      (void) rtosalMessageQueuePut(ipc_sim_queue_id, IPC_SIM_MSG_CMD, 0U);
+    }
+  }
+  (void) rtosalMutexRelease(ipc_sim_cmd_mutex_id);
+
+  /* only AT commands are answered */
+  if ((p_end != NULL) && (strncmp(ipc_sim_cmd, "AT", 2U) == 0))
+  {
+    ipc_sim_stats.cmd_count++;
+    PRINT_DBG("cmd: %.64s", ipc_sim_cmd) /* SEND commands are longer than a trace buffer */
+    p_body = &ipc_sim_cmd[2];
+
+    (void) rtosalDelay(IPC_SIM_RESPONSE_LATENCY);
+
+    if (p_ipc_sim_replay != NULL)
+    {
+      /* final result code is part of the recorded responses */
+      if (ipc_sim_replay_cmd(p_body) == false)
+      {
+        ipc_sim_stats.replay_unmatched++;
+        ipc_sim_output_line("ERROR");
+      }
+    }
+    else if (strncmp(p_body, "%SOCKETCMD=", 11U) == 0)
+    {
+      ok = ipc_sim_socketcmd(&p_body[11]);
+    }
+    else if (strncmp(p_body, "%SOCKETDATA=", 12U) == 0)
+    {
+      ok = ipc_sim_socketdata(&p_body[12]);
+    }
+    else if (strncmp(p_body, "%DNSRSLV=", 9U) == 0)
+    {
+      ipc_sim_stats.dns_count++;
+      ipc_sim_output_line("%DNSRSLV:0,\"" IPC_SIM_REMOTE_IP_ADDR "\"");
+    }
+    else if (strncmp(p_body, "+CSQ", 4U) == 0)
+    {
+      ipc_sim_stats.csq_count++;
+      (void) sprintf(ipc_sim_rsp, "+CSQ: %d,99", ipc_sim_csq_rssi);
+      ipc_sim_output_line(ipc_sim_rsp);
+    }
+    else
+    {
+      for (idx = 0U; (idx < IPC_SIM_RSP_TABLE_SIZE) && (found == false); idx++)
+      {
+        if (strncmp(p_body, ipc_sim_rsp_table[idx].p_cmd, strlen(ipc_sim_rsp_table[idx].p_cmd)) == 0)
+        {
+          ipc_sim_output_line(ipc_sim_rsp_table[idx].p_rsp);
+          found = true;
+        }
+      }
+
+      if (strncmp(p_body, "+CFUN=1", 7U) == 0)
+      {
+        /* network registration is reported after the network latency */
+        ipc_sim_registration_due_tick = rtosalGetSysTimerCount() + IPC_SIM_NETWORK_LATENCY + 1U;
+      }
+    }
+
+    if (p_ipc_sim_replay == NULL)
+    {
+      ipc_sim_output_line((ok == true) ? "OK" : "ERROR");
+    }
+  }
+}
+
+/**
+  * @brief  Split AT command parameters separated by commas (quotes are removed).
+  * @param  p_params parameters string (modified).
+  * @param  p_argv parameters found.
+  * @retval number of parameters found.
+  */
+static uint8_t ipc_sim_split_params(IPC_SIM_CHAR_t *p_params, IPC_SIM_CHAR_t *p_argv[])
+{
+  IPC_SIM_CHAR_t *p_cur = p_params;
+  uint8_t argc = 0U;
+  bool in_quotes = false;
+
+  p_argv[0] = p_cur;
+  argc = 1U;
+  while ((*p_cur != '\0') && (argc < IPC_SIM_MAX_PARAMS))
+  {
+    if (*p_cur == '"')
+    {
+      in_quotes = !in_quotes;
+      *p_cur = '\0';
+      if (in_quotes == true)
+      {
+        p_argv[argc - 1U] = &p_cur[1];
+      }
+    }
+    else if ((*p_cur == ',') && (in_quotes == false))
+    {
+      *p_cur = '\0';
+      p_argv[argc] = &p_cur[1];
+      argc++;
+    }
+    else
+    {
+      /* parameter character */
+    }
+    p_cur++;
+  }
+
+  return (argc);
+}
+
+/**
+  * @brief  Get simulated socket from its socket ID string.
+  * @param  p_id socket ID string.
+  * @retval socket or NULL if socket ID is invalid.
+  */
+static ipc_sim_socket_t *ipc_sim_get_socket(const IPC_SIM_CHAR_t *p_id)
+{
+  ipc_sim_socket_t *p_socket = NULL;
+  uint32_t socket_id = (uint32_t)strtoul(p_id, NULL, 10);
+
+  if ((socket_id >= 1U) && (socket_id <= IPC_SIM_MAX_SOCKETS))
+  {
+    if (ipc_sim_sockets[socket_id - 1U].allocated == 1U)
+    {
+      p_socket = &ipc_sim_sockets[socket_id - 1U];
+    }
+  }
+
+  return (p_socket);
+}
+
+/**
+  * @brief  Process AT%SOCKETCMD=<cmd>,...
+  * @param  p_params command parameters.
+  * @retval true if command is successful.
+  */
+static bool ipc_sim_socketcmd(IPC_SIM_CHAR_t *p_params)
+{
+  IPC_SIM_CHAR_t *p_argv[IPC_SIM_MAX_PARAMS];
+  ipc_sim_socket_t *p_socket;
+  uint8_t argc;
+  uint8_t idx;
+  bool ok = true;
+
+  argc = ipc_sim_split_params(p_params, p_argv);
+
+  if (strcmp(p_argv[0], "ALLOCATE") == 0)
+  {
+    /* "ALLOCATE",<cid>,<protocol>,<mode>,<ip>,<remote_port>,<local_port>,<packet_size> */
+    ok = false;
+    for (idx = 0U; (idx < IPC_SIM_MAX_SOCKETS) && (ok == false); idx++)
+    {
+      if (ipc_sim_sockets[idx].allocated == 0U)
+      {
+        p_socket = &ipc_sim_sockets[idx];
+        (void) memset((void *)p_socket, 0, sizeof(ipc_sim_socket_t) - IPC_SIM_SOCKET_RXBUF_SIZE);
+        p_socket->allocated = 1U;
+#if (IPC_SIM_TCP_BRIDGE == 1U)
+        p_socket->bridge_fd = IPC_SIM_BRIDGE_NONE;
+#endif /* IPC_SIM_TCP_BRIDGE == 1U */
+        p_socket->is_udp = ((argc > 2U) && (strcmp(p_argv[2], "UDP") == 0)) ? 1U : 0U;
+        if (argc > 4U)
+        {
+          (void) strncpy(p_socket->remote_ip, p_argv[4], IPC_SIM_IP_ADDR_MAXSIZE - 1U);
+        }
+        p_socket->remote_port = (argc > 5U) ? (uint16_t)strtoul(p_argv[5], NULL, 10) : 0U;
+        p_socket->local_port = (argc > 6U) ? (uint16_t)strtoul(p_argv[6], NULL, 10) : 0U;
+        (void) sprintf(ipc_sim_rsp, "%%SOCKETCMD:%d", idx + 1U);
+        ipc_sim_output_line(ipc_sim_rsp);
+        ok = true;
+      }
+    }
+  }
+  else
+  {
+    p_socket = (argc > 1U) ? ipc_sim_get_socket(p_argv[1]) : NULL;
+    if (p_socket == NULL)
+    {
+      ok = false;
+    }
+    else if (strcmp(p_argv[0], "ACTIVATE") == 0)
+    {
+      p_socket->activated = 1U;
+#if (IPC_SIM_TCP_BRIDGE == 1U)
+      ipc_sim_bridge_open(p_socket);
+#endif /* IPC_SIM_TCP_BRIDGE == 1U */
+    }
+    else if (strcmp(p_argv[0], "DEACTIVATE") == 0)
+    {
+      p_socket->activated = 0U;
+#if (IPC_SIM_TCP_BRIDGE == 1U)
+      ipc_sim_bridge_close(p_socket);
+#endif /* IPC_SIM_TCP_BRIDGE == 1U */
+    }
+    else if (strcmp(p_argv[0], "DELETE") == 0)
+    {
+      p_socket->allocated = 0U;
+      p_socket->activated = 0U;
+#if (IPC_SIM_TCP_BRIDGE == 1U)
+      ipc_sim_bridge_close(p_socket);
+#endif /* IPC_SIM_TCP_BRIDGE == 1U */
+    }
+    else if (strcmp(p_argv[0], "INFO") == 0)
+    {
+      (void) sprintf(ipc_sim_rsp, "%%SOCKETCMD:\"%s\",\"%s\",\"%s\",\"%s\",%d,%d",
+                     (p_socket->activated == 1U) ? "ACTIVATED" : "DEACTIVATED",
+                     (p_socket->is_udp == 1U) ? "UDP" : "TCP",
+                     IPC_SIM_LOCAL_IP_ADDR, p_socket->remote_ip,
+                     p_socket->local_port, p_socket->remote_port);
+      ipc_sim_output_line(ipc_sim_rsp);
+    }
+    else
+    {
+      /* other socket commands are accepted without effect */
+    }
+  }
+
+  return (ok);
+}
+
+/**
+  * @brief  Process AT%SOCKETDATA=<cmd>,...
+  * @param  p_params command parameters.
+  * @retval true if command is successful.
+  */
+static bool ipc_sim_socketdata(IPC_SIM_CHAR_t *p_params)
+{
+  IPC_SIM_CHAR_t *p_argv[IPC_SIM_MAX_PARAMS];
+  ipc_sim_socket_t *p_socket;
+  uint16_t length;
+  uint16_t free_size;
+  uint16_t rsp_size;
+  uint8_t argc;
+  bool ok = true;
+
+  argc = ipc_sim_split_params(p_params, p_argv);
+  p_socket = (argc > 2U) ? ipc_sim_get_socket(p_argv[1]) : NULL;
+
+  if ((p_socket == NULL) || (p_socket->activated == 0U))
+  {
+    ok = false;
+  }
+  else if ((strcmp(p_argv[0], "SEND") == 0) && (argc > 3U))
+  {
+    /* "SEND",<socket_id>,<length>,"<hex data>"[,"<ip>",<port>] */
+    length = (uint16_t)strtoul(p_argv[2], NULL, 10);
+    free_size = IPC_SIM_SOCKET_RXBUF_SIZE - p_socket->rx_available - p_socket->rx_in_flight;
+    if ((2U * (uint32_t)length) != (uint32_t)strlen(p_argv[3]))
+    {
+      ok = false;
+    }
+    else
+    {
+      ipc_sim_stats.tx_bytes += length;
+      ipc_sim_stats.tx_count++;
+      if (ipc_sim_is_lost() == true)
+      {
+        ipc_sim_stats.lost_packets++;
+      }
+#if (IPC_SIM_TCP_BRIDGE == 1U)
+      else if (p_socket->bridge_fd != IPC_SIM_BRIDGE_NONE)
+      {
+        ok = ipc_sim_bridge_send(p_socket, p_argv[3], length);
+      }
+#endif /* IPC_SIM_TCP_BRIDGE == 1U */
+      else if (length <= free_size)
+      {
+        /* echo data: decode it after the bytes already received or in flight */
+        if (ATutil_convertHexaStringToBuffer((const uint8_t *)p_argv[3], length,
+                                             &p_socket->rx_buffer[p_socket->rx_available +
+                                                                  p_socket->rx_in_flight]) == 0U)
+        {
+          if (p_socket->rx_in_flight == 0U)
+          {
+            p_socket->rx_due_tick = rtosalGetSysTimerCount() + IPC_SIM_NETWORK_LATENCY + 1U;
+          }
+          p_socket->rx_in_flight += length;
+        }
+      }
+      else
+      {
+        /* no room in the socket RX buffer: data dropped as on a real modem */
+        ipc_sim_stats.lost_packets++;
+      }
+      (void) sprintf(ipc_sim_rsp, "%%SOCKETDATA:%s,%d", p_argv[1], length);
+      ipc_sim_output_line(ipc_sim_rsp);
+    }
+  }
+  else if (strcmp(p_argv[0], "RECEIVE") == 0)
+  {
+    /* "RECEIVE",<socket_id>,<max_length> */
+    length = (uint16_t)strtoul(p_argv[2], NULL, 10);
+    if (length > p_socket->rx_available)
+    {
+      length = p_socket->rx_available;
+    }
+    rsp_size = (uint16_t)sprintf(ipc_sim_rsp, "%%SOCKETDATA:%s,%d,%d,\"", p_argv[1], length,
+                                 p_socket->rx_available - length);
+    ATutil_convertBufferToHexaString(p_socket->rx_buffer, length, (uint8_t *)&ipc_sim_rsp[rsp_size]);
+    rsp_size += (2U * length);
+    if (p_socket->is_udp == 1U)
+    {
+      (void) sprintf(&ipc_sim_rsp[rsp_size], "\",\"%s\",%d", p_socket->remote_ip, p_socket->remote_port);
+    }
+    else
+    {
+      (void) strcpy(&ipc_sim_rsp[rsp_size], "\"");
+    }
+    ipc_sim_output_line(ipc_sim_rsp);
+
+    /* consume data read */
+    p_socket->rx_available -= length;
+    (void) memmove((void *)p_socket->rx_buffer, (const void *)&p_socket->rx_buffer[length],
+                   (size_t)p_socket->rx_available + (size_t)p_socket->rx_in_flight);
+    ipc_sim_stats.rx_bytes += length;
+    ipc_sim_stats.rx_count++;
+  }
+  else
+  {
+    ok = false;
+  }
+
+  return (ok);
+}
+
+/**
+  * @brief  Deliver the events (URC) whose network latency is elapsed.
+  * @retval none
+  */
+static void ipc_sim_process_events(void)
+{
+  uint32_t now = rtosalGetSysTimerCount();
+  uint8_t idx;
+
+  if ((ipc_sim_registration_due_tick != 0U) && ((int32_t)(now - ipc_sim_registration_due_tick) >= 0))
+  {
+    ipc_sim_registration_due_tick = 0U;
+    ipc_sim_output_line("+CEREG: 1");
+  }
+
+  for (idx = 0U; idx < IPC_SIM_MAX_SOCKETS; idx++)
+  {
+    if ((ipc_sim_sockets[idx].rx_in_flight != 0U)
+        && ((int32_t)(now - ipc_sim_sockets[idx].rx_due_tick) >= 0))
+    {
+      ipc_sim_sockets[idx].rx_available += ipc_sim_sockets[idx].rx_in_flight;
+      ipc_sim_sockets[idx].rx_in_flight = 0U;
+      (void) sprintf(ipc_sim_rsp, "%%SOCKETEV:1,%d", idx + 1U);
+      ipc_sim_output_line(ipc_sim_rsp);
+    }
+#if (IPC_SIM_TCP_BRIDGE == 1U)
+    ipc_sim_bridge_receive(idx);
+#endif /* IPC_SIM_TCP_BRIDGE == 1U */
+  }
+}
+
+/**
+  * @brief  Compute the delay until the next pending event.
+  * @retval delay in ms or RTOSAL_WAIT_FOREVER if no event is pending.
+  */
+static uint32_t ipc_sim_next_event_delay(void)
+{
+  uint32_t now = rtosalGetSysTimerCount();
+  uint32_t delay = RTOSAL_WAIT_FOREVER;
+  int32_t remaining;
+  uint8_t idx;
+
+  if (ipc_sim_registration_due_tick != 0U)
+  {
+    remaining = (int32_t)(ipc_sim_registration_due_tick - now);
+    delay = (remaining > 0) ? (uint32_t)remaining : 1U;
+  }
+  for (idx = 0U; idx < IPC_SIM_MAX_SOCKETS; idx++)
+  {
+    if (ipc_sim_sockets[idx].rx_in_flight != 0U)
+    {
+      remaining = (int32_t)(ipc_sim_sockets[idx].rx_due_tick - now);
+      if ((remaining > 0) && ((uint32_t)remaining < delay))
+      {
+        delay = (uint32_t)remaining;
+      }
+      else if (remaining <= 0)
+      {
+        delay = 1U;
+      }
+      else
+      {
+        /* a nearer event is already pending */
+      }
+    }
+#if (IPC_SIM_TCP_BRIDGE == 1U)
+    if ((ipc_sim_sockets[idx].allocated == 1U) && (ipc_sim_sockets[idx].bridge_fd >= 0)
+        && (delay > IPC_SIM_BRIDGE_POLL_PERIOD))
+    {
+      /* bridged socket reception is polled */
+      delay = IPC_SIM_BRIDGE_POLL_PERIOD;
+    }
+#endif /* IPC_SIM_TCP_BRIDGE == 1U */
+  }
+
+  return (delay);
+}
+
+/**
+  * @brief  Loss simulation (pseudo random, reproducible between runs).
+  * @retval true if the packet is lost.
+  */
+static bool ipc_sim_is_lost(void)
+{
+  bool lost = false;
+
+#if (IPC_SIM_LOSS_PER_MILLE != 0U)
+  ipc_sim_random_seed = (ipc_sim_random_seed * 1103515245U) + 12345U;
+  lost = (((ipc_sim_random_seed >> 16) % 1000U) < IPC_SIM_LOSS_PER_MILLE);
+#endif /* IPC_SIM_LOSS_PER_MILLE != 0U */
+
+  return (lost);
+}
+
+/**
+  * @brief  Send a recorded response and the responses recorded after it without command.
+  * @param  first index of the first response to send.
+  * @retval none
+  */
+static void ipc_sim_replay_from(uint16_t first)
+{
+  uint16_t idx = first;
+
+  while ((idx < ipc_sim_replay_nb) && (p_ipc_sim_replay[idx].replayed == 0U)
+         && ((idx == first) || (p_ipc_sim_replay[idx].p_cmd == NULL)))
+  {
+    ipc_sim_output((const IPC_SIM_CHAR_t *)p_ipc_sim_replay[idx].p_data, p_ipc_sim_replay[idx].size);
+    p_ipc_sim_replay[idx].replayed = 1U;
+    idx++;
+  }
+}
+
+/**
+  * @brief  Answer an AT command with the first response recorded for it not yet sent.
+  * @param  p_body AT command without "AT".
+  * @retval false if no response is recorded for this command.
+  */
+static bool ipc_sim_replay_cmd(const IPC_SIM_CHAR_t *p_body)
+{
+  const IPC_SIM_CHAR_t *p_cmd;
+  uint16_t idx;
+  bool found = false;
+
+  for (idx = 0U; (idx < ipc_sim_replay_nb) && (found == false); idx++)
+  {
+    p_cmd = (const IPC_SIM_CHAR_t *)p_ipc_sim_replay[idx].p_cmd;
+    /* recorded command names are truncated: compared as a prefix, an empty name is "AT" alone */
+    if ((p_ipc_sim_replay[idx].replayed == 0U) && (p_cmd != NULL) && (strncmp(p_body, p_cmd, strlen(p_cmd)) == 0)
+        && ((p_cmd[0] != '\0') || (p_body[0] == '\0')))
+    {
+      ipc_sim_replay_from(idx);
+      found = true;
+    }
+  }
+
+  return (found);
+}
+
+#if (IPC_SIM_TCP_BRIDGE == 1U)
+/**
+  * @brief  Connect a simulated TCP socket to the local host server listening on its remote port.
+  * @note   Socket stays in echo mode if no server listens on this port.
+  * @param  p_socket simulated socket.
+  * @retval none
+  */
+static void ipc_sim_bridge_open(ipc_sim_socket_t *p_socket)
+{
+  struct sockaddr_in address;
+  int32_t fd;
+
+  if ((p_socket->is_udp == 0U) && (p_socket->bridge_fd < 0))
+  {
+    fd = (int32_t)socket(AF_INET, SOCK_STREAM, 0);
+    if (fd >= 0)
+    {
+      (void) memset((void *)&address, 0, sizeof(address));
+      address.sin_family = AF_INET;
+      address.sin_port = htons(p_socket->remote_port);
+      address.sin_addr.s_addr = inet_addr(IPC_SIM_BRIDGE_IP_ADDR);
+      if (connect(fd, (const struct sockaddr *)&address, (socklen_t)sizeof(address)) == 0)
+      {
+        p_socket->bridge_fd = fd;
+        PRINT_INFO("socket bridged to " IPC_SIM_BRIDGE_IP_ADDR ":%d", p_socket->remote_port)
+      }
+      else
+      {
+        (void) close(fd);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Close the local host connection of a simulated socket.
+  * @param  p_socket simulated socket.
+  * @retval none
+  */
+static void ipc_sim_bridge_close(ipc_sim_socket_t *p_socket)
+{
+  if (p_socket->bridge_fd >= 0)
+  {
+    (void) close(p_socket->bridge_fd);
+    p_socket->bridge_fd = IPC_SIM_BRIDGE_NONE;
+  }
+}
+
+/**
+  * @brief  Forward data of AT%SOCKETDATA="SEND" to the local host server.
+  * @param  p_socket simulated socket.
+  * @param  p_hex data in HEX format.
+  * @param  length data length (in bytes).
+  * @retval true if all data is sent (false once the connection is closed by the server).
+  */
+static bool ipc_sim_bridge_send(ipc_sim_socket_t *p_socket, const IPC_SIM_CHAR_t *p_hex, uint16_t length)
+{
+  bool ok = false;
+
+  if ((p_socket->bridge_fd >= 0) && (length <= IPC_SIM_SOCKET_RXBUF_SIZE)
+      && (ATutil_convertHexaStringToBuffer((const uint8_t *)p_hex, length, ipc_sim_bridge_buffer) == 0U))
+  {
+    ok = (send(p_socket->bridge_fd, ipc_sim_bridge_buffer, (size_t)length, MSG_NOSIGNAL) == (ssize_t)length);
+  }
+
+  return (ok);
+}
+
+/**
+  * @brief  Read the data received from the local host server, as the modem does from the network.
+  * @note   %SOCKETEV:1 announces new data, %SOCKETEV:3 the connection closed by the server.
+  * @param  idx simulated socket index.
+  * @retval none
+  */
+static void ipc_sim_bridge_receive(uint8_t idx)
+{
+  ipc_sim_socket_t *p_socket = &ipc_sim_sockets[idx];
+  uint16_t free_size;
+  ssize_t received;
+
+  if ((p_socket->allocated == 1U) && (p_socket->bridge_fd >= 0))
+  {
+    free_size = IPC_SIM_SOCKET_RXBUF_SIZE - p_socket->rx_available;
+    if (free_size != 0U)
+    {
+      received = recv(p_socket->bridge_fd, &p_socket->rx_buffer[p_socket->rx_available], (size_t)free_size,
+                      MSG_DONTWAIT);
+      if (received > 0)
+      {
+        p_socket->rx_available += (uint16_t)received;
+        (void) sprintf(ipc_sim_rsp, "%%SOCKETEV:1,%d", idx + 1U);
+        ipc_sim_output_line(ipc_sim_rsp);
+      }
+      else if (received == 0)
+      {
+        ipc_sim_bridge_close(p_socket);
+        p_socket->bridge_fd = IPC_SIM_BRIDGE_CLOSED;
+        (void) sprintf(ipc_sim_rsp, "%%SOCKETEV:3,%d", idx + 1U);
+        ipc_sim_output_line(ipc_sim_rsp);
+      }
+      else
+      {
+        /* nothing received */
+      }
+    }
+  }
+}
+#endif /* IPC_SIM_TCP_BRIDGE == 1U */
+
+#endif /* USE_MODEM_SIMULATOR == 1 */
+
+/******************************** END OF FILE *********************************/
@@ -28,6 +28,10 @@
 #include "rtosal.h"
 #endif /* RTOS_USED */
 
+#if (USE_MODEM_SIMULATOR == 1)
+#include "ipc_sim.h"
+#endif /* USE_MODEM_SIMULATOR == 1 */
+
 /* Private typedef -----------------------------------------------------------*/
 
 /* Private defines -----------------------------------------------------------*/
@@ -53,12 +57,24 @@
 #endif /* USE_TRACE_IPC */
 
 /* Private variables ---------------------------------------------------------*/
+/* linear copy of the message received when it wraps at the end of the RX FIFO */
+static uint8_t uart_rx_wrap_buffer[IPC_MAX_DEVICES][IPC_RXBUF_MAXSIZE];
+#if (IPC_USE_UART_DMA == 1U)
+/* circular buffers filled by DMA and read position of next char to write in the RX FIFO */
+static uint8_t  uart_dma_rx_buffer[IPC_MAX_DEVICES][IPC_UART_DMA_RXBUF_SIZE];
+static uint16_t uart_dma_rx_read_pos[IPC_MAX_DEVICES];
+#endif /* IPC_USE_UART_DMA == 1U */
 
 /* Global variables ----------------------------------------------------------*/
 
 /* Private function prototypes -----------------------------------------------*/
 static uint8_t find_Device_Id(const UART_HandleTypeDef *huart);
 static IPC_Status_t change_ipc_channel(IPC_Handle_t *hipc);
+static HAL_StatusTypeDef uart_receive_it(IPC_Handle_t *hipc);
+static void uart_abort_transmit_it(const IPC_Handle_t *hipc);
+#if (IPC_USE_UART_DMA == 1U)
+static void uart_dma_rx_process(uint8_t device_id);
+#endif /* IPC_USE_UART_DMA == 1U */
 
 /* Functions Definition ------------------------------------------------------*/
 /**
@@ -200,7 +216,11 @@ IPC_Status_t IPC_UART_open(IPC_Handle_t *hipc,
 #endif /* IPC_USE_STREAM_MODE */
 
     /* start RX IT */
-    uart_status = HAL_UART_Receive_IT(hipc->Interface.h_uart, (uint8_t *)IPC_DevicesList[device].RxChar, 1U);
+#if (USE_MODEM_SIMULATOR == 1)
+    uart_status = (IPC_SIM_start(hipc) == IPC_OK) ? HAL_OK : HAL_ERROR;
+#else
+    uart_status = uart_receive_it(hipc);
+#endif /* USE_MODEM_SIMULATOR == 1 */
     if (uart_status != HAL_OK)
     {
       PRINT_ERR("HAL_UART_Receive_IT error")
@@ -268,7 +288,7 @@ IPC_Status_t IPC_UART_close(IPC_Handle_t *hipc)
       {
         if (hipc->Interface.h_uart != NULL)
         {
-          (void)HAL_UART_AbortTransmit_IT(hipc->Interface.h_uart);
+          uart_abort_transmit_it(hipc);
         }
       }
 
@@ -315,7 +335,7 @@ IPC_Status_t IPC_UART_reset(IPC_Handle_t *hipc)
 #endif /* IPC_USE_STREAM_MODE */
 
     /* rearm IT */
-    (void) HAL_UART_Receive_IT(hipc->Interface.h_uart, (uint8_t *)IPC_DevicesList[device_id].RxChar, 1U);
+    (void) uart_receive_it(hipc);
     hipc->State = IPC_STATE_ACTIVE;
     retval = IPC_OK;
   }
@@ -336,7 +356,7 @@ IPC_Status_t IPC_UART_abort(IPC_Handle_t *hipc)
   {
     if (hipc->Interface.h_uart->gState != HAL_UART_STATE_RESET)
     {
-      (void)HAL_UART_AbortTransmit_IT(hipc->Interface.h_uart);
+      uart_abort_transmit_it(hipc);
     }
   }
 
@@ -405,14 +425,20 @@ IPC_Status_t IPC_UART_send(IPC_Handle_t *hipc, uint8_t *p_TxBuffer, uint16_t buf
 #endif /* RTOS_USED */
   {
     /* send string in one block */
+#if (USE_MODEM_SIMULATOR == 1)
+    retval = IPC_SIM_send(hipc, p_TxBuffer, bufsize);
+#else
     (void)HAL_UART_Transmit_IT(hipc->Interface.h_uart, (uint8_t *)p_TxBuffer, bufsize);
     retval = IPC_OK;
+#endif /* USE_MODEM_SIMULATOR == 1 */
   }
   return (retval);
 }
 
 /**
   * @brief  Receive a message from an UART channel.
+  * @note   No copy: the message stays in the RX FIFO until IPC_UART_release() is called.
+  *         Only a message wrapping at the end of the RX FIFO is copied to be contiguous.
   * @param  hipc IPC handle.
   * @param  p_msg Pointer to the IPC message structure to fill with received message.
   * @retval status
@@ -421,6 +447,7 @@ IPC_Status_t IPC_UART_receive(IPC_Handle_t *hipc, IPC_RxMessage_t *p_msg)
 {
   IPC_Status_t retval;
   int16_t unread_msg;
+  IPC_RxMessageView_t view;
 #if (DBG_IPC_RX_FIFO == 1U)
   int16_t free_bytes;
 #endif /* DBG_IPC_RX_FIFO */
@@ -440,8 +467,8 @@ IPC_Status_t IPC_UART_receive(IPC_Handle_t *hipc, IPC_RxMessage_t *p_msg)
       PRINT_DBG("free_bytes before msg read=%d", free_bytes)
 #endif /* DBG_IPC_RX_FIFO */
 
-      /* read the first unread message */
-      unread_msg = IPC_RXFIFO_read(hipc, p_msg);
+      /* get the first unread message */
+      unread_msg = IPC_RXFIFO_getMsg(hipc, &view);
       if (unread_msg == -1)
       {
         PRINT_ERR("IPC_receive err - no unread msg")
@@ -449,20 +476,20 @@ IPC_Status_t IPC_UART_receive(IPC_Handle_t *hipc, IPC_RxMessage_t *p_msg)
       }
       else
       {
-#if (DBG_IPC_RX_FIFO == 1U)
-        free_bytes = IPC_RXFIFO_getFreeBytes(hipc);
-        PRINT_DBG("free bytes after msg read=%d", free_bytes)
-#endif /* DBG_IPC_RX_FIFO */
-
-        if (hipc->State == IPC_STATE_PAUSED)
+        p_msg->size = view.part_size[0] + view.part_size[1];
+        if (view.part_size[1] == 0U)
         {
-#if (DBG_IPC_RX_FIFO == 1U)
-          /* dump_RX_dbg_infos(hipc, 1, 1); */
-          PRINT_INFO("Resume IPC (paused %d times) %d unread msg", hipc->dbgRxQueue.cpt_RXPause, unread_msg)
-#endif /* DBG_IPC_RX_FIFO */
-
-          hipc->State = IPC_STATE_ACTIVE;
-          (void) HAL_UART_Receive_IT(hipc->Interface.h_uart, (uint8_t *)IPC_DevicesList[hipc->Device_ID].RxChar, 1U);
+          /* message is contiguous in the RX FIFO */
+          p_msg->buffer = view.p_part[0];
+        }
+        else
+        {
+          /* message wraps at the end of the RX FIFO */
+          (void) memcpy((void *)&uart_rx_wrap_buffer[hipc->Device_ID][0],
+                        (const void *)view.p_part[0], (size_t)view.part_size[0]);
+          (void) memcpy((void *)&uart_rx_wrap_buffer[hipc->Device_ID][view.part_size[0]],
+                        (const void *)view.p_part[1], (size_t)view.part_size[1]);
+          p_msg->buffer = &uart_rx_wrap_buffer[hipc->Device_ID][0];
         }
 
         if (unread_msg == 0)
@@ -485,6 +512,50 @@ IPC_Status_t IPC_UART_receive(IPC_Handle_t *hipc, IPC_RxMessage_t *p_msg)
   return (retval);
 }
 
+/**
+  * @brief  Release the message returned by IPC_UART_receive().
+  * @param  hipc IPC handle.
+  * @retval status
+  */
+IPC_Status_t IPC_UART_release(IPC_Handle_t *hipc)
+{
+  IPC_Status_t retval;
+#if (DBG_IPC_RX_FIFO == 1U)
+  int16_t free_bytes;
+#endif /* DBG_IPC_RX_FIFO */
+
+  if (hipc->Mode == IPC_MODE_UART_CHARACTER)
+  {
+    /* free message place in the RX FIFO */
+    IPC_RXFIFO_releaseMsg(hipc);
+
+#if (DBG_IPC_RX_FIFO == 1U)
+    free_bytes = IPC_RXFIFO_getFreeBytes(hipc);
+    PRINT_DBG("free bytes after msg read=%d", free_bytes)
+#endif /* DBG_IPC_RX_FIFO */
+
+    if (hipc->State == IPC_STATE_PAUSED)
+    {
+#if (DBG_IPC_RX_FIFO == 1U)
+      /* dump_RX_dbg_infos(hipc, 1, 1); */
+      PRINT_INFO("Resume IPC (paused %d times) %d unread msg", hipc->dbgRxQueue.cpt_RXPause,
+                 hipc->RxQueue.nb_unread_msg)
+#endif /* DBG_IPC_RX_FIFO */
+
+      hipc->State = IPC_STATE_ACTIVE;
+      (void) uart_receive_it(hipc);
+    }
+    retval = IPC_OK;
+  }
+  else
+  {
+    PRINT_ERR("IPC_release err - IPC mode not matching")
+    retval = IPC_ERROR;
+  }
+
+  return (retval);
+}
+
 #if (IPC_USE_STREAM_MODE == 1U)
 /**
   * @brief  Receive a data buffer from an UART channel.
@@ -553,7 +624,7 @@ void IPC_UART_rearm_RX_IT(IPC_Handle_t *hipc)
     /* rearm uart TX interrupt */
     if (hipc->Interface.interface_type == IPC_INTERFACE_UART)
     {
-      (void)HAL_UART_Receive_IT(hipc->Interface.h_uart, (uint8_t *)IPC_DevicesList[hipc->Device_ID].RxChar, 1U);
+      (void) uart_receive_it(hipc);
     }
   }
 }
@@ -634,14 +705,62 @@ void IPC_UART_RxCpltCallback(UART_HandleTypeDef *UartHandle)
   uint8_t device_id = find_Device_Id(UartHandle);
   if (device_id < IPC_MAX_DEVICES)
   {
+#if (IPC_USE_UART_DMA == 1U)
+    /* DMA reached the end of the circular buffer */
+    uart_dma_rx_process(device_id);
+#else
     if (IPC_DevicesList[device_id].h_current_channel != NULL)
     {
       IPC_DevicesList[device_id].h_current_channel->RxFifoWrite(IPC_DevicesList[device_id].h_current_channel,
                                                                 IPC_DevicesList[device_id].RxChar[0]);
     }
+#endif /* IPC_USE_UART_DMA == 1U */
+  }
+}
+
+#if (IPC_USE_UART_DMA == 1U)
+/**
+  * @brief  IPC uart RX half complete callback (called under IT !).
+  * @note   DMA reached the middle of the circular buffer.
+  * @param  UartHandle Ptr to the HAL UART handle.
+  * @retval none
+  */
+void IPC_UART_RxHalfCpltCallback(UART_HandleTypeDef *UartHandle)
+{
+  /* Warning ! this function is called under IT */
+  uint8_t device_id = find_Device_Id(UartHandle);
+  if (device_id < IPC_MAX_DEVICES)
+  {
+    uart_dma_rx_process(device_id);
   }
 }
 
+/**
+  * @brief  IPC uart idle line detection (called under IT !).
+  * @note   To call from the UART IRQ handler, before HAL_UART_IRQHandler().
+  *         Chars received by DMA are processed when the line becomes idle (end of modem answer)
+  *         or when the IRQ is set pending by software to resume a paused reception.
+  * @param  UartHandle Ptr to the HAL UART handle.
+  * @retval none
+  */
+void IPC_UART_IdleLineIRQHandler(UART_HandleTypeDef *UartHandle)
+{
+  /* Warning ! this function is called under IT */
+  uint8_t device_id;
+
+  /* idle line interrupt is only enabled on UART used by IPC in DMA mode */
+  if (__HAL_UART_GET_IT_SOURCE(UartHandle, UART_IT_IDLE) != 0U)
+  {
+    __HAL_UART_CLEAR_IDLEFLAG(UartHandle);
+    device_id = find_Device_Id(UartHandle);
+    if (device_id < IPC_MAX_DEVICES)
+    {
+      uart_dma_rx_process(device_id);
+    }
+  }
+}
+#endif /* IPC_USE_UART_DMA == 1U */
+
 /**
   * @brief  IPC uart TX callback (called under IT !).
   * @param  UartHandle Ptr to the HAL UART handle.
@@ -671,8 +790,20 @@ void IPC_UART_TxCpltCallback(UART_HandleTypeDef *UartHandle)
   */
 void IPC_UART_ErrorCallback(UART_HandleTypeDef *UartHandle)
 {
-  UNUSED(UartHandle);
   /* Warning ! this function is called under IT */
+#if (IPC_USE_UART_DMA == 1U)
+  /* DMA reception has been stopped by HAL on error: restart it */
+  uint8_t device_id = find_Device_Id(UartHandle);
+  if (device_id < IPC_MAX_DEVICES)
+  {
+    if (IPC_DevicesList[device_id].h_current_channel != NULL)
+    {
+      (void) uart_receive_it(IPC_DevicesList[device_id].h_current_channel);
+    }
+  }
+#else
+  UNUSED(UartHandle);
+#endif /* IPC_USE_UART_DMA == 1U */
 }
 
 /* Private function Definition -----------------------------------------------*/
@@ -725,5 +856,112 @@ static IPC_Status_t change_ipc_channel(IPC_Handle_t *hipc)
   return (IPC_OK);
 }
 
+/**
+  * brief  Start reception of next character on the UART.
+  * note   No UART reception when the modem simulator is used.
+  * param  hipc IPC handle.
+  * retval HAL status
+  */
+static HAL_StatusTypeDef uart_receive_it(IPC_Handle_t *hipc)
+{
+#if (USE_MODEM_SIMULATOR == 1)
+  UNUSED(hipc);
+  return (HAL_OK);
+#elif (IPC_USE_UART_DMA == 1U)
+  HAL_StatusTypeDef status = HAL_OK;
+  UART_HandleTypeDef *huart = hipc->Interface.h_uart;
+
+  if (huart->RxState == HAL_UART_STATE_READY)
+  {
+    /* start circular DMA reception and idle line detection */
+    uart_dma_rx_read_pos[hipc->Device_ID] = 0U;
+    status = HAL_UART_Receive_DMA(huart, uart_dma_rx_buffer[hipc->Device_ID], IPC_UART_DMA_RXBUF_SIZE);
+    if (status == HAL_OK)
+    {
+      __HAL_UART_CLEAR_IDLEFLAG(huart);
+      __HAL_UART_ENABLE_IT(huart, UART_IT_IDLE);
+    }
+  }
+  else if (HAL_IS_BIT_CLR(huart->Instance->CR3, USART_CR3_DMAR))
+  {
+    /* reception paused: resume it, chars waiting in DMA buffer are processed under IT */
+    status = HAL_UART_DMAResume(huart);
+    HAL_NVIC_SetPendingIRQ(MODEM_UART_IRQN);
+  }
+  else
+  {
+    /* DMA reception is running: nothing to rearm */
+  }
+  return (status);
+#else
+  return (HAL_UART_Receive_IT(hipc->Interface.h_uart, (uint8_t *)IPC_DevicesList[hipc->Device_ID].RxChar, 1U));
+#endif /* USE_MODEM_SIMULATOR == 1 */
+}
+
+/**
+  * brief  Abort ongoing UART transmission.
+  * note   Nothing to abort when the modem simulator is used (transmission is immediate).
+  * param  hipc IPC handle.
+  * retval none
+  */
+static void uart_abort_transmit_it(const IPC_Handle_t *hipc)
+{
+#if (USE_MODEM_SIMULATOR == 1)
+  UNUSED(hipc);
+#else
+  (void)HAL_UART_AbortTransmit_IT(hipc->Interface.h_uart);
+#endif /* USE_MODEM_SIMULATOR == 1 */
+}
+
+#if (IPC_USE_UART_DMA == 1U)
+/**
+  * brief  Write chars received by DMA in the RX FIFO (called under IT).
+  * note   If the RX FIFO becomes paused, DMA requests are stopped: the UART RTS line
+  *        stops the modem until the reception is resumed by IPC_UART_receive().
+  * param  device_id IPC device identifier.
+  * retval none
+  */
+static void uart_dma_rx_process(uint8_t device_id)
+{
+  IPC_Handle_t *hipc = IPC_DevicesList[device_id].h_current_channel;
+  UART_HandleTypeDef *huart = IPC_DevicesList[device_id].phy_int.h_uart;
+  uint16_t read_pos = uart_dma_rx_read_pos[device_id];
+  uint16_t write_pos;
+  uint16_t size;
+  uint16_t written;
+
+  if ((hipc != NULL) && (huart->hdmarx != NULL))
+  {
+    /* DMA counter: number of chars before the end of the circular buffer */
+    write_pos = (IPC_UART_DMA_RXBUF_SIZE - (uint16_t)__HAL_DMA_GET_COUNTER(huart->hdmarx)) % IPC_UART_DMA_RXBUF_SIZE;
+
+    while ((read_pos != write_pos) && (hipc->State != IPC_STATE_PAUSED))
+    {
+      /* contiguous chars available */
+      size = (write_pos > read_pos) ? (write_pos - read_pos) : (IPC_UART_DMA_RXBUF_SIZE - read_pos);
+
+      if (hipc->Mode == IPC_MODE_UART_CHARACTER)
+      {
+        written = IPC_RXFIFO_writeBuffer(hipc, &uart_dma_rx_buffer[device_id][read_pos], size);
+      }
+      else
+      {
+        for (written = 0U; written < size; written++)
+        {
+          hipc->RxFifoWrite(hipc, uart_dma_rx_buffer[device_id][read_pos + written]);
+        }
+      }
+      read_pos = (read_pos + written) % IPC_UART_DMA_RXBUF_SIZE;
+    }
+    uart_dma_rx_read_pos[device_id] = read_pos;
+
+    if (hipc->State == IPC_STATE_PAUSED)
+    {
+      (void) HAL_UART_DMAPause(huart);
+    }
+  }
+}
+#endif /* IPC_USE_UART_DMA == 1U */
+
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
 
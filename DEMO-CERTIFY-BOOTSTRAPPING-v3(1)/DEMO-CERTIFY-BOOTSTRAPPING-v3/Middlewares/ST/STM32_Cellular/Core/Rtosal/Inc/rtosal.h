@@ -28,6 +28,10 @@ extern "C" {
 /* Includes ------------------------------------------------------------------*/
 #include <stdint.h>
 
+#if defined(RTOSAL_POSIX)
+/* Host build: CMSIS RTOS V1 types are provided by the POSIX implementation */
+#include "rtosal_posix.h"
+#else
 /* FreeRTOS headers are included in order to avoid warning during compilation */
 /* FreeRTOS is a Third Party so MISRAC messages linked to it are ignored */
 /*cstat -MISRAC2012-* */
@@ -39,6 +43,7 @@ extern "C" {
 #include "semphr.h"
 #include "event_groups.h"
 /*cstat +MISRAC2012-* */
+#endif /* defined(RTOSAL_POSIX) */
 
 /* Exported constants --------------------------------------------------------*/
 /* MISRAC 2012 issue link to osWaitForever usage */
@@ -102,6 +107,28 @@ osThreadId rtosalThreadNew(const rtosal_char_t *p_name, os_pthread func, osPrior
   */
 rtosalStatus rtosalThreadTerminate(osThreadId thread_id);
 
+/**
+  * @brief  Return the thread ID of the current running thread.
+  * @retval osThreadId - thread ID for reference by other functions or NULL in case of error.
+  */
+osThreadId rtosalThreadGetId(void);
+
+/**
+  * @brief  Get current priority of a thread.
+  * @param  thread_id  - thread ID obtained by rtosalThreadNew or rtosalThreadGetId.
+  * @retval osPriority - current priority value of the thread.
+  */
+osPriority rtosalThreadGetPriority(osThreadId thread_id);
+
+/**
+  * @brief  Change priority of a thread.
+  * @param  thread_id    - thread ID obtained by rtosalThreadNew or rtosalThreadGetId.
+  * @param  priority     - new priority value of the thread.
+  * @note   Only CMSIS RTOS V1 osPriority values should be used.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  */
+rtosalStatus rtosalThreadSetPriority(osThreadId thread_id, osPriority priority);
+
 
 /********************************* SEMAPHORE **********************************/
 /**
@@ -0,0 +1,94 @@
+/**
+  ******************************************************************************
+  * @file           rtosal_posix.h
+  * @author         artworkTrackingMAP
+  * @brief          CMSIS RTOS V1 compatible types used by rtosal when it is
+  *                 built for a POSIX host (RTOSAL_POSIX defined).
+  * @note           Only the types and values used by Cellular are provided.
+  *                 Values are identical to CMSIS RTOS V1 cmsis_os.h.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef RTOSAL_POSIX_H
+#define RTOSAL_POSIX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Host implementation behaves as CMSIS RTOS V1: all osCMSIS < 0x20000U code is used */
+#define osCMSIS           0x10002
+
+/* Wait forever timeout value */
+#define osWaitForever     0xFFFFFFFF
+
+/* Exported types ------------------------------------------------------------*/
+/* Priority used for thread control */
+typedef enum
+{
+  osPriorityIdle          = -3,
+  osPriorityLow           = -2,
+  osPriorityBelowNormal   = -1,
+  osPriorityNormal        =  0,
+  osPriorityAboveNormal   = +1,
+  osPriorityHigh          = +2,
+  osPriorityRealtime      = +3,
+  osPriorityError         =  0x84
+} osPriority;
+
+/* Status code values returned by rtosal functions */
+typedef enum
+{
+  osOK                    =     0,
+  osEventSignal           =  0x08,
+  osEventMessage          =  0x10,
+  osEventMail             =  0x20,
+  osEventTimeout          =  0x40,
+  osErrorParameter        =  0x80,
+  osErrorResource         =  0x81,
+  osErrorTimeoutResource  =  0xC1,
+  osErrorISR              =  0x82,
+  osErrorISRRecursive     =  0x83,
+  osErrorPriority         =  0x84,
+  osErrorNoMemory         =  0x85,
+  osErrorValue            =  0x86,
+  osErrorOS               =  0xFF,
+  os_status_reserved      =  0x7FFFFFFF
+} osStatus;
+
+/* Timer type */
+typedef enum
+{
+  osTimerOnce             =     0,
+  osTimerPeriodic         =     1
+} os_timer_type;
+
+/* Entry point of a thread */
+typedef void (*os_pthread)(void const *argument);
+
+/* Entry point of a timer callback function */
+typedef void (*os_ptimer)(void const *argument);
+
+/* Objects are opaque: they are allocated and managed by rtosal_posix.c */
+typedef struct rtosal_posix_thread_s    *osThreadId;
+typedef struct rtosal_posix_sync_s      *osSemaphoreId;
+typedef struct rtosal_posix_sync_s      *osMutexId;
+typedef struct rtosal_posix_queue_s     *osMessageQId;
+typedef struct rtosal_posix_timer_s     *osTimerId;
+
+/* Stack unit: rtosalThreadNew stacksize is expressed in StackType_t */
+typedef uint32_t StackType_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTOSAL_POSIX_H */
+
+/******************************** END OF FILE *********************************/
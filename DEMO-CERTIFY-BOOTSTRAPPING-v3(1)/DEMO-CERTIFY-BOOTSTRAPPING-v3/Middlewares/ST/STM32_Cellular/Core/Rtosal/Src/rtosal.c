@@ -22,6 +22,8 @@
 /* Includes ------------------------------------------------------------------*/
 #include "rtosal.h"
 
+#if !defined(RTOSAL_POSIX)
+
 /* Private typedef -----------------------------------------------------------*/
 
 /* Private defines -----------------------------------------------------------*/
@@ -141,6 +143,43 @@ rtosalStatus rtosalThreadTerminate(osThreadId thread_id)
   return (status);
 }
 
+/**
+  * @brief  Return the thread ID of the current running thread.
+  * @retval osThreadId - thread ID for reference by other functions or NULL in case of error.
+  */
+osThreadId rtosalThreadGetId(void)
+{
+  osThreadId retval;
+  retval = osThreadGetId();
+  return (retval);
+}
+
+/**
+  * @brief  Get current priority of a thread.
+  * @param  thread_id  - thread ID obtained by rtosalThreadNew or rtosalThreadGetId.
+  * @retval osPriority - current priority value of the thread.
+  */
+osPriority rtosalThreadGetPriority(osThreadId thread_id)
+{
+  osPriority retval;
+  retval = osThreadGetPriority(thread_id);
+  return (retval);
+}
+
+/**
+  * @brief  Change priority of a thread.
+  * @param  thread_id    - thread ID obtained by rtosalThreadNew or rtosalThreadGetId.
+  * @param  priority     - new priority value of the thread.
+  * @note   Only CMSIS RTOS V1 osPriority values should be used.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  */
+rtosalStatus rtosalThreadSetPriority(osThreadId thread_id, osPriority priority)
+{
+  rtosalStatus status;
+  status = osThreadSetPriority(thread_id, priority);
+  return (status);
+}
+
 /********************************* SEMAPHORE **********************************/
 
 /**
@@ -486,4 +525,6 @@ rtosalStatus rtosalDelay(uint32_t ticks)
   return (status);
 }
 
+#endif /* !defined(RTOSAL_POSIX) */
+
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,990 @@
+/**
+  ******************************************************************************
+  * @file           rtosal_posix.c
+  * @author         artworkTrackingMAP
+  * @brief          This file provides a POSIX host implementation of rtosal
+  *                 (pthread for threads and synchronization objects,
+  *                 timerfd/epoll for timers).
+  * @note           It implementents only the services used by Cellular and
+  *                 follows CMSIS RTOS V1 return values.
+  *                 It is compiled only when RTOSAL_POSIX is defined.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rtosal.h"
+
+#if defined(RTOSAL_POSIX)
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+
+/* Private typedef -----------------------------------------------------------*/
+/* Thread object */
+struct rtosal_posix_thread_s
+{
+  pthread_t  thread;
+  os_pthread func;
+  void      *p_arg;
+  char       name[16]; /* host thread names are limited to 15 characters */
+  osPriority priority; /* stored only: not applied to the host scheduling */
+};
+
+/* Semaphore and Mutex object: a counter protected by a mutex/condition */
+struct rtosal_posix_sync_s
+{
+  pthread_mutex_t lock;
+  pthread_cond_t  cond;
+  uint32_t        count;
+  uint32_t        max_count;
+};
+
+/* Message queue object: ring buffer of 32-bit messages */
+struct rtosal_posix_queue_s
+{
+  pthread_mutex_t lock;
+  pthread_cond_t  not_empty;
+  pthread_cond_t  not_full;
+  uint32_t       *p_msg;
+  uint32_t        size;
+  uint32_t        head;
+  uint32_t        count;
+};
+
+/* Timer object: one timerfd, callbacks are called by the timer daemon thread */
+struct rtosal_posix_timer_s
+{
+  int32_t       fd;
+  os_ptimer     func;
+  void         *p_arg;
+  os_timer_type type;
+  struct rtosal_posix_timer_s *p_next_deleted;
+};
+
+/* Private defines -----------------------------------------------------------*/
+#define RTOSAL_POSIX_NSEC_PER_MSEC   (1000000L)
+#define RTOSAL_POSIX_NSEC_PER_SEC    (1000000000L)
+#define RTOSAL_POSIX_TIMER_EVENTS    (8)
+
+/* Private macros ------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+/* Kernel start gate: threads created before rtosalKernelStart() wait for it,
+   as tasks created before the FreeRTOS scheduler start */
+static pthread_mutex_t rtosal_posix_kernel_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  rtosal_posix_kernel_cond = PTHREAD_COND_INITIALIZER;
+static uint8_t         rtosal_posix_kernel_started = 0U;
+static struct timespec rtosal_posix_kernel_origin;
+
+/* Timer daemon: serializes callbacks as the FreeRTOS timer task does */
+static pthread_once_t  rtosal_posix_timer_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t rtosal_posix_timer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t       rtosal_posix_timer_thread;
+static int32_t         rtosal_posix_timer_epoll = -1;
+/* Wakes the daemon up so that deleted timers are released even if no timer expires */
+static int32_t         rtosal_posix_timer_wakeup = -1;
+/* Deleted timers: released by the daemon only, once it owns the lock,
+   because epoll_wait may have returned them before the deletion */
+static struct rtosal_posix_timer_s *rtosal_posix_timer_deleted = NULL;
+
+/* Thread object of the calling thread (NULL for threads not created by rtosal) */
+static __thread struct rtosal_posix_thread_s *rtosal_posix_thread_self = NULL;
+/* Thread object given by rtosalThreadGetId to threads not created by rtosal (e.g. main) */
+static __thread struct rtosal_posix_thread_s rtosal_posix_thread_foreign;
+
+/* Global variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+static void rtosal_posix_deadline(uint32_t timeout, struct timespec *p_deadline);
+static void rtosal_posix_cond_init(pthread_cond_t *p_cond);
+static void *rtosal_posix_thread_entry(void *p_arg);
+static struct rtosal_posix_sync_s *rtosal_posix_sync_new(uint32_t count, uint32_t max_count);
+static rtosalStatus rtosal_posix_sync_acquire(struct rtosal_posix_sync_s *p_sync, uint32_t timeout);
+static rtosalStatus rtosal_posix_sync_release(struct rtosal_posix_sync_s *p_sync);
+static rtosalStatus rtosal_posix_sync_delete(struct rtosal_posix_sync_s *p_sync);
+static void rtosal_posix_timer_init(void);
+static void *rtosal_posix_timer_daemon(void *p_arg);
+
+/* Private function Definition -----------------------------------------------*/
+/**
+  * @brief  Compute an absolute CLOCK_MONOTONIC deadline.
+  * @param  timeout    - timeout value (in ms), must not be RTOSAL_WAIT_FOREVER.
+  * @param  p_deadline - deadline computed.
+  * @retval -
+  */
+static void rtosal_posix_deadline(uint32_t timeout, struct timespec *p_deadline)
+{
+  (void)clock_gettime(CLOCK_MONOTONIC, p_deadline);
+  p_deadline->tv_sec += (time_t)(timeout / 1000U);
+  p_deadline->tv_nsec += (long)(timeout % 1000U) * RTOSAL_POSIX_NSEC_PER_MSEC;
+  if (p_deadline->tv_nsec >= RTOSAL_POSIX_NSEC_PER_SEC)
+  {
+    p_deadline->tv_sec++;
+    p_deadline->tv_nsec -= RTOSAL_POSIX_NSEC_PER_SEC;
+  }
+}
+
+/**
+  * @brief  Initialize a condition variable using CLOCK_MONOTONIC.
+  * @param  p_cond - condition to initialize.
+  * @retval -
+  */
+static void rtosal_posix_cond_init(pthread_cond_t *p_cond)
+{
+  pthread_condattr_t attr;
+
+  (void)pthread_condattr_init(&attr);
+  (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  (void)pthread_cond_init(p_cond, &attr);
+  (void)pthread_condattr_destroy(&attr);
+}
+
+/**
+  * @brief  Thread trampoline: wait the kernel start then call the thread function.
+  * @note   The thread object is owned by the thread: it is released when the
+  *         thread function returns or when the thread terminates itself.
+  * @param  p_arg - thread object.
+  * @retval NULL
+  */
+static void *rtosal_posix_thread_entry(void *p_arg)
+{
+  struct rtosal_posix_thread_s *p_thread = (struct rtosal_posix_thread_s *)p_arg;
+
+  rtosal_posix_thread_self = p_thread;
+#if defined(_GNU_SOURCE)
+  if (p_thread->name[0] != '\0')
+  {
+    (void)pthread_setname_np(pthread_self(), p_thread->name);
+  }
+#endif /* defined(_GNU_SOURCE) */
+
+  (void)pthread_mutex_lock(&rtosal_posix_kernel_lock);
+  while (rtosal_posix_kernel_started == 0U)
+  {
+    (void)pthread_cond_wait(&rtosal_posix_kernel_cond, &rtosal_posix_kernel_lock);
+  }
+  (void)pthread_mutex_unlock(&rtosal_posix_kernel_lock);
+
+  p_thread->func((void const *)p_thread->p_arg);
+
+  rtosal_posix_thread_self = NULL;
+  free(p_thread);
+
+  return (NULL);
+}
+
+/**
+  * @brief  Create a counter based synchronization object (semaphore or mutex).
+  * @param  count     - initial count.
+  * @param  max_count - maximum count.
+  * @retval object created or NULL in case of error.
+  */
+static struct rtosal_posix_sync_s *rtosal_posix_sync_new(uint32_t count, uint32_t max_count)
+{
+  struct rtosal_posix_sync_s *p_sync;
+
+  p_sync = (struct rtosal_posix_sync_s *)malloc(sizeof(struct rtosal_posix_sync_s));
+  if (p_sync != NULL)
+  {
+    (void)pthread_mutex_init(&p_sync->lock, NULL);
+    rtosal_posix_cond_init(&p_sync->cond);
+    p_sync->count = count;
+    p_sync->max_count = max_count;
+  }
+
+  return (p_sync);
+}
+
+/**
+  * @brief  Take one token of a synchronization object.
+  * @param  p_sync  - object.
+  * @param  timeout - timeout value (in ms) or 0 in case of no time-out.
+  * @retval rtosalStatus - osOK, osErrorOS if no token is available, osErrorParameter.
+  */
+static rtosalStatus rtosal_posix_sync_acquire(struct rtosal_posix_sync_s *p_sync, uint32_t timeout)
+{
+  rtosalStatus status = osOK;
+  struct timespec deadline;
+  int32_t ret = 0;
+
+  if (p_sync == NULL)
+  {
+    status = osErrorParameter;
+  }
+  else
+  {
+    if ((timeout != 0U) && (timeout != RTOSAL_WAIT_FOREVER))
+    {
+      rtosal_posix_deadline(timeout, &deadline);
+    }
+    (void)pthread_mutex_lock(&p_sync->lock);
+    while ((p_sync->count == 0U) && (timeout != 0U) && (ret == 0))
+    {
+      if (timeout == RTOSAL_WAIT_FOREVER)
+      {
+        ret = pthread_cond_wait(&p_sync->cond, &p_sync->lock);
+      }
+      else
+      {
+        ret = pthread_cond_timedwait(&p_sync->cond, &p_sync->lock, &deadline);
+      }
+    }
+    if (p_sync->count != 0U)
+    {
+      p_sync->count--;
+    }
+    else
+    {
+      status = osErrorOS;
+    }
+    (void)pthread_mutex_unlock(&p_sync->lock);
+  }
+
+  return (status);
+}
+
+/**
+  * @brief  Give back one token of a synchronization object.
+  * @param  p_sync - object.
+  * @retval rtosalStatus - osOK, osErrorOS if max count is already reached, osErrorParameter.
+  */
+static rtosalStatus rtosal_posix_sync_release(struct rtosal_posix_sync_s *p_sync)
+{
+  rtosalStatus status = osOK;
+
+  if (p_sync == NULL)
+  {
+    status = osErrorParameter;
+  }
+  else
+  {
+    (void)pthread_mutex_lock(&p_sync->lock);
+    if (p_sync->count < p_sync->max_count)
+    {
+      p_sync->count++;
+      (void)pthread_cond_signal(&p_sync->cond);
+    }
+    else
+    {
+      status = osErrorOS;
+    }
+    (void)pthread_mutex_unlock(&p_sync->lock);
+  }
+
+  return (status);
+}
+
+/**
+  * @brief  Delete a synchronization object.
+  * @param  p_sync - object.
+  * @retval rtosalStatus - osOK or osErrorParameter.
+  */
+static rtosalStatus rtosal_posix_sync_delete(struct rtosal_posix_sync_s *p_sync)
+{
+  rtosalStatus status = osOK;
+
+  if (p_sync == NULL)
+  {
+    status = osErrorParameter;
+  }
+  else
+  {
+    (void)pthread_cond_destroy(&p_sync->cond);
+    (void)pthread_mutex_destroy(&p_sync->lock);
+    free(p_sync);
+  }
+
+  return (status);
+}
+
+/**
+  * @brief  Create the timer daemon (called once).
+  * @retval -
+  */
+static void rtosal_posix_timer_init(void)
+{
+  struct epoll_event event;
+
+  rtosal_posix_timer_epoll = (int32_t)epoll_create1(EPOLL_CLOEXEC);
+  rtosal_posix_timer_wakeup = (int32_t)eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+  /* wake-up event is the only one with a NULL data pointer */
+  event.events = EPOLLIN;
+  event.data.ptr = NULL;
+  if ((rtosal_posix_timer_epoll >= 0) && (rtosal_posix_timer_wakeup >= 0)
+      && (epoll_ctl(rtosal_posix_timer_epoll, EPOLL_CTL_ADD, rtosal_posix_timer_wakeup, &event) == 0)
+      && (pthread_create(&rtosal_posix_timer_thread, NULL, rtosal_posix_timer_daemon, NULL) == 0))
+  {
+    (void)pthread_detach(rtosal_posix_timer_thread);
+  }
+  else
+  {
+    if (rtosal_posix_timer_wakeup >= 0)
+    {
+      (void)close(rtosal_posix_timer_wakeup);
+      rtosal_posix_timer_wakeup = -1;
+    }
+    if (rtosal_posix_timer_epoll >= 0)
+    {
+      (void)close(rtosal_posix_timer_epoll);
+      rtosal_posix_timer_epoll = -1;
+    }
+  }
+}
+
+/**
+  * @brief  Timer daemon: wait timerfd expirations and call the timer callbacks.
+  * @param  p_arg - unused.
+  * @retval NULL
+  */
+static void *rtosal_posix_timer_daemon(void *p_arg)
+{
+  struct epoll_event events[RTOSAL_POSIX_TIMER_EVENTS];
+  struct rtosal_posix_timer_s *p_timer;
+  uint64_t expirations;
+  int32_t nb_events;
+  int32_t i;
+
+  (void)p_arg;
+
+  for (;;)
+  {
+    nb_events = (int32_t)epoll_wait(rtosal_posix_timer_epoll, events, RTOSAL_POSIX_TIMER_EVENTS, -1);
+    (void)pthread_mutex_lock(&rtosal_posix_timer_lock);
+    for (i = 0; i < nb_events; i++)
+    {
+      p_timer = (struct rtosal_posix_timer_s *)events[i].data.ptr;
+      if (p_timer == NULL)
+      {
+        /* Wake-up after a deletion: deleted list is released below */
+        (void)read(rtosal_posix_timer_wakeup, &expirations, sizeof(expirations));
+      }
+      /* Timer may have been deleted or stopped since epoll_wait returned:
+         a deleted timer is still allocated until the end of this batch */
+      else if ((p_timer->fd >= 0)
+          && (read(p_timer->fd, &expirations, sizeof(expirations)) == (ssize_t)sizeof(expirations)))
+      {
+        p_timer->func((void const *)p_timer->p_arg);
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    while (rtosal_posix_timer_deleted != NULL)
+    {
+      p_timer = rtosal_posix_timer_deleted;
+      rtosal_posix_timer_deleted = p_timer->p_next_deleted;
+      free(p_timer);
+    }
+    (void)pthread_mutex_unlock(&rtosal_posix_timer_lock);
+  }
+
+  return (NULL);
+}
+
+/* Functions Definition ------------------------------------------------------*/
+
+/*********************************** KERNEL ***********************************/
+
+/**
+  * @brief  Initialize the RTOS kernel.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  */
+rtosalStatus rtosalKernelInitialize(void)
+{
+  (void)clock_gettime(CLOCK_MONOTONIC, &rtosal_posix_kernel_origin);
+  return (osOK);
+}
+
+/**
+  * @brief  Start the RTOS kernel scheduler.
+  * @note   Unlike FreeRTOS, this function returns: created threads are released
+  *         and the caller (e.g. a host benchmark main) keeps running.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  */
+rtosalStatus rtosalKernelStart(void)
+{
+  (void)pthread_mutex_lock(&rtosal_posix_kernel_lock);
+  if ((rtosal_posix_kernel_origin.tv_sec == 0) && (rtosal_posix_kernel_origin.tv_nsec == 0))
+  {
+    (void)clock_gettime(CLOCK_MONOTONIC, &rtosal_posix_kernel_origin);
+  }
+  rtosal_posix_kernel_started = 1U;
+  (void)pthread_cond_broadcast(&rtosal_posix_kernel_cond);
+  (void)pthread_mutex_unlock(&rtosal_posix_kernel_lock);
+
+  return (osOK);
+}
+
+/**
+  * @brief  Get the RTOS kernel system timer count.
+  * @note   One tick is one millisecond as configTICK_RATE_HZ on target.
+  * @retval uint32_t - RTOS kernel current system timer count as 32-bit value.
+  */
+uint32_t rtosalGetSysTimerCount(void)
+{
+  struct timespec now;
+  int64_t elapsed_ms;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  elapsed_ms = ((int64_t)(now.tv_sec - rtosal_posix_kernel_origin.tv_sec) * 1000)
+               + ((int64_t)(now.tv_nsec - rtosal_posix_kernel_origin.tv_nsec) / RTOSAL_POSIX_NSEC_PER_MSEC);
+
+  return ((uint32_t)elapsed_ms);
+}
+
+/*********************************** THREAD ***********************************/
+
+/**
+  * @brief  Create a Thread and Add it to Active Threads.
+  * @note   The thread is detached. Priority is stored but not mapped (host default scheduling policy).
+  *         As a FreeRTOS task handle, the thread ID is no more valid once the thread ended.
+  * @param  p_name     - thread name.
+  * @param  func       - thread function.
+  * @param  priority   - initial thread priority.
+  * @param  stacksize  - stack size requirements in StackType_t unit.
+  * @note   Host default stack size is kept when it is bigger than the requested one.
+  * @param  p_arg      - argument passed to the thread function when it is started.
+  * @retval osThreadId - thread ID for reference by other functions or NULL in case of error.
+  */
+osThreadId rtosalThreadNew(const rtosal_char_t *p_name, os_pthread func, osPriority priority, uint32_t stacksize,
+                           void *p_arg)
+{
+  struct rtosal_posix_thread_s *p_thread;
+  pthread_attr_t attr;
+  size_t default_size = 0U;
+  size_t requested_size = (size_t)stacksize * sizeof(StackType_t);
+
+  p_thread = (struct rtosal_posix_thread_s *)malloc(sizeof(struct rtosal_posix_thread_s));
+  if (p_thread != NULL)
+  {
+    p_thread->func = func;
+    p_thread->p_arg = p_arg;
+    p_thread->priority = priority;
+    p_thread->name[0] = '\0';
+    if (p_name != NULL)
+    {
+      /* Name is truncated to 15 characters by the host */
+      (void)strncpy(p_thread->name, (const char *)p_name, sizeof(p_thread->name) - 1U);
+      p_thread->name[sizeof(p_thread->name) - 1U] = '\0';
+    }
+
+    (void)pthread_attr_init(&attr);
+    (void)pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    (void)pthread_attr_getstacksize(&attr, &default_size);
+    if (requested_size > default_size)
+    {
+      (void)pthread_attr_setstacksize(&attr, requested_size);
+    }
+    /* Once created, the object belongs to the thread (it may already be released
+       when pthread_create returns): it is no more accessed here */
+    if (pthread_create(&p_thread->thread, &attr, rtosal_posix_thread_entry, p_thread) != 0)
+    {
+      free(p_thread);
+      p_thread = NULL;
+    }
+    (void)pthread_attr_destroy(&attr);
+  }
+
+  return (p_thread);
+}
+
+/**
+  * @brief  Terminate execution of a thread and remove it from Active Threads.
+  * @note   Only self termination (thread_id of the caller or NULL) is supported.
+  * @param  thread_id    - thread ID obtained by rtosalThreadNew.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  */
+rtosalStatus rtosalThreadTerminate(osThreadId thread_id)
+{
+  rtosalStatus status = osErrorOS;
+
+  if ((thread_id == NULL) || (thread_id == rtosal_posix_thread_self))
+  {
+    /* thread object is released by its own thread before exit */
+    free(rtosal_posix_thread_self);
+    rtosal_posix_thread_self = NULL;
+    pthread_exit(NULL);
+  }
+
+  return (status);
+}
+
+/**
+  * @brief  Return the thread ID of the current running thread.
+  * @note   A thread not created by rtosalThreadNew gets a thread ID valid until it ends,
+  *         its initial priority is osPriorityNormal.
+  * @retval osThreadId - thread ID for reference by other functions.
+  */
+osThreadId rtosalThreadGetId(void)
+{
+  osThreadId thread_id = rtosal_posix_thread_self;
+
+  if (thread_id == NULL)
+  {
+    thread_id = &rtosal_posix_thread_foreign;
+  }
+
+  return (thread_id);
+}
+
+/**
+  * @brief  Get current priority of a thread.
+  * @param  thread_id  - thread ID obtained by rtosalThreadNew or rtosalThreadGetId.
+  * @retval osPriority - current priority value of the thread, osPriorityError if thread_id is NULL.
+  */
+osPriority rtosalThreadGetPriority(osThreadId thread_id)
+{
+  osPriority priority = osPriorityError;
+
+  if (thread_id != NULL)
+  {
+    priority = __atomic_load_n(&thread_id->priority, __ATOMIC_RELAXED);
+  }
+
+  return (priority);
+}
+
+/**
+  * @brief  Change priority of a thread.
+  * @note   The priority is stored only: host threads keep the default scheduling policy.
+  * @param  thread_id    - thread ID obtained by rtosalThreadNew or rtosalThreadGetId.
+  * @param  priority     - new priority value of the thread.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  */
+rtosalStatus rtosalThreadSetPriority(osThreadId thread_id, osPriority priority)
+{
+  rtosalStatus status = osErrorParameter;
+
+  if ((thread_id != NULL) && (priority != osPriorityError))
+  {
+    __atomic_store_n(&thread_id->priority, priority, __ATOMIC_RELAXED);
+    status = osOK;
+  }
+
+  return (status);
+}
+
+/********************************* SEMAPHORE **********************************/
+
+/**
+  * @brief  Create and Initialize a Semaphore object.
+  * @param  p_name        - semaphore name (unused).
+  * @param  count         - number of available resources.
+  * @note   At creation semaphore max count is set to count.
+  * @retval osSemaphoreId - semaphore ID for reference by other functions or NULL in case of error.
+  */
+osSemaphoreId rtosalSemaphoreNew(const rtosal_char_t *p_name, uint32_t count)
+{
+  (void)(p_name);
+  return (rtosal_posix_sync_new(count, count));
+}
+
+/**
+  * @brief  Acquire a Semaphore token or timeout if no tokens are available.
+  * @param  semaphore_id - semaphore ID obtained by rtosalSemaphoreNew.
+  * @param  timeout      - timeout value (in ms) or 0 in case of no time-out.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  * @note   As with CMSIS RTOS V1, this function returns osErrorOS when no token is available.
+  */
+rtosalStatus rtosalSemaphoreAcquire(osSemaphoreId semaphore_id, uint32_t timeout)
+{
+  return (rtosal_posix_sync_acquire(semaphore_id, timeout));
+}
+
+/**
+  * @brief  Release a Semaphore token.
+  * @param  semaphore_id - semaphore ID obtained by rtosalSemaphoreNew.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  */
+rtosalStatus rtosalSemaphoreRelease(osSemaphoreId semaphore_id)
+{
+  return (rtosal_posix_sync_release(semaphore_id));
+}
+
+/**
+  * @brief  Delete a Semaphore object.
+  * @param  semaphore_id - semaphore ID obtained by rtosalSemaphoreNew.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  */
+rtosalStatus rtosalSemaphoreDelete(osSemaphoreId semaphore_id)
+{
+  return (rtosal_posix_sync_delete(semaphore_id));
+}
+
+/*********************************** MUTEX ************************************/
+
+/**
+  * @brief  Create and Initialize a Mutex object.
+  * @note   Non-recursive mutex without priority inheritance.
+  * @param  p_name    - mutex name (unused).
+  * @retval osMutexId - mutex ID for reference by other functions or NULL in case of error.
+  */
+osMutexId rtosalMutexNew(const rtosal_char_t *p_name)
+{
+  (void)(p_name);
+  return (rtosal_posix_sync_new(1U, 1U));
+}
+
+/**
+  * @brief  Acquire a Mutex or timeout if it is locked.
+  * @param  mutex_id     - mutex ID obtained by rtosalMutexNew.
+  * @param  timeout      - timeout value (in ms) or 0 in case of no time-out.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  * @note   As with CMSIS RTOS V1, this function returns osErrorOS when no mutex is available.
+  */
+rtosalStatus rtosalMutexAcquire(osMutexId mutex_id, uint32_t timeout)
+{
+  return (rtosal_posix_sync_acquire(mutex_id, timeout));
+}
+
+/**
+  * @brief  Release a Mutex that was acquired by rtosalMutexAcquire.
+  * @param  mutex_id     - mutex ID obtained by rtosalMutexNew.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  */
+rtosalStatus rtosalMutexRelease(osMutexId mutex_id)
+{
+  return (rtosal_posix_sync_release(mutex_id));
+}
+
+/**
+  * @brief  Delete a Mutex object.
+  * @param  mutex_id - mutex ID obtained by rtosalMutexNew.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  */
+rtosalStatus rtosalMutexDelete(osMutexId mutex_id)
+{
+  return (rtosal_posix_sync_delete(mutex_id));
+}
+
+/******************************* MESSAGE QUEUE ********************************/
+
+/**
+  * @brief  Create and Initialize a Message Queue object.
+  * @note   This implementation supports 32-bit sized messages only.
+  * @param  p_name       - message queue name (unused).
+  * @param  queue_size   - maximum number of messages in queue.
+  * @retval osMessageQId - message queue ID for reference by other functions or NULL in case of error.
+  */
+osMessageQId rtosalMessageQueueNew(const rtosal_char_t *p_name, uint32_t queue_size)
+{
+  struct rtosal_posix_queue_s *p_queue = NULL;
+
+  (void)(p_name);
+
+  if (queue_size != 0U)
+  {
+    p_queue = (struct rtosal_posix_queue_s *)malloc(sizeof(struct rtosal_posix_queue_s));
+    if (p_queue != NULL)
+    {
+      p_queue->p_msg = (uint32_t *)malloc((size_t)queue_size * sizeof(uint32_t));
+      if (p_queue->p_msg == NULL)
+      {
+        free(p_queue);
+        p_queue = NULL;
+      }
+      else
+      {
+        (void)pthread_mutex_init(&p_queue->lock, NULL);
+        rtosal_posix_cond_init(&p_queue->not_empty);
+        rtosal_posix_cond_init(&p_queue->not_full);
+        p_queue->size = queue_size;
+        p_queue->head = 0U;
+        p_queue->count = 0U;
+      }
+    }
+  }
+
+  return (p_queue);
+}
+
+/**
+  * @brief Put a Message into a Queue or timeout if Queue is full.
+  * @param mq_id         - message queue ID obtained by rtosalMessageNew.
+  * @param msg           - message to put into a queue.
+  * @param timeout       - timeout value (in ms) or 0 in case of no time-out.
+  * @note  As with CMSIS RTOS V1, a timeout of 0 waits at least one tick.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  * @note   As with CMSIS RTOS V1, this function returns osErrorOS if the queue is full.
+  */
+rtosalStatus rtosalMessageQueuePut(osMessageQId mq_id, uint32_t msg, uint32_t timeout)
+{
+  rtosalStatus status = osOK;
+  struct timespec deadline;
+  int32_t ret = 0;
+
+  if (mq_id == NULL)
+  {
+    status = osErrorParameter;
+  }
+  else
+  {
+    if (timeout != RTOSAL_WAIT_FOREVER)
+    {
+      rtosal_posix_deadline((timeout == 0U) ? 1U : timeout, &deadline);
+    }
+    (void)pthread_mutex_lock(&mq_id->lock);
+    while ((mq_id->count == mq_id->size) && (ret == 0))
+    {
+      if (timeout == RTOSAL_WAIT_FOREVER)
+      {
+        ret = pthread_cond_wait(&mq_id->not_full, &mq_id->lock);
+      }
+      else
+      {
+        ret = pthread_cond_timedwait(&mq_id->not_full, &mq_id->lock, &deadline);
+      }
+    }
+    if (mq_id->count < mq_id->size)
+    {
+      mq_id->p_msg[(mq_id->head + mq_id->count) % mq_id->size] = msg;
+      mq_id->count++;
+      (void)pthread_cond_signal(&mq_id->not_empty);
+    }
+    else
+    {
+      status = osErrorOS;
+    }
+    (void)pthread_mutex_unlock(&mq_id->lock);
+  }
+
+  return (status);
+}
+
+/**
+  * @brief Get a Message from a Queue or timeout if Queue is empty.
+  * @param mq_id         - message queue id obtained by rtosalMessageNew.
+  * @param p_msg         - pointer to buffer for message to get from a queue.
+  * @param timeout       - timeout value (in ms) or 0 in case of no time-out.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  * @note  As with CMSIS RTOS V1, this function returns osEventMessage if a msg is available,
+  *        osEventTimeout on timeout and osOK if queue is empty and timeout is 0.
+  */
+rtosalStatus rtosalMessageQueueGet(osMessageQId mq_id, uint32_t *p_msg, uint32_t timeout)
+{
+  rtosalStatus status;
+  struct timespec deadline;
+  int32_t ret = 0;
+
+  if ((mq_id == NULL) || (p_msg == NULL))  /* Check parameter */
+  {
+    status = osErrorParameter;
+  }
+  else
+  {
+    if ((timeout != 0U) && (timeout != RTOSAL_WAIT_FOREVER))
+    {
+      rtosal_posix_deadline(timeout, &deadline);
+    }
+    (void)pthread_mutex_lock(&mq_id->lock);
+    while ((mq_id->count == 0U) && (timeout != 0U) && (ret == 0))
+    {
+      if (timeout == RTOSAL_WAIT_FOREVER)
+      {
+        ret = pthread_cond_wait(&mq_id->not_empty, &mq_id->lock);
+      }
+      else
+      {
+        ret = pthread_cond_timedwait(&mq_id->not_empty, &mq_id->lock, &deadline);
+      }
+    }
+    if (mq_id->count != 0U)
+    {
+      *p_msg = mq_id->p_msg[mq_id->head];
+      mq_id->head = (mq_id->head + 1U) % mq_id->size;
+      mq_id->count--;
+      (void)pthread_cond_signal(&mq_id->not_full);
+      status = osEventMessage;
+    }
+    else
+    {
+      status = (timeout == 0U) ? osOK : osEventTimeout;
+    }
+    (void)pthread_mutex_unlock(&mq_id->lock);
+  }
+
+  return (status);
+}
+
+/*********************************** TIMER ************************************/
+
+/**
+  * @brief Create and Initialize a Timer object.
+  * @param   p_name   - timer name (unused).
+  * @param   func     - function pointer to timer callback function.
+  * @param   type     - osTimerOnce for one-shot or osTimerPeriodic for periodic behavior
+  * @param   p_arg    - argument passed to the timer callback function when it is called.
+  * @retval osTimerId - timer ID for reference by other functions or NULL in case of error.
+  */
+osTimerId rtosalTimerNew(const rtosal_char_t *p_name, os_ptimer func, os_timer_type type, void *p_arg)
+{
+  struct rtosal_posix_timer_s *p_timer = NULL;
+  struct epoll_event event;
+
+  (void)(p_name);
+
+  (void)pthread_once(&rtosal_posix_timer_once, rtosal_posix_timer_init);
+  if ((rtosal_posix_timer_epoll >= 0) && (func != NULL))
+  {
+    p_timer = (struct rtosal_posix_timer_s *)malloc(sizeof(struct rtosal_posix_timer_s));
+    if (p_timer != NULL)
+    {
+      p_timer->fd = (int32_t)timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+      p_timer->func = func;
+      p_timer->p_arg = p_arg;
+      p_timer->type = type;
+      p_timer->p_next_deleted = NULL;
+      event.events = EPOLLIN;
+      event.data.ptr = p_timer;
+      if ((p_timer->fd < 0)
+          || (epoll_ctl(rtosal_posix_timer_epoll, EPOLL_CTL_ADD, p_timer->fd, &event) != 0))
+      {
+        if (p_timer->fd >= 0)
+        {
+          (void)close(p_timer->fd);
+        }
+        free(p_timer);
+        p_timer = NULL;
+      }
+    }
+  }
+
+  return (p_timer);
+}
+
+/**
+  * @brief Start or Restart a Timer.
+  * @param  timer_id     - timer ID obtained by rtosalTimerNew.
+  * @param  ticks        - "time ticks" value of the timer (1 tick = 1 ms).
+  * @retval rtosalStatus - indicate the execution status of the function.
+  */
+rtosalStatus rtosalTimerStart(osTimerId timer_id, uint32_t ticks)
+{
+  rtosalStatus status = osOK;
+  struct itimerspec value;
+  uint32_t period = (ticks == 0U) ? 1U : ticks;
+
+  if (timer_id == NULL)
+  {
+    status = osErrorParameter;
+  }
+  else
+  {
+    value.it_value.tv_sec = (time_t)(period / 1000U);
+    value.it_value.tv_nsec = (long)(period % 1000U) * RTOSAL_POSIX_NSEC_PER_MSEC;
+    if (timer_id->type == osTimerPeriodic)
+    {
+      value.it_interval = value.it_value;
+    }
+    else
+    {
+      value.it_interval.tv_sec = 0;
+      value.it_interval.tv_nsec = 0;
+    }
+    if (timerfd_settime(timer_id->fd, 0, &value, NULL) != 0)
+    {
+      status = osErrorOS;
+    }
+  }
+
+  return (status);
+}
+
+/**
+  * @brief Stop a Timer.
+  * @param  timer_id     - timer ID obtained by rtosalTimerNew.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  * @note   As with CMSIS RTOS V1, this function returns osOK if the timer is not started.
+  */
+rtosalStatus rtosalTimerStop(osTimerId timer_id)
+{
+  rtosalStatus status = osOK;
+  struct itimerspec value;
+
+  if (timer_id == NULL)
+  {
+    status = osErrorParameter;
+  }
+  else
+  {
+    (void)memset(&value, 0, sizeof(value));
+    if (timerfd_settime(timer_id->fd, 0, &value, NULL) != 0)
+    {
+      status = osErrorOS;
+    }
+  }
+
+  return (status);
+}
+
+/**
+  * @brief Delete a Timer object.
+  * @param   timer_id    - timer ID obtained by rtosalTimerNew.
+  * @retval rtosalStatus - indicate the execution status of the function.
+  */
+rtosalStatus rtosalTimerDelete(osTimerId timer_id)
+{
+  rtosalStatus status = osOK;
+  uint8_t in_daemon;
+
+  if (timer_id == NULL)
+  {
+    status = osErrorParameter;
+  }
+  else
+  {
+    /* Deletion from a timer callback: daemon lock is already owned */
+    in_daemon = (pthread_equal(rtosal_posix_timer_thread, pthread_self()) != 0) ? 1U : 0U;
+    if (in_daemon == 0U)
+    {
+      (void)pthread_mutex_lock(&rtosal_posix_timer_lock);
+    }
+    (void)epoll_ctl(rtosal_posix_timer_epoll, EPOLL_CTL_DEL, timer_id->fd, NULL);
+    (void)close(timer_id->fd);
+    /* Object may still be referenced by events already returned to the daemon:
+       it is only unlinked here and released by the daemon under its lock */
+    timer_id->fd = -1;
+    timer_id->p_next_deleted = rtosal_posix_timer_deleted;
+    rtosal_posix_timer_deleted = timer_id;
+    if (in_daemon == 0U)
+    {
+      (void)pthread_mutex_unlock(&rtosal_posix_timer_lock);
+      (void)eventfd_write(rtosal_posix_timer_wakeup, 1U);
+    }
+  }
+
+  return (status);
+}
+
+/*********************************** DELAY ************************************/
+
+/**
+  * @brief Wait for Timeout (Time Delay).
+  * @param ticks         - "time ticks" value (1 tick = 1 ms).
+  * @retval rtosalStatus - indicate the execution status of the function.
+  */
+rtosalStatus rtosalDelay(uint32_t ticks)
+{
+  struct timespec delay;
+
+  delay.tv_sec = (time_t)(ticks / 1000U);
+  delay.tv_nsec = (long)(ticks % 1000U) * RTOSAL_POSIX_NSEC_PER_MSEC;
+  while (nanosleep(&delay, &delay) != 0)
+  {
+    /* interrupted by a signal: sleep the remaining time */
+  }
+
+  return (osOK);
+}
+
+#endif /* defined(RTOSAL_POSIX) */
+
+/******************************** END OF FILE *********************************/
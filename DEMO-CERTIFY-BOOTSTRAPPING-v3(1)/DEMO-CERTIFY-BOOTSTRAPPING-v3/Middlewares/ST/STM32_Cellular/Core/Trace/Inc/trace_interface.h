@@ -55,6 +55,21 @@ typedef uint8_t dbg_levels_t;
 /* Maximum buffer size (per channel) */
 #define DBG_IF_MAX_BUFFER_SIZE  (uint16_t)(256)
 
+/* UART traces deferred: queued in a ring per channel and sent by the trace thread */
+#if !defined TRACE_IF_DEFERRED
+#define TRACE_IF_DEFERRED       (0U)
+#endif /* !defined TRACE_IF_DEFERRED */
+
+/* Tokenized traces: TRACE_TOKEN sends a format string ID and its arguments in binary */
+#if !defined TRACE_IF_TOKENIZED
+#define TRACE_IF_TOKENIZED      (0U)
+#endif /* !defined TRACE_IF_TOKENIZED */
+
+/* Maximum number of arguments of a tokenized trace */
+#define TRACE_IF_TOKEN_MAX_ARGS (8U)
+/* First byte of a tokenized trace record: never present in a text trace */
+#define TRACE_IF_TOKEN_SYNC     (0xFEU)
+
 /* Exported types ------------------------------------------------------------*/
 
 /* Define here the list of 32 ITM channels (0 to 31) */
@@ -191,6 +206,17 @@ void traceIF_BufCharPrint(dbg_channels_t chan, dbg_levels_t level, const CRC_CHA
   */
 void traceIF_BufHexPrint(dbg_channels_t chan, dbg_levels_t level, const CRC_CHAR_t *buf, uint16_t size);
 
+/**
+  * @brief  Print a tokenized trace - use TRACE_TOKEN macro
+  * @param  port   - component channel
+  * @param  lvl    - trace level
+  * @param  token  - format string ID
+  * @param  p_args - arguments of the format string
+  * @param  nb_args - number of arguments
+  * @retval -
+  */
+void traceIF_tokenPrint(uint8_t port, uint8_t lvl, uint32_t token, const uint32_t *p_args, uint8_t nb_args);
+
 #if ((TRACE_IF_TRACES_ITM == 1U) && (TRACE_IF_TRACES_UART == 1U))
 #define TRACE_PRINT(chan, lvl, format, args...) \
   (void)sprintf((CRC_CHAR_t *)dbgIF_buf[(chan)], format "", ## args);\
@@ -225,6 +251,46 @@ void traceIF_BufHexPrint(dbg_channels_t chan, dbg_levels_t level, const CRC_CHAR
   traceIF_uartPrintForce((uint8_t)(DBG_CHAN_VALID), (uint8_t *)dbgIF_buf[(DBG_CHAN_VALID)],\
                          (uint16_t)crs_strlen(dbgIF_buf[(DBG_CHAN_VALID)]));
 
+/**
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                    ##### Tokenized traces #####
+  ==============================================================================
+
+  TRACE_TOKEN(chan, lvl, format, args...) replaces TRACE_PRINT on paths where
+  the sprintf cost is not acceptable. The format string is not formatted nor sent:
+  it is stored in the .trace_fmt section, which is not loaded in the target
+  (INFO section of the linker script), and its address in this section is its ID.
+  The arguments must be integers (char, int, enum): each one is sent as a uint32.
+  The format string must not use %s, %f or %p.
+
+  The channel and level filters are the same as TRACE_PRINT ones.
+
+  Record sent (ITM and/or UART):
+    byte 0 : TRACE_IF_TOKEN_SYNC
+    byte 1 : channel
+    byte 2 : number of arguments
+    then the ID and each argument: unsigned LEB128 varint
+                 (7 bits per byte, bit 7 set when another byte follows)
+
+  Utilities/trace_token_decode.py rebuilds the text traces using the .trace_fmt
+  section of the ELF file (or a dictionary generated from it).
+
+  @endverbatim
+  */
+#if (TRACE_IF_TOKENIZED == 1U)
+#define TRACE_TOKEN(chan, lvl, format, args...) \
+  do { \
+    static const CRC_CHAR_t traceIF_token_fmt[] __attribute__((section(".trace_fmt"), used)) = format; \
+    const uint32_t traceIF_token_args[] = { 0U, ## args }; \
+    traceIF_tokenPrint((uint8_t)(chan), (uint8_t)(lvl), (uint32_t)&traceIF_token_fmt[0], &traceIF_token_args[1], \
+                       (uint8_t)((sizeof(traceIF_token_args) / sizeof(uint32_t)) - 1U)); \
+  } while (false);
+#else
+#define TRACE_TOKEN(chan, lvl, format, args...) TRACE_PRINT(chan, lvl, format, ## args)
+#endif /* TRACE_IF_TOKENIZED == 1U */
+
 #define TRACE_PRINT_BUF_CHAR(chan, lvl, pbuf, size) traceIF_BufCharPrint((chan), (lvl), (pbuf), (size))
 #define TRACE_PRINT_BUF_HEX(chan, lvl, pbuf, size)  traceIF_BufHexPrint((chan), (lvl), (pbuf), (size))
 
@@ -29,8 +29,51 @@
 #include "cmd.h"
 #endif  /* (USE_CMD_CONSOLE == 1) */
 
+#if ((TRACE_IF_DEFERRED == 1U) && (TRACE_IF_TRACES_UART == 1U) && (RTOS_USED == 1))
+#define TRACE_IF_RING_USED     (1U)
+#else
+#define TRACE_IF_RING_USED     (0U)
+#endif /* (TRACE_IF_DEFERRED == 1U) && (TRACE_IF_TRACES_UART == 1U) && (RTOS_USED == 1) */
+
+#if (TRACE_IF_RING_USED == 1U)
+#if (USE_STACK_ANALYSIS == 1)
+#include "stack_analysis.h"
+#endif /* USE_STACK_ANALYSIS == 1 */
+
+/* Size of the ring of each channel - must be a power of 2 */
+#if !defined TRACE_IF_RING_SIZE
+#define TRACE_IF_RING_SIZE     (512U)
+#endif /* !defined TRACE_IF_RING_SIZE */
+#define TRACE_IF_RING_MASK     (TRACE_IF_RING_SIZE - 1U)
+
+/* Trace thread sleeping time when all the rings are empty (in ms) */
+#if !defined TRACE_IF_DRAIN_PERIOD
+#define TRACE_IF_DRAIN_PERIOD  (10U)
+#endif /* !defined TRACE_IF_DRAIN_PERIOD */
+
+/* Trace thread sends the rings with DMA (1) - the UART TX DMA channel must be configured */
+#if !defined TRACE_IF_UART_DMA
+#define TRACE_IF_UART_DMA      (0U)
+#endif /* !defined TRACE_IF_UART_DMA */
+#endif /* TRACE_IF_RING_USED == 1U */
+
 
 /* Private typedef -----------------------------------------------------------*/
+#if (TRACE_IF_RING_USED == 1U)
+/* Ring of the UART traces of a channel
+ * Written by the threads tracing on the channel under traceIF_ring_mutex, read by the trace thread:
+ * head and tail are free running counters, each one updated by one side only.
+ */
+typedef struct
+{
+  uint8_t           buffer[TRACE_IF_RING_SIZE];
+  volatile uint32_t head;     /* bytes queued  - updated by the producers only    */
+  volatile uint32_t tail;     /* bytes sent    - updated by the trace thread only */
+  volatile uint32_t dropped;  /* traces lost because the ring was full           */
+  uint32_t          used_max; /* max bytes waiting in the ring                   */
+} traceIF_ring_t;
+#endif /* TRACE_IF_RING_USED == 1U */
+
 /* Private macros ------------------------------------------------------------*/
 #define PRINT_FORCE(format, args...)  TRACE_PRINT_FORCE(DBG_CHAN_UTILITIES, DBL_LVL_P0, format, ## args)
 
@@ -45,6 +88,17 @@ static uint32_t traceIF_Level = TRACE_IF_MASK;
 static osMutexId traceIF_uart_mutex = NULL;
 #endif /* (RTOS_USED == 1) */
 
+#if (TRACE_IF_RING_USED == 1U)
+static traceIF_ring_t traceIF_ring[DBG_CHAN_MAX_VALUE];
+/* Several threads may trace on the same channel: serializes the producers of the rings,
+   held during the copy of a trace only (never during a UART transfer) */
+static osMutexId traceIF_ring_mutex = NULL;
+/* Dropped traces already reported - used by the trace thread only */
+static uint32_t traceIF_ring_reported[DBG_CHAN_MAX_VALUE];
+/* Trace thread handle - traces are queued only once it is created */
+static osThreadId traceIF_ThreadId = NULL;
+#endif /* TRACE_IF_RING_USED == 1U */
+
 /* Array to know if trace is activated for a specific channel */
 /* All debug channel  enabled per default */
 static uint8_t traceIF_traceComponent[DBG_CHAN_MAX_VALUE] =
@@ -93,11 +147,25 @@ static uint8_t *trace_cmd_label = (uint8_t *)"trace";
 
 /* Private function prototypes -----------------------------------------------*/
 static void ITM_Out(uint32_t port, uint32_t ch);
+static void traceIF_uartTransmit(uint8_t *ptr, uint16_t len);
+#if (TRACE_IF_TOKENIZED == 1U)
+static bool traceIF_isEnabled(uint8_t port, uint8_t lvl);
+static uint8_t traceIF_putVarint(uint8_t *p_buf, uint32_t value);
+#endif /* TRACE_IF_TOKENIZED == 1U */
+
+#if (TRACE_IF_RING_USED == 1U)
+static void traceIF_ringPut(uint8_t port, const uint8_t *ptr, uint16_t len);
+static void traceIF_ringSend(const uint8_t *ptr, uint32_t len);
+static bool traceIF_ringDrain(uint8_t port);
+static void traceIF_ringReportDropped(void);
+static void traceIF_thread(void *p_argument);
+#endif /* TRACE_IF_RING_USED == 1U */
 
 #if (USE_CMD_CONSOLE == 1)
 #if (SW_DEBUG_VERSION == 1)
 static cmd_status_t traceIF_cmd(uint8_t *cmd_line_p);
 static void traceIF_cmd_Help(void);
+static void traceIF_cmd_Stat(void);
 #endif /* SW_DEBUG_VERSION == 1 */
 #endif  /* (USE_CMD_CONSOLE == 1) */
 
@@ -220,6 +288,32 @@ static void traceIF_cmd_Help(void)
               trace_cmd_label)
   PRINT_FORCE("           |data_cache|utilities|error\r\n")
   PRINT_FORCE(" -> disable traces of selected component\r\n")
+  PRINT_FORCE("%s stat (display deferred traces statistics)\r\n", trace_cmd_label)
+}
+
+/**
+  * @brief  stat cmd management: display the rings of deferred UART traces
+  * @param  -
+  * @retval -
+  */
+static void traceIF_cmd_Stat(void)
+{
+#if (TRACE_IF_RING_USED == 1U)
+  PRINT_FORCE("\n\r <<< TRACE STAT >>>\n\r")
+  PRINT_FORCE("ring size: %lu bytes per channel, thread %s\n\r", (uint32_t)TRACE_IF_RING_SIZE,
+              (traceIF_ThreadId != NULL) ? "running" : "not started")
+  for (uint8_t i = 0U; i < (uint8_t)DBG_CHAN_MAX_VALUE; i++)
+  {
+    /* Display only the channels already used */
+    if (traceIF_ring[i].head != 0U)
+    {
+      PRINT_FORCE("channel %2u: queued: %lu used max: %lu dropped: %lu\n\r", i,
+                  traceIF_ring[i].head - traceIF_ring[i].tail, traceIF_ring[i].used_max, traceIF_ring[i].dropped)
+    }
+  }
+#else
+  PRINT_FORCE("\n\r <<< TRACE NOT DEFERRED >>>\n\r")
+#endif /* TRACE_IF_RING_USED == 1U */
 }
 
 /**
@@ -322,6 +416,14 @@ static cmd_status_t traceIF_cmd(uint8_t *cmd_line_p)
         traceIF_traceEnable = false;
         PRINT_FORCE("\n\r <<< TRACE INACTIVE >>>\n\r")
       }
+      /* 'stat' : display deferred traces statistics */
+      else if (strncmp((CRC_CHAR_t *)argv_p[0],
+                       "stat",
+                       strlen((CRC_CHAR_t *)argv_p[0]))
+               == 0)
+      {
+        traceIF_cmd_Stat();
+      }
       else
       {
         /* Parameter not recognized - display help */
@@ -367,6 +469,44 @@ static void ITM_Out(uint32_t port, uint32_t ch)
 }
 
 
+#if (TRACE_IF_TOKENIZED == 1U)
+/**
+  * @brief  Check if a trace must be printed
+  * @param  port - component channel
+  * @param  lvl  - trace level
+  * @retval bool - true: trace, global and component trace enabled
+  */
+static bool traceIF_isEnabled(uint8_t port, uint8_t lvl)
+{
+  return ((traceIF_traceEnable == true)
+          && ((traceIF_Level & lvl) != 0U)
+          && (traceIF_traceComponent[port] != 0U));
+}
+
+/**
+  * @brief  Write an unsigned LEB128 varint
+  * @param  p_buf - where to write (at least 5 bytes available)
+  * @param  value - value to write
+  * @retval uint8_t - number of bytes written
+  */
+static uint8_t traceIF_putVarint(uint8_t *p_buf, uint32_t value)
+{
+  uint8_t len = 0U;
+  uint32_t remain = value;
+
+  while (remain >= 0x80U)
+  {
+    p_buf[len] = (uint8_t)((remain & 0x7FU) | 0x80U);
+    remain >>= 7;
+    len++;
+  }
+  p_buf[len] = (uint8_t)remain;
+  len++;
+
+  return len;
+}
+#endif /* TRACE_IF_TOKENIZED == 1U */
+
 /**
   * @brief  Print a trace through UART
   * @param  ptr - pointer on the trace string
@@ -388,6 +528,180 @@ static void traceIF_uartTransmit(uint8_t *ptr, uint16_t len)
 #endif /* (RTOS_USED == 1) */
 }
 
+#if (TRACE_IF_RING_USED == 1U)
+/**
+  * @brief  Queue a trace in the ring of its channel
+  * @note   The producers of all the channels are serialized by traceIF_ring_mutex;
+  *         the trace thread reads the ring without it.
+  *         The trace is queued entirely or dropped and counted.
+  * @param  port - component channel
+  * @param  ptr  - pointer on the trace string
+  * @param  len  - length of the trace string
+  * @retval -
+  */
+static void traceIF_ringPut(uint8_t port, const uint8_t *ptr, uint16_t len)
+{
+  traceIF_ring_t *p_ring = &traceIF_ring[port];
+  uint32_t head;
+  uint32_t used;
+  uint32_t offset;
+  uint32_t first;
+
+  (void)rtosalMutexAcquire(traceIF_ring_mutex, RTOSAL_WAIT_FOREVER);
+  head = p_ring->head;
+  /* Unsigned difference: correct even when the counters wrap */
+  used = (head - p_ring->tail) + (uint32_t)len;
+  if (used <= TRACE_IF_RING_SIZE)
+  {
+    offset = head & TRACE_IF_RING_MASK;
+    first = TRACE_IF_RING_SIZE - offset;
+    if (first >= (uint32_t)len)
+    {
+      (void)memcpy(&p_ring->buffer[offset], ptr, len);
+    }
+    else
+    {
+      /* Trace wraps at the end of the ring */
+      (void)memcpy(&p_ring->buffer[offset], ptr, first);
+      (void)memcpy(&p_ring->buffer[0], &ptr[first], (uint32_t)len - first);
+    }
+    if (used > p_ring->used_max)
+    {
+      p_ring->used_max = used;
+    }
+    /* Trace must be in the ring before the trace thread sees the new head */
+    __DMB();
+    p_ring->head = head + (uint32_t)len;
+  }
+  else
+  {
+    p_ring->dropped++;
+  }
+  (void)rtosalMutexRelease(traceIF_ring_mutex);
+}
+
+/**
+  * @brief  Send a part of a ring on the UART
+  * @note   Called by the trace thread with traceIF_uart_mutex acquired
+  * @param  ptr - pointer on the data
+  * @param  len - length of the data
+  * @retval -
+  */
+static void traceIF_ringSend(const uint8_t *ptr, uint32_t len)
+{
+#if (TRACE_IF_UART_DMA == 1U)
+  if (HAL_UART_Transmit_DMA(&TRACE_INTERFACE_UART_HANDLE, (uint8_t *)ptr, (uint16_t)len) == HAL_OK)
+  {
+    /* Ring space is released only at the end of the transfer */
+    while (TRACE_INTERFACE_UART_HANDLE.gState != HAL_UART_STATE_READY)
+    {
+      (void)rtosalDelay(1U);
+    }
+  }
+#else
+  (void)HAL_UART_Transmit(&TRACE_INTERFACE_UART_HANDLE, (uint8_t *)ptr, (uint16_t)len, HAL_MAX_DELAY);
+#endif /* TRACE_IF_UART_DMA == 1U */
+}
+
+/**
+  * @brief  Send on the UART all the traces queued in the ring of a channel
+  * @param  port - component channel
+  * @retval bool - true: traces sent, false: ring was empty
+  */
+static bool traceIF_ringDrain(uint8_t port)
+{
+  bool result = false;
+  traceIF_ring_t *p_ring = &traceIF_ring[port];
+  uint32_t tail = p_ring->tail;
+  uint32_t head = p_ring->head;
+  uint32_t used;
+  uint32_t offset;
+  uint32_t first;
+
+  used = head - tail;
+  if (used != 0U)
+  {
+    /* Read the traces only after the head */
+    __DMB();
+    offset = tail & TRACE_IF_RING_MASK;
+    first = TRACE_IF_RING_SIZE - offset;
+    if (first > used)
+    {
+      first = used;
+    }
+
+    /* Mutex is kept for both parts: a forced trace cannot cut a trace which wraps */
+    (void)rtosalMutexAcquire(traceIF_uart_mutex, RTOSAL_WAIT_FOREVER);
+    traceIF_ringSend(&p_ring->buffer[offset], first);
+    if (used > first)
+    {
+      traceIF_ringSend(&p_ring->buffer[0], used - first);
+    }
+    (void)rtosalMutexRelease(traceIF_uart_mutex);
+
+    /* Space is given back to the producer only once sent */
+    __DMB();
+    p_ring->tail = head;
+    result = true;
+  }
+
+  return result;
+}
+
+/**
+  * @brief  Report on the UART the traces dropped since the last report
+  * @param  -
+  * @retval -
+  */
+static void traceIF_ringReportDropped(void)
+{
+  static uint8_t traceIF_report_buf[64];
+  uint32_t dropped;
+
+  for (uint8_t i = 0U; i < (uint8_t)DBG_CHAN_MAX_VALUE; i++)
+  {
+    dropped = traceIF_ring[i].dropped;
+    if (dropped != traceIF_ring_reported[i])
+    {
+      (void)snprintf((CRC_CHAR_t *)traceIF_report_buf, sizeof(traceIF_report_buf),
+                     "\r\n<%lu traces dropped on channel %u>\r\n", dropped - traceIF_ring_reported[i], i);
+      traceIF_uartTransmit(traceIF_report_buf, (uint16_t)crs_strlen(traceIF_report_buf));
+      traceIF_ring_reported[i] = dropped;
+    }
+  }
+}
+
+/**
+  * @brief  Trace thread: send on the UART the traces queued by the channels
+  * @param  p_argument - unused
+  * @retval -
+  */
+static void traceIF_thread(void *p_argument)
+{
+  UNUSED(p_argument);
+  bool sent;
+
+  for (;;)
+  {
+    sent = false;
+    /* Round robin on the channels: one channel cannot delay the others more than a ring */
+    for (uint8_t i = 0U; i < (uint8_t)DBG_CHAN_MAX_VALUE; i++)
+    {
+      if (traceIF_ringDrain(i) == true)
+      {
+        sent = true;
+      }
+    }
+    traceIF_ringReportDropped();
+
+    if (sent == false)
+    {
+      (void)rtosalDelay(TRACE_IF_DRAIN_PERIOD);
+    }
+  }
+}
+#endif /* TRACE_IF_RING_USED == 1U */
+
 /* Functions Definition ------------------------------------------------------*/
 /**
   * @brief  Trace off - Set trace to disable
@@ -464,13 +778,70 @@ void traceIF_uartPrint(uint8_t port, uint8_t lvl, uint8_t *pptr, uint16_t len)
         uint8_t *ptr;
         ptr = pptr;
 
-        /* Print bytes of the trace  */
-        traceIF_uartTransmit(ptr, len);
+#if (TRACE_IF_RING_USED == 1U)
+        /* Once the trace thread is running, the caller is not blocked by the UART transfer */
+        if (traceIF_ThreadId != NULL)
+        {
+          traceIF_ringPut(port, ptr, len);
+        }
+        else
+#endif /* TRACE_IF_RING_USED == 1U */
+        {
+          /* Print bytes of the trace  */
+          traceIF_uartTransmit(ptr, len);
+        }
       }
     }
   }
 }
 
+/**
+  * @brief  Print a tokenized trace - use TRACE_TOKEN macro
+  * @note   Record is encoded only if the trace is enabled: no cost for a filtered trace
+  * @param  port   - component channel
+  * @param  lvl    - trace level
+  * @param  token  - format string ID
+  * @param  p_args - arguments of the format string
+  * @param  nb_args - number of arguments
+  * @retval -
+  */
+void traceIF_tokenPrint(uint8_t port, uint8_t lvl, uint32_t token, const uint32_t *p_args, uint8_t nb_args)
+{
+#if (TRACE_IF_TOKENIZED == 1U)
+  /* sync + channel + number of arguments + ID and arguments as varint */
+  uint8_t record[3U + (5U * (1U + TRACE_IF_TOKEN_MAX_ARGS))];
+  uint16_t len;
+  uint8_t nb;
+
+  if (traceIF_isEnabled(port, lvl) == true)
+  {
+    nb = (nb_args > (uint8_t)TRACE_IF_TOKEN_MAX_ARGS) ? (uint8_t)TRACE_IF_TOKEN_MAX_ARGS : nb_args;
+    record[0] = (uint8_t)TRACE_IF_TOKEN_SYNC;
+    record[1] = port;
+    record[2] = nb;
+    len = 3U;
+    len += traceIF_putVarint(&record[len], token);
+    for (uint8_t i = 0U; i < nb; i++)
+    {
+      len += traceIF_putVarint(&record[len], p_args[i]);
+    }
+
+#if (TRACE_IF_TRACES_ITM == 1U)
+    traceIF_itmPrint(port, lvl, record, len);
+#endif /* TRACE_IF_TRACES_ITM == 1U */
+#if (TRACE_IF_TRACES_UART == 1U)
+    traceIF_uartPrint(port, lvl, record, len);
+#endif /* TRACE_IF_TRACES_UART == 1U */
+  }
+#else
+  UNUSED(port);
+  UNUSED(lvl);
+  UNUSED(token);
+  UNUSED(p_args);
+  UNUSED(nb_args);
+#endif /* TRACE_IF_TOKENIZED == 1U */
+}
+
 /**
   * @brief  Print a trace on ITM even if global or component trace is disable
   * @param  port - component channel
@@ -506,7 +877,8 @@ void traceIF_uartPrintForce(uint8_t port, uint8_t *pptr, uint16_t len)
   uint8_t *ptr;
   ptr = pptr;
 
-  /* Print bytes of the trace */
+  /* Print bytes of the trace
+     Not deferred: console and boot menu outputs must be displayed before the next input */
   traceIF_uartTransmit(ptr, len);
 }
 
@@ -695,6 +1067,27 @@ void traceIF_start(void)
   CMD_Declare((uint8_t *)"trace", traceIF_cmd, (uint8_t *)"trace management");
 #endif /* SW_DEBUG_VERSION == 1 */
 #endif /* USE_CMD_CONSOLE == 1 */
+
+#if (TRACE_IF_RING_USED == 1U)
+  /* Multi call protection */
+  if (traceIF_ring_mutex == NULL)
+  {
+    traceIF_ring_mutex = rtosalMutexNew(NULL);
+  }
+  if ((traceIF_ThreadId == NULL) && (traceIF_ring_mutex != NULL))
+  {
+    /* Create the thread sending the deferred UART traces
+       if it cannot be created, the traces are still sent by the caller */
+    traceIF_ThreadId = rtosalThreadNew((const rtosal_char_t *)"TraceThread", (os_pthread)traceIF_thread,
+                                       TRACE_IF_THREAD_PRIO, TRACE_IF_THREAD_STACK_SIZE, NULL);
+#if (USE_STACK_ANALYSIS == 1)
+    if (traceIF_ThreadId != NULL)
+    {
+      (void)stackAnalysis_addStackSizeByHandle(traceIF_ThreadId, TRACE_IF_THREAD_STACK_SIZE);
+    }
+#endif /* USE_STACK_ANALYSIS == 1 */
+  }
+#endif /* TRACE_IF_RING_USED == 1U */
 }
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
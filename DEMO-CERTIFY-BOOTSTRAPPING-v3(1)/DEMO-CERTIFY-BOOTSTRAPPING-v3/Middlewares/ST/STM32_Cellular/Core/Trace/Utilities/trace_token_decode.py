@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""Decode the tokenized traces sent by trace_interface (TRACE_TOKEN macro).
+
+The format strings are read from the .trace_fmt section of the ELF file, or
+from a dictionary previously generated with --dump-dict. The text traces
+are output unchanged, the tokenized records are replaced by their text.
+
+Examples:
+  trace_token_decode.py --elf Cellular.elf --dump-dict trace_fmt.csv
+  trace_token_decode.py --elf Cellular.elf trace.log
+  trace_token_decode.py --dict trace_fmt.csv --serial /dev/ttyACM0
+"""
+
+import argparse
+import csv
+import re
+import struct
+import sys
+
+TOKEN_SYNC = 0xFE           # TRACE_IF_TOKEN_SYNC
+TOKEN_MAX_ARGS = 8          # TRACE_IF_TOKEN_MAX_ARGS
+SECTION_NAME = ".trace_fmt"
+
+# printf conversion: flags, width, precision, length modifier, conversion
+PRINTF_SPEC = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diouxXcs%])")
+
+
+def read_elf_dictionary(path):
+    """Return {ID: format string} from the .trace_fmt section of an ELF file."""
+    with open(path, "rb") as elf:
+        data = elf.read()
+    if data[:4] != b"\x7fELF":
+        raise ValueError("%s is not an ELF file" % path)
+    is_64 = data[4] == 2
+    endian = "<" if data[5] == 1 else ">"
+    if is_64:
+        shoff, = struct.unpack_from(endian + "Q", data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", data, 0x3A)
+        section_fmt = endian + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(endian + "I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", data, 0x2E)
+        section_fmt = endian + "IIIIIIIIII"
+
+    sections = [struct.unpack_from(section_fmt, data, shoff + (i * shentsize)) for i in range(shnum)]
+    names = sections[shstrndx]
+    names_data = data[names[4]:names[4] + names[5]]
+
+    dictionary = {}
+    for section in sections:
+        name = names_data[section[0]:names_data.index(b"\0", section[0])].decode()
+        if name == SECTION_NAME:
+            addr, offset, size = section[3], section[4], section[5]
+            content = data[offset:offset + size]
+            start = 0
+            while start < len(content):
+                end = content.index(b"\0", start)
+                if end > start:
+                    dictionary[addr + start] = content[start:end].decode("latin-1")
+                start = end + 1
+    if not dictionary:
+        raise ValueError("no %s section in %s (TRACE_IF_TOKENIZED == 0 ?)" % (SECTION_NAME, path))
+    return dictionary
+
+
+def read_csv_dictionary(path):
+    """Return {ID: format string} from a dictionary generated by --dump-dict."""
+    with open(path, newline="") as dict_file:
+        return {int(row[0], 16): row[1] for row in csv.reader(dict_file)}
+
+
+def write_csv_dictionary(path, dictionary):
+    """Write the dictionary: one line per format string, ID in hexadecimal."""
+    with open(path, "w", newline="") as dict_file:
+        writer = csv.writer(dict_file)
+        for token in sorted(dictionary):
+            writer.writerow(["%08x" % token, dictionary[token]])
+
+
+def format_trace(fmt, args):
+    """Format a C printf string with the uint32 arguments sent by the target."""
+    values = iter(args)
+
+    def convert(match):
+        flags, width, precision, length, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        value = next(values, 0)
+        if conversion == "s":
+            return "<str>"
+        if conversion in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+        if conversion == "c":
+            return chr(value & 0xFF)
+        spec = "%" + flags + width + (("." + precision) if precision else "")
+        return (spec + ("d" if conversion == "u" else conversion)) % value
+
+    return PRINTF_SPEC.sub(convert, fmt)
+
+
+def read_varint(stream):
+    """Read an unsigned LEB128 varint, None at the end of the stream."""
+    value = 0
+    shift = 0
+    while True:
+        byte = stream.read(1)
+        if not byte:
+            return None
+        value |= (byte[0] & 0x7F) << shift
+        shift += 7
+        if (byte[0] & 0x80) == 0:
+            return value & 0xFFFFFFFF
+
+
+def decode(stream, dictionary, output):
+    """Copy the text traces and decode the tokenized records of the stream."""
+    while True:
+        byte = stream.read(1)
+        if not byte:
+            break
+        if byte[0] != TOKEN_SYNC:
+            output.write(byte.decode("latin-1"))
+            continue
+        header = stream.read(2)
+        if len(header) < 2:
+            break
+        channel, nb_args = header[0], header[1]
+        if nb_args > TOKEN_MAX_ARGS:
+            output.write("<bad record>")
+            continue
+        values = [read_varint(stream) for _ in range(nb_args + 1)]
+        if None in values:
+            break
+        fmt = dictionary.get(values[0])
+        if fmt is None:
+            output.write("<unknown token 0x%08x on channel %d>\n" % (values[0], channel))
+        else:
+            output.write(format_trace(fmt, values[1:]))
+        output.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--elf", help="ELF file built with TRACE_IF_TOKENIZED == 1")
+    source.add_argument("--dict", help="dictionary generated with --dump-dict")
+    parser.add_argument("--dump-dict", metavar="CSV", help="write the dictionary and exit")
+    parser.add_argument("--serial", metavar="PORT", help="read the traces from a serial port (needs pyserial)")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("log", nargs="?", help="binary trace log (default: stdin)")
+    args = parser.parse_args()
+
+    dictionary = read_elf_dictionary(args.elf) if args.elf else read_csv_dictionary(args.dict)
+    if args.dump_dict:
+        write_csv_dictionary(args.dump_dict, dictionary)
+        return
+
+    if args.serial:
+        import serial  # pylint: disable=import-outside-toplevel
+        stream = serial.Serial(args.serial, args.baudrate)
+    elif args.log:
+        stream = open(args.log, "rb")
+    else:
+        stream = sys.stdin.buffer
+    with stream:
+        decode(stream, dictionary, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,98 @@
+/**
+  ******************************************************************************
+  * @file    com_dns_cache.h
+  * @author  artworkTrackingMAP
+  * @brief   Header for com_dns_cache.c module
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef COM_DNS_CACHE_H
+#define COM_DNS_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "plf_config.h"
+
+#include "com_common.h"
+#include "com_sockets_addr_compat.h"
+
+/**
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                    ##### How to use COM DNS cache Module #####
+  ==============================================================================
+  Keeps the last host names resolved by the modem, to avoid a modem wake-up and
+  a DNS request on the network for each com_gethostbyname of the same host.
+
+  - com_dns_cache_lookup() returns true and the address if the name is cached.
+    Otherwise it returns false and the caller owns the resolution of the name:
+    it must resolve the name then call com_dns_cache_update(), with the address
+    found or NULL if the resolution failed.
+  - Only one resolution is in progress at a time: a concurrent lookup of the
+    same name waits for it and gets its result from the cache.
+  - An address is kept for the DNS TTL, if known, and at least for
+    COM_DNS_CACHE_TTL_MIN seconds. When the cache is full, the least recently
+    used name is replaced.
+  - com_dns_cache_flush() forgets all the names: to call when the network is
+    lost, the addresses may change with the next PDN activation.
+
+  COM_DNS_CACHE_NB = 0 deactivates the cache.
+
+  @endverbatim
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/* Number of host names in the cache (0: no cache) */
+#if !defined COM_DNS_CACHE_NB
+#define COM_DNS_CACHE_NB           (4U)
+#endif /* !defined COM_DNS_CACHE_NB */
+
+/* Minimum time an address is kept, used when the DNS TTL is unknown or lower */
+#if !defined COM_DNS_CACHE_TTL_MIN
+#define COM_DNS_CACHE_TTL_MIN      (300U) /* in s. */
+#endif /* !defined COM_DNS_CACHE_TTL_MIN */
+
+/* Maximum length of a cached host name, a longer name is resolved but not cached */
+#define COM_DNS_CACHE_NAME_SIZE    (64U)
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t hit;       /* lookups answered by the cache                        */
+  uint32_t coalesced; /* among hits: answered by a concurrent resolution      */
+  uint32_t miss;      /* lookups resolved by the caller                       */
+  uint32_t flush;     /* cache flushes                                        */
+} com_dns_cache_stat_t;
+
+/* External variables --------------------------------------------------------*/
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported functions ------------------------------------------------------- */
+bool com_dns_cache_init(void);
+
+/* true: name found, addr updated - false: caller must resolve name then call com_dns_cache_update */
+bool com_dns_cache_lookup(const com_char_t *name, com_sockaddr_t *addr);
+
+/* End of the resolution started by com_dns_cache_lookup - addr NULL if resolution failed,
+   ttl in s. (0 if unknown) */
+void com_dns_cache_update(const com_char_t *name, const com_sockaddr_t *addr, uint32_t ttl);
+
+void com_dns_cache_flush(void);
+void com_dns_cache_get_stat(com_dns_cache_stat_t *p_stat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COM_DNS_CACHE_H */
+
+/******************************** END OF FILE *********************************/
@@ -197,6 +197,15 @@ extern "C" {
 /** @defgroup COM_SOCKETS_Constants Constants
   * @{
   */
+/* Maximum number of buffers in a com_sendmsg request */
+#if !defined COM_IOV_MAX
+#define COM_IOV_MAX  8
+#endif /* !defined COM_IOV_MAX */
+
+/* Maximum number of sockets in a com_poll request */
+#if !defined COM_POLL_FDS_MAX
+#define COM_POLL_FDS_MAX  8
+#endif /* !defined COM_POLL_FDS_MAX */
 
 /**
   * @}
@@ -206,6 +215,29 @@ extern "C" {
 /** @defgroup COM_SOCKETS_Types Types
   * @{
   */
+/* One buffer of a com_sendmsg request */
+typedef struct
+{
+  const com_char_t *iov_base;   /*!< buffer address */
+  int32_t          iov_len;     /*!< buffer length (in bytes) */
+} com_iovec_t;
+
+/* Message of a com_sendmsg request: the buffers are sent in order, as one block of data */
+typedef struct
+{
+  const com_sockaddr_t *msg_name;    /*!< remote IP address and port number, NULL on a connected socket */
+  int32_t              msg_namelen;  /*!< remote IP length, 0 on a connected socket */
+  const com_iovec_t    *msg_iov;     /*!< buffers to send */
+  int32_t              msg_iovlen;   /*!< number of buffers (1 to COM_IOV_MAX) */
+} com_msghdr_t;
+
+/* Socket of a com_poll request */
+typedef struct
+{
+  int32_t fd;         /*!< socket handle obtained with com_socket, negative value: entry ignored */
+  int16_t events;     /*!< events requested: COM_POLLIN and/or COM_POLLOUT */
+  int16_t revents;    /*!< events returned: COM_POLLIN, COM_POLLOUT, COM_POLLERR, COM_POLLHUP, COM_POLLNVAL */
+} com_pollfd_t;
 
 /**
   * @}
@@ -387,6 +419,19 @@ int32_t com_sendto(int32_t sock,
                    int32_t flags,
                    const com_sockaddr_t *to, int32_t tolen);
 
+/**
+  * @brief  Socket send message
+  * @note   Send data gathered from several buffers, e.g. a protocol header and its payload,
+  *         without copying them in an intermediate buffer
+  * @param  sock      - socket handle obtained with com_socket
+  * @param  msg       - buffers to send and optional remote IP address and port number
+  * @param  flags     - options
+  * @retval int32_t   - number of bytes sent or error value
+  */
+int32_t com_sendmsg(int32_t sock,
+                    const com_msghdr_t *msg,
+                    int32_t flags);
+
 /**
   * @brief  Socket receive data
   * @note   Receive data on already connected socket
@@ -416,6 +461,18 @@ int32_t com_recvfrom(int32_t sock,
                      int32_t flags,
                      com_sockaddr_t *from, int32_t *fromlen);
 
+/**
+  * @brief  Socket poll
+  * @note   Wait until at least one socket of a set is ready, so one thread can serve several sockets
+  *         COM_POLLIN : com_recv/com_recvfrom has data to return or the socket is closed by remote
+  *         COM_POLLOUT: com_send/com_sendto can be called
+  * @param  fds       - sockets and events requested, revents updated with events ready
+  * @param  nfds      - number of entries in fds (1 to COM_POLL_FDS_MAX)
+  * @param  timeout   - maximum time to wait (in ms), 0: no wait, negative value: wait forever
+  * @retval int32_t   - number of entries with revents != 0, 0 on timeout or error value
+  */
+int32_t com_poll(com_pollfd_t *fds, uint32_t nfds, int32_t timeout);
+
 
 /**
   * @brief  Socket close
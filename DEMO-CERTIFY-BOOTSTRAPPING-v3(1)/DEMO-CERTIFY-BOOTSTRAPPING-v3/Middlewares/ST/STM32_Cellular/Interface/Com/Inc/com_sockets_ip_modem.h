@@ -30,6 +30,7 @@ extern "C" {
 
 #include "com_common.h"
 #include "com_sockets_addr_compat.h"
+#include "com_sockets.h"
 
 /* Exported constants --------------------------------------------------------*/
 
@@ -225,6 +226,22 @@ int32_t com_sendto_ip_modem(int32_t sock,
                             int32_t flags,
                             const com_sockaddr_t *to, int32_t tolen);
 
+/**
+  * @brief  Socket send message
+  * @note   Send data gathered from several buffers without intermediate copy:
+  *         the buffers are given to the modem driver which gathers them in the AT command
+  * @param  sock      - socket handle obtained with com_socket
+  * @param  msg       - buffers to send and optional remote IP address and port number
+  * @note   on a datagram socket sent with sendto service (or if msg_name is provided)
+  *         only one buffer is supported
+  * @param  flags     - options
+  * @note   same behavior as com_send_ip_modem
+  * @retval int32_t   - number of bytes sent or error value
+  */
+int32_t com_sendmsg_ip_modem(int32_t sock,
+                             const com_msghdr_t *msg,
+                             int32_t flags);
+
 /**
   * @brief  Socket receive data
   * @note   Receive data on already connected socket
@@ -275,6 +292,23 @@ int32_t com_recvfrom_ip_modem(int32_t sock,
                               int32_t flags,
                               com_sockaddr_t *from, int32_t *fromlen);
 
+/**
+  * @brief  Socket poll
+  * @note   Wait until at least one socket of a set is ready
+  *         Readiness is updated by the modem data ready and socket closing notifications:
+  *         COM_POLLIN : data notified by the modem and not yet read by com_recv/com_recvfrom,
+  *                      or socket closed by remote
+  *         COM_POLLOUT: socket connected (or UDP socket created) and not closed by remote
+  *         COM_POLLERR: network down
+  *         COM_POLLHUP: socket closed by remote
+  *         COM_POLLNVAL: socket not found
+  * @param  fds       - sockets and events requested, revents updated with events ready
+  * @param  nfds      - number of entries in fds (1 to COM_POLL_FDS_MAX)
+  * @param  timeout   - maximum time to wait (in ms), 0: no wait, negative value: wait forever
+  * @retval int32_t   - number of entries with revents != 0, 0 on timeout or error value
+  */
+int32_t com_poll_ip_modem(com_pollfd_t *fds, uint32_t nfds, int32_t timeout);
+
 /**
   * @brief  Socket close
   * @note   Close a socket and release socket handle
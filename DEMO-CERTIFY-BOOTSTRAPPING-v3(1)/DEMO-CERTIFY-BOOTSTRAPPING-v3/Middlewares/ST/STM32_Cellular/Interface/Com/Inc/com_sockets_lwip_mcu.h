@@ -30,6 +30,7 @@ extern "C" {
 
 #include "com_common.h"
 #include "com_sockets_addr_compat.h"
+#include "com_sockets.h"
 
 /* Exported constants --------------------------------------------------------*/
 
@@ -191,6 +192,19 @@ int32_t com_sendto_lwip_mcu(int32_t sock,
                             int32_t flags,
                             const com_sockaddr_t *to, int32_t tolen);
 
+/**
+  * @brief  Socket send message
+  * @note   Send data gathered from several buffers
+  *         Restrictions, if any, are linked to LwIP module used
+  * @param  sock      - socket handle obtained with com_socket
+  * @param  msg       - buffers to send and optional remote IP address and port number
+  * @param  flags     - options
+  * @retval int32_t   - number of bytes sent or error value
+  */
+int32_t com_sendmsg_lwip_mcu(int32_t sock,
+                             const com_msghdr_t *msg,
+                             int32_t flags);
+
 /**
   * @brief  Socket receive data
   * @note   Receive data on already connected socket
@@ -222,6 +236,17 @@ int32_t com_recvfrom_lwip_mcu(int32_t sock,
                               int32_t flags,
                               com_sockaddr_t *from, int32_t *fromlen);
 
+/**
+  * @brief  Socket poll
+  * @note   Wait until at least one socket of a set is ready
+  *         Restrictions, if any, are linked to LwIP module used (LWIP_SOCKET_POLL)
+  * @param  fds       - sockets and events requested, revents updated with events ready
+  * @param  nfds      - number of entries in fds (1 to COM_POLL_FDS_MAX)
+  * @param  timeout   - maximum time to wait (in ms), 0: no wait, negative value: wait forever
+  * @retval int32_t   - number of entries with revents != 0, 0 on timeout or error value
+  */
+int32_t com_poll_lwip_mcu(com_pollfd_t *fds, uint32_t nfds, int32_t timeout);
+
 /**
   * @brief  Socket close
   * @note   Close a socket and release socket handle
@@ -93,6 +93,13 @@ extern "C" {
 #define COM_MSG_WAIT       0x00    /*!< Blocking     */
 #define COM_MSG_DONTWAIT   0x01    /*!< Non blocking */
 
+/* Events used with poll. */
+#define COM_POLLIN         0x01    /*!< Data to read or socket closed by remote */
+#define COM_POLLOUT        0x02    /*!< Data can be sent                        */
+#define COM_POLLERR        0x04    /*!< Error - e.g network down (revents only) */
+#define COM_POLLNVAL       0x08    /*!< Invalid socket id (revents only)        */
+#define COM_POLLHUP        0x200   /*!< Socket closed by remote (revents only)  */
+
 /**
   * @}
   */
@@ -186,6 +193,13 @@ extern "C" {
 #define COM_MSG_WAIT       0x00
 #define COM_MSG_DONTWAIT   MSG_DONTWAIT
 
+/* Events used with poll. */
+#define COM_POLLIN         POLLIN
+#define COM_POLLOUT        POLLOUT
+#define COM_POLLERR        POLLERR
+#define COM_POLLNVAL       POLLNVAL
+#define COM_POLLHUP        POLLHUP
+
 /* Exported types ------------------------------------------------------------*/
 
 /* External variables --------------------------------------------------------*/
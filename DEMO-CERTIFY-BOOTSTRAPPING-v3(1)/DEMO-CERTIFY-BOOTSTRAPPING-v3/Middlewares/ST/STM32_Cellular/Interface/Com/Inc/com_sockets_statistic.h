@@ -33,6 +33,12 @@ extern "C" {
   * @{
   */
 
+/* Number of buckets of the latency histograms:
+   bucket 0 : 0ms,
+   bucket i : [2^(i-1), 2^i - 1] ms,
+   last one : all latencies >= 2^(COM_SOCKETS_STAT_LATENCY_BUCKETS - 2) ms */
+#define COM_SOCKETS_STAT_LATENCY_BUCKETS  (18U)
+
 /**
   * @}
   */
@@ -56,11 +62,62 @@ typedef enum
 #endif /* USE_DATACACHE == 1 */
 } com_sockets_stat_update_t;
 
+/* Internal usage only: operations timed by com_sockets_ip_modem */
+typedef enum
+{
+  COM_SOCKET_STAT_OP_CNT = 0,  /* com_connect     */
+  COM_SOCKET_STAT_OP_SND,      /* com_send        */
+  COM_SOCKET_STAT_OP_RCV,      /* com_recv        */
+  COM_SOCKET_STAT_OP_RCV_MDM,  /* data read from the modem by com_recv: one per AT transaction */
+  COM_SOCKET_STAT_OP_CLS,      /* com_closesocket */
+#if (USE_DATACACHE == 1)
+  COM_SOCKET_STAT_OP_NWK,      /* network down (or start) to network up: attach duration */
+#endif /* USE_DATACACHE == 1 */
+  COM_SOCKET_STAT_OP_NB
+} com_sockets_stat_op_t;
+
 /* Exported types ------------------------------------------------------------*/
 /** @addtogroup COM_SOCKETS_Types
   * @{
   */
 
+/* Result counters */
+typedef struct
+{
+  uint16_t sock_cre_ok;
+  uint16_t sock_cre_nok;
+  uint16_t sock_cnt_ok;
+  uint16_t sock_cnt_nok;
+  uint16_t sock_snd_ok;
+  uint16_t sock_snd_nok;
+  uint16_t sock_rcv_ok;
+  uint16_t sock_rcv_nok;
+  uint16_t sock_cls_ok;
+  uint16_t sock_cls_nok;
+#if (USE_DATACACHE == 1)
+  uint16_t nwk_up;
+  uint16_t nwk_dwn;
+#endif /* USE_DATACACHE == 1 */
+} com_sockets_stat_counter_t;
+
+/* Latency and size of the calls to an operation */
+typedef struct
+{
+  uint32_t calls;                                      /* number of calls timed          */
+  uint32_t latency_sum_ms;                             /* to compute the average         */
+  uint32_t latency_max_ms;
+  uint32_t bytes;                                      /* bytes sent/received            */
+  uint32_t bytes_max;                                  /* max bytes sent/received by call */
+  uint16_t bucket[COM_SOCKETS_STAT_LATENCY_BUCKETS];   /* log2 latency histogram         */
+} com_sockets_stat_latency_t;
+
+/* Statistics snapshot */
+typedef struct
+{
+  com_sockets_stat_counter_t counter;
+  com_sockets_stat_latency_t latency[COM_SOCKET_STAT_OP_NB];
+} com_sockets_stat_snapshot_t;
+
 /**
   * @}
   */
@@ -96,6 +153,24 @@ typedef enum
   */
 void com_sockets_statistic_display(void);
 
+/**
+  * @brief  Get a copy of com sockets statistics
+  * @note   COM_SOCKETS_STATISTIC must be set to 1 else the snapshot is set to 0
+  * @param  p_snapshot - statistics copy
+  * @retval -
+  */
+void com_sockets_statistic_snapshot(com_sockets_stat_snapshot_t *p_snapshot);
+
+/**
+  * @brief  Get a latency percentile from a histogram
+  * @note   Result is the upper bound of the histogram bucket reaching the percentile,
+  *         limited to the max latency
+  * @param  p_latency - histogram
+  * @param  percent   - percentile to compute (e.g 50U, 90U, 99U)
+  * @retval uint32_t  - latency in ms (0 if no call)
+  */
+uint32_t com_sockets_statistic_percentile(const com_sockets_stat_latency_t *p_latency, uint8_t percent);
+
 /**
   * @}
   */
@@ -124,6 +199,16 @@ void com_sockets_statistic_init(void);
   */
 void com_sockets_statistic_update(com_sockets_stat_update_t stat);
 
+/**
+  * @brief  Record the latency of an operation
+  * @note   -
+  * @param  op         - operation timed
+  * @param  start_tick - rtosalGetSysTimerCount() at the operation start
+  * @param  bytes      - result of the operation: bytes sent/received if > 0
+  * @retval -
+  */
+void com_sockets_statistic_latency(com_sockets_stat_op_t op, uint32_t start_tick, int32_t bytes);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,343 @@
+/**
+  ******************************************************************************
+  * @file    com_dns_cache.c
+  * @author  artworkTrackingMAP
+  * @brief   This file implements the DNS cache of the modem sockets
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "com_dns_cache.h"
+
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
+
+#include <string.h>
+#include <stdio.h>
+
+#include "rtosal.h"
+
+/* Private defines -----------------------------------------------------------*/
+#if (USE_TRACE_COM_SOCKETS == 1U)
+#if (USE_PRINTF == 0U)
+#include "trace_interface.h"
+#define PRINT_INFO(format, args...) TRACE_PRINT(DBG_CHAN_COMLIB, DBL_LVL_P0, "ComLib: " format "\n\r", ## args)
+#define PRINT_DBG(format, args...)  TRACE_PRINT(DBG_CHAN_COMLIB, DBL_LVL_P1, "ComLib: " format "\n\r", ## args)
+#else /* USE_PRINTF == 1 */
+#define PRINT_INFO(format, args...)  (void)printf("ComLib: " format "\n\r", ## args);
+/* To reduce trace PRINT_DBG is deactivated when using printf */
+#define PRINT_DBG(...)               __NOP(); /* Nothing to do */
+#endif /* USE_PRINTF == 0U */
+
+#else /* USE_TRACE_COM_SOCKETS == 0U */
+#define PRINT_INFO(...)  __NOP(); /* Nothing to do */
+#define PRINT_DBG(...)   __NOP(); /* Nothing to do */
+#endif /* USE_TRACE_COM_SOCKETS == 1U */
+
+/* TTL is limited to keep the expiry time comparable with the system tick */
+#define COM_DNS_CACHE_TTL_MAX  (86400U) /* in s. : 1 day */
+
+#if (COM_DNS_CACHE_NB > 0U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef char CSDNS_CHAR_t; /* used in string.h service call */
+
+typedef struct
+{
+  bool           valid;
+  com_char_t     name[COM_DNS_CACHE_NAME_SIZE];
+  com_sockaddr_t addr;
+  uint32_t       expiry;   /* tick at which the address is no more valid */
+  uint32_t       last_use; /* tick of the last lookup or update: to replace the least recently used */
+} com_dns_cache_entry_t;
+
+/* Private macros ------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static com_dns_cache_entry_t com_dns_cache[COM_DNS_CACHE_NB];
+static com_dns_cache_stat_t com_dns_cache_stat;
+
+/* Protect cache entries, statistics and generation */
+static osMutexId com_dns_cache_mutex = NULL;
+/* Owned by the caller in charge of a resolution: from com_dns_cache_lookup miss to com_dns_cache_update */
+static osMutexId com_dns_cache_resolver_mutex = NULL;
+
+/* Incremented at each flush: a resolution started before a flush is not cached */
+static uint32_t com_dns_cache_generation;
+static uint32_t com_dns_cache_resolver_generation;
+
+/* Global variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+static com_dns_cache_entry_t *com_dns_cache_find(const com_char_t *name, uint32_t now);
+static bool com_dns_cache_get(const com_char_t *name, com_sockaddr_t *addr, bool coalesced);
+static void com_dns_cache_set(const com_char_t *name, const com_sockaddr_t *addr, uint32_t ttl);
+
+/* Private function Definition -----------------------------------------------*/
+/**
+  * @brief  Find a name in the cache
+  * @note   com_dns_cache_mutex must be acquired - expired entries found are released
+  * @param  name - host name
+  * @param  now  - current tick
+  * @retval com_dns_cache_entry_t * - entry of the name or NULL if not found
+  */
+static com_dns_cache_entry_t *com_dns_cache_find(const com_char_t *name, uint32_t now)
+{
+  com_dns_cache_entry_t *p_entry = NULL;
+
+  for (uint32_t i = 0U; (i < COM_DNS_CACHE_NB) && (p_entry == NULL); i++)
+  {
+    if (com_dns_cache[i].valid == true)
+    {
+      /* wrap-safe comparison of ticks */
+      if ((int32_t)(now - com_dns_cache[i].expiry) >= 0)
+      {
+        com_dns_cache[i].valid = false;
+      }
+      else if (strcmp((const CSDNS_CHAR_t *)&com_dns_cache[i].name[0], (const CSDNS_CHAR_t *)name) == 0)
+      {
+        p_entry = &com_dns_cache[i];
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+  }
+
+  return (p_entry);
+}
+
+/**
+  * @brief  Get the address of a name from the cache
+  * @param  name      - host name
+  * @param  addr      - address of the host if found
+  * @param  coalesced - true if the lookup waited for a concurrent resolution
+  * @retval bool      - true: name found
+  */
+static bool com_dns_cache_get(const com_char_t *name, com_sockaddr_t *addr, bool coalesced)
+{
+  bool result = false;
+  uint32_t now = rtosalGetSysTimerCount();
+  com_dns_cache_entry_t *p_entry;
+
+  (void)rtosalMutexAcquire(com_dns_cache_mutex, RTOSAL_WAIT_FOREVER);
+  p_entry = com_dns_cache_find(name, now);
+  if (p_entry != NULL)
+  {
+    (void)memcpy((void *)addr, (const void *)&p_entry->addr, sizeof(com_sockaddr_t));
+    p_entry->last_use = now;
+    com_dns_cache_stat.hit++;
+    if (coalesced == true)
+    {
+      com_dns_cache_stat.coalesced++;
+    }
+    result = true;
+  }
+  (void)rtosalMutexRelease(com_dns_cache_mutex);
+
+  return (result);
+}
+
+/**
+  * @brief  Set the address of a name in the cache
+  * @note   com_dns_cache_mutex must be acquired - the least recently used entry is replaced if cache is full
+  * @param  name - host name, shorter than COM_DNS_CACHE_NAME_SIZE
+  * @param  addr - address of the host
+  * @param  ttl  - time to live of the address (in s.)
+  * @retval -
+  */
+static void com_dns_cache_set(const com_char_t *name, const com_sockaddr_t *addr, uint32_t ttl)
+{
+  uint32_t now = rtosalGetSysTimerCount();
+  com_dns_cache_entry_t *p_entry;
+
+  p_entry = com_dns_cache_find(name, now);
+  /* else use a free entry, or replace the least recently used one */
+  for (uint32_t i = 0U; (i < COM_DNS_CACHE_NB) && (p_entry == NULL); i++)
+  {
+    if (com_dns_cache[i].valid == false)
+    {
+      p_entry = &com_dns_cache[i];
+    }
+  }
+  if (p_entry == NULL)
+  {
+    p_entry = &com_dns_cache[0];
+    for (uint32_t i = 1U; i < COM_DNS_CACHE_NB; i++)
+    {
+      if ((now - com_dns_cache[i].last_use) > (now - p_entry->last_use))
+      {
+        p_entry = &com_dns_cache[i];
+      }
+    }
+    PRINT_DBG("DNS cache: %s replaced by %s", p_entry->name, name)
+  }
+
+  (void)strcpy((CSDNS_CHAR_t *)&p_entry->name[0], (const CSDNS_CHAR_t *)name);
+  (void)memcpy((void *)&p_entry->addr, (const void *)addr, sizeof(com_sockaddr_t));
+  p_entry->expiry = now + (1000U * ttl);
+  p_entry->last_use = now;
+  p_entry->valid = true;
+}
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief  DNS cache initialization
+  * @note   must be called before com_dns_cache_lookup
+  * @retval bool - true/false init ok/nok
+  */
+bool com_dns_cache_init(void)
+{
+  (void)memset((void *)&com_dns_cache[0], 0, sizeof(com_dns_cache));
+  (void)memset((void *)&com_dns_cache_stat, 0, sizeof(com_dns_cache_stat));
+  com_dns_cache_generation = 0U;
+  com_dns_cache_resolver_generation = 0U;
+
+  com_dns_cache_mutex = rtosalMutexNew(NULL);
+  com_dns_cache_resolver_mutex = rtosalMutexNew(NULL);
+
+  return ((com_dns_cache_mutex != NULL) && (com_dns_cache_resolver_mutex != NULL));
+}
+
+/**
+  * @brief  Lookup a name in the DNS cache
+  * @note   If a resolution is in progress, wait for its end: the name may be the same
+  * @param  name - host name
+  * @param  addr - address of the host if found
+  * @retval bool - true: name found, addr updated
+  *                false: the caller is in charge of the resolution and must call com_dns_cache_update
+  */
+bool com_dns_cache_lookup(const com_char_t *name, com_sockaddr_t *addr)
+{
+  bool result;
+
+  result = com_dns_cache_get(name, addr, false);
+  if (result == false)
+  {
+    /* Only one resolution at a time: the modem processes the DNS requests one by one anyway */
+    (void)rtosalMutexAcquire(com_dns_cache_resolver_mutex, RTOSAL_WAIT_FOREVER);
+
+    /* Previous resolution may be the same name */
+    result = com_dns_cache_get(name, addr, true);
+    if (result == true)
+    {
+      (void)rtosalMutexRelease(com_dns_cache_resolver_mutex);
+    }
+    else
+    {
+      (void)rtosalMutexAcquire(com_dns_cache_mutex, RTOSAL_WAIT_FOREVER);
+      com_dns_cache_resolver_generation = com_dns_cache_generation;
+      com_dns_cache_stat.miss++;
+      (void)rtosalMutexRelease(com_dns_cache_mutex);
+    }
+  }
+
+  if (result == true)
+  {
+    PRINT_DBG("DNS cache: %s found", name)
+  }
+
+  return (result);
+}
+
+/**
+  * @brief  Update the DNS cache with a resolution result
+  * @note   Must be called after com_dns_cache_lookup returned false
+  * @param  name - host name
+  * @param  addr - address of the host or NULL if resolution failed
+  * @param  ttl  - time to live of the address (in s.), 0 if unknown
+  * @retval -
+  */
+void com_dns_cache_update(const com_char_t *name, const com_sockaddr_t *addr, uint32_t ttl)
+{
+  uint32_t cache_ttl;
+
+  if ((addr != NULL)
+      && (strlen((const CSDNS_CHAR_t *)name) < COM_DNS_CACHE_NAME_SIZE))
+  {
+    cache_ttl = (ttl < COM_DNS_CACHE_TTL_MIN) ? COM_DNS_CACHE_TTL_MIN : ttl;
+    cache_ttl = (cache_ttl > COM_DNS_CACHE_TTL_MAX) ? COM_DNS_CACHE_TTL_MAX : cache_ttl;
+
+    (void)rtosalMutexAcquire(com_dns_cache_mutex, RTOSAL_WAIT_FOREVER);
+    /* Network lost during the resolution: the address may be no more valid */
+    if (com_dns_cache_resolver_generation == com_dns_cache_generation)
+    {
+      com_dns_cache_set(name, addr, cache_ttl);
+      PRINT_DBG("DNS cache: %s added for %lds", name, cache_ttl)
+    }
+    (void)rtosalMutexRelease(com_dns_cache_mutex);
+  }
+
+  (void)rtosalMutexRelease(com_dns_cache_resolver_mutex);
+}
+
+/**
+  * @brief  Flush the DNS cache
+  * @note   To call when the network is lost
+  * @retval -
+  */
+void com_dns_cache_flush(void)
+{
+  if (com_dns_cache_mutex != NULL)
+  {
+    (void)rtosalMutexAcquire(com_dns_cache_mutex, RTOSAL_WAIT_FOREVER);
+    for (uint32_t i = 0U; i < COM_DNS_CACHE_NB; i++)
+    {
+      com_dns_cache[i].valid = false;
+    }
+    com_dns_cache_generation++;
+    com_dns_cache_stat.flush++;
+    (void)rtosalMutexRelease(com_dns_cache_mutex);
+    PRINT_INFO("DNS cache flushed")
+  }
+}
+
+/**
+  * @brief  Get the DNS cache statistics
+  * @param  p_stat - statistics
+  * @retval -
+  */
+void com_dns_cache_get_stat(com_dns_cache_stat_t *p_stat)
+{
+  (void)rtosalMutexAcquire(com_dns_cache_mutex, RTOSAL_WAIT_FOREVER);
+  *p_stat = com_dns_cache_stat;
+  (void)rtosalMutexRelease(com_dns_cache_mutex);
+}
+
+#else /* COM_DNS_CACHE_NB == 0U */
+
+/* No cache: each lookup is resolved by the caller */
+bool com_dns_cache_init(void)
+{
+  return (true);
+}
+
+bool com_dns_cache_lookup(const com_char_t *name, com_sockaddr_t *addr)
+{
+  UNUSED(name);
+  UNUSED(addr);
+  return (false);
+}
+
+void com_dns_cache_update(const com_char_t *name, const com_sockaddr_t *addr, uint32_t ttl)
+{
+  UNUSED(name);
+  UNUSED(addr);
+  UNUSED(ttl);
+}
+
+void com_dns_cache_flush(void)
+{
+  /* Nothing to do */
+}
+
+void com_dns_cache_get_stat(com_dns_cache_stat_t *p_stat)
+{
+  (void)memset((void *)p_stat, 0, sizeof(com_dns_cache_stat_t));
+}
+
+#endif /* COM_DNS_CACHE_NB > 0U */
+
+#endif /* USE_SOCKETS_TYPE == USE_SOCKETS_MODEM */
+
+/******************************** END OF FILE *********************************/
@@ -363,6 +363,31 @@ int32_t com_sendto(int32_t sock,
 }
 
 
+/**
+  * @brief  Socket send message
+  * @note   Send data gathered from several buffers, e.g. a protocol header and its payload,
+  *         without copying them in an intermediate buffer
+  * @param  sock      - socket handle obtained with com_socket
+  * @param  msg       - buffers to send and optional remote IP address and port number
+  * @param  flags     - options
+  * @retval int32_t   - number of bytes sent or error value
+  */
+int32_t com_sendmsg(int32_t sock,
+                    const com_msghdr_t *msg,
+                    int32_t flags)
+{
+  int32_t result;
+
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
+  result = com_sendmsg_ip_modem(sock, msg, flags);
+#else
+  result = com_sendmsg_lwip_mcu(sock, msg, flags);
+#endif /* USE_SOCKETS_TYPE == USE_SOCKETS_MODEM */
+
+  return (result);
+}
+
+
 /**
   * @brief  Socket receive data
   * @note   Receive data on already connected socket
@@ -415,6 +440,29 @@ int32_t com_recvfrom(int32_t sock,
   return (result);
 }
 
+/**
+  * @brief  Socket poll
+  * @note   Wait until at least one socket of a set is ready, so one thread can serve several sockets
+  *         COM_POLLIN : com_recv/com_recvfrom has data to return or the socket is closed by remote
+  *         COM_POLLOUT: com_send/com_sendto can be called
+  * @param  fds       - sockets and events requested, revents updated with events ready
+  * @param  nfds      - number of entries in fds (1 to COM_POLL_FDS_MAX)
+  * @param  timeout   - maximum time to wait (in ms), 0: no wait, negative value: wait forever
+  * @retval int32_t   - number of entries with revents != 0, 0 on timeout or error value
+  */
+int32_t com_poll(com_pollfd_t *fds, uint32_t nfds, int32_t timeout)
+{
+  int32_t result;
+
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
+  result = com_poll_ip_modem(fds, nfds, timeout);
+#else
+  result = com_poll_lwip_mcu(fds, nfds, timeout);
+#endif /* USE_SOCKETS_TYPE == USE_SOCKETS_MODEM */
+
+  return (result);
+}
+
 
 /**
   * @brief  Socket close
@@ -27,12 +27,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <inttypes.h>
 
 #include "rtosal.h"
 
 #include "com_sockets_net_compat.h"
 #include "com_sockets_err_compat.h"
 #include "com_sockets_statistic.h"
+#include "com_dns_cache.h"
 
 #include "cellular_service_os.h"
 #if (USE_LOW_POWER == 1)
@@ -73,8 +75,25 @@
 #define COM_MODEM_MAX_TX_DATA_SIZE CONFIG_MODEM_MAX_SOCKET_TX_DATA_SIZE
 #define COM_MODEM_MAX_RX_DATA_SIZE CONFIG_MODEM_MAX_SOCKET_RX_DATA_SIZE
 
+/* A chunk of a com_sendmsg request references at most all the buffers of the request */
+#if (COM_IOV_MAX > CS_IOV_MAX)
+#error "COM_IOV_MAX must not exceed CS_IOV_MAX"
+#endif /* COM_IOV_MAX > CS_IOV_MAX */
+
 #define COM_SOCKET_LOCAL_ID_NB 1U /* Socket local id number : 1 for ping */
 
+/* Socket descriptor pool: one slot per modem socket handle, then one slot per local id */
+#define COM_SOCKET_DESC_NB     (CELLULAR_MAX_SOCKETS + COM_SOCKET_LOCAL_ID_NB)
+
+/* Socket id provided to the application: generation of the slot | slot index
+   A socket id is no more valid once the socket is closed, even if its slot is reused */
+#define COM_SOCKET_SLOT_BITS          8U
+#define COM_SOCKET_SLOT_MASK          0xFFU
+#define COM_SOCKET_GENERATION_MAX     0x7FFFU
+#define COM_SOCKET_ID(generation, slot) \
+  ((int32_t)(((uint32_t)(generation) << COM_SOCKET_SLOT_BITS) | (uint32_t)(slot)))
+#define COM_SOCKET_SLOT(id)           ((uint32_t)(id) & COM_SOCKET_SLOT_MASK)
+
 #define COM_LOCAL_PORT_BEGIN  0xc000U /* 49152 */
 #define COM_LOCAL_PORT_END    0xffffU /* 65535 */
 
@@ -82,6 +101,17 @@
 #define COM_TIMER_INACTIVITY_MS 10000U /* in ms */
 #endif /* USE_LOW_POWER == 1 */
 
+/* Receive read-ahead of a TCP socket: a com_recv smaller than this size reads up to this size
+   from the modem, the next com_recv are served from RAM (0: no read-ahead) */
+#if !defined COM_RCV_AHEAD_SIZE
+#define COM_RCV_AHEAD_SIZE      (512U)
+#endif /* !defined COM_RCV_AHEAD_SIZE */
+
+/* Number of com_poll calls that can wait at the same time (one per event-loop thread) */
+#if !defined COM_POLL_WAITER_NB
+#define COM_POLL_WAITER_NB      2U
+#endif /* !defined COM_POLL_WAITER_NB */
+
 /* Private typedef -----------------------------------------------------------*/
 typedef char CSIP_CHAR_t; /* used in stdio.h and string.h service call */
 
@@ -116,9 +146,14 @@ typedef struct _socket_desc_t
   bool                  local;       /*   internal id - e.g for ping
                                        or external id - e.g modem    */
   bool                  closing;     /* close recv from remote  */
+  bool                  rx_pending;  /* data notified by modem and maybe not yet read */
+  uint16_t              rcv_ahead_pos; /* first byte of read-ahead data not yet returned */
+  uint16_t              rcv_ahead_len; /* read-ahead data not yet returned */
   uint8_t               type;        /* Socket Type TCP/UDP/RAW */
   int32_t               error;       /* last command status     */
-  int32_t               id;          /* identifier */
+  int32_t               id;          /* identifier provided to the application */
+  socket_handle_t       handle;      /* modem socket handle or local id */
+  uint16_t              generation;  /* incremented at each use of the slot */
   uint16_t              local_port;  /* local port */
   uint16_t              remote_port; /* remote port */
   com_ip_addr_t         remote_addr; /* remote addr */
@@ -126,7 +161,6 @@ typedef struct _socket_desc_t
   uint32_t              rcv_timeout; /* timeout for receive cmd */
   osMessageQId          queue;       /* message queue for URC   */
   com_ping_rsp_t        *rsp;
-  struct _socket_desc_t *next;       /* chained list            */
 } socket_desc_t;
 
 typedef struct
@@ -187,20 +221,28 @@ socket_msg_t
 /* Private variables ---------------------------------------------------------*/
 
 /* Mutex to protect access to :
-   socket descriptor list,
-   socket local_id array */
+   socket descriptor pool allocation */
 static osMutexId ComSocketsMutexHandle;
 
-static socket_desc_t *socket_desc_list; /* Socket descriptor list */
-
-/* Provide a socket local id - Used for Ping */
-static bool socket_local_id[COM_SOCKET_LOCAL_ID_NB]; /* false : unused, true  : in use  */
+/* Socket descriptor pool - index is modem socket handle
+   or CELLULAR_MAX_SOCKETS + local id (local id used for Ping) */
+static socket_desc_t socket_desc_pool[COM_SOCKET_DESC_NB];
 #if (USE_COM_PING == 1)
 static int32_t ping_socket_id; /* Ping socket id */
 #endif /* USE_COM_PING  == 1 */
 
 static bool com_sockets_network_is_up; /* Network status is managed through Datacache */
 
+/* com_poll waiters: a waiter semaphore is released at each socket event
+   com_poll_waiter_used is protected by ComSocketsMutexHandle */
+static osSemaphoreId com_poll_waiter_sem[COM_POLL_WAITER_NB];
+static bool com_poll_waiter_used[COM_POLL_WAITER_NB];
+
+#if (COM_RCV_AHEAD_SIZE > 0U)
+/* Read-ahead buffer of each modem socket - index is modem socket handle */
+static com_char_t com_rcv_ahead_buf[CELLULAR_MAX_SOCKETS][COM_RCV_AHEAD_SIZE];
+#endif /* COM_RCV_AHEAD_SIZE > 0U */
+
 #if (USE_LOW_POWER == 1)
 /* Timer to check inactivity on socket and maybe to go in data idle mode */
 static osTimerId ComTimerInactivityId;
@@ -248,14 +290,14 @@ static void com_ip_modem_timer_inactivity_cb(void *argument);
 
 /* Initialize a socket descriptor */
 static void com_ip_modem_init_socket_desc(socket_desc_t *socket_desc);
-/* Create a socket descriptor */
-static socket_desc_t *com_ip_modem_create_socket_desc(void);
 /* Provide a free socket descriptor */
-static socket_desc_t *com_ip_modem_provide_socket_desc(bool local);
+static socket_desc_t *com_ip_modem_provide_socket_desc(bool local, socket_handle_t handle);
 /* Delete a socket descriptor - in fact reinitialize it */
 static void com_ip_modem_delete_socket_desc(int32_t sock, bool local);
 /* Find a socket descriptor */
 static socket_desc_t *com_ip_modem_find_socket(int32_t sock, bool local);
+/* Find a socket descriptor from its modem socket handle */
+static socket_desc_t *com_ip_modem_find_socket_handle(socket_handle_t handle);
 
 /* Empty queue from all messages */
 static void com_ip_modem_empty_queue(osMessageQId queue);
@@ -292,6 +334,30 @@ static void com_ip_modem_idlemode_request(bool immediate);
 static bool com_ip_modem_are_all_sockets_invalid(void);
 #endif /* USE_LOW_POWER == 1U */
 
+/* Message length and split of a message in chunks for the low level */
+static uint32_t com_ip_modem_msg_length(const com_msghdr_t *msg);
+static uint32_t com_ip_modem_msg_chunk(const com_msghdr_t *msg, uint32_t offset, uint32_t max_length,
+                                       CS_IOVec_t *p_chunk, uint8_t *p_chunk_nb);
+
+/* Receive data and keep track of the data still available in the modem */
+static int32_t com_ip_modem_receive(socket_desc_t *socket_desc,
+                                    com_char_t *buf, uint32_t len);
+static uint32_t com_ip_modem_rcv_ahead_get(socket_desc_t *socket_desc,
+                                           com_char_t *buf, uint32_t len);
+#if (UDP_SERVICE_SUPPORTED == 1U)
+static int32_t com_ip_modem_receivefrom(socket_desc_t *socket_desc,
+                                        com_char_t *buf, uint32_t len,
+                                        CS_IPaddrType_t *p_addr_type,
+                                        CS_CHAR_t *p_ip_addr_value,
+                                        uint16_t *p_remote_port);
+#endif /* UDP_SERVICE_SUPPORTED == 1U */
+
+/* com_poll services */
+static void com_ip_modem_poll_notify(void);
+static uint32_t com_ip_modem_poll_waiter_get(void);
+static void com_ip_modem_poll_waiter_release(uint32_t waiter);
+static int16_t com_ip_modem_poll_revents(const com_pollfd_t *fd);
+
 /* Private function Definition -----------------------------------------------*/
 
 /**
@@ -305,7 +371,11 @@ static void com_ip_modem_init_socket_desc(socket_desc_t *socket_desc)
   socket_desc->state            = COM_SOCKET_INVALID;
   socket_desc->local            = false;
   socket_desc->closing          = false;
+  socket_desc->rx_pending       = false;
+  socket_desc->rcv_ahead_pos    = 0U;
+  socket_desc->rcv_ahead_len    = 0U;
   socket_desc->id               = COM_SOCKET_INVALID_ID;
+  socket_desc->handle           = CS_INVALID_SOCKET_HANDLE;
   socket_desc->local_port       = 0U;
   socket_desc->remote_port      = 0U;
   socket_desc->remote_addr.addr = 0U;
@@ -313,142 +383,78 @@ static void com_ip_modem_init_socket_desc(socket_desc_t *socket_desc)
   socket_desc->rcv_timeout      = RTOSAL_WAIT_FOREVER;
   socket_desc->snd_timeout      = RTOSAL_WAIT_FOREVER;
   socket_desc->error            = COM_SOCKETS_ERR_OK;
-  /* socket_desc->next is not re-initialize - element is let in the list at its place */
+  /* socket_desc->generation is not re-initialize - a new id is provided at each use of the slot */
   /* socket_desc->queue is not re-initialize - queue is reused */
 }
 
-/**
-  * @brief  Create a socket descriptor
-  * @note   Allocate a new socket_desc_t and its queue
-  *         and initialize the socket to default value
-  * @param  -
-  * @retval socket_desc_t or NULL (if not enough memory)
-  */
-static socket_desc_t *com_ip_modem_create_socket_desc(void)
-{
-  socket_desc_t *socket_desc;
-
-  socket_desc = (socket_desc_t *)pvPortMalloc(sizeof(socket_desc_t));
-  if (socket_desc != NULL)
-  {
-    socket_desc->queue = rtosalMessageQueueNew(NULL, 4U);
-    if (socket_desc->queue == NULL)
-    {
-      /* Not enough memory - Deallocate socket_desc */
-      vPortFree(socket_desc);
-      socket_desc = NULL;
-    }
-    else
-    {
-      socket_desc->next = NULL;
-      com_ip_modem_init_socket_desc(socket_desc);
-    }
-  }
-
-  return socket_desc;
-}
-
 /**
   * @brief  Provide a socket descriptor
-  * @note   Search the first empty place in the chained socket list
-  *         or create a new socket and add it at the end of the chained list
+  * @note   Network socket: the slot of the modem socket handle
+  *         Local socket: the first free local slot
   * @param  local
   * @note   true/false socket is local (used for Ping) / network one
-  * @retval socket_desc_t or NULL (if not enough memory)
+  * @param  handle
+  * @note   modem socket handle - not used if local is true
+  * @retval socket_desc_t or NULL (if no slot available)
   */
-static socket_desc_t *com_ip_modem_provide_socket_desc(bool local)
+static socket_desc_t *com_ip_modem_provide_socket_desc(bool local, socket_handle_t handle)
 {
-  /* Chained list will be changed */
+  /* Pool will be changed */
   (void)rtosalMutexAcquire(ComSocketsMutexHandle, RTOSAL_WAIT_FOREVER);
 
-  bool found;
-  uint8_t i;
+  uint32_t slot;
   socket_desc_t *socket_desc;
-  socket_desc_t *socket_desc_previous;
 
-  i = 0U;
-  found = false;
-  socket_desc = socket_desc_list;
+  socket_desc = NULL;
 
-  /* If socket is local first check an id is still available in the table */
   if (local == true)
   {
-    while ((i < COM_SOCKET_LOCAL_ID_NB) && (found == false))
+    /* First check a local id is still available */
+    for (slot = CELLULAR_MAX_SOCKETS; (slot < COM_SOCKET_DESC_NB) && (socket_desc == NULL); slot++)
     {
-      if (socket_local_id[i] == false)
+      if (socket_desc_pool[slot].state == COM_SOCKET_INVALID)
       {
-        found = true; /* an unused local id has been found */
-        /* com_socket_local_id book is done only if socket is really created */
-      }
-      else
-      {
-        i++;
+        socket_desc = &socket_desc_pool[slot];
+        /* even if an application create two sockets one local - one distant
+           no issue because the slots are different */
+        socket_desc->handle = (socket_handle_t)slot - (socket_handle_t)CELLULAR_MAX_SOCKETS;
       }
     }
   }
+  else if ((handle >= 0) && ((uint32_t)handle < CELLULAR_MAX_SOCKETS))
+  {
+    /* Modem socket handle is free at modem level: if its slot is still used, the socket is closed
+       at modem level and com_closesocket has not yet deleted its descriptor - the slot is taken over,
+       the id of the closed socket is no more found and its deletion has no effect */
+    socket_desc = &socket_desc_pool[handle];
+    if (socket_desc->state != COM_SOCKET_INVALID)
+    {
+      PRINT_DBG("socket desc %ld closed at modem level, slot reused", socket_desc->id)
+      com_ip_modem_init_socket_desc(socket_desc);
+    }
+    socket_desc->handle = handle;
+  }
   else
   {
-    found = true; /* if local == false no specific treatment to do */
+    /* Handle out of pool - should not happen */
+    __NOP();
   }
 
-  if ((found == true) && (i < COM_SOCKET_LOCAL_ID_NB))
+  if (socket_desc != NULL)
   {
-    /* Need to create a new socket_desc ? */
-    while ((socket_desc->state != COM_SOCKET_INVALID)
-           && (socket_desc->next != NULL))
-    {
-      socket_desc = socket_desc->next; /* Check next descriptor */
-    }
-    /* Find an empty socket ? */
-    if (socket_desc->state != COM_SOCKET_INVALID)
-    {
-      /* No empty socket, save the last socket descriptor to attach the new one */
-      socket_desc_previous = socket_desc;
-      /* Create new socket descriptor */
-      socket_desc = com_ip_modem_create_socket_desc();
-      if (socket_desc != NULL)
-      {
-        PRINT_DBG("socket desc created %ld queue %p", socket_desc->id, socket_desc->queue)
-        /* Before to attach this new socket to the descriptor list finalize its initialization */
-        socket_desc->state = COM_SOCKET_CREATING;
-        socket_desc->local = local;
-        if (local == true)
-        {
-          /* even if an application create two sockets one local - one distant
-             no issue if id is same because it will be stored
-             in two variables at application level */
-          /* Don't need an OFFSET to not overlap Modem id */
-          socket_desc->id = (int32_t)i;
-          /*  Socket is really created - book com_socket_local_id */
-          socket_local_id[i] = true;
-        }
-        /* Initialization is finalized, socket can be attached to the list
-           and so visible to other functions
-           even the one accessing in read mode to socket descriptor list */
-        socket_desc_previous->next = socket_desc;
-      }
-    }
-    else
-    {
-      /* Find an empty place */
-      socket_desc->state = COM_SOCKET_CREATING;
-      socket_desc->local = local;
-      if (local == true)
-      {
-        /* even if an application create two sockets one local - one distant
-           no issue if id is same because it will be stored
-           in two variable s at application level */
-        /* Don't need an OFFSET to not overlap Modem id */
-        socket_desc->id = (int32_t)i;
-        /*  Socket is really created - book com_socket_local_id */
-        socket_local_id[i] = true;
-      }
-    }
+    /* A new id for each use of the slot */
+    socket_desc->generation = (socket_desc->generation >= COM_SOCKET_GENERATION_MAX) ? \
+                              1U : (socket_desc->generation + 1U);
+    socket_desc->id    = COM_SOCKET_ID(socket_desc->generation, (uint32_t)(socket_desc - &socket_desc_pool[0]));
+    socket_desc->local = local;
+    /* Last update: socket becomes visible to the functions accessing in read mode to the pool */
+    socket_desc->state = COM_SOCKET_CREATING;
+    PRINT_DBG("socket desc provided %ld handle %ld", socket_desc->id, socket_desc->handle)
   }
 
   (void)rtosalMutexRelease(ComSocketsMutexHandle);
 
-  /* If provide == false then socket_desc = NULL */
+  /* If no slot available then socket_desc = NULL */
   return socket_desc;
 }
 
@@ -463,41 +469,16 @@ static socket_desc_t *com_ip_modem_provide_socket_desc(bool local)
   */
 static void com_ip_modem_delete_socket_desc(int32_t sock, bool local)
 {
-  /* Chained list will be changed */
+  /* Pool will be changed */
   (void)rtosalMutexAcquire(ComSocketsMutexHandle, RTOSAL_WAIT_FOREVER);
 
-  bool found;
   socket_desc_t *socket_desc;
 
-  found = false;
-
-  socket_desc = socket_desc_list;
-
-  /* Search the socket descriptor */
-  while ((socket_desc != NULL)
-         && (found != true))
-  {
-    if ((socket_desc->id == sock)
-        && (socket_desc->local == local))
-    {
-      /* Socket descriptor is found */
-      found = true;
-    }
-    else
-    {
-      /* Not the searched one ... Next */
-      socket_desc = socket_desc->next;
-    }
-  }
-  if (found == true)
+  socket_desc = com_ip_modem_find_socket(sock, local);
+  if (socket_desc != NULL)
   {
-    /* Always keep a created socket */
+    /* Always keep the slot and its queue */
     com_ip_modem_init_socket_desc(socket_desc);
-    if (local == true)
-    {
-      /* Free com_socket_local_id */
-      socket_local_id[sock] = false;
-    }
   }
 
   (void)rtosalMutexRelease(ComSocketsMutexHandle);
@@ -505,7 +486,8 @@ static void com_ip_modem_delete_socket_desc(int32_t sock, bool local)
 
 /**
   * @brief  Find a socket descriptor
-  * @note   Search the socket descriptor
+  * @note   Direct access to the slot of the socket id
+  *         the id of a closed socket is not found even if its slot is reused
   * @param  sock
   * @note   socket id
   * @param  local
@@ -515,37 +497,49 @@ static void com_ip_modem_delete_socket_desc(int32_t sock, bool local)
 static socket_desc_t *com_ip_modem_find_socket(int32_t sock, bool local)
 {
   socket_desc_t *socket_desc;
+  uint32_t slot;
+
+  socket_desc = NULL;
 
   if (sock >= 0)
   {
-    bool found;
-
-    socket_desc = socket_desc_list;
-    found = false;
-
-    /* Search the socket descriptor */
-    while ((socket_desc != NULL)
-           && (found != true))
+    slot = COM_SOCKET_SLOT(sock);
+    if ((slot < COM_SOCKET_DESC_NB)
+        && (socket_desc_pool[slot].id == sock)
+        && (socket_desc_pool[slot].local == local))
     {
-      if ((socket_desc->id == sock)
-          && (socket_desc->local == local))
-      {
-        /* Socket descriptor is found */
-        found = true;
-      }
-      else
-      {
-        /* Not the searched one ... Next */
-        socket_desc = socket_desc->next;
-      }
+      /* Socket descriptor is found */
+      socket_desc = &socket_desc_pool[slot];
     }
   }
-  else
+
+  /* If not found then socket_desc = NULL */
+  return socket_desc;
+}
+
+/**
+  * @brief  Find a socket descriptor from its modem socket handle
+  * @note   Used by the callbacks called by AT
+  * @param  handle
+  * @note   modem socket handle
+  * @retval socket_desc_t or NULL
+  */
+static socket_desc_t *com_ip_modem_find_socket_handle(socket_handle_t handle)
+{
+  socket_desc_t *socket_desc;
+
+  socket_desc = NULL;
+
+  if ((handle >= 0) && ((uint32_t)handle < CELLULAR_MAX_SOCKETS))
   {
-    socket_desc = NULL;
+    if ((socket_desc_pool[handle].state != COM_SOCKET_INVALID)
+        && (socket_desc_pool[handle].handle == handle))
+    {
+      socket_desc = &socket_desc_pool[handle];
+    }
   }
 
-  /* If found == false then socket_desc = NULL */
+  /* If not found then socket_desc = NULL */
   return socket_desc;
 }
 
@@ -580,31 +574,346 @@ static void com_ip_modem_empty_queue(osMessageQId queue)
   */
 static bool com_ip_modem_are_all_sockets_invalid(void)
 {
-  socket_desc_t *socket_desc;
+  uint32_t slot;
   bool result; /* false : at least one socket is still open
                   true : all sockets are Invalid */
 
-  socket_desc = socket_desc_list;
   result = true;
 
-  /* Search the socket descriptor */
-  while ((socket_desc != NULL)
-         && (result != false))
+  /* Search a valid socket descriptor */
+  for (slot = 0U; (slot < COM_SOCKET_DESC_NB) && (result != false); slot++)
   {
-    if (socket_desc->id > COM_SOCKET_INVALID_ID)
+    if (socket_desc_pool[slot].id > COM_SOCKET_INVALID_ID)
     {
       result = false;
     }
+  }
+
+  return result;
+}
+#endif /* USE_LOW_POWER == 1 */
+
+/**
+  * @brief  Message length
+  * @note   Check the buffers of a com_sendmsg request
+  * @param  msg - message to send
+  * @retval uint32_t - total length of the buffers, 0 if the message is not valid
+  */
+static uint32_t com_ip_modem_msg_length(const com_msghdr_t *msg)
+{
+  uint32_t length;
+  bool valid;
+
+  length = 0U;
+  valid = ((msg != NULL)
+           && (msg->msg_iov != NULL)
+           && (msg->msg_iovlen > 0)
+           && (msg->msg_iovlen <= COM_IOV_MAX));
+
+  for (int32_t i = 0; (valid == true) && (i < msg->msg_iovlen); i++)
+  {
+    /* total length must be representable as a result of com_sendmsg */
+    if ((msg->msg_iov[i].iov_len < 0)
+        || ((msg->msg_iov[i].iov_base == NULL) && (msg->msg_iov[i].iov_len != 0))
+        || ((uint32_t)msg->msg_iov[i].iov_len > ((uint32_t)INT32_MAX - length)))
+    {
+      valid = false;
+    }
     else
     {
-      /* Socket is Invalid, check the next one */
-      socket_desc = socket_desc->next;
+      length += (uint32_t)msg->msg_iov[i].iov_len;
     }
   }
 
-  return result;
+  return ((valid == true) ? length : 0U);
+}
+
+/**
+  * @brief  Message chunk
+  * @note   Reference the part of a message which starts at offset, up to max_length bytes,
+  *         in a buffers list for the low level - the data are not copied
+  * @param  msg        - message to send, already checked by com_ip_modem_msg_length
+  * @param  offset     - number of bytes of the message already sent
+  * @param  max_length - maximum length of the chunk
+  * @param  p_chunk    - buffers list of the chunk (COM_IOV_MAX elements)
+  * @param  p_chunk_nb - number of buffers in the chunk
+  * @retval uint32_t   - length of the chunk
+  */
+static uint32_t com_ip_modem_msg_chunk(const com_msghdr_t *msg, uint32_t offset, uint32_t max_length,
+                                       CS_IOVec_t *p_chunk, uint8_t *p_chunk_nb)
+{
+  uint32_t skip;
+  uint32_t length;
+  uint8_t chunk_nb;
+
+  skip = offset;
+  length = 0U;
+  chunk_nb = 0U;
+
+  for (int32_t i = 0; (i < msg->msg_iovlen) && (length < max_length); i++)
+  {
+    uint32_t iov_len = (uint32_t)msg->msg_iov[i].iov_len;
+
+    if (skip >= iov_len)
+    {
+      /* buffer already sent (or empty) */
+      skip -= iov_len;
+    }
+    else
+    {
+      p_chunk[chunk_nb].p_buf = (const CS_CHAR_t *)&msg->msg_iov[i].iov_base[skip];
+      p_chunk[chunk_nb].length = COM_MIN(iov_len - skip, max_length - length);
+      length += p_chunk[chunk_nb].length;
+      chunk_nb++;
+      skip = 0U;
+    }
+  }
+  *p_chunk_nb = chunk_nb;
+
+  return length;
+}
+
+/**
+  * @brief  Receive data
+  * @note   Data ready notification is only sent by the modem when new data are received:
+  *         if the buffer is filled, more data may be available without new notification
+  * @note   TCP socket: a read smaller than COM_RCV_AHEAD_SIZE reads up to COM_RCV_AHEAD_SIZE,
+  *         the data not returned are kept for the next com_recv (see com_ip_modem_rcv_ahead_get())
+  * @param  socket_desc - socket descriptor
+  * @param  buf         - buffer to store the data to
+  * @param  len         - size of the buffer
+  * @retval int32_t     - number of bytes received or error value
+  */
+static int32_t com_ip_modem_receive(socket_desc_t *socket_desc,
+                                    com_char_t *buf, uint32_t len)
+{
+  int32_t len_rcv;
+  uint32_t start_tick;
+  uint32_t len_modem;
+  com_char_t *p_buf_modem;
+
+  start_tick = rtosalGetSysTimerCount();
+  len_modem = len;
+  p_buf_modem = buf;
+
+#if (COM_RCV_AHEAD_SIZE > 0U)
+  if ((socket_desc->type == (uint8_t)COM_SOCK_STREAM)
+      && (len < COM_MIN(COM_RCV_AHEAD_SIZE, COM_MODEM_MAX_RX_DATA_SIZE)))
+  {
+    /* Read-ahead buffer is empty: com_recv serves it before to read the modem */
+    len_modem = COM_MIN(COM_RCV_AHEAD_SIZE, COM_MODEM_MAX_RX_DATA_SIZE);
+    p_buf_modem = &com_rcv_ahead_buf[socket_desc->handle][0];
+  }
+#endif /* COM_RCV_AHEAD_SIZE > 0U */
+
+  /* A data ready notification received from now on is for new data */
+  socket_desc->rx_pending = false;
+  len_rcv = osCDS_socket_receive(socket_desc->handle, p_buf_modem, len_modem);
+  com_sockets_statistic_latency(COM_SOCKET_STAT_OP_RCV_MDM, start_tick, len_rcv);
+  if ((len_rcv > 0) && ((uint32_t)len_rcv == len_modem))
+  {
+    socket_desc->rx_pending = true;
+  }
+
+  if ((len_rcv > 0) && (p_buf_modem != buf))
+  {
+    socket_desc->rcv_ahead_pos = 0U;
+    socket_desc->rcv_ahead_len = (uint16_t)len_rcv;
+    len_rcv = (int32_t)com_ip_modem_rcv_ahead_get(socket_desc, buf, len);
+  }
+
+  return len_rcv;
+}
+
+/**
+  * @brief  Get data from the read-ahead buffer
+  * @note   No modem access
+  * @param  socket_desc - socket descriptor
+  * @param  buf         - buffer to store the data to
+  * @param  len         - size of the buffer
+  * @retval uint32_t    - number of bytes returned (0: read-ahead buffer empty)
+  */
+static uint32_t com_ip_modem_rcv_ahead_get(socket_desc_t *socket_desc,
+                                           com_char_t *buf, uint32_t len)
+{
+  uint32_t length;
+
+  length = 0U;
+
+#if (COM_RCV_AHEAD_SIZE > 0U)
+  if (socket_desc->rcv_ahead_len != 0U)
+  {
+    length = COM_MIN(len, (uint32_t)socket_desc->rcv_ahead_len);
+    (void)memcpy((void *)buf,
+                 (const void *)&com_rcv_ahead_buf[socket_desc->handle][socket_desc->rcv_ahead_pos],
+                 length);
+    socket_desc->rcv_ahead_pos += (uint16_t)length;
+    socket_desc->rcv_ahead_len -= (uint16_t)length;
+  }
+#else /* COM_RCV_AHEAD_SIZE == 0U */
+  UNUSED(socket_desc);
+  UNUSED(buf);
+  UNUSED(len);
+#endif /* COM_RCV_AHEAD_SIZE > 0U */
+
+  return length;
+}
+
+#if (UDP_SERVICE_SUPPORTED == 1U)
+/**
+  * @brief  Receive data from a remote host
+  * @note   See com_ip_modem_receive()
+  * @param  socket_desc     - socket descriptor
+  * @param  buf             - buffer to store the data to
+  * @param  len             - size of the buffer
+  * @param  p_addr_type     - remote IP address type
+  * @param  p_ip_addr_value - remote IP address
+  * @param  p_remote_port   - remote port
+  * @retval int32_t         - number of bytes received or error value
+  */
+static int32_t com_ip_modem_receivefrom(socket_desc_t *socket_desc,
+                                        com_char_t *buf, uint32_t len,
+                                        CS_IPaddrType_t *p_addr_type,
+                                        CS_CHAR_t *p_ip_addr_value,
+                                        uint16_t *p_remote_port)
+{
+  int32_t len_rcv;
+
+  /* A data ready notification received from now on is for new data */
+  socket_desc->rx_pending = false;
+  len_rcv = osCDS_socket_receivefrom(socket_desc->handle, buf, len,
+                                     p_addr_type, p_ip_addr_value, p_remote_port);
+  if ((len_rcv > 0) && ((uint32_t)len_rcv == len))
+  {
+    socket_desc->rx_pending = true;
+  }
+
+  return len_rcv;
+}
+#endif /* UDP_SERVICE_SUPPORTED == 1U */
+
+/**
+  * @brief  Wake up the com_poll waiters
+  * @note   Called on each socket event - the waiters check the readiness of their sockets
+  * @param  -
+  * @retval -
+  */
+static void com_ip_modem_poll_notify(void)
+{
+  for (uint32_t waiter = 0U; waiter < COM_POLL_WAITER_NB; waiter++)
+  {
+    if (com_poll_waiter_used[waiter] == true)
+    {
+      /* Semaphore maybe already released: the waiter has not yet checked the previous event */
+      (void)rtosalSemaphoreRelease(com_poll_waiter_sem[waiter]);
+    }
+  }
+}
+
+/**
+  * @brief  Provide a com_poll waiter
+  * @param  -
+  * @retval uint32_t - waiter index, COM_POLL_WAITER_NB if all waiters are used
+  */
+static uint32_t com_ip_modem_poll_waiter_get(void)
+{
+  uint32_t waiter;
+
+  (void)rtosalMutexAcquire(ComSocketsMutexHandle, RTOSAL_WAIT_FOREVER);
+  waiter = 0U;
+  while ((waiter < COM_POLL_WAITER_NB) && (com_poll_waiter_used[waiter] == true))
+  {
+    waiter++;
+  }
+  if (waiter < COM_POLL_WAITER_NB)
+  {
+    /* Forget the events notified to the previous user of the waiter */
+    (void)rtosalSemaphoreAcquire(com_poll_waiter_sem[waiter], 0U);
+    com_poll_waiter_used[waiter] = true;
+  }
+  (void)rtosalMutexRelease(ComSocketsMutexHandle);
+
+  return waiter;
+}
+
+/**
+  * @brief  Release a com_poll waiter
+  * @param  waiter - waiter index
+  * @retval -
+  */
+static void com_ip_modem_poll_waiter_release(uint32_t waiter)
+{
+  (void)rtosalMutexAcquire(ComSocketsMutexHandle, RTOSAL_WAIT_FOREVER);
+  com_poll_waiter_used[waiter] = false;
+  (void)rtosalMutexRelease(ComSocketsMutexHandle);
+}
+
+/**
+  * @brief  Events ready on a socket of a com_poll request
+  * @param  fd      - socket and events requested
+  * @retval int16_t - events ready
+  */
+static int16_t com_ip_modem_poll_revents(const com_pollfd_t *fd)
+{
+  const socket_desc_t *socket_desc;
+  uint16_t events;
+  uint16_t revents;
+  bool writable;
+
+  events = (uint16_t)fd->events;
+  revents = 0U;
+
+  /* A negative fd is ignored */
+  if (fd->fd >= 0)
+  {
+    socket_desc = com_ip_modem_find_socket(fd->fd, false);
+    if (socket_desc == NULL)
+    {
+      revents = (uint16_t)COM_POLLNVAL;
+    }
+    else
+    {
+      /* Closing: com_recv returns the last data then the closing error */
+      if (socket_desc->closing == true)
+      {
+        revents |= (uint16_t)COM_POLLHUP;
+        revents |= (events & (uint16_t)COM_POLLIN);
+      }
+      else if ((socket_desc->rx_pending == true) || (socket_desc->rcv_ahead_len != 0U))
+      {
+        revents |= (events & (uint16_t)COM_POLLIN);
+      }
+      else
+      {
+        /* No data to read */
+      }
+
+      if (com_ip_modem_is_network_up() == true)
+      {
+        writable = ((socket_desc->state == COM_SOCKET_CONNECTED) && (socket_desc->closing == false));
+#if (UDP_SERVICE_SUPPORTED == 1U)
+        /* sendto does the implicit bind and connect */
+        writable = writable || ((socket_desc->state == COM_SOCKET_CREATED)
+                                && (socket_desc->type == (uint8_t)COM_SOCK_DGRAM));
+#endif /* UDP_SERVICE_SUPPORTED == 1U */
+        if (writable == true)
+        {
+          revents |= (events & (uint16_t)COM_POLLOUT);
+        }
+      }
+      else if (socket_desc->state >= COM_SOCKET_CONNECTED)
+      {
+        revents |= (uint16_t)COM_POLLERR;
+      }
+      else
+      {
+        /* Socket not yet connected: wait for the network */
+      }
+    }
+  }
+
+  return (int16_t)revents;
 }
-#endif /* USE_LOW_POWER == 1 */
 
 /**
   * @brief  Translate a com_sockaddr_t to a socket_addr_t
@@ -694,8 +1003,9 @@ static bool com_convert_IPString_to_sockaddr(uint16_t       ipaddr_port,
 
     (void)memset(sockaddr, 0, sizeof(com_sockaddr_t));
 
+    /* SCNu32: ip_addr[] is uint32_t whatever the size of long */
     count = sscanf((CSIP_CHAR_t *)(&ipaddr_str[begin]),
-                   "%03lu.%03lu.%03lu.%03lu",
+                   "%03" SCNu32 ".%03" SCNu32 ".%03" SCNu32 ".%03" SCNu32,
                    &ip_addr[0], &ip_addr[1],
                    &ip_addr[2], &ip_addr[3]);
 
@@ -786,7 +1096,7 @@ static uint16_t com_ip_modem_new_local_port(void)
   bool found;
   uint16_t iter;
   uint16_t result;
-  socket_desc_t *socket_desc;
+  uint32_t slot;
 
   local_port_ok = false;
   iter = 0U;
@@ -802,22 +1112,16 @@ static uint16_t com_ip_modem_new_local_port(void)
       com_local_port = COM_LOCAL_PORT_BEGIN;
     }
 
-    socket_desc = socket_desc_list;
     found = false;
 
     /* See if a socket already created is not using this port */
-    while ((socket_desc != NULL)
-           && (found != true))
+    for (slot = 0U; (slot < COM_SOCKET_DESC_NB) && (found != true); slot++)
     {
-      if (socket_desc->local_port == com_local_port)
+      if (socket_desc_pool[slot].local_port == com_local_port)
       {
         /* Local port already used */
         found = true;
       }
-      else
-      {
-        socket_desc = socket_desc->next;
-      }
     }
 
     if (found == false)
@@ -879,13 +1183,13 @@ static int32_t com_ip_modem_connect_udp_service(socket_desc_t *socket_desc)
       com_ip_modem_wakeup_request();
 
       /* Bind */
-      if (osCDS_socket_bind(socket_desc->id,
+      if (osCDS_socket_bind(socket_desc->handle,
                             socket_desc->local_port)
           == CELLULAR_OK)
       {
         PRINT_INFO("socket internal bind ok")
         /* Connect UDP service */
-        if (osCDS_socket_connect(socket_desc->id,
+        if (osCDS_socket_connect(socket_desc->handle,
                                  CS_IPAT_IPV4,
                                  CONFIG_MODEM_UDP_SERVICE_CONNECT_IP,
                                  0)
@@ -1031,12 +1335,16 @@ static void com_ip_modem_data_ready_cb(socket_handle_t sock)
   socket_desc_t    *socket_desc;
 
   msg_queue = 0U;
-  socket_desc = com_ip_modem_find_socket(sock, false);
+  socket_desc = com_ip_modem_find_socket_handle(sock);
 
   if (socket_desc != NULL)
   {
     if (socket_desc->closing != true)
     {
+      /* Data to read, even if nobody is waiting for them in com_recv */
+      socket_desc->rx_pending = true;
+      com_ip_modem_poll_notify();
+
       if (socket_desc->state == COM_SOCKET_WAITING_RSP)
       {
         PRINT_INFO("cb socket %ld data ready called: waiting rsp", socket_desc->id)
@@ -1085,7 +1393,7 @@ static void com_ip_modem_closing_cb(socket_handle_t sock)
   socket_desc_t    *socket_desc;
 
   msg_queue = 0U;
-  socket_desc = com_ip_modem_find_socket(sock, false);
+  socket_desc = com_ip_modem_find_socket_handle(sock);
 
   if (socket_desc != NULL)
   {
@@ -1094,6 +1402,7 @@ static void com_ip_modem_closing_cb(socket_handle_t sock)
     {
       socket_desc->closing = true;
       PRINT_INFO("cb socket closing: close rqt")
+      com_ip_modem_poll_notify();
     }
     if ((socket_desc->state == COM_SOCKET_WAITING_RSP)
         || (socket_desc->state == COM_SOCKET_WAITING_FROM))
@@ -1160,6 +1469,10 @@ static void com_socket_datacache_cb(dc_com_event_id_t dc_event_id,
         {
           com_sockets_network_is_up = false;
           com_sockets_statistic_update(COM_SOCKET_STAT_NWK_DWN);
+          /* Addresses may change with the next PDN activation */
+          com_dns_cache_flush();
+          /* Connected sockets are in error */
+          com_ip_modem_poll_notify();
 #if (USE_LOW_POWER == 1)
           (void)rtosalMutexAcquire(ComTimerInactivityMutexHandle, RTOSAL_WAIT_FOREVER);
           com_timer_inactivity_state = COM_TIMER_IDLE;
@@ -1423,7 +1736,7 @@ int32_t com_socket_ip_modem(int32_t family, int32_t type, int32_t protocol)
       PRINT_INFO("create socket ok low level")
 
       /* Need to create a new socket_desc ? */
-      socket_desc = com_ip_modem_provide_socket_desc(false);
+      socket_desc = com_ip_modem_provide_socket_desc(false, sock);
       if (socket_desc == NULL)
       {
         result = COM_SOCKETS_ERR_NOMEMORY;
@@ -1442,8 +1755,7 @@ int32_t com_socket_ip_modem(int32_t family, int32_t type, int32_t protocol)
       }
       else
       {
-        /* Update socket descriptor */
-        socket_desc->id    = sock;
+        /* Update socket descriptor - id provided by com_ip_modem_provide_socket_desc */
         socket_desc->type  = (uint8_t)type;
         socket_desc->state = COM_SOCKET_CREATED;
 
@@ -1454,11 +1766,13 @@ int32_t com_socket_ip_modem(int32_t family, int32_t type, int32_t protocol)
             == CELLULAR_OK)
         {
           result = COM_SOCKETS_ERR_OK;
+          /* Socket id provided to the application */
+          sock = socket_desc->id;
         }
         else
         {
           PRINT_ERR("rqt close socket issue at creation")
-          if (com_closesocket_ip_modem(sock)
+          if (com_closesocket_ip_modem(socket_desc->id)
               == COM_SOCKETS_ERR_OK)
           {
             PRINT_INFO("close socket ok low level")
@@ -1718,7 +2032,7 @@ int32_t com_bind_ip_modem(int32_t sock,
         result = COM_SOCKETS_ERR_GENERAL;
         PRINT_DBG("socket bind request")
 
-        if (osCDS_socket_bind(sock,
+        if (osCDS_socket_bind(socket_desc->handle,
                               socket_addr.port)
             == CELLULAR_OK)
         {
@@ -1794,9 +2108,11 @@ int32_t com_connect_ip_modem(int32_t sock,
                              const com_sockaddr_t *addr, int32_t addrlen)
 {
   int32_t result;
+  uint32_t start_tick;
   socket_addr_t socket_addr;
   socket_desc_t *socket_desc;
 
+  start_tick = rtosalGetSysTimerCount();
   result = COM_SOCKETS_ERR_PARAMETER;
 
   socket_desc = com_ip_modem_find_socket(sock, false);
@@ -1824,7 +2140,7 @@ int32_t com_connect_ip_modem(int32_t sock,
         if (com_ip_modem_is_network_up() == true)
         {
           com_ip_modem_wakeup_request();
-          if (osCDS_socket_connect(socket_desc->id,
+          if (osCDS_socket_connect(socket_desc->handle,
                                    socket_addr.ip_type,
                                    &socket_addr.ip_value[0],
                                    socket_addr.port)
@@ -1865,7 +2181,7 @@ int32_t com_connect_ip_modem(int32_t sock,
           || (socket_desc->state == COM_SOCKET_CONNECTED))
       {
         com_ip_modem_wakeup_request();
-        if (osCDS_socket_connect(socket_desc->id,
+        if (osCDS_socket_connect(socket_desc->handle,
                                  socket_addr.ip_type,
                                  &socket_addr.ip_value[0],
                                  socket_addr.port)
@@ -1900,6 +2216,7 @@ int32_t com_connect_ip_modem(int32_t sock,
     /* if com_translate_ip_address == FALSE, result already set to COM_SOCKETS_ERR_PARAMETER */
     com_sockets_statistic_update((result == COM_SOCKETS_ERR_OK) ? \
                                  COM_SOCKET_STAT_CNT_OK : COM_SOCKET_STAT_CNT_NOK);
+    com_sockets_statistic_latency(COM_SOCKET_STAT_OP_CNT, start_tick, 0);
     SOCKET_SET_ERROR(socket_desc, result);
   }
 
@@ -1941,19 +2258,74 @@ int32_t com_connect_ip_modem(int32_t sock,
 int32_t com_send_ip_modem(int32_t sock,
                           const com_char_t *buf, int32_t len,
                           int32_t flags)
+{
+  com_iovec_t iov;
+  com_msghdr_t msg;
+
+  /* a buffer is a message with only one buffer */
+  iov.iov_base = buf;
+  iov.iov_len = len;
+  msg.msg_name = NULL;
+  msg.msg_namelen = 0;
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+
+  return (com_sendmsg_ip_modem(sock, &msg, flags));
+}
+
+/**
+  * @brief  Socket send message
+  * @note   Send data gathered from several buffers without intermediate copy:
+  *         the buffers are given to the modem driver which gathers them in the AT command
+  * @param  sock      - socket handle obtained with com_socket
+  * @param  msg       - buffers to send and optional remote IP address and port number
+  * @note   on a datagram socket sent with sendto service (or if msg_name is provided)
+  *         only one buffer is supported
+  * @param  flags     - options
+  * @note
+  *         - if flags = COM_MSG_DONTWAIT, application request to not wait
+  *         if len of message to send > interface between COM and low level.
+  *          The maximum of interface will be send (only one send)
+  *         - if flags = COM_MSG_WAIT, application accept to wait
+  *         if len of message to send > interface between COM and low level.
+  *          COM will fragment the message according to the interface (multiple sends)
+  * @retval int32_t   - number of bytes sent or error value
+  */
+int32_t com_sendmsg_ip_modem(int32_t sock,
+                             const com_msghdr_t *msg,
+                             int32_t flags)
 {
   bool is_network_up;
   socket_desc_t *socket_desc;
   int32_t result;
+  uint32_t start_tick;
+  uint32_t len;
 
+  start_tick = rtosalGetSysTimerCount();
   result = COM_SOCKETS_ERR_PARAMETER;
   socket_desc = com_ip_modem_find_socket(sock, false);
+  len = com_ip_modem_msg_length(msg);
 
   if ((socket_desc != NULL)
-      && (buf != NULL)
-      && (len > 0))
+      && (len > 0U))
   {
-    if (socket_desc->state == COM_SOCKET_CONNECTED)
+    if ((socket_desc->type == (uint8_t)COM_SOCK_DGRAM)
+        && (msg->msg_name != NULL))
+    {
+      /* sendto service: a datagram is sent from one buffer */
+      if (msg->msg_iovlen == 1)
+      {
+        result = com_sendto_ip_modem(sock, msg->msg_iov[0].iov_base, msg->msg_iov[0].iov_len, flags,
+                                     msg->msg_name, msg->msg_namelen);
+      }
+      else
+      {
+        PRINT_ERR("sndmsg data NOK several buffers in a datagram")
+        result = COM_SOCKETS_ERR_UNSUPPORTED;
+        com_sockets_statistic_update(COM_SOCKET_STAT_SND_NOK);
+      }
+    }
+    else if (socket_desc->state == COM_SOCKET_CONNECTED)
     {
       /* closing maybe received, refuse to send data */
       if (socket_desc->closing == false)
@@ -1974,10 +2346,22 @@ int32_t com_send_ip_modem(int32_t sock,
           if ((socket_desc->type == (uint8_t)COM_SOCK_DGRAM)
               && (UDP_SERVICE_SUPPORTED == 1U))
           {
-            result = com_sendto_ip_modem(sock, buf, len, flags, NULL, 0);
+            if (msg->msg_iovlen == 1)
+            {
+              result = com_sendto_ip_modem(sock, msg->msg_iov[0].iov_base, msg->msg_iov[0].iov_len, flags,
+                                           NULL, 0);
+            }
+            else
+            {
+              PRINT_ERR("sndmsg data NOK several buffers in a datagram")
+              result = COM_SOCKETS_ERR_UNSUPPORTED;
+              com_sockets_statistic_update(COM_SOCKET_STAT_SND_NOK);
+            }
           }
           else
           {
+            CS_IOVec_t chunk[COM_IOV_MAX];
+            uint8_t chunk_nb;
             uint32_t length_to_send;
             uint32_t length_send;
 
@@ -1987,9 +2371,10 @@ int32_t com_send_ip_modem(int32_t sock,
 
             if (flags == COM_MSG_DONTWAIT)
             {
-              length_to_send = COM_MIN((uint32_t)len, COM_MODEM_MAX_TX_DATA_SIZE);
-              if (osCDS_socket_send(socket_desc->id,
-                                    buf, length_to_send)
+              length_to_send = com_ip_modem_msg_chunk(msg, 0U, COM_MODEM_MAX_TX_DATA_SIZE,
+                                                      &chunk[0], &chunk_nb);
+              if (osCDS_socket_send_iov(socket_desc->handle,
+                                        &chunk[0], chunk_nb)
                   == CELLULAR_OK)
               {
                 length_send = length_to_send;
@@ -2005,19 +2390,18 @@ int32_t com_send_ip_modem(int32_t sock,
             else
             {
               is_network_up = com_ip_modem_is_network_up();
-              /* Send all data of a big buffer - Whatever the size */
-              while ((length_send != (uint32_t)len)
+              /* Send all data of a big message - Whatever the size */
+              while ((length_send != len)
                      && (socket_desc->closing == false)
                      && (is_network_up == true)
                      && (socket_desc->state == COM_SOCKET_SENDING))
               {
-                length_to_send = COM_MIN((((uint32_t)len) - length_send),
-                                         COM_MODEM_MAX_TX_DATA_SIZE);
+                length_to_send = com_ip_modem_msg_chunk(msg, length_send, COM_MODEM_MAX_TX_DATA_SIZE,
+                                                        &chunk[0], &chunk_nb);
                 com_ip_modem_wakeup_request();
                 /* A tempo is already managed at low-level */
-                if (osCDS_socket_send(socket_desc->id,
-                                      buf + length_send,
-                                      length_to_send)
+                if (osCDS_socket_send_iov(socket_desc->handle,
+                                          &chunk[0], chunk_nb)
                     == CELLULAR_OK)
                 {
                   length_send += length_to_send;
@@ -2061,12 +2445,13 @@ int32_t com_send_ip_modem(int32_t sock,
 
     /* Do not count twice with sendto */
     if ((socket_desc->type == (uint8_t)COM_SOCK_STREAM)
-        || (UDP_SERVICE_SUPPORTED == 0U))
+        || ((UDP_SERVICE_SUPPORTED == 0U) && (msg->msg_name == NULL)))
     {
       com_sockets_statistic_update((result >= 0) ? \
                                    COM_SOCKET_STAT_SND_OK : COM_SOCKET_STAT_SND_NOK);
+      com_sockets_statistic_latency(COM_SOCKET_STAT_OP_SND, start_tick, result);
     }
-    /* else statistic updated by sendto function */
+    /* else statistic and latency updated by sendto function */
   }
 
   if (result >= 0)
@@ -2081,7 +2466,6 @@ int32_t com_send_ip_modem(int32_t sock,
   return (result);
 }
 
-
 /**
   * @brief  Socket send to data
   * @note   Send data to a remote host
@@ -2138,8 +2522,11 @@ int32_t com_sendto_ip_modem(int32_t sock,
 #else /* UDP_SERVICE_SUPPORTED == 1U */
       {
         bool is_network_up;
+        uint32_t start_tick;
         socket_addr_t socket_addr;
 
+        start_tick = rtosalGetSysTimerCount();
+
         /* Check remote addr is valid */
         if ((to != NULL) && (tolen != 0))
         {
@@ -2217,7 +2604,7 @@ int32_t com_sendto_ip_modem(int32_t sock,
               {
                 length_to_send = COM_MIN((uint32_t)len, COM_MODEM_MAX_TX_DATA_SIZE);
 
-                if (osCDS_socket_sendto(socket_desc->id,
+                if (osCDS_socket_sendto(socket_desc->handle,
                                         buf, length_to_send,
                                         socket_addr.ip_type,
                                         socket_addr.ip_value,
@@ -2247,7 +2634,7 @@ int32_t com_sendto_ip_modem(int32_t sock,
                                            COM_MODEM_MAX_TX_DATA_SIZE);
                   com_ip_modem_wakeup_request();
                   /* A tempo is already managed at low-level */
-                  if (osCDS_socket_sendto(socket_desc->id,
+                  if (osCDS_socket_sendto(socket_desc->handle,
                                           buf + length_send,
                                           length_to_send,
                                           socket_addr.ip_type,
@@ -2289,6 +2676,7 @@ int32_t com_sendto_ip_modem(int32_t sock,
 
           com_sockets_statistic_update((result >= 0) ? \
                                        COM_SOCKET_STAT_SND_OK : COM_SOCKET_STAT_SND_NOK);
+          com_sockets_statistic_latency(COM_SOCKET_STAT_OP_SND, start_tick, result);
         }
         else
         {
@@ -2336,10 +2724,12 @@ int32_t com_recv_ip_modem(int32_t sock,
 {
   int32_t result;
   int32_t len_rcv;
+  uint32_t start_tick;
   com_socket_msg_t msg_queue;
   rtosalStatus status_queue;
   socket_desc_t *socket_desc;
 
+  start_tick = rtosalGetSysTimerCount();
   result = COM_SOCKETS_ERR_PARAMETER;
   len_rcv = 0;
   socket_desc = com_ip_modem_find_socket(sock, false);
@@ -2348,9 +2738,20 @@ int32_t com_recv_ip_modem(int32_t sock,
       && (buf != NULL)
       && (len > 0))
   {
+    /* Data already read from the modem by a previous com_recv */
+    if (socket_desc->state == COM_SOCKET_CONNECTED)
+    {
+      len_rcv = (int32_t)com_ip_modem_rcv_ahead_get(socket_desc, buf, (uint32_t)len);
+    }
+
+    if (len_rcv > 0)
+    {
+      result = COM_SOCKETS_ERR_OK;
+      PRINT_DBG("rcv data from read-ahead")
+    }
     /* Closing maybe received or Network maybe done
        but still some data to read */
-    if (socket_desc->state == COM_SOCKET_CONNECTED)
+    else if (socket_desc->state == COM_SOCKET_CONNECTED)
     {
       uint32_t length_to_read;
       length_to_read = COM_MIN((uint32_t)len, COM_MODEM_MAX_RX_DATA_SIZE);
@@ -2365,7 +2766,7 @@ int32_t com_recv_ip_modem(int32_t sock,
       {
 
         /* Application don't want to wait if there is no data available */
-        len_rcv = osCDS_socket_receive(socket_desc->id,
+        len_rcv = com_ip_modem_receive(socket_desc,
                                        buf, length_to_read);
         result = (len_rcv < 0) ? COM_SOCKETS_ERR_GENERAL : COM_SOCKETS_ERR_OK;
         socket_desc->state = COM_SOCKET_CONNECTED;
@@ -2376,7 +2777,7 @@ int32_t com_recv_ip_modem(int32_t sock,
         /* Maybe still some data available
            because application don't read all data with previous calls */
         PRINT_DBG("rcv data waiting")
-        len_rcv = osCDS_socket_receive(socket_desc->id,
+        len_rcv = com_ip_modem_receive(socket_desc,
                                        buf, length_to_read);
         PRINT_DBG("rcv data waiting exit")
 
@@ -2400,7 +2801,7 @@ int32_t com_recv_ip_modem(int32_t sock,
               {
                 case COM_DATA_RCV :
                 {
-                  len_rcv = osCDS_socket_receive(socket_desc->id,
+                  len_rcv = com_ip_modem_receive(socket_desc,
                                                  buf, length_to_read);
                   result = (len_rcv < 0) ? \
                            COM_SOCKETS_ERR_GENERAL : COM_SOCKETS_ERR_OK;
@@ -2467,6 +2868,8 @@ int32_t com_recv_ip_modem(int32_t sock,
 
     com_sockets_statistic_update((result == COM_SOCKETS_ERR_OK) ? \
                                  COM_SOCKET_STAT_RCV_OK : COM_SOCKET_STAT_RCV_NOK);
+    com_sockets_statistic_latency(COM_SOCKET_STAT_OP_RCV, start_tick,
+                                  (result == COM_SOCKETS_ERR_OK) ? len_rcv : result);
   }
 
   SOCKET_SET_ERROR(socket_desc, result);
@@ -2582,7 +2985,7 @@ int32_t com_recvfrom_ip_modem(int32_t sock,
           if (flags == COM_MSG_DONTWAIT)
           {
             /* Application don't want to wait if there is no data available */
-            len_rcv = osCDS_socket_receivefrom(socket_desc->id,
+            len_rcv = com_ip_modem_receivefrom(socket_desc,
                                                buf, length_to_read,
                                                &ip_addr_type,
                                                &ip_addr_value[0],
@@ -2596,7 +2999,7 @@ int32_t com_recvfrom_ip_modem(int32_t sock,
             /* Maybe still some data available
                because application don't read all data with previous calls */
             PRINT_DBG("rcvfrom data waiting")
-            len_rcv = osCDS_socket_receivefrom(socket_desc->id,
+            len_rcv = com_ip_modem_receivefrom(socket_desc,
                                                buf, length_to_read,
                                                &ip_addr_type,
                                                &ip_addr_value[0],
@@ -2625,7 +3028,7 @@ int32_t com_recvfrom_ip_modem(int32_t sock,
                   {
                     case COM_DATA_RCV :
                     {
-                      len_rcv = osCDS_socket_receivefrom(socket_desc->id,
+                      len_rcv = com_ip_modem_receivefrom(socket_desc,
                                                          buf, length_to_read,
                                                          &ip_addr_type,
                                                          &ip_addr_value[0],
@@ -2714,6 +3117,102 @@ int32_t com_recvfrom_ip_modem(int32_t sock,
 }
 
 
+/**
+  * @brief  Socket poll
+  * @note   Wait until at least one socket of a set is ready
+  *         Readiness is updated by the modem data ready and socket closing notifications:
+  *         COM_POLLIN : data notified by the modem and not yet read by com_recv/com_recvfrom,
+  *                      or socket closed by remote
+  *         COM_POLLOUT: socket connected (or UDP socket created) and not closed by remote
+  *         COM_POLLERR: network down
+  *         COM_POLLHUP: socket closed by remote
+  *         COM_POLLNVAL: socket not found
+  * @note   When the last com_recv filled the application buffer, COM_POLLIN is set
+  *         as the modem may have more data: read with COM_MSG_DONTWAIT, 0 may be returned
+  * @param  fds       - sockets and events requested, revents updated with events ready
+  * @param  nfds      - number of entries in fds (1 to COM_POLL_FDS_MAX)
+  * @param  timeout   - maximum time to wait (in ms), 0: no wait, negative value: wait forever
+  * @retval int32_t   - number of entries with revents != 0, 0 on timeout or error value
+  */
+int32_t com_poll_ip_modem(com_pollfd_t *fds, uint32_t nfds, int32_t timeout)
+{
+  int32_t result;
+  uint32_t waiter;
+  uint32_t start_tick;
+  uint32_t elapsed;
+  uint32_t wait_time;
+  bool wait;
+
+  start_tick = rtosalGetSysTimerCount();
+  waiter = COM_POLL_WAITER_NB;
+
+  if ((fds == NULL) || (nfds == 0U) || (nfds > (uint32_t)COM_POLL_FDS_MAX))
+  {
+    result = COM_SOCKETS_ERR_PARAMETER;
+  }
+  else
+  {
+    result = COM_SOCKETS_ERR_OK;
+    if (timeout != 0)
+    {
+      /* Register as waiter before the first check: no event can be missed */
+      waiter = com_ip_modem_poll_waiter_get();
+      if (waiter == COM_POLL_WAITER_NB)
+      {
+        PRINT_ERR("poll: too many waiters")
+        result = COM_SOCKETS_ERR_NOMEMORY;
+      }
+    }
+  }
+
+  if (result == COM_SOCKETS_ERR_OK)
+  {
+    do
+    {
+      for (uint32_t i = 0U; i < nfds; i++)
+      {
+        fds[i].revents = com_ip_modem_poll_revents(&fds[i]);
+        if (fds[i].revents != 0)
+        {
+          result++;
+        }
+      }
+
+      wait = false;
+      wait_time = 0U;
+      if ((result == 0) && (timeout != 0))
+      {
+        if (timeout < 0)
+        {
+          wait = true;
+          wait_time = RTOSAL_WAIT_FOREVER;
+        }
+        else
+        {
+          elapsed = rtosalGetSysTimerCount() - start_tick;
+          if (elapsed < (uint32_t)timeout)
+          {
+            wait = true;
+            wait_time = (uint32_t)timeout - elapsed;
+          }
+        }
+        if (wait == true)
+        {
+          /* Released at each socket event, maybe for an other socket: check again */
+          (void)rtosalSemaphoreAcquire(com_poll_waiter_sem[waiter], wait_time);
+        }
+      }
+    } while (wait == true);
+
+    if (waiter != COM_POLL_WAITER_NB)
+    {
+      com_ip_modem_poll_waiter_release(waiter);
+    }
+  }
+
+  return result;
+}
+
 /**
   * @brief  Socket close
   * @note   Close a socket and release socket handle
@@ -2725,8 +3224,10 @@ int32_t com_recvfrom_ip_modem(int32_t sock,
 int32_t com_closesocket_ip_modem(int32_t sock)
 {
   int32_t result;
+  uint32_t start_tick;
   socket_desc_t *socket_desc;
 
+  start_tick = rtosalGetSysTimerCount();
   result = COM_SOCKETS_ERR_PARAMETER;
   socket_desc = com_ip_modem_find_socket(sock, false);
 
@@ -2743,7 +3244,7 @@ int32_t com_closesocket_ip_modem(int32_t sock)
     {
       result = COM_SOCKETS_ERR_GENERAL;
       com_ip_modem_wakeup_request();
-      if (osCDS_socket_close(sock, 0U)
+      if (osCDS_socket_close(socket_desc->handle, 0U)
           == CELLULAR_OK)
       {
         com_ip_modem_delete_socket_desc(sock, false);
@@ -2758,6 +3259,7 @@ int32_t com_closesocket_ip_modem(int32_t sock)
     }
     com_sockets_statistic_update((result == COM_SOCKETS_ERR_OK) ? \
                                  COM_SOCKET_STAT_CLS_OK : COM_SOCKET_STAT_CLS_NOK);
+    com_sockets_statistic_latency(COM_SOCKET_STAT_OP_CLS, start_tick, 0);
   }
 
 
@@ -2770,6 +3272,7 @@ int32_t com_closesocket_ip_modem(int32_t sock)
 /**
   * @brief  Get host IP from host name
   * @note   Retrieve host IP address from host name
+  *         answered from the DNS cache when the host name was resolved recently
   *         DNS resolver is a fix value in the module
   *         only a primary DNS is used
   * @param  name      - host name
@@ -2793,35 +3296,47 @@ int32_t com_gethostbyname_ip_modem(const com_char_t *name,
   {
     if (strlen((const CSIP_CHAR_t *)name) <= sizeof(dns_req.host_name))
     {
-      (void)strcpy((CSIP_CHAR_t *)&dns_req.host_name[0],
-                   (const CSIP_CHAR_t *)name);
-
-      result = COM_SOCKETS_ERR_GENERAL;
-      com_ip_modem_wakeup_request();
-      if (osCDS_dns_request(PDN_conf_id,
-                            &dns_req,
-                            &dns_resp)
-          == CELLULAR_OK)
+      /* Cache hit: no modem wake-up and no DNS request on the network */
+      if (com_dns_cache_lookup(name, addr) == true)
       {
-        PRINT_INFO("DNS resolution OK - Remote: %s IP: %s", name, dns_resp.host_addr)
-        if (com_convert_IPString_to_sockaddr(0U,
-                                             (com_char_t *)&dns_resp.host_addr[0],
-                                             addr)
-            == true)
+        PRINT_INFO("DNS resolution OK from cache - Remote: %s", name)
+        result = COM_SOCKETS_ERR_OK;
+      }
+      else
+      {
+        (void)strcpy((CSIP_CHAR_t *)&dns_req.host_name[0],
+                     (const CSIP_CHAR_t *)name);
+
+        result = COM_SOCKETS_ERR_GENERAL;
+        com_ip_modem_wakeup_request();
+        if (osCDS_dns_request(PDN_conf_id,
+                              &dns_req,
+                              &dns_resp)
+            == CELLULAR_OK)
         {
-          PRINT_DBG("DNS conversion OK")
-          result = COM_SOCKETS_ERR_OK;
+          PRINT_INFO("DNS resolution OK - Remote: %s IP: %s", name, dns_resp.host_addr)
+          if (com_convert_IPString_to_sockaddr(0U,
+                                               (com_char_t *)&dns_resp.host_addr[0],
+                                               addr)
+              == true)
+          {
+            PRINT_DBG("DNS conversion OK")
+            result = COM_SOCKETS_ERR_OK;
+          }
+          else
+          {
+            PRINT_ERR("DNS conversion NOK")
+          }
         }
         else
         {
-          PRINT_ERR("DNS conversion NOK")
+          PRINT_ERR("DNS resolution NOK for %s", name)
         }
+        com_ip_modem_idlemode_request(false);
+
+        /* Modem does not provide the DNS TTL: minimum cache TTL is used */
+        com_dns_cache_update(name, (result == COM_SOCKETS_ERR_OK) ? addr : NULL, 0U);
       }
-      else
-      {
-        PRINT_ERR("DNS resolution NOK for %s", name)
-      }
-      com_ip_modem_idlemode_request(false);
     }
   }
 
@@ -2882,7 +3397,7 @@ int32_t com_ping_ip_modem(void)
   socket_desc_t *socket_desc;
 
   /* Need to create a new socket_desc ? */
-  socket_desc = com_ip_modem_provide_socket_desc(true);
+  socket_desc = com_ip_modem_provide_socket_desc(true, CS_INVALID_SOCKET_HANDLE);
   if (socket_desc == NULL)
   {
     result = COM_SOCKETS_ERR_NOMEMORY;
@@ -3180,20 +3695,31 @@ bool com_init_ip_modem(void)
   ping_socket_id = COM_SOCKET_INVALID_ID;
 #endif /* USE_COM_PING == 1 */
 
-  for (uint8_t i = 0U; i < COM_SOCKET_LOCAL_ID_NB; i++)
-  {
-    socket_local_id[i] = false; /* set socket local id to unused */
-  }
-
-  /* Initialize Mutex to protect socket descriptor list access */
+  /* Initialize Mutex to protect socket descriptor pool access */
   ComSocketsMutexHandle = rtosalMutexNew(NULL);
-  if (ComSocketsMutexHandle != NULL)
+  if ((ComSocketsMutexHandle != NULL)
+      && (com_dns_cache_init() == true))
   {
-    /* Create always the first element of the list */
-    socket_desc_list = com_ip_modem_create_socket_desc();
-    if (socket_desc_list != NULL)
+    /* All the socket descriptors and their queues are created at init: no allocation after */
+    result = true;
+    for (uint32_t slot = 0U; slot < COM_SOCKET_DESC_NB; slot++)
     {
-      result = true;
+      socket_desc_pool[slot].generation = 0U;
+      com_ip_modem_init_socket_desc(&socket_desc_pool[slot]);
+      socket_desc_pool[slot].queue = rtosalMessageQueueNew(NULL, 4U);
+      if (socket_desc_pool[slot].queue == NULL)
+      {
+        result = false;
+      }
+    }
+    for (uint32_t waiter = 0U; waiter < COM_POLL_WAITER_NB; waiter++)
+    {
+      com_poll_waiter_used[waiter] = false;
+      com_poll_waiter_sem[waiter] = rtosalSemaphoreNew(NULL, 1U);
+      if (com_poll_waiter_sem[waiter] == NULL)
+      {
+        result = false;
+      }
     }
   }
 
@@ -3232,8 +3758,12 @@ bool com_init_ip_modem(void)
 void com_start_ip_modem(void)
 {
 #if (USE_DATACACHE == 1)
+  dc_com_reg_id_t dc_reg_id;
+
   /* Datacache registration for netwok on/off status */
-  (void)dc_com_register_gen_event_cb(&dc_com_db, com_socket_datacache_cb, (void *)NULL);
+  dc_reg_id = dc_com_register_gen_event_cb(&dc_com_db, com_socket_datacache_cb, (void *)NULL);
+  /* Only network status is needed */
+  (void)dc_com_subscribe_res(&dc_com_db, dc_reg_id, DC_COM_NIFMAN_INFO);
 #endif /* USE_DATACACHE == 1 */
 
 #if (UDP_SERVICE_SUPPORTED == 1U)
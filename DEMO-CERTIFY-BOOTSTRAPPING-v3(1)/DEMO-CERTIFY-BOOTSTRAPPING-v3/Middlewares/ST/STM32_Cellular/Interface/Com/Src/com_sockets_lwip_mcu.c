@@ -247,6 +247,65 @@ int32_t com_sendto_lwip_mcu(int32_t sock,
 }
 
 
+/**
+  * @brief  Socket send message
+  * @note   Send data gathered from several buffers
+  *         Restrictions, if any, are linked to LwIP module used
+  * @param  sock      - socket handle obtained with com_socket
+  * @param  msg       - buffers to send and optional remote IP address and port number
+  * @param  flags     - options
+  * @retval int32_t   - number of bytes sent or error value
+  */
+int32_t com_sendmsg_lwip_mcu(int32_t sock,
+                             const com_msghdr_t *msg,
+                             int32_t flags)
+{
+  int32_t result;
+  uint32_t length;
+  struct iovec iov[COM_IOV_MAX];
+
+  result = COM_SOCKETS_ERR_OK;
+  length = 0U;
+
+  if ((msg == NULL) || (msg->msg_iov == NULL)
+      || (msg->msg_iovlen <= 0) || (msg->msg_iovlen > COM_IOV_MAX))
+  {
+    result = COM_SOCKETS_ERR_PARAMETER;
+  }
+
+  for (int32_t i = 0; (result == COM_SOCKETS_ERR_OK) && (i < msg->msg_iovlen); i++)
+  {
+    /* total length must be representable as a result of com_sendmsg */
+    if ((msg->msg_iov[i].iov_len < 0)
+        || ((msg->msg_iov[i].iov_base == NULL) && (msg->msg_iov[i].iov_len != 0))
+        || ((uint32_t)msg->msg_iov[i].iov_len > ((uint32_t)INT32_MAX - length)))
+    {
+      result = COM_SOCKETS_ERR_PARAMETER;
+    }
+    else
+    {
+      length += (uint32_t)msg->msg_iov[i].iov_len;
+      iov[i].iov_base = (void *)msg->msg_iov[i].iov_base;
+      iov[i].iov_len = (size_t)msg->msg_iov[i].iov_len;
+    }
+  }
+
+  if (result == COM_SOCKETS_ERR_OK)
+  {
+    struct msghdr lwip_msg;
+
+    (void)memset((void *)&lwip_msg, 0, sizeof(lwip_msg));
+    lwip_msg.msg_name = (void *)msg->msg_name;
+    lwip_msg.msg_namelen = (socklen_t)msg->msg_namelen;
+    lwip_msg.msg_iov = &iov[0];
+    lwip_msg.msg_iovlen = (int)msg->msg_iovlen;
+    result = lwip_sendmsg(sock, &lwip_msg, flags);
+  }
+
+  return (result);
+}
+
+
 /**
   * @brief  Socket receive data
   * @note   Receive data on already connected socket
@@ -286,6 +345,44 @@ int32_t com_recvfrom_lwip_mcu(int32_t sock,
 }
 
 
+/**
+  * @brief  Socket poll
+  * @note   Wait until at least one socket of a set is ready
+  *         Restrictions, if any, are linked to LwIP module used (LWIP_SOCKET_POLL)
+  * @param  fds       - sockets and events requested, revents updated with events ready
+  * @param  nfds      - number of entries in fds (1 to COM_POLL_FDS_MAX)
+  * @param  timeout   - maximum time to wait (in ms), 0: no wait, negative value: wait forever
+  * @retval int32_t   - number of entries with revents != 0, 0 on timeout or error value
+  */
+int32_t com_poll_lwip_mcu(com_pollfd_t *fds, uint32_t nfds, int32_t timeout)
+{
+  int32_t result;
+
+  if ((fds == NULL) || (nfds == 0U) || (nfds > (uint32_t)COM_POLL_FDS_MAX))
+  {
+    result = COM_SOCKETS_ERR_PARAMETER;
+  }
+  else
+  {
+    struct pollfd lwip_fds[COM_POLL_FDS_MAX];
+
+    for (uint32_t i = 0U; i < nfds; i++)
+    {
+      lwip_fds[i].fd = (int)fds[i].fd;
+      lwip_fds[i].events = (short)fds[i].events;
+      lwip_fds[i].revents = 0;
+    }
+    result = lwip_poll(&lwip_fds[0], (nfds_t)nfds, (int)((timeout < 0) ? -1 : timeout));
+    for (uint32_t i = 0U; i < nfds; i++)
+    {
+      fds[i].revents = (int16_t)lwip_fds[i].revents;
+    }
+  }
+
+  return (result);
+}
+
+
 /**
   * @brief  Socket close
   * @note   Close a socket and release socket handle
@@ -18,11 +18,12 @@
   */
 
 /* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
 #include "com_sockets_statistic.h"
 
 #if (COM_SOCKETS_STATISTIC == 1U)
 
-#include <string.h>
 #include <stdio.h>
 
 #include "rtosal.h"
@@ -58,25 +59,10 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Socket statistics definition */
-typedef struct
-{
-  uint16_t sock_cre_ok;
-  uint16_t sock_cre_nok;
-  uint16_t sock_cnt_ok;
-  uint16_t sock_cnt_nok;
-  uint16_t sock_snd_ok;
-  uint16_t sock_snd_nok;
-  uint16_t sock_rcv_ok;
-  uint16_t sock_rcv_nok;
-  uint16_t sock_cls_ok;
-  uint16_t sock_cls_nok;
-#if (USE_DATACACHE == 1)
-  uint16_t nwk_up;
-  uint16_t nwk_dwn;
-#endif /* USE_DATACACHE == 1 */
-} com_socket_statistic_t;
+typedef com_sockets_stat_counter_t com_socket_statistic_t;
 
 /* Private macros ------------------------------------------------------------*/
+#define COM_STAT_MIN(a,b) (((a)<(b)) ? (a) : (b))
 
 /* Private variables ---------------------------------------------------------*/
 
@@ -99,6 +85,31 @@ static const uint8_t *com_socket_state_string[] =
 /* Statistic socket variable */
 static com_socket_statistic_t com_socket_statistic;
 
+/* Latency histograms - protected by com_socket_statistic_mutex to provide a coherent snapshot */
+static com_sockets_stat_latency_t com_socket_statistic_latency[COM_SOCKET_STAT_OP_NB];
+static osMutexId com_socket_statistic_mutex = NULL;
+
+#if (USE_DATACACHE == 1)
+/* Network down (or statistic start) time: to compute the attach duration */
+static uint32_t com_socket_statistic_nwk_dwn_tick;
+static bool com_socket_statistic_nwk_is_dwn;
+#endif /* USE_DATACACHE == 1 */
+
+#if ((USE_TRACE_COM_SOCKETS == 1U) || (USE_CMD_CONSOLE == 1U))
+/* Operations readable print */
+static const uint8_t *com_socket_statistic_op_string[COM_SOCKET_STAT_OP_NB] =
+{
+  (const uint8_t *)"Con",
+  (const uint8_t *)"Snd",
+  (const uint8_t *)"Rcv",
+  (const uint8_t *)"RcM",
+  (const uint8_t *)"Cls",
+#if (USE_DATACACHE == 1)
+  (const uint8_t *)"Att",
+#endif /* USE_DATACACHE == 1 */
+};
+#endif /* (USE_TRACE_COM_SOCKETS == 1U) || (USE_CMD_CONSOLE == 1U) */
+
 /* Private typedef -----------------------------------------------------------*/
 
 /* Private macros ------------------------------------------------------------*/
@@ -114,8 +125,52 @@ static com_socket_statistic_t com_socket_statistic;
 static void com_socket_statistic_timer_cb(void *argument);
 #endif /* COM_SOCKETS_STATISTIC_PERIOD != 0U */
 
+static void com_socket_statistic_latency_add(com_sockets_stat_op_t op, uint32_t latency, int32_t bytes);
+
 /* Private function Definition -----------------------------------------------*/
 
+/**
+  * @brief  Add a latency in a histogram
+  * @note   com_socket_statistic_mutex must be acquired
+  * @param  op      - operation timed
+  * @param  latency - latency in ms
+  * @param  bytes   - bytes sent/received if > 0
+  * @retval -
+  */
+static void com_socket_statistic_latency_add(com_sockets_stat_op_t op, uint32_t latency, int32_t bytes)
+{
+  com_sockets_stat_latency_t *p_latency = &com_socket_statistic_latency[op];
+  uint32_t bucket = 0U;
+  uint32_t remain = latency;
+
+  /* Bucket is the number of significant bits of the latency */
+  while ((remain != 0U) && (bucket < (COM_SOCKETS_STAT_LATENCY_BUCKETS - 1U)))
+  {
+    remain >>= 1;
+    bucket++;
+  }
+  /* Saturated: histogram keeps the distribution even if a bucket is full */
+  if (p_latency->bucket[bucket] < 0xFFFFU)
+  {
+    p_latency->bucket[bucket]++;
+  }
+
+  p_latency->calls++;
+  p_latency->latency_sum_ms += latency;
+  if (latency > p_latency->latency_max_ms)
+  {
+    p_latency->latency_max_ms = latency;
+  }
+  if (bytes > 0)
+  {
+    p_latency->bytes += (uint32_t)bytes;
+    if ((uint32_t)bytes > p_latency->bytes_max)
+    {
+      p_latency->bytes_max = (uint32_t)bytes;
+    }
+  }
+}
+
 #if (COM_SOCKETS_STATISTIC_PERIOD != 0U)
 /**
   * @brief  Called when statistic timer raised
@@ -150,6 +205,18 @@ void com_sockets_statistic_init(void)
 
   /* Initialize socket statistics structure to 0U */
   (void)memset(&com_socket_statistic, 0, sizeof(com_socket_statistic_t));
+  (void)memset(com_socket_statistic_latency, 0, sizeof(com_socket_statistic_latency));
+
+  if (com_socket_statistic_mutex == NULL)
+  {
+    com_socket_statistic_mutex = rtosalMutexNew(NULL);
+  }
+
+#if (USE_DATACACHE == 1)
+  /* First attach duration is computed from the start */
+  com_socket_statistic_nwk_dwn_tick = rtosalGetSysTimerCount();
+  com_socket_statistic_nwk_is_dwn = true;
+#endif /* USE_DATACACHE == 1 */
 
 #if (COM_SOCKETS_STATISTIC_PERIOD != 0U)
   /* Timer creation */
@@ -184,11 +251,21 @@ void com_sockets_statistic_update(com_sockets_stat_update_t stat)
     case COM_SOCKET_STAT_NWK_UP:
     {
       com_socket_statistic.nwk_up++;
+      if (com_socket_statistic_nwk_is_dwn == true)
+      {
+        com_sockets_statistic_latency(COM_SOCKET_STAT_OP_NWK, com_socket_statistic_nwk_dwn_tick, 0);
+        com_socket_statistic_nwk_is_dwn = false;
+      }
       break;
     }
     case COM_SOCKET_STAT_NWK_DWN:
     {
       com_socket_statistic.nwk_dwn++;
+      if (com_socket_statistic_nwk_is_dwn == false)
+      {
+        com_socket_statistic_nwk_dwn_tick = rtosalGetSysTimerCount();
+        com_socket_statistic_nwk_is_dwn = true;
+      }
       break;
     }
 #endif /* USE_DATACACHE == 1 */
@@ -250,6 +327,89 @@ void com_sockets_statistic_update(com_sockets_stat_update_t stat)
   }
 }
 
+/**
+  * @brief  Record the latency of an operation
+  * @note   -
+  * @param  op         - operation timed
+  * @param  start_tick - rtosalGetSysTimerCount() at the operation start
+  * @param  bytes      - result of the operation: bytes sent/received if > 0
+  * @retval -
+  */
+void com_sockets_statistic_latency(com_sockets_stat_op_t op, uint32_t start_tick, int32_t bytes)
+{
+  /* Unsigned subtraction: correct even if the tick counter wrapped */
+  uint32_t latency = rtosalGetSysTimerCount() - start_tick;
+
+  if ((op < COM_SOCKET_STAT_OP_NB) && (com_socket_statistic_mutex != NULL))
+  {
+    (void)rtosalMutexAcquire(com_socket_statistic_mutex, RTOSAL_WAIT_FOREVER);
+    com_socket_statistic_latency_add(op, latency, bytes);
+    (void)rtosalMutexRelease(com_socket_statistic_mutex);
+  }
+}
+
+/**
+  * @brief  Get a copy of com sockets statistics
+  * @note   COM_SOCKETS_STATISTIC must be set to 1 else the snapshot is set to 0
+  * @param  p_snapshot - statistics copy
+  * @retval -
+  */
+void com_sockets_statistic_snapshot(com_sockets_stat_snapshot_t *p_snapshot)
+{
+  if (p_snapshot != NULL)
+  {
+    if (com_socket_statistic_mutex != NULL)
+    {
+      (void)rtosalMutexAcquire(com_socket_statistic_mutex, RTOSAL_WAIT_FOREVER);
+    }
+    (void)memcpy(&p_snapshot->counter, &com_socket_statistic, sizeof(com_sockets_stat_counter_t));
+    (void)memcpy(p_snapshot->latency, com_socket_statistic_latency, sizeof(com_socket_statistic_latency));
+    if (com_socket_statistic_mutex != NULL)
+    {
+      (void)rtosalMutexRelease(com_socket_statistic_mutex);
+    }
+  }
+}
+
+/**
+  * @brief  Get a latency percentile from a histogram
+  * @note   Result is the upper bound of the histogram bucket reaching the percentile,
+  *         limited to the max latency
+  * @param  p_latency - histogram
+  * @param  percent   - percentile to compute (e.g 50U, 90U, 99U)
+  * @retval uint32_t  - latency in ms (0 if no call)
+  */
+uint32_t com_sockets_statistic_percentile(const com_sockets_stat_latency_t *p_latency, uint8_t percent)
+{
+  uint32_t result = 0U;
+  uint32_t count = 0U;
+  uint32_t total = 0U;
+  uint32_t target;
+  uint32_t bucket = 0U;
+
+  for (uint32_t i = 0U; i < COM_SOCKETS_STAT_LATENCY_BUCKETS; i++)
+  {
+    total += p_latency->bucket[i];
+  }
+
+  if (total != 0U)
+  {
+    /* Rank of the percentile, rounded up */
+    target = ((total * (uint32_t)percent) + 99U) / 100U;
+    while ((bucket < (COM_SOCKETS_STAT_LATENCY_BUCKETS - 1U))
+           && ((count + p_latency->bucket[bucket]) < target))
+    {
+      count += p_latency->bucket[bucket];
+      bucket++;
+    }
+    /* Upper bound of the bucket: 2^bucket - 1 */
+    result = (bucket < (COM_SOCKETS_STAT_LATENCY_BUCKETS - 1U)) ? ((1UL << bucket) - 1U) : p_latency->latency_max_ms;
+    result = COM_STAT_MIN(result, p_latency->latency_max_ms);
+  }
+
+  return result;
+}
+
 /**
   * @brief  Display com sockets statistics
   * @note   COM_SOCKETS_STATISTIC and USE_TRACE_COM_SOCKETS must be set to 1
@@ -310,6 +470,49 @@ void com_sockets_statistic_display(void)
                com_socket_statistic.sock_cls_ok,
                com_socket_statistic.sock_cls_nok,
                (com_socket_statistic.sock_cls_ok + com_socket_statistic.sock_cls_nok))
+    /* Latency in ms and bytes by operation */
+    for (uint8_t op = 0U; op < (uint8_t)COM_SOCKET_STAT_OP_NB; op++)
+    {
+      com_sockets_stat_latency_t latency;
+
+      (void)rtosalMutexAcquire(com_socket_statistic_mutex, RTOSAL_WAIT_FOREVER);
+      (void)memcpy(&latency, &com_socket_statistic_latency[op], sizeof(com_sockets_stat_latency_t));
+      (void)rtosalMutexRelease(com_socket_statistic_mutex);
+
+      if (latency.calls != 0U)
+      {
+        PRINT_STAT("%s: ms p50:%5lu p90:%5lu p99:%5lu max:%5lu avg:%5lu bytes:%7lu max:%4lu",
+                   com_socket_statistic_op_string[op],
+                   com_sockets_statistic_percentile(&latency, 50U),
+                   com_sockets_statistic_percentile(&latency, 90U),
+                   com_sockets_statistic_percentile(&latency, 99U),
+                   latency.latency_max_ms,
+                   latency.latency_sum_ms / latency.calls,
+                   latency.bytes,
+                   latency.bytes_max)
+      }
+    }
+    /* Modem read transactions per KB received - read-ahead efficiency */
+    {
+      uint32_t rcv_calls;
+      uint32_t mdm_calls;
+      uint32_t mdm_kbytes;
+
+      (void)rtosalMutexAcquire(com_socket_statistic_mutex, RTOSAL_WAIT_FOREVER);
+      rcv_calls = com_socket_statistic_latency[COM_SOCKET_STAT_OP_RCV].calls;
+      mdm_calls = com_socket_statistic_latency[COM_SOCKET_STAT_OP_RCV_MDM].calls;
+      mdm_kbytes = com_socket_statistic_latency[COM_SOCKET_STAT_OP_RCV_MDM].bytes / 1024U;
+      (void)rtosalMutexRelease(com_socket_statistic_mutex);
+
+      if (mdm_kbytes != 0U)
+      {
+        PRINT_STAT("Rcv: calls:%5lu modem reads:%5lu per KB x100:%5lu",
+                   rcv_calls, mdm_calls, (mdm_calls * 100U) / mdm_kbytes)
+      }
+      /* only displayed: unused when the traces are deactivated */
+      UNUSED(rcv_calls);
+      UNUSED(mdm_calls);
+    }
 #if 0
     /* Socket status displayed */
     while (socket_desc != NULL)
@@ -362,6 +565,51 @@ void com_sockets_statistic_update(com_sockets_stat_update_t stat)
   /* Nothing to do */
 }
 
+/**
+  * @brief  Record the latency of an operation
+  * @note   -
+  * @param  op         - operation timed
+  * @param  start_tick - rtosalGetSysTimerCount() at the operation start
+  * @param  bytes      - result of the operation: bytes sent/received if > 0
+  * @retval -
+  */
+void com_sockets_statistic_latency(com_sockets_stat_op_t op, uint32_t start_tick, int32_t bytes)
+{
+  UNUSED(op);
+  UNUSED(start_tick);
+  UNUSED(bytes);
+  /* Nothing to do */
+}
+
+/**
+  * @brief  Get a copy of com sockets statistics
+  * @note   COM_SOCKETS_STATISTIC must be set to 1 else the snapshot is set to 0
+  * @param  p_snapshot - statistics copy
+  * @retval -
+  */
+void com_sockets_statistic_snapshot(com_sockets_stat_snapshot_t *p_snapshot)
+{
+  if (p_snapshot != NULL)
+  {
+    (void)memset(p_snapshot, 0, sizeof(com_sockets_stat_snapshot_t));
+  }
+}
+
+/**
+  * @brief  Get a latency percentile from a histogram
+  * @note   Result is the upper bound of the histogram bucket reaching the percentile,
+  *         limited to the max latency
+  * @param  p_latency - histogram
+  * @param  percent   - percentile to compute (e.g 50U, 90U, 99U)
+  * @retval uint32_t  - latency in ms (0 if no call)
+  */
+uint32_t com_sockets_statistic_percentile(const com_sockets_stat_latency_t *p_latency, uint8_t percent)
+{
+  UNUSED(p_latency);
+  UNUSED(percent);
+  return 0U;
+}
+
 /**
   * @brief  Display com sockets statistics
   * @note   COM_SOCKETS_STATISTIC and USE_TRACE_COM_SOCKETS must be set to 1
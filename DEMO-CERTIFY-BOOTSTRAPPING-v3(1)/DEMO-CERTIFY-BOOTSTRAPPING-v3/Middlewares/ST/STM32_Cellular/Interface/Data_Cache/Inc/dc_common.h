@@ -49,7 +49,12 @@ extern "C" {
   A component can subscribe a callback in order to be informed
   when a Data Cache data entry has been updated.
   Subscription is done through dc_com_register_gen_event_cb() service
+  By default a consumer is notified for each Data Cache entry update.
+  To be notified only for some entries, the consumer calls dc_com_subscribe_res()
+  service for each entry it is interested in.
   Read of data entry value is done by calling dc_com_read() service.
+  Read is done without lock: each entry has a sequence counter incremented by the writer
+  before and after the update. The read is retried when an update occurred during the copy.
 
   The Data Cache structure includes the rt_state field.
   This field contains the state of service and the validity of entry data.
@@ -132,7 +137,10 @@ extern "C" {
     {
       * Data Cache entry structure registration
       * registration allows consumer to be notified when an entry is produced in Data Cache
-      (void)dc_com_register_gen_event_cb(&dc_com_db, dc_consumer_example_notif_callback, (void *) NULL);
+      dc_com_reg_id_t reg_id;
+      reg_id = dc_com_register_gen_event_cb(&dc_com_db, dc_consumer_example_notif_callback, (void *) NULL);
+      * optional: be notified only when DC_PRODUCER_EXAMPLE_ENTRY is updated
+      (void)dc_com_subscribe_res(&dc_com_db, reg_id, DC_PRODUCER_EXAMPLE_ENTRY);
     }
 
     ---------------------------------------------------------------------------------------
@@ -226,13 +234,23 @@ extern "C" {
 
 #define DC_CELLULAR_CORE_ENTRIES 12U
 
+#if ((USE_STACK_ANALYSIS == 1) && (STACK_ANALYSIS_SAMPLER_PERIOD != 0U))
+#define DC_TASK_STAT_ENTRIES 1U
+#else  /* (USE_STACK_ANALYSIS == 1) && (STACK_ANALYSIS_SAMPLER_PERIOD != 0U) */
+#define DC_TASK_STAT_ENTRIES 0U
+#endif /* (USE_STACK_ANALYSIS == 1) && (STACK_ANALYSIS_SAMPLER_PERIOD != 0U) */
+
 /** @brief Number max of Data Cache entries */
 #define DC_COM_ENTRY_MAX_NB   (DC_BOARD_ENTRIES + \
                                DC_MEMS_ENTRIES + \
                                DC_SIMU_MEMS_ENTRIES + \
                                DC_GENERIC_ENTRIES + \
+                               DC_TASK_STAT_ENTRIES + \
                                DC_CELLULAR_CORE_ENTRIES)
 
+/** @brief Number of 32 bits words of the consumer entries subscription mask */
+#define DC_COM_RES_MASK_NB    ((DC_COM_ENTRY_MAX_NB + 31U) / 32U)
+
 /** @brief Invalid entry: at creation, the Data Cache entries must be initialized with this value  */
 #define DC_COM_INVALID_ENTRY  0xFFU
 
@@ -293,6 +311,9 @@ typedef struct
   dc_com_reg_id_t consumer_reg_id;
   dc_com_gen_event_callback_t notif_cb;
   const void *private_consumer_data;
+  bool res_filter;                          /*!< false: notified for all entries,
+                                                 true: notified only for entries set in res_mask */
+  uint32_t res_mask[DC_COM_RES_MASK_NB];    /*!< bit res_id set: consumer subscribed to res_id */
 } dc_com_consumer_info_t;
 
 /** @brief type of Data Cache global structure (Data Cache internal use) */
@@ -303,6 +324,7 @@ typedef struct
   dc_com_consumer_info_t consumer_info[DC_COM_MAX_NB_SUBSCRIBER];
   void *p_dc_db[DC_COM_ENTRY_MAX_NB];
   uint16_t dc_db_len[DC_COM_ENTRY_MAX_NB];
+  volatile uint32_t dc_db_seq[DC_COM_ENTRY_MAX_NB]; /*!< entry sequence counter: odd while a write is on-going */
 } dc_com_db_t;
 
 /**
@@ -361,6 +383,17 @@ dc_com_res_id_t dc_com_register_serv(dc_com_db_t *p_dc_db, void *p_data, uint16_
 dc_com_reg_id_t dc_com_register_gen_event_cb(dc_com_db_t *p_dc_db, dc_com_gen_event_callback_t notif_cb,
                                              const void *p_private_data);
 
+/**
+  * @brief  Allow a registered consumer to be notified only for the update of some entries.
+  * @note   Once called, the consumer is only notified for the entries it subscribed to.
+  *         Call it once per entry of interest. Events sent by dc_com_write_event are not filtered.
+  * @param  p_dc_db         - data base reference (Must be set to &dc_com_db)
+  * @param  reg_id          - consumer identifier returned by dc_com_register_gen_event_cb
+  * @param  res_id          - entry/resource id to subscribe to
+  * @retval dc_com_status_t - return status with DC_COM_OK or DC_COM_ERROR
+  */
+dc_com_status_t dc_com_subscribe_res(dc_com_db_t *p_dc_db, dc_com_reg_id_t reg_id, dc_com_res_id_t res_id);
+
 /**
   * @brief  Allow a Data Cache producer to update data associated to a Data Cache entry.
   * @param  p_dc            - data base reference (Must be set to &dc_com_db)
@@ -373,6 +406,7 @@ dc_com_status_t dc_com_write(dc_com_db_t *p_dc, dc_com_res_id_t res_id, const vo
 
 /**
   * @brief  Allow a consumer to read the currents data associated to a Data Cache entry.
+  * @note   The read copy is consistent: it never mixes data of two different writes.
   * @param  p_dc            - data base reference (Must be set to &dc_com_db)
   * @param  res_id          - entry/resource id
   * @param  p_data          - data to read
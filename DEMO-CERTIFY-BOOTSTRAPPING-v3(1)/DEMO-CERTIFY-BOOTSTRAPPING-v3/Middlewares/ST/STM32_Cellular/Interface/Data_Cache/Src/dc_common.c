@@ -35,6 +35,9 @@ typedef struct
 } dc_base_rt_info_t;
 
 /* Private defines -----------------------------------------------------------*/
+/* Number of lock-free read attempts before waiting the end of the write with the mutex */
+#define DC_COM_READ_MAX_RETRY 3U
+
 /* Private macros ------------------------------------------------------------*/
 /* Global variables ----------------------------------------------------------*/
 
@@ -42,12 +45,41 @@ typedef struct
 dc_com_db_t dc_com_db;
 
 /* Private function prototypes -----------------------------------------------*/
+static bool dc_com_is_subscribed(const dc_com_consumer_info_t *p_consumer_info, dc_com_res_id_t res_id);
 
 /* Private variables ---------------------------------------------------------*/
 
 /* Mutex to avoid  Data Cache concurrent access */
 static osMutexId dc_common_mutex;
 
+/* Private function Definition -----------------------------------------------*/
+/**
+  * @brief  Check if a consumer has to be notified of an entry update.
+  * @param  p_consumer_info - consumer information
+  * @param  res_id          - entry/resource id
+  * @retval bool            - true: consumer to notify, false: otherwise
+  */
+static bool dc_com_is_subscribed(const dc_com_consumer_info_t *p_consumer_info, dc_com_res_id_t res_id)
+{
+  bool result;
+
+  if (p_consumer_info->notif_cb == NULL)
+  {
+    result = false;
+  }
+  else if (p_consumer_info->res_filter == false)
+  {
+    /* no subscription: consumer notified for all entries */
+    result = true;
+  }
+  else
+  {
+    result = ((p_consumer_info->res_mask[res_id / 32U] & (1UL << (res_id % 32U))) != 0U);
+  }
+
+  return result;
+}
+
 /* Functions Definition ------------------------------------------------------*/
 
 /**
@@ -124,6 +156,35 @@ dc_com_reg_id_t dc_com_register_gen_event_cb(dc_com_db_t *p_dc_db,
   return consumer_id;
 }
 
+/**
+  * @brief  Allow a registered consumer to be notified only for the update of some entries.
+  * @note   Once called, the consumer is only notified for the entries it subscribed to.
+  *         Call it once per entry of interest. Events sent by dc_com_write_event are not filtered.
+  * @param  p_dc_db         - data base reference (Must be set to &dc_com_db)
+  * @param  reg_id          - consumer identifier returned by dc_com_register_gen_event_cb
+  * @param  res_id          - entry/resource id to subscribe to
+  * @retval dc_com_status_t - return status with DC_COM_OK or DC_COM_ERROR
+  */
+dc_com_status_t dc_com_subscribe_res(dc_com_db_t *p_dc_db, dc_com_reg_id_t reg_id, dc_com_res_id_t res_id)
+{
+  dc_com_status_t res;
+
+  if ((p_dc_db != NULL) && (reg_id < p_dc_db->consumer_number) && (res_id < p_dc_db->serv_number))
+  {
+    (void)rtosalMutexAcquire(dc_common_mutex, RTOSAL_WAIT_FOREVER);
+    p_dc_db->consumer_info[reg_id].res_filter = true;
+    p_dc_db->consumer_info[reg_id].res_mask[res_id / 32U] |= (1UL << (res_id % 32U));
+    (void)rtosalMutexRelease(dc_common_mutex);
+    res = DC_COM_OK;
+  }
+  else
+  {
+    res = DC_COM_ERROR;
+  }
+
+  return res;
+}
+
 /**
   * @brief  Allow a Data Cache producer to update data associated to a Data Cache entry.
   * @param  p_dc            - data base reference (Must be set to &dc_com_db)
@@ -144,17 +205,26 @@ dc_com_status_t dc_com_write(dc_com_db_t *p_dc, dc_com_res_id_t res_id, const vo
     /* Avoid to be interrupted by another event before the end of first event processing */
     (void)rtosalMutexAcquire(dc_common_mutex, RTOSAL_WAIT_FOREVER);
 
+    /* Odd sequence: readers know the entry is being updated */
+    p_dc->dc_db_seq[res_id]++;
+    __DMB();
+
     (void)memcpy((void *)(com_db->p_dc_db[res_id]), p_data, (uint32_t)len);
     dc_base_rt_info = (dc_base_rt_info_t *)(com_db->p_dc_db[res_id]);
     dc_base_rt_info->header.res_id = res_id;
     dc_base_rt_info->header.size   = len;
 
+    /* Even sequence: update is complete */
+    __DMB();
+    p_dc->dc_db_seq[res_id]++;
+
+    /* Notify only the consumers interested by this entry */
     for (reg_id = 0U; reg_id < p_dc->consumer_number; reg_id++)
     {
       const dc_com_consumer_info_t *consumer_info;
       consumer_info = &(com_db->consumer_info[reg_id]);
 
-      if (consumer_info->notif_cb != NULL)
+      if (dc_com_is_subscribed(consumer_info, res_id) == true)
       {
         consumer_info->notif_cb((dc_com_event_id_t)res_id, consumer_info->private_consumer_data);
       }
@@ -182,10 +252,37 @@ dc_com_status_t dc_com_write(dc_com_db_t *p_dc, dc_com_res_id_t res_id, const vo
 dc_com_status_t dc_com_read(dc_com_db_t *p_dc, dc_com_res_id_t res_id, void *p_data, uint32_t len)
 {
   dc_com_status_t res;
+  uint32_t seq;
+  uint8_t retry;
+  bool consistent;
 
   if ((p_dc != NULL) && (res_id < p_dc->serv_number) && (p_dc->dc_db_len[res_id] >= len))
   {
-    (void)memcpy(p_data, (void *)p_dc->p_dc_db[res_id], (uint32_t)len);
+    consistent = false;
+    retry = 0U;
+    while ((consistent == false) && (retry < DC_COM_READ_MAX_RETRY))
+    {
+      seq = p_dc->dc_db_seq[res_id];
+      /* No copy if a write is on-going */
+      if ((seq & 1U) == 0U)
+      {
+        __DMB();
+        (void)memcpy(p_data, (void *)p_dc->p_dc_db[res_id], (uint32_t)len);
+        __DMB();
+        /* Copy is consistent if no write occurred in the meantime */
+        consistent = (seq == p_dc->dc_db_seq[res_id]);
+      }
+      retry++;
+    }
+
+    if (consistent == false)
+    {
+      /* Reader has preempted a writer in the middle of the update:
+         take the mutex to let the writer complete, then copy */
+      (void)rtosalMutexAcquire(dc_common_mutex, RTOSAL_WAIT_FOREVER);
+      (void)memcpy(p_data, (void *)p_dc->p_dc_db[res_id], (uint32_t)len);
+      (void)rtosalMutexRelease(dc_common_mutex);
+    }
     res = DC_COM_OK;
   }
   else
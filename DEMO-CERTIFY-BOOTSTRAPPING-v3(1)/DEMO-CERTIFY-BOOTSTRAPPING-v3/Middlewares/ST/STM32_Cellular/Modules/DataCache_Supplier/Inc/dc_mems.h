@@ -29,6 +29,7 @@ extern "C" {
 /* Includes ------------------------------------------------------------------*/
 #include <math.h>
 #include "dc_common.h"
+#include "dc_mems_sampler.h"
 
 /* Exported macros -----------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
@@ -87,6 +88,14 @@ typedef struct
   dc_sensor_axe_t magnetometer;
 } dc_magnetometer_info_t;
 
+/* Aggregates of all the sensors over a window: min, max, mean, last value and shocks */
+typedef struct
+{
+  dc_service_rt_header_t header;
+  dc_service_rt_state_t rt_state;
+  mems_sampler_window_t window;
+} dc_mems_window_info_t;
+
 /* Exported constants --------------------------------------------------------*/
 /* External variables --------------------------------------------------------*/
 #if (USE_DC_MEMS == 1) || (USE_SIMU_MEMS == 1)
@@ -96,12 +105,16 @@ extern dc_com_res_id_t  DC_COM_TEMPERATURE   ;
 extern dc_com_res_id_t  DC_COM_ACCELEROMETER ;
 extern dc_com_res_id_t  DC_COM_GYROSCOPE     ;
 extern dc_com_res_id_t  DC_COM_MAGNETOMETER  ;
+extern dc_com_res_id_t  DC_COM_MEMS_WINDOW   ;
 #endif  /* (USE_DC_MEMS == 1) || (USE_SIMU_MEMS == 1) */
 
 /* Exported functions ------------------------------------------------------- */
 void dc_mems_start(void);
 void dc_mems_init(void);
 
+/* Sensor data ready / FIFO watermark - callable from the sensor interrupt handler */
+void dc_mems_sensor_event(mems_sampler_sensor_t sensor);
+
 #ifdef __cplusplus
 }
 #endif
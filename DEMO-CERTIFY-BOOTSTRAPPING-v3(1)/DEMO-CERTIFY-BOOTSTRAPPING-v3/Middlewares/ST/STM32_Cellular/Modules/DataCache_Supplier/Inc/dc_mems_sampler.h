@@ -0,0 +1,170 @@
+/**
+  ******************************************************************************
+  * @file    dc_mems_sampler.h
+  * @author  artworkTrackingMAP
+  * @brief   Header for dc_mems_sampler.c module
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef DC_MEMS_SAMPLER_H
+#define DC_MEMS_SAMPLER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+/* No platform include: the sampler is built and run on host as well */
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+/**
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                    ##### How to use MEMS sampler module #####
+  ==============================================================================
+
+  The sampler reads each sensor at its own period through a sensor bus and
+  aggregates the samples of a window: number, min, max, mean and last value of
+  each axis. Accelerometer samples are checked for shocks: a sample whose norm
+  differs from 1g by more than shock_threshold_mg.
+
+  - mems_sampler_init() with a configuration and a bus (read function + context).
+    The bus may return several samples per read (FIFO / batch), up to batch_nb.
+  - mems_sampler_run() reads the sensors due at now_ms and returns the delay
+    until the next sensor or window end. The caller sleeps this delay, or less
+    if woken up by a sensor interrupt (see mems_sampler_request()).
+  - mems_sampler_window_get() returns the aggregates once per window, or at a
+    shock if shock_ends_window is set. A window ended by a shock lasts at least
+    shock_window_min_ms: a series of shocks gives one window per
+    shock_window_min_ms, not one per accelerometer read.
+
+  The sampler uses no OS and no HAL service: the time is given by the caller.
+  mems_sampler_simu_read() is a simulated bus, to run the sampler on host:
+    mems_sampler_simu_init(&simu);
+    mems_sampler_init(&sampler, &config, mems_sampler_simu_read, &simu);
+    for (now = 0U; now < 60000U; now += delay)
+    {
+      delay = mems_sampler_run(&sampler, now);
+      if (mems_sampler_window_get(&sampler, now, &window) == true) { ... }
+    }
+  mems_sampler_simu_shock() injects a shock in the next accelerometer sample.
+
+  @endverbatim
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/* Max number of samples returned by one bus read */
+#if !defined MEMS_SAMPLER_BATCH_MAX
+#define MEMS_SAMPLER_BATCH_MAX   (16U)
+#endif /* !defined MEMS_SAMPLER_BATCH_MAX */
+
+/* Acceleration of gravity in accelerometer unit (mg) */
+#define MEMS_SAMPLER_GRAVITY_MG  (1000.0f)
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  MEMS_SAMPLER_ACCELERO = 0,  /* mg     */
+  MEMS_SAMPLER_GYRO,          /* mdps   */
+  MEMS_SAMPLER_MAGNETO,       /* mgauss */
+  MEMS_SAMPLER_PRESSURE,      /* hPa    - axis[0] only */
+  MEMS_SAMPLER_HUMIDITY,      /* %      - axis[0] only */
+  MEMS_SAMPLER_TEMPERATURE,   /* degC   - axis[0] only */
+  MEMS_SAMPLER_SENSOR_NB
+} mems_sampler_sensor_t;
+
+/* One sample of a sensor */
+typedef struct
+{
+  float_t axis[3];
+} mems_sampler_value_t;
+
+/* Sensor bus: read up to max_nb samples of a sensor, return the number of samples read (0: none) */
+typedef uint16_t (*mems_sampler_read_t)(void *p_bus_context, mems_sampler_sensor_t sensor,
+                                        mems_sampler_value_t *p_values, uint16_t max_nb);
+
+typedef struct
+{
+  uint32_t period_ms[MEMS_SAMPLER_SENSOR_NB]; /* read period of each sensor, 0: not read       */
+  uint16_t batch_nb[MEMS_SAMPLER_SENSOR_NB];  /* max samples per read (FIFO depth), 0 means 1  */
+  uint32_t window_ms;                         /* aggregation window                           */
+  float_t  shock_threshold_mg;                /* shock detection threshold, 0: no detection   */
+  bool     shock_ends_window;                 /* end the window as soon as a shock is detected */
+  uint32_t shock_window_min_ms;               /* min duration of a window ended by a shock    */
+} mems_sampler_config_t;
+
+/* Aggregates of one sensor over a window */
+typedef struct
+{
+  uint16_t nb;                                /* number of samples, 0: other fields not valid */
+  float_t  min[3];
+  float_t  max[3];
+  float_t  mean[3];
+  float_t  last[3];
+} mems_sampler_stat_t;
+
+/* Result of a window */
+typedef struct
+{
+  uint32_t start_ms;                          /* window start time                            */
+  uint32_t duration_ms;                       /* window duration                              */
+  uint16_t read_nb;                           /* number of bus reads                          */
+  uint16_t shock_nb;                          /* number of accelerometer samples over threshold */
+  float_t  shock_max_mg;                      /* max difference between norm and 1g           */
+  uint32_t shock_first_ms;                    /* first shock time, from window start          */
+  mems_sampler_stat_t stat[MEMS_SAMPLER_SENSOR_NB];
+} mems_sampler_window_t;
+
+/* Sampler context - fields are private */
+typedef struct
+{
+  mems_sampler_config_t config;
+  mems_sampler_read_t   p_read;
+  void                  *p_bus_context;
+  bool                  started;
+  uint32_t              next_ms[MEMS_SAMPLER_SENSOR_NB];
+  float_t               sum[MEMS_SAMPLER_SENSOR_NB][3];
+  mems_sampler_window_t window;
+  mems_sampler_value_t  values[MEMS_SAMPLER_BATCH_MAX];
+} mems_sampler_t;
+
+/* Simulated bus context - fields are private */
+typedef struct
+{
+  float_t  env[3];                            /* pressure, humidity, temperature              */
+  float_t  env_step[3];
+  uint32_t count;
+  float_t  shock_mg;
+} mems_sampler_simu_t;
+
+/* External variables --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void     mems_sampler_init(mems_sampler_t *p_sampler, const mems_sampler_config_t *p_config,
+                           mems_sampler_read_t p_read, void *p_bus_context);
+uint32_t mems_sampler_run(mems_sampler_t *p_sampler, uint32_t now_ms);
+bool     mems_sampler_window_get(mems_sampler_t *p_sampler, uint32_t now_ms, mems_sampler_window_t *p_window);
+
+/* Read a sensor at the next mems_sampler_run() - e.g. on a FIFO watermark interrupt */
+void     mems_sampler_request(mems_sampler_t *p_sampler, mems_sampler_sensor_t sensor, uint32_t now_ms);
+
+/* Change the window duration - applies from the current window */
+void     mems_sampler_set_window(mems_sampler_t *p_sampler, uint32_t window_ms);
+
+/* Simulated bus */
+void     mems_sampler_simu_init(mems_sampler_simu_t *p_simu);
+void     mems_sampler_simu_shock(mems_sampler_simu_t *p_simu, float_t shock_mg);
+uint16_t mems_sampler_simu_read(void *p_bus_context, mems_sampler_sensor_t sensor,
+                                mems_sampler_value_t *p_values, uint16_t max_nb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DC_MEMS_SAMPLER_H */
+
+/******************************** END OF FILE *********************************/
@@ -101,31 +101,59 @@
 #endif /* USE_TRACE_DCMEMS */
 
 /* Private defines -----------------------------------------------------------*/
-#define MEMS_POLLING_PERIOD    10000U
-
-#define SIMULATED_PRESSURE_INCREMENT    (float_t)1
-#define SIMULATED_PRESSURE_INITIAL      (float_t)1000
-#define SIMULATED_PRESSURE_DELTA        (float_t)7
-#define SIMULATED_PRESSURE_MAX          (float_t)(SIMULATED_PRESSURE_INITIAL+SIMULATED_PRESSURE_DELTA)
-#define SIMULATED_PRESSURE_MIN          (float_t)(SIMULATED_PRESSURE_INITIAL-SIMULATED_PRESSURE_DELTA)
-
-#define SIMULATED_HUMIDITY_INCREMENT    (float_t)1
-#define SIMULATED_HUMIDITY_INITIAL      (float_t)85
-#define SIMULATED_HUMIDITY_DELTA        (float_t)10
-#define SIMULATED_HUMIDITY_MAX          (SIMULATED_HUMIDITY_INITIAL+SIMULATED_HUMIDITY_DELTA)
-#define SIMULATED_HUMIDITY_MIN          (SIMULATED_HUMIDITY_INITIAL-SIMULATED_HUMIDITY_DELTA)
-
-#define SIMULATED_TEMPERATURE_INCREMENT (float_t)0.8
-#define SIMULATED_TEMPERATURE_INITIAL   (float_t)40
-#define SIMULATED_TEMPERATURE_DELTA     (float_t)7
-#define SIMULATED_TEMPERATURE_MAX       (SIMULATED_TEMPERATURE_INITIAL+SIMULATED_TEMPERATURE_DELTA)
-#define SIMULATED_TEMPERATURE_MIN       (SIMULATED_TEMPERATURE_INITIAL-SIMULATED_TEMPERATURE_DELTA)
+/* Aggregation window: the Data Cache mems entries are updated once per window */
+#if !defined DC_MEMS_WINDOW_PERIOD
+#define DC_MEMS_WINDOW_PERIOD      (10000U)
+#endif /* !defined DC_MEMS_WINDOW_PERIOD */
+
+/* Read period of the environmental sensors: pressure, humidity, temperature */
+#if !defined DC_MEMS_ENV_PERIOD
+#define DC_MEMS_ENV_PERIOD         (10000U)
+#endif /* !defined DC_MEMS_ENV_PERIOD */
+
+/* Read period of the accelerometer */
+#if !defined DC_MEMS_ACCELERO_PERIOD
+#define DC_MEMS_ACCELERO_PERIOD    (10000U)
+#endif /* !defined DC_MEMS_ACCELERO_PERIOD */
+
+/* Read period of the gyroscope and of the magnetometer */
+#if !defined DC_MEMS_MOTION_PERIOD
+#define DC_MEMS_MOTION_PERIOD      (10000U)
+#endif /* !defined DC_MEMS_MOTION_PERIOD */
+
+/* 1: the board calls dc_mems_sensor_event() on a FIFO watermark or wake-up interrupt.
+   Without it every read is an I2C transfer woken by a timer: the motion sensors are
+   not polled faster than the environmental sensors */
+#if !defined DC_MEMS_USE_SENSOR_EVENT
+#define DC_MEMS_USE_SENSOR_EVENT   (0U)
+#endif /* !defined DC_MEMS_USE_SENSOR_EVENT */
+
+#if (DC_MEMS_USE_SENSOR_EVENT == 0U)
+#if (DC_MEMS_ACCELERO_PERIOD < DC_MEMS_ENV_PERIOD) || (DC_MEMS_MOTION_PERIOD < DC_MEMS_ENV_PERIOD)
+#error "DC_MEMS_ACCELERO_PERIOD and DC_MEMS_MOTION_PERIOD below DC_MEMS_ENV_PERIOD need DC_MEMS_USE_SENSOR_EVENT"
+#endif /* DC_MEMS_ACCELERO_PERIOD < DC_MEMS_ENV_PERIOD || DC_MEMS_MOTION_PERIOD < DC_MEMS_ENV_PERIOD */
+#endif /* DC_MEMS_USE_SENSOR_EVENT == 0U */
+
+/* Shock threshold in mg: difference between acceleration norm and 1g - 0U: no detection */
+#if !defined DC_MEMS_SHOCK_THRESHOLD
+#define DC_MEMS_SHOCK_THRESHOLD    (500U)
+#endif /* !defined DC_MEMS_SHOCK_THRESHOLD */
+
+/* Min duration of a window ended by a shock: a series of shocks gives one window per period */
+#if !defined DC_MEMS_SHOCK_WINDOW_MIN
+#define DC_MEMS_SHOCK_WINDOW_MIN   (2000U)
+#endif /* !defined DC_MEMS_SHOCK_WINDOW_MIN */
 
 
 /* Private variables ---------------------------------------------------------*/
 #if (USE_CMD_CONSOLE == 1)
 static uint8_t *mems_cmd_label = (uint8_t *)"mems";
 static uint32_t mems_state;
+static const uint8_t *mems_sensor_name[MEMS_SAMPLER_SENSOR_NB] =
+{
+  (const uint8_t *)"accelero", (const uint8_t *)"gyro", (const uint8_t *)"magneto",
+  (const uint8_t *)"pressure", (const uint8_t *)"humidity", (const uint8_t *)"temperature"
+};
 #endif  /* USE_CMD_CONSOLE */
 
 #if (USE_DC_MEMS == 1)
@@ -168,8 +196,26 @@ static int8_t mems_init_status;               /* init status of mems */
 static dc_pressure_info_t          dc_pressure_info;
 static dc_humidity_info_t          dc_humidity_info;
 static dc_temperature_info_t       dc_temperature_info;
-static uint32_t       mems_polling_period;
+static dc_mems_window_info_t       dc_mems_window_info;
+static uint32_t       mems_window_period;
 
+/* Sampler of the sensors: read by the mems task only */
+static mems_sampler_t        mems_sampler;
+static mems_sampler_config_t mems_sampler_config;
+#if (USE_SIMU_MEMS == 1)
+static mems_sampler_simu_t   mems_simu;
+#endif /* USE_SIMU_MEMS == 1 */
+
+/* Read period of each sensor - mems_sampler_sensor_t order */
+static const uint32_t mems_sensor_period[MEMS_SAMPLER_SENSOR_NB] =
+{
+  DC_MEMS_ACCELERO_PERIOD, DC_MEMS_MOTION_PERIOD, DC_MEMS_MOTION_PERIOD,
+  DC_MEMS_ENV_PERIOD, DC_MEMS_ENV_PERIOD, DC_MEMS_ENV_PERIOD
+};
+
+/* Sensor events set by dc_mems_sensor_event() - wake up of the mems task */
+static osSemaphoreId mems_event_semaphore = NULL;
+static volatile uint8_t mems_event[MEMS_SAMPLER_SENSOR_NB];
 
 /* Global variables ----------------------------------------------------------*/
 dc_com_res_id_t  DC_COM_PRESSURE      = DC_COM_INVALID_ENTRY;
@@ -178,17 +224,23 @@ dc_com_res_id_t  DC_COM_TEMPERATURE   = DC_COM_INVALID_ENTRY;
 dc_com_res_id_t  DC_COM_ACCELEROMETER = DC_COM_INVALID_ENTRY;
 dc_com_res_id_t  DC_COM_GYROSCOPE     = DC_COM_INVALID_ENTRY;
 dc_com_res_id_t  DC_COM_MAGNETOMETER  = DC_COM_INVALID_ENTRY;
+dc_com_res_id_t  DC_COM_MEMS_WINDOW   = DC_COM_INVALID_ENTRY;
 
 /* Private function prototypes -----------------------------------------------*/
 static void StartMemsDclibTask(void *argument);
 static void mems_init_sensors(void);
-static void mems_get_acc_datas(void);
-static void mems_get_gyro_datas(void);
-static void mems_get_magn_datas(void);
-static uint8_t mems_get_pressure_datas(void);
-static uint8_t mems_get_humidity_datas(void);
-static uint8_t mems_get_temperature_datas(void);
+static void mems_sampler_setup(void);
+static uint16_t mems_bus_read(void *p_bus_context, mems_sampler_sensor_t sensor,
+                              mems_sampler_value_t *p_values, uint16_t max_nb);
+static void mems_publish(dc_mems_window_info_t *p_window_info);
+static uint16_t mems_get_acc_datas(mems_sampler_value_t *p_value);
+static uint16_t mems_get_gyro_datas(mems_sampler_value_t *p_value);
+static uint16_t mems_get_magn_datas(mems_sampler_value_t *p_value);
+static uint16_t mems_get_pressure_datas(mems_sampler_value_t *p_value);
+static uint16_t mems_get_humidity_datas(mems_sampler_value_t *p_value);
+static uint16_t mems_get_temperature_datas(mems_sampler_value_t *p_value);
 #if (USE_CMD_CONSOLE == 1)
+static void mems_cmd_window(void);
 static void mems_cmd_help(void);
 static cmd_status_t mems_cmd(uint8_t *cmd_line_p);
 #endif /* USE_CMD_CONSOLE */
@@ -207,7 +259,8 @@ static void mems_cmd_help(void)
   PRINT_FORCE("%s state (state of mems software component)", mems_cmd_label);
   PRINT_FORCE("%s disable (disable mems process)", mems_cmd_label);
   PRINT_FORCE("%s enable (enable mems process)", mems_cmd_label);
-  PRINT_FORCE("%s period [<ms>] (set/get mems process period)", mems_cmd_label);
+  PRINT_FORCE("%s period [<ms>] (set/get mems aggregation window period)", mems_cmd_label);
+  PRINT_FORCE("%s window (display the last aggregation window)", mems_cmd_label);
   PRINT_FORCE("%s pressure (get current pressure value)", mems_cmd_label);
   PRINT_FORCE("%s pressure <ppp>  (set pressure value and disable mems process)", mems_cmd_label);
   PRINT_FORCE("%s temperature (get current temperature value)", mems_cmd_label);
@@ -216,6 +269,41 @@ static void mems_cmd_help(void)
   PRINT_FORCE("%s humidity <hhh> (set humidity value and disable mems process)", mems_cmd_label);
 }
 
+/**
+  * @brief  display the last aggregation window
+  * @param  none
+  * @retval none
+  */
+static void mems_cmd_window(void)
+{
+  dc_mems_window_info_t window_info;
+  const mems_sampler_stat_t *p_stat;
+
+  (void)dc_com_read(&dc_com_db, DC_COM_MEMS_WINDOW, (void *)&window_info, sizeof(window_info));
+  if (window_info.rt_state == DC_SERVICE_ON)
+  {
+    PRINT_FORCE("window start: %ld duration: %ld ms reads: %d", window_info.window.start_ms,
+                window_info.window.duration_ms, window_info.window.read_nb);
+    PRINT_FORCE("shocks: %d max: %f mg first: %ld ms", window_info.window.shock_nb,
+                window_info.window.shock_max_mg, window_info.window.shock_first_ms);
+    for (uint8_t i = 0U; i < (uint8_t)MEMS_SAMPLER_SENSOR_NB; i++)
+    {
+      p_stat = &window_info.window.stat[i];
+      if (p_stat->nb != 0U)
+      {
+        PRINT_FORCE("%-11s nb:%4d min: %f %f %f", mems_sensor_name[i], p_stat->nb,
+                    p_stat->min[0], p_stat->min[1], p_stat->min[2]);
+        PRINT_FORCE("%-11s       max: %f %f %f", "", p_stat->max[0], p_stat->max[1], p_stat->max[2]);
+        PRINT_FORCE("%-11s      mean: %f %f %f", "", p_stat->mean[0], p_stat->mean[1], p_stat->mean[2]);
+      }
+    }
+  }
+  else
+  {
+    PRINT_FORCE("no mems window available");
+  }
+}
+
 /**
   * @brief  mems command handler
   * @param  cmd_line_p     command line
@@ -271,7 +359,11 @@ static cmd_status_t mems_cmd(uint8_t *cmd_line_p)
       else
       {
         PRINT_FORCE("mems enabled");
-        PRINT_FORCE("polling period: %ld", mems_polling_period);
+        PRINT_FORCE("window period: %ld", mems_window_period);
+        for (uint8_t i = 0U; i < (uint8_t)MEMS_SAMPLER_SENSOR_NB; i++)
+        {
+          PRINT_FORCE("%s read period: %ld", mems_sensor_name[i], mems_sampler_config.period_ms[i]);
+        }
       }
     }
     else if (memcmp((CRC_CHAR_t *)argv_p[0], "enable", crs_strlen(argv_p[0])) == 0)
@@ -288,13 +380,29 @@ static cmd_status_t mems_cmd(uint8_t *cmd_line_p)
     {
       if (argc == 2U)
       {
-        mems_polling_period = (uint32_t)crs_atoi(argv_p[1]);
+        if (crs_atoi(argv_p[1]) > 0)
+        {
+          /* applied by the mems task at its next wake up */
+          mems_window_period = (uint32_t)crs_atoi(argv_p[1]);
+          if (mems_event_semaphore != NULL)
+          {
+            (void)rtosalSemaphoreRelease(mems_event_semaphore);
+          }
+        }
+        else
+        {
+          PRINT_FORCE("%s bad period %s", argv_p[0], argv_p[1]);
+        }
       }
       else
       {
-        PRINT_FORCE("mems polling period: %ld", mems_polling_period);
+        PRINT_FORCE("mems window period: %ld", mems_window_period);
       }
     }
+    else if (memcmp((CRC_CHAR_t *)argv_p[0], "window", crs_strlen(argv_p[0])) == 0)
+    {
+      mems_cmd_window();
+    }
     else if (memcmp((CRC_CHAR_t *)argv_p[0], "pressure", crs_strlen(argv_p[0])) == 0)
     {
       if (argc == 2U)
@@ -371,24 +479,172 @@ static cmd_status_t mems_cmd(uint8_t *cmd_line_p)
 }
 #endif /* USE_CMD_CONSOLE */
 
+/**
+  * @brief  Sensor bus of the sampler: read a sensor of the board
+  * @note   The board sensors are read without FIFO: one sample per read.
+  *         When the sensor is not available, the environmental values are simulated (USE_SIMU_MEMS == 1).
+  * @param  p_bus_context - unused
+  * @param  sensor        - sensor to read
+  * @param  p_values      - samples read
+  * @param  max_nb        - max number of samples
+  * @retval uint16_t      - number of samples read
+  */
+static uint16_t mems_bus_read(void *p_bus_context, mems_sampler_sensor_t sensor,
+                              mems_sampler_value_t *p_values, uint16_t max_nb)
+{
+  uint16_t nb;
+  UNUSED(p_bus_context);
+#if (USE_SIMU_MEMS == 0)
+  UNUSED(max_nb);
+#endif /* USE_SIMU_MEMS == 0 */
+
+  switch (sensor)
+  {
+    case MEMS_SAMPLER_ACCELERO:
+      nb = mems_get_acc_datas(p_values);
+      break;
+    case MEMS_SAMPLER_GYRO:
+      nb = mems_get_gyro_datas(p_values);
+      break;
+    case MEMS_SAMPLER_MAGNETO:
+      nb = mems_get_magn_datas(p_values);
+      break;
+    case MEMS_SAMPLER_PRESSURE:
+      nb = mems_get_pressure_datas(p_values);
+      break;
+    case MEMS_SAMPLER_HUMIDITY:
+      nb = mems_get_humidity_datas(p_values);
+      break;
+    case MEMS_SAMPLER_TEMPERATURE:
+      nb = mems_get_temperature_datas(p_values);
+      break;
+    default:
+      nb = 0U;
+      break;
+  }
+
+#if (USE_SIMU_MEMS == 1)
+  if ((nb == 0U) && (sensor >= MEMS_SAMPLER_PRESSURE))
+  {
+    nb = mems_sampler_simu_read((void *)&mems_simu, sensor, p_values, max_nb);
+    PRINT_DBG("### Simulated %d value = %f\n\r", sensor, p_values[0].axis[0])
+  }
+#endif /* USE_SIMU_MEMS */
+
+  return (nb);
+}
+
+/**
+  * @brief  Configure the sampler with the sensors available
+  * @note   A sensor giving no sample at startup is never read
+  * @param  none
+  * @retval none
+  */
+static void mems_sampler_setup(void)
+{
+  mems_sampler_value_t value;
+
+#if (USE_SIMU_MEMS == 1)
+  mems_sampler_simu_init(&mems_simu);
+#endif /* USE_SIMU_MEMS */
+
+  (void)memset((void *)&mems_sampler_config, 0, sizeof(mems_sampler_config_t));
+  mems_sampler_config.window_ms           = mems_window_period;
+  mems_sampler_config.shock_threshold_mg  = (float_t)DC_MEMS_SHOCK_THRESHOLD;
+  mems_sampler_config.shock_ends_window   = true;
+  mems_sampler_config.shock_window_min_ms = DC_MEMS_SHOCK_WINDOW_MIN;
+
+  for (uint8_t i = 0U; i < (uint8_t)MEMS_SAMPLER_SENSOR_NB; i++)
+  {
+    if (mems_bus_read(NULL, (mems_sampler_sensor_t)i, &value, 1U) != 0U)
+    {
+      mems_sampler_config.period_ms[i] = mems_sensor_period[i];
+      mems_sampler_config.batch_nb[i]  = (uint16_t)MEMS_SAMPLER_BATCH_MAX;
+    }
+  }
+}
+
+/**
+  * @brief  Publish a window in the Data Cache
+  * @note   DC_COM_MEMS_WINDOW gets the whole window, the sensor entries get
+  *         the mean (environmental sensors) or last (motion sensors) value
+  * @param  p_window_info - window to publish
+  * @retval none
+  */
+static void mems_publish(dc_mems_window_info_t *p_window_info)
+{
+  const mems_sampler_stat_t *p_stat = &p_window_info->window.stat[0];
+  dc_pressure_info_t      pressure_info;
+  dc_humidity_info_t      humidity_info;
+  dc_temperature_info_t   temperature_info;
+  dc_accelerometer_info_t accelerometer_info;
+  dc_gyroscope_info_t     gyroscope_info;
+  dc_magnetometer_info_t  magnetometer_info;
+
+  PRINT_DBG("window %ld ms: %d reads, %d shocks", p_window_info->window.duration_ms,
+            p_window_info->window.read_nb, p_window_info->window.shock_nb)
+
+  p_window_info->rt_state = DC_SERVICE_ON;
+  (void)dc_com_write(&dc_com_db, DC_COM_MEMS_WINDOW, (void *)p_window_info, sizeof(dc_mems_window_info_t));
+
+  if (p_stat[MEMS_SAMPLER_ACCELERO].nb != 0U)
+  {
+    accelerometer_info.rt_state              = DC_SERVICE_ON;
+    accelerometer_info.accelerometer.AXIS_X  = (int32_t)p_stat[MEMS_SAMPLER_ACCELERO].last[0];
+    accelerometer_info.accelerometer.AXIS_Y  = (int32_t)p_stat[MEMS_SAMPLER_ACCELERO].last[1];
+    accelerometer_info.accelerometer.AXIS_Z  = (int32_t)p_stat[MEMS_SAMPLER_ACCELERO].last[2];
+    (void)dc_com_write(&dc_com_db, DC_COM_ACCELEROMETER, (void *)&accelerometer_info, sizeof(accelerometer_info));
+  }
+  if (p_stat[MEMS_SAMPLER_GYRO].nb != 0U)
+  {
+    gyroscope_info.rt_state          = DC_SERVICE_ON;
+    gyroscope_info.gyroscope.AXIS_X  = (int32_t)p_stat[MEMS_SAMPLER_GYRO].last[0];
+    gyroscope_info.gyroscope.AXIS_Y  = (int32_t)p_stat[MEMS_SAMPLER_GYRO].last[1];
+    gyroscope_info.gyroscope.AXIS_Z  = (int32_t)p_stat[MEMS_SAMPLER_GYRO].last[2];
+    (void)dc_com_write(&dc_com_db, DC_COM_GYROSCOPE, (void *)&gyroscope_info, sizeof(gyroscope_info));
+  }
+  if (p_stat[MEMS_SAMPLER_MAGNETO].nb != 0U)
+  {
+    magnetometer_info.rt_state             = DC_SERVICE_ON;
+    magnetometer_info.magnetometer.AXIS_X  = (int32_t)p_stat[MEMS_SAMPLER_MAGNETO].last[0];
+    magnetometer_info.magnetometer.AXIS_Y  = (int32_t)p_stat[MEMS_SAMPLER_MAGNETO].last[1];
+    magnetometer_info.magnetometer.AXIS_Z  = (int32_t)p_stat[MEMS_SAMPLER_MAGNETO].last[2];
+    (void)dc_com_write(&dc_com_db, DC_COM_MAGNETOMETER, (void *)&magnetometer_info, sizeof(magnetometer_info));
+  }
+  if (p_stat[MEMS_SAMPLER_PRESSURE].nb != 0U)
+  {
+    pressure_info.rt_state = DC_SERVICE_ON;
+    pressure_info.pressure = p_stat[MEMS_SAMPLER_PRESSURE].mean[0];
+    (void)dc_com_write(&dc_com_db, DC_COM_PRESSURE, (void *)&pressure_info, sizeof(pressure_info));
+  }
+  if (p_stat[MEMS_SAMPLER_HUMIDITY].nb != 0U)
+  {
+    humidity_info.rt_state = DC_SERVICE_ON;
+    humidity_info.humidity = p_stat[MEMS_SAMPLER_HUMIDITY].mean[0];
+    (void)dc_com_write(&dc_com_db, DC_COM_HUMIDITY, (void *)&humidity_info, sizeof(humidity_info));
+  }
+  if (p_stat[MEMS_SAMPLER_TEMPERATURE].nb != 0U)
+  {
+    temperature_info.rt_state    = DC_SERVICE_ON;
+    temperature_info.temperature = p_stat[MEMS_SAMPLER_TEMPERATURE].mean[0];
+    (void)dc_com_write(&dc_com_db, DC_COM_TEMPERATURE, (void *)&temperature_info, sizeof(temperature_info));
+  }
+}
+
 /**
   * @brief  StartDefaultTask function
+  * @note   The task sleeps until the next sensor read, the window end or a sensor event
   * @param  argument     task argument (unused)
   * @retval none
   */
 static void StartMemsDclibTask(void *argument)
 {
-#if (USE_SIMU_MEMS == 1)
-  static float_t pressure_increment    = SIMULATED_PRESSURE_INCREMENT;
-  static float_t humidity_increment    = SIMULATED_HUMIDITY_INCREMENT;
-  static float_t temperature_increment = SIMULATED_TEMPERATURE_INCREMENT;
-
-  static float_t simulated_pressure_value    = SIMULATED_PRESSURE_INITIAL;
-  static float_t simulated_temperature_value = SIMULATED_TEMPERATURE_INITIAL;
-  static float_t simulated_humidity_value    = SIMULATED_HUMIDITY_INITIAL;
-#endif /* USE_SIMU_MEMS */
+  uint32_t now;
+  uint32_t delay;
+  bool     sampling = false;
 
   mems_init_sensors();
+  mems_sampler_setup();
 
   /* USER CODE BEGIN StartDefaultTask */
   (void)rtosalDelay(1000U);
@@ -397,75 +653,45 @@ static void StartMemsDclibTask(void *argument)
   for (;;)
   {
 #if (USE_CMD_CONSOLE == 1)
-    if (mems_state == 0U)
+    if (mems_state != 0U)
+    {
+      /* values set by the console: a new window starts when enabled again */
+      sampling = false;
+      delay = mems_window_period;
+    }
+    else
 #endif /* USE_CMD_CONSOLE */
     {
-      /* get mems data */
-      mems_get_acc_datas();
-      mems_get_gyro_datas();
-      mems_get_magn_datas();
-
-      if (mems_get_pressure_datas() != 1U)
+      now = rtosalGetSysTimerCount();
+      if (sampling == false)
       {
-#if (USE_SIMU_MEMS == 1)
-        simulated_pressure_value += pressure_increment;
-        if (dc_pressure_info.pressure >= (float_t)SIMULATED_PRESSURE_MAX)
-        {
-          pressure_increment = (float_t) - SIMULATED_PRESSURE_INCREMENT;
-        }
-        if (dc_pressure_info.pressure <= (float_t)SIMULATED_PRESSURE_MIN)
-        {
-          pressure_increment = (float_t)SIMULATED_PRESSURE_INCREMENT;
-        }
-
-        dc_pressure_info.rt_state =  DC_SERVICE_ON;
-        dc_pressure_info.pressure = simulated_pressure_value;
-        PRINT_DBG("### Simulated PRESSURE_Value = %f\n\r", dc_pressure_info.pressure)
-        (void)dc_com_write(&dc_com_db, DC_COM_PRESSURE, (void *)&dc_pressure_info, sizeof(dc_pressure_info_t));
-#endif /* USE_SIMU_MEMS */
+        mems_sampler_config.window_ms = mems_window_period;
+        mems_sampler_init(&mems_sampler, &mems_sampler_config, mems_bus_read, NULL);
+        sampling = true;
       }
-
-      if (mems_get_humidity_datas() != 1U)
+      if (mems_sampler_config.window_ms != mems_window_period)
       {
-#if (USE_SIMU_MEMS == 1)
-        simulated_humidity_value += humidity_increment;
-        {
-          humidity_increment = -SIMULATED_HUMIDITY_INCREMENT;
-        }
-        if (dc_humidity_info.humidity <= SIMULATED_HUMIDITY_MIN)
-        {
-          humidity_increment  = SIMULATED_HUMIDITY_INCREMENT;
-        }
-
-        dc_humidity_info.rt_state =  DC_SERVICE_ON;
-        dc_humidity_info.humidity = simulated_humidity_value;
-        PRINT_DBG("### Simulated HUMIDITY Value = %f\n\r", dc_humidity_info.humidity)
-        (void)dc_com_write(&dc_com_db, DC_COM_HUMIDITY, (void *)&dc_humidity_info, sizeof(dc_humidity_info_t));
-#endif /* USE_SIMU_MEMS */
+        mems_sampler_config.window_ms = mems_window_period;
+        mems_sampler_set_window(&mems_sampler, mems_window_period);
       }
 
-      if (mems_get_temperature_datas() != 1U)
+      /* sensors signaled by an interrupt are read now */
+      for (uint8_t i = 0U; i < (uint8_t)MEMS_SAMPLER_SENSOR_NB; i++)
       {
-#if (USE_SIMU_MEMS == 1)
-        simulated_temperature_value += temperature_increment;
-        if (dc_temperature_info.temperature >= SIMULATED_TEMPERATURE_MAX)
-        {
-          temperature_increment = -SIMULATED_TEMPERATURE_INCREMENT;
-        }
-
-        if (dc_temperature_info.temperature <= SIMULATED_TEMPERATURE_MIN)
+        if (mems_event[i] != 0U)
         {
-          temperature_increment = SIMULATED_TEMPERATURE_INCREMENT;
+          mems_event[i] = 0U;
+          mems_sampler_request(&mems_sampler, (mems_sampler_sensor_t)i, now);
         }
+      }
 
-        dc_temperature_info.rt_state =  DC_SERVICE_ON;
-        dc_temperature_info.temperature = simulated_temperature_value;
-        PRINT_DBG("### Simulated TEMPERATURE Value = %f\n\r", dc_temperature_info.temperature)
-        (void)dc_com_write(&dc_com_db, DC_COM_TEMPERATURE, (void *)&dc_temperature_info, sizeof(dc_temperature_info_t));
-#endif /* USE_SIMU_MEMS */
+      delay = mems_sampler_run(&mems_sampler, now);
+      if (mems_sampler_window_get(&mems_sampler, now, &dc_mems_window_info.window) == true)
+      {
+        mems_publish(&dc_mems_window_info);
       }
     }
-    (void)rtosalDelay(mems_polling_period);
+    (void)rtosalSemaphoreAcquire(mems_event_semaphore, delay);
   }
 }
 
@@ -480,18 +706,21 @@ void dc_mems_init(void)
   static dc_accelerometer_info_t     dc_accelerometer_info;
   static dc_gyroscope_info_t         dc_gyroscope_info;
   static dc_magnetometer_info_t      dc_magnetometer_info;
+  static dc_mems_window_info_t       dc_mems_window_entry;
 
 #if (USE_CMD_CONSOLE == 1)
   mems_state = 0U;
 #endif /* USE_CMD_CONSOLE */
 
-  mems_polling_period = MEMS_POLLING_PERIOD;
+  mems_window_period = DC_MEMS_WINDOW_PERIOD;
   (void)memset((void *)&dc_pressure_info,      0, sizeof(dc_pressure_info_t));
   (void)memset((void *)&dc_humidity_info,      0, sizeof(dc_humidity_info_t));
   (void)memset((void *)&dc_temperature_info,   0, sizeof(dc_temperature_info_t));
   (void)memset((void *)&dc_accelerometer_info, 0, sizeof(dc_accelerometer_info_t));
   (void)memset((void *)&dc_gyroscope_info,     0, sizeof(dc_gyroscope_info_t));
   (void)memset((void *)&dc_magnetometer_info,  0, sizeof(dc_magnetometer_info_t));
+  (void)memset((void *)&dc_mems_window_entry,  0, sizeof(dc_mems_window_info_t));
+  (void)memset((void *)&dc_mems_window_info,   0, sizeof(dc_mems_window_info_t));
 
   DC_COM_PRESSURE       = dc_com_register_serv(&dc_com_db, (void *)&dc_pressure_info,
                                                (uint16_t)sizeof(dc_pressure_info_t));
@@ -505,6 +734,8 @@ void dc_mems_init(void)
                                                (uint16_t)sizeof(dc_gyroscope_info_t));
   DC_COM_MAGNETOMETER   = dc_com_register_serv(&dc_com_db, (void *)&dc_magnetometer_info,
                                                (uint16_t)sizeof(dc_magnetometer_info_t));
+  DC_COM_MEMS_WINDOW    = dc_com_register_serv(&dc_com_db, (void *)&dc_mems_window_entry,
+                                               (uint16_t)sizeof(dc_mems_window_info_t));
 }
 
 /**
@@ -521,6 +752,14 @@ void dc_mems_start(void)
   CMD_Declare(mems_cmd_label, mems_cmd, (uint8_t *)"mems management");
 #endif /* USE_CMD_CONSOLE */
 
+  mems_event_semaphore = rtosalSemaphoreNew((const rtosal_char_t *)"MEMS_SEM_EVENT", 1U);
+  if (mems_event_semaphore == NULL)
+  {
+    ERROR_Handler(DBG_CHAN_MAIN, 12, ERROR_FATAL);
+  }
+  /* init semaphore: taken until an event */
+  (void)rtosalSemaphoreAcquire(mems_event_semaphore, 0U);
+
   memsDclibTaskTaskId = rtosalThreadNew((const rtosal_char_t *)"memsDclibTask", (os_pthread)StartMemsDclibTask,
                                         DC_MEMS_THREAD_PRIO, USED_DC_MEMS_THREAD_STACK_SIZE, NULL);
   if (memsDclibTaskTaskId == NULL)
@@ -535,6 +774,21 @@ void dc_mems_start(void)
   }
 }
 
+/**
+  * @brief  Signal a sensor event - data ready or FIFO watermark
+  * @note   May be called from an interrupt: the sensor is read by the mems task
+  * @param  sensor - sensor to read
+  * @retval none
+  */
+void dc_mems_sensor_event(mems_sampler_sensor_t sensor)
+{
+  if ((sensor < MEMS_SAMPLER_SENSOR_NB) && (mems_event_semaphore != NULL))
+  {
+    mems_event[sensor] = 1U;
+    (void)rtosalSemaphoreRelease(mems_event_semaphore);
+  }
+}
+
 static void mems_init_sensors(void)
 {
 #if (USE_DC_MEMS == 1)
@@ -657,17 +911,14 @@ static void mems_init_sensors(void)
 
 /**
   * @brief  accelerometer data managememnt
-  * @param  none
-  * @retval none
+  * @param  p_value - sample read (mg)
+  * @retval uint16_t - number of samples read (0: sensor not available)
   */
-static void mems_get_acc_datas(void)
+static uint16_t mems_get_acc_datas(mems_sampler_value_t *p_value)
 {
+  uint16_t nb = 0U;
 #if (USE_DC_MEMS == 1)
-
-	PRINT_INFO("USE_DC_MEMS\n\r");
 #if defined (USE_STM32L496G_DISCO) /* USE X-NUCLEO-IKS01A2 MEMS */
-	PRINT_INFO("USE_STM32L496G_DISCO\n\r");
-  dc_accelerometer_info_t   accelerometer_info;
   static SensorAxes_t ACC_Value;                /*!< Acceleration Value */
   uint8_t status = 0U;
 
@@ -678,16 +929,12 @@ static void mems_get_acc_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### ACC_Value: X=%ld - Y=%ld - Z=%ld\n\r", ACC_Value.AXIS_X, ACC_Value.AXIS_Y, ACC_Value.AXIS_Z)
 
-    accelerometer_info.rt_state              =  DC_SERVICE_ON;
-    accelerometer_info.accelerometer.AXIS_X  =  ACC_Value.AXIS_X;
-    accelerometer_info.accelerometer.AXIS_Y  =  ACC_Value.AXIS_Y;
-    accelerometer_info.accelerometer.AXIS_Z  =  ACC_Value.AXIS_Z;
-    (void)dc_com_write(&dc_com_db, DC_COM_ACCELEROMETER, (void *)&accelerometer_info, sizeof(accelerometer_info));
+    p_value->axis[0] = (float_t)ACC_Value.AXIS_X;
+    p_value->axis[1] = (float_t)ACC_Value.AXIS_Y;
+    p_value->axis[2] = (float_t)ACC_Value.AXIS_Z;
+    nb = 1U;
   }
 #elif defined (USE_STM32L475E_IOT01) /* USE B-L475E-IOT1 MEMS */
-
-  PRINT_INFO("USE_STM32L475E_IOT01\n\r");
-  dc_accelerometer_info_t   accelerometer_info;
   if (mems_init_status & FLAG_MEMS_ACC)
   {
     BSP_ACCELERO_AccGetXYZ(ACC_Value);
@@ -695,16 +942,13 @@ static void mems_get_acc_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### ACC_Value: X=%d - Y=%d - Z=%d\n\r", ACC_Value[0], ACC_Value[1], ACC_Value[2])
 
-    accelerometer_info.rt_state              =  DC_SERVICE_ON;
-    accelerometer_info.accelerometer.AXIS_X  =  ACC_Value[0];
-    accelerometer_info.accelerometer.AXIS_Y  =  ACC_Value[1];
-    accelerometer_info.accelerometer.AXIS_Z  =  ACC_Value[2];
-    dc_com_write(&dc_com_db, DC_COM_ACCELEROMETER, (void *)&accelerometer_info, sizeof(accelerometer_info));
+    p_value->axis[0] = (float_t)ACC_Value[0];
+    p_value->axis[1] = (float_t)ACC_Value[1];
+    p_value->axis[2] = (float_t)ACC_Value[2];
+    nb = 1U;
   }
 #elif defined (USE_STEVAL_STWIN) /* USE STEVAL-STWINKT1 */
-  PRINT_INFO("USE_STEVAL_STWIN\n\r");
   static BSP_MOTION_SENSOR_Axes_t ACC_Value;    /*!< Acceleration Value */
-  dc_accelerometer_info_t accelerometer_info;
 
   if (mems_init_status & FLAG_MEMS_ACC)
   {
@@ -713,26 +957,26 @@ static void mems_get_acc_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### ACC_Value: X=%ld - Y=%ld - Z=%ld\n\r", ACC_Value.x, ACC_Value.y, ACC_Value.z)
 
-    accelerometer_info.rt_state              =  DC_SERVICE_ON;
-    accelerometer_info.accelerometer.AXIS_X  =  ACC_Value.x;
-    accelerometer_info.accelerometer.AXIS_Y  =  ACC_Value.y;
-    accelerometer_info.accelerometer.AXIS_Z  =  ACC_Value.z;
-    (void)dc_com_write(&dc_com_db, DC_COM_ACCELEROMETER, (void *)&accelerometer_info, sizeof(accelerometer_info));
+    p_value->axis[0] = (float_t)ACC_Value.x;
+    p_value->axis[1] = (float_t)ACC_Value.y;
+    p_value->axis[2] = (float_t)ACC_Value.z;
+    nb = 1U;
   }
 #endif /* USE_STM32L475E_IOT01 */
 #endif /* USE_DC_MEMS */
+  return (nb);
 }
 
 /**
   * @brief  gyroscope data managememnt
-  * @param  none
-  * @retval none
+  * @param  p_value - sample read (mdps)
+  * @retval uint16_t - number of samples read (0: sensor not available)
   */
-static void mems_get_gyro_datas(void)
+static uint16_t mems_get_gyro_datas(mems_sampler_value_t *p_value)
 {
+  uint16_t nb = 0U;
 #if (USE_DC_MEMS == 1)
 #if defined (USE_STM32L496G_DISCO) /* USE X-NUCLEO-IKS01A2 MEMS */
-  dc_gyroscope_info_t       gyroscope_info;
   static SensorAxes_t GYR_Value;                /*!< Gyroscope Value */
   uint8_t status = 0U;
 
@@ -743,14 +987,12 @@ static void mems_get_gyro_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### GYR_Value: X=%ld - Y=%ld - Z=%ld\n\r", GYR_Value.AXIS_X, GYR_Value.AXIS_Y, GYR_Value.AXIS_Z)
 
-    gyroscope_info.rt_state          =  DC_SERVICE_ON;
-    gyroscope_info.gyroscope.AXIS_X  =  GYR_Value.AXIS_X;
-    gyroscope_info.gyroscope.AXIS_Y  =  GYR_Value.AXIS_Y;
-    gyroscope_info.gyroscope.AXIS_Z  =  GYR_Value.AXIS_Z;
-    (void)dc_com_write(&dc_com_db, DC_COM_GYROSCOPE, (void *)&gyroscope_info, sizeof(gyroscope_info));
+    p_value->axis[0] = (float_t)GYR_Value.AXIS_X;
+    p_value->axis[1] = (float_t)GYR_Value.AXIS_Y;
+    p_value->axis[2] = (float_t)GYR_Value.AXIS_Z;
+    nb = 1U;
   }
 #elif defined (USE_STM32L475E_IOT01) /* USE B-L475E-IOT1 MEMS */
-  dc_gyroscope_info_t       gyroscope_info;
   if (mems_init_status & FLAG_MEMS_GYRO)
   {
     BSP_GYRO_GetXYZ(GYR_Value);
@@ -761,15 +1003,13 @@ static void mems_get_gyro_datas(void)
               (int32_t) GYR_Value[1],
               (int32_t) GYR_Value[2]);
 
-    gyroscope_info.rt_state          =  DC_SERVICE_ON;
-    gyroscope_info.gyroscope.AXIS_X  = (int32_t) GYR_Value[0];
-    gyroscope_info.gyroscope.AXIS_Y  = (int32_t) GYR_Value[1];
-    gyroscope_info.gyroscope.AXIS_Z  = (int32_t) GYR_Value[2];
-    dc_com_write(&dc_com_db, DC_COM_GYROSCOPE, (void *)&gyroscope_info, sizeof(gyroscope_info));
+    p_value->axis[0] = GYR_Value[0];
+    p_value->axis[1] = GYR_Value[1];
+    p_value->axis[2] = GYR_Value[2];
+    nb = 1U;
   }
 #elif defined (USE_STEVAL_STWIN) /* USE STEVAL-STWINKT1 */
   static BSP_MOTION_SENSOR_Axes_t GYR_Value;    /*!< Gyroscope Value */
-  dc_gyroscope_info_t gyroscope_info;
 
   if (mems_init_status & FLAG_MEMS_GYRO)
   {
@@ -778,26 +1018,26 @@ static void mems_get_gyro_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### GYR_Value: X=%ld - Y=%ld - Z=%ld\n\r", GYR_Value.x, GYR_Value.y, GYR_Value.z)
 
-    gyroscope_info.rt_state          =  DC_SERVICE_ON;
-    gyroscope_info.gyroscope.AXIS_X  =  GYR_Value.x;
-    gyroscope_info.gyroscope.AXIS_Y  =  GYR_Value.y;
-    gyroscope_info.gyroscope.AXIS_Z  =  GYR_Value.z;
-    (void)dc_com_write(&dc_com_db, DC_COM_GYROSCOPE, (void *)&gyroscope_info, sizeof(gyroscope_info));
+    p_value->axis[0] = (float_t)GYR_Value.x;
+    p_value->axis[1] = (float_t)GYR_Value.y;
+    p_value->axis[2] = (float_t)GYR_Value.z;
+    nb = 1U;
   }
 #endif /* USE_STM32L475E_IOT01 */
 #endif /* USE_DC_MEMS */
+  return (nb);
 }
 
 /**
   * @brief  magnetometer data managememnt
-  * @param  none
-  * @retval none
+  * @param  p_value - sample read (mgauss)
+  * @retval uint16_t - number of samples read (0: sensor not available)
   */
-static void mems_get_magn_datas(void)
+static uint16_t mems_get_magn_datas(mems_sampler_value_t *p_value)
 {
+  uint16_t nb = 0U;
 #if (USE_DC_MEMS == 1)
 #if defined (USE_STM32L496G_DISCO) /* USE X-NUCLEO-IKS01A2 MEMS */
-  dc_magnetometer_info_t    magnetometer_info;
   static SensorAxes_t MAG_Value;                /*!< Magnetometer Value */
   uint8_t status = 0U;
 
@@ -808,14 +1048,12 @@ static void mems_get_magn_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### MAG_Value: X=%ld - Y=%ld - Z=%ld\n\r", MAG_Value.AXIS_X, MAG_Value.AXIS_Y, MAG_Value.AXIS_Z)
 
-    magnetometer_info.rt_state             =  DC_SERVICE_ON;
-    magnetometer_info.magnetometer.AXIS_X  =  MAG_Value.AXIS_X;
-    magnetometer_info.magnetometer.AXIS_Y  =  MAG_Value.AXIS_Y;
-    magnetometer_info.magnetometer.AXIS_Z  =  MAG_Value.AXIS_Z;
-    (void)dc_com_write(&dc_com_db, DC_COM_MAGNETOMETER, (void *)&magnetometer_info, sizeof(magnetometer_info));
+    p_value->axis[0] = (float_t)MAG_Value.AXIS_X;
+    p_value->axis[1] = (float_t)MAG_Value.AXIS_Y;
+    p_value->axis[2] = (float_t)MAG_Value.AXIS_Z;
+    nb = 1U;
   }
 #elif defined (USE_STM32L475E_IOT01) /* USE B-L475E-IOT1 MEMS */
-  dc_magnetometer_info_t    magnetometer_info;
   if (mems_init_status & FLAG_MEMS_MAGN)
   {
     BSP_MAGNETO_GetXYZ(MAG_Value);
@@ -823,15 +1061,13 @@ static void mems_get_magn_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### MAG_Value: X=%d - Y=%d - Z=%d\n\r", MAG_Value[0], MAG_Value[1], MAG_Value[2])
 
-    magnetometer_info.rt_state             =  DC_SERVICE_ON;
-    magnetometer_info.magnetometer.AXIS_X  =  MAG_Value[0];
-    magnetometer_info.magnetometer.AXIS_Y  =  MAG_Value[1];
-    magnetometer_info.magnetometer.AXIS_Z  =  MAG_Value[2];
-    dc_com_write(&dc_com_db, DC_COM_MAGNETOMETER, (void *)&magnetometer_info, sizeof(magnetometer_info));
+    p_value->axis[0] = (float_t)MAG_Value[0];
+    p_value->axis[1] = (float_t)MAG_Value[1];
+    p_value->axis[2] = (float_t)MAG_Value[2];
+    nb = 1U;
   }
 #elif defined (USE_STEVAL_STWIN) /* USE STEVAL-STWINKT1 */
   static BSP_MOTION_SENSOR_Axes_t MAG_Value;    /*!< Magnetometer Value */
-  dc_magnetometer_info_t magnetometer_info;
 
   if (mems_init_status & FLAG_MEMS_MAGN)
   {
@@ -840,28 +1076,27 @@ static void mems_get_magn_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### MAG_Value: X=%ld - Y=%ld - Z=%ld\n\r", MAG_Value.x, MAG_Value.y, MAG_Value.z)
 
-    magnetometer_info.rt_state             =  DC_SERVICE_ON;
-    magnetometer_info.magnetometer.AXIS_X  =  MAG_Value.x;
-    magnetometer_info.magnetometer.AXIS_Y  =  MAG_Value.y;
-    magnetometer_info.magnetometer.AXIS_Z  =  MAG_Value.z;
-    (void)dc_com_write(&dc_com_db, DC_COM_MAGNETOMETER, (void *)&magnetometer_info, sizeof(magnetometer_info));
+    p_value->axis[0] = (float_t)MAG_Value.x;
+    p_value->axis[1] = (float_t)MAG_Value.y;
+    p_value->axis[2] = (float_t)MAG_Value.z;
+    nb = 1U;
   }
 #endif /* USE_STM32L475E_IOT01 */
 #endif /* USE_DC_MEMS */
+  return (nb);
 }
 
 /**
   * @brief  pressure data managememnt
-  * @param  none
-  * @retval   function result (0:OK)
+  * @param  p_value - sample read (hPa in axis[0])
+  * @retval uint16_t - number of samples read (0: sensor not available)
   */
-static uint8_t mems_get_pressure_datas(void)
+static uint16_t mems_get_pressure_datas(mems_sampler_value_t *p_value)
 {
-  uint8_t success = 0U;
+  uint16_t nb = 0U;
 #if (USE_DC_MEMS == 1)
 #if defined (USE_STM32L496G_DISCO) /* USE X-NUCLEO-IKS01A2 MEMS */
   static float_t PRESSURE_Value; /*!< Pressure Value */
-  dc_pressure_info_t        pressure_info;
   uint8_t status = 0U;
 
   if ((BSP_PRESSURE_IsInitialized(PRESSURE_handle, &status) == COMPONENT_OK) && (status == 1U))
@@ -871,14 +1106,11 @@ static uint8_t mems_get_pressure_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### PRESSURE_Value = %f\n\r", PRESSURE_Value)
 
-    pressure_info.rt_state         =  DC_SERVICE_ON;
-    pressure_info.pressure         =  PRESSURE_Value;
-    (void)dc_com_write(&dc_com_db, DC_COM_PRESSURE, (void *)&pressure_info, sizeof(pressure_info));
-    success = 1U;
+    p_value->axis[0] = PRESSURE_Value;
+    nb = 1U;
   }
 #elif defined (USE_STM32L475E_IOT01)|| defined (USE_STM32L462E_CELL01) /* USE B-L475E-IOT1 MEMS */
   static float_t PRESSURE_Value; /*!< Pressure Value */
-  dc_pressure_info_t        pressure_info;
   if (mems_init_status & FLAG_MEMS_PRESSURE)
   {
     PRESSURE_Value = BSP_PSENSOR_ReadPressure();
@@ -886,14 +1118,11 @@ static uint8_t mems_get_pressure_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### PRESSURE_Value = %f\n\r", PRESSURE_Value)
 
-    pressure_info.rt_state         =  DC_SERVICE_ON;
-    pressure_info.pressure         =  PRESSURE_Value;
-    dc_com_write(&dc_com_db, DC_COM_PRESSURE, (void *)&pressure_info, sizeof(pressure_info));
-    success = 1U;
+    p_value->axis[0] = PRESSURE_Value;
+    nb = 1U;
   }
 #elif defined (USE_STEVAL_STWIN) /* USE STEVAL-STWINKT1 */
   static float_t PRESSURE_Value;    /*!< Pressure Value */
-  dc_pressure_info_t pressure_info;
 
   if (mems_init_status & FLAG_MEMS_PRESSURE)
   {
@@ -902,28 +1131,25 @@ static uint8_t mems_get_pressure_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### PRESSURE_Value = %f\n\r", PRESSURE_Value)
 
-    pressure_info.rt_state         =  DC_SERVICE_ON;
-    pressure_info.pressure      =  PRESSURE_Value;
-    (void)dc_com_write(&dc_com_db, DC_COM_PRESSURE, (void *)&pressure_info, sizeof(pressure_info));
-    success = 1U;
+    p_value->axis[0] = PRESSURE_Value;
+    nb = 1U;
   }
 #endif /* USE_STM32L475E_IOT01 */
 #endif /* USE_DC_MEMS */
-  return (success);
+  return (nb);
 }
 
 /**
   * @brief  humidity data managememnt
-  * @param  none
-  * @retval   function result (0:OK)
+  * @param  p_value - sample read (% in axis[0])
+  * @retval uint16_t - number of samples read (0: sensor not available)
   */
-static uint8_t mems_get_humidity_datas(void)
+static uint16_t mems_get_humidity_datas(mems_sampler_value_t *p_value)
 {
-  uint8_t success = 0U;
+  uint16_t nb = 0U;
 #if (USE_DC_MEMS == 1)
 #if defined (USE_STM32L496G_DISCO) /* USE X-NUCLEO-IKS01A2 MEMS */
   static float_t HUMIDITY_Value;    /*!< Humidity Value */
-  dc_humidity_info_t        humidity_info;
   uint8_t status = 0U;
   if ((BSP_HUMIDITY_IsInitialized(HUMIDITY_handle, &status) == COMPONENT_OK) && (status == 1U))
   {
@@ -932,14 +1158,11 @@ static uint8_t mems_get_humidity_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### HUMIDITY_Value = %f\n\r", HUMIDITY_Value)
 
-    humidity_info.rt_state         =  DC_SERVICE_ON;
-    humidity_info.humidity         =  HUMIDITY_Value;
-    (void)dc_com_write(&dc_com_db, DC_COM_HUMIDITY, (void *)&humidity_info, sizeof(humidity_info));
-    success = 1U;
+    p_value->axis[0] = HUMIDITY_Value;
+    nb = 1U;
   }
 #elif defined (USE_STM32L475E_IOT01) || defined (USE_STM32L462E_CELL01) /* USE B-L475E-IOT1 MEMS */
   static float_t HUMIDITY_Value;    /*!< Humidity Value */
-  dc_humidity_info_t        humidity_info;
   if (mems_init_status & FLAG_MEMS_HUMIDTY)
   {
     HUMIDITY_Value = BSP_HSENSOR_ReadHumidity();
@@ -947,14 +1170,11 @@ static uint8_t mems_get_humidity_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### HUMIDITY_Value = %f\n\r", HUMIDITY_Value)
 
-    humidity_info.rt_state         =  DC_SERVICE_ON;
-    humidity_info.humidity         =  HUMIDITY_Value;
-    dc_com_write(&dc_com_db, DC_COM_HUMIDITY, (void *)&humidity_info, sizeof(humidity_info));
-    success = 1U;
+    p_value->axis[0] = HUMIDITY_Value;
+    nb = 1U;
   }
 #elif defined (USE_STEVAL_STWIN) /* USE STEVAL-STWINKT1 */
   static float_t HUMIDITY_Value;    /*!< Humidity Value */
-  dc_humidity_info_t humidity_info;
 
   if (mems_init_status & FLAG_MEMS_HUMIDITY)
   {
@@ -963,29 +1183,25 @@ static uint8_t mems_get_humidity_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### HUMIDITY_Value = %f\n\r", HUMIDITY_Value)
 
-    humidity_info.rt_state         =  DC_SERVICE_ON;
-    humidity_info.humidity      =  HUMIDITY_Value;
-    (void)dc_com_write(&dc_com_db, DC_COM_HUMIDITY, (void *)&humidity_info, sizeof(humidity_info));
-    success = 1U;
+    p_value->axis[0] = HUMIDITY_Value;
+    nb = 1U;
   }
 #endif /* USE_STM32L475E_IOT01 */
 #endif /* USE_DC_MEMS */
-  return (success);
+  return (nb);
 }
 
 /**
   * @brief  temperature data managememnt
-  * @param  none
-  * @retval   function result (0:OK)
+  * @param  p_value - sample read (degC in axis[0])
+  * @retval uint16_t - number of samples read (0: sensor not available)
   */
-static uint8_t mems_get_temperature_datas(void)
+static uint16_t mems_get_temperature_datas(mems_sampler_value_t *p_value)
 {
-  uint8_t success;
-  success = 0U;
+  uint16_t nb = 0U;
 #if (USE_DC_MEMS == 1)
 #if defined (USE_STM32L496G_DISCO) /* USE X-NUCLEO-IKS01A2 MEMS */
   static float_t TEMPERATURE_Value;    /*!< Temperature Value */
-  dc_temperature_info_t     temperature_info;
   uint8_t status = 0U;
 
   if ((BSP_TEMPERATURE_IsInitialized(TEMPERATURE_handle, &status) == COMPONENT_OK) && (status == 1U))
@@ -995,14 +1211,11 @@ static uint8_t mems_get_temperature_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### TEMPERATURE_Value = %f\n\r", TEMPERATURE_Value)
 
-    temperature_info.rt_state         =  DC_SERVICE_ON;
-    temperature_info.temperature      =  TEMPERATURE_Value;
-    (void)dc_com_write(&dc_com_db, DC_COM_TEMPERATURE, (void *)&temperature_info, sizeof(temperature_info));
-    success = 1U;
+    p_value->axis[0] = TEMPERATURE_Value;
+    nb = 1U;
   }
 #elif defined (USE_STM32L475E_IOT01) || defined (USE_STM32L462E_CELL01)/* USE B-L475E-IOT1 MEMS */
   static float_t TEMPERATURE_Value;    /*!< Temperature Value */
-  dc_temperature_info_t     temperature_info;
   if (mems_init_status & FLAG_MEMS_TEMPERATURE)
   {
     TEMPERATURE_Value = BSP_TSENSOR_ReadTemp();
@@ -1010,14 +1223,11 @@ static uint8_t mems_get_temperature_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### TEMPERATURE_Value = %f\n\r", TEMPERATURE_Value)
 
-    temperature_info.rt_state         =  DC_SERVICE_ON;
-    temperature_info.temperature      =  TEMPERATURE_Value;
-    dc_com_write(&dc_com_db, DC_COM_TEMPERATURE, (void *)&temperature_info, sizeof(temperature_info));
-    success = 1U;
+    p_value->axis[0] = TEMPERATURE_Value;
+    nb = 1U;
   }
 #elif defined (USE_STEVAL_STWIN) /* USE STEVAL-STWINKT1 */
   static float_t TEMPERATURE_Value;    /*!< Temperature Value */
-  dc_temperature_info_t temperature_info;
 
   if (mems_init_status & FLAG_MEMS_TEMPERATURE)
   {
@@ -1026,14 +1236,12 @@ static uint8_t mems_get_temperature_datas(void)
     /* DEBUG sensor values */
     PRINT_DBG("### TEMPERATURE_Value = %f\n\r", TEMPERATURE_Value)
 
-    temperature_info.rt_state         =  DC_SERVICE_ON;
-    temperature_info.temperature      =  TEMPERATURE_Value;
-    (void)dc_com_write(&dc_com_db, DC_COM_TEMPERATURE, (void *)&temperature_info, sizeof(temperature_info));
-    success = 1U;
+    p_value->axis[0] = TEMPERATURE_Value;
+    nb = 1U;
   }
 #endif /* USE_STM32L475E_IOT01 */
 #endif /* USE_DC_MEMS */
-  return (success);
+  return (nb);
 }
 
 #endif  /*USE_DC_MEMS == 1) || (USE_SIMU_MEMS == 1) */
@@ -0,0 +1,417 @@
+/**
+  ******************************************************************************
+  * @file    dc_mems_sampler.c
+  * @author  artworkTrackingMAP
+  * @brief   This file contains the sampling and aggregation of mems data:
+  *          per sensor read period, window statistics and shock detection
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "dc_mems_sampler.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private defines -----------------------------------------------------------*/
+/* Delay returned by mems_sampler_run() when nothing is configured */
+#define MEMS_SAMPLER_IDLE_DELAY           (10000U)
+
+/* Simulated bus: environmental values are triangle waves */
+#define SIMULATED_PRESSURE_INCREMENT      (1.0f)
+#define SIMULATED_PRESSURE_INITIAL        (1000.0f)
+#define SIMULATED_PRESSURE_DELTA          (7.0f)
+
+#define SIMULATED_HUMIDITY_INCREMENT      (1.0f)
+#define SIMULATED_HUMIDITY_INITIAL        (85.0f)
+#define SIMULATED_HUMIDITY_DELTA          (10.0f)
+
+#define SIMULATED_TEMPERATURE_INCREMENT   (0.8f)
+#define SIMULATED_TEMPERATURE_INITIAL     (40.0f)
+#define SIMULATED_TEMPERATURE_DELTA       (7.0f)
+
+/* Simulated motion: small periodic noise around the rest position */
+#define SIMULATED_MOTION_NOISE            (4U)
+
+/* Private macros ------------------------------------------------------------*/
+/* Time comparison robust to the wrap of the ms counter */
+#define MEMS_SAMPLER_REACHED(now, date)   ((int32_t)((uint32_t)(now) - (uint32_t)(date)) >= 0)
+
+/* Private variables ---------------------------------------------------------*/
+static const float_t simu_env_initial[3] =
+{
+  SIMULATED_PRESSURE_INITIAL, SIMULATED_HUMIDITY_INITIAL, SIMULATED_TEMPERATURE_INITIAL
+};
+static const float_t simu_env_increment[3] =
+{
+  SIMULATED_PRESSURE_INCREMENT, SIMULATED_HUMIDITY_INCREMENT, SIMULATED_TEMPERATURE_INCREMENT
+};
+static const float_t simu_env_delta[3] =
+{
+  SIMULATED_PRESSURE_DELTA, SIMULATED_HUMIDITY_DELTA, SIMULATED_TEMPERATURE_DELTA
+};
+
+/* Global variables ----------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void mems_sampler_window_reset(mems_sampler_t *p_sampler, uint32_t now_ms);
+static void mems_sampler_add(mems_sampler_t *p_sampler, mems_sampler_sensor_t sensor,
+                             const mems_sampler_value_t *p_value, uint32_t now_ms);
+static uint8_t mems_sampler_axis_nb(mems_sampler_sensor_t sensor);
+static bool mems_sampler_shock_pending(const mems_sampler_t *p_sampler);
+
+/* Private function Definition -----------------------------------------------*/
+/**
+  * @brief  Number of axes of a sensor
+  * @param  sensor - sensor
+  * @retval uint8_t - 3 for motion sensors, 1 for environmental sensors
+  */
+static uint8_t mems_sampler_axis_nb(mems_sampler_sensor_t sensor)
+{
+  return ((sensor <= MEMS_SAMPLER_MAGNETO) ? 3U : 1U);
+}
+
+/**
+  * @brief  Is the current window to end on a shock
+  * @param  p_sampler - sampler
+  * @retval bool - true: a shock is detected and shock_ends_window is set
+  */
+static bool mems_sampler_shock_pending(const mems_sampler_t *p_sampler)
+{
+  return ((p_sampler->config.shock_ends_window == true) && (p_sampler->window.shock_nb != 0U));
+}
+
+/**
+  * @brief  Start a new window
+  * @param  p_sampler - sampler
+  * @param  now_ms    - window start
+  * @retval -
+  */
+static void mems_sampler_window_reset(mems_sampler_t *p_sampler, uint32_t now_ms)
+{
+  (void)memset((void *)&p_sampler->window, 0, sizeof(mems_sampler_window_t));
+  (void)memset((void *)&p_sampler->sum[0][0], 0, sizeof(p_sampler->sum));
+  p_sampler->window.start_ms = now_ms;
+}
+
+/**
+  * @brief  Aggregate a sample in the current window
+  * @param  p_sampler - sampler
+  * @param  sensor    - sensor of the sample
+  * @param  p_value   - sample
+  * @param  now_ms    - current time
+  * @retval -
+  */
+static void mems_sampler_add(mems_sampler_t *p_sampler, mems_sampler_sensor_t sensor,
+                             const mems_sampler_value_t *p_value, uint32_t now_ms)
+{
+  mems_sampler_stat_t *p_stat = &p_sampler->window.stat[sensor];
+  uint8_t axis_nb = mems_sampler_axis_nb(sensor);
+  float_t norm;
+  float_t shock;
+
+  for (uint8_t i = 0U; i < axis_nb; i++)
+  {
+    if ((p_stat->nb == 0U) || (p_value->axis[i] < p_stat->min[i]))
+    {
+      p_stat->min[i] = p_value->axis[i];
+    }
+    if ((p_stat->nb == 0U) || (p_value->axis[i] > p_stat->max[i]))
+    {
+      p_stat->max[i] = p_value->axis[i];
+    }
+    p_stat->last[i] = p_value->axis[i];
+    p_sampler->sum[sensor][i] += p_value->axis[i];
+  }
+  if (p_stat->nb < UINT16_MAX)
+  {
+    p_stat->nb++;
+  }
+
+  if ((sensor == MEMS_SAMPLER_ACCELERO) && (p_sampler->config.shock_threshold_mg > 0.0f))
+  {
+    norm = sqrtf((p_value->axis[0] * p_value->axis[0]) + (p_value->axis[1] * p_value->axis[1])
+                 + (p_value->axis[2] * p_value->axis[2]));
+    shock = fabsf(norm - MEMS_SAMPLER_GRAVITY_MG);
+    if (shock > p_sampler->config.shock_threshold_mg)
+    {
+      if (p_sampler->window.shock_nb == 0U)
+      {
+        p_sampler->window.shock_first_ms = now_ms - p_sampler->window.start_ms;
+      }
+      if (p_sampler->window.shock_nb < UINT16_MAX)
+      {
+        p_sampler->window.shock_nb++;
+      }
+      if (shock > p_sampler->window.shock_max_mg)
+      {
+        p_sampler->window.shock_max_mg = shock;
+      }
+    }
+  }
+}
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief  Initialize a sampler
+  * @param  p_sampler     - sampler
+  * @param  p_config      - configuration (copied)
+  * @param  p_read        - bus read function
+  * @param  p_bus_context - context given to p_read
+  * @retval -
+  */
+void mems_sampler_init(mems_sampler_t *p_sampler, const mems_sampler_config_t *p_config,
+                       mems_sampler_read_t p_read, void *p_bus_context)
+{
+  (void)memset((void *)p_sampler, 0, sizeof(mems_sampler_t));
+  p_sampler->config = *p_config;
+  p_sampler->p_read = p_read;
+  p_sampler->p_bus_context = p_bus_context;
+  p_sampler->started = false;
+}
+
+/**
+  * @brief  Read the sensors due and aggregate their samples
+  * @note   A sensor late by more than its period is read once: no catch-up burst
+  * @param  p_sampler - sampler
+  * @param  now_ms    - current time in ms
+  * @retval uint32_t  - delay in ms until the next sensor read or the window end
+  */
+uint32_t mems_sampler_run(mems_sampler_t *p_sampler, uint32_t now_ms)
+{
+  uint32_t delay;
+  uint32_t sensor_delay;
+  uint16_t nb;
+  uint16_t max_nb;
+  mems_sampler_sensor_t sensor;
+
+  if (p_sampler->started == false)
+  {
+    p_sampler->started = true;
+    mems_sampler_window_reset(p_sampler, now_ms);
+    for (uint8_t i = 0U; i < (uint8_t)MEMS_SAMPLER_SENSOR_NB; i++)
+    {
+      p_sampler->next_ms[i] = now_ms;
+    }
+  }
+
+  /* Window end */
+  if (p_sampler->config.window_ms != 0U)
+  {
+    delay = p_sampler->window.start_ms + p_sampler->config.window_ms;
+    delay = (MEMS_SAMPLER_REACHED(now_ms, delay)) ? 0U : (delay - now_ms);
+  }
+  else
+  {
+    delay = MEMS_SAMPLER_IDLE_DELAY;
+  }
+  /* Window end by a shock seen before shock_window_min_ms */
+  if (mems_sampler_shock_pending(p_sampler) == true)
+  {
+    sensor_delay = p_sampler->window.start_ms + p_sampler->config.shock_window_min_ms;
+    sensor_delay = (MEMS_SAMPLER_REACHED(now_ms, sensor_delay)) ? 0U : (sensor_delay - now_ms);
+    if (sensor_delay < delay)
+    {
+      delay = sensor_delay;
+    }
+  }
+
+  for (uint8_t i = 0U; i < (uint8_t)MEMS_SAMPLER_SENSOR_NB; i++)
+  {
+    sensor = (mems_sampler_sensor_t)i;
+    if (p_sampler->config.period_ms[i] != 0U)
+    {
+      if (MEMS_SAMPLER_REACHED(now_ms, p_sampler->next_ms[i]))
+      {
+        max_nb = p_sampler->config.batch_nb[i];
+        if (max_nb == 0U)
+        {
+          max_nb = 1U;
+        }
+        else if (max_nb > MEMS_SAMPLER_BATCH_MAX)
+        {
+          max_nb = (uint16_t)MEMS_SAMPLER_BATCH_MAX;
+        }
+        else
+        {
+          /* Nothing to do */
+        }
+        nb = p_sampler->p_read(p_sampler->p_bus_context, sensor, &p_sampler->values[0], max_nb);
+        if (nb > max_nb)
+        {
+          nb = max_nb;
+        }
+        if (p_sampler->window.read_nb < UINT16_MAX)
+        {
+          p_sampler->window.read_nb++;
+        }
+        for (uint16_t j = 0U; j < nb; j++)
+        {
+          mems_sampler_add(p_sampler, sensor, &p_sampler->values[j], now_ms);
+        }
+        p_sampler->next_ms[i] = now_ms + p_sampler->config.period_ms[i];
+      }
+      sensor_delay = p_sampler->next_ms[i] - now_ms;
+      if (sensor_delay < delay)
+      {
+        delay = sensor_delay;
+      }
+    }
+  }
+
+  return (delay);
+}
+
+/**
+  * @brief  Get the aggregates of the current window if it is ended
+  * @note   The window is ended after window_ms, or at a shock if shock_ends_window is set
+  *         and the window has lasted shock_window_min_ms. A new window starts at now_ms.
+  * @param  p_sampler - sampler
+  * @param  now_ms    - current time in ms
+  * @param  p_window  - aggregates of the ended window
+  * @retval bool      - true: window ended and p_window filled / false: window not ended
+  */
+bool mems_sampler_window_get(mems_sampler_t *p_sampler, uint32_t now_ms, mems_sampler_window_t *p_window)
+{
+  bool result = false;
+  mems_sampler_stat_t *p_stat;
+
+  if (p_sampler->started == true)
+  {
+    if (((p_sampler->config.window_ms != 0U)
+         && (MEMS_SAMPLER_REACHED(now_ms, p_sampler->window.start_ms + p_sampler->config.window_ms)))
+        || ((mems_sampler_shock_pending(p_sampler) == true)
+            && (MEMS_SAMPLER_REACHED(now_ms, p_sampler->window.start_ms + p_sampler->config.shock_window_min_ms))))
+    {
+      for (uint8_t i = 0U; i < (uint8_t)MEMS_SAMPLER_SENSOR_NB; i++)
+      {
+        p_stat = &p_sampler->window.stat[i];
+        if (p_stat->nb != 0U)
+        {
+          for (uint8_t j = 0U; j < 3U; j++)
+          {
+            p_stat->mean[j] = p_sampler->sum[i][j] / (float_t)p_stat->nb;
+          }
+        }
+      }
+      p_sampler->window.duration_ms = now_ms - p_sampler->window.start_ms;
+      *p_window = p_sampler->window;
+      mems_sampler_window_reset(p_sampler, now_ms);
+      result = true;
+    }
+  }
+
+  return (result);
+}
+
+/**
+  * @brief  Read a sensor at the next mems_sampler_run()
+  * @note   To call from the sampling task, not from an interrupt
+  * @param  p_sampler - sampler
+  * @param  sensor    - sensor to read
+  * @param  now_ms    - current time in ms
+  * @retval -
+  */
+void mems_sampler_request(mems_sampler_t *p_sampler, mems_sampler_sensor_t sensor, uint32_t now_ms)
+{
+  if ((sensor < MEMS_SAMPLER_SENSOR_NB) && (p_sampler->config.period_ms[sensor] != 0U))
+  {
+    p_sampler->next_ms[sensor] = now_ms;
+  }
+}
+
+/**
+  * @brief  Change the window duration
+  * @param  p_sampler - sampler
+  * @param  window_ms - new window duration, 0: windows are never ended by time
+  * @retval -
+  */
+void mems_sampler_set_window(mems_sampler_t *p_sampler, uint32_t window_ms)
+{
+  p_sampler->config.window_ms = window_ms;
+}
+
+/**
+  * @brief  Initialize the simulated bus
+  * @param  p_simu - simulated bus context
+  * @retval -
+  */
+void mems_sampler_simu_init(mems_sampler_simu_t *p_simu)
+{
+  (void)memset((void *)p_simu, 0, sizeof(mems_sampler_simu_t));
+  for (uint8_t i = 0U; i < 3U; i++)
+  {
+    p_simu->env[i] = simu_env_initial[i];
+    p_simu->env_step[i] = simu_env_increment[i];
+  }
+}
+
+/**
+  * @brief  Inject a shock in the next accelerometer sample of the simulated bus
+  * @param  p_simu   - simulated bus context
+  * @param  shock_mg - acceleration added on Z axis
+  * @retval -
+  */
+void mems_sampler_simu_shock(mems_sampler_simu_t *p_simu, float_t shock_mg)
+{
+  p_simu->shock_mg = shock_mg;
+}
+
+/**
+  * @brief  Simulated bus read
+  * @note   Environmental sensors return one sample per read, following a triangle wave.
+  *         Motion sensors return max_nb samples (a full FIFO) around the rest position.
+  * @param  p_bus_context - mems_sampler_simu_t context
+  * @param  sensor        - sensor to read
+  * @param  p_values      - samples read
+  * @param  max_nb        - max number of samples
+  * @retval uint16_t      - number of samples read
+  */
+uint16_t mems_sampler_simu_read(void *p_bus_context, mems_sampler_sensor_t sensor,
+                                mems_sampler_value_t *p_values, uint16_t max_nb)
+{
+  mems_sampler_simu_t *p_simu = (mems_sampler_simu_t *)p_bus_context;
+  uint16_t nb = 0U;
+  uint8_t env;
+  float_t noise;
+
+  if ((p_simu != NULL) && (max_nb != 0U))
+  {
+    if (sensor >= MEMS_SAMPLER_PRESSURE)
+    {
+      env = (uint8_t)sensor - (uint8_t)MEMS_SAMPLER_PRESSURE;
+      p_simu->env[env] += p_simu->env_step[env];
+      if (p_simu->env[env] >= (simu_env_initial[env] + simu_env_delta[env]))
+      {
+        p_simu->env_step[env] = -simu_env_increment[env];
+      }
+      if (p_simu->env[env] <= (simu_env_initial[env] - simu_env_delta[env]))
+      {
+        p_simu->env_step[env] = simu_env_increment[env];
+      }
+      p_values[0].axis[0] = p_simu->env[env];
+      p_values[0].axis[1] = 0.0f;
+      p_values[0].axis[2] = 0.0f;
+      nb = 1U;
+    }
+    else
+    {
+      for (nb = 0U; nb < max_nb; nb++)
+      {
+        p_simu->count++;
+        noise = (float_t)(p_simu->count % SIMULATED_MOTION_NOISE);
+        p_values[nb].axis[0] = noise;
+        p_values[nb].axis[1] = -noise;
+        p_values[nb].axis[2] = (sensor == MEMS_SAMPLER_ACCELERO) ? (MEMS_SAMPLER_GRAVITY_MG + noise) : noise;
+      }
+      if ((sensor == MEMS_SAMPLER_ACCELERO) && (p_simu->shock_mg != 0.0f))
+      {
+        p_values[0].axis[2] += p_simu->shock_mg;
+        p_simu->shock_mg = 0.0f;
+      }
+    }
+  }
+
+  return (nb);
+}
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,112 @@
+/**
+  ******************************************************************************
+  * @file    feeprom_ring.h
+  * @author  artworkTrackingMAP
+  * @brief   Header for feeprom_ring.c module
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef FEEPROM_RING_H
+#define FEEPROM_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "plf_config.h"
+
+/**
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                    ##### How to use Flash Ring module #####
+  ==============================================================================
+
+  Append-only ring of records stored in FEEPROM_RING_PAGES flash pages located
+  just below the configuration pages managed by feeprom_utils.
+
+  - feeprom_ring_init() retrieves the records still stored in flash (after a reset).
+  - feeprom_ring_append() stores a record.
+  - feeprom_ring_peek() gives the oldest record not consumed, read in place in flash.
+  - feeprom_ring_consume() marks this record as consumed: it is not given again,
+    even after a reset.
+
+  The pages are used in turn: a page is erased only when the writer needs it, so each
+  page is erased the same number of times. When the ring is full, the oldest page
+  is erased and its records not consumed are lost.
+
+  Page layout: 8 bytes header (magic, page sequence number) then records.
+  Record layout: 3 double-words (header with size, commit, consumed) then data
+  padded to 8 bytes. The commit double-word is written after the data: a record
+  interrupted by a reset is ignored.
+
+  The functions are protected by a mutex: append and read can be done by different
+  threads. The data given by feeprom_ring_peek() is read in place: it stays valid
+  until the next append erases the oldest page (ring full), so a reader that is not
+  the writer must consume or copy it before.
+
+  @endverbatim
+  */
+
+/* Exported constants --------------------------------------------------------*/
+#define FEEPROM_RING_OK     0U
+#define FEEPROM_RING_ERROR  1U
+#define FEEPROM_RING_EMPTY  2U
+
+/* Number of flash pages used by the ring */
+#if !defined FEEPROM_RING_PAGES
+#define FEEPROM_RING_PAGES  (16U)
+#endif /* !defined FEEPROM_RING_PAGES */
+
+/* Ring pages are just below the FEEPROM_UTILS_APPLI_MAX configuration pages */
+#if !defined FEEPROM_RING_FIRST_PAGE_NUMBER
+#define FEEPROM_RING_FIRST_PAGE_NUMBER  ((uint32_t)FLASH_LAST_PAGE_NUMBER - (uint32_t)FEEPROM_UTILS_APPLI_MAX \
+                                         - (uint32_t)FEEPROM_RING_PAGES + 1U)
+#endif /* !defined FEEPROM_RING_FIRST_PAGE_NUMBER */
+#if !defined FEEPROM_RING_FIRST_PAGE_ADDR
+#define FEEPROM_RING_FIRST_PAGE_ADDR    ((uint32_t)FEEPROM_UTILS_LAST_PAGE_ADDR \
+                                         - (((uint32_t)FEEPROM_UTILS_APPLI_MAX + (uint32_t)FEEPROM_RING_PAGES - 1U) \
+                                            * FLASH_PAGE_SIZE))
+#endif /* !defined FEEPROM_RING_FIRST_PAGE_ADDR */
+
+/* Max size of a record: one page less page header and record header */
+#define FEEPROM_RING_RECORD_MAX_SIZE    ((uint32_t)FLASH_PAGE_SIZE - 8U - 24U)
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t records_stored;   /* number of records appended          */
+  uint32_t records_consumed; /* number of records consumed          */
+  uint32_t records_lost;     /* records erased before consumption   */
+  uint32_t page_erases;      /* number of page erasures             */
+} feeprom_ring_stat_t;
+
+/* External variables --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported functions ------------------------------------------------------- */
+/*  retrieve the ring state from flash - to call before any other function */
+uint32_t feeprom_ring_init(void);
+
+/*  append a record at the end of the ring */
+uint32_t feeprom_ring_append(const uint8_t *p_data, uint32_t size);
+
+/*  get the oldest record not consumed (FEEPROM_RING_EMPTY if none) */
+uint32_t feeprom_ring_peek(const uint8_t **p_data, uint32_t *p_size);
+
+/*  mark the record returned by feeprom_ring_peek as consumed */
+uint32_t feeprom_ring_consume(void);
+
+/*  get the ring statistics */
+void feeprom_ring_get_stat(feeprom_ring_stat_t *p_stat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FEEPROM_RING_H */
+
+/******************************** END OF FILE *********************************/
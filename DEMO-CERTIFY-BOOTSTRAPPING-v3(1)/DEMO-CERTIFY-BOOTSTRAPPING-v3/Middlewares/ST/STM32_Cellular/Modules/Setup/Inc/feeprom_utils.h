@@ -53,6 +53,12 @@ uint32_t feeprom_utils_save_config_flash(setup_appli_code_t appli_code, setup_ap
 uint32_t feeprom_utils_read_config_flash(setup_appli_code_t appli_code, setup_appli_version_t appli_version,
                                          uint8_t **config_addr, uint32_t *config_size);
 
+/*  erase a flash page */
+uint32_t feeprom_utils_page_erase(uint32_t page_number);
+
+/*  write data in an erased flash area (8 bytes aligned addresses and length) */
+uint32_t feeprom_utils_page_write(uint8_t *data_addr, uint8_t *flash_addr, uint32_t length);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,507 @@
+/**
+  ******************************************************************************
+  * @file    feeprom_ring.c
+  * @author  artworkTrackingMAP
+  * @brief   Append-only ring of records in flash (store and forward)
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <stdbool.h>
+#include "plf_config.h"
+#include "rtosal.h"
+#include "feeprom_utils.h"
+#include "feeprom_ring.h"
+
+#if (FEEPROM_UTILS_FLASH_USED == 1)
+
+/* Private defines -----------------------------------------------------------*/
+#define FEEPROM_RING_PAGE_MAGIC          ((uint32_t)0x474E4952U) /* "RING" */
+#define FEEPROM_RING_RECORD_MAGIC        ((uint32_t)0x52454331U) /* "REC1" */
+#define FEEPROM_RING_PAGE_HEADER_SIZE    8U
+#define FEEPROM_RING_RECORD_HEADER_SIZE  24U
+#define FEEPROM_RING_ERASED_DW           ((uint64_t)0xFFFFFFFFFFFFFFFFU)
+#define FEEPROM_RING_WRITTEN_DW          ((uint64_t)0U)
+
+/* Private macros ------------------------------------------------------------*/
+/* Record size in flash: header + data padded to 8 bytes */
+#define FEEPROM_RING_RECORD_FLASH_SIZE(size) \
+  (FEEPROM_RING_RECORD_HEADER_SIZE + (((size) + 7U) & ~((uint32_t)7U)))
+
+/* Private typedef -----------------------------------------------------------*/
+/* page header */
+typedef struct
+{
+  uint32_t magic;
+  uint32_t seq;      /* incremented each time a page is opened: highest value is the write page */
+} feeprom_ring_page_header_t;
+
+/* record header */
+typedef struct
+{
+  uint32_t magic;
+  uint32_t size;     /* data size */
+  uint64_t commit;   /* FEEPROM_RING_WRITTEN_DW once data is completely written */
+  uint64_t consumed; /* FEEPROM_RING_WRITTEN_DW once record is consumed */
+} feeprom_ring_record_header_t;
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t feeprom_ring_write_page;   /* index of the page being written           */
+static uint32_t feeprom_ring_write_offset; /* offset of the next record in the write page */
+static uint32_t feeprom_ring_write_seq;    /* sequence number of the write page         */
+static uint32_t feeprom_ring_read_page;    /* index of the page being read              */
+static uint32_t feeprom_ring_read_offset;  /* offset of the next record to read         */
+static bool     feeprom_ring_peeked = false;
+static feeprom_ring_stat_t feeprom_ring_stat;
+
+/* Mutex to protect the ring state and the flash programming sequences */
+static osMutexId feeprom_ring_mutex = NULL;
+
+/* 8 bytes aligned copy of the data to write in flash */
+static uint64_t feeprom_ring_chunk[16];
+
+/* Global variables ----------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t *feeprom_ring_page_addr(uint32_t index);
+static const feeprom_ring_record_header_t *feeprom_ring_record(uint32_t index, uint32_t offset);
+static bool feeprom_ring_page_valid(uint32_t index, uint32_t *p_seq);
+static uint32_t feeprom_ring_write(uint8_t *p_flash, const uint8_t *p_data, uint32_t size);
+static uint32_t feeprom_ring_open_page(uint32_t index, uint32_t seq);
+static uint32_t feeprom_ring_page_end(uint32_t index);
+static uint32_t feeprom_ring_count_unconsumed(uint32_t index, uint32_t offset);
+static uint32_t feeprom_ring_load(void);
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  get the address of a ring page
+  * @param  index     page index in the ring
+  * @retval address
+  */
+static uint8_t *feeprom_ring_page_addr(uint32_t index)
+{
+  return (uint8_t *)(uintptr_t)(FEEPROM_RING_FIRST_PAGE_ADDR + (index * FLASH_PAGE_SIZE));
+}
+
+/**
+  * @brief  get a record header in a ring page
+  * @param  index     page index in the ring
+  * @param  offset    record offset in the page
+  * @retval record header
+  */
+static const feeprom_ring_record_header_t *feeprom_ring_record(uint32_t index, uint32_t offset)
+{
+  return (const feeprom_ring_record_header_t *)(feeprom_ring_page_addr(index) + offset);
+}
+
+/**
+  * @brief  check if a page belongs to the ring
+  * @param  index     page index in the ring
+  * @param  p_seq     (out) page sequence number
+  * @retval true: page opened by the ring / false: page erased or unknown content
+  */
+static bool feeprom_ring_page_valid(uint32_t index, uint32_t *p_seq)
+{
+  const feeprom_ring_page_header_t *p_header;
+
+  p_header = (const feeprom_ring_page_header_t *)feeprom_ring_page_addr(index);
+  *p_seq = p_header->seq;
+
+  return (p_header->magic == FEEPROM_RING_PAGE_MAGIC);
+}
+
+/**
+  * @brief  write data in flash through an aligned buffer
+  * @param  p_flash   flash addr where write (8 bytes aligned)
+  * @param  p_data    data to write (no alignment constraint)
+  * @param  size      size of data: last double-word is completed with erased value
+  * @retval status
+  */
+static uint32_t feeprom_ring_write(uint8_t *p_flash, const uint8_t *p_data, uint32_t size)
+{
+  uint32_t ret = FEEPROM_RING_OK;
+  uint32_t done = 0U;
+  uint32_t chunk_size;
+
+  while ((done < size) && (ret == FEEPROM_RING_OK))
+  {
+    chunk_size = size - done;
+    if (chunk_size > sizeof(feeprom_ring_chunk))
+    {
+      chunk_size = sizeof(feeprom_ring_chunk);
+    }
+    (void)memset((void *)feeprom_ring_chunk, 0xFF, sizeof(feeprom_ring_chunk));
+    (void)memcpy((void *)feeprom_ring_chunk, (const void *)&p_data[done], chunk_size);
+    if (feeprom_utils_page_write((uint8_t *)feeprom_ring_chunk, &p_flash[done],
+                                 (chunk_size + 7U) & ~((uint32_t)7U)) != 0U)
+    {
+      ret = FEEPROM_RING_ERROR;
+    }
+    done += chunk_size;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  erase a page and make it the write page
+  * @param  index     page index in the ring
+  * @param  seq       page sequence number
+  * @retval status
+  */
+static uint32_t feeprom_ring_open_page(uint32_t index, uint32_t seq)
+{
+  uint32_t ret;
+  feeprom_ring_page_header_t header;
+
+  feeprom_ring_write_page   = index;
+  feeprom_ring_write_seq    = seq;
+  /* page considered as full until it is ready */
+  feeprom_ring_write_offset = FLASH_PAGE_SIZE;
+
+  feeprom_ring_stat.page_erases++;
+  if (feeprom_utils_page_erase(FEEPROM_RING_FIRST_PAGE_NUMBER + index) != 0U)
+  {
+    ret = FEEPROM_RING_ERROR;
+  }
+  else
+  {
+    header.magic = FEEPROM_RING_PAGE_MAGIC;
+    header.seq   = seq;
+    ret = feeprom_ring_write(feeprom_ring_page_addr(index), (const uint8_t *)&header, sizeof(header));
+    if (ret == FEEPROM_RING_OK)
+    {
+      feeprom_ring_write_offset = FEEPROM_RING_PAGE_HEADER_SIZE;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  find the end of the records of a page
+  * @param  index     page index in the ring
+  * @retval offset of the first free place in the page
+  */
+static uint32_t feeprom_ring_page_end(uint32_t index)
+{
+  const feeprom_ring_record_header_t *p_record;
+  uint32_t offset = FEEPROM_RING_PAGE_HEADER_SIZE;
+  bool end = false;
+
+  /* records are valid up to the returned offset */
+  while ((end == false) && ((offset + FEEPROM_RING_RECORD_HEADER_SIZE) <= FLASH_PAGE_SIZE))
+  {
+    p_record = feeprom_ring_record(index, offset);
+    if (*((const uint64_t *)p_record) == FEEPROM_RING_ERASED_DW)
+    {
+      /* free place found */
+      end = true;
+    }
+    else if ((p_record->magic != FEEPROM_RING_RECORD_MAGIC)
+             || (p_record->size > FEEPROM_RING_RECORD_MAX_SIZE))
+    {
+      /* unknown content: page is not used anymore */
+      offset = FLASH_PAGE_SIZE;
+    }
+    else
+    {
+      offset += FEEPROM_RING_RECORD_FLASH_SIZE(p_record->size);
+    }
+  }
+
+  return ((offset < FLASH_PAGE_SIZE) ? offset : FLASH_PAGE_SIZE);
+}
+
+/**
+  * @brief  count the records not consumed of a page from an offset
+  * @param  index     page index in the ring
+  * @param  offset    first record offset
+  * @retval number of records not consumed
+  */
+static uint32_t feeprom_ring_count_unconsumed(uint32_t index, uint32_t offset)
+{
+  const feeprom_ring_record_header_t *p_record;
+  uint32_t count = 0U;
+  uint32_t end = feeprom_ring_page_end(index);
+  uint32_t current = offset;
+
+  while (current < end)
+  {
+    p_record = feeprom_ring_record(index, current);
+    if ((p_record->commit == FEEPROM_RING_WRITTEN_DW) && (p_record->consumed == FEEPROM_RING_ERASED_DW))
+    {
+      count++;
+    }
+    current += FEEPROM_RING_RECORD_FLASH_SIZE(p_record->size);
+  }
+
+  return count;
+}
+
+/**
+  * @brief  retrieve the ring state from flash
+  * @param  none
+  * @retval status
+  */
+static uint32_t feeprom_ring_load(void)
+{
+  uint32_t ret = FEEPROM_RING_OK;
+  uint32_t i;
+  uint32_t index;
+  uint32_t seq;
+  bool found = false;
+
+  (void)memset((void *)&feeprom_ring_stat, 0, sizeof(feeprom_ring_stat));
+  feeprom_ring_peeked = false;
+
+  /* the write page is the page with the highest sequence number */
+  for (i = 0U; i < FEEPROM_RING_PAGES; i++)
+  {
+    if (feeprom_ring_page_valid(i, &seq) == true)
+    {
+      if ((found == false) || (seq > feeprom_ring_write_seq))
+      {
+        feeprom_ring_write_page = i;
+        feeprom_ring_write_seq  = seq;
+      }
+      found = true;
+    }
+  }
+
+  if (found == false)
+  {
+    /* empty ring */
+    ret = feeprom_ring_open_page(0U, 1U);
+    feeprom_ring_read_page = 0U;
+  }
+  else
+  {
+    feeprom_ring_write_offset = feeprom_ring_page_end(feeprom_ring_write_page);
+    /* pages are opened in turn: the oldest page is the first valid page after the write page */
+    feeprom_ring_read_page = feeprom_ring_write_page;
+    for (i = 1U; i < FEEPROM_RING_PAGES; i++)
+    {
+      index = (feeprom_ring_write_page + i) % FEEPROM_RING_PAGES;
+      if (feeprom_ring_page_valid(index, &seq) == true)
+      {
+        feeprom_ring_read_page = index;
+        break;
+      }
+    }
+  }
+  feeprom_ring_read_offset = FEEPROM_RING_PAGE_HEADER_SIZE;
+
+  return ret;
+}
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+  * @brief  retrieve the ring state from flash
+  * @note   to call before any other function of the module
+  * @param  none
+  * @retval status
+  */
+uint32_t feeprom_ring_init(void)
+{
+  uint32_t ret;
+
+  /* Multi call protection */
+  if (feeprom_ring_mutex == NULL)
+  {
+    feeprom_ring_mutex = rtosalMutexNew(NULL);
+  }
+
+  if (feeprom_ring_mutex == NULL)
+  {
+    ret = FEEPROM_RING_ERROR;
+  }
+  else
+  {
+    (void)rtosalMutexAcquire(feeprom_ring_mutex, RTOSAL_WAIT_FOREVER);
+    ret = feeprom_ring_load();
+    (void)rtosalMutexRelease(feeprom_ring_mutex);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  append a record at the end of the ring
+  * @note   when the ring is full the oldest page is erased
+  * @param  p_data    data to store
+  * @param  size      size of data (at most FEEPROM_RING_RECORD_MAX_SIZE)
+  * @retval status
+  */
+uint32_t feeprom_ring_append(const uint8_t *p_data, uint32_t size)
+{
+  uint32_t ret = FEEPROM_RING_OK;
+  uint32_t next;
+  uint8_t *p_flash;
+  feeprom_ring_record_header_t header;
+
+  (void)rtosalMutexAcquire(feeprom_ring_mutex, RTOSAL_WAIT_FOREVER);
+  if ((size == 0U) || (size > FEEPROM_RING_RECORD_MAX_SIZE))
+  {
+    ret = FEEPROM_RING_ERROR;
+  }
+  else if ((feeprom_ring_write_offset + FEEPROM_RING_RECORD_FLASH_SIZE(size)) > FLASH_PAGE_SIZE)
+  {
+    /* use the next page */
+    next = (feeprom_ring_write_page + 1U) % FEEPROM_RING_PAGES;
+    if (next == feeprom_ring_read_page)
+    {
+      /* ring is full: records not consumed of the oldest page are lost */
+      feeprom_ring_stat.records_lost += feeprom_ring_count_unconsumed(next, feeprom_ring_read_offset);
+      feeprom_ring_read_page   = (next + 1U) % FEEPROM_RING_PAGES;
+      feeprom_ring_read_offset = FEEPROM_RING_PAGE_HEADER_SIZE;
+      feeprom_ring_peeked      = false;
+    }
+    ret = feeprom_ring_open_page(next, feeprom_ring_write_seq + 1U);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  if (ret == FEEPROM_RING_OK)
+  {
+    p_flash = feeprom_ring_page_addr(feeprom_ring_write_page) + feeprom_ring_write_offset;
+    header.magic = FEEPROM_RING_RECORD_MAGIC;
+    header.size  = size;
+
+    /* header (size) first, then data, then commit */
+    ret = feeprom_ring_write(p_flash, (const uint8_t *)&header, 8U);
+    if (ret == FEEPROM_RING_OK)
+    {
+      ret = feeprom_ring_write(&p_flash[FEEPROM_RING_RECORD_HEADER_SIZE], p_data, size);
+    }
+    if (ret == FEEPROM_RING_OK)
+    {
+      header.commit = FEEPROM_RING_WRITTEN_DW;
+      ret = feeprom_ring_write(&p_flash[8], (const uint8_t *)&header.commit, 8U);
+    }
+
+    if (ret == FEEPROM_RING_OK)
+    {
+      feeprom_ring_write_offset += FEEPROM_RING_RECORD_FLASH_SIZE(size);
+      feeprom_ring_stat.records_stored++;
+    }
+    else
+    {
+      /* do not program again this area: next record in the next page */
+      feeprom_ring_write_offset = FLASH_PAGE_SIZE;
+    }
+  }
+  (void)rtosalMutexRelease(feeprom_ring_mutex);
+
+  return ret;
+}
+
+/**
+  * @brief  get the oldest record not consumed
+  * @note   data is read in place in flash: valid until the next append
+  * @param  p_data    (out) record data
+  * @param  p_size    (out) record data size
+  * @retval status    FEEPROM_RING_OK / FEEPROM_RING_EMPTY
+  */
+uint32_t feeprom_ring_peek(const uint8_t **p_data, uint32_t *p_size)
+{
+  uint32_t ret = FEEPROM_RING_EMPTY;
+  uint32_t seq;
+  bool done = false;
+  const feeprom_ring_record_header_t *p_record;
+
+  (void)rtosalMutexAcquire(feeprom_ring_mutex, RTOSAL_WAIT_FOREVER);
+  feeprom_ring_peeked = false;
+  while (done == false)
+  {
+    if ((feeprom_ring_read_page == feeprom_ring_write_page)
+        && (feeprom_ring_read_offset >= feeprom_ring_write_offset))
+    {
+      /* all records read */
+      done = true;
+    }
+    else if ((feeprom_ring_page_valid(feeprom_ring_read_page, &seq) == false)
+             || (feeprom_ring_read_offset >= feeprom_ring_page_end(feeprom_ring_read_page)))
+    {
+      /* end of page */
+      if (feeprom_ring_read_page == feeprom_ring_write_page)
+      {
+        done = true;
+      }
+      else
+      {
+        feeprom_ring_read_page   = (feeprom_ring_read_page + 1U) % FEEPROM_RING_PAGES;
+        feeprom_ring_read_offset = FEEPROM_RING_PAGE_HEADER_SIZE;
+      }
+    }
+    else
+    {
+      p_record = feeprom_ring_record(feeprom_ring_read_page, feeprom_ring_read_offset);
+      if ((p_record->commit == FEEPROM_RING_WRITTEN_DW) && (p_record->consumed == FEEPROM_RING_ERASED_DW))
+      {
+        *p_data = (const uint8_t *)p_record + FEEPROM_RING_RECORD_HEADER_SIZE;
+        *p_size = p_record->size;
+        feeprom_ring_peeked = true;
+        ret = FEEPROM_RING_OK;
+        done = true;
+      }
+      else
+      {
+        /* record consumed or not completely written */
+        feeprom_ring_read_offset += FEEPROM_RING_RECORD_FLASH_SIZE(p_record->size);
+      }
+    }
+  }
+  (void)rtosalMutexRelease(feeprom_ring_mutex);
+
+  return ret;
+}
+
+/**
+  * @brief  mark the record returned by feeprom_ring_peek as consumed
+  * @param  none
+  * @retval status
+  */
+uint32_t feeprom_ring_consume(void)
+{
+  uint32_t ret;
+  uint64_t consumed = FEEPROM_RING_WRITTEN_DW;
+  const feeprom_ring_record_header_t *p_record;
+
+  (void)rtosalMutexAcquire(feeprom_ring_mutex, RTOSAL_WAIT_FOREVER);
+  if (feeprom_ring_peeked == false)
+  {
+    ret = FEEPROM_RING_ERROR;
+  }
+  else
+  {
+    p_record = feeprom_ring_record(feeprom_ring_read_page, feeprom_ring_read_offset);
+    ret = feeprom_ring_write(feeprom_ring_page_addr(feeprom_ring_read_page) + feeprom_ring_read_offset + 16U,
+                             (const uint8_t *)&consumed, 8U);
+    feeprom_ring_read_offset += FEEPROM_RING_RECORD_FLASH_SIZE(p_record->size);
+    feeprom_ring_stat.records_consumed++;
+    feeprom_ring_peeked = false;
+  }
+  (void)rtosalMutexRelease(feeprom_ring_mutex);
+
+  return ret;
+}
+
+/**
+  * @brief  get the ring statistics
+  * @param  p_stat    (out) statistics
+  * @retval none
+  */
+void feeprom_ring_get_stat(feeprom_ring_stat_t *p_stat)
+{
+  (void)rtosalMutexAcquire(feeprom_ring_mutex, RTOSAL_WAIT_FOREVER);
+  *p_stat = feeprom_ring_stat;
+  (void)rtosalMutexRelease(feeprom_ring_mutex);
+}
+
+#endif /* FEEPROM_UTILS_FLASH_USED == 1 */
+
+/******************************** END OF FILE *********************************/
@@ -249,6 +249,36 @@ static uint32_t feeprom_utils_flash_erase(uint32_t page_number)
   return ret;
 }
 
+/**
+  * @brief  erase a flash page (used by other flash users like feeprom_ring)
+  * @param  page_number             flash page number to erase
+  * @retval status (0=>erase OK / 1=>erase error)
+  */
+uint32_t feeprom_utils_page_erase(uint32_t page_number)
+{
+  return feeprom_utils_flash_erase(page_number);
+}
+
+/**
+  * @brief  write data in an erased flash area (used by other flash users like feeprom_ring)
+  * @param  data_addr    data addr to write (8 bytes aligned)
+  * @param  flash_addr   flash addr where write (8 bytes aligned)
+  * @param  length       length of data to write (multiple of 8, at most one flash page)
+  * @retval status (0=>write OK / 1=>write error)
+  */
+uint32_t feeprom_utils_page_write(uint8_t *data_addr, uint8_t *flash_addr, uint32_t length)
+{
+  uint32_t ret;
+  uint32_t byteswritten;
+
+  feeprom_utils_open_flash();
+  __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+  ret = feeprom_utils_flash_write(data_addr, flash_addr, length, &byteswritten);
+  feeprom_utils_close_flash();
+
+  return ret;
+}
+
 /**
   * @brief  erase a setup configuration in flash
   * @param  appli_code          owner code of application to erase
@@ -0,0 +1,149 @@
+/**
+  ******************************************************************************
+  * @file    stack_analysis_sampler.h
+  * @author  artworkTrackingMAP
+  * @brief   Header for the task sampler of stack_analysis.c module
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STACK_ANALYSIS_SAMPLER_H
+#define STACK_ANALYSIS_SAMPLER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "plf_config.h"
+
+#if ((USE_STACK_ANALYSIS == 1) && (STACK_ANALYSIS_SAMPLER_PERIOD != 0U))
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dc_common.h"
+
+/**
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                    ##### How to use the task sampler #####
+  ==============================================================================
+
+  Every STACK_ANALYSIS_SAMPLER_PERIOD ms, the stack analysis thread samples:
+    - CPU load of each thread during the last period (FreeRTOS run time statistics
+      computed with the DWT cycle counter),
+    - stack high water mark of each thread,
+    - current and minimum ever free heap.
+  No allocation is done: the last STACK_ANALYSIS_SAMPLER_HISTORY samples are kept
+  in a preallocated ring, read by stackAnalysis_sampler_get().
+  The last sample is also published in the Data Cache entry DC_COM_TASK_STAT.
+
+  stackAnalysis_sample_encode() provides a compact binary form of a sample.
+  All multi-bytes fields are little endian, varint is unsigned LEB128.
+    byte 0     : format (STACK_ANALYSIS_SAMPLE_FORMAT)
+    byte 1     : number of threads
+    byte 2..5  : sample time in ms (uint32)
+    varint     : free heap in bytes
+    varint     : minimum ever free heap in bytes
+    varint     : CPU load in 1/1000 (all threads except Idle)
+  Then for each thread:
+    byte 0     : FreeRTOS task number
+    byte 1..4  : first characters of the name (padded with 0)
+    varint     : CPU load in 1/1000
+    varint     : stack high water mark (FreeRTOS unit: words)
+    varint     : stack size at creation (0: not provided to stack analysis)
+
+  @endverbatim
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/* Max number of threads in a sample: threads created after are not sampled */
+#if !defined STACK_ANALYSIS_SAMPLER_TASK_MAX
+#define STACK_ANALYSIS_SAMPLER_TASK_MAX    (THREAD_NUMBER + 2U)
+#endif /* !defined STACK_ANALYSIS_SAMPLER_TASK_MAX */
+
+/* Number of samples kept in the ring */
+#if !defined STACK_ANALYSIS_SAMPLER_HISTORY
+#define STACK_ANALYSIS_SAMPLER_HISTORY     (4U)
+#endif /* !defined STACK_ANALYSIS_SAMPLER_HISTORY */
+
+/* Number of characters of the thread name kept in a sample */
+#define STACK_ANALYSIS_SAMPLE_NAME_SIZE    (4U)
+
+/* First byte of an encoded sample - different from the Custom client telemetry versions */
+#define STACK_ANALYSIS_SAMPLE_FORMAT       ((uint8_t)0x10U)
+
+/* Max size of an encoded sample for nb threads: header + 3 varints (5 bytes max),
+   then per thread: number + name + CPU varint (2 bytes max) + 2 stack varints (3 bytes max) */
+#define STACK_ANALYSIS_SAMPLE_SIZE(nb)     (6U + (3U * 5U) \
+                                            + ((uint32_t)(nb) * (1U + STACK_ANALYSIS_SAMPLE_NAME_SIZE + 2U + 3U + 3U)))
+
+/* Exported types ------------------------------------------------------------*/
+/* Usage of one thread during a sampler period */
+typedef struct
+{
+  uint8_t  task_number;                            /* FreeRTOS task number               */
+  uint8_t  name[STACK_ANALYSIS_SAMPLE_NAME_SIZE];  /* first characters of the name       */
+  uint16_t cpu_permille;                           /* CPU load in 1/1000                 */
+  uint16_t stack_free_min;                         /* stack high water mark              */
+  uint16_t stack_size;                             /* stack size at creation, 0: unknown */
+} sa_task_usage_t;
+
+/* One sample of the task sampler */
+typedef struct
+{
+  uint32_t time_ms;                                /* sample time in ms                  */
+  uint32_t heap_free;                              /* free heap in bytes                 */
+  uint32_t heap_free_min;                          /* minimum ever free heap in bytes    */
+  uint16_t cpu_permille;                           /* CPU load of all threads but Idle   */
+  uint8_t  task_nb;                                /* number of threads in task[]        */
+  sa_task_usage_t task[STACK_ANALYSIS_SAMPLER_TASK_MAX];
+} sa_sample_t;
+
+/* Data Cache entry DC_COM_TASK_STAT */
+typedef struct
+{
+  dc_service_rt_header_t header;
+  dc_service_rt_state_t  rt_state;
+  sa_sample_t            sample;
+} dc_task_stat_info_t;
+
+/* External variables --------------------------------------------------------*/
+/* Data Cache entry of the task sampler - rt_state is DC_SERVICE_ON once a sample is available */
+extern dc_com_res_id_t DC_COM_TASK_STAT;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+
+/**
+  * @brief  Get a sample of the task sampler ring
+  * @param  age      - 0: last sample, 1: previous one, ...
+  * @param  p_sample - sample copy
+  * @retval bool - false: no such sample (yet) / true: sample copied
+  */
+bool stackAnalysis_sampler_get(uint8_t age, sa_sample_t *p_sample);
+
+/**
+  * @brief  Encode a sample in the compact binary format
+  * @param  p_sample - sample to encode
+  * @param  p_buf    - where to encode
+  * @param  size     - size of p_buf (STACK_ANALYSIS_SAMPLE_SIZE(task_nb) is always enough)
+  * @retval uint16_t - number of bytes written, 0 if p_buf is too small
+  */
+uint16_t stackAnalysis_sample_encode(const sa_sample_t *p_sample, uint8_t *p_buf, uint16_t size);
+
+/*** Internal use only - Not an Application Interface *************************/
+/* Run time counter of RTOS statistics (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS / portGET_RUN_TIME_COUNTER_VALUE) */
+void stackAnalysis_runtime_init(void);
+uint32_t stackAnalysis_runtime_get(void);
+
+#endif /* (USE_STACK_ANALYSIS == 1) && (STACK_ANALYSIS_SAMPLER_PERIOD != 0U) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STACK_ANALYSIS_SAMPLER_H */
+
+/******************************** END OF FILE *********************************/
@@ -28,6 +28,10 @@
 
 #include "error_handler.h"
 
+#if (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)
+#include "stack_analysis_sampler.h"
+#endif /* STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
+
 #if (USE_CMD_CONSOLE == 1)
 #include "cmd.h"
 #endif /* (USE_CMD_CONSOLE == 1) */
@@ -74,6 +78,16 @@ typedef struct
 #define TSK_INVALID_CHAR   (SA_CHAR_t)('I')
 #define TSK_UNKNOWN_CHAR   (SA_CHAR_t)(' ')
 
+/* Messages received by the stack analysis thread */
+#define SA_MSG_TRACE       (uint32_t)(0U) /* trace the tasks stack */
+#define SA_MSG_SAMPLE      (uint32_t)(1U) /* sample the tasks usage */
+
+#if (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)
+/* Run time counter is the DWT cycle counter divided by 2^SA_RUNTIME_SHIFT:
+   at 80MHz, 1.25MHz counter wrapping every 57 minutes */
+#define SA_RUNTIME_SHIFT   (6U)
+#endif /* STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
+
 /* Private variables ---------------------------------------------------------*/
 /* Mutex to protect access to TaskAnalysisList when add a new entry */
 static osMutexId StackAnalysisMutexHandle = NULL;
@@ -86,12 +100,40 @@ static uint8_t TaskAnalysisListNb = 0U;
 static uint8_t *stackAnalysis_cmd_label = (uint8_t *)"stack";
 #endif /* USE_CMD_CONSOLE == 1 */
 
-#if (STACK_ANALYSIS_TIMER != 0U)
-/* When timer call back function is called a message is send to the queue to ask to trace the tasks stack */
+#if (USED_STACK_ANALYSIS_THREAD == 1)
+/* When timer call back function is called a message is send to the queue
+   to ask to trace the tasks stack or to sample the tasks usage */
 static osMessageQId StackAnalysisQueueId = NULL;
+#endif /* USED_STACK_ANALYSIS_THREAD == 1 */
+#if (STACK_ANALYSIS_TIMER != 0U)
 static osTimerId StackAnalysisTimerId = NULL;
 #endif /* STACK_ANALYSIS_TIMER != 0U */
 
+#if (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)
+static osTimerId StackAnalysisSamplerTimerId = NULL;
+/* Data Cache entry and its write buffer where the sample is built */
+static dc_task_stat_info_t sa_task_stat_dc;
+static dc_task_stat_info_t sa_task_stat;
+/* Tasks status provided by RTOS - preallocated to avoid any allocation at each sample */
+static TaskStatus_t sa_sampler_status[STACK_ANALYSIS_SAMPLER_TASK_MAX];
+/* Run time counter of each task at the last two samples: CPU load is computed on the difference */
+static struct
+{
+  UBaseType_t number;
+  uint32_t    runtime;
+} sa_sampler_runtime[2][STACK_ANALYSIS_SAMPLER_TASK_MAX];
+static uint8_t sa_sampler_runtime_nb[2];
+static uint8_t sa_sampler_runtime_last;  /* index of the last sample in sa_sampler_runtime */
+static uint32_t sa_sampler_total_last;   /* total run time at the last sample */
+/* Ring of the last samples - protected by StackAnalysisMutexHandle */
+static sa_sample_t sa_sampler_ring[STACK_ANALYSIS_SAMPLER_HISTORY];
+static uint8_t sa_sampler_ring_next;     /* where the next sample is written */
+static uint8_t sa_sampler_ring_nb;       /* number of samples in the ring */
+/* Run time counter: cycles counted since the scheduler start */
+static uint64_t sa_runtime_cycles;
+static uint32_t sa_runtime_cyccnt_last;
+#endif /* STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
+
 /* Format of stack analysis trace */
 static sa_print_format_t sa_next_print_format;
 
@@ -99,6 +141,11 @@ static sa_print_format_t sa_next_print_format;
 static bool sa_next_force; /* force to trace all stack even if SA_TRACE_ONLY_THE_CHANGE is activated */
 #endif /* SA_TRACE_ONLY_THE_CHANGE == 1 */
 
+/* Global variables ----------------------------------------------------------*/
+#if (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)
+dc_com_res_id_t DC_COM_TASK_STAT = DC_COM_INVALID_ENTRY;
+#endif /* STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
+
 /* Private function prototypes -----------------------------------------------*/
 static bool getStackSizeByHandle(
   const TaskHandle_t *TaskHandle,
@@ -123,15 +170,27 @@ static void formatTaskName(SA_CHAR_t *pcBuffer,
 static cmd_status_t stackAnalysis_cmd(uint8_t *cmd_line_p);
 #endif /* USE_CMD_CONSOLE == 1 */
 
-#if (STACK_ANALYSIS_TIMER != 0U)
-/* In case a periodical display is activated,
+#if (USED_STACK_ANALYSIS_THREAD == 1)
+/* In case a periodical display or the sampler is activated,
    a task is needed to received the message of the timer and to display the task stack status
    callback is not used to do this because display is using freertos functions */
 static void stack_analysis_thread(void *p_argument);
+#endif /* USED_STACK_ANALYSIS_THREAD == 1 */
 
+#if (STACK_ANALYSIS_TIMER != 0U)
 static void stack_analysis_timer_cb(void *p_argument);
 #endif /* STACK_ANALYSIS_TIMER != 0U */
 
+#if (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)
+static void stack_analysis_sampler_timer_cb(void *p_argument);
+static void stack_analysis_sample(void);
+static uint32_t stack_analysis_get_runtime(uint8_t index, UBaseType_t number);
+static uint16_t stack_analysis_put_varint(uint8_t *p_buf, uint32_t value);
+#if (USE_CMD_CONSOLE == 1)
+static void stack_analysis_sampler_display(void);
+#endif /* USE_CMD_CONSOLE == 1 */
+#endif /* STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
+
 /* Private functions ---------------------------------------------------------*/
 
 
@@ -147,6 +206,9 @@ static void stackAnalysis_cmd_help(void)
   PRINT_FORCE("%s display              : display task infos according internal settings", stackAnalysis_cmd_label)
   PRINT_FORCE("%s display all          : display all task infos whatever internal settings", stackAnalysis_cmd_label)
   PRINT_FORCE("%s format [print|valid] : set the display format to print or validation", stackAnalysis_cmd_label)
+#if (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)
+  PRINT_FORCE("%s sampler              : display the last sample of task usage", stackAnalysis_cmd_label)
+#endif /* STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
   PRINT_FORCE("%s help                 : display this help", stackAnalysis_cmd_label)
 }
 
@@ -254,6 +316,14 @@ static cmd_status_t stackAnalysis_cmd(uint8_t *cmd_line_p)
           stackAnalysis_cmd_help();
         }
       }
+#if (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)
+      else if (strncmp((SA_CHAR_t *)argv_p[0],
+                       "sampler",
+                       strlen((const SA_CHAR_t *)argv_p[0])) == 0)
+      {
+        stack_analysis_sampler_display();
+      }
+#endif /* STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
       else if (strncmp((SA_CHAR_t *)argv_p[0],
                        "help",
                        strlen((const SA_CHAR_t *)argv_p[0])) == 0)
@@ -412,10 +482,197 @@ static void stack_analysis_timer_cb(void *p_argument)
   UNUSED(p_argument);
 
   /* Request a trace by sending a message to the stack analysis thread */
-  (void)rtosalMessageQueuePut(StackAnalysisQueueId, (uint32_t)0U, 0U);
+  (void)rtosalMessageQueuePut(StackAnalysisQueueId, SA_MSG_TRACE, 0U);
 }
 #endif /* STACK_ANALYSIS_TIMER != 0U */
 
+#if (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)
+/**
+  * @brief  Callback called when Sampler Timer raised
+  * @note   Managed Stack Analysis Sampler Timer
+  * @param  p_argument - unused
+  * @retval -
+  */
+static void stack_analysis_sampler_timer_cb(void *p_argument)
+{
+  UNUSED(p_argument);
+
+  /* Request a sample by sending a message to the stack analysis thread */
+  (void)rtosalMessageQueuePut(StackAnalysisQueueId, SA_MSG_SAMPLE, 0U);
+}
+
+/**
+  * @brief  Get the run time counter of a task at a previous sample
+  * @param  index  - index of the sample in sa_sampler_runtime
+  * @param  number - task number to search
+  * @retval uint32_t - run time counter of the task, 0 if the task did not exist
+  */
+static uint32_t stack_analysis_get_runtime(uint8_t index, UBaseType_t number)
+{
+  uint32_t result = 0U;
+  uint8_t i = 0U;
+  bool found = false;
+
+  while ((found == false) && (i < sa_sampler_runtime_nb[index]))
+  {
+    if (sa_sampler_runtime[index][i].number == number)
+    {
+      result = sa_sampler_runtime[index][i].runtime;
+      found = true;
+    }
+    else
+    {
+      i++;
+    }
+  }
+
+  return result;
+}
+
+/**
+  * @brief  Sample the tasks usage
+  * @note   Called by the stack analysis thread - no allocation, no trace
+  *         The sample is added in the ring and written in the Data Cache
+  * @param  -
+  * @retval -
+  */
+static void stack_analysis_sample(void)
+{
+  sa_sample_t *p_sample = &sa_task_stat.sample;
+  const TaskStatus_t *p_status;
+  const TaskHandle_t idle_handle = xTaskGetIdleTaskHandle();
+  UBaseType_t status_nb;
+  uint32_t total_runtime;
+  uint32_t total_delta;
+  uint32_t task_delta;
+  uint32_t idle_delta = 0U;
+  uint16_t stack_size;
+  uint16_t stack_free;
+  uint8_t indice;
+  uint8_t previous = sa_sampler_runtime_last;
+  uint8_t current = (uint8_t)(1U - previous);
+
+  /* Tasks status - returns 0 if a task is not in the array: tasks number is too high */
+  status_nb = uxTaskGetSystemState(sa_sampler_status, (UBaseType_t)STACK_ANALYSIS_SAMPLER_TASK_MAX, &total_runtime);
+
+  /* Unsigned subtraction: correct even if the run time counter wrapped */
+  total_delta = total_runtime - sa_sampler_total_last;
+  sa_sampler_total_last = total_runtime;
+
+  p_sample->time_ms = HAL_GetTick();
+  p_sample->heap_free = (uint32_t)xPortGetFreeHeapSize();
+  p_sample->heap_free_min = (uint32_t)xPortGetMinimumEverFreeHeapSize();
+  p_sample->task_nb = (uint8_t)status_nb;
+
+  for (uint8_t i = 0U; i < (uint8_t)status_nb; i++)
+  {
+    p_status = &sa_sampler_status[i];
+
+    /* Keep the run time counter for the next sample */
+    sa_sampler_runtime[current][i].number = p_status->xTaskNumber;
+    sa_sampler_runtime[current][i].runtime = p_status->ulRunTimeCounter;
+
+    task_delta = p_status->ulRunTimeCounter - stack_analysis_get_runtime(previous, p_status->xTaskNumber);
+    if (p_status->xHandle == idle_handle)
+    {
+      idle_delta = task_delta;
+    }
+
+    /* Stack size at creation if provided to stack analysis */
+    if ((getStackSizeByHandle((const TaskHandle_t *)p_status->xHandle, &stack_size, &stack_free, &indice) == false)
+        && (getStackSizeByName((const SA_CHAR_t *)p_status->pcTaskName, &stack_size, &stack_free, &indice) == false))
+    {
+      stack_size = 0U;
+    }
+
+    p_sample->task[i].task_number = (uint8_t)p_status->xTaskNumber;
+    (void)strncpy((SA_CHAR_t *)p_sample->task[i].name, (const SA_CHAR_t *)p_status->pcTaskName,
+                  STACK_ANALYSIS_SAMPLE_NAME_SIZE);
+    p_sample->task[i].cpu_permille = (total_delta == 0U) ? 0U
+                                     : (uint16_t)(((uint64_t)task_delta * 1000U) / total_delta);
+    p_sample->task[i].stack_free_min = (uint16_t)p_status->usStackHighWaterMark;
+    p_sample->task[i].stack_size = stack_size;
+  }
+  sa_sampler_runtime_nb[current] = (uint8_t)status_nb;
+  sa_sampler_runtime_last = current;
+
+  p_sample->cpu_permille = (total_delta == 0U) ? 0U
+                           : (uint16_t)(1000U - (uint16_t)(((uint64_t)idle_delta * 1000U) / total_delta));
+
+  /* Add the sample in the ring */
+  (void)rtosalMutexAcquire(StackAnalysisMutexHandle, RTOSAL_WAIT_FOREVER);
+  (void)memcpy((void *)&sa_sampler_ring[sa_sampler_ring_next], (const void *)p_sample, sizeof(sa_sample_t));
+  sa_sampler_ring_next = (uint8_t)((sa_sampler_ring_next + 1U) % STACK_ANALYSIS_SAMPLER_HISTORY);
+  if (sa_sampler_ring_nb < STACK_ANALYSIS_SAMPLER_HISTORY)
+  {
+    sa_sampler_ring_nb++;
+  }
+  (void)rtosalMutexRelease(StackAnalysisMutexHandle);
+
+  /* Publish the sample */
+  sa_task_stat.rt_state = DC_SERVICE_ON;
+  (void)dc_com_write(&dc_com_db, DC_COM_TASK_STAT, (void *)&sa_task_stat, sizeof(sa_task_stat));
+}
+
+/**
+  * @brief  Write an unsigned LEB128 varint.
+  * @param  p_buf    - where to write (at least 5 bytes available)
+  * @param  value    - value to write
+  * @retval uint16_t - number of bytes written
+  */
+static uint16_t stack_analysis_put_varint(uint8_t *p_buf, uint32_t value)
+{
+  uint16_t len = 0U;
+  uint32_t remain = value;
+
+  while (remain >= 0x80U)
+  {
+    p_buf[len] = (uint8_t)((remain & 0x7FU) | 0x80U);
+    remain >>= 7;
+    len++;
+  }
+  p_buf[len] = (uint8_t)remain;
+  len++;
+
+  return len;
+}
+
+#if (USE_CMD_CONSOLE == 1)
+/**
+  * @brief  Display the last sample of the tasks usage
+  * @param  -
+  * @retval -
+  */
+static void stack_analysis_sampler_display(void)
+{
+  static sa_sample_t sample; /* static: too big for the console thread stack */
+  SA_CHAR_t name[STACK_ANALYSIS_SAMPLE_NAME_SIZE + 1U];
+
+  if (stackAnalysis_sampler_get(0U, &sample) == true)
+  {
+    PRINT_FORCE("<< Sampler Begin >>")
+    PRINT_FORCE("Time:%lu CPU:%u.%u%% Heap:%lu (min:%lu) Task number:%u",
+                sample.time_ms, sample.cpu_permille / 10U, sample.cpu_permille % 10U,
+                sample.heap_free, sample.heap_free_min, sample.task_nb)
+    for (uint8_t i = 0U; i < sample.task_nb; i++)
+    {
+      (void)memcpy((void *)name, (const void *)sample.task[i].name, STACK_ANALYSIS_SAMPLE_NAME_SIZE);
+      name[STACK_ANALYSIS_SAMPLE_NAME_SIZE] = (SA_CHAR_t)(0x00);
+      PRINT_FORCE("n:%2u %-4s CPU:%3u.%u%% FreeStack:%4u (init:%u)",
+                  sample.task[i].task_number, name,
+                  sample.task[i].cpu_permille / 10U, sample.task[i].cpu_permille % 10U,
+                  sample.task[i].stack_free_min, sample.task[i].stack_size)
+    }
+    PRINT_FORCE("<< Sampler End >>")
+  }
+  else
+  {
+    PRINT_FORCE("SA: no sample available yet")
+  }
+}
+#endif /* USE_CMD_CONSOLE == 1 */
+#endif /* STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
+
 /* Public functions ----------------------------------------------------------*/
 /**
   * @brief  Using TaskHandle to refer the task, add the task and its stack size at creation in the task List
@@ -806,11 +1063,11 @@ bool stackAnalysis_trace(void)
   return (result);
 }
 
-#if (STACK_ANALYSIS_TIMER != 0U)
+#if (USED_STACK_ANALYSIS_THREAD == 1)
 /**
   * @brief  Stack analysis thread
   * @note   Infinite loop Stack Analysis body
-  *         In case a periodical display is activated,
+  *         In case a periodical display or the sampler is activated,
   *         a task is needed to received the message of the timer and to display the task stack status
   *         callback is not used to do this because display is using freertos functions
   * @param  p_argument - unused
@@ -822,16 +1079,140 @@ static void stack_analysis_thread(void *p_argument)
 
   uint32_t msg_queue = 0U;
 
+#if (STACK_ANALYSIS_TIMER != 0U)
   (void)rtosalTimerStart(StackAnalysisTimerId, STACK_ANALYSIS_TIMER);
+#endif /* STACK_ANALYSIS_TIMER != 0U */
+#if (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)
+  (void)rtosalTimerStart(StackAnalysisSamplerTimerId, STACK_ANALYSIS_SAMPLER_PERIOD);
+#endif /* STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
 
   for (;;)
   {
     /* Wait instruction */
     (void)rtosalMessageQueueGet(StackAnalysisQueueId, &msg_queue, RTOSAL_WAIT_FOREVER);
-    (void)stackAnalysis_trace();
+#if (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)
+    if (msg_queue == SA_MSG_SAMPLE)
+    {
+      stack_analysis_sample();
+    }
+    else
+#endif /* STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
+    {
+      (void)stackAnalysis_trace();
+    }
   }
 }
-#endif /* STACK_ANALYSIS_TIMER != 0U */
+#endif /* USED_STACK_ANALYSIS_THREAD == 1 */
+
+#if (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)
+/**
+  * @brief  Get a sample of the task sampler ring
+  * @param  age      - 0: last sample, 1: previous one, ...
+  * @param  p_sample - sample copy
+  * @retval bool - false: no such sample (yet) / true: sample copied
+  */
+bool stackAnalysis_sampler_get(uint8_t age, sa_sample_t *p_sample)
+{
+  bool result = false;
+  uint8_t index;
+
+  if (p_sample != NULL)
+  {
+    (void)rtosalMutexAcquire(StackAnalysisMutexHandle, RTOSAL_WAIT_FOREVER);
+    if (age < sa_sampler_ring_nb)
+    {
+      index = (uint8_t)((sa_sampler_ring_next + STACK_ANALYSIS_SAMPLER_HISTORY - 1U - age)
+                        % STACK_ANALYSIS_SAMPLER_HISTORY);
+      (void)memcpy((void *)p_sample, (const void *)&sa_sampler_ring[index], sizeof(sa_sample_t));
+      result = true;
+    }
+    (void)rtosalMutexRelease(StackAnalysisMutexHandle);
+  }
+
+  return result;
+}
+
+/**
+  * @brief  Encode a sample in the compact binary format
+  * @param  p_sample - sample to encode
+  * @param  p_buf    - where to encode
+  * @param  size     - size of p_buf (STACK_ANALYSIS_SAMPLE_MAX_SIZE is always enough)
+  * @retval uint16_t - number of bytes written, 0 if p_buf is too small
+  */
+uint16_t stackAnalysis_sample_encode(const sa_sample_t *p_sample, uint8_t *p_buf, uint16_t size)
+{
+  uint16_t len = 0U;
+  uint8_t *p_out;
+
+  /* Check with the max size: varints length is not known before encoding */
+  if ((uint32_t)size >= STACK_ANALYSIS_SAMPLE_SIZE(p_sample->task_nb))
+  {
+    p_buf[0] = STACK_ANALYSIS_SAMPLE_FORMAT;
+    p_buf[1] = p_sample->task_nb;
+    p_buf[2] = (uint8_t)(p_sample->time_ms & 0xFFU);
+    p_buf[3] = (uint8_t)((p_sample->time_ms >> 8) & 0xFFU);
+    p_buf[4] = (uint8_t)((p_sample->time_ms >> 16) & 0xFFU);
+    p_buf[5] = (uint8_t)(p_sample->time_ms >> 24);
+    len = 6U;
+    len += stack_analysis_put_varint(&p_buf[len], p_sample->heap_free);
+    len += stack_analysis_put_varint(&p_buf[len], p_sample->heap_free_min);
+    len += stack_analysis_put_varint(&p_buf[len], (uint32_t)p_sample->cpu_permille);
+
+    for (uint8_t i = 0U; i < p_sample->task_nb; i++)
+    {
+      p_out = &p_buf[len];
+      p_out[0] = p_sample->task[i].task_number;
+      (void)memcpy((void *)&p_out[1], (const void *)p_sample->task[i].name, STACK_ANALYSIS_SAMPLE_NAME_SIZE);
+      len += 1U + (uint16_t)STACK_ANALYSIS_SAMPLE_NAME_SIZE;
+      len += stack_analysis_put_varint(&p_buf[len], (uint32_t)p_sample->task[i].cpu_permille);
+      len += stack_analysis_put_varint(&p_buf[len], (uint32_t)p_sample->task[i].stack_free_min);
+      len += stack_analysis_put_varint(&p_buf[len], (uint32_t)p_sample->task[i].stack_size);
+    }
+  }
+
+  return len;
+}
+
+/**
+  * @brief  Start the run time counter used by RTOS run time statistics
+  * @note   Called by RTOS (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS) when the scheduler starts
+  * @param  -
+  * @retval -
+  */
+void stackAnalysis_runtime_init(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  sa_runtime_cycles = 0U;
+  sa_runtime_cyccnt_last = 0U;
+}
+
+/**
+  * @brief  Get the run time counter used by RTOS run time statistics
+  * @note   Called by RTOS (portGET_RUN_TIME_COUNTER_VALUE) at each context switch
+  *         The DWT cycle counter wraps every 53s at 80MHz: it is extended on 64 bits,
+  *         so this function must be called at least once per wrap - done by the sampler
+  * @param  -
+  * @retval uint32_t - run time counter
+  */
+uint32_t stackAnalysis_runtime_get(void)
+{
+  UBaseType_t mask;
+  uint32_t cyccnt;
+  uint32_t result;
+
+  mask = portSET_INTERRUPT_MASK_FROM_ISR();
+  cyccnt = DWT->CYCCNT;
+  /* Unsigned subtraction: correct even if the cycle counter wrapped */
+  sa_runtime_cycles += (uint64_t)(cyccnt - sa_runtime_cyccnt_last);
+  sa_runtime_cyccnt_last = cyccnt;
+  result = (uint32_t)(sa_runtime_cycles >> SA_RUNTIME_SHIFT);
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+  return result;
+}
+#endif /* STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
 
 /**
   * @brief  Set stack analysis print format
@@ -883,11 +1264,21 @@ void stackAnalysis_init(void)
   {
     StackAnalysisTimerId = rtosalTimerNew(NULL, (os_ptimer)stack_analysis_timer_cb, osTimerPeriodic, NULL);
   }
+#endif /* STACK_ANALYSIS_TIMER != 0U */
+#if (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)
+  if (StackAnalysisSamplerTimerId == NULL)
+  {
+    StackAnalysisSamplerTimerId = rtosalTimerNew(NULL, (os_ptimer)stack_analysis_sampler_timer_cb,
+                                                 osTimerPeriodic, NULL);
+  }
+#endif /* STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
+#if (USED_STACK_ANALYSIS_THREAD == 1)
   if (StackAnalysisQueueId == NULL)
   {
-    StackAnalysisQueueId = rtosalMessageQueueNew(NULL, 2U);
+    /* one message per timer */
+    StackAnalysisQueueId = rtosalMessageQueueNew(NULL, 4U);
   }
-#endif /* STACK_ANALYSIS_TIMER != 0U */
+#endif /* USED_STACK_ANALYSIS_THREAD == 1 */
 }
 
 /**
@@ -898,15 +1289,24 @@ void stackAnalysis_init(void)
   */
 void stackAnalysis_start(void)
 {
-#if (STACK_ANALYSIS_TIMER != 0U)
+#if (USED_STACK_ANALYSIS_THREAD == 1)
   static osThreadId StackAnalysisTaskHandle;
-#endif /* STACK_ANALYSIS_TIMER != 0 */
+#endif /* USED_STACK_ANALYSIS_THREAD == 1 */
 
 #if (USE_CMD_CONSOLE == 1)
   CMD_Declare(stackAnalysis_cmd_label, stackAnalysis_cmd, (uint8_t *)"stack analysis");
 #endif /* USE_CMD_CONSOLE == 1 */
 
-#if (STACK_ANALYSIS_TIMER != 0U)
+#if (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)
+  /* Registration of the task sampler entry in Data Cache - available at the first sample */
+  (void)memset((void *)&sa_task_stat_dc, 0, sizeof(dc_task_stat_info_t));
+  (void)memset((void *)&sa_task_stat, 0, sizeof(dc_task_stat_info_t));
+  sa_task_stat_dc.rt_state = DC_SERVICE_UNAVAIL;
+  DC_COM_TASK_STAT = dc_com_register_serv(&dc_com_db, (void *)&sa_task_stat_dc,
+                                          (uint16_t)sizeof(dc_task_stat_info_t));
+#endif /* STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
+
+#if (USED_STACK_ANALYSIS_THREAD == 1)
   /* Create Stack Analysis thread  */
   StackAnalysisTaskHandle = rtosalThreadNew((const rtosal_char_t *)"StackAnalysisThread",
                                             (os_pthread)stack_analysis_thread,
@@ -919,7 +1319,7 @@ void stackAnalysis_start(void)
   {
     (void)stackAnalysis_addStackSizeByHandle(StackAnalysisTaskHandle, USED_STACK_ANALYSIS_THREAD_STACK_SIZE);
   }
-#endif /* STACK_ANALYSIS_TIMER != 0U */
+#endif /* USED_STACK_ANALYSIS_THREAD == 1 */
 }
 
 #endif /* USE_STACK_ANALYSIS == 1 */
@@ -0,0 +1,136 @@
+/**
+  ******************************************************************************
+  * @file    custom_telemetry.h
+  * @author  artworkTrackingMAP
+  * @brief   Header for custom_telemetry.c module
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef CUSTOM_TELEMETRY_H
+#define CUSTOM_TELEMETRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "plf_config.h"
+
+/**
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                    ##### Telemetry frame format #####
+  ==============================================================================
+
+  A frame packs several samples. All multi-bytes fields are little endian.
+
+  Frame header (6 bytes):
+    byte 0     : format version (CUSTOM_TELEMETRY_VERSION)
+    byte 1     : number of samples in the frame
+    byte 2..5  : time of the first sample in ms (uint32)
+
+  Then for each sample (6 to 10 bytes):
+    time delta in ms from the previous sample: unsigned LEB128 varint
+                 (7 bits per byte, bit 7 set when another byte follows; 0 for the first sample)
+    temperature: int16 in 0.01 degree C
+    humidity   : int16 in 0.01 %
+    signal     : int8 in dBm
+
+  When CUSTOM_CLIENT_TASK_STAT_FRAMES != 0, a frame with the threads statistics
+  is also sent every CUSTOM_CLIENT_TASK_STAT_FRAMES telemetry frames: its byte 0 is
+  STACK_ANALYSIS_SAMPLE_FORMAT, see stack_analysis_sampler.h for its format.
+
+  @endverbatim
+  */
+
+/* Exported constants --------------------------------------------------------*/
+#define CUSTOM_TELEMETRY_VERSION          ((uint8_t)1U)
+#define CUSTOM_TELEMETRY_HEADER_SIZE      6U
+/* varint time delta (5 bytes max for uint32) + temperature + humidity + signal */
+#define CUSTOM_TELEMETRY_SAMPLE_MAX_SIZE  (5U + 2U + 2U + 1U)
+
+/* Frame size: default is the Type1SC max data size of a socket send */
+#if !defined CUSTOM_CLIENT_FRAME_MAX_SIZE
+#define CUSTOM_CLIENT_FRAME_MAX_SIZE      (710U)
+#endif /* !defined CUSTOM_CLIENT_FRAME_MAX_SIZE */
+
+/* Exported types ------------------------------------------------------------*/
+/* Sample to encode: values already in fixed-point */
+typedef struct
+{
+  uint32_t time_ms;     /* sample time in ms                */
+  int16_t  temperature; /* temperature in 0.01 degree C     */
+  int16_t  humidity;    /* humidity in 0.01 %               */
+  int8_t   signal_dbm;  /* signal level in dBm              */
+} custom_telemetry_sample_t;
+
+/* Frame under construction */
+typedef struct
+{
+  uint8_t  buffer[CUSTOM_CLIENT_FRAME_MAX_SIZE];
+  uint16_t len;          /* number of bytes used in buffer */
+  uint8_t  nb_samples;   /* number of samples in buffer    */
+  uint32_t last_time_ms; /* time of the last sample added  */
+} custom_telemetry_frame_t;
+
+/* External variables --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported functions ------------------------------------------------------- */
+
+/**
+  * @brief  Reset a frame: no sample in it.
+  * @param  p_frame - frame to reset
+  * @retval -
+  */
+void custom_telemetry_reset(custom_telemetry_frame_t *p_frame);
+
+/**
+  * @brief  Encode a sample at the end of a frame.
+  * @param  p_frame  - frame to complete
+  * @param  p_sample - sample to encode
+  * @retval bool     - true: sample added, false: frame is full
+  */
+bool custom_telemetry_add(custom_telemetry_frame_t *p_frame, const custom_telemetry_sample_t *p_sample);
+
+/**
+  * @brief  Check if a new sample can still be added to a frame.
+  * @param  p_frame - frame to check
+  * @retval bool    - true: frame is full, false: a sample can be added
+  */
+bool custom_telemetry_is_full(const custom_telemetry_frame_t *p_frame);
+
+/**
+  * @brief  Decode a frame: reverse of custom_telemetry_add.
+  * @note   Used by the host tests, the log server does the same in Python.
+  * @param  p_buf         - frame received
+  * @param  len           - frame length in bytes
+  * @param  p_samples     - decoded samples
+  * @param  max_samples   - number of samples p_samples can hold
+  * @param  p_nb_samples  - number of samples decoded
+  * @retval bool          - true: frame decoded, false: frame is invalid or p_samples too small
+  */
+bool custom_telemetry_decode(const uint8_t *p_buf, uint16_t len,
+                             custom_telemetry_sample_t *p_samples, uint8_t max_samples, uint8_t *p_nb_samples);
+
+/**
+  * @brief  Convert a value to fixed-point 0.01 unit.
+  * @note   Result is rounded to the nearest value and saturated to int16 range.
+  * @param  value   - value to convert
+  * @retval int16_t - value * 100
+  */
+int16_t custom_telemetry_to_centi(float_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_TELEMETRY_H */
+
+/******************************** END OF FILE *********************************/
@@ -82,8 +82,10 @@ extern "C" {
                                           1: Use default parameters, no setup menu */
 
 /* Begin Stack analysis tools configuration */
-#define USE_STACK_ANALYSIS         (0) /* 0: Stack analysis is not embedded
+#define USE_STACK_ANALYSIS         (1) /* 0: Stack analysis is not embedded
                                           1: Stack analysis is available */
+/* CPU load, stack and heap usage of the threads sampled every 10s and uploaded by Custom client */
+#define STACK_ANALYSIS_SAMPLER_PERIOD (10000U)
 /* End Stack analysis tools configuration */
 
 
@@ -146,6 +148,19 @@ Note: doing this the global heap allocated in FreeRTOS will be fine
 #define CUSTOM_CLIENT_CMD                    (1U)  /* 0U: No usage of command module
                                                       1U: One command registration */
 
+/* Telemetry sent to the log server: samples are batched in binary frames (see custom_telemetry.h) */
+#define CUSTOM_CLIENT_FRAME_SAMPLES          (10U)   /* Number of samples sent in one frame */
+#define CUSTOM_CLIENT_FRAME_MAX_SIZE         (710U)  /* Max frame size in bytes */
+#define CUSTOM_CLIENT_FRAME_QUEUE_SIZE       (4U)    /* Frames kept while the data port is not connected */
+#define CUSTOM_CLIENT_RECONNECT_MIN_MS       (1000U) /* First delay before a data port reconnection */
+#define CUSTOM_CLIENT_RECONNECT_MAX_MS       (60000U) /* Max delay: doubled at each failure up to this value */
+/* Frames produced without network coverage are stored in a flash ring (feeprom_ring)
+   and sent after the reconnection - needs FEEPROM_UTILS_FLASH_USED == 1 */
+#define CUSTOM_CLIENT_FLASH_RING             (1)
+/* A frame with the threads statistics (DC_COM_TASK_STAT) is sent every N telemetry frames
+   0U: not sent - needs STACK_ANALYSIS_SAMPLER_PERIOD != 0U */
+#define CUSTOM_CLIENT_TASK_STAT_FRAMES       (6U)
+
 /* Active or not the debug trace in Custom Client */
 #if (SW_DEBUG_VERSION == 1U)
 #define USE_TRACE_CUSTOM_CLIENT              (1)  /* 1: Trace in Custom Client activated */
@@ -41,6 +41,13 @@
 #include "dc_mems.h"
 
 #include "cellular_service_utils.h"
+#include "custom_telemetry.h"
+#if (CUSTOM_CLIENT_FLASH_RING == 1)
+#include "feeprom_ring.h"
+#endif /* CUSTOM_CLIENT_FLASH_RING == 1 */
+#if (USE_STACK_ANALYSIS == 1)
+#include "stack_analysis_sampler.h"
+#endif /* USE_STACK_ANALYSIS == 1 */
 
 
 #define SERVER_LOG_IP                 	((uint32_t)857055654) /*13.60.194.107  222085739*/ /* 0x9B22D734U 52.215.34.155  2478242818 */     /* 52.47.67.227   0x342f43e3    875512803  */
@@ -49,6 +56,26 @@
 #define MUD_URL 						"13.60.22.32:6000/mud"
 #define MUD_DEVICE_ID					((int)1)
 
+/* Data port connection: queue of frames waiting to be sent and reconnection backoff */
+#if !defined CUSTOM_CLIENT_FRAME_QUEUE_SIZE
+#define CUSTOM_CLIENT_FRAME_QUEUE_SIZE  (4U)
+#endif /* !defined CUSTOM_CLIENT_FRAME_QUEUE_SIZE */
+#if !defined CUSTOM_CLIENT_RECONNECT_MIN_MS
+#define CUSTOM_CLIENT_RECONNECT_MIN_MS  (1000U)
+#endif /* !defined CUSTOM_CLIENT_RECONNECT_MIN_MS */
+#if !defined CUSTOM_CLIENT_RECONNECT_MAX_MS
+#define CUSTOM_CLIENT_RECONNECT_MAX_MS  (60000U)
+#endif /* !defined CUSTOM_CLIENT_RECONNECT_MAX_MS */
+
+/* Threads statistics frame sent every N telemetry frames */
+#if !defined CUSTOM_CLIENT_TASK_STAT_FRAMES
+#define CUSTOM_CLIENT_TASK_STAT_FRAMES  (0U)
+#endif /* !defined CUSTOM_CLIENT_TASK_STAT_FRAMES */
+#if ((CUSTOM_CLIENT_TASK_STAT_FRAMES != 0U) \
+     && ((USE_STACK_ANALYSIS == 0) || (STACK_ANALYSIS_SAMPLER_PERIOD == 0U)))
+#error "CUSTOM_CLIENT_TASK_STAT_FRAMES needs the stack analysis sampler (STACK_ANALYSIS_SAMPLER_PERIOD)"
+#endif /* CUSTOM_CLIENT_TASK_STAT_FRAMES needs the sampler */
+
 
 
 typedef struct
@@ -62,61 +89,76 @@ static logBuffer_t socketResponse;
 static logBuffer_t logBuffer;
 static uint16_t SERVER_LOG_PORT = -1;
 
-static bool custom_log_mems()
+/* Samples not yet sent to the log server */
+static custom_telemetry_frame_t telemetry_frame;
+
+/* Data port connection statistics */
+typedef struct
+{
+	uint32_t connects;             /* successful connections              */
+	uint32_t reconnects;           /* connections after a connection loss */
+	uint32_t connect_failures;     /* failed connection attempts          */
+	uint32_t bytes_sent;
+	uint32_t frames_sent;
+	uint32_t frames_dropped;       /* frames dropped because queue full   */
+	uint32_t frames_stored;        /* frames stored in flash ring         */
+	uint32_t send_latency_last_ms;
+	uint32_t send_latency_max_ms;
+	uint32_t send_latency_sum_ms;  /* to compute the average on frames_sent */
+} custom_conn_stat_t;
+
+/* Modem is attached true/false: updated by the datacache callback */
+static bool custom_client_modem_is_attached;
+
+/* Data port connection kept open between the frames */
+static int32_t  custom_data_socket = COM_SOCKET_INVALID_ID;
+static bool     custom_data_socket_lost = false; /* a connection has already been lost */
+static uint32_t custom_reconnect_delay_ms = 0U;  /* 0: no backoff on-going */
+static uint32_t custom_reconnect_tick;           /* time of the last connection failure */
+static custom_conn_stat_t custom_conn_stat;
+
+/* Frames waiting to be sent */
+static custom_telemetry_frame_t telemetry_queue[CUSTOM_CLIENT_FRAME_QUEUE_SIZE];
+static uint8_t telemetry_queue_head = 0U;
+static uint8_t telemetry_queue_count = 0U;
+
+/* Requests of the console: set by the console thread, treated by the custom client thread
+   which is the only one using the frames and the sockets */
+static bool custom_send_requested = false;
+static bool custom_mud_requested = false;
+
+#if (CUSTOM_CLIENT_TASK_STAT_FRAMES != 0U)
+/* Telemetry frames queued since the last threads statistics frame */
+static uint8_t task_stat_frame_count = 0U;
+#endif /* CUSTOM_CLIENT_TASK_STAT_FRAMES != 0U */
+
+static void custom_log_mems(custom_telemetry_sample_t *p_sample)
 {
 	dc_temperature_info_t   temperature_info;
 	dc_humidity_info_t		humidity_info;
-	char 					mems_string[64];
-	int						mems_string_len;
-
-	char str_tmp[100] = "";
-	char str_hum[100] = "";
-	char str_dbm[100] = "";
-	float temp_value = 0;
-	float hum_value = 0;
-	int32_t dbm_value = cst_cellular_info.cs_signal_level_db;
+	int32_t					dbm_value = cst_cellular_info.cs_signal_level_db;
+	int32_t					abs_value;
 
 	// read the MEM data
 	(void)dc_com_read(&dc_com_db, DC_COM_TEMPERATURE, (void *)&temperature_info, sizeof(temperature_info));
-    (void)dc_com_read(&dc_com_db, DC_COM_HUMIDITY, (void *)&humidity_info, sizeof(humidity_info));
-
-    temp_value = temperature_info.temperature;
-    int tempInt = (int)temp_value;
-	int tmpInt1 = temp_value;
-	float tmpFrac = temp_value - tmpInt1;
-	int tmpInt2 = trunc(tmpFrac * 100);
-
-	hum_value = humidity_info.humidity;
-	int humInt = (int)hum_value;
-	int humInt1 = hum_value;
-	float humFrac = hum_value - humInt1;
-	int humInt2 = trunc(humFrac * 100);
-
-	// convert to string the temperature and humidity
-    //mems_string_len= sprintf(mems_string,"time=%d;temperature=%f;humidity=%f;acceleration=%li, %li, %li",xTaskGetTickCount(),temperature_info.temperature, humidity_info.humidity, acc_data.AXIS_X, acc_data.AXIS_Y, acc_data.AXIS_Z);
-    //mems_string_len= sprintf(mems_string,"time=%lu;temperature=%f;humidity=%f",(unsigned long)time(NULL),temperature_info.temperature, humidity_info.humidity);
-    mems_string_len= sprintf(mems_string, "{\"time\": \"%d\",\"dbm\": \"%d\",\"temperature\": \"%f\",\"humidity\": \"%f\"}", xTaskGetTickCount(), dbm_value, temperature_info.temperature, humidity_info.humidity);
-
-    snprintf(str_tmp,100," TEMPERATURE = %d.%02d degree C\n\r", tmpInt1, tmpInt2);
-    snprintf(str_hum,100," HUMIDITY = %d.%02d %%\n\r", humInt1, humInt2);
-    snprintf(str_dbm, 100," DBM = %d\n\r", dbm_value);
-
-    HAL_UART_Transmit(&huart1,( uint8_t *)str_tmp,sizeof(str_tmp),1000);
-	HAL_UART_Transmit(&huart1,( uint8_t *)str_hum,sizeof(str_hum),1000);
-	HAL_UART_Transmit(&huart1,( uint8_t *)str_dbm,sizeof(str_dbm),1000);
+	(void)dc_com_read(&dc_com_db, DC_COM_HUMIDITY, (void *)&humidity_info, sizeof(humidity_info));
+
+	// fixed-point conversion: no float formatting
+	p_sample->time_ms     = xTaskGetTickCount();
+	p_sample->temperature = custom_telemetry_to_centi(temperature_info.temperature);
+	p_sample->humidity    = custom_telemetry_to_centi(humidity_info.humidity);
+	p_sample->signal_dbm  = (int8_t)((dbm_value < INT8_MIN) ? INT8_MIN : ((dbm_value > INT8_MAX) ? INT8_MAX : dbm_value));
+
+	// through the trace interface: the thread is not blocked by the UART transfer
+	abs_value = (p_sample->temperature < 0) ? -(int32_t)p_sample->temperature : (int32_t)p_sample->temperature;
+	PRINT_INFO(" TEMPERATURE = %s%ld.%02ld degree C\n\r",
+			   (p_sample->temperature < 0) ? "-" : "", abs_value / 100, abs_value % 100)
+	abs_value = (p_sample->humidity < 0) ? -(int32_t)p_sample->humidity : (int32_t)p_sample->humidity;
+	PRINT_INFO(" HUMIDITY = %s%ld.%02ld %%\n\r",
+			   (p_sample->humidity < 0) ? "-" : "", abs_value / 100, abs_value % 100)
+	PRINT_INFO(" DBM = %ld\n\r", dbm_value)
 
 	HAL_Delay(1000);
-	// append in logBuffer as string
-	if ((logBuffer.data_len + mems_string_len) <= (sizeof(logBuffer.data)))
-	{
-		memcpy(&logBuffer.data[logBuffer.data_len], (const void *)mems_string, mems_string_len);
-		logBuffer.data_len += mems_string_len;
-	}
-	else
-	{
-		return false;
-	}
-	return true;
 }
 uint16_t ntohs(uint16_t netshort) {
     return (netshort << 8) | (netshort >> 8);
@@ -160,7 +202,7 @@ static bool custom_connect_and_send_data(char * buffer_addr, int buffer_len, int
                 {
                    	int32_t 	ret;
                 	PRINT_INFO("Send data in progress....\n\r");
-                	PRINT_INFO("%s\n\r", buffer_addr);
+                	PRINT_INFO("%d bytes\n\r", buffer_len);
 
                 	ret = com_send(id, (const com_char_t *)buffer_addr, buffer_len, COM_MSG_WAIT);
                 	// Data send ok
@@ -224,6 +266,265 @@ static bool custom_connect_and_send_data(char * buffer_addr, int buffer_len, int
 	  return (result);
 }
 
+static void custom_conn_close(void)
+{
+	if (custom_data_socket != COM_SOCKET_INVALID_ID)
+	{
+		(void)com_closesocket(custom_data_socket);
+		custom_data_socket = COM_SOCKET_INVALID_ID;
+	}
+}
+
+static bool custom_conn_open(void)
+{
+	bool		result = false;
+	int32_t		timeout = 20000;
+	com_sockaddr_in_t address;
+
+	custom_data_socket = com_socket(COM_AF_INET, COM_SOCK_STREAM, COM_IPPROTO_TCP);
+	if (custom_data_socket >= 0)
+	{
+		if ((com_setsockopt(custom_data_socket, COM_SOL_SOCKET, COM_SO_RCVTIMEO, &timeout,
+							(int32_t)sizeof(timeout)) == COM_SOCKETS_ERR_OK)
+			&& (com_setsockopt(custom_data_socket, COM_SOL_SOCKET, COM_SO_SNDTIMEO, &timeout,
+							   (int32_t)sizeof(timeout)) == COM_SOCKETS_ERR_OK))
+		{
+			address.sin_family      = (uint8_t)COM_AF_INET;
+			address.sin_addr.s_addr = COM_HTONL(SERVER_LOG_IP);
+			address.sin_port        = COM_HTONS(SERVER_LOG_PORT);
+			if (com_connect(custom_data_socket, (com_sockaddr_t const *)&address,
+							(int32_t)sizeof(com_sockaddr_in_t)) == COM_SOCKETS_ERR_OK)
+			{
+				result = true;
+			}
+		}
+	}
+
+	if (result == true)
+	{
+		PRINT_INFO("data port connected\n\r")
+		custom_conn_stat.connects++;
+		if (custom_data_socket_lost == true)
+		{
+			custom_conn_stat.reconnects++;
+		}
+	}
+	else
+	{
+		PRINT_INFO("data port connection NOK\n\r")
+		custom_conn_stat.connect_failures++;
+		custom_conn_close();
+	}
+	return result;
+}
+
+static void custom_conn_failed(void)
+{
+	custom_conn_close();
+	// exponential backoff before the next connection attempt
+	if (custom_reconnect_delay_ms == 0U)
+	{
+		custom_reconnect_delay_ms = CUSTOM_CLIENT_RECONNECT_MIN_MS;
+	}
+	else if (custom_reconnect_delay_ms < (CUSTOM_CLIENT_RECONNECT_MAX_MS / 2U))
+	{
+		custom_reconnect_delay_ms *= 2U;
+	}
+	else
+	{
+		custom_reconnect_delay_ms = CUSTOM_CLIENT_RECONNECT_MAX_MS;
+	}
+	custom_reconnect_tick = HAL_GetTick();
+	PRINT_INFO("data port: next connection in %lu ms\n\r", custom_reconnect_delay_ms)
+}
+
+static bool custom_conn_send(const uint8_t *p_buf, uint32_t len)
+{
+	bool		result = false;
+	bool		connected = true;
+	int32_t		ret;
+	uint32_t	start_tick;
+	uint32_t	latency;
+
+	if (custom_data_socket == COM_SOCKET_INVALID_ID)
+	{
+		// connect only when network is up and backoff delay is elapsed
+		if ((custom_client_modem_is_attached == false)
+			|| ((custom_reconnect_delay_ms != 0U)
+				&& ((HAL_GetTick() - custom_reconnect_tick) < custom_reconnect_delay_ms)))
+		{
+			connected = false;
+		}
+		else if (custom_conn_open() == false)
+		{
+			custom_conn_failed();
+			connected = false;
+		}
+		else
+		{
+			/* connected: continue with the send */
+		}
+	}
+
+	if (connected == false)
+	{
+		/* frame kept: sent at the next attempt */
+	}
+	else
+	{
+		start_tick = HAL_GetTick();
+		ret = com_send(custom_data_socket, (const com_char_t *)p_buf, (int32_t)len, COM_MSG_WAIT);
+		latency = HAL_GetTick() - start_tick;
+
+		if (ret == (int32_t)len)
+		{
+			custom_conn_stat.bytes_sent += (uint32_t)ret;
+			custom_conn_stat.frames_sent++;
+			custom_conn_stat.send_latency_last_ms = latency;
+			custom_conn_stat.send_latency_sum_ms += latency;
+			if (latency > custom_conn_stat.send_latency_max_ms)
+			{
+				custom_conn_stat.send_latency_max_ms = latency;
+			}
+			custom_reconnect_delay_ms = 0U;
+			result = true;
+		}
+		else
+		{
+			// COM_SOCKETS_ERR_NONETWORK, COM_SOCKETS_ERR_CLOSING or partial send:
+			// connection is not usable anymore, frame is sent again after reconnection
+			PRINT_INFO("data port send NOK (%ld)\n\r", ret)
+			custom_data_socket_lost = true;
+			custom_conn_failed();
+		}
+	}
+	return result;
+}
+
+#if (CUSTOM_CLIENT_FLASH_RING == 1)
+static void custom_store_frame(const custom_telemetry_frame_t *p_frame)
+{
+	if (feeprom_ring_append(p_frame->buffer, (uint32_t)p_frame->len) == FEEPROM_RING_OK)
+	{
+		custom_conn_stat.frames_stored++;
+	}
+	else
+	{
+		PRINT_INFO("%d samples lost\n\r", p_frame->nb_samples)
+		custom_conn_stat.frames_dropped++;
+	}
+}
+#endif /* CUSTOM_CLIENT_FLASH_RING == 1 */
+
+static void custom_send_queue(void)
+{
+	bool		sent = true;
+	const custom_telemetry_frame_t *p_frame;
+#if (CUSTOM_CLIENT_FLASH_RING == 1)
+	const uint8_t *p_record;
+	uint32_t	record_size;
+
+	// frames stored in flash during the coverage loss are the oldest: send them first
+	while ((sent == true) && (feeprom_ring_peek(&p_record, &record_size) == FEEPROM_RING_OK))
+	{
+		sent = custom_conn_send(p_record, record_size);
+		if (sent == true)
+		{
+			(void)feeprom_ring_consume();
+		}
+	}
+#endif /* CUSTOM_CLIENT_FLASH_RING == 1 */
+
+	while ((sent == true) && (telemetry_queue_count != 0U))
+	{
+		p_frame = &telemetry_queue[telemetry_queue_head];
+		sent = custom_conn_send(p_frame->buffer, (uint32_t)p_frame->len);
+		if (sent == true)
+		{
+			telemetry_queue_head = (uint8_t)((telemetry_queue_head + 1U) % CUSTOM_CLIENT_FRAME_QUEUE_SIZE);
+			telemetry_queue_count--;
+		}
+	}
+}
+
+// get a free frame at the end of the queue: if the queue is full the oldest one is moved to flash (or dropped)
+static custom_telemetry_frame_t *custom_queue_alloc(void)
+{
+	uint8_t	tail;
+
+	if (telemetry_queue_count == CUSTOM_CLIENT_FRAME_QUEUE_SIZE)
+	{
+#if (CUSTOM_CLIENT_FLASH_RING == 1)
+		custom_store_frame(&telemetry_queue[telemetry_queue_head]);
+#else
+		PRINT_INFO("%d samples lost\n\r", telemetry_queue[telemetry_queue_head].nb_samples)
+		custom_conn_stat.frames_dropped++;
+#endif /* CUSTOM_CLIENT_FLASH_RING == 1 */
+		telemetry_queue_head = (uint8_t)((telemetry_queue_head + 1U) % CUSTOM_CLIENT_FRAME_QUEUE_SIZE);
+		telemetry_queue_count--;
+	}
+	tail = (uint8_t)((telemetry_queue_head + telemetry_queue_count) % CUSTOM_CLIENT_FRAME_QUEUE_SIZE);
+	telemetry_queue_count++;
+
+	return &telemetry_queue[tail];
+}
+
+#if (CUSTOM_CLIENT_TASK_STAT_FRAMES != 0U)
+// queue a frame with the last threads statistics published by the stack analysis sampler
+static void custom_queue_task_stat(void)
+{
+	static dc_task_stat_info_t task_stat_info; /* static: too big for the thread stack */
+	custom_telemetry_frame_t *p_frame;
+
+	if ((dc_com_read(&dc_com_db, DC_COM_TASK_STAT, (void *)&task_stat_info, sizeof(task_stat_info)) == DC_COM_OK)
+	    && (task_stat_info.rt_state == DC_SERVICE_ON))
+	{
+		p_frame = custom_queue_alloc();
+		custom_telemetry_reset(p_frame);
+		p_frame->len = stackAnalysis_sample_encode(&task_stat_info.sample, p_frame->buffer,
+		                                           (uint16_t)CUSTOM_CLIENT_FRAME_MAX_SIZE);
+		if (p_frame->len == 0U)
+		{
+			// too many threads for a frame: not sent
+			telemetry_queue_count--;
+		}
+	}
+}
+#endif /* CUSTOM_CLIENT_TASK_STAT_FRAMES != 0U */
+
+static void custom_send_telemetry(void)
+{
+#if (CUSTOM_CLIENT_FLASH_RING == 1)
+	if ((telemetry_frame.nb_samples != 0U) && (custom_client_modem_is_attached == false))
+	{
+		// no coverage: keep the frames in flash until the network is back
+		// queued frames are older: stored first to keep the order of the frames
+		while (telemetry_queue_count != 0U)
+		{
+			custom_store_frame(&telemetry_queue[telemetry_queue_head]);
+			telemetry_queue_head = (uint8_t)((telemetry_queue_head + 1U) % CUSTOM_CLIENT_FRAME_QUEUE_SIZE);
+			telemetry_queue_count--;
+		}
+		custom_store_frame(&telemetry_frame);
+		custom_telemetry_reset(&telemetry_frame);
+	}
+#endif /* CUSTOM_CLIENT_FLASH_RING == 1 */
+	if (telemetry_frame.nb_samples != 0U)
+	{
+		// queue the frame
+		(void)memcpy((void *)custom_queue_alloc(), (const void *)&telemetry_frame, sizeof(telemetry_frame));
+		custom_telemetry_reset(&telemetry_frame);
+#if (CUSTOM_CLIENT_TASK_STAT_FRAMES != 0U)
+		task_stat_frame_count++;
+		if (task_stat_frame_count >= CUSTOM_CLIENT_TASK_STAT_FRAMES)
+		{
+			task_stat_frame_count = 0U;
+			custom_queue_task_stat();
+		}
+#endif /* CUSTOM_CLIENT_TASK_STAT_FRAMES != 0U */
+	}
+	custom_send_queue();
+}
 
 /* To interact with Custom client through a Terminal connected to the target */
 #if ((USE_CMD_CONSOLE == 1) && (CUSTOM_CLIENT_CMD != 0U))
@@ -231,6 +532,9 @@ static bool custom_connect_and_send_data(char * buffer_addr, int buffer_len, int
 #endif /* (USE_CMD_CONSOLE == 1) && (CUSTOM_CLIENT_CMD != 0U) */
 
 /* Private defines -----------------------------------------------------------*/
+#if !defined CUSTOM_CLIENT_FRAME_SAMPLES
+#define CUSTOM_CLIENT_FRAME_SAMPLES  (10U) /* Number of samples sent in one frame */
+#endif /* !defined CUSTOM_CLIENT_FRAME_SAMPLES */
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
@@ -266,8 +570,6 @@ static bool custom_connect_and_send_data(char * buffer_addr, int buffer_len, int
 /* Private variables ---------------------------------------------------------*/
 static osMessageQId custom_client_queue; /* To communicate between datacache callback
                                             and custom client main thread */
-/* Example : */
-static bool custom_client_modem_is_attached; /* Modem is attached true/false */
 
 #if ((USE_CMD_CONSOLE == 1) && (CUSTOM_CLIENT_CMD != 0U))
 static uint8_t *custom_client_cmd_label = ((uint8_t *)"custclt"); /* string used to interact with custom client
@@ -320,6 +622,10 @@ static cmd_status_t custom_client_cmd_help(uint8_t *cmd_p,
             (CRC_CHAR_t *)custom_client_cmd_label,
             (CRC_CHAR_t *)custom_client_cmd_label)
   /* Describe below all other custom client command supported */
+  PRINT_APP("%s send       : send the pending samples to the log server\n\r",
+            (CRC_CHAR_t *)custom_client_cmd_label)
+  PRINT_APP("%s stat       : display data port connection statistics\n\r",
+            (CRC_CHAR_t *)custom_client_cmd_label)
 
   return (result);
 }
@@ -371,27 +677,47 @@ static cmd_status_t custom_client_cmd(uint8_t *cmd_line_p)
                     "send",
                     crs_strlen(argv_p[0])) == 0)
     {
-    	// connect to server and send
-		if (custom_connect_and_send_data(logBuffer.data, logBuffer.data_len, 0)== true)
-		{
-			memset(logBuffer.data, 0, sizeof(logBuffer.data));
-			logBuffer.data_len=0;
-		}
-		memset(logBuffer.data, 0, sizeof(logBuffer.data));
-		logBuffer.data_len=0;
+		// sent by the custom client thread at its next cycle
+		custom_send_requested = true;
+		PRINT_APP("send requested\n\r")
     }
     //send mud link
     else if (memcmp((CRC_CHAR_t *)argv_p[0],
 					"mud",
 					crs_strlen(argv_p[0])) == 0)
 	{
-		// connect to server and send mudlink
-		if (custom_connect_and_send_data(logBuffer.data, logBuffer.data_len, 0)== true)
-		{
-			memset(logBuffer.data, 0, sizeof(logBuffer.data));
-			logBuffer.data_len=0;
-		}
+		// connect to server and send mudlink: done by the custom client thread
+		custom_mud_requested = true;
+		PRINT_APP("mud link requested\n\r")
 	}
+    else if (memcmp((CRC_CHAR_t *)argv_p[0],
+                    "stat",
+                    crs_strlen(argv_p[0])) == 0)
+    {
+      PRINT_APP("data port         : %s\n\r",
+                (custom_data_socket == COM_SOCKET_INVALID_ID) ? "closed" : "connected")
+      PRINT_APP("connects          : %lu\n\r", custom_conn_stat.connects)
+      PRINT_APP("reconnects        : %lu\n\r", custom_conn_stat.reconnects)
+      PRINT_APP("connect failures  : %lu\n\r", custom_conn_stat.connect_failures)
+      PRINT_APP("frames sent       : %lu\n\r", custom_conn_stat.frames_sent)
+      PRINT_APP("bytes sent        : %lu\n\r", custom_conn_stat.bytes_sent)
+      PRINT_APP("frames queued     : %d\n\r", telemetry_queue_count)
+      PRINT_APP("frames dropped    : %lu\n\r", custom_conn_stat.frames_dropped)
+#if (CUSTOM_CLIENT_FLASH_RING == 1)
+      {
+        feeprom_ring_stat_t ring_stat;
+        feeprom_ring_get_stat(&ring_stat);
+        PRINT_APP("frames to flash   : %lu\n\r", custom_conn_stat.frames_stored)
+        PRINT_APP("flash ring        : stored %lu consumed %lu lost %lu erases %lu\n\r",
+                  ring_stat.records_stored, ring_stat.records_consumed,
+                  ring_stat.records_lost, ring_stat.page_erases)
+      }
+#endif /* CUSTOM_CLIENT_FLASH_RING == 1 */
+      PRINT_APP("send latency (ms) : last %lu max %lu avg %lu\n\r",
+                custom_conn_stat.send_latency_last_ms, custom_conn_stat.send_latency_max_ms,
+                (custom_conn_stat.frames_sent == 0U) ? 0U :
+                (custom_conn_stat.send_latency_sum_ms / custom_conn_stat.frames_sent))
+    }
     else if (memcmp((CRC_CHAR_t *)argv_p[0],
                     "help",
                     crs_strlen(argv_p[0])) == 0)
@@ -501,6 +827,7 @@ static void custom_client_thread(void *p_argument)
     /* Example : */
     /* Wait network is up to do something */
 	uint32_t msg_queue = 0U;
+	custom_telemetry_sample_t sample;
 	(void)rtosalMessageQueueGet(custom_client_queue, &msg_queue, RTOSAL_WAIT_FOREVER);
 
     /* Block for 5000ms. */
@@ -509,9 +836,35 @@ static void custom_client_thread(void *p_argument)
     for( ;; )
     {
         // Perform action here: log the mems
-        custom_log_mems();
-        uint8_t cmd[] = "custclt send";
-		custom_client_cmd(cmd);
+        custom_log_mems(&sample);
+        if (custom_telemetry_add(&telemetry_frame, &sample) == false)
+        {
+            // frame full: flush it, the sample starts the next one
+            custom_send_telemetry();
+            (void)custom_telemetry_add(&telemetry_frame, &sample);
+        }
+        if (custom_mud_requested == true)
+        {
+            custom_mud_requested = false;
+            if (custom_connect_and_send_data(logBuffer.data, logBuffer.data_len, 0) == true)
+            {
+                memset(logBuffer.data, 0, sizeof(logBuffer.data));
+                logBuffer.data_len = 0;
+            }
+        }
+        // send when enough samples are batched or when requested by the console
+        if ((custom_send_requested == true)
+            || (telemetry_frame.nb_samples >= CUSTOM_CLIENT_FRAME_SAMPLES)
+            || (custom_telemetry_is_full(&telemetry_frame) == true))
+        {
+            custom_send_requested = false;
+            custom_send_telemetry();
+        }
+        else
+        {
+            // frames still pending after a connection loss
+            custom_send_queue();
+        }
 
         // Wait for the next cycle.
         vTaskDelay( xDelay );
@@ -535,6 +888,15 @@ void custom_client_init(void)
   /* Example: */
   custom_client_modem_is_attached = false;
 
+  custom_telemetry_reset(&telemetry_frame);
+#if (CUSTOM_CLIENT_FLASH_RING == 1)
+  /* frames stored before a reset are sent when the network is up */
+  if (feeprom_ring_init() != FEEPROM_RING_OK)
+  {
+    PRINT_INFO("flash ring init NOK\n\r")
+  }
+#endif /* CUSTOM_CLIENT_FLASH_RING == 1 */
+
   /* CustomClient queue creation */
   custom_client_queue = rtosalMessageQueueNew(NULL, 1U);
   if (custom_client_queue == NULL)
@@ -552,12 +914,15 @@ void custom_client_init(void)
 void custom_client_start(void)
 {
   static osThreadId CustomClient_TaskHandle;
+  dc_com_reg_id_t dc_reg_id;
 
   /* Cellular is now initialized
     Registration to other components is now possible */
 
   /* Registration to datacache */
-  (void)dc_com_register_gen_event_cb(&dc_com_db, custom_client_notif_cb, (void *) NULL);
+  dc_reg_id = dc_com_register_gen_event_cb(&dc_com_db, custom_client_notif_cb, (void *) NULL);
+  /* Only network status is treated: no need to be notified for the other entries */
+  (void)dc_com_subscribe_res(&dc_com_db, dc_reg_id, DC_CELLULAR_NIFMAN_INFO);
 
 #if ((USE_CMD_CONSOLE == 1)  && (CUSTOM_CLIENT_CMD != 0U))
   CMD_Declare(custom_client_cmd_label, custom_client_cmd, (uint8_t *)"customclient commands");
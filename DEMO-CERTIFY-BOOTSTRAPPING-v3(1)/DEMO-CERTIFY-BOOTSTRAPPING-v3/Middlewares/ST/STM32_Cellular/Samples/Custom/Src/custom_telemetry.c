@@ -0,0 +1,287 @@
+/**
+  ******************************************************************************
+  * @file    custom_telemetry.c
+  * @author  artworkTrackingMAP
+  * @brief   Binary encoding and decoding of the Custom Client telemetry samples
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "plf_config.h"
+
+#if (USE_CUSTOM_CLIENT == 1)
+
+#include "custom_telemetry.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private defines -----------------------------------------------------------*/
+/* Max number of samples in a frame: the count is coded on one byte */
+#define CUSTOM_TELEMETRY_MAX_SAMPLES  255U
+
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Global variables ----------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint16_t custom_telemetry_put_varint(uint8_t *p_buf, uint32_t value);
+static void custom_telemetry_put_u16(uint8_t *p_buf, uint16_t value);
+static void custom_telemetry_put_u32(uint8_t *p_buf, uint32_t value);
+static uint16_t custom_telemetry_get_varint(const uint8_t *p_buf, uint16_t len, uint32_t *p_value);
+static uint16_t custom_telemetry_get_u16(const uint8_t *p_buf);
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Write an unsigned LEB128 varint.
+  * @param  p_buf    - where to write (at least 5 bytes available)
+  * @param  value    - value to write
+  * @retval uint16_t - number of bytes written
+  */
+static uint16_t custom_telemetry_put_varint(uint8_t *p_buf, uint32_t value)
+{
+  uint16_t len = 0U;
+  uint32_t remain = value;
+
+  while (remain >= 0x80U)
+  {
+    p_buf[len] = (uint8_t)((remain & 0x7FU) | 0x80U);
+    remain >>= 7;
+    len++;
+  }
+  p_buf[len] = (uint8_t)remain;
+  len++;
+
+  return len;
+}
+
+/**
+  * @brief  Write a 16 bits value in little endian.
+  * @param  p_buf - where to write
+  * @param  value - value to write
+  * @retval -
+  */
+static void custom_telemetry_put_u16(uint8_t *p_buf, uint16_t value)
+{
+  p_buf[0] = (uint8_t)(value & 0xFFU);
+  p_buf[1] = (uint8_t)(value >> 8);
+}
+
+/**
+  * @brief  Write a 32 bits value in little endian.
+  * @param  p_buf - where to write
+  * @param  value - value to write
+  * @retval -
+  */
+static void custom_telemetry_put_u32(uint8_t *p_buf, uint32_t value)
+{
+  custom_telemetry_put_u16(&p_buf[0], (uint16_t)(value & 0xFFFFU));
+  custom_telemetry_put_u16(&p_buf[2], (uint16_t)(value >> 16));
+}
+
+/**
+  * @brief  Read an unsigned LEB128 varint.
+  * @param  p_buf    - where to read
+  * @param  len      - number of bytes available in p_buf
+  * @param  p_value  - value read
+  * @retval uint16_t - number of bytes read, 0 if the varint is truncated or too long
+  */
+static uint16_t custom_telemetry_get_varint(const uint8_t *p_buf, uint16_t len, uint32_t *p_value)
+{
+  uint16_t result = 0U;
+  uint16_t i = 0U;
+  uint32_t value = 0U;
+  bool end = false;
+
+  /* 5 bytes max for an uint32 */
+  while ((end == false) && (i < len) && (i < 5U))
+  {
+    value |= ((uint32_t)p_buf[i] & 0x7FU) << (7U * i);
+    if ((p_buf[i] & 0x80U) == 0U)
+    {
+      end = true;
+      result = i + 1U;
+    }
+    i++;
+  }
+  *p_value = value;
+
+  return result;
+}
+
+/**
+  * @brief  Read a 16 bits value in little endian.
+  * @param  p_buf    - where to read
+  * @retval uint16_t - value read
+  */
+static uint16_t custom_telemetry_get_u16(const uint8_t *p_buf)
+{
+  return (uint16_t)((uint16_t)p_buf[0] | ((uint16_t)p_buf[1] << 8));
+}
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+  * @brief  Reset a frame: no sample in it.
+  * @param  p_frame - frame to reset
+  * @retval -
+  */
+void custom_telemetry_reset(custom_telemetry_frame_t *p_frame)
+{
+  p_frame->buffer[0] = CUSTOM_TELEMETRY_VERSION;
+  p_frame->buffer[1] = 0U;
+  custom_telemetry_put_u32(&p_frame->buffer[2], 0U);
+  p_frame->len = (uint16_t)CUSTOM_TELEMETRY_HEADER_SIZE;
+  p_frame->nb_samples = 0U;
+  p_frame->last_time_ms = 0U;
+}
+
+/**
+  * @brief  Encode a sample at the end of a frame.
+  * @param  p_frame  - frame to complete
+  * @param  p_sample - sample to encode
+  * @retval bool     - true: sample added, false: frame is full
+  */
+bool custom_telemetry_add(custom_telemetry_frame_t *p_frame, const custom_telemetry_sample_t *p_sample)
+{
+  bool result;
+  uint8_t *p_buf;
+
+  if (custom_telemetry_is_full(p_frame) == true)
+  {
+    result = false;
+  }
+  else
+  {
+    if (p_frame->nb_samples == 0U)
+    {
+      /* First sample time is the frame reference time */
+      custom_telemetry_put_u32(&p_frame->buffer[2], p_sample->time_ms);
+      p_frame->last_time_ms = p_sample->time_ms;
+    }
+
+    p_buf = &p_frame->buffer[p_frame->len];
+    /* Unsigned subtraction: correct even if the tick counter wrapped */
+    p_frame->len += custom_telemetry_put_varint(p_buf, p_sample->time_ms - p_frame->last_time_ms);
+    p_buf = &p_frame->buffer[p_frame->len];
+    custom_telemetry_put_u16(&p_buf[0], (uint16_t)p_sample->temperature);
+    custom_telemetry_put_u16(&p_buf[2], (uint16_t)p_sample->humidity);
+    p_buf[4] = (uint8_t)p_sample->signal_dbm;
+    p_frame->len += 5U;
+
+    p_frame->last_time_ms = p_sample->time_ms;
+    p_frame->nb_samples++;
+    p_frame->buffer[1] = p_frame->nb_samples;
+    result = true;
+  }
+
+  return result;
+}
+
+/**
+  * @brief  Check if a new sample can still be added to a frame.
+  * @param  p_frame - frame to check
+  * @retval bool    - true: frame is full, false: a sample can be added
+  */
+bool custom_telemetry_is_full(const custom_telemetry_frame_t *p_frame)
+{
+  return (((uint32_t)p_frame->len + CUSTOM_TELEMETRY_SAMPLE_MAX_SIZE) > CUSTOM_CLIENT_FRAME_MAX_SIZE)
+         || (p_frame->nb_samples >= CUSTOM_TELEMETRY_MAX_SAMPLES);
+}
+
+/**
+  * @brief  Decode a frame: reverse of custom_telemetry_add.
+  * @note   Used by the host tests, the log server does the same in Python.
+  * @param  p_buf         - frame received
+  * @param  len           - frame length in bytes
+  * @param  p_samples     - decoded samples
+  * @param  max_samples   - number of samples p_samples can hold
+  * @param  p_nb_samples  - number of samples decoded
+  * @retval bool          - true: frame decoded, false: frame is invalid or p_samples too small
+  */
+bool custom_telemetry_decode(const uint8_t *p_buf, uint16_t len,
+                             custom_telemetry_sample_t *p_samples, uint8_t max_samples, uint8_t *p_nb_samples)
+{
+  bool result;
+  uint16_t offset = (uint16_t)CUSTOM_TELEMETRY_HEADER_SIZE;
+  uint16_t varint_len;
+  uint32_t time_ms;
+  uint32_t delta;
+  uint8_t count;
+  uint8_t i = 0U;
+
+  *p_nb_samples = 0U;
+  if ((len < CUSTOM_TELEMETRY_HEADER_SIZE) || (p_buf[0] != CUSTOM_TELEMETRY_VERSION) || (p_buf[1] > max_samples))
+  {
+    result = false;
+  }
+  else
+  {
+    count = p_buf[1];
+    time_ms = (uint32_t)custom_telemetry_get_u16(&p_buf[2]) | ((uint32_t)custom_telemetry_get_u16(&p_buf[4]) << 16);
+    result = true;
+    while ((result == true) && (i < count))
+    {
+      varint_len = custom_telemetry_get_varint(&p_buf[offset], len - offset, &delta);
+      /* varint then temperature, humidity and signal */
+      if ((varint_len == 0U) || (((uint32_t)offset + varint_len + 5U) > len))
+      {
+        result = false;
+      }
+      else
+      {
+        offset += varint_len;
+        time_ms += delta;
+        p_samples[i].time_ms     = time_ms;
+        p_samples[i].temperature = (int16_t)custom_telemetry_get_u16(&p_buf[offset]);
+        p_samples[i].humidity    = (int16_t)custom_telemetry_get_u16(&p_buf[offset + 2U]);
+        p_samples[i].signal_dbm  = (int8_t)p_buf[offset + 4U];
+        offset += 5U;
+        i++;
+      }
+    }
+    /* no trailing bytes after the last sample */
+    if ((result == true) && (offset != len))
+    {
+      result = false;
+    }
+    if (result == true)
+    {
+      *p_nb_samples = count;
+    }
+  }
+
+  return result;
+}
+
+/**
+  * @brief  Convert a value to fixed-point 0.01 unit.
+  * @note   Result is rounded to the nearest value and saturated to int16 range.
+  * @param  value   - value to convert
+  * @retval int16_t - value * 100
+  */
+int16_t custom_telemetry_to_centi(float_t value)
+{
+  int16_t result;
+  float_t centi = value * 100.0f;
+
+  if (isnan(centi) != 0)
+  {
+    result = 0;
+  }
+  else if (centi >= 32767.0f)
+  {
+    result = INT16_MAX;
+  }
+  else if (centi <= -32768.0f)
+  {
+    result = INT16_MIN;
+  }
+  else
+  {
+    result = (int16_t)((centi >= 0.0f) ? (centi + 0.5f) : (centi - 0.5f));
+  }
+
+  return result;
+}
+
+#endif /* USE_CUSTOM_CLIENT == 1 */
+
+/******************************** END OF FILE *********************************/
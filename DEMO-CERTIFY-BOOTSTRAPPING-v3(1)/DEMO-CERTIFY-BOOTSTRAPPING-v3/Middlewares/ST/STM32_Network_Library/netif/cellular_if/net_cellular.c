@@ -74,9 +74,12 @@ typedef struct
   bool use_internal_sim;
 } cellular_data_t;
 
+/* Channel: socket number given to the network library.
+   The com socket ids are not channel indexes: an id is never reused, whatever its value */
 typedef struct
 {
   uint8_t  status;
+  int32_t  com_socket;
 } cellular_Channel_t;
 
 /* Private variables ---------------------------------------------------------*/
@@ -87,6 +90,7 @@ static volatile bool stop_requested;
 static dc_cellular_info_t dc_cellular_info;
 
 static cellular_Channel_t CellularChannel[NET_CELLULAR_MAX_CHANNEL_NBR] = {.0};
+static osMutexId CellularChannelMutex = NULL;
 
 
 
@@ -108,6 +112,8 @@ static int32_t net_cellular_bind(int32_t sock, const net_sockaddr_t *addr, uint3
 static int32_t net_cellular_listen(int32_t sock, int32_t backlog);
 static int32_t net_cellular_accept(int32_t sock, net_sockaddr_t *addr, uint32_t *addrlen);
 static int32_t net_cellular_connect(int32_t sock, const net_sockaddr_t *addr, uint32_t addrlen);
+static int32_t net_cellular_channel_alloc(int32_t com_socket, uint8_t status);
+static int32_t net_cellular_channel_get(int32_t sock);
 static int32_t net_cellular_send(int32_t sock, uint8_t *buf, int32_t len, int32_t flags);
 static int32_t net_cellular_recv(int32_t sock, uint8_t *buf, int32_t len, int32_t flags);
 static int32_t net_cellular_sendto(int32_t sock, uint8_t *buf, int32_t len, int32_t flags, net_sockaddr_t *to,
@@ -265,6 +271,11 @@ static int32_t net_cellular_if_init(net_if_handle_t *pnetif)
   /* statical init of cellular components */
   connection_requested = false;
   stop_requested = false;
+  if (CellularChannelMutex == NULL)
+  {
+    osMutexDef(CellIfChannelMutex);
+    CellularChannelMutex = osMutexCreate(osMutex(CellIfChannelMutex));
+  }
   cellular_init();
 
   return  NET_OK;
@@ -466,17 +477,11 @@ static int32_t net_cellular_socket(int32_t domain, int32_t type, int32_t protoco
     {
       NET_DBG_INFO("Found socket : %lu\n", net_socketv);
 
-      if (net_socketv < NET_CELLULAR_MAX_CHANNEL_NBR)
-      {
-        CellularChannel[net_socketv].status = CELLULAR_ALLOCATED_SOCKET;
-        ret = net_socketv;
-      }
-      else
+      ret = net_cellular_channel_alloc(net_socketv, CELLULAR_ALLOCATED_SOCKET);
+      if (ret < 0)
       {
-        NET_DBG_ERROR("More socket supported (%lu) than allowed (%d)",
-                      net_socketv,
-                      NET_CELLULAR_MAX_CHANNEL_NBR);
-        ret = NET_ERROR_INVALID_SOCKET;
+        NET_DBG_ERROR("More socket supported than allowed (%d)", NET_CELLULAR_MAX_CHANNEL_NBR);
+        (void) com_closesocket(net_socketv);
       }
     }
     else
@@ -492,10 +497,11 @@ static int32_t net_cellular_socket(int32_t domain, int32_t type, int32_t protoco
 static int32_t net_cellular_bind(int32_t sock, const net_sockaddr_t *addr, uint32_t addrlen)
 {
   int32_t ret;
+  int32_t com_sock = net_cellular_channel_get(sock);
   (void) addrlen;
   com_sockaddr_t saddr;
   netsockaddr2com(&saddr, addr, sizeof(com_sockaddr_t));
-  ret = com_bind(sock, &saddr, (int32_t) sizeof(com_sockaddr_t));
+  ret = com_bind(com_sock, &saddr, (int32_t) sizeof(com_sockaddr_t));
 
   return (ret == COM_SOCKETS_ERR_OK) ? NET_OK : NET_ERROR_GENERIC;
 }
@@ -503,7 +509,7 @@ static int32_t net_cellular_bind(int32_t sock, const net_sockaddr_t *addr, uint3
 static int32_t net_cellular_listen(int32_t sock, int32_t backlog)
 {
   int32_t ret;
-  ret = com_listen(sock, backlog);
+  ret = com_listen(net_cellular_channel_get(sock), backlog);
   return (ret == COM_SOCKETS_ERR_OK) ? NET_OK : NET_ERROR_GENERIC;
 }
 
@@ -513,13 +519,13 @@ static int32_t net_cellular_accept(int32_t sock, net_sockaddr_t *addr, uint32_t
   com_sockaddr_t        com_addr;
   int32_t               addrlen = (int32_t) sizeof(com_sockaddr_t);
 
-  ret = com_accept(sock, &com_addr, &addrlen);
-  if (ret > 0)
+  ret = com_accept(net_cellular_channel_get(sock), &com_addr, &addrlen);
+  if (ret >= 0)
   {
     com2netsockaddr(addr, &com_addr, *addrlenv);
-    CellularChannel[ret].status = CELLULAR_CONNECTED_SOCKET_RW;
+    ret = net_cellular_channel_alloc(ret, CELLULAR_CONNECTED_SOCKET_RW);
   }
-  return (ret > 0) ? ret : NET_ERROR_GENERIC;
+  return (ret >= 0) ? ret : NET_ERROR_GENERIC;
 
 }
 
@@ -541,10 +547,11 @@ static int32_t net_cellular_connect(int32_t sock, const net_sockaddr_t *addrp, u
   int32_t  ret;
   uint16_t            port;
   net_sockaddr_t        addr;
+  int32_t  com_sock = net_cellular_channel_get(sock);
 
   (void) memcpy(&addr, addrp, addrlen);
 
-  if ((sock < 0) || (sock >= NET_CELLULAR_MAX_CHANNEL_NBR))
+  if (com_sock < 0)
   {
     NET_DBG_ERROR("invalid socket");
     ret = NET_ERROR_INVALID_SOCKET;
@@ -560,7 +567,7 @@ static int32_t net_cellular_connect(int32_t sock, const net_sockaddr_t *addrp, u
       net_set_port(&addr, port);
 
       addr.sa_family = COM_AF_INET;
-      if (com_connect(sock,
+      if (com_connect(com_sock,
                       /*cstat -MISRAC2012-Rule-11.3 */
                       (com_sockaddr_t *) &addr,
                       /*cstat +MISRAC2012-Rule-11.3*/
@@ -585,6 +592,53 @@ static int32_t net_cellular_connect(int32_t sock, const net_sockaddr_t *addrp, u
   return ret;
 }
 
+/**
+  * @brief  Allocate a channel to a com socket
+  * @param  com_socket com socket id returned by com_socket() or com_accept()
+  *         status     status of the channel
+  * @retval ret
+  *          <  0  : no free channel.
+  *          >= 0  : channel, the socket number of the network library.
+  */
+static int32_t net_cellular_channel_alloc(int32_t com_socket, uint8_t status)
+{
+  int32_t ret = NET_ERROR_INVALID_SOCKET;
+
+  (void) osMutexWait(CellularChannelMutex, osWaitForever);
+  for (int32_t i = 0; (i < NET_CELLULAR_MAX_CHANNEL_NBR) && (ret < 0); i++)
+  {
+    if (CellularChannel[i].status == CELLULAR_FREE_SOCKET)
+    {
+      CellularChannel[i].status = status;
+      CellularChannel[i].com_socket = com_socket;
+      ret = i;
+    }
+  }
+  (void) osMutexRelease(CellularChannelMutex);
+
+  return ret;
+}
+
+/**
+  * @brief  Get the com socket of a channel
+  * @param  sock channel, the socket number of the network library
+  * @retval ret
+  *          <  0  : channel not allocated.
+  *          >= 0  : com socket id.
+  */
+static int32_t net_cellular_channel_get(int32_t sock)
+{
+  int32_t ret = NET_ERROR_INVALID_SOCKET;
+
+  if ((sock >= 0) && (sock < NET_CELLULAR_MAX_CHANNEL_NBR)
+      && (CellularChannel[sock].status != CELLULAR_FREE_SOCKET))
+  {
+    ret = CellularChannel[sock].com_socket;
+  }
+
+  return ret;
+}
+
 /**
   * @brief  Generate a Random Local Port between 49152 and 65535
   *
@@ -680,9 +734,9 @@ static int32_t conv(int32_t retv)
 static int32_t net_cellular_send(int32_t sock, uint8_t *buf, int32_t len, int32_t flags)
 {
   int32_t  ret;
+  int32_t  com_sock = net_cellular_channel_get(sock);
 
-
-  if ((sock < 0) || (sock >= NET_CELLULAR_MAX_CHANNEL_NBR))
+  if (com_sock < 0)
   {
     NET_DBG_ERROR("invalid socket");
     ret = NET_ERROR_INVALID_SOCKET;
@@ -699,7 +753,7 @@ static int32_t net_cellular_send(int32_t sock, uint8_t *buf, int32_t len, int32_
 
       NET_DBG_INFO("Trying to send (%lu) on socket %ld\n", len, sock);
 
-      ret = com_send(sock,
+      ret = com_send(com_sock,
                      buf,
                      len,
                      (((uint8_t) flags & NET_MSG_DONTWAIT) != 0U) ? COM_MSG_DONTWAIT : COM_MSG_WAIT);
@@ -736,8 +790,9 @@ static int32_t net_cellular_send(int32_t sock, uint8_t *buf, int32_t len, int32_
 static int32_t net_cellular_recv(int32_t sock, uint8_t *buf, int32_t len, int32_t flags)
 {
   int32_t ret;
+  int32_t com_sock = net_cellular_channel_get(sock);
 
-  if ((sock < 0) || (sock >= NET_CELLULAR_MAX_CHANNEL_NBR))
+  if (com_sock < 0)
   {
     NET_DBG_ERROR("invalid socket");
     ret = NET_ERROR_INVALID_SOCKET;
@@ -752,7 +807,7 @@ static int32_t net_cellular_recv(int32_t sock, uint8_t *buf, int32_t len, int32_
     else
     {
       NET_DBG_INFO("com_recv in progress of %ld bytes\n", len);
-      ret = com_recv(sock,
+      ret = com_recv(com_sock,
                      buf,
                      len,
                      (((uint8_t)flags & NET_MSG_DONTWAIT) != 0U) ? COM_MSG_DONTWAIT : COM_MSG_WAIT);
@@ -778,7 +833,7 @@ static int32_t net_cellular_sendto(int32_t sock, uint8_t *buf, int32_t len, int3
   com_sockaddr_t addr;
   (void) tolen;
   netsockaddr2com(&addr, to, sizeof(com_sockaddr_t));
-  ret = com_sendto(sock, buf, len, flags, &addr, (int32_t) sizeof(com_sockaddr_t));
+  ret = com_sendto(net_cellular_channel_get(sock), buf, len, flags, &addr, (int32_t) sizeof(com_sockaddr_t));
 
   return conv(ret);
 }
@@ -790,7 +845,7 @@ static int32_t net_cellular_recvfrom(int32_t sock, uint8_t *buf, int32_t len, in
   com_sockaddr_t addr;
   int32_t addrlen = (int32_t) sizeof(com_sockaddr_t);
 
-  ret = com_recvfrom(sock, buf, len, flags, &addr, &addrlen);
+  ret = com_recvfrom(net_cellular_channel_get(sock), buf, len, flags, &addr, &addrlen);
   if (ret >= 0)
   {
     com2netsockaddr(from, &addr, *fromlen);
@@ -819,9 +874,10 @@ static int32_t net_cellular_setsockopt(int32_t sock, int32_t level, int32_t optn
   /*cstat -MISRAC2012-Rule-11.5 -MISRAC2012-Rule-11.8 */
   int32_t       *optint32 = (int32_t *) optvalue;
   /*cstat +MISRAC2012-Rule-11.5 +MISRAC2012-Rule-11.8 */
+  int32_t       com_sock = net_cellular_channel_get(sock);
   (void) level;
   (void) optlen;
-  if ((sock < 0) || (sock >= NET_CELLULAR_MAX_CHANNEL_NBR))
+  if (com_sock < 0)
   {
     NET_DBG_ERROR("invalid socket");
     ret = NET_ERROR_INVALID_SOCKET;
@@ -833,7 +889,7 @@ static int32_t net_cellular_setsockopt(int32_t sock, int32_t level, int32_t optn
       case NET_SO_RCVTIMEO:
         if (NULL != optvalue)
         {
-          if (0 == com_setsockopt(sock, COM_SOL_SOCKET, COM_SO_RCVTIMEO, optint32, (int32_t) sizeof(int)))
+          if (0 == com_setsockopt(com_sock, COM_SOL_SOCKET, COM_SO_RCVTIMEO, optint32, (int32_t) sizeof(int)))
           {
             ret = NET_OK;
           }
@@ -843,7 +899,7 @@ static int32_t net_cellular_setsockopt(int32_t sock, int32_t level, int32_t optn
       case NET_SO_SNDTIMEO:
         if (NULL != optvalue)
         {
-          if (0 == com_setsockopt(sock, COM_SOL_SOCKET, COM_SO_SNDTIMEO, optint32, (int32_t) sizeof(int)))
+          if (0 == com_setsockopt(com_sock, COM_SOL_SOCKET, COM_SO_SNDTIMEO, optint32, (int32_t) sizeof(int)))
           {
             ret = NET_OK;
           }
@@ -897,8 +953,9 @@ static int32_t net_cellular_getpeername(int32_t sock, net_sockaddr_t *name, uint
 static int32_t net_cellular_close(int32_t sock, bool isaclone)
 {
   int32_t ret;
+  int32_t com_sock = net_cellular_channel_get(sock);
   (void) isaclone;
-  if ((sock < 0) || (sock >= NET_CELLULAR_MAX_CHANNEL_NBR))
+  if (com_sock < 0)
   {
     NET_DBG_ERROR("invalid socket");
     ret = NET_ERROR_INVALID_SOCKET;
@@ -907,7 +964,7 @@ static int32_t net_cellular_close(int32_t sock, bool isaclone)
   {
     NET_DBG_INFO("Trying to close socket %ld\n", sock);
 
-    if (com_closesocket(sock) == COM_SOCKETS_ERR_OK)
+    if (com_closesocket(com_sock) == COM_SOCKETS_ERR_OK)
     {
       NET_DBG_INFO("socket %ld is now closed\n", sock);
       ret = NET_OK;
@@ -917,7 +974,10 @@ static int32_t net_cellular_close(int32_t sock, bool isaclone)
       NET_DBG_ERROR("socket %ld cannot be closed", sock);
       ret = NET_ERROR_SOCKET_FAILURE;
     }
+    (void) osMutexWait(CellularChannelMutex, osWaitForever);
+    CellularChannel[sock].com_socket = COM_SOCKET_INVALID_ID;
     CellularChannel[sock].status = CELLULAR_FREE_SOCKET;
+    (void) osMutexRelease(CellularChannelMutex);
   }
   return ret;
 }
@@ -926,7 +986,7 @@ static int32_t net_cellular_shutdown(int32_t sock, int32_t mode)
 {
   int32_t ret = NET_OK;
 
-  if ((sock < 0) || (sock >= NET_CELLULAR_MAX_CHANNEL_NBR))
+  if (net_cellular_channel_get(sock) < 0)
   {
     NET_DBG_ERROR("invalid socket");
     ret = NET_ERROR_INVALID_SOCKET;
@@ -1195,6 +1255,7 @@ static void cellif_input(void const  *argument)
               for (int32_t i = 0; i < NET_CELLULAR_MAX_CHANNEL_NBR; i++)
               {
                 CellularChannel[i].status          = CELLULAR_FREE_SOCKET;
+                CellularChannel[i].com_socket      = COM_SOCKET_INVALID_ID;
               }
               (void) net_state_manage_event(pnetif, NET_EVENT_INTERFACE_READY);
             }
@@ -942,12 +942,25 @@ struct mqtt_queued_message {
     uint16_t packet_id;
 };
 
+/**
+ * @brief The average size of a message, used to share the message queue's memory block
+ *        between the messages and their mqtt_queued_message.
+ * @ingroup details
+ */
+#ifndef MQTT_MQ_MSG_SIZE_AVG
+#define MQTT_MQ_MSG_SIZE_AVG 64
+#endif
+
 /**
  * @brief A message queue.
  * @ingroup details
  * 
  * @note This struct is used internally to manage sending messages.
  * @note The only members the user should use are \c curr and \c curr_sz. 
+ * @note The messages and the mqtt_queued_message's are two rings: a message is never moved
+ *       once packed, removing the messages at the front of the queue is O(1) per message.
+ *       A message is packed in one piece, at the end of the memory block or, once wrapped,
+ *       at its start.
  */
 struct mqtt_message_queue {
     /** 
@@ -971,19 +984,40 @@ struct mqtt_message_queue {
     /**
      * @brief The number of bytes that can be written to \c curr.
      * 
-     * @note curr_sz will decrease by more than the number of bytes you write to 
-     *       \c curr. This is because the mqtt_queued_message structs share the 
-     *       same memory (and thus, a mqtt_queued_message must be allocated in 
-     *       the message queue's memory whenever a new message is registered).  
+     * @note curr_sz is 0 when all the mqtt_queued_message's are used, even if
+     *       there is room for the bytes of a message.
      */
     size_t curr_sz;
     
     /**
-     * @brief The tail of the array of mqtt_queued_messages's.
+     * @brief The end of the messages' memory, the mqtt_queued_message's ring follows.
      * 
      * @note This member should not be used manually.
      */
-    struct mqtt_queued_message *queue_tail;
+    uint8_t *data_end;
+
+    /**
+     * @brief Non-zero if \c curr wrapped to \c mem_start before the first message.
+     * 
+     * @note This member should not be used manually.
+     */
+    int wrapped;
+
+    /**
+     * @brief The ring of mqtt_queued_messages's.
+     * 
+     * @note This member should not be used manually.
+     */
+    struct mqtt_queued_message *queue;
+
+    /** @brief The number of mqtt_queued_message's in \c queue. */
+    size_t queue_size;
+
+    /** @brief The index in \c queue of the first message. */
+    size_t queue_head;
+
+    /** @brief The number of messages in the queue. */
+    size_t queue_len;
 };
 
 /**
@@ -1003,6 +1037,8 @@ void mqtt_mq_init(struct mqtt_message_queue *mq, void *buf, size_t bufsz);
  * @ingroup details
  * 
  * @note Calls to this function are the \em only way to remove messages from the queue.
+ * @note The messages are not moved: \c curr wraps to the start of the buffer when there
+ *       is more room there than at the end of the buffer.
  * 
  * @param mq The message queue.
  * 
@@ -1042,28 +1078,55 @@ struct mqtt_queued_message* mqtt_mq_register(struct mqtt_message_queue *mq, size
  */
 struct mqtt_queued_message* mqtt_mq_find(struct mqtt_message_queue *mq, enum MQTTControlPacketType control_type, uint16_t *packet_id);
 
+/**
+ * @brief Used internally to recalculate the \c curr_sz.
+ * @ingroup details
+ */
+size_t mqtt_mq_currsz(const struct mqtt_message_queue *mq);
+
 /**
  * @brief Returns the mqtt_queued_message at \p index.
  * @ingroup details
  * 
  * @param mq_ptr A pointer to the message queue.
- * @param index The index of the message. 
+ * @param index The index of the message, 0 is the first message. 
+ *
+ * @note \p index is not greater than mqtt_message_queue::queue_size: the ring
+ *       wraps at most once and no division is needed.
  *
  * @returns The mqtt_queued_message at \p index.
  */
-#define mqtt_mq_get(mq_ptr, index) (((struct mqtt_queued_message*) ((mq_ptr)->mem_end)) - 1 - index)
+#define mqtt_mq_get(mq_ptr, index) ((mq_ptr)->queue + \
+    (((mq_ptr)->queue_head + (size_t)(index) < (mq_ptr)->queue_size) ? \
+     ((mq_ptr)->queue_head + (size_t)(index)) : \
+     ((mq_ptr)->queue_head + (size_t)(index) - (mq_ptr)->queue_size)))
 
 /**
- * @brief Returns the number of messages in the message queue, \p mq_ptr.
+ * @brief Returns the mqtt_queued_message that follows \p msg_ptr in the message queue.
  * @ingroup details
+ *
+ * @note Used to walk through the queue without computing each index.
  */
-#define mqtt_mq_length(mq_ptr) (((struct mqtt_queued_message*) ((mq_ptr)->mem_end)) - (mq_ptr)->queue_tail)
+#define mqtt_mq_next(mq_ptr, msg_ptr) \
+    (((msg_ptr) + 1 == (mq_ptr)->queue + (mq_ptr)->queue_size) ? (mq_ptr)->queue : (msg_ptr) + 1)
 
 /**
- * @brief Used internally to recalculate the \c curr_sz.
+ * @brief Returns the end of the contiguous run of at most \p n mqtt_queued_message's
+ *        that starts at \p msg_ptr: the end of the ring if the run wraps.
+ * @ingroup details
+ *
+ * @note Used to scan the queue in at most two plain loops, without a wrap check
+ *       per message.
+ */
+#define mqtt_mq_segment_end(mq_ptr, msg_ptr, n) \
+    (((size_t)(((mq_ptr)->queue + (mq_ptr)->queue_size) - (msg_ptr)) > (size_t)(n)) ? \
+     ((msg_ptr) + (n)) : ((mq_ptr)->queue + (mq_ptr)->queue_size))
+
+/**
+ * @brief Returns the number of messages in the message queue, \p mq_ptr.
  * @ingroup details
  */
-#define mqtt_mq_currsz(mq_ptr) (mq_ptr->curr >= (uint8_t*) ((mq_ptr)->queue_tail - 1)) ? 0 : ((uint8_t*) ((mq_ptr)->queue_tail - 1)) - (mq_ptr)->curr
+#define mqtt_mq_length(mq_ptr) ((ssize_t)(mq_ptr)->queue_len)
 
 /* CLIENT */
 
@@ -59,7 +59,7 @@ SOFTWARE.
  *  - \c MQTT_PAL_MUTEX_RELEASE(mtx_pointer) : macro that unlocks the mutex pointed to by
  *    \c mtx_pointer.
  *
- * Lastly, \ref mqtt_pal_sendall and \ref mqtt_pal_recvall, must be implemented in mqtt_pal.c
+ * Lastly, \ref mqtt_pal_sendall, \ref mqtt_pal_sendallv and \ref mqtt_pal_recvall, must be implemented in mqtt_pal.c
  * for sending and receiving data using the platforms socket calls.
  */
 
@@ -162,6 +162,45 @@ SOFTWARE.
  */
 ssize_t mqtt_pal_sendall(mqtt_pal_socket_handle fd, const void* buf, size_t len, int flags);
 
+/**
+ * @brief The maximum number of buffers given to \ref mqtt_pal_sendallv.
+ * @ingroup pal
+ */
+#ifndef MQTT_PAL_IOV_MAX
+#if defined(__unix__) && (USE_NETWORK_LIBRARY == 0)
+    #define MQTT_PAL_IOV_MAX COM_IOV_MAX
+#else
+    #define MQTT_PAL_IOV_MAX 8
+#endif
+#endif
+
+/**
+ * @brief A buffer given to \ref mqtt_pal_sendallv.
+ * @ingroup pal
+ */
+struct mqtt_pal_iovec {
+    /** @brief A pointer to the first byte of the buffer. */
+    const void* base;
+    /** @brief The number of bytes of the buffer. */
+    size_t len;
+};
+
+/**
+ * @brief Sends all the bytes of several buffers, in order.
+ * @ingroup pal
+ *
+ * The buffers are gathered in as few socket writes as the transport allows, e.g. several
+ * queued messages are sent with one AT transaction by the cellular modem.
+ *
+ * @param[in] fd The file-descriptor (or handle) of the socket.
+ * @param[in] iov The buffers to send.
+ * @param[in] iovcnt The number of buffers (1 to \ref MQTT_PAL_IOV_MAX).
+ * @param[in] flags Flags which are passed to the underlying socket.
+ *
+ * @returns The number of bytes sent if successful, an \ref MQTTErrors otherwise.
+ */
+ssize_t mqtt_pal_sendallv(mqtt_pal_socket_handle fd, const struct mqtt_pal_iovec* iov, int iovcnt, int flags);
+
 /**
  * @brief Non-blocking receive all the byte available.
  * @ingroup pal
@@ -70,19 +70,28 @@ uint16_t __mqtt_next_pid(struct mqtt_client *client) {
 
     do {
         struct mqtt_queued_message *curr;
+        struct mqtt_queued_message *stop;
+        size_t n;
         unsigned lsb = client->pid_lfsr & 1;
         (client->pid_lfsr) >>= 1;
         if (lsb) {
             client->pid_lfsr ^= 0xB400u;
         }
 
-        /* check that the PID is unique */
+        /* check that the PID is unique: up to the end of the ring, then from its start */
         pid_exists = 0;
-        for(curr = mqtt_mq_get(&(client->mq), 0); curr >= client->mq.queue_tail; --curr) {
-            if (curr->packet_id == client->pid_lfsr) {
-                pid_exists = 1;
-                break;
+        n = client->mq.queue_len;
+        curr = client->mq.queue + client->mq.queue_head;
+        while((n > 0) && !pid_exists) {
+            stop = mqtt_mq_segment_end(&(client->mq), curr, n);
+            n -= (size_t)(stop - curr);
+            for(; curr < stop; ++curr) {
+                if (curr->packet_id == client->pid_lfsr) {
+                    pid_exists = 1;
+                    break;
+                }
             }
+            curr = client->mq.queue;
         }
 
     } while(pid_exists);
@@ -177,16 +186,22 @@ void mqtt_reinit(struct mqtt_client* client,
 /**
  * A macro function that:
  *      1) Checks that the client isn't in an error state.
- *      2) Attempts to pack to client's message queue.
+ *      2) Cleans the client's message queue if its first message is complete:
+ *         cheap, nothing is moved.
+ *      3) Attempts to pack to client's message queue.
  *          a) handles errors
  *          b) if mq buffer is too small, cleans it and tries again
- *      3) Upon successful pack, registers the new message.
+ *      4) Upon successful pack, registers the new message.
  */
 #define MQTT_CLIENT_TRY_PACK(tmp, msg, client, pack_call, release)  \
     if (client->error < 0) {                                        \
         if (release) MQTT_PAL_MUTEX_UNLOCK(&client->mutex);         \
         return client->error;                                       \
     }                                                               \
+    if (mqtt_mq_length(&client->mq) > 0 &&                          \
+        mqtt_mq_get(&client->mq, 0)->state == MQTT_QUEUED_COMPLETE) { \
+        mqtt_mq_clean(&client->mq);                                 \
+    }                                                               \
     tmp = pack_call;                                                \
     if (tmp < 0) {                                                  \
         client->error = tmp;                                        \
@@ -472,6 +487,7 @@ enum MQTTErrors mqtt_disconnect(struct mqtt_client *client)
 
 ssize_t __mqtt_send(struct mqtt_client *client)
 {
+    struct mqtt_queued_message *curr;
     uint8_t inspected;
     ssize_t len;
     int inflight_qos2 = 0;
@@ -484,114 +500,153 @@ ssize_t __mqtt_send(struct mqtt_client *client)
         return client->error;
     }
 
-    /* loop through all messages in the queue */
+    /* loop through all messages in the queue: the messages to send are gathered
+       by batches of MQTT_PAL_IOV_MAX and each batch is sent with one socket write */
     len = mqtt_mq_length(&client->mq);
-    for(; i < len; ++i) {
-        struct mqtt_queued_message *msg = mqtt_mq_get(&client->mq, i);
-        int resend = 0;
-        if (msg->state == MQTT_QUEUED_UNSENT) {
-            /* message has not been sent to lets send it */
-            resend = 1;
-        } else if (msg->state == MQTT_QUEUED_AWAITING_ACK) {
-            /* check for timeout */
-            if (MQTT_PAL_TIME() > msg->time_sent + client->response_timeout) {
+    curr = client->mq.queue + client->mq.queue_head;
+    while(i < len) {
+        struct mqtt_queued_message *batch[MQTT_PAL_IOV_MAX];
+        struct mqtt_pal_iovec iov[MQTT_PAL_IOV_MAX];
+        int timed_out[MQTT_PAL_IOV_MAX];
+        int batch_nb = 0;
+        ssize_t sent;
+        int partial = 0;
+
+        for(; (i < len) && (batch_nb < MQTT_PAL_IOV_MAX); ++i, curr = mqtt_mq_next(&client->mq, curr)) {
+            struct mqtt_queued_message *msg = curr;
+            int resend = 0;
+            int timeout = 0;
+            if (msg->state == MQTT_QUEUED_UNSENT) {
+                /* message has not been sent to lets send it */
                 resend = 1;
-                client->number_of_timeouts += 1;
-                client->send_offset = 0;
+            } else if (msg->state == MQTT_QUEUED_AWAITING_ACK) {
+                /* check for timeout */
+                if (MQTT_PAL_TIME() > msg->time_sent + client->response_timeout) {
+                    resend = 1;
+                    timeout = 1;
+                }
             }
-        }
 
-        /* only send QoS 2 message if there are no inflight QoS 2 PUBLISH messages */
-        if (msg->control_type == MQTT_CONTROL_PUBLISH
-            && (msg->state == MQTT_QUEUED_UNSENT || msg->state == MQTT_QUEUED_AWAITING_ACK))
-        {
-            inspected = 0x03 & ((msg->start[0]) >> 1); /* qos */
-            if (inspected == 2) {
-                if (inflight_qos2) {
-                    resend = 0;
+            /* only send QoS 2 message if there are no inflight QoS 2 PUBLISH messages */
+            if (msg->control_type == MQTT_CONTROL_PUBLISH
+                && (msg->state == MQTT_QUEUED_UNSENT || msg->state == MQTT_QUEUED_AWAITING_ACK))
+            {
+                inspected = 0x03 & ((msg->start[0]) >> 1); /* qos */
+                if (inspected == 2) {
+                    if (inflight_qos2) {
+                        resend = 0;
+                    }
+                    inflight_qos2 = 1;
                 }
-                inflight_qos2 = 1;
             }
-        }
 
-        /* goto next message if we don't need to send */
-        if (!resend) {
-            continue;
-        }
+            /* goto next message if we don't need to send */
+            if (!resend) {
+                continue;
+            }
 
-        /* we're sending the message */
-        {
-          ssize_t tmp = mqtt_pal_sendall(client->socketfd, msg->start + client->send_offset, msg->size - client->send_offset, 0);
-          if (tmp < 0) {
-            client->error = tmp;
-            MQTT_PAL_MUTEX_UNLOCK(&client->mutex);
-            return tmp;
-          } else {
-            client->send_offset += tmp;
-            if(client->send_offset < msg->size) {
-              /* partial sent. Await additional calls */
-              break;
-            } else {
-              /* whole message has been sent */
-              client->send_offset = 0;
+            /* a timed out message is sent again from its start */
+            if (timeout && (batch_nb == 0)) {
+                client->send_offset = 0;
             }
 
-          }
+            /* only the first message of a batch may be partially sent */
+            batch[batch_nb] = msg;
+            timed_out[batch_nb] = timeout;
+            iov[batch_nb].base = msg->start + ((batch_nb == 0) ? client->send_offset : 0);
+            iov[batch_nb].len = msg->size - ((batch_nb == 0) ? client->send_offset : 0);
+            batch_nb++;
+        }
 
+        if (batch_nb == 0) {
+            break;
         }
 
-        /* update timeout watcher */
-        client->time_of_last_send = MQTT_PAL_TIME();
-        msg->time_sent = client->time_of_last_send;
+        /* we're sending the messages */
+        sent = mqtt_pal_sendallv(client->socketfd, iov, batch_nb, 0);
+        if (sent < 0) {
+            if (timed_out[0]) {
+                client->number_of_timeouts += 1;
+            }
+            client->error = sent;
+            MQTT_PAL_MUTEX_UNLOCK(&client->mutex);
+            return sent;
+        }
 
-        /*
-        Determine the state to put the message in.
-        Control Types:
-        MQTT_CONTROL_CONNECT     -> awaiting
-        MQTT_CONTROL_CONNACK     -> n/a
-        MQTT_CONTROL_PUBLISH     -> qos == 0 ? complete : awaiting
-        MQTT_CONTROL_PUBACK      -> complete
-        MQTT_CONTROL_PUBREC      -> awaiting
-        MQTT_CONTROL_PUBREL      -> awaiting
-        MQTT_CONTROL_PUBCOMP     -> complete
-        MQTT_CONTROL_SUBSCRIBE   -> awaiting
-        MQTT_CONTROL_SUBACK      -> n/a
-        MQTT_CONTROL_UNSUBSCRIBE -> awaiting
-        MQTT_CONTROL_UNSUBACK    -> n/a
-        MQTT_CONTROL_PINGREQ     -> awaiting
-        MQTT_CONTROL_PINGRESP    -> n/a
-        MQTT_CONTROL_DISCONNECT  -> complete
-        */
-        switch (msg->control_type) {
-        case MQTT_CONTROL_PUBACK:
-        case MQTT_CONTROL_PUBCOMP:
-        case MQTT_CONTROL_DISCONNECT:
-            msg->state = MQTT_QUEUED_COMPLETE;
-            break;
-        case MQTT_CONTROL_PUBLISH:
-            inspected = ( MQTT_PUBLISH_QOS_MASK & (msg->start[0]) ) >> 1; /* qos */
-            if (inspected == 0) {
+        /* update the messages sent, in order */
+        for(int b = 0; (b < batch_nb) && !partial; ++b) {
+            struct mqtt_queued_message *msg = batch[b];
+
+            if (timed_out[b]) {
+                client->number_of_timeouts += 1;
+            }
+            if ((size_t)sent < msg->size - client->send_offset) {
+                /* partial sent. Await additional calls */
+                client->send_offset += sent;
+                partial = 1;
+                continue;
+            }
+            /* whole message has been sent */
+            sent -= msg->size - client->send_offset;
+            client->send_offset = 0;
+
+            /* update timeout watcher */
+            client->time_of_last_send = MQTT_PAL_TIME();
+            msg->time_sent = client->time_of_last_send;
+
+            /*
+            Determine the state to put the message in.
+            Control Types:
+            MQTT_CONTROL_CONNECT     -> awaiting
+            MQTT_CONTROL_CONNACK     -> n/a
+            MQTT_CONTROL_PUBLISH     -> qos == 0 ? complete : awaiting
+            MQTT_CONTROL_PUBACK      -> complete
+            MQTT_CONTROL_PUBREC      -> awaiting
+            MQTT_CONTROL_PUBREL      -> awaiting
+            MQTT_CONTROL_PUBCOMP     -> complete
+            MQTT_CONTROL_SUBSCRIBE   -> awaiting
+            MQTT_CONTROL_SUBACK      -> n/a
+            MQTT_CONTROL_UNSUBSCRIBE -> awaiting
+            MQTT_CONTROL_UNSUBACK    -> n/a
+            MQTT_CONTROL_PINGREQ     -> awaiting
+            MQTT_CONTROL_PINGRESP    -> n/a
+            MQTT_CONTROL_DISCONNECT  -> complete
+            */
+            switch (msg->control_type) {
+            case MQTT_CONTROL_PUBACK:
+            case MQTT_CONTROL_PUBCOMP:
+            case MQTT_CONTROL_DISCONNECT:
                 msg->state = MQTT_QUEUED_COMPLETE;
-            } else if (inspected == 1) {
-                msg->state = MQTT_QUEUED_AWAITING_ACK;
-                /*set DUP flag for subsequent sends [Spec MQTT-3.3.1-1] */
-                msg->start[0] |= MQTT_PUBLISH_DUP;
-            } else {
+                break;
+            case MQTT_CONTROL_PUBLISH:
+                inspected = ( MQTT_PUBLISH_QOS_MASK & (msg->start[0]) ) >> 1; /* qos */
+                if (inspected == 0) {
+                    msg->state = MQTT_QUEUED_COMPLETE;
+                } else if (inspected == 1) {
+                    msg->state = MQTT_QUEUED_AWAITING_ACK;
+                    /*set DUP flag for subsequent sends [Spec MQTT-3.3.1-1] */
+                    msg->start[0] |= MQTT_PUBLISH_DUP;
+                } else {
+                    msg->state = MQTT_QUEUED_AWAITING_ACK;
+                }
+                break;
+            case MQTT_CONTROL_CONNECT:
+            case MQTT_CONTROL_PUBREC:
+            case MQTT_CONTROL_PUBREL:
+            case MQTT_CONTROL_SUBSCRIBE:
+            case MQTT_CONTROL_UNSUBSCRIBE:
+            case MQTT_CONTROL_PINGREQ:
                 msg->state = MQTT_QUEUED_AWAITING_ACK;
+                break;
+            default:
+                client->error = MQTT_ERROR_MALFORMED_REQUEST;
+                MQTT_PAL_MUTEX_UNLOCK(&client->mutex);
+                return MQTT_ERROR_MALFORMED_REQUEST;
             }
+        }
+
+        if (partial) {
             break;
-        case MQTT_CONTROL_CONNECT:
-        case MQTT_CONTROL_PUBREC:
-        case MQTT_CONTROL_PUBREL:
-        case MQTT_CONTROL_SUBSCRIBE:
-        case MQTT_CONTROL_UNSUBSCRIBE:
-        case MQTT_CONTROL_PINGREQ:
-            msg->state = MQTT_QUEUED_AWAITING_ACK;
-            break;
-        default:
-            client->error = MQTT_ERROR_MALFORMED_REQUEST;
-            MQTT_PAL_MUTEX_UNLOCK(&client->mutex);
-            return MQTT_ERROR_MALFORMED_REQUEST;
         }
     }
 
@@ -1589,68 +1644,79 @@ void mqtt_mq_init(struct mqtt_message_queue *mq, void *buf, size_t bufsz)
 {
     if(buf != NULL)
     {
+        uintptr_t queue_addr;
+
         mq->mem_start = buf;
         mq->mem_end = (unsigned char*)buf + bufsz;
         mq->curr = buf;
-        mq->queue_tail = mq->mem_end;
+        mq->wrapped = 0;
+
+        /* the mqtt_queued_message's ring at the end of the buffer, 8 bytes aligned */
+        mq->queue_size = bufsz / (sizeof(struct mqtt_queued_message) + MQTT_MQ_MSG_SIZE_AVG);
+        queue_addr = ((uintptr_t)mq->mem_end - (mq->queue_size * sizeof(struct mqtt_queued_message))) & ~(uintptr_t)7u;
+        mq->queue = (struct mqtt_queued_message*)queue_addr;
+        mq->data_end = (uint8_t*)queue_addr;
+        mq->queue_head = 0;
+        mq->queue_len = 0;
         mq->curr_sz = mqtt_mq_currsz(mq);
     }
 }
 
+size_t mqtt_mq_currsz(const struct mqtt_message_queue *mq)
+{
+    if (mq->queue_len >= mq->queue_size) {
+        /* no mqtt_queued_message left */
+        return 0;
+    } else if (mq->queue_len == 0) {
+        return mq->data_end - mq->curr;
+    } else if (mq->wrapped) {
+        /* up to the first message */
+        return mqtt_mq_get(mq, 0)->start - mq->curr;
+    } else {
+        return mq->data_end - mq->curr;
+    }
+}
+
 struct mqtt_queued_message* mqtt_mq_register(struct mqtt_message_queue *mq, size_t nbytes)
 {
     /* make queued message header */
-    --(mq->queue_tail);
-    mq->queue_tail->start = mq->curr;
-    mq->queue_tail->size = nbytes;
-    mq->queue_tail->state = MQTT_QUEUED_UNSENT;
+    struct mqtt_queued_message *msg = mqtt_mq_get(mq, mq->queue_len);
+    ++(mq->queue_len);
+    msg->start = mq->curr;
+    msg->size = nbytes;
+    msg->state = MQTT_QUEUED_UNSENT;
 
     /* move curr and recalculate curr_sz */
     mq->curr += nbytes;
     mq->curr_sz = mqtt_mq_currsz(mq);
 
-    return mq->queue_tail;
+    return msg;
 }
 
 void mqtt_mq_clean(struct mqtt_message_queue *mq) {
-    struct mqtt_queued_message *new_head;
-
-    for(new_head = mqtt_mq_get(mq, 0); new_head >= mq->queue_tail; --new_head) {
-        if (new_head->state != MQTT_QUEUED_COMPLETE) break;
+    /* remove the completed messages at the front: nothing is moved */
+    while((mq->queue_len > 0) && (mqtt_mq_get(mq, 0)->state == MQTT_QUEUED_COMPLETE)) {
+        if (++(mq->queue_head) == mq->queue_size) {
+            mq->queue_head = 0;
+        }
+        --(mq->queue_len);
     }
 
-    /* check if everything can be removed */
-    if (new_head < mq->queue_tail) {
+    if (mq->queue_len == 0) {
+        /* everything removed */
         mq->curr = mq->mem_start;
-        mq->queue_tail = mq->mem_end;
-        mq->curr_sz = mqtt_mq_currsz(mq);
-        return;
-    } else if (new_head == mqtt_mq_get(mq, 0)) {
-        /* do nothing */
-        return;
-    }
-
-    /* move buffered data */
-    {
-        size_t n = mq->curr - new_head->start;
-        size_t removing = new_head->start - (uint8_t*) mq->mem_start;
-        memmove(mq->mem_start, new_head->start, n);
-        mq->curr = (unsigned char*)mq->mem_start + n;
-
-
-        /* move queue */
-        {
-            ssize_t new_tail_idx = new_head - mq->queue_tail;
-            memmove(mqtt_mq_get(mq, new_tail_idx), mq->queue_tail, sizeof(struct mqtt_queued_message) * (new_tail_idx + 1));
-            mq->queue_tail = mqtt_mq_get(mq, new_tail_idx);
+        mq->wrapped = 0;
+    } else {
+        uint8_t *first = mqtt_mq_get(mq, 0)->start;
 
-            {
-                /* bump back start's */
-                ssize_t i = 0;
-                for(; i < new_tail_idx + 1; ++i) {
-                    mqtt_mq_get(mq, i)->start -= removing;
-                }
-            }
+        if (mq->wrapped && (first < mq->curr)) {
+            /* the messages at the end of the buffer are all removed */
+            mq->wrapped = 0;
+        }
+        if (!mq->wrapped && ((size_t)(first - (uint8_t*)mq->mem_start) > (size_t)(mq->data_end - mq->curr))) {
+            /* more room before the first message than after the last one */
+            mq->curr = mq->mem_start;
+            mq->wrapped = 1;
         }
     }
 
@@ -1661,13 +1727,24 @@ void mqtt_mq_clean(struct mqtt_message_queue *mq) {
 struct mqtt_queued_message* mqtt_mq_find(struct mqtt_message_queue *mq, enum MQTTControlPacketType control_type, uint16_t *packet_id)
 {
     struct mqtt_queued_message *curr;
-    for(curr = mqtt_mq_get(mq, 0); curr >= mq->queue_tail; --curr) {
-        if (curr->control_type == control_type) {
-            if ((packet_id == NULL && curr->state != MQTT_QUEUED_COMPLETE) ||
-                (packet_id != NULL && *packet_id == curr->packet_id)) {
-                return curr;
+    struct mqtt_queued_message *stop;
+    size_t n;
+
+    /* up to the end of the ring, then from its start */
+    n = mq->queue_len;
+    curr = mq->queue + mq->queue_head;
+    while(n > 0) {
+        stop = mqtt_mq_segment_end(mq, curr, n);
+        n -= (size_t)(stop - curr);
+        for(; curr < stop; ++curr) {
+            if (curr->control_type == control_type) {
+                if ((packet_id == NULL && curr->state != MQTT_QUEUED_COMPLETE) ||
+                    (packet_id != NULL && *packet_id == curr->packet_id)) {
+                    return curr;
+                }
             }
         }
+        curr = mq->queue;
     }
     return NULL;
 }
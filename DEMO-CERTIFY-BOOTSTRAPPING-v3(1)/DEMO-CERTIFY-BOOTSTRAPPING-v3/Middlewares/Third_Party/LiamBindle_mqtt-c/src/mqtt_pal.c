@@ -26,7 +26,7 @@ SOFTWARE.
 
 /**
  * @file
- * @brief Implements @ref mqtt_pal_sendall and @ref mqtt_pal_recvall and
+ * @brief Implements @ref mqtt_pal_sendall, @ref mqtt_pal_sendallv and @ref mqtt_pal_recvall and
  *        any platform-specific helpers you'd like.
  * @cond Doxygen_Suppress
  */
@@ -52,6 +52,18 @@ ssize_t mqtt_pal_sendall(mqtt_pal_socket_handle fd, const void* buf, size_t len,
     return sent;
 }
 
+ssize_t mqtt_pal_sendallv(mqtt_pal_socket_handle fd, const struct mqtt_pal_iovec* iov, int iovcnt, int flags) {
+    ssize_t sent = 0;
+    for(int i = 0; i < iovcnt; ++i) {
+        ssize_t tmp = mqtt_pal_sendall(fd, iov[i].base, iov[i].len, flags);
+        if (tmp < 0) {
+            return tmp;
+        }
+        sent += tmp;
+    }
+    return sent;
+}
+
 ssize_t mqtt_pal_recvall(mqtt_pal_socket_handle fd, void* buf, size_t bufsz, int flags) {
     const void const *start = buf;
     int rv;
@@ -98,6 +110,63 @@ ssize_t mqtt_pal_sendall(mqtt_pal_socket_handle fd, const void* buf, size_t len,
     return sent;
 }
 
+ssize_t mqtt_pal_sendallv(mqtt_pal_socket_handle fd, const struct mqtt_pal_iovec* iov, int iovcnt, int flags) {
+#if (USE_NETWORK_LIBRARY == 1)
+    /* no gathered send in the network library: one write per buffer */
+    ssize_t sent = 0;
+    for(int i = 0; i < iovcnt; ++i) {
+        ssize_t tmp = mqtt_pal_sendall(fd, iov[i].base, iov[i].len, flags);
+        if (tmp < 0) {
+            return tmp;
+        }
+        sent += tmp;
+    }
+    return sent;
+#else
+    /* one com_sendmsg for all the buffers: split by the modem MTU only */
+    com_iovec_t com_iov[MQTT_PAL_IOV_MAX];
+    com_msghdr_t msg;
+    size_t len = 0;
+    size_t sent = 0;
+    int first = 0;
+
+    if ((iovcnt < 1) || (iovcnt > MQTT_PAL_IOV_MAX)) {
+        return -MQTT_ERROR_SOCKET_ERROR;
+    }
+    for(int i = 0; i < iovcnt; ++i) {
+        com_iov[i].iov_base = (const com_char_t *)iov[i].base;
+        com_iov[i].iov_len = (int32_t)iov[i].len;
+        len += iov[i].len;
+    }
+    msg.msg_name = NULL;
+    msg.msg_namelen = 0;
+
+    while(sent < len) {
+        msg.msg_iov = &com_iov[first];
+        msg.msg_iovlen = (int32_t)(iovcnt - first);
+        ssize_t tmp = com_sendmsg((int32_t) fd, &msg, flags);
+
+        if (tmp < 1) {
+            /*   need a negative return   */
+            return -MQTT_ERROR_SOCKET_ERROR;
+        }
+        sent += (size_t) tmp;
+        /* skip the bytes sent */
+        while((tmp > 0) && (first < iovcnt)) {
+            if (tmp >= com_iov[first].iov_len) {
+                tmp -= com_iov[first].iov_len;
+                first++;
+            } else {
+                com_iov[first].iov_base += tmp;
+                com_iov[first].iov_len -= tmp;
+                tmp = 0;
+            }
+        }
+    }
+    return sent;
+#endif /* USE_NETWORK_LIBRARY == 1 */
+}
+
 ssize_t mqtt_pal_recvall(mqtt_pal_socket_handle fd, void* buf, size_t bufsz, int flags) {
     const void *const start = buf;
     uint8_t* buf1 = (uint8_t*)buf;
@@ -149,6 +218,18 @@ ssize_t mqtt_pal_sendall(mqtt_pal_socket_handle fd, const void* buf, size_t len,
     return sent;
 }
 
+ssize_t mqtt_pal_sendallv(mqtt_pal_socket_handle fd, const struct mqtt_pal_iovec* iov, int iovcnt, int flags) {
+    ssize_t sent = 0;
+    for(int i = 0; i < iovcnt; ++i) {
+        ssize_t tmp = mqtt_pal_sendall(fd, iov[i].base, iov[i].len, flags);
+        if (tmp < 0) {
+            return tmp;
+        }
+        sent += tmp;
+    }
+    return sent;
+}
+
 ssize_t mqtt_pal_recvall(mqtt_pal_socket_handle fd, void* buf, size_t bufsz, int flags) {
     const char *const start = buf;
     ssize_t rv;
@@ -35,6 +35,7 @@ extern UART_HandleTypeDef huart2;
 extern UART_HandleTypeDef huart3;
 
 /* USER CODE BEGIN Private defines */
+extern DMA_HandleTypeDef hdma_modem_uart_rx;
 
 /* USER CODE END Private defines */
 
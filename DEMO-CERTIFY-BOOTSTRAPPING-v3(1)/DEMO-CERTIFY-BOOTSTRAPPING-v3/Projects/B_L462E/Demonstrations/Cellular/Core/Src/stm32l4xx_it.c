@@ -27,6 +27,8 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "usart.h"
+#include "ipc_uart.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -216,6 +218,9 @@ void USART1_IRQHandler(void)
 void USART2_IRQHandler(void)
 {
   /* USER CODE BEGIN USART2_IRQn 0 */
+#if (IPC_USE_UART_DMA == 1U)
+  IPC_UART_IdleLineIRQHandler(&huart2);
+#endif /* IPC_USE_UART_DMA == 1U */
 
   /* USER CODE END USART2_IRQn 0 */
   HAL_UART_IRQHandler(&huart2);
@@ -230,6 +235,9 @@ void USART2_IRQHandler(void)
 void USART3_IRQHandler(void)
 {
   /* USER CODE BEGIN USART3_IRQn 0 */
+#if (IPC_USE_UART_DMA == 1U)
+  IPC_UART_IdleLineIRQHandler(&huart3);
+#endif /* IPC_USE_UART_DMA == 1U */
 
   /* USER CODE END USART3_IRQn 0 */
   HAL_UART_IRQHandler(&huart3);
@@ -254,6 +262,14 @@ void EXTI15_10_IRQHandler(void)
 }
 
 /* USER CODE BEGIN 1 */
-
+#if (IPC_USE_UART_DMA == 1U)
+/**
+  * @brief This function handles DMA channel used by modem UART reception.
+  */
+void MODEM_UART_DMA_RX_IRQHANDLER(void)
+{
+  HAL_DMA_IRQHandler(&hdma_modem_uart_rx);
+}
+#endif /* IPC_USE_UART_DMA == 1U */
 /* USER CODE END 1 */
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -21,7 +21,13 @@
 #include "usart.h"
 
 /* USER CODE BEGIN 0 */
+#include "plf_ipc_config.h"
 
+#if (IPC_USE_UART_DMA == 1U)
+DMA_HandleTypeDef hdma_modem_uart_rx;
+
+static void MODEM_UART_DMA_RX_Init(UART_HandleTypeDef *uartHandle);
+#endif /* IPC_USE_UART_DMA == 1U */
 /* USER CODE END 0 */
 
 UART_HandleTypeDef huart1;
@@ -149,6 +155,9 @@ void HAL_UART_MspInit(UART_HandleTypeDef* uartHandle)
     HAL_NVIC_SetPriority(USART2_IRQn, 5, 0);
     HAL_NVIC_EnableIRQ(USART2_IRQn);
   /* USER CODE BEGIN USART2_MspInit 1 */
+#if (IPC_USE_UART_DMA == 1U)
+    MODEM_UART_DMA_RX_Init(uartHandle);
+#endif /* IPC_USE_UART_DMA == 1U */
 
     /* will be reactivated later */
     HAL_NVIC_DisableIRQ(USART2_IRQn);
@@ -196,6 +205,9 @@ void HAL_UART_MspInit(UART_HandleTypeDef* uartHandle)
     HAL_NVIC_SetPriority(USART3_IRQn, 5, 0);
     HAL_NVIC_EnableIRQ(USART3_IRQn);
   /* USER CODE BEGIN USART3_MspInit 1 */
+#if (IPC_USE_UART_DMA == 1U)
+    MODEM_UART_DMA_RX_Init(uartHandle);
+#endif /* IPC_USE_UART_DMA == 1U */
     /* disable IRQ to avoid problems with IPC - will be reactivated later */
     HAL_NVIC_DisableIRQ(USART3_IRQn);
   /* USER CODE END USART3_MspInit 1 */
@@ -244,6 +256,12 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* uartHandle)
     /* USART2 interrupt Deinit */
     HAL_NVIC_DisableIRQ(USART2_IRQn);
   /* USER CODE BEGIN USART2_MspDeInit 1 */
+#if (IPC_USE_UART_DMA == 1U)
+    if (uartHandle->hdmarx != NULL)
+    {
+      HAL_DMA_DeInit(uartHandle->hdmarx);
+    }
+#endif /* IPC_USE_UART_DMA == 1U */
 
   /* USER CODE END USART2_MspDeInit 1 */
   }
@@ -270,13 +288,48 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* uartHandle)
     /* USART3 interrupt Deinit */
     HAL_NVIC_DisableIRQ(USART3_IRQn);
   /* USER CODE BEGIN USART3_MspDeInit 1 */
+#if (IPC_USE_UART_DMA == 1U)
+    if (uartHandle->hdmarx != NULL)
+    {
+      HAL_DMA_DeInit(uartHandle->hdmarx);
+    }
+#endif /* IPC_USE_UART_DMA == 1U */
 
   /* USER CODE END USART3_MspDeInit 1 */
   }
 } 
 
 /* USER CODE BEGIN 1 */
-
+#if (IPC_USE_UART_DMA == 1U)
+/* Modem UART RX DMA Init: circular reception used by IPC */
+static void MODEM_UART_DMA_RX_Init(UART_HandleTypeDef *uartHandle)
+{
+  if (uartHandle->Instance == MODEM_UART_INSTANCE)
+  {
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    hdma_modem_uart_rx.Instance = MODEM_UART_DMA_RX_CHANNEL;
+    hdma_modem_uart_rx.Init.Request = MODEM_UART_DMA_RX_REQUEST;
+    hdma_modem_uart_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_modem_uart_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_modem_uart_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_modem_uart_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_modem_uart_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_modem_uart_rx.Init.Mode = DMA_CIRCULAR;
+    hdma_modem_uart_rx.Init.Priority = DMA_PRIORITY_HIGH;
+    if (HAL_DMA_Init(&hdma_modem_uart_rx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(uartHandle, hdmarx, hdma_modem_uart_rx);
+
+    /* DMA interrupt Init: same priority as the UART interrupt */
+    HAL_NVIC_SetPriority(MODEM_UART_DMA_RX_IRQN, 5, 0);
+    HAL_NVIC_EnableIRQ(MODEM_UART_DMA_RX_IRQN);
+  }
+}
+#endif /* IPC_USE_UART_DMA == 1U */
 /* USER CODE END 1 */
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,39 @@
+/**
+  ******************************************************************************
+  * @file    plf_config.h
+  * @author  artworkTrackingMAP
+  * @brief   Host version of the common defines of the application: same as
+  *          STM32_Cellular/App/plf_config.h with the host plf_hw_config.h.
+  * @note    Forced first in each host compilation unit (see ../CMakeLists.txt)
+  *          so that the target plf_config.h is never included.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef PLF_CONFIG_H
+#define PLF_CONFIG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+
+/* Specific project Includes -------------------------------------------------*/
+#if (USE_CUSTOM_CONFIG == 1)
+#include "plf_custom_config.h" /* First include to overwrite Platform defines */
+#endif /* USE_CUSTOM_CONFIG == 1 */
+
+/* Common projects Includes --------------------------------------------------*/
+#include "plf_features.h"
+#include "plf_hw_config.h"
+#include "plf_sw_config.h"
+#include "plf_thread_config.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLF_CONFIG_H */
+
+/******************************** END OF FILE *********************************/
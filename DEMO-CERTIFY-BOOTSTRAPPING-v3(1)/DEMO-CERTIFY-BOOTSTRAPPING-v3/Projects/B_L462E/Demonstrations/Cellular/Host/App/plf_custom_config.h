@@ -0,0 +1,90 @@
+/**
+  ******************************************************************************
+  * @file    plf_custom_config.h
+  * @author  artworkTrackingMAP
+  * @brief   Host configuration: overwrites X-Cube-Cellular features to build
+  *          the cellular stack on a POSIX host (see ../CMakeLists.txt).
+  * @note    Modem is the simulator of ipc_sim.c, rtosal is rtosal_posix.c,
+  *          board features (display, buttons, leds, console) are removed.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef PLF_CUSTOM_CONFIG_H
+#define PLF_CUSTOM_CONFIG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+
+/* Exported constants --------------------------------------------------------*/
+
+#if (USE_CUSTOM_CONFIG == 1)
+
+/* ===================================== */
+/* BEGIN - Applications to include       */
+/* ===================================== */
+#define USE_COM_CLIENT       (0) /* 0: not activated, 1: activated */
+#define USE_ECHO_CLIENT      (0) /* 0: not activated, 1: activated */
+#define USE_HTTP_CLIENT      (0) /* 0: not activated, 1: activated */
+#define USE_PING_CLIENT      (0) /* 0: not activated, 1: activated */
+#define USE_MQTT_CLIENT      (0) /* 0: not activated, 1: activated */
+#define USE_UI_CLIENT        (0) /* 0: not activated, 1: activated */
+/* set to 1 by the tests of the custom client modules, see Test/CMakeLists.txt */
+#if !defined USE_CUSTOM_CLIENT
+#define USE_CUSTOM_CLIENT    (0) /* 0: not activated, 1: activated */
+#endif /* !defined USE_CUSTOM_CLIENT */
+
+#define USE_DC_MEMS          (0) /* 0: not activated, 1: activated */
+#define USE_SIMU_MEMS        (0) /* 0: not activated, 1: activated */
+#define USE_DC_GENERIC       (0) /* 0: not activated, 1: activated */
+/* ===================================== */
+/* END   - Applications to include       */
+/* ===================================== */
+
+/* ======================================= */
+/* BEGIN -  Miscellaneous functionalities  */
+/* ======================================= */
+#define USE_MODEM_SIMULATOR        (1) /* AT modem simulated by ipc_sim.c */
+#define IPC_SIM_TCP_BRIDGE         (1U) /* simulated sockets reach the local host servers */
+#define USE_COM_PING               (0) /* 0: not included, 1: included */
+#define USE_COM_ICC                (0) /* 0: not included, 1: included */
+/* set to 1 by the tests of the socket statistics, see Test/CMakeLists.txt */
+#if !defined COM_SOCKETS_STATISTIC
+#define COM_SOCKETS_STATISTIC      (0U) /* 0: not activated, 1: activated */
+#endif /* !defined COM_SOCKETS_STATISTIC */
+#define USE_CMD_CONSOLE            (0) /* 0: not activated, 1: activated */
+#define USE_RTC                    (0) /* 0: not activated, 1: activated */
+#define USE_DEFAULT_SETUP          (1) /* 1: Use default parameters, no setup menu */
+#define USE_STACK_ANALYSIS         (0) /* 0: Stack analysis is not embedded */
+#define USE_BUTTONS                (0) /* 0: not activated, 1: activated */
+#define USE_DISPLAY                (0) /* 0: not activated, 1: activated */
+#define USE_LEDS                   (0) /* 0: not activated, 1: activated */
+#define USE_LINK_UART              (0) /* 0: not activated, 1: activated */
+#define USE_ST33                   (0) /* 0: not activated, 1: activated */
+/* ======================================= */
+/* END   -  Miscellaneous functionalities  */
+/* ======================================= */
+
+/* set to 1 by the test of the trace rings, see Test/CMakeLists.txt */
+#if !defined SW_DEBUG_VERSION
+#define SW_DEBUG_VERSION           (0U)  /* 0 for SW release version (no traces),
+                                            1 for SW debug version */
+#endif /* !defined SW_DEBUG_VERSION */
+
+#endif /* USE_CUSTOM_CONFIG == 1 */
+
+/* Exported types ------------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLF_CUSTOM_CONFIG_H */
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,104 @@
+/**
+  ******************************************************************************
+  * @file    plf_hw_config.h
+  * @author  artworkTrackingMAP
+  * @brief   Host hardware configuration: the board resources used by the
+  *          cellular stack are mapped on the stubs of Target/host_hal.c.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef PLF_HW_CONFIG_H
+#define PLF_HW_CONFIG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "host_hal.h"
+#include "plf_modem_config.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Platform defines ----------------------------------------------------------*/
+#define HW_SETUP                (0)
+
+/* MODEM configuration: UART is simulated by ipc_sim.c */
+#define MODEM_UART_HANDLE       huart_modem
+#define MODEM_UART_INSTANCE     ((USART_TypeDef *)NULL)
+#define MODEM_UART_AUTOBAUD     (0)
+#define MODEM_UART_IRQN         ((IRQn_Type)0)
+#define MODEM_UART_BAUDRATE     (CONFIG_MODEM_UART_BAUDRATE)
+#define MODEM_UART_WORDLENGTH   UART_WORDLENGTH_8B
+#define MODEM_UART_STOPBITS     UART_STOPBITS_1
+#define MODEM_UART_PARITY       UART_PARITY_NONE
+#define MODEM_UART_MODE         UART_MODE_TX_RX
+#define MODEM_UART_HWFLOWCTRL   UART_HWCONTROL_NONE
+
+/* MODEM pins: GPIO services do nothing on the host */
+#define MODEM_TX_GPIO_PORT      ((GPIO_TypeDef *)NULL)
+#define MODEM_TX_PIN            (0U)
+#define MODEM_RX_GPIO_PORT      ((GPIO_TypeDef *)NULL)
+#define MODEM_RX_PIN            (0U)
+#define MODEM_CTS_GPIO_PORT     ((GPIO_TypeDef *)NULL)
+#define MODEM_CTS_PIN           (0U)
+#define MODEM_RTS_GPIO_PORT     ((GPIO_TypeDef *)NULL)
+#define MODEM_RTS_PIN           (0U)
+#define MODEM_RST_GPIO_PORT     ((GPIO_TypeDef *)NULL)
+#define MODEM_RST_PIN           (0U)
+#define MODEM_PWR_EN_GPIO_PORT  ((GPIO_TypeDef *)NULL)
+#define MODEM_PWR_EN_PIN        (0U)
+#define MODEM_DTR_GPIO_PORT     ((GPIO_TypeDef *)NULL)
+#define MODEM_DTR_PIN           (0U)
+#define MODEM_RING_GPIO_PORT    ((GPIO_TypeDef *)NULL)
+#define MODEM_RING_PIN          (0U)
+#define MODEM_RING_IRQN         ((IRQn_Type)1)
+
+#define PPPOS_LINK_UART_HANDLE   NULL
+#define PPPOS_LINK_UART_INSTANCE NULL
+
+/* Resource BUTTON definition */
+#define NO_BUTTON            (0xFF)
+#define USER_BUTTON          NO_BUTTON
+#define UP_BUTTON            NO_BUTTON
+#define DOWN_BUTTON          NO_BUTTON
+#define RIGHT_BUTTON         NO_BUTTON
+#define LEFT_BUTTON          NO_BUTTON
+#define SEL_BUTTON           NO_BUTTON
+#define BUTTONS_NB           (0U)
+
+/* Resource LED definition */
+#define NO_LED               ((uint8_t)0xFF)
+#define BOARD_LEDS_1         NO_LED
+#define BOARD_LEDS_2         NO_LED
+#define BOARD_LEDS_3         NO_LED
+#define GREEN_LED            NO_LED
+#define RED_LED              NO_LED
+#define BLUE_LED             NO_LED
+#define DATAREADY_LED        NO_LED
+#define CLOUD_LED            NO_LED
+#define OTHER_LED            NO_LED
+#define LEDS_NB              (0U)
+
+/* Flash configuration: see host_hal.c */
+#define FLASH_LAST_PAGE_ADDR     ((uint32_t)0x0807f800)
+#define FLASH_LAST_PAGE_NUMBER   255
+#define FLASH_BANK_NUMBER        FLASH_BANK_1
+
+/* DEBUG INTERFACE CONFIGURATION: traces are written on stdout */
+#define TRACE_INTERFACE_UART_HANDLE     huart_trace
+#define TRACE_INTERFACE_INSTANCE        ((USART_TypeDef *)NULL)
+
+/* Exported types ------------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLF_HW_CONFIG_H */
+
+/******************************** END OF FILE *********************************/
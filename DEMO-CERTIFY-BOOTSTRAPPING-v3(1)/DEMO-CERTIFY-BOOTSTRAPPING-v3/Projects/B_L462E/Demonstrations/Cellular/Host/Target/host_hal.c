@@ -0,0 +1,221 @@
+/**
+  ******************************************************************************
+  * @file    host_hal.c
+  * @author  artworkTrackingMAP
+  * @brief   POSIX host implementation of the HAL/CMSIS subset of host_hal.h.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "host_hal.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private defines -----------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static DWT_Type host_dwt_registers;
+
+/* Interrupt masking: recursive as __disable_irq() may be nested by the callers */
+static pthread_mutex_t host_irq_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+/* Global variables ----------------------------------------------------------*/
+UART_HandleTypeDef huart_modem;
+UART_HandleTypeDef huart_trace;
+RNG_HandleTypeDef hrng;
+ITM_Type host_itm;
+CoreDebug_Type host_core_debug;
+uint32_t SystemCoreClock = 1000000000U;
+
+/* Private function prototypes -----------------------------------------------*/
+/* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief  Mask the "interrupts": lock shared with the modem simulator thread.
+  * @retval -
+  */
+void host_irq_disable(void)
+{
+  (void)pthread_mutex_lock(&host_irq_lock);
+}
+
+/**
+  * @brief  Unmask the "interrupts".
+  * @retval -
+  */
+void host_irq_enable(void)
+{
+  (void)pthread_mutex_unlock(&host_irq_lock);
+}
+
+/**
+  * @brief  DWT registers: the cycle counter is read from the monotonic clock.
+  * @retval DWT registers with CYCCNT in ns
+  */
+DWT_Type *host_dwt(void)
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  host_dwt_registers.CYCCNT = (uint32_t)(((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec);
+
+  return (&host_dwt_registers);
+}
+
+/**
+  * @brief  Provide a tick value in millisecond.
+  * @retval tick value
+  */
+uint32_t HAL_GetTick(void)
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return ((uint32_t)(((uint64_t)now.tv_sec * 1000U) + ((uint64_t)now.tv_nsec / 1000000U)));
+}
+
+/**
+  * @brief  Wait a delay.
+  * @param  Delay - delay in millisecond
+  * @retval -
+  */
+void HAL_Delay(uint32_t Delay)
+{
+  (void)usleep((useconds_t)Delay * 1000U);
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+  UNUSED(GPIOx);
+  UNUSED(GPIO_Init);
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+  UNUSED(GPIOx);
+  UNUSED(GPIO_Pin);
+  UNUSED(PinState);
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+  UNUSED(GPIOx);
+  UNUSED(GPIO_Pin);
+
+  return (GPIO_PIN_RESET);
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+  UNUSED(IRQn);
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+  UNUSED(IRQn);
+}
+
+void HAL_NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+  UNUSED(IRQn);
+}
+
+/**
+  * @brief  System reset: the host process ends.
+  * @retval -
+  */
+void NVIC_SystemReset(void)
+{
+  (void)fprintf(stderr, "NVIC_SystemReset\n");
+  abort();
+}
+
+/**
+  * @brief  UART init: UART is ready.
+  * @param  huart - UART handle
+  * @retval HAL_OK
+  */
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+  huart->gState = HAL_UART_STATE_READY;
+  huart->RxState = HAL_UART_STATE_READY;
+
+  return (HAL_OK);
+}
+
+/**
+  * @brief  UART de-init.
+  * @param  huart - UART handle
+  * @retval HAL_OK
+  */
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *huart)
+{
+  huart->gState = HAL_UART_STATE_RESET;
+  huart->RxState = HAL_UART_STATE_RESET;
+
+  return (HAL_OK);
+}
+
+/**
+  * @brief  UART transmit: data are written on stdout (trace UART).
+  * @param  huart   - UART handle
+  * @param  pData   - data to transmit
+  * @param  Size    - data size
+  * @param  Timeout - unused
+  * @retval HAL_OK
+  */
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+  UNUSED(huart);
+  UNUSED(Timeout);
+  (void)fwrite(pData, 1U, Size, stdout);
+
+  return (HAL_OK);
+}
+
+/* Modem UART is replaced by the simulator (USE_MODEM_SIMULATOR == 1): never called */
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+  UNUSED(huart);
+  UNUSED(pData);
+  UNUSED(Size);
+
+  return (HAL_ERROR);
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+  UNUSED(huart);
+  UNUSED(pData);
+  UNUSED(Size);
+
+  return (HAL_ERROR);
+}
+
+HAL_StatusTypeDef HAL_UART_AbortTransmit_IT(UART_HandleTypeDef *huart)
+{
+  UNUSED(huart);
+
+  return (HAL_OK);
+}
+
+/**
+  * @brief  Random number generation.
+  * @param  hrng        - RNG handle
+  * @param  random32bit - generated number
+  * @retval HAL_OK
+  */
+HAL_StatusTypeDef HAL_RNG_GenerateRandomNumber(RNG_HandleTypeDef *hrng, uint32_t *random32bit)
+{
+  UNUSED(hrng);
+  *random32bit = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+
+  return (HAL_OK);
+}
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,203 @@
+/**
+  ******************************************************************************
+  * @file    host_hal.h
+  * @author  artworkTrackingMAP
+  * @brief   Subset of the STM32 HAL/CMSIS API used by the cellular stack,
+  *          implemented for a POSIX host in host_hal.c.
+  * @note    GPIO and NVIC services do nothing, UART transmit writes on stdout,
+  *          interrupt masking is a process wide lock (IPC "interrupts" are
+  *          raised by the modem simulator thread).
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define __IO                  volatile
+#define HAL_MAX_DELAY         0xFFFFFFFFU
+
+#define GPIO_MODE_INPUT       (0x00000000U)
+#define GPIO_MODE_OUTPUT_PP   (0x00000001U)
+#define GPIO_MODE_ANALOG      (0x00000003U)
+#define GPIO_MODE_IT_RISING   (0x10110000U)
+#define GPIO_MODE_IT_FALLING  (0x10210000U)
+#define GPIO_NOPULL           (0x00000000U)
+#define GPIO_PULLUP           (0x00000001U)
+#define GPIO_PULLDOWN         (0x00000002U)
+#define GPIO_SPEED_FREQ_LOW   (0x00000000U)
+#define GPIO_SPEED_FREQ_MEDIUM (0x00000001U)
+#define GPIO_SPEED_FREQ_HIGH  (0x00000002U)
+
+#define HAL_UART_STATE_RESET  (0x00000000U)
+#define HAL_UART_STATE_READY  (0x00000020U)
+
+#define UART_WORDLENGTH_8B          (0x00000000U)
+#define UART_STOPBITS_1             (0x00000000U)
+#define UART_PARITY_NONE            (0x00000000U)
+#define UART_MODE_TX_RX             (0x0000000CU)
+#define UART_HWCONTROL_NONE         (0x00000000U)
+#define UART_HWCONTROL_RTS_CTS      (0x00000300U)
+#define UART_OVERSAMPLING_16        (0x00000000U)
+#define UART_ONE_BIT_SAMPLE_DISABLE (0x00000000U)
+#define UART_ADVFEATURE_NO_INIT     (0x00000000U)
+
+#define FLASH_BANK_1          (0x00000001U)
+
+#define ITM_TCR_ITMENA_Msk    (1UL)
+
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  HAL_OK       = 0x00U,
+  HAL_ERROR    = 0x01U,
+  HAL_BUSY     = 0x02U,
+  HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+typedef int32_t IRQn_Type;
+
+typedef enum
+{
+  GPIO_PIN_RESET = 0U,
+  GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct
+{
+  __IO uint32_t IDR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+  uint32_t Pin;
+  uint32_t Mode;
+  uint32_t Pull;
+  uint32_t Speed;
+  uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+typedef struct
+{
+  __IO uint32_t CR1;
+} USART_TypeDef;
+
+typedef struct
+{
+  uint32_t BaudRate;
+  uint32_t WordLength;
+  uint32_t StopBits;
+  uint32_t Parity;
+  uint32_t Mode;
+  uint32_t HwFlowCtl;
+  uint32_t OverSampling;
+  uint32_t OneBitSampling;
+} UART_InitTypeDef;
+
+typedef struct
+{
+  uint32_t AdvFeatureInit;
+} UART_AdvFeatureInitTypeDef;
+
+typedef struct
+{
+  USART_TypeDef              *Instance;
+  UART_InitTypeDef           Init;
+  UART_AdvFeatureInitTypeDef AdvancedInit;
+  __IO uint32_t              gState;
+  __IO uint32_t              RxState;
+} UART_HandleTypeDef;
+
+typedef struct
+{
+  uint32_t State;
+} RNG_HandleTypeDef;
+
+typedef struct
+{
+  union
+  {
+    __IO uint8_t  u8;
+    __IO uint32_t u32;
+  } PORT[32U];
+  __IO uint32_t TER;
+  __IO uint32_t TCR;
+} ITM_Type;
+
+typedef struct
+{
+  __IO uint32_t CTRL;
+  __IO uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+  __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+/* External variables --------------------------------------------------------*/
+extern uint32_t SystemCoreClock; /* 1 GHz: the DWT cycle counter counts nanoseconds */
+extern UART_HandleTypeDef huart_modem;
+extern UART_HandleTypeDef huart_trace;
+extern RNG_HandleTypeDef hrng;
+extern ITM_Type host_itm; /* never enabled: ITM traces are dropped */
+extern CoreDebug_Type host_core_debug;
+
+/* Exported macros -----------------------------------------------------------*/
+#define UNUSED(X)       (void)(X)
+#define ITM             (&host_itm)
+#define DWT             (host_dwt())
+#define CoreDebug       (&host_core_debug)
+#define __NOP()         do {} while (0)
+#if defined(HOST_HAL_DMB_YIELD)
+/* Tests of lock free code: the thread is preempted at each barrier, as it may be on target */
+#include <sched.h>
+#define __DMB()         do { __sync_synchronize(); (void)sched_yield(); } while (0)
+#else
+#define __DMB()         __sync_synchronize()
+#endif /* defined(HOST_HAL_DMB_YIELD) */
+#define __disable_irq() host_irq_disable()
+#define __enable_irq()  host_irq_enable()
+
+/* Exported functions ------------------------------------------------------- */
+void host_irq_disable(void);
+void host_irq_enable(void);
+
+DWT_Type *host_dwt(void);
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_SetPendingIRQ(IRQn_Type IRQn);
+void NVIC_SystemReset(void);
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_AbortTransmit_IT(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_RNG_GenerateRandomNumber(RNG_HandleTypeDef *hrng, uint32_t *random32bit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_HAL_H */
+
+/******************************** END OF FILE *********************************/
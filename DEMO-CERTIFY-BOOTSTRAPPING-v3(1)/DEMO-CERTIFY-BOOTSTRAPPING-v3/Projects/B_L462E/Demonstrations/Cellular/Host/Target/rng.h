@@ -0,0 +1,26 @@
+/**
+  ******************************************************************************
+  * @file    rng.h
+  * @author  artworkTrackingMAP
+  * @brief   Host replacement of Core/Inc/rng.h: hrng is provided by host_hal.c.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef RNG_H
+#define RNG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "host_hal.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RNG_H */
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,43 @@
+/**
+  ******************************************************************************
+  * @file    host_test.h
+  * @author  artworkTrackingMAP
+  * @brief   Minimal check macros of the host tests: a failed check is printed
+  *          and the test executable returns a non null exit code.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+
+/* Exported variables --------------------------------------------------------*/
+static unsigned int host_test_failures = 0U;
+
+/* Exported macros -----------------------------------------------------------*/
+#define HOST_TEST_CHECK(cond)                                                \
+  do                                                                         \
+  {                                                                          \
+    if (!(cond))                                                             \
+    {                                                                        \
+      (void)printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);  \
+      host_test_failures++;                                                  \
+    }                                                                        \
+  } while (0)
+
+#define HOST_TEST_RESULT() ((host_test_failures == 0U) ? 0 : 1)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_TEST_H */
+
+/******************************** END OF FILE *********************************/
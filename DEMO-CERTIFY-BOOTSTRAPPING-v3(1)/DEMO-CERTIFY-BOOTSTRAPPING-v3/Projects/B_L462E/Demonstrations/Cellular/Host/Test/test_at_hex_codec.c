@@ -0,0 +1,221 @@
+/**
+  ******************************************************************************
+  * @file    test_at_hex_codec.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test and benchmark of the bulk HEX codec of at_util.c used by
+  *          the TYPE1SC %SOCKETDATA commands: results are compared with the
+  *          previous per-byte conversion; encode/decode MB/s and the bytes on
+  *          the UART per payload byte are printed.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "at_util.h"
+#include "plf_modem_config.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_MAX_SIZE     (1500U)
+#define TEST_BENCH_BYTES  (64U * 1024U * 1024U)
+#define TEST_BURST_SIZE   (4096U) /* telemetry burst used for the AT round-trips count */
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t test_bin[TEST_MAX_SIZE];
+static uint8_t test_hex[(2U * TEST_MAX_SIZE) + 1U];
+static uint8_t test_ref[(2U * TEST_MAX_SIZE) + 1U];
+static uint8_t test_out[TEST_MAX_SIZE];
+
+/* Private functions ---------------------------------------------------------*/
+/* Previous TYPE1SC conversion (one digit at a time, one memcpy per digit) */
+static uint8_t test_ref_digit(uint8_t nbr)
+{
+  return ((nbr <= 9U) ? (nbr + 48U) : (nbr + 87U));
+}
+
+static void test_ref_encode(const uint8_t *p_src, uint16_t size, uint8_t *p_dst)
+{
+  uint16_t idx;
+  uint8_t ms;
+  uint8_t ls;
+
+  for (idx = 0U; idx < size; idx++)
+  {
+    ms = test_ref_digit(p_src[idx] / 16U);
+    ls = test_ref_digit(p_src[idx] % 16U);
+    (void)memcpy(&p_dst[2U * idx], &ms, 1);
+    (void)memcpy(&p_dst[(2U * idx) + 1U], &ls, 1);
+  }
+}
+
+static int32_t test_ref_value(uint8_t digit)
+{
+  int32_t value = -1;
+
+  if ((digit >= 48U) && (digit <= 57U))
+  {
+    value = (int32_t)digit - 48;
+  }
+  else if ((digit >= 97U) && (digit <= 102U))
+  {
+    value = (int32_t)digit - 87;
+  }
+  else if ((digit >= 65U) && (digit <= 70U))
+  {
+    value = (int32_t)digit - 55;
+  }
+  else
+  {
+    /* invalid digit */
+  }
+
+  return (value);
+}
+
+static uint8_t test_ref_decode(const uint8_t *p_src, uint16_t size, uint8_t *p_dst)
+{
+  uint8_t error = 0U;
+  uint16_t idx;
+  int32_t ms;
+  int32_t ls;
+
+  for (idx = 0U; (idx < size) && (error == 0U); idx++)
+  {
+    ms = test_ref_value(p_src[2U * idx]);
+    ls = test_ref_value(p_src[(2U * idx) + 1U]);
+    if ((ms < 0) || (ls < 0))
+    {
+      error = 1U;
+    }
+    else
+    {
+      p_dst[idx] = (uint8_t)((ms * 16) + ls);
+    }
+  }
+
+  return (error);
+}
+
+static double test_elapsed_s(const struct timespec *p_start)
+{
+  struct timespec end;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &end);
+
+  return ((double)(end.tv_sec - p_start->tv_sec) + ((double)(end.tv_nsec - p_start->tv_nsec) / 1e9));
+}
+
+static void test_bench(uint16_t size)
+{
+  struct timespec start;
+  uint32_t loops = TEST_BENCH_BYTES / size;
+  uint32_t i;
+  double enc;
+  double enc_ref;
+  double dec;
+  double dec_ref;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0U; i < loops; i++)
+  {
+    test_bin[0] = (uint8_t)i;
+    ATutil_convertBufferToHexaString(test_bin, size, test_hex);
+  }
+  enc = test_elapsed_s(&start);
+  (void)clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0U; i < loops; i++)
+  {
+    test_bin[0] = (uint8_t)i;
+    test_ref_encode(test_bin, size, test_ref);
+  }
+  enc_ref = test_elapsed_s(&start);
+  (void)clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0U; i < loops; i++)
+  {
+    test_hex[0] = (uint8_t)'0' + (uint8_t)(i & 7U);
+    (void)ATutil_convertHexaStringToBuffer(test_hex, size, test_out);
+  }
+  dec = test_elapsed_s(&start);
+  (void)clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0U; i < loops; i++)
+  {
+    test_hex[0] = (uint8_t)'0' + (uint8_t)(i & 7U);
+    (void)test_ref_decode(test_hex, size, test_out);
+  }
+  dec_ref = test_elapsed_s(&start);
+
+  (void)printf("%4u bytes: encode %7.1f MB/s (per-byte %6.1f), decode %7.1f MB/s (per-byte %6.1f)\n",
+               size, (double)loops * size / enc / 1e6, (double)loops * size / enc_ref / 1e6,
+               (double)loops * size / dec / 1e6, (double)loops * size / dec_ref / 1e6);
+}
+
+/* Bytes on the UART per payload byte: AT%SOCKETDATA="SEND" command and its answer */
+static void test_wire(uint32_t payload_max)
+{
+  char cmd[64];
+  uint32_t commands = (TEST_BURST_SIZE + payload_max - 1U) / payload_max;
+  uint32_t overhead;
+
+  overhead = (uint32_t)snprintf(cmd, sizeof(cmd), "AT%%SOCKETDATA=\"SEND\",1,%lu,\"\"\r",
+                                (unsigned long)payload_max);
+  overhead += (uint32_t)snprintf(cmd, sizeof(cmd), "\r\n%%SOCKETDATA:1,%lu\r\n\r\nOK\r\n",
+                                 (unsigned long)payload_max);
+  (void)printf("payload %4lu: %.3f bytes on wire per payload byte, %lu AT commands per %u bytes burst\n",
+               (unsigned long)payload_max, (double)((2U * payload_max) + overhead) / (double)payload_max,
+               (unsigned long)commands, TEST_BURST_SIZE);
+}
+
+int main(void)
+{
+  uint16_t size;
+  uint32_t i;
+
+  srand(1U);
+  for (i = 0U; i < TEST_MAX_SIZE; i++)
+  {
+    test_bin[i] = (uint8_t)rand();
+  }
+  /* all byte values */
+  for (i = 0U; i < 256U; i++)
+  {
+    test_bin[i] = (uint8_t)i;
+  }
+
+  /* every size up to 64 (tails of the 4 bytes loop) and big sizes */
+  for (size = 0U; size <= TEST_MAX_SIZE; size = (size < 64U) ? (size + 1U) : (size + 239U))
+  {
+    (void)memset(test_hex, 0xA5, sizeof(test_hex));
+    (void)memset(test_ref, 0xA5, sizeof(test_ref));
+    ATutil_convertBufferToHexaString(test_bin, size, test_hex);
+    test_ref_encode(test_bin, size, test_ref);
+    HOST_TEST_CHECK(memcmp(test_hex, test_ref, sizeof(test_hex)) == 0); /* nothing written after 2 * size */
+    (void)memset(test_out, 0, sizeof(test_out));
+    HOST_TEST_CHECK(ATutil_convertHexaStringToBuffer(test_hex, size, test_out) == 0U);
+    HOST_TEST_CHECK(memcmp(test_out, test_bin, size) == 0);
+  }
+
+  /* upper case digits are accepted, any other character is rejected */
+  HOST_TEST_CHECK(ATutil_convertHexaStringToBuffer((const uint8_t *)"A0fF", 2U, test_out) == 0U);
+  HOST_TEST_CHECK((test_out[0] == 0xA0U) && (test_out[1] == 0xFFU));
+  for (i = 0U; i < 256U; i++)
+  {
+    uint8_t digits[4] = { (uint8_t)'4', (uint8_t)'1', (uint8_t)'3', (uint8_t)i };
+    HOST_TEST_CHECK(ATutil_convertHexaStringToBuffer(digits, 2U, test_out)
+                    == test_ref_decode(digits, 2U, test_ref));
+  }
+
+  /* benchmark */
+  test_bench(64U);
+  test_bench(710U);
+  test_bench(1460U);
+  test_wire(710U);
+  test_wire(CONFIG_MODEM_MAX_SOCKET_TX_DATA_SIZE);
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
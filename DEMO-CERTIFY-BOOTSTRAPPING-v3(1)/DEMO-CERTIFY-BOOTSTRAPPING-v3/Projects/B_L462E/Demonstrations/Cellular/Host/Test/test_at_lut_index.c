@@ -0,0 +1,154 @@
+/**
+  ******************************************************************************
+  * @file    test_at_lut_index.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test of the modem LUT hash index (atcm_build_LUT_index):
+  *          each lookup must return the same command as the linear LUT scan,
+  *          on the TYPE1SC LUT strings (duplicates, empty and unknown strings).
+  *          Lookup times of both searches are printed.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "at_modem_common.h"
+#include "at_modem_signalling.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_BENCH_LOOPS  (200000U)
+
+/* Private variables ---------------------------------------------------------*/
+/* Command strings of ATCMD_TYPE1SC_LUT, in the same order */
+static const char *const test_lut_str[] =
+{
+  "", "OK", "CONNECT", "RING", "NO CARRIER", "ERROR", "NO DIALTONE", "BUSY", "NO ANSWER",
+  "+CME ERROR", "+CMS ERROR", "+CGMI", "+CGMM", "+CGMR", "+CGSN", "+GSN", "+CIMI", "+CEER",
+  "+CMEE", "+CPIN", "+CFUN", "+COPS", "+CNUM", "+CGATT", "+CGPADDR", "+CEREG", "+CREG",
+  "+CGREG", "+CSQ", "+CGDCONT", "+CGACT", "+CGDATA", "+CGEREP", "+CGEV", "D", "E", "H", "O",
+  "V", "X", "Z", "+++", "+IPR", "+IFC", "&W", "&D", "", "&K3", "&K0", "+CPSMS", "+CEDRXS",
+  "+CEDRXP", "+CEDRXRDP", "+CSIM", "%PDNSET", "%CCID", "%SETCFG", "%GETCFG", "%SETACFG",
+  "%GETACFG", "%SETBDELAY", "%PDNACT", "%SOCKETCMD", "%SOCKETCMD", "%SOCKETCMD", "%SOCKETCMD",
+  "%SOCKETCMD", "%SOCKETDATA", "%SOCKETDATA", "%DNSRSLV", "%PINGCMD", "%SOCKETEV", "%BOOTEV"
+};
+#define TEST_LUT_SIZE (sizeof(test_lut_str) / sizeof(test_lut_str[0]))
+
+/* Received elements which are not in the LUT */
+static const char *const test_unknown_str[] =
+{
+  "+CSQ1", "+CS", "%SOCKET", "ok", "CONNEC", "+CGEREPX", "%SOCKETEVT",
+  "A_VERY_LONG_ELEMENT_RECEIVED_FROM_THE_MODEM_WHICH_IS_LONGER_THAN_ANY_LUT_STRING"
+};
+#define TEST_UNKNOWN_SIZE (sizeof(test_unknown_str) / sizeof(test_unknown_str[0]))
+
+static atcustom_LUT_t test_lut[ATCM_LUT_INDEX_MAX_ENTRIES + 1U];
+static atcustom_modem_context_t test_ctxt;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t test_search(const char *p_str, at_bool_t use_index)
+{
+  uint8_t buffer[128];
+  IPC_RxMessage_t msg;
+  at_element_info_t infos;
+  size_t size = strlen(p_str);
+
+  /* element is located after a prefix, as in a received line */
+  buffer[0] = (uint8_t)'\r';
+  buffer[1] = (uint8_t)'\n';
+  (void)memcpy(&buffer[2], p_str, size);
+  msg.buffer = buffer;
+  msg.size = (uint16_t)(size + 2U);
+  (void)memset(&infos, 0, sizeof(infos));
+  infos.str_start_idx = 2U;
+  infos.str_size = (uint16_t)size;
+
+  test_ctxt.LUT_index.ready = use_index;
+  (void)atcm_searchCmdInLUT(&test_ctxt, NULL, &msg, &infos);
+  test_ctxt.LUT_index.ready = AT_TRUE;
+
+  return (infos.cmd_id_received);
+}
+
+static double test_bench(at_bool_t use_index)
+{
+  struct timespec start;
+  struct timespec end;
+  volatile uint32_t id = 0U;
+  uint32_t i;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0U; i < TEST_BENCH_LOOPS; i++)
+  {
+    /* typical received elements: final result codes and URC/answers of the end of the LUT */
+    id += test_search("OK", use_index);
+    id += test_search("%SOCKETDATA", use_index);
+    id += test_search("+CEREG", use_index);
+    id += test_search("%SOCKETEV", use_index);
+  }
+  (void)clock_gettime(CLOCK_MONOTONIC, &end);
+
+  return ((((double)(end.tv_sec - start.tv_sec) * 1e9) + (double)(end.tv_nsec - start.tv_nsec))
+          / (4.0 * (double)TEST_BENCH_LOOPS));
+}
+
+int main(void)
+{
+  uint32_t i;
+  uint32_t j;
+  uint32_t expected;
+
+  for (i = 0U; i < TEST_LUT_SIZE; i++)
+  {
+    test_lut[i].cmd_id = 100U + i;
+    (void)strncpy((char *)test_lut[i].cmd_str, test_lut_str[i], ATCMD_MAX_NAME_SIZE - 1U);
+  }
+  test_ctxt.p_modem_LUT = test_lut;
+  test_ctxt.modem_LUT_size = TEST_LUT_SIZE;
+  atcm_build_LUT_index(&test_ctxt);
+  HOST_TEST_CHECK(test_ctxt.LUT_index.ready == AT_TRUE);
+
+  /* each LUT string: first entry with this string, as the linear search */
+  for (i = 1U; i < TEST_LUT_SIZE; i++)
+  {
+    if (test_lut_str[i][0] != '\0')
+    {
+      expected = 0U;
+      for (j = 0U; (j < TEST_LUT_SIZE) && (expected == 0U); j++)
+      {
+        if (strcmp(test_lut_str[j], test_lut_str[i]) == 0)
+        {
+          expected = 100U + j;
+        }
+      }
+      HOST_TEST_CHECK(test_search(test_lut_str[i], AT_TRUE) == expected);
+      HOST_TEST_CHECK(test_search(test_lut_str[i], AT_FALSE) == expected);
+    }
+  }
+
+  /* empty element and unknown elements */
+  HOST_TEST_CHECK(test_search("", AT_TRUE) == (uint32_t)CMD_AT);
+  for (i = 0U; i < TEST_UNKNOWN_SIZE; i++)
+  {
+    HOST_TEST_CHECK(test_search(test_unknown_str[i], AT_TRUE) == (uint32_t)CMD_AT_INVALID);
+    HOST_TEST_CHECK(test_search(test_unknown_str[i], AT_FALSE) == (uint32_t)CMD_AT_INVALID);
+  }
+
+  (void)printf("LUT lookup: index %.1f ns, linear %.1f ns\n", test_bench(AT_TRUE), test_bench(AT_FALSE));
+
+  /* LUT too big: not indexed, linear search is used */
+  for (i = TEST_LUT_SIZE; i < (ATCM_LUT_INDEX_MAX_ENTRIES + 1U); i++)
+  {
+    test_lut[i].cmd_id = 100U + i;
+    (void)strcpy((char *)test_lut[i].cmd_str, "+FILL");
+  }
+  test_ctxt.modem_LUT_size = ATCM_LUT_INDEX_MAX_ENTRIES + 1U;
+  atcm_build_LUT_index(&test_ctxt);
+  HOST_TEST_CHECK(test_ctxt.LUT_index.ready == AT_FALSE);
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
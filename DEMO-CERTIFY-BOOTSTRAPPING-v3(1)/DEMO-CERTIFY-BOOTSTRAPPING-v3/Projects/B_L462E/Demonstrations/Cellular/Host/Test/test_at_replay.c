@@ -0,0 +1,309 @@
+/**
+  ******************************************************************************
+  * @file    test_at_replay.c
+  * @author  artworkTrackingMAP
+  * @brief   Host replay of the AT traffic recorded by at_recorder.c: a first
+  *          process records the network attach with the simulated Type1SC
+  *          modem, a second one replays the recorded responses to the whole
+  *          stack (AT core, Type1SC custom layer, cellular service) on
+  *          rtosal_posix. The parser must return the recorded actions and
+  *          the network must come up; the parser time on host is reported.
+  * @note    Built with USE_AT_RECORDER and rings large enough for the attach.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "rtosal.h"
+#include "dc_common.h"
+#include "cellular_datacache.h"
+#include "cellular_mngt.h"
+#include "at_recorder.h"
+#include "ipc_sim.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_ATTACH_TIMEOUT   (30000U) /* in ms */
+#define TEST_LINE_SIZE        (256U)
+
+/* Private typedef -----------------------------------------------------------*/
+/* ATREC T line */
+typedef struct
+{
+  uint32_t seq;
+  char     name[AT_RECORDER_NAME_SIZE];
+  uint32_t tx;
+} test_record_t;
+
+/* ATREC R line and its ATREC D lines */
+typedef struct
+{
+  int32_t  seq;
+  uint32_t size;
+  uint32_t parse_cycles;
+  uint32_t action;
+  uint32_t offset;   /* of the bytes in test_session_t data */
+  uint32_t stored;
+  bool     matched;
+} test_rsp_t;
+
+/* One "atrec dump" */
+typedef struct
+{
+  uint32_t clock;
+  uint32_t lost;
+  uint32_t records_nb;
+  uint32_t rsp_nb;
+  test_record_t records[AT_RECORDER_RECORDS];
+  test_rsp_t rsp[AT_RECORDER_RSP_BUFFER_SIZE / 16U];
+  uint8_t data[AT_RECORDER_RSP_BUFFER_SIZE];
+  uint32_t data_size;
+} test_session_t;
+
+/* Private variables ---------------------------------------------------------*/
+static test_session_t test_recorded;
+static test_session_t test_replayed;
+static IPC_SIM_ReplayRsp_t test_replay[AT_RECORDER_RSP_BUFFER_SIZE / 16U];
+
+/* Private functions ---------------------------------------------------------*/
+static bool test_wait_network(void)
+{
+  dc_nifman_info_t nifman_info;
+  uint32_t waited = 0U;
+  bool up = false;
+
+  while ((up == false) && (waited < TEST_ATTACH_TIMEOUT))
+  {
+    (void)dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+    if (nifman_info.rt_state == DC_SERVICE_ON)
+    {
+      up = true;
+    }
+    else
+    {
+      (void)rtosalDelay(10U);
+      waited += 10U;
+    }
+  }
+
+  return (up);
+}
+
+/* Attach the stack to the network then dump the recorder in p_file: returns true if the network is up */
+static bool test_attach(FILE *p_file)
+{
+  dc_cellular_params_t cellular_params;
+  int saved_stdout;
+  bool up;
+
+  /* trace UART is stdout: the dump is captured in the file */
+  (void)fflush(stdout);
+  saved_stdout = dup(STDOUT_FILENO);
+  (void)dup2(fileno(p_file), STDOUT_FILENO);
+
+  (void)rtosalKernelInitialize();
+  (void)rtosalKernelStart();
+  cellular_init();
+  (void)dc_com_read(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_set_default_setup_config(&cellular_params);
+  (void)dc_com_write(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_start();
+  up = test_wait_network();
+  ATRecorder_dump();
+
+  (void)fflush(stdout);
+  (void)dup2(saved_stdout, STDOUT_FILENO);
+  (void)close(saved_stdout);
+
+  return (up);
+}
+
+/* Read the dump of p_file, as at_recorder_report.py does */
+static void test_read_dump(FILE *p_file, test_session_t *p_session)
+{
+  char line[TEST_LINE_SIZE];
+  const char *p_rec;
+  test_record_t *p_record;
+  test_rsp_t *p_rsp = NULL;
+  unsigned int value;
+  unsigned long records_nb;
+  long seq;
+  int pos;
+  int len;
+
+  (void)memset(p_session, 0, sizeof(test_session_t));
+  (void)fseek(p_file, 0L, SEEK_SET);
+  while (fgets(line, (int)sizeof(line), p_file) != NULL)
+  {
+    p_rec = strstr(line, "ATREC ");
+    if (p_rec == NULL)
+    {
+      continue;
+    }
+    p_record = &p_session->records[p_session->records_nb];
+    if (strncmp(p_rec, "ATREC H ", 8U) == 0)
+    {
+      HOST_TEST_CHECK(sscanf(&p_rec[8], "%u %u %*u %lu %u", &value, &p_session->clock, &records_nb,
+                             &p_session->lost) == 4);
+      HOST_TEST_CHECK(value == 1U);
+    }
+    else if ((strncmp(p_rec, "ATREC T ", 8U) == 0) && (p_session->records_nb < AT_RECORDER_RECORDS))
+    {
+      HOST_TEST_CHECK(sscanf(&p_rec[8], "%u %*u %*u %11s %*u %*u %*d %*d %u", &p_record->seq, p_record->name,
+                             &p_record->tx) == 3);
+      p_session->records_nb++;
+    }
+    else if ((strncmp(p_rec, "ATREC R ", 8U) == 0) && (p_session->rsp_nb < (AT_RECORDER_RSP_BUFFER_SIZE / 16U)))
+    {
+      p_rsp = &p_session->rsp[p_session->rsp_nb];
+      HOST_TEST_CHECK(sscanf(&p_rec[8], "%ld %u %u %u", &seq, &p_rsp->size, &p_rsp->parse_cycles,
+                             &p_rsp->action) == 4);
+      p_rsp->seq = (int32_t)seq;
+      p_rsp->offset = p_session->data_size;
+      p_session->rsp_nb++;
+    }
+    else if ((strncmp(p_rec, "ATREC D ", 8U) == 0) && (p_rsp != NULL))
+    {
+      for (pos = 8; (sscanf(&p_rec[pos], "%2x%n", &value, &len) == 1) && (len == 2)
+           && (p_session->data_size < AT_RECORDER_RSP_BUFFER_SIZE); pos += 2)
+      {
+        p_session->data[p_session->data_size] = (uint8_t)value;
+        p_session->data_size++;
+        p_rsp->stored++;
+      }
+    }
+    else
+    {
+      /* ATREC E */
+    }
+  }
+}
+
+/* Responses to replay: the first response of a command sent is sent when this command is received */
+static uint16_t test_build_replay(test_session_t *p_session)
+{
+  const test_record_t *p_record;
+  int32_t last_seq = -1;
+  uint32_t i;
+
+  for (i = 0U; i < p_session->rsp_nb; i++)
+  {
+    test_replay[i].p_cmd = NULL;
+    test_replay[i].p_data = &p_session->data[p_session->rsp[i].offset];
+    test_replay[i].size = (uint16_t)p_session->rsp[i].stored;
+    test_replay[i].replayed = 0U;
+    if ((p_session->rsp[i].seq >= 0) && (p_session->rsp[i].seq != last_seq))
+    {
+      last_seq = p_session->rsp[i].seq;
+      p_record = &p_session->records[(uint32_t)last_seq - p_session->records[0].seq];
+      HOST_TEST_CHECK(p_record->seq == (uint32_t)last_seq);
+      if (p_record->tx != 0U)
+      {
+        /* name is dumped as "-" if empty: matches any command */
+        test_replay[i].p_cmd = (const uint8_t *)((strcmp(p_record->name, "-") == 0) ? "" : p_record->name);
+      }
+    }
+  }
+
+  return ((uint16_t)p_session->rsp_nb);
+}
+
+/* Each recorded response is parsed again with the same action: returns the number of responses compared */
+static uint32_t test_compare(void)
+{
+  const test_rsp_t *p_rec;
+  test_rsp_t *p_rep;
+  uint32_t compared = 0U;
+  uint32_t i;
+  uint32_t j;
+
+  for (i = 0U; i < test_recorded.rsp_nb; i++)
+  {
+    p_rec = &test_recorded.rsp[i];
+    p_rep = NULL;
+    for (j = 0U; (j < test_replayed.rsp_nb) && (p_rep == NULL); j++)
+    {
+      if ((test_replayed.rsp[j].matched == false) && (test_replayed.rsp[j].stored == p_rec->stored)
+          && (memcmp(&test_replayed.data[test_replayed.rsp[j].offset], &test_recorded.data[p_rec->offset],
+                     p_rec->stored) == 0))
+      {
+        p_rep = &test_replayed.rsp[j];
+        p_rep->matched = true;
+      }
+    }
+    HOST_TEST_CHECK(p_rep != NULL);
+    if (p_rep != NULL)
+    {
+      HOST_TEST_CHECK(p_rep->action == p_rec->action);
+      compared++;
+    }
+  }
+
+  return (compared);
+}
+
+int main(void)
+{
+  IPC_SIM_Statistics_t stats;
+  FILE *p_recorded;
+  FILE *p_replayed;
+  pid_t pid;
+  int status = -1;
+  uint16_t replay_nb;
+  uint32_t compared;
+  uint64_t cycles = 0U;
+  uint32_t cycles_max = 0U;
+  uint32_t i;
+
+  /* the stack runs once per process: recording in a child process */
+  p_recorded = tmpfile();
+  p_replayed = tmpfile();
+  HOST_TEST_CHECK((p_recorded != NULL) && (p_replayed != NULL));
+  (void)fflush(stdout);
+  pid = fork();
+  if (pid == 0)
+  {
+    _exit((test_attach(p_recorded) == true) ? 0 : 1);
+  }
+  HOST_TEST_CHECK((pid > 0) && (waitpid(pid, &status, 0) == pid));
+  HOST_TEST_CHECK(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+
+  if (HOST_TEST_RESULT() == 0)
+  {
+    test_read_dump(p_recorded, &test_recorded);
+    /* the whole attach is recorded */
+    HOST_TEST_CHECK((test_recorded.records_nb != 0U) && (test_recorded.records_nb < AT_RECORDER_RECORDS));
+    HOST_TEST_CHECK((test_recorded.rsp_nb != 0U) && (test_recorded.lost == 0U));
+    replay_nb = test_build_replay(&test_recorded);
+    IPC_SIM_replay(test_replay, replay_nb);
+
+    HOST_TEST_CHECK(test_attach(p_replayed) == true);
+    IPC_SIM_getStatistics(&stats);
+    HOST_TEST_CHECK(stats.replay_unmatched == 0U);
+    for (i = 0U; i < replay_nb; i++)
+    {
+      HOST_TEST_CHECK(test_replay[i].replayed == 1U);
+    }
+
+    test_read_dump(p_replayed, &test_replayed);
+    compared = test_compare();
+    for (i = 0U; i < test_replayed.rsp_nb; i++)
+    {
+      cycles += test_replayed.rsp[i].parse_cycles;
+      cycles_max = (test_replayed.rsp[i].parse_cycles > cycles_max) ? test_replayed.rsp[i].parse_cycles : cycles_max;
+    }
+    (void)printf("%lu AT commands, %lu responses replayed, %lu compared: parser %.1f us average, %.1f us max\n",
+                 (unsigned long)test_replayed.records_nb, (unsigned long)replay_nb, (unsigned long)compared,
+                 (double)cycles * 1000000.0 / (double)test_replayed.clock / (double)test_replayed.rsp_nb,
+                 (double)cycles_max * 1000000.0 / (double)test_replayed.clock);
+  }
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,242 @@
+/**
+  ******************************************************************************
+  * @file    test_com_dns_cache.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test of the DNS cache of com_gethostbyname with the simulated
+  *          Type1SC modem: a cached name sends no DNS request to the modem,
+  *          concurrent lookups of a name share one request, the least
+  *          recently used name is replaced, an address expires after the
+  *          minimum TTL and the cache is flushed when the network goes down.
+  * @note    Built with a COM_DNS_CACHE_TTL_MIN of 2 s.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+
+#include "rtosal.h"
+#include "dc_common.h"
+#include "cellular_datacache.h"
+#include "cellular_mngt.h"
+#include "com_sockets.h"
+#include "com_dns_cache.h"
+#include "ipc_sim.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_ATTACH_TIMEOUT   (30000U) /* in ms */
+#define TEST_THREADS_NB       (8U)     /* concurrent lookups of the same name */
+#define TEST_NAME_SIZE        (32U)
+
+/* Private variables ---------------------------------------------------------*/
+static osSemaphoreId test_done;
+static uint32_t test_remote_ip;
+
+/* Private functions ---------------------------------------------------------*/
+static bool test_wait_network(void)
+{
+  dc_nifman_info_t nifman_info;
+  uint32_t waited = 0U;
+  bool up = false;
+
+  while ((up == false) && (waited < TEST_ATTACH_TIMEOUT))
+  {
+    (void)dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+    if (nifman_info.rt_state == DC_SERVICE_ON)
+    {
+      up = true;
+    }
+    else
+    {
+      (void)rtosalDelay(10U);
+      waited += 10U;
+    }
+  }
+
+  return (up);
+}
+
+/* Number of DNS requests received by the modem */
+static uint32_t test_dns_count(void)
+{
+  IPC_SIM_Statistics_t stats;
+
+  IPC_SIM_getStatistics(&stats);
+
+  return (stats.dns_count);
+}
+
+/* Resolve a name: the address is the simulator one */
+static void test_resolve(const char *p_name)
+{
+  com_sockaddr_in_t address;
+
+  (void)memset(&address, 0, sizeof(address));
+  HOST_TEST_CHECK(com_gethostbyname((const com_char_t *)p_name, (com_sockaddr_t *)&address) == COM_SOCKETS_ERR_OK);
+  HOST_TEST_CHECK(address.sin_addr.s_addr == test_remote_ip);
+}
+
+/* Network down then up, as notified by the network interface manager */
+static void test_network_lost(void)
+{
+  dc_nifman_info_t nifman_info;
+
+  (void)dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+  nifman_info.rt_state = DC_SERVICE_OFF;
+  (void)dc_com_write(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+  nifman_info.rt_state = DC_SERVICE_ON;
+  (void)dc_com_write(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+}
+
+/* A name resolved once is then found without a DNS request */
+static void test_hit(void)
+{
+  com_dns_cache_stat_t before;
+  com_dns_cache_stat_t after;
+  uint32_t dns_count = test_dns_count();
+
+  com_dns_cache_get_stat(&before);
+  test_resolve("hit.test");
+  HOST_TEST_CHECK(test_dns_count() == (dns_count + 1U));
+  test_resolve("hit.test");
+  test_resolve("hit.test");
+  HOST_TEST_CHECK(test_dns_count() == (dns_count + 1U));
+  com_dns_cache_get_stat(&after);
+  HOST_TEST_CHECK((after.miss - before.miss) == 1U);
+  HOST_TEST_CHECK((after.hit - before.hit) == 2U);
+}
+
+static void test_lookup_thread(void const *p_arg)
+{
+  UNUSED(p_arg);
+  test_resolve("coalesced.test");
+  (void)rtosalSemaphoreRelease(test_done);
+}
+
+/* Concurrent lookups of a name not cached: one DNS request, the others wait for its result */
+static uint32_t test_coalesce(void)
+{
+  com_dns_cache_stat_t before;
+  com_dns_cache_stat_t after;
+  uint32_t dns_count = test_dns_count();
+  uint32_t i;
+
+  com_dns_cache_get_stat(&before);
+  test_done = rtosalSemaphoreNew(NULL, TEST_THREADS_NB);
+  for (i = 0U; i < TEST_THREADS_NB; i++)
+  {
+    (void)rtosalSemaphoreAcquire(test_done, 0U);
+  }
+  for (i = 0U; i < TEST_THREADS_NB; i++)
+  {
+    HOST_TEST_CHECK(rtosalThreadNew((const rtosal_char_t *)"TestLookup", test_lookup_thread, osPriorityNormal,
+                                    1024U, NULL) != NULL);
+  }
+  for (i = 0U; i < TEST_THREADS_NB; i++)
+  {
+    (void)rtosalSemaphoreAcquire(test_done, RTOSAL_WAIT_FOREVER);
+  }
+  HOST_TEST_CHECK(test_dns_count() == (dns_count + 1U));
+  com_dns_cache_get_stat(&after);
+  HOST_TEST_CHECK((after.miss - before.miss) == 1U);
+  HOST_TEST_CHECK((after.hit - before.hit) == (TEST_THREADS_NB - 1U));
+
+  return (after.coalesced - before.coalesced);
+}
+
+/* Cache full: the name not looked up for the longest time is replaced */
+static void test_lru(void)
+{
+  char name[TEST_NAME_SIZE];
+  uint32_t dns_count;
+  uint32_t i;
+
+  test_network_lost();
+  for (i = 0U; i < COM_DNS_CACHE_NB; i++)
+  {
+    (void)snprintf(name, sizeof(name), "lru%lu.test", (unsigned long)i);
+    test_resolve(name);
+    (void)rtosalDelay(2U);
+  }
+  /* lru1.test is now the least recently used */
+  test_resolve("lru0.test");
+  (void)rtosalDelay(2U);
+  (void)snprintf(name, sizeof(name), "lru%lu.test", (unsigned long)COM_DNS_CACHE_NB);
+  test_resolve(name);
+
+  dns_count = test_dns_count();
+  test_resolve("lru0.test");
+  HOST_TEST_CHECK(test_dns_count() == dns_count);
+  test_resolve("lru1.test");
+  HOST_TEST_CHECK(test_dns_count() == (dns_count + 1U));
+}
+
+/* The modem gives no TTL: an address is kept COM_DNS_CACHE_TTL_MIN */
+static void test_ttl(void)
+{
+  uint32_t dns_count = test_dns_count();
+
+  test_resolve("ttl.test");
+  (void)rtosalDelay((1000U * COM_DNS_CACHE_TTL_MIN) - 500U);
+  test_resolve("ttl.test");
+  HOST_TEST_CHECK(test_dns_count() == (dns_count + 1U));
+  (void)rtosalDelay(1000U);
+  test_resolve("ttl.test");
+  HOST_TEST_CHECK(test_dns_count() == (dns_count + 2U));
+}
+
+/* Addresses may change with the next PDN activation: forgotten when the network goes down */
+static void test_flush(void)
+{
+  com_dns_cache_stat_t before;
+  com_dns_cache_stat_t after;
+  uint32_t dns_count = test_dns_count();
+
+  com_dns_cache_get_stat(&before);
+  test_resolve("flush.test");
+  test_network_lost();
+  test_resolve("flush.test");
+  HOST_TEST_CHECK(test_dns_count() == (dns_count + 2U));
+  com_dns_cache_get_stat(&after);
+  HOST_TEST_CHECK((after.flush - before.flush) == 1U);
+}
+
+int main(void)
+{
+  dc_cellular_params_t cellular_params;
+  com_dns_cache_stat_t stat;
+  com_ip_addr_t remote_ip;
+  uint32_t coalesced;
+
+  COM_IP4_ADDR(&remote_ip, 10U, 0U, 0U, 1U); /* IPC_SIM_REMOTE_IP_ADDR */
+  test_remote_ip = remote_ip.addr;
+
+  (void)rtosalKernelInitialize();
+  (void)rtosalKernelStart();
+
+  cellular_init();
+  (void)dc_com_read(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_set_default_setup_config(&cellular_params);
+  (void)dc_com_write(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_start();
+
+  HOST_TEST_CHECK(test_wait_network() == true);
+  if (HOST_TEST_RESULT() == 0)
+  {
+    test_hit();
+    coalesced = test_coalesce();
+    test_lru();
+    test_ttl();
+    test_flush();
+
+    com_dns_cache_get_stat(&stat);
+    (void)printf("%lu lookups, %lu DNS requests: %lu hits (%lu of %lu concurrent lookups coalesced), %lu flushes\n",
+                 (unsigned long)(stat.hit + stat.miss), (unsigned long)test_dns_count(), (unsigned long)stat.hit,
+                 (unsigned long)coalesced, (unsigned long)(TEST_THREADS_NB - 1U), (unsigned long)stat.flush);
+  }
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,312 @@
+/**
+  ******************************************************************************
+  * @file    test_com_poll.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test of com_poll with the simulated Type1SC modem: one thread
+  *          serves several echo sockets, woken by the data ready notification
+  *          of the socket that has data; a socket closed by the server is
+  *          reported POLLHUP, a closed socket POLLNVAL and the connected
+  *          sockets POLLERR while the network is down.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "rtosal.h"
+#include "dc_common.h"
+#include "cellular_datacache.h"
+#include "cellular_mngt.h"
+#include "com_sockets.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_ATTACH_TIMEOUT   (30000U) /* in ms */
+#define TEST_POLL_TIMEOUT     (5000)   /* in ms */
+#define TEST_ECHO_PORT        (7U)     /* no local server: simulator echo */
+#define TEST_SOCKETS_NB       (3U)
+#define TEST_ROUNDS_NB        (10U)
+#define TEST_MSG_SIZE         (64U)
+
+/* Private variables ---------------------------------------------------------*/
+static int test_server_fd;
+
+/* Private functions ---------------------------------------------------------*/
+static bool test_wait_network(void)
+{
+  dc_nifman_info_t nifman_info;
+  uint32_t waited = 0U;
+  bool up = false;
+
+  while ((up == false) && (waited < TEST_ATTACH_TIMEOUT))
+  {
+    (void)dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+    if (nifman_info.rt_state == DC_SERVICE_ON)
+    {
+      up = true;
+    }
+    else
+    {
+      (void)rtosalDelay(10U);
+      waited += 10U;
+    }
+  }
+
+  return (up);
+}
+
+/* Local host server: accepts one connection and closes it */
+static void *test_server(void *p_arg)
+{
+  int fd;
+
+  (void)p_arg;
+  fd = accept(test_server_fd, NULL, NULL);
+  HOST_TEST_CHECK(fd >= 0);
+  (void)close(fd);
+
+  return (NULL);
+}
+
+static uint16_t test_server_start(pthread_t *p_thread)
+{
+  struct sockaddr_in address;
+  socklen_t len = (socklen_t)sizeof(address);
+
+  test_server_fd = socket(AF_INET, SOCK_STREAM, 0);
+  (void)memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0U; /* any free port */
+  HOST_TEST_CHECK(bind(test_server_fd, (struct sockaddr *)&address, len) == 0);
+  HOST_TEST_CHECK(listen(test_server_fd, 1) == 0);
+  HOST_TEST_CHECK(getsockname(test_server_fd, (struct sockaddr *)&address, &len) == 0);
+  HOST_TEST_CHECK(pthread_create(p_thread, NULL, test_server, NULL) == 0);
+
+  return (ntohs(address.sin_port));
+}
+
+static int32_t test_open(uint16_t port)
+{
+  com_sockaddr_in_t address;
+  com_ip_addr_t remote_ip;
+  int32_t sock;
+
+  sock = com_socket(COM_AF_INET, COM_SOCK_STREAM, COM_IPPROTO_TCP);
+  HOST_TEST_CHECK(sock >= 0);
+  (void)memset(&address, 0, sizeof(address));
+  address.sin_family = (uint8_t)COM_AF_INET;
+  address.sin_port   = COM_HTONS(port);
+  COM_IP4_ADDR(&remote_ip, 10U, 0U, 0U, 1U); /* IPC_SIM_REMOTE_IP_ADDR */
+  address.sin_addr.s_addr = remote_ip.addr;
+  HOST_TEST_CHECK(com_connect(sock, (com_sockaddr_t const *)&address, (int32_t)sizeof(com_sockaddr_in_t))
+                  == COM_SOCKETS_ERR_OK);
+
+  return (sock);
+}
+
+/* Network down or up, as notified by the network interface manager */
+static void test_network_set(dc_service_rt_state_t rt_state)
+{
+  dc_nifman_info_t nifman_info;
+
+  (void)dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+  nifman_info.rt_state = rt_state;
+  (void)dc_com_write(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+}
+
+/* Connected sockets: writable, nothing to read, a poll without event lasts its timeout */
+static void test_idle(com_pollfd_t *p_fds)
+{
+  uint32_t start;
+  uint32_t i;
+
+  for (i = 0U; i < TEST_SOCKETS_NB; i++)
+  {
+    p_fds[i].events = COM_POLLIN | COM_POLLOUT;
+  }
+  HOST_TEST_CHECK(com_poll(p_fds, TEST_SOCKETS_NB, 0) == (int32_t)TEST_SOCKETS_NB);
+  for (i = 0U; i < TEST_SOCKETS_NB; i++)
+  {
+    HOST_TEST_CHECK(p_fds[i].revents == COM_POLLOUT);
+    p_fds[i].events = COM_POLLIN;
+  }
+
+  start = rtosalGetSysTimerCount();
+  HOST_TEST_CHECK(com_poll(p_fds, TEST_SOCKETS_NB, 100) == 0);
+  HOST_TEST_CHECK((rtosalGetSysTimerCount() - start) >= 100U);
+
+  HOST_TEST_CHECK(com_poll(p_fds, 0U, 0) == COM_SOCKETS_ERR_PARAMETER);
+  HOST_TEST_CHECK(com_poll(p_fds, (uint32_t)COM_POLL_FDS_MAX + 1U, 0) == COM_SOCKETS_ERR_PARAMETER);
+}
+
+/* One thread serves all the sockets: each round, a message is sent on each socket and the echoes are
+   read when com_poll reports them - returns the longest com_poll wait (in ms) */
+static uint32_t test_event_loop(com_pollfd_t *p_fds, uint32_t *p_polls)
+{
+  uint8_t tx[TEST_SOCKETS_NB][TEST_MSG_SIZE];
+  uint8_t rx[TEST_SOCKETS_NB][2U * TEST_MSG_SIZE];
+  int32_t received[TEST_SOCKETS_NB];
+  uint32_t done;
+  uint32_t start;
+  uint32_t wait;
+  uint32_t wait_max = 0U;
+  int32_t ready;
+  int32_t ret;
+  uint32_t round;
+  uint32_t i;
+
+  *p_polls = 0U;
+  for (round = 0U; round < TEST_ROUNDS_NB; round++)
+  {
+    for (i = 0U; i < TEST_SOCKETS_NB; i++)
+    {
+      (void)memset(tx[i], (int32_t)((round * TEST_SOCKETS_NB) + i), TEST_MSG_SIZE);
+      received[i] = 0;
+      p_fds[i].events = COM_POLLIN;
+      HOST_TEST_CHECK(com_send(p_fds[i].fd, (const com_char_t *)tx[i], (int32_t)TEST_MSG_SIZE, COM_MSG_WAIT)
+                      == (int32_t)TEST_MSG_SIZE);
+    }
+
+    done = 0U;
+    while (done < TEST_SOCKETS_NB)
+    {
+      start = rtosalGetSysTimerCount();
+      ready = com_poll(p_fds, TEST_SOCKETS_NB, TEST_POLL_TIMEOUT);
+      wait = rtosalGetSysTimerCount() - start;
+      wait_max = (wait > wait_max) ? wait : wait_max;
+      (*p_polls)++;
+      HOST_TEST_CHECK(ready > 0);
+      if (ready <= 0)
+      {
+        break;
+      }
+      for (i = 0U; i < TEST_SOCKETS_NB; i++)
+      {
+        if (p_fds[i].revents != 0)
+        {
+          /* only POLLIN requested: nothing else to report on an echo socket */
+          HOST_TEST_CHECK(p_fds[i].revents == COM_POLLIN);
+          ret = com_recv(p_fds[i].fd, (com_char_t *)&rx[i][received[i]],
+                         (int32_t)sizeof(rx[i]) - received[i], COM_MSG_DONTWAIT);
+          HOST_TEST_CHECK(ret > 0);
+          if (ret > 0)
+          {
+            received[i] += ret;
+            if (received[i] >= (int32_t)TEST_MSG_SIZE)
+            {
+              HOST_TEST_CHECK(received[i] == (int32_t)TEST_MSG_SIZE);
+              HOST_TEST_CHECK(memcmp(rx[i], tx[i], TEST_MSG_SIZE) == 0);
+              p_fds[i].events = 0;
+              done++;
+            }
+          }
+        }
+      }
+    }
+
+    /* all data read: nothing reported anymore */
+    for (i = 0U; i < TEST_SOCKETS_NB; i++)
+    {
+      p_fds[i].events = COM_POLLIN;
+    }
+    HOST_TEST_CHECK(com_poll(p_fds, TEST_SOCKETS_NB, 0) == 0);
+  }
+
+  return (wait_max);
+}
+
+/* Connection closed by the server: com_poll is woken and reports POLLHUP */
+static void test_hangup(void)
+{
+  com_pollfd_t fd;
+  pthread_t server;
+  uint16_t port;
+
+  port = test_server_start(&server);
+  fd.fd = test_open(port);
+  fd.events = COM_POLLIN;
+  HOST_TEST_CHECK(com_poll(&fd, 1U, TEST_POLL_TIMEOUT) == 1);
+  HOST_TEST_CHECK((fd.revents & COM_POLLHUP) == COM_POLLHUP);
+  HOST_TEST_CHECK((fd.revents & COM_POLLOUT) == 0);
+  HOST_TEST_CHECK(com_closesocket(fd.fd) == COM_SOCKETS_ERR_OK);
+  HOST_TEST_CHECK(pthread_join(server, NULL) == 0);
+  (void)close(test_server_fd);
+}
+
+/* Closed socket reported POLLNVAL, negative fd ignored, connected sockets in error while the network is down */
+static void test_invalid(com_pollfd_t *p_fds)
+{
+  int32_t fd;
+  uint32_t i;
+
+  fd = p_fds[0].fd;
+  HOST_TEST_CHECK(com_closesocket(fd) == COM_SOCKETS_ERR_OK);
+  HOST_TEST_CHECK(com_poll(p_fds, 1U, 0) == 1);
+  HOST_TEST_CHECK(p_fds[0].revents == COM_POLLNVAL);
+  p_fds[0].fd = -1;
+  HOST_TEST_CHECK(com_poll(p_fds, 1U, 0) == 0);
+  HOST_TEST_CHECK(p_fds[0].revents == 0);
+
+  test_network_set(DC_SERVICE_OFF);
+  HOST_TEST_CHECK(com_poll(p_fds, TEST_SOCKETS_NB, 0) == (int32_t)(TEST_SOCKETS_NB - 1U));
+  for (i = 1U; i < TEST_SOCKETS_NB; i++)
+  {
+    HOST_TEST_CHECK(p_fds[i].revents == COM_POLLERR);
+  }
+  test_network_set(DC_SERVICE_ON);
+  for (i = 1U; i < TEST_SOCKETS_NB; i++)
+  {
+    p_fds[i].events = COM_POLLOUT;
+  }
+  HOST_TEST_CHECK(com_poll(p_fds, TEST_SOCKETS_NB, 0) == (int32_t)(TEST_SOCKETS_NB - 1U));
+}
+
+int main(void)
+{
+  dc_cellular_params_t cellular_params;
+  com_pollfd_t fds[TEST_SOCKETS_NB];
+  uint32_t wait_max;
+  uint32_t polls;
+  uint32_t i;
+
+  (void)rtosalKernelInitialize();
+  (void)rtosalKernelStart();
+
+  cellular_init();
+  (void)dc_com_read(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_set_default_setup_config(&cellular_params);
+  (void)dc_com_write(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_start();
+
+  HOST_TEST_CHECK(test_wait_network() == true);
+  if (HOST_TEST_RESULT() == 0)
+  {
+    for (i = 0U; i < TEST_SOCKETS_NB; i++)
+    {
+      fds[i].fd = test_open(TEST_ECHO_PORT);
+    }
+    test_idle(fds);
+    wait_max = test_event_loop(fds, &polls);
+    test_hangup();
+    test_invalid(fds);
+    for (i = 1U; i < TEST_SOCKETS_NB; i++)
+    {
+      HOST_TEST_CHECK(com_closesocket(fds[i].fd) == COM_SOCKETS_ERR_OK);
+    }
+
+    (void)printf("1 thread, %lu sockets: %lu echoes served in %lu com_poll calls, longest wait %lu ms\n",
+                 (unsigned long)TEST_SOCKETS_NB, (unsigned long)(TEST_SOCKETS_NB * TEST_ROUNDS_NB),
+                 (unsigned long)polls, (unsigned long)wait_max);
+  }
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,189 @@
+/**
+  ******************************************************************************
+  * @file    test_com_read_ahead.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test of the TCP read-ahead of com_sockets_ip_modem.c with the
+  *          simulated Type1SC modem: echoed data read by small com_recv calls
+  *          (MQTT header and body, HTTP chunks, single bytes) and mixed with
+  *          reads larger than the read-ahead buffer come back in order, with
+  *          a few %SOCKETDATA="RECEIVE" transactions per KB instead of one per
+  *          com_recv.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+
+#include "rtosal.h"
+#include "dc_common.h"
+#include "cellular_datacache.h"
+#include "cellular_mngt.h"
+#include "com_sockets.h"
+#include "ipc_sim.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_ATTACH_TIMEOUT   (30000U) /* in ms */
+#define TEST_ECHO_PORT        (7U)     /* simulator echo */
+#define TEST_BLOCK_SIZE       (1024U)  /* echoed at once by the simulator */
+#define TEST_BLOCKS_NB        (16U)    /* per read pattern */
+#define TEST_SIZES_MAX        (4U)
+
+/* Private typedef -----------------------------------------------------------*/
+/* Sizes of the successive com_recv calls of an application */
+typedef struct
+{
+  const char *p_name;
+  uint32_t   sizes_nb;
+  uint32_t   sizes[TEST_SIZES_MAX];
+} test_pattern_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const test_pattern_t test_patterns[] =
+{
+  { "mqtt 2+126", 2U, { 2U, 126U } },
+  { "http 100",   1U, { 100U } },
+  { "1 byte",     1U, { 1U } },
+  { "mixed 600",  4U, { 5U, 600U, 33U, 1000U } }, /* reads larger than the read-ahead buffer */
+};
+
+static uint8_t test_tx[TEST_BLOCK_SIZE];
+static uint8_t test_rx[TEST_BLOCK_SIZE];
+
+/* Private functions ---------------------------------------------------------*/
+static bool test_wait_network(void)
+{
+  dc_nifman_info_t nifman_info;
+  uint32_t waited = 0U;
+  bool up = false;
+
+  while ((up == false) && (waited < TEST_ATTACH_TIMEOUT))
+  {
+    (void)dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+    if (nifman_info.rt_state == DC_SERVICE_ON)
+    {
+      up = true;
+    }
+    else
+    {
+      (void)rtosalDelay(10U);
+      waited += 10U;
+    }
+  }
+
+  return (up);
+}
+
+static int32_t test_open(void)
+{
+  com_sockaddr_in_t address;
+  com_ip_addr_t remote_ip;
+  uint32_t timeout = 5000U;
+  int32_t sock;
+
+  sock = com_socket(COM_AF_INET, COM_SOCK_STREAM, COM_IPPROTO_TCP);
+  HOST_TEST_CHECK(sock >= 0);
+  HOST_TEST_CHECK(com_setsockopt(sock, COM_SOL_SOCKET, COM_SO_RCVTIMEO, &timeout, (int32_t)sizeof(timeout))
+                  == COM_SOCKETS_ERR_OK);
+  (void)memset(&address, 0, sizeof(address));
+  address.sin_family = (uint8_t)COM_AF_INET;
+  address.sin_port   = COM_HTONS(TEST_ECHO_PORT);
+  COM_IP4_ADDR(&remote_ip, 10U, 0U, 0U, 1U); /* IPC_SIM_REMOTE_IP_ADDR */
+  address.sin_addr.s_addr = remote_ip.addr;
+  HOST_TEST_CHECK(com_connect(sock, (com_sockaddr_t const *)&address, (int32_t)sizeof(com_sockaddr_in_t))
+                  == COM_SOCKETS_ERR_OK);
+
+  return (sock);
+}
+
+/* Echo TEST_BLOCKS_NB blocks read with the sizes of p_pattern: returns the number of com_recv calls */
+static uint32_t test_read_pattern(int32_t sock, const test_pattern_t *p_pattern, uint32_t *p_offset)
+{
+  uint32_t calls = 0U;
+  uint32_t received;
+  uint32_t size;
+  uint32_t block;
+  uint32_t i;
+  int32_t ret;
+
+  for (block = 0U; block < TEST_BLOCKS_NB; block++)
+  {
+    /* bytes numbered across the whole stream: a byte lost, duplicated or swapped is detected */
+    for (i = 0U; i < TEST_BLOCK_SIZE; i++)
+    {
+      test_tx[i] = (uint8_t)((*p_offset + i) % 251U);
+    }
+    HOST_TEST_CHECK(com_send(sock, (const com_char_t *)test_tx, (int32_t)TEST_BLOCK_SIZE, COM_MSG_WAIT)
+                    == (int32_t)TEST_BLOCK_SIZE);
+
+    received = 0U;
+    while (received < TEST_BLOCK_SIZE)
+    {
+      size = p_pattern->sizes[calls % p_pattern->sizes_nb];
+      size = (size < (TEST_BLOCK_SIZE - received)) ? size : (TEST_BLOCK_SIZE - received);
+      ret = com_recv(sock, (com_char_t *)&test_rx[received], (int32_t)size, COM_MSG_WAIT);
+      calls++;
+      HOST_TEST_CHECK((ret > 0) && (ret <= (int32_t)size));
+      if (ret <= 0)
+      {
+        break;
+      }
+      received += (uint32_t)ret;
+    }
+    HOST_TEST_CHECK(memcmp(test_rx, test_tx, TEST_BLOCK_SIZE) == 0);
+    *p_offset += TEST_BLOCK_SIZE;
+  }
+
+  return (calls);
+}
+
+int main(void)
+{
+  dc_cellular_params_t cellular_params;
+  IPC_SIM_Statistics_t before;
+  IPC_SIM_Statistics_t after;
+  uint32_t offset = 0U;
+  uint32_t calls;
+  uint32_t reads;
+  uint32_t kbytes;
+  int32_t sock;
+  uint32_t i;
+
+  (void)rtosalKernelInitialize();
+  (void)rtosalKernelStart();
+
+  cellular_init();
+  (void)dc_com_read(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_set_default_setup_config(&cellular_params);
+  (void)dc_com_write(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_start();
+
+  HOST_TEST_CHECK(test_wait_network() == true);
+  if (HOST_TEST_RESULT() == 0)
+  {
+    sock = test_open();
+    kbytes = (TEST_BLOCKS_NB * TEST_BLOCK_SIZE) / 1024U;
+    for (i = 0U; i < (sizeof(test_patterns) / sizeof(test_patterns[0])); i++)
+    {
+      IPC_SIM_getStatistics(&before);
+      calls = test_read_pattern(sock, &test_patterns[i], &offset);
+      IPC_SIM_getStatistics(&after);
+      reads = after.rx_count - before.rx_count;
+      HOST_TEST_CHECK((after.rx_bytes - before.rx_bytes) == (TEST_BLOCKS_NB * TEST_BLOCK_SIZE));
+
+      /* without read-ahead each com_recv is a modem read */
+      (void)printf("%-10s: %5lu com_recv, %4lu modem reads: %7.2f -> %5.2f modem reads per KB\n",
+                   test_patterns[i].p_name, (unsigned long)calls, (unsigned long)reads,
+                   (double)calls / (double)kbytes, (double)reads / (double)kbytes);
+      /* a 1 KB block: two full reads of the 512 bytes buffer, then an empty one - a full read does not
+         tell whether more data wait in the modem and no new data ready notification comes for them */
+      HOST_TEST_CHECK(reads <= (3U * TEST_BLOCKS_NB));
+    }
+    HOST_TEST_CHECK(com_closesocket(sock) == COM_SOCKETS_ERR_OK);
+  }
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
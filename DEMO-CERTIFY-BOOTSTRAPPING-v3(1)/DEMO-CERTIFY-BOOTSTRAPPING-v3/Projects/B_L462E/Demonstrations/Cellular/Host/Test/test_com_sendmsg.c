@@ -0,0 +1,248 @@
+/**
+  ******************************************************************************
+  * @file    test_com_sendmsg.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test of com_sendmsg with the simulated Type1SC modem: a
+  *          message gathered from several buffers is echoed entire, messages
+  *          with a negative or overflowing length are rejected, each send,
+  *          sendto and sendmsg call is counted and timed once.
+  * @note    Built with COM_SOCKETS_STATISTIC set to 1.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+
+#include "rtosal.h"
+#include "dc_common.h"
+#include "cellular_datacache.h"
+#include "cellular_mngt.h"
+#include "com_sockets.h"
+#include "com_sockets_statistic.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_ATTACH_TIMEOUT   (30000U) /* in ms */
+#define TEST_ECHO_PORT        (7U)     /* simulator echo */
+#define TEST_HEADER_SIZE      (5U)
+#define TEST_PAYLOAD_SIZE     (1800U)  /* more than one modem send */
+#define TEST_TRAILER_SIZE     (2U)
+#define TEST_MSG_SIZE         (TEST_HEADER_SIZE + TEST_PAYLOAD_SIZE + TEST_TRAILER_SIZE)
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t test_header[TEST_HEADER_SIZE];
+static uint8_t test_payload[TEST_PAYLOAD_SIZE];
+static uint8_t test_trailer[TEST_TRAILER_SIZE];
+static uint8_t test_rx[TEST_MSG_SIZE];
+
+/* Private functions ---------------------------------------------------------*/
+static bool test_wait_network(void)
+{
+  dc_nifman_info_t nifman_info;
+  uint32_t waited = 0U;
+  bool up = false;
+
+  while ((up == false) && (waited < TEST_ATTACH_TIMEOUT))
+  {
+    (void)dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+    if (nifman_info.rt_state == DC_SERVICE_ON)
+    {
+      up = true;
+    }
+    else
+    {
+      (void)rtosalDelay(10U);
+      waited += 10U;
+    }
+  }
+
+  return (up);
+}
+
+static void test_echo_address(com_sockaddr_in_t *p_address)
+{
+  com_ip_addr_t remote_ip;
+
+  (void)memset(p_address, 0, sizeof(com_sockaddr_in_t));
+  p_address->sin_family = (uint8_t)COM_AF_INET;
+  p_address->sin_port   = COM_HTONS(TEST_ECHO_PORT);
+  COM_IP4_ADDR(&remote_ip, 10U, 0U, 0U, 1U); /* IPC_SIM_REMOTE_IP_ADDR */
+  p_address->sin_addr.s_addr = remote_ip.addr;
+}
+
+/* Number of send calls counted and timed since p_before */
+static void test_snd_calls(const com_sockets_stat_snapshot_t *p_before, uint32_t *p_counted, uint32_t *p_timed)
+{
+  com_sockets_stat_snapshot_t after;
+
+  com_sockets_statistic_snapshot(&after);
+  *p_counted = ((uint32_t)after.counter.sock_snd_ok + after.counter.sock_snd_nok)
+               - ((uint32_t)p_before->counter.sock_snd_ok + p_before->counter.sock_snd_nok);
+  *p_timed = after.latency[COM_SOCKET_STAT_OP_SND].calls - p_before->latency[COM_SOCKET_STAT_OP_SND].calls;
+}
+
+/* Header, payload and trailer gathered in one message are echoed as one block */
+static void test_gather(int32_t sock)
+{
+  com_iovec_t iov[3];
+  com_msghdr_t msg;
+  int32_t received = 0;
+  int32_t ret;
+
+  iov[0].iov_base = test_header;
+  iov[0].iov_len  = (int32_t)sizeof(test_header);
+  iov[1].iov_base = test_payload;
+  iov[1].iov_len  = (int32_t)sizeof(test_payload);
+  iov[2].iov_base = test_trailer;
+  iov[2].iov_len  = (int32_t)sizeof(test_trailer);
+  (void)memset(&msg, 0, sizeof(msg));
+  msg.msg_iov    = iov;
+  msg.msg_iovlen = 3;
+  HOST_TEST_CHECK(com_sendmsg(sock, &msg, COM_MSG_WAIT) == (int32_t)TEST_MSG_SIZE);
+
+  while (received < (int32_t)TEST_MSG_SIZE)
+  {
+    ret = com_recv(sock, &test_rx[received], (int32_t)TEST_MSG_SIZE - received, COM_MSG_WAIT);
+    HOST_TEST_CHECK(ret > 0);
+    if (ret <= 0)
+    {
+      break;
+    }
+    received += ret;
+  }
+  HOST_TEST_CHECK(memcmp(&test_rx[0], test_header, TEST_HEADER_SIZE) == 0);
+  HOST_TEST_CHECK(memcmp(&test_rx[TEST_HEADER_SIZE], test_payload, TEST_PAYLOAD_SIZE) == 0);
+  HOST_TEST_CHECK(memcmp(&test_rx[TEST_HEADER_SIZE + TEST_PAYLOAD_SIZE], test_trailer, TEST_TRAILER_SIZE) == 0);
+}
+
+/* Messages not sendable: nothing is sent, the socket is still usable */
+static void test_invalid(int32_t sock)
+{
+  com_iovec_t iov[COM_IOV_MAX + 1];
+  com_msghdr_t msg;
+  int32_t i;
+
+  for (i = 0; i < (COM_IOV_MAX + 1); i++)
+  {
+    iov[i].iov_base = test_payload;
+    iov[i].iov_len  = 1;
+  }
+  (void)memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+
+  /* no buffer, too many buffers */
+  msg.msg_iovlen = 0;
+  HOST_TEST_CHECK(com_sendmsg(sock, &msg, COM_MSG_WAIT) == COM_SOCKETS_ERR_PARAMETER);
+  msg.msg_iovlen = COM_IOV_MAX + 1;
+  HOST_TEST_CHECK(com_sendmsg(sock, &msg, COM_MSG_WAIT) == COM_SOCKETS_ERR_PARAMETER);
+
+  /* negative length */
+  msg.msg_iovlen = 2;
+  iov[1].iov_len = -1;
+  HOST_TEST_CHECK(com_sendmsg(sock, &msg, COM_MSG_WAIT) == COM_SOCKETS_ERR_PARAMETER);
+
+  /* total length not representable in the result */
+  iov[0].iov_len = INT32_MAX;
+  iov[1].iov_len = 1;
+  HOST_TEST_CHECK(com_sendmsg(sock, &msg, COM_MSG_WAIT) == COM_SOCKETS_ERR_PARAMETER);
+  iov[0].iov_len = INT32_MAX / 2;
+  iov[1].iov_len = (INT32_MAX / 2) + 2;
+  HOST_TEST_CHECK(com_sendmsg(sock, &msg, COM_MSG_WAIT) == COM_SOCKETS_ERR_PARAMETER);
+
+  /* no data */
+  iov[0].iov_len = 1;
+  iov[1].iov_base = NULL;
+  HOST_TEST_CHECK(com_sendmsg(sock, &msg, COM_MSG_WAIT) == COM_SOCKETS_ERR_PARAMETER);
+}
+
+/* Each send on a datagram socket is counted and timed once */
+static void test_datagram_statistic(void)
+{
+  com_sockets_stat_snapshot_t before;
+  com_sockaddr_in_t address;
+  com_iovec_t iov;
+  com_msghdr_t msg;
+  uint32_t counted;
+  uint32_t timed;
+  int32_t sock;
+
+  test_echo_address(&address);
+  sock = com_socket(COM_AF_INET, COM_SOCK_DGRAM, COM_IPPROTO_UDP);
+  HOST_TEST_CHECK(sock >= 0);
+
+  com_sockets_statistic_snapshot(&before);
+  HOST_TEST_CHECK(com_sendto(sock, test_header, (int32_t)sizeof(test_header), COM_MSG_WAIT,
+                             (const com_sockaddr_t *)&address, (int32_t)sizeof(address))
+                  == (int32_t)sizeof(test_header));
+  test_snd_calls(&before, &counted, &timed);
+  HOST_TEST_CHECK((counted == 1U) && (timed == 1U));
+
+  com_sockets_statistic_snapshot(&before);
+  iov.iov_base = test_header;
+  iov.iov_len  = (int32_t)sizeof(test_header);
+  msg.msg_name    = (const com_sockaddr_t *)&address;
+  msg.msg_namelen = (int32_t)sizeof(address);
+  msg.msg_iov     = &iov;
+  msg.msg_iovlen  = 1;
+  HOST_TEST_CHECK(com_sendmsg(sock, &msg, COM_MSG_WAIT) == (int32_t)sizeof(test_header));
+  test_snd_calls(&before, &counted, &timed);
+  HOST_TEST_CHECK((counted == 1U) && (timed == 1U));
+
+  HOST_TEST_CHECK(com_closesocket(sock) == COM_SOCKETS_ERR_OK);
+}
+
+int main(void)
+{
+  dc_cellular_params_t cellular_params;
+  com_sockets_stat_snapshot_t before;
+  com_sockaddr_in_t address;
+  uint32_t timeout = 5000U;
+  uint32_t counted;
+  uint32_t timed;
+  int32_t sock;
+  uint32_t i;
+
+  for (i = 0U; i < TEST_PAYLOAD_SIZE; i++)
+  {
+    test_payload[i] = (uint8_t)(i * 7U);
+  }
+  (void)memcpy(test_header, "HEAD:", TEST_HEADER_SIZE);
+  (void)memcpy(test_trailer, "\r\n", TEST_TRAILER_SIZE);
+
+  (void)rtosalKernelInitialize();
+  (void)rtosalKernelStart();
+
+  cellular_init();
+  (void)dc_com_read(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_set_default_setup_config(&cellular_params);
+  (void)dc_com_write(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_start();
+
+  HOST_TEST_CHECK(test_wait_network() == true);
+  if (HOST_TEST_RESULT() == 0)
+  {
+    test_echo_address(&address);
+    sock = com_socket(COM_AF_INET, COM_SOCK_STREAM, COM_IPPROTO_TCP);
+    HOST_TEST_CHECK(sock >= 0);
+    HOST_TEST_CHECK(com_setsockopt(sock, COM_SOL_SOCKET, COM_SO_RCVTIMEO, &timeout, (int32_t)sizeof(timeout))
+                    == COM_SOCKETS_ERR_OK);
+    HOST_TEST_CHECK(com_connect(sock, (com_sockaddr_t const *)&address, (int32_t)sizeof(com_sockaddr_in_t))
+                    == COM_SOCKETS_ERR_OK);
+
+    test_invalid(sock);
+    com_sockets_statistic_snapshot(&before);
+    test_gather(sock);
+    test_snd_calls(&before, &counted, &timed);
+    HOST_TEST_CHECK((counted == 1U) && (timed == 1U));
+    HOST_TEST_CHECK(com_closesocket(sock) == COM_SOCKETS_ERR_OK);
+
+    test_datagram_statistic();
+    (void)printf("%u bytes gathered from 3 buffers echoed, invalid messages rejected, sends timed once\n",
+                 (unsigned int)TEST_MSG_SIZE);
+  }
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,221 @@
+/**
+  ******************************************************************************
+  * @file    test_com_socket_pool.c
+  * @author  artworkTrackingMAP
+  * @brief   Stress test of the socket descriptor pool of com_sockets_ip_modem.c
+  *          with the simulated Type1SC modem: several threads open, use and
+  *          close sockets concurrently. The ids of the live sockets are
+  *          distinct, an id is never given twice, the id of a closed socket
+  *          is rejected, the pool gives CELLULAR_MAX_SOCKETS sockets.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+
+#include "rtosal.h"
+#include "dc_common.h"
+#include "cellular_datacache.h"
+#include "cellular_mngt.h"
+#include "com_sockets.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_ATTACH_TIMEOUT   (30000U) /* in ms */
+#define TEST_THREADS_NB       (4U)     /* channels of the network library driver */
+#define TEST_CYCLES_NB        (100U)   /* per thread */
+#define TEST_ECHO_EVERY       (10U)    /* one cycle out of 10 connects and echoes */
+#define TEST_ECHO_PORT        (7U)     /* simulator echo */
+#define TEST_ECHO_SIZE        (64U)
+
+/* Private variables ---------------------------------------------------------*/
+static osMutexId test_mutex;
+static osSemaphoreId test_done;
+static int32_t test_live[TEST_THREADS_NB];
+static int32_t test_ids[TEST_THREADS_NB * TEST_CYCLES_NB];
+static uint32_t test_ids_nb;
+
+/* Private functions ---------------------------------------------------------*/
+static bool test_wait_network(void)
+{
+  dc_nifman_info_t nifman_info;
+  uint32_t waited = 0U;
+  bool up = false;
+
+  while ((up == false) && (waited < TEST_ATTACH_TIMEOUT))
+  {
+    (void)dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+    if (nifman_info.rt_state == DC_SERVICE_ON)
+    {
+      up = true;
+    }
+    else
+    {
+      (void)rtosalDelay(10U);
+      waited += 10U;
+    }
+  }
+
+  return (up);
+}
+
+/* Record the id of a new socket: not used by another live socket, never given before */
+static void test_record(uint32_t thread, int32_t sock)
+{
+  uint32_t i;
+
+  (void)rtosalMutexAcquire(test_mutex, RTOSAL_WAIT_FOREVER);
+  for (i = 0U; i < TEST_THREADS_NB; i++)
+  {
+    HOST_TEST_CHECK(test_live[i] != sock);
+  }
+  for (i = 0U; i < test_ids_nb; i++)
+  {
+    HOST_TEST_CHECK(test_ids[i] != sock);
+  }
+  test_live[thread] = sock;
+  test_ids[test_ids_nb] = sock;
+  test_ids_nb++;
+  (void)rtosalMutexRelease(test_mutex);
+}
+
+static void test_echo(int32_t sock)
+{
+  uint8_t tx[TEST_ECHO_SIZE];
+  uint8_t rx[TEST_ECHO_SIZE];
+  com_sockaddr_in_t address;
+  com_ip_addr_t remote_ip;
+  uint32_t timeout = 5000U;
+  int32_t received = 0;
+  int32_t ret;
+
+  (void)memset(tx, (int32_t)sock, sizeof(tx));
+  (void)memset(&address, 0, sizeof(address));
+  address.sin_family = (uint8_t)COM_AF_INET;
+  address.sin_port   = COM_HTONS(TEST_ECHO_PORT);
+  COM_IP4_ADDR(&remote_ip, 10U, 0U, 0U, 1U); /* IPC_SIM_REMOTE_IP_ADDR */
+  address.sin_addr.s_addr = remote_ip.addr;
+  HOST_TEST_CHECK(com_setsockopt(sock, COM_SOL_SOCKET, COM_SO_RCVTIMEO, &timeout, (int32_t)sizeof(timeout))
+                  == COM_SOCKETS_ERR_OK);
+  HOST_TEST_CHECK(com_connect(sock, (com_sockaddr_t const *)&address, (int32_t)sizeof(com_sockaddr_in_t))
+                  == COM_SOCKETS_ERR_OK);
+  HOST_TEST_CHECK(com_send(sock, (const com_char_t *)tx, (int32_t)sizeof(tx), COM_MSG_WAIT) == (int32_t)sizeof(tx));
+  while (received < (int32_t)sizeof(rx))
+  {
+    ret = com_recv(sock, (com_char_t *)&rx[received], (int32_t)sizeof(rx) - received, COM_MSG_WAIT);
+    HOST_TEST_CHECK(ret > 0);
+    if (ret <= 0)
+    {
+      break;
+    }
+    received += ret;
+  }
+  HOST_TEST_CHECK(memcmp(rx, tx, sizeof(tx)) == 0);
+}
+
+static void test_thread(void const *p_arg)
+{
+  uint32_t thread = (uint32_t)(uintptr_t)p_arg;
+  uint8_t data = 0U;
+  int32_t sock;
+  uint32_t cycle;
+
+  for (cycle = 0U; cycle < TEST_CYCLES_NB; cycle++)
+  {
+    sock = com_socket(COM_AF_INET, COM_SOCK_STREAM, COM_IPPROTO_TCP);
+    HOST_TEST_CHECK(sock >= 0);
+    if (sock < 0)
+    {
+      break;
+    }
+    test_record(thread, sock);
+    if ((cycle % TEST_ECHO_EVERY) == thread)
+    {
+      test_echo(sock);
+    }
+    (void)rtosalMutexAcquire(test_mutex, RTOSAL_WAIT_FOREVER);
+    test_live[thread] = COM_SOCKET_INVALID_ID;
+    (void)rtosalMutexRelease(test_mutex);
+    HOST_TEST_CHECK(com_closesocket(sock) == COM_SOCKETS_ERR_OK);
+
+    /* closed: the id is rejected, even once its slot is used by another thread */
+    HOST_TEST_CHECK(com_closesocket(sock) != COM_SOCKETS_ERR_OK);
+    HOST_TEST_CHECK(com_send(sock, (const com_char_t *)&data, 1, COM_MSG_DONTWAIT) < 0);
+  }
+  (void)rtosalSemaphoreRelease(test_done);
+}
+
+/* The pool gives one socket per modem socket, then again once they are closed */
+static void test_pool_full(void)
+{
+  int32_t sock[CELLULAR_MAX_SOCKETS + 1U];
+  uint32_t i;
+
+  for (i = 0U; i < CELLULAR_MAX_SOCKETS; i++)
+  {
+    sock[i] = com_socket(COM_AF_INET, COM_SOCK_DGRAM, COM_IPPROTO_UDP);
+    HOST_TEST_CHECK(sock[i] >= 0);
+  }
+  sock[i] = com_socket(COM_AF_INET, COM_SOCK_DGRAM, COM_IPPROTO_UDP);
+  HOST_TEST_CHECK(sock[i] < 0);
+  for (i = 0U; i < CELLULAR_MAX_SOCKETS; i++)
+  {
+    HOST_TEST_CHECK(com_closesocket(sock[i]) == COM_SOCKETS_ERR_OK);
+  }
+  sock[0] = com_socket(COM_AF_INET, COM_SOCK_DGRAM, COM_IPPROTO_UDP);
+  HOST_TEST_CHECK(sock[0] >= 0);
+  HOST_TEST_CHECK(com_closesocket(sock[0]) == COM_SOCKETS_ERR_OK);
+}
+
+int main(void)
+{
+  dc_cellular_params_t cellular_params;
+  int32_t id_max = 0;
+  uint32_t i;
+
+  (void)rtosalKernelInitialize();
+  (void)rtosalKernelStart();
+
+  cellular_init();
+  (void)dc_com_read(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_set_default_setup_config(&cellular_params);
+  (void)dc_com_write(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_start();
+
+  HOST_TEST_CHECK(test_wait_network() == true);
+  if (HOST_TEST_RESULT() == 0)
+  {
+    test_pool_full();
+
+    test_mutex = rtosalMutexNew(NULL);
+    test_done = rtosalSemaphoreNew(NULL, TEST_THREADS_NB);
+    for (i = 0U; i < TEST_THREADS_NB; i++)
+    {
+      test_live[i] = COM_SOCKET_INVALID_ID;
+      (void)rtosalSemaphoreAcquire(test_done, 0U);
+    }
+    for (i = 0U; i < TEST_THREADS_NB; i++)
+    {
+      HOST_TEST_CHECK(rtosalThreadNew((const rtosal_char_t *)"TestSocket", test_thread, osPriorityNormal, 1024U,
+                                      (void *)(uintptr_t)i) != NULL);
+    }
+    for (i = 0U; i < TEST_THREADS_NB; i++)
+    {
+      (void)rtosalSemaphoreAcquire(test_done, RTOSAL_WAIT_FOREVER);
+    }
+
+    for (i = 0U; i < test_ids_nb; i++)
+    {
+      id_max = (test_ids[i] > id_max) ? test_ids[i] : id_max;
+    }
+    (void)printf("%lu threads: %lu sockets opened and closed, all ids distinct, max id %ld\n",
+                 (unsigned long)TEST_THREADS_NB, (unsigned long)test_ids_nb, (long)id_max);
+    HOST_TEST_CHECK(test_ids_nb == (TEST_THREADS_NB * TEST_CYCLES_NB));
+    test_pool_full();
+  }
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,161 @@
+/**
+  ******************************************************************************
+  * @file    test_csos_priority.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test of the AT transaction scheduler of cellular_service_os.c
+  *          with the simulated modem: a low priority thread owning the AT
+  *          channel runs at the priority of a higher priority thread waiting
+  *          for it, and gets back its own priority at the end of the
+  *          transaction.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+
+#include "rtosal.h"
+#include "dc_common.h"
+#include "cellular_datacache.h"
+#include "cellular_mngt.h"
+#include "cellular_service_os.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_ATTACH_TIMEOUT   (30000U) /* in ms */
+#define TEST_TRANSACTIONS_NB  (40U)
+
+/* Private variables ---------------------------------------------------------*/
+static osSemaphoreId test_done;
+static osSemaphoreId test_low_exit; /* test_low_id stays valid until the low priority thread ends */
+static osThreadId test_low_id;
+static volatile bool test_low_started;
+
+/* Private functions ---------------------------------------------------------*/
+static bool test_wait_network(void)
+{
+  dc_nifman_info_t nifman_info;
+  uint32_t waited = 0U;
+  bool up = false;
+
+  while ((up == false) && (waited < TEST_ATTACH_TIMEOUT))
+  {
+    (void)dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+    if (nifman_info.rt_state == DC_SERVICE_ON)
+    {
+      up = true;
+    }
+    else
+    {
+      (void)rtosalDelay(10U);
+      waited += 10U;
+    }
+  }
+
+  return (up);
+}
+
+/* Polling transactions in a loop: the thread priority is unchanged after each of them */
+static void test_transactions(osPriority priority)
+{
+  CS_SignalQuality_t sig_qual;
+  uint32_t i;
+
+  for (i = 0U; i < TEST_TRANSACTIONS_NB; i++)
+  {
+    HOST_TEST_CHECK(osCS_get_signal_quality(&sig_qual) == CELLULAR_OK);
+    HOST_TEST_CHECK(rtosalThreadGetPriority(rtosalThreadGetId()) == priority);
+  }
+  (void)rtosalSemaphoreRelease(test_done);
+}
+
+static void test_low(void const *p_arg)
+{
+  (void)p_arg;
+  test_low_id = rtosalThreadGetId();
+  test_low_started = true;
+  test_transactions(osPriorityLow);
+  (void)rtosalSemaphoreAcquire(test_low_exit, RTOSAL_WAIT_FOREVER);
+}
+
+static void test_high(void const *p_arg)
+{
+  (void)p_arg;
+  test_transactions(osPriorityHigh);
+}
+
+static void test_rtosal_priority(void)
+{
+  osThreadId thread_id = rtosalThreadGetId();
+
+  /* main() is not created by rtosal */
+  HOST_TEST_CHECK(thread_id != NULL);
+  HOST_TEST_CHECK(rtosalThreadGetPriority(thread_id) == osPriorityNormal);
+  HOST_TEST_CHECK(rtosalThreadSetPriority(thread_id, osPriorityAboveNormal) == osOK);
+  HOST_TEST_CHECK(rtosalThreadGetPriority(rtosalThreadGetId()) == osPriorityAboveNormal);
+  HOST_TEST_CHECK(rtosalThreadSetPriority(thread_id, osPriorityNormal) == osOK);
+  HOST_TEST_CHECK(rtosalThreadSetPriority(NULL, osPriorityNormal) != osOK);
+}
+
+int main(void)
+{
+  dc_cellular_params_t cellular_params;
+  csos_sched_stat_t stat;
+  osPriority low_max = osPriorityIdle;
+  osPriority priority;
+  uint32_t done = 0U;
+
+  (void)rtosalKernelInitialize();
+  (void)rtosalKernelStart();
+  test_rtosal_priority();
+
+  cellular_init();
+  (void)dc_com_read(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_set_default_setup_config(&cellular_params);
+  (void)dc_com_write(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_start();
+
+  HOST_TEST_CHECK(test_wait_network() == true);
+  if (HOST_TEST_RESULT() == 0)
+  {
+    test_done = rtosalSemaphoreNew(NULL, 2U);
+    HOST_TEST_CHECK(rtosalSemaphoreAcquire(test_done, 0U) == osOK);
+    test_low_exit = rtosalSemaphoreNew(NULL, 1U);
+    HOST_TEST_CHECK(rtosalSemaphoreAcquire(test_low_exit, 0U) == osOK);
+    HOST_TEST_CHECK(rtosalThreadNew((const rtosal_char_t *)"TestLow", test_low, osPriorityLow, 1024U, NULL) != NULL);
+    while (test_low_started == false)
+    {
+      (void)rtosalDelay(1U);
+    }
+    HOST_TEST_CHECK(rtosalThreadNew((const rtosal_char_t *)"TestHigh", test_high, osPriorityHigh, 1024U, NULL)
+                    != NULL);
+
+    /* low priority thread is raised while the high priority one waits for the channel */
+    while (done < 2U)
+    {
+      priority = rtosalThreadGetPriority(test_low_id);
+      low_max = ((int32_t)priority > (int32_t)low_max) ? priority : low_max;
+      if (rtosalSemaphoreAcquire(test_done, 0U) == osOK)
+      {
+        done++;
+      }
+      else
+      {
+        (void)rtosalDelay(1U);
+      }
+    }
+    HOST_TEST_CHECK(rtosalThreadGetPriority(test_low_id) == osPriorityLow);
+    (void)rtosalSemaphoreRelease(test_low_exit);
+    osCDS_get_sched_stat(CSOS_CLASS_POLLING, &stat);
+    (void)printf("polling: %lu transactions, %lu waited, %lu boosts, low thread priority max %d\n",
+                 (unsigned long)stat.transactions, (unsigned long)stat.waited, (unsigned long)stat.boosts,
+                 (int)low_max);
+    HOST_TEST_CHECK(stat.boosts > 0U);
+    HOST_TEST_CHECK(low_max == osPriorityHigh);
+    HOST_TEST_CHECK(stat.depth == 0U);
+  }
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,136 @@
+/**
+  ******************************************************************************
+  * @file    test_cst_polling.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test of the adaptive modem polling of cellular_service_task.c
+  *          with the simulated Type1SC modem: the signal quality URC is not
+  *          supported so the subscription fails and the signal is polled,
+  *          the period backs off while the level is stable and goes back to
+  *          the configured period when the level moves.
+  * @note    Built with CST_MODEM_POLLING_PERIOD_MAX reduced to 4 s.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+
+#include "rtosal.h"
+#include "dc_common.h"
+#include "cellular_datacache.h"
+#include "cellular_mngt.h"
+#include "cellular_service_os.h"
+#include "cellular_service_task.h"
+#include "ipc_sim.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_ATTACH_TIMEOUT   (30000U) /* in ms */
+#define TEST_BACKOFF_TIME     (8000U)  /* in ms: 1 s + 2 s + 4 s polling periods, then 4 s max */
+#define TEST_STABLE_TIME      (12000U) /* in ms */
+#define TEST_MOVED_TIME       (4000U)  /* in ms */
+#define TEST_RSSI_MOVED       (28U)    /* simulator default is 20: 16 dB more */
+
+/* Private functions ---------------------------------------------------------*/
+static bool test_wait_network(void)
+{
+  dc_nifman_info_t nifman_info;
+  uint32_t waited = 0U;
+  bool up = false;
+
+  while ((up == false) && (waited < TEST_ATTACH_TIMEOUT))
+  {
+    (void)dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+    if (nifman_info.rt_state == DC_SERVICE_ON)
+    {
+      up = true;
+    }
+    else
+    {
+      (void)rtosalDelay(10U);
+      waited += 10U;
+    }
+  }
+
+  return (up);
+}
+
+static void test_urc_callback(void)
+{
+  HOST_TEST_CHECK(false);
+}
+
+/* Number of AT+CSQ received by the simulator during time ms */
+static uint32_t test_csq_count(uint32_t time)
+{
+  IPC_SIM_Statistics_t stats;
+  uint32_t start;
+
+  IPC_SIM_getStatistics(&stats);
+  start = stats.csq_count;
+  (void)rtosalDelay(time);
+  IPC_SIM_getStatistics(&stats);
+
+  return (stats.csq_count - start);
+}
+
+/* Wait for the signal level read by the polling: returns the time waited in ms */
+static uint32_t test_wait_level(dc_cs_signal_level_t level)
+{
+  dc_cellular_info_t cellular_info;
+  uint32_t waited = 0U;
+
+  do
+  {
+    (void)rtosalDelay(10U);
+    waited += 10U;
+    (void)dc_com_read(&dc_com_db, DC_CELLULAR_INFO, (void *)&cellular_info, sizeof(cellular_info));
+  } while ((cellular_info.cs_signal_level != level) && (waited < (2U * CST_MODEM_POLLING_PERIOD_MAX)));
+
+  return (waited);
+}
+
+int main(void)
+{
+  dc_cellular_params_t cellular_params;
+  uint32_t stable;
+  uint32_t moved;
+  uint32_t waited;
+
+  (void)rtosalKernelInitialize();
+  (void)rtosalKernelStart();
+
+  cellular_init();
+  (void)dc_com_read(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_set_default_setup_config(&cellular_params);
+  (void)dc_com_write(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_start();
+
+  HOST_TEST_CHECK(test_wait_network() == true);
+  if (HOST_TEST_RESULT() == 0)
+  {
+    /* Type1SC has no signal quality URC: the failure is reported, the service polls */
+    HOST_TEST_CHECK(CST_signal_quality_urc == false);
+    HOST_TEST_CHECK(osCDS_subscribe_net_event(CS_URCEVENT_SIGNAL_QUALITY, test_urc_callback) == CELLULAR_ERROR);
+
+    /* stable level: polled at the max period (one poll per second without back-off) */
+    (void)rtosalDelay(TEST_BACKOFF_TIME);
+    stable = test_csq_count(TEST_STABLE_TIME);
+    HOST_TEST_CHECK((stable >= 2U) && (stable <= ((TEST_STABLE_TIME / CST_MODEM_POLLING_PERIOD_MAX) + 1U)));
+
+    /* level moves: seen at the next poll, then polled again at the configured period */
+    IPC_SIM_setSignalQuality(TEST_RSSI_MOVED);
+    waited = test_wait_level(TEST_RSSI_MOVED);
+    HOST_TEST_CHECK(waited <= (CST_MODEM_POLLING_PERIOD_MAX + 500U));
+    moved = test_csq_count(TEST_MOVED_TIME);
+    HOST_TEST_CHECK(moved >= 2U);
+
+    (void)printf("AT+CSQ: %lu in %lu ms with a stable level, level move seen after %lu ms, then %lu in %lu ms\n",
+                 (unsigned long)stable, (unsigned long)TEST_STABLE_TIME, (unsigned long)waited,
+                 (unsigned long)moved, (unsigned long)TEST_MOVED_TIME);
+  }
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,162 @@
+/**
+  ******************************************************************************
+  * @file    test_custom_telemetry.c
+  * @author  artworkTrackingMAP
+  * @brief   Host round-trip test of the Custom Client telemetry frames of
+  *          custom_telemetry.c: frames are filled until full, decoded and
+  *          compared with the samples; corrupted frames must be rejected.
+  *          The frame size is compared with the previous JSON text samples.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "custom_telemetry.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_FRAMES_NB  (200U)
+#define TEST_MAX_SAMPLES (255U)
+
+/* Private variables ---------------------------------------------------------*/
+static custom_telemetry_frame_t test_frame;
+static custom_telemetry_sample_t test_in[TEST_MAX_SAMPLES];
+static custom_telemetry_sample_t test_out[TEST_MAX_SAMPLES];
+
+/* Private functions ---------------------------------------------------------*/
+static void test_random_sample(custom_telemetry_sample_t *p_sample, uint32_t *p_time)
+{
+  /* mostly the 1 s period of the client, sometimes long gaps (connection lost) */
+  switch (rand() % 8)
+  {
+    case 0:
+      *p_time += (uint32_t)rand();
+      break;
+    case 1:
+      *p_time += 0U;
+      break;
+    default:
+      *p_time += 1000U + ((uint32_t)rand() % 200U);
+      break;
+  }
+  p_sample->time_ms     = *p_time;
+  p_sample->temperature = (int16_t)((rand() % 65536) - 32768);
+  p_sample->humidity    = (int16_t)(rand() % 10001);
+  p_sample->signal_dbm  = (int8_t)((rand() % 256) - 128);
+}
+
+static bool test_same(const custom_telemetry_sample_t *p_a, const custom_telemetry_sample_t *p_b)
+{
+  return (p_a->time_ms == p_b->time_ms) && (p_a->temperature == p_b->temperature)
+         && (p_a->humidity == p_b->humidity) && (p_a->signal_dbm == p_b->signal_dbm);
+}
+
+/* Fill a frame until it is full, decode it: returns the number of samples */
+static uint8_t test_round_trip(uint32_t *p_time)
+{
+  uint8_t nb = 0U;
+  uint8_t decoded = 0U;
+  uint8_t i;
+
+  custom_telemetry_reset(&test_frame);
+  while (custom_telemetry_is_full(&test_frame) == false)
+  {
+    test_random_sample(&test_in[nb], p_time);
+    HOST_TEST_CHECK(custom_telemetry_add(&test_frame, &test_in[nb]) == true);
+    nb++;
+  }
+  /* full: the sample is not added and the frame is unchanged */
+  test_random_sample(&test_in[nb], p_time);
+  HOST_TEST_CHECK(custom_telemetry_add(&test_frame, &test_in[nb]) == false);
+  HOST_TEST_CHECK(test_frame.nb_samples == nb);
+  HOST_TEST_CHECK(test_frame.len <= CUSTOM_CLIENT_FRAME_MAX_SIZE);
+
+  HOST_TEST_CHECK(custom_telemetry_decode(test_frame.buffer, test_frame.len, test_out, TEST_MAX_SAMPLES, &decoded)
+                  == true);
+  HOST_TEST_CHECK(decoded == nb);
+  for (i = 0U; i < decoded; i++)
+  {
+    HOST_TEST_CHECK(test_same(&test_in[i], &test_out[i]) == true);
+  }
+
+  return (nb);
+}
+
+static void test_invalid_frames(void)
+{
+  custom_telemetry_sample_t sample = { 0xFFFFFFF0U, 2832, 4350, -79 };
+  uint8_t decoded = 0xFFU;
+  uint16_t len;
+
+  custom_telemetry_reset(&test_frame);
+  (void)custom_telemetry_add(&test_frame, &sample);
+  sample.time_ms += 0x20U; /* tick counter wrapped */
+  (void)custom_telemetry_add(&test_frame, &sample);
+  HOST_TEST_CHECK(custom_telemetry_decode(test_frame.buffer, test_frame.len, test_out, 2U, &decoded) == true);
+  HOST_TEST_CHECK((decoded == 2U) && (test_out[1].time_ms == 0x10U));
+
+  /* truncated anywhere */
+  for (len = 0U; len < test_frame.len; len++)
+  {
+    HOST_TEST_CHECK(custom_telemetry_decode(test_frame.buffer, len, test_out, 2U, &decoded) == false);
+    HOST_TEST_CHECK(decoded == 0U);
+  }
+  /* trailing byte */
+  test_frame.buffer[test_frame.len] = 0U;
+  HOST_TEST_CHECK(custom_telemetry_decode(test_frame.buffer, test_frame.len + 1U, test_out, 2U, &decoded) == false);
+  /* output too small */
+  HOST_TEST_CHECK(custom_telemetry_decode(test_frame.buffer, test_frame.len, test_out, 1U, &decoded) == false);
+  /* unknown version */
+  test_frame.buffer[0] = (uint8_t)(CUSTOM_TELEMETRY_VERSION + 1U);
+  HOST_TEST_CHECK(custom_telemetry_decode(test_frame.buffer, test_frame.len, test_out, 2U, &decoded) == false);
+  /* varint longer than 5 bytes */
+  custom_telemetry_reset(&test_frame);
+  test_frame.buffer[1] = 1U;
+  (void)memset(&test_frame.buffer[CUSTOM_TELEMETRY_HEADER_SIZE], 0x80, 6U);
+  test_frame.buffer[CUSTOM_TELEMETRY_HEADER_SIZE + 6U] = 0U;
+  HOST_TEST_CHECK(custom_telemetry_decode(test_frame.buffer, CUSTOM_TELEMETRY_HEADER_SIZE + 12U, test_out, 2U,
+                                          &decoded) == false);
+}
+
+static void test_to_centi(void)
+{
+  HOST_TEST_CHECK(custom_telemetry_to_centi(28.322449f) == 2832);
+  HOST_TEST_CHECK(custom_telemetry_to_centi(-0.005f) == -1);
+  HOST_TEST_CHECK(custom_telemetry_to_centi(-12.344f) == -1234);
+  HOST_TEST_CHECK(custom_telemetry_to_centi(400.0f) == INT16_MAX);
+  HOST_TEST_CHECK(custom_telemetry_to_centi(-400.0f) == INT16_MIN);
+  HOST_TEST_CHECK(custom_telemetry_to_centi(NAN) == 0);
+}
+
+int main(void)
+{
+  uint32_t time_ms = 11750U;
+  uint32_t samples = 0U;
+  uint32_t bytes = 0U;
+  uint32_t i;
+  int json_len;
+  char json[128];
+
+  srand(1U);
+  for (i = 0U; i < TEST_FRAMES_NB; i++)
+  {
+    samples += test_round_trip(&time_ms);
+    bytes += test_frame.len;
+  }
+  test_invalid_frames();
+  test_to_centi();
+
+  /* a typical sample of the previous text format */
+  json_len = snprintf(json, sizeof(json), "{\"time\": \"%d\",\"dbm\": \"%d\",\"temperature\": \"%f\",\"humidity\": \"%f\"}",
+                      14039, -79, 28.322449, 43.508064);
+  (void)printf("%lu samples in %lu frames of %u bytes max: %.1f bytes/sample (JSON text: %d bytes/sample)\n",
+               (unsigned long)samples, (unsigned long)TEST_FRAMES_NB, CUSTOM_CLIENT_FRAME_MAX_SIZE,
+               (double)bytes / (double)samples, json_len);
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
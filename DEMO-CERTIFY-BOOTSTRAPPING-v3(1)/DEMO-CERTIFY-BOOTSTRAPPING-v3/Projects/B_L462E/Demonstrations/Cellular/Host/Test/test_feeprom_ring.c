@@ -0,0 +1,304 @@
+/**
+  ******************************************************************************
+  * @file    test_feeprom_ring.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test of the flash ring of feeprom_ring.c on a RAM flash mapped
+  *          at the target flash address: records are kept across resets, a
+  *          record interrupted by a reset is ignored, the oldest page is
+  *          erased when the ring is full, append and read from two threads.
+  * @note    The RAM flash follows the STM32L4 rules: a page is erased to 0xFF,
+  *          only an erased double-word can be programmed.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "rtosal.h"
+#include "feeprom_utils.h"
+#include "feeprom_ring.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_FLASH_BASE       (0x08000000U)
+#define TEST_FLASH_END        (TEST_FLASH_BASE + ((FLASH_LAST_PAGE_NUMBER + 1U) * FLASH_PAGE_SIZE))
+#define TEST_RING_SIZE        (FEEPROM_RING_PAGES * FLASH_PAGE_SIZE)
+#define TEST_RECORD_FLASH_SIZE(size) (24U + (((size) + 7U) & ~7U)) /* header + data padded to 8 bytes */
+#define TEST_THREAD_RECORDS   (3000U)
+#define TEST_THREAD_BACKLOG   (100U) /* records not consumed: far below the ring capacity */
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t test_write_fail_after; /* 0: no programming failure */
+static uint32_t test_flash_violations; /* programming of a not erased double-word */
+static uint32_t test_program_us;       /* programming time: the writer can be preempted in a record */
+static uint8_t  test_record[FEEPROM_RING_RECORD_MAX_SIZE];
+static osSemaphoreId test_writer_done;
+static volatile uint32_t test_reader_next; /* next record expected by the reader thread */
+
+/* Private functions ---------------------------------------------------------*/
+/* RAM flash: replaces the HAL based functions of feeprom_utils.c */
+uint32_t feeprom_utils_page_erase(uint32_t page_number)
+{
+  (void)memset((void *)(uintptr_t)(TEST_FLASH_BASE + (page_number * FLASH_PAGE_SIZE)), 0xFF, FLASH_PAGE_SIZE);
+
+  return 0U;
+}
+
+uint32_t feeprom_utils_page_write(uint8_t *data_addr, uint8_t *flash_addr, uint32_t length)
+{
+  uint32_t ret = 0U;
+  uint32_t i;
+  uint64_t dw;
+
+  HOST_TEST_CHECK((((uintptr_t)flash_addr % 8U) == 0U) && ((length % 8U) == 0U));
+  if (test_program_us != 0U)
+  {
+    (void)usleep(test_program_us);
+  }
+  if (test_write_fail_after != 0U)
+  {
+    test_write_fail_after--;
+    if (test_write_fail_after == 0U)
+    {
+      /* reset during programming: nothing written */
+      ret = 1U;
+    }
+  }
+  for (i = 0U; (ret == 0U) && (i < length); i += 8U)
+  {
+    (void)memcpy(&dw, &flash_addr[i], 8U);
+    if (dw != 0xFFFFFFFFFFFFFFFFU)
+    {
+      test_flash_violations++;
+      ret = 1U;
+    }
+    else
+    {
+      (void)memcpy(&flash_addr[i], &data_addr[i], 8U);
+    }
+  }
+
+  return ret;
+}
+
+static void test_fill(uint32_t seq, uint32_t size)
+{
+  uint32_t i;
+
+  (void)memcpy(test_record, &seq, sizeof(seq));
+  for (i = sizeof(seq); i < size; i++)
+  {
+    test_record[i] = (uint8_t)(seq + i);
+  }
+}
+
+/* Read the next record: its sequence number, 0xFFFFFFFF if ring is empty */
+static uint32_t test_read(bool consume)
+{
+  const uint8_t *p_data;
+  uint32_t size;
+  uint32_t seq = 0xFFFFFFFFU;
+  uint32_t i;
+
+  if (feeprom_ring_peek(&p_data, &size) == FEEPROM_RING_OK)
+  {
+    (void)memcpy(&seq, p_data, sizeof(seq));
+    for (i = sizeof(seq); i < size; i++)
+    {
+      if (p_data[i] != (uint8_t)(seq + i))
+      {
+        HOST_TEST_CHECK(p_data[i] == (uint8_t)(seq + i));
+        break;
+      }
+    }
+    if (consume == true)
+    {
+      HOST_TEST_CHECK(feeprom_ring_consume() == FEEPROM_RING_OK);
+    }
+  }
+
+  return seq;
+}
+
+static void test_reset(void)
+{
+  HOST_TEST_CHECK(feeprom_ring_init() == FEEPROM_RING_OK);
+}
+
+static void test_store_and_reset(void)
+{
+  uint32_t seq;
+
+  HOST_TEST_CHECK(feeprom_ring_init() == FEEPROM_RING_OK);
+  HOST_TEST_CHECK(test_read(false) == 0xFFFFFFFFU);
+  HOST_TEST_CHECK(feeprom_ring_append(test_record, 0U) == FEEPROM_RING_ERROR);
+  HOST_TEST_CHECK(feeprom_ring_append(test_record, FEEPROM_RING_RECORD_MAX_SIZE + 1U) == FEEPROM_RING_ERROR);
+  HOST_TEST_CHECK(feeprom_ring_consume() == FEEPROM_RING_ERROR);
+
+  /* sizes not multiple of 8, the last one fills a page */
+  for (seq = 0U; seq < 40U; seq++)
+  {
+    test_fill(seq, ((seq * 37U) % 500U) + 4U);
+    HOST_TEST_CHECK(feeprom_ring_append(test_record, ((seq * 37U) % 500U) + 4U) == FEEPROM_RING_OK);
+  }
+  test_fill(seq, FEEPROM_RING_RECORD_MAX_SIZE);
+  HOST_TEST_CHECK(feeprom_ring_append(test_record, FEEPROM_RING_RECORD_MAX_SIZE) == FEEPROM_RING_OK);
+  for (seq = 0U; seq < 10U; seq++)
+  {
+    HOST_TEST_CHECK(test_read(true) == seq);
+  }
+  /* peeked but not consumed: given again after a reset */
+  HOST_TEST_CHECK(test_read(false) == 10U);
+  test_reset();
+  for (seq = 10U; seq <= 40U; seq++)
+  {
+    HOST_TEST_CHECK(test_read(true) == seq);
+  }
+  HOST_TEST_CHECK(test_read(false) == 0xFFFFFFFFU);
+  test_reset();
+  HOST_TEST_CHECK(test_read(false) == 0xFFFFFFFFU);
+}
+
+static void test_interrupted(void)
+{
+  test_reset();
+  test_fill(100U, 64U);
+  HOST_TEST_CHECK(feeprom_ring_append(test_record, 64U) == FEEPROM_RING_OK);
+  /* header written, reset during the data: record never committed */
+  test_fill(101U, 300U);
+  test_write_fail_after = 2U;
+  HOST_TEST_CHECK(feeprom_ring_append(test_record, 300U) == FEEPROM_RING_ERROR);
+  test_write_fail_after = 0U;
+  test_reset();
+  test_fill(102U, 64U);
+  HOST_TEST_CHECK(feeprom_ring_append(test_record, 64U) == FEEPROM_RING_OK);
+  HOST_TEST_CHECK(test_read(true) == 100U);
+  HOST_TEST_CHECK(test_read(true) == 102U);
+  HOST_TEST_CHECK(test_read(false) == 0xFFFFFFFFU);
+}
+
+static void test_full(void)
+{
+  feeprom_ring_stat_t stat;
+  uint32_t seq;
+  uint32_t first;
+  uint32_t expected;
+  uint32_t total = 4U * TEST_RING_SIZE / TEST_RECORD_FLASH_SIZE(100U);
+
+  test_reset();
+  for (seq = 0U; seq < total; seq++)
+  {
+    test_fill(seq, 100U);
+    HOST_TEST_CHECK(feeprom_ring_append(test_record, 100U) == FEEPROM_RING_OK);
+  }
+  feeprom_ring_get_stat(&stat);
+  /* the oldest records are lost, the others are read in order */
+  first = test_read(false);
+  HOST_TEST_CHECK((first > 0U) && (first < total));
+  HOST_TEST_CHECK(stat.records_lost == first);
+  expected = first;
+  while ((seq = test_read(true)) != 0xFFFFFFFFU)
+  {
+    HOST_TEST_CHECK(seq == expected);
+    expected++;
+  }
+  HOST_TEST_CHECK(expected == total);
+  /* pages are used in turn: 4 ring sizes written, each page erased 4 or 5 times */
+  HOST_TEST_CHECK((stat.page_erases >= (4U * FEEPROM_RING_PAGES)) && (stat.page_erases <= (5U * FEEPROM_RING_PAGES)));
+  (void)printf("%lu records of 100 bytes: %lu lost, %lu page erases\n", (unsigned long)total,
+               (unsigned long)stat.records_lost, (unsigned long)stat.page_erases);
+}
+
+static void test_writer(void const *p_arg)
+{
+  static uint8_t record[256];
+  uint32_t seq;
+  uint32_t size;
+  uint32_t i;
+
+  (void)p_arg;
+  for (seq = 0U; seq < TEST_THREAD_RECORDS; seq++)
+  {
+    while ((seq - test_reader_next) >= TEST_THREAD_BACKLOG)
+    {
+      (void)rtosalDelay(1U);
+    }
+    size = 4U + (seq % 200U);
+    (void)memcpy(record, &seq, sizeof(seq));
+    for (i = sizeof(seq); i < size; i++)
+    {
+      record[i] = (uint8_t)(seq + i);
+    }
+    HOST_TEST_CHECK(feeprom_ring_append(record, size) == FEEPROM_RING_OK);
+  }
+  (void)rtosalSemaphoreRelease(test_writer_done);
+}
+
+static void test_threads(void)
+{
+  feeprom_ring_stat_t stat;
+  uint32_t expected = 0U;
+  uint32_t seq;
+  bool writer_done = false;
+
+  test_reset();
+  test_program_us = 20U;
+  test_writer_done = rtosalSemaphoreNew(NULL, 1U);
+  HOST_TEST_CHECK(rtosalSemaphoreAcquire(test_writer_done, 0U) == osOK);
+  HOST_TEST_CHECK(rtosalThreadNew((const rtosal_char_t *)"TestWriter", test_writer, osPriorityNormal, 1024U, NULL)
+                  != NULL);
+  /* a record read while it is written must not be skipped */
+  seq = 0U;
+  while ((writer_done == false) || (seq != 0xFFFFFFFFU))
+  {
+    seq = test_read(true);
+    if (seq == 0xFFFFFFFFU)
+    {
+      writer_done = (rtosalSemaphoreAcquire(test_writer_done, 1U) == osOK);
+    }
+    else
+    {
+      HOST_TEST_CHECK(seq == expected);
+      expected = seq + 1U;
+      test_reader_next = expected;
+    }
+  }
+  test_program_us = 0U;
+  feeprom_ring_get_stat(&stat);
+  HOST_TEST_CHECK(expected == TEST_THREAD_RECORDS);
+  HOST_TEST_CHECK((stat.records_stored == TEST_THREAD_RECORDS) && (stat.records_consumed == TEST_THREAD_RECORDS)
+                  && (stat.records_lost == 0U));
+}
+
+int main(void)
+{
+  void *p_flash;
+
+  /* the ring pages are at their target address: map the whole target flash */
+  p_flash = mmap((void *)(uintptr_t)TEST_FLASH_BASE, TEST_FLASH_END - TEST_FLASH_BASE, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+  HOST_TEST_CHECK(p_flash == (void *)(uintptr_t)TEST_FLASH_BASE);
+  if (p_flash == (void *)(uintptr_t)TEST_FLASH_BASE)
+  {
+    HOST_TEST_CHECK((FEEPROM_RING_FIRST_PAGE_ADDR + TEST_RING_SIZE) <= TEST_FLASH_END);
+    /* unknown content before the first init */
+    (void)memset((void *)(uintptr_t)FEEPROM_RING_FIRST_PAGE_ADDR, 0xA5, TEST_RING_SIZE);
+
+    (void)rtosalKernelInitialize();
+    (void)rtosalKernelStart();
+
+    test_store_and_reset();
+    test_interrupted();
+    test_full();
+    test_threads();
+    HOST_TEST_CHECK(test_flash_violations == 0U);
+  }
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,232 @@
+/**
+  ******************************************************************************
+  * @file    test_ipc_sim_throughput.c
+  * @author  artworkTrackingMAP
+  * @brief   End-to-end host test of the cellular stack with the Type1SC modem
+  *          simulated by ipc_sim.c: boot, network registration, then TCP echo
+  *          through com_send/com_recv; throughput and round-trip latency are
+  *          printed for each payload size, first with the simulator echo then
+  *          with the simulator bridged to an echo server on the local host.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "rtosal.h"
+#include "dc_common.h"
+#include "cellular_datacache.h"
+#include "cellular_mngt.h"
+#include "com_sockets.h"
+#include "ipc_sim.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_ATTACH_TIMEOUT   (30000U) /* in ms */
+#define TEST_RCV_TIMEOUT      (5000U)  /* in ms */
+#define TEST_ECHO_PORT        (7U)     /* no local server: simulator echo */
+#define TEST_ROUNDS_NB        (8U)
+#define TEST_MAX_SIZE         (1460U)
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t test_tx[TEST_MAX_SIZE];
+static uint8_t test_rx[TEST_MAX_SIZE];
+static int test_server_fd;
+static uint32_t test_server_bytes; /* bytes echoed by the local host server */
+
+/* Private functions ---------------------------------------------------------*/
+static bool test_wait_network(void)
+{
+  dc_nifman_info_t nifman_info;
+  uint32_t waited = 0U;
+  bool up = false;
+
+  while ((up == false) && (waited < TEST_ATTACH_TIMEOUT))
+  {
+    (void)dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+    if (nifman_info.rt_state == DC_SERVICE_ON)
+    {
+      up = true;
+    }
+    else
+    {
+      (void)rtosalDelay(10U);
+      waited += 10U;
+    }
+  }
+  (void)printf("network up after %lu ms\n", (unsigned long)waited);
+
+  return (up);
+}
+
+/* Local host echo server: one connection, closed when the client closes */
+static void *test_server(void *p_arg)
+{
+  static uint8_t buffer[TEST_MAX_SIZE];
+  ssize_t received;
+  int fd;
+
+  (void)p_arg;
+  fd = accept(test_server_fd, NULL, NULL);
+  HOST_TEST_CHECK(fd >= 0);
+  do
+  {
+    received = recv(fd, buffer, sizeof(buffer), 0);
+    if (received > 0)
+    {
+      HOST_TEST_CHECK(send(fd, buffer, (size_t)received, MSG_NOSIGNAL) == received);
+      test_server_bytes += (uint32_t)received;
+    }
+  } while (received > 0);
+  (void)close(fd);
+
+  return (NULL);
+}
+
+static uint16_t test_server_start(pthread_t *p_thread)
+{
+  struct sockaddr_in address;
+  socklen_t len = (socklen_t)sizeof(address);
+
+  test_server_fd = socket(AF_INET, SOCK_STREAM, 0);
+  (void)memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0U; /* any free port */
+  HOST_TEST_CHECK(bind(test_server_fd, (struct sockaddr *)&address, len) == 0);
+  HOST_TEST_CHECK(listen(test_server_fd, 1) == 0);
+  HOST_TEST_CHECK(getsockname(test_server_fd, (struct sockaddr *)&address, &len) == 0);
+  HOST_TEST_CHECK(pthread_create(p_thread, NULL, test_server, NULL) == 0);
+
+  return (ntohs(address.sin_port));
+}
+
+static int32_t test_open(uint16_t port)
+{
+  com_sockaddr_in_t address;
+  com_ip_addr_t remote_ip;
+  uint32_t timeout = TEST_RCV_TIMEOUT;
+  int32_t sock;
+
+  sock = com_socket(COM_AF_INET, COM_SOCK_STREAM, COM_IPPROTO_TCP);
+  HOST_TEST_CHECK(sock >= 0);
+  HOST_TEST_CHECK(com_setsockopt(sock, COM_SOL_SOCKET, COM_SO_RCVTIMEO, &timeout, (int32_t)sizeof(timeout))
+                  == COM_SOCKETS_ERR_OK);
+  (void)memset(&address, 0, sizeof(address));
+  address.sin_family = (uint8_t)COM_AF_INET;
+  address.sin_port   = COM_HTONS(port);
+  COM_IP4_ADDR(&remote_ip, 10U, 0U, 0U, 1U); /* IPC_SIM_REMOTE_IP_ADDR */
+  address.sin_addr.s_addr = remote_ip.addr;
+  HOST_TEST_CHECK(com_connect(sock, (com_sockaddr_t const *)&address, (int32_t)sizeof(com_sockaddr_in_t))
+                  == COM_SOCKETS_ERR_OK);
+
+  return (sock);
+}
+
+/* Send size bytes and read the echo: returns the round trip time in ms */
+static uint32_t test_round_trip(int32_t sock, uint16_t size)
+{
+  uint32_t start = rtosalGetSysTimerCount();
+  int32_t received = 0;
+  int32_t ret;
+
+  HOST_TEST_CHECK(com_send(sock, (const com_char_t *)test_tx, (int32_t)size, COM_MSG_WAIT) == (int32_t)size);
+  while (received < (int32_t)size)
+  {
+    ret = com_recv(sock, (com_char_t *)&test_rx[received], (int32_t)size - received, COM_MSG_WAIT);
+    HOST_TEST_CHECK(ret > 0);
+    if (ret <= 0)
+    {
+      break;
+    }
+    received += ret;
+  }
+  HOST_TEST_CHECK(memcmp(test_rx, test_tx, size) == 0);
+
+  return (rtosalGetSysTimerCount() - start);
+}
+
+static void test_throughput(int32_t sock, uint16_t size)
+{
+  uint32_t total = 0U;
+  uint32_t worst = 0U;
+  uint32_t rtt;
+  uint32_t i;
+
+  for (i = 0U; i < TEST_ROUNDS_NB; i++)
+  {
+    test_tx[0] = (uint8_t)i;
+    rtt = test_round_trip(sock, size);
+    total += rtt;
+    worst = (rtt > worst) ? rtt : worst;
+  }
+  (void)printf("%4u bytes: round trip avg %lu ms max %lu ms, %.1f kbit/s each way\n", size,
+               (unsigned long)(total / TEST_ROUNDS_NB), (unsigned long)worst,
+               (8.0 * size * TEST_ROUNDS_NB) / (double)((total != 0U) ? total : 1U));
+}
+
+int main(void)
+{
+  dc_cellular_params_t cellular_params;
+  IPC_SIM_Statistics_t stats;
+  pthread_t server;
+  uint16_t port;
+  int32_t sock;
+  uint32_t i;
+
+  for (i = 0U; i < TEST_MAX_SIZE; i++)
+  {
+    test_tx[i] = (uint8_t)(i * 7U);
+  }
+
+  /* main() thread plays the target default task */
+  (void)rtosalKernelInitialize();
+  (void)rtosalKernelStart();
+
+  cellular_init();
+  /* what the Setup module does on target with USE_DEFAULT_SETUP */
+  (void)dc_com_read(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_set_default_setup_config(&cellular_params);
+  (void)dc_com_write(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_start();
+
+  HOST_TEST_CHECK(test_wait_network() == true);
+  if (HOST_TEST_RESULT() == 0)
+  {
+    (void)printf("simulator echo (network latency %u ms)\n", IPC_SIM_NETWORK_LATENCY);
+    sock = test_open(TEST_ECHO_PORT);
+    test_throughput(sock, 16U);
+    test_throughput(sock, 256U);
+    test_throughput(sock, 710U);
+    test_throughput(sock, TEST_MAX_SIZE);
+    HOST_TEST_CHECK(com_closesocket(sock) == COM_SOCKETS_ERR_OK);
+
+    port = test_server_start(&server);
+    (void)printf("bridge to " IPC_SIM_BRIDGE_IP_ADDR ":%u\n", port);
+    sock = test_open(port);
+    test_throughput(sock, 16U);
+    test_throughput(sock, 710U);
+    test_throughput(sock, TEST_MAX_SIZE);
+    HOST_TEST_CHECK(com_closesocket(sock) == COM_SOCKETS_ERR_OK);
+    /* server sees the connection closed by the simulator */
+    HOST_TEST_CHECK(pthread_join(server, NULL) == 0);
+    (void)close(test_server_fd);
+    HOST_TEST_CHECK(test_server_bytes == (TEST_ROUNDS_NB * (16U + 710U + TEST_MAX_SIZE)));
+
+    IPC_SIM_getStatistics(&stats);
+    (void)printf("simulator: %lu AT commands, %lu bytes sent, %lu bytes read, %lu ms paused\n",
+                 (unsigned long)stats.cmd_count, (unsigned long)stats.tx_bytes, (unsigned long)stats.rx_bytes,
+                 (unsigned long)stats.paused_ms);
+    HOST_TEST_CHECK(stats.tx_bytes == stats.rx_bytes);
+  }
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,226 @@
+/**
+  ******************************************************************************
+  * @file    test_mems_sampler.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test of the mems sampler of dc_mems_sampler.c on its simulated
+  *          bus, the time given by the test: with the dc_mems.c periods the
+  *          sensors are read once per window as the former 10 s polling, a
+  *          late task reads once, batch reads are aggregated, and a series of
+  *          shocks ends at most one window per shock_window_min_ms.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+
+#include "dc_mems_sampler.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_PERIOD           (10000U)  /* dc_mems.c default window and sensor periods, in ms */
+#define TEST_RUN_TIME         (600000U) /* in ms */
+#define TEST_SHOCK_PERIOD     (100U)    /* accelerometer period with sensor events, in ms */
+#define TEST_SHOCK_WINDOW_MIN (2000U)   /* dc_mems.c default, in ms */
+#define TEST_SHOCK_TIME       (20000U)  /* in ms */
+#define TEST_SHOCK_MG         (2000.0f)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint32_t wakeups;
+  uint32_t reads;
+  uint32_t windows;
+  uint32_t shock_windows;
+  uint32_t duration_min;
+  uint32_t duration_max;
+} test_result_t;
+
+/* Private variables ---------------------------------------------------------*/
+static mems_sampler_t test_sampler;
+static mems_sampler_simu_t test_simu;
+static mems_sampler_window_t test_window;
+
+/* Private functions ---------------------------------------------------------*/
+static void test_config(mems_sampler_config_t *p_config, uint32_t motion_period, uint16_t batch_nb)
+{
+  (void)memset(p_config, 0, sizeof(mems_sampler_config_t));
+  for (uint8_t i = 0U; i < (uint8_t)MEMS_SAMPLER_SENSOR_NB; i++)
+  {
+    p_config->period_ms[i] = (i <= (uint8_t)MEMS_SAMPLER_MAGNETO) ? motion_period : TEST_PERIOD;
+    p_config->batch_nb[i] = batch_nb;
+  }
+  p_config->window_ms = TEST_PERIOD;
+  p_config->shock_threshold_mg = 500.0f;
+  p_config->shock_ends_window = true;
+  p_config->shock_window_min_ms = TEST_SHOCK_WINDOW_MIN;
+}
+
+/* Run the sampler as the mems task does, from start to end ms: shock on each accelerometer read if shock is set */
+static void test_run(uint32_t start, uint32_t end, bool shock, test_result_t *p_result)
+{
+  uint32_t now = start;
+
+  (void)memset(p_result, 0, sizeof(test_result_t));
+  p_result->duration_min = UINT32_MAX;
+  while (now < end)
+  {
+    if (shock == true)
+    {
+      mems_sampler_simu_shock(&test_simu, TEST_SHOCK_MG);
+    }
+    p_result->wakeups++;
+    now += mems_sampler_run(&test_sampler, now);
+    if (mems_sampler_window_get(&test_sampler, now, &test_window) == true)
+    {
+      p_result->windows++;
+      p_result->reads += test_window.read_nb;
+      p_result->shock_windows += (test_window.shock_nb != 0U) ? 1U : 0U;
+      p_result->duration_min = (test_window.duration_ms < p_result->duration_min) ? test_window.duration_ms
+                               : p_result->duration_min;
+      p_result->duration_max = (test_window.duration_ms > p_result->duration_max) ? test_window.duration_ms
+                               : p_result->duration_max;
+    }
+  }
+}
+
+/* dc_mems.c periods: one read of each sensor per window, one wake-up per window */
+static void test_cadence(void)
+{
+  mems_sampler_config_t config;
+  test_result_t result;
+  const mems_sampler_stat_t *p_stat;
+
+  test_config(&config, TEST_PERIOD, 1U);
+  mems_sampler_simu_init(&test_simu);
+  mems_sampler_init(&test_sampler, &config, mems_sampler_simu_read, &test_simu);
+  test_run(0U, TEST_RUN_TIME, false, &result);
+
+  (void)printf("%lu s: %lu sensor reads (%.2f per s), %lu wake-ups, %lu windows\n",
+               (unsigned long)(TEST_RUN_TIME / 1000U), (unsigned long)result.reads,
+               (double)result.reads * 1000.0 / (double)TEST_RUN_TIME, (unsigned long)result.wakeups,
+               (unsigned long)result.windows);
+  HOST_TEST_CHECK(result.windows == (TEST_RUN_TIME / TEST_PERIOD));
+  HOST_TEST_CHECK(result.reads == (result.windows * (uint32_t)MEMS_SAMPLER_SENSOR_NB));
+  HOST_TEST_CHECK(result.wakeups == result.windows);
+  HOST_TEST_CHECK((result.duration_min == TEST_PERIOD) && (result.duration_max == TEST_PERIOD));
+  HOST_TEST_CHECK((test_window.shock_nb == 0U) && (test_window.start_ms == (TEST_RUN_TIME - TEST_PERIOD)));
+  for (uint8_t i = 0U; i < (uint8_t)MEMS_SAMPLER_SENSOR_NB; i++)
+  {
+    p_stat = &test_window.stat[i];
+    HOST_TEST_CHECK((p_stat->nb == 1U) && (p_stat->min[0] == p_stat->max[0]) && (p_stat->mean[0] == p_stat->last[0]));
+  }
+  /* simulated pressure stays in 1000 +/- 7 hPa */
+  p_stat = &test_window.stat[MEMS_SAMPLER_PRESSURE];
+  HOST_TEST_CHECK((p_stat->mean[0] >= 993.0f) && (p_stat->mean[0] <= 1007.0f));
+}
+
+/* A task late by several periods reads each sensor once, without catch-up burst */
+static void test_late(void)
+{
+  mems_sampler_config_t config;
+  uint32_t delay;
+
+  test_config(&config, TEST_PERIOD, 1U);
+  mems_sampler_simu_init(&test_simu);
+  mems_sampler_init(&test_sampler, &config, mems_sampler_simu_read, &test_simu);
+  HOST_TEST_CHECK(mems_sampler_run(&test_sampler, 0U) == TEST_PERIOD);
+  HOST_TEST_CHECK(mems_sampler_window_get(&test_sampler, 0U, &test_window) == false);
+
+  delay = mems_sampler_run(&test_sampler, 3U * TEST_PERIOD + 10U);
+  HOST_TEST_CHECK(delay == 0U);
+  HOST_TEST_CHECK(mems_sampler_window_get(&test_sampler, 3U * TEST_PERIOD + 10U, &test_window) == true);
+  HOST_TEST_CHECK((test_window.read_nb == (2U * (uint16_t)MEMS_SAMPLER_SENSOR_NB))
+                  && (test_window.duration_ms == (3U * TEST_PERIOD + 10U)));
+  HOST_TEST_CHECK(mems_sampler_run(&test_sampler, 3U * TEST_PERIOD + 10U) == TEST_PERIOD);
+
+  /* sensor event: read at the next run, then at its period */
+  mems_sampler_request(&test_sampler, MEMS_SAMPLER_ACCELERO, 3U * TEST_PERIOD + 500U);
+  HOST_TEST_CHECK(mems_sampler_run(&test_sampler, 3U * TEST_PERIOD + 500U) == (TEST_PERIOD - 490U));
+  HOST_TEST_CHECK(mems_sampler_window_get(&test_sampler, 4U * TEST_PERIOD + 10U, &test_window) == true);
+  HOST_TEST_CHECK((test_window.read_nb == 1U) && (test_window.stat[MEMS_SAMPLER_ACCELERO].nb == 1U));
+}
+
+/* Motion sensors with a FIFO: max batch_nb samples per read */
+static void test_batch(void)
+{
+  mems_sampler_config_t config;
+  const mems_sampler_stat_t *p_stat;
+  uint32_t now = 0U;
+
+  test_config(&config, TEST_PERIOD, (uint16_t)MEMS_SAMPLER_BATCH_MAX);
+  mems_sampler_simu_init(&test_simu);
+  mems_sampler_init(&test_sampler, &config, mems_sampler_simu_read, &test_simu);
+  while (mems_sampler_window_get(&test_sampler, now, &test_window) == false)
+  {
+    now += mems_sampler_run(&test_sampler, now);
+  }
+  HOST_TEST_CHECK(test_window.read_nb == (uint16_t)MEMS_SAMPLER_SENSOR_NB);
+  for (uint8_t i = 0U; i < (uint8_t)MEMS_SAMPLER_SENSOR_NB; i++)
+  {
+    p_stat = &test_window.stat[i];
+    HOST_TEST_CHECK(p_stat->nb == ((i <= (uint8_t)MEMS_SAMPLER_MAGNETO) ? (uint16_t)MEMS_SAMPLER_BATCH_MAX : 1U));
+  }
+  /* simulated motion noise: 0, 1, 2, 3 on X, -X on Y */
+  p_stat = &test_window.stat[MEMS_SAMPLER_GYRO];
+  HOST_TEST_CHECK((p_stat->min[0] == 0.0f) && (p_stat->max[0] == 3.0f) && (p_stat->mean[0] == 1.5f));
+  HOST_TEST_CHECK((p_stat->min[1] == -3.0f) && (p_stat->max[1] == 0.0f) && (p_stat->mean[1] == -1.5f));
+  p_stat = &test_window.stat[MEMS_SAMPLER_ACCELERO];
+  HOST_TEST_CHECK((p_stat->min[2] >= 1000.0f) && (p_stat->max[2] <= 1003.0f) && (test_window.shock_nb == 0U));
+}
+
+/* A shock ends the window once it has lasted shock_window_min_ms */
+static void test_shock(void)
+{
+  mems_sampler_config_t config;
+  test_result_t result;
+  uint32_t now = 0U;
+
+  test_config(&config, TEST_SHOCK_PERIOD, 1U);
+  mems_sampler_simu_init(&test_simu);
+  mems_sampler_init(&test_sampler, &config, mems_sampler_simu_read, &test_simu);
+
+  /* one shock at 500 ms: window ended at 2000 ms, the task is woken up for it */
+  while (now < 500U)
+  {
+    now += mems_sampler_run(&test_sampler, now);
+    HOST_TEST_CHECK(mems_sampler_window_get(&test_sampler, now, &test_window) == false);
+  }
+  mems_sampler_simu_shock(&test_simu, TEST_SHOCK_MG);
+  (void)mems_sampler_run(&test_sampler, now);
+  HOST_TEST_CHECK(mems_sampler_window_get(&test_sampler, now, &test_window) == false);
+  while (mems_sampler_window_get(&test_sampler, now, &test_window) == false)
+  {
+    now += mems_sampler_run(&test_sampler, now);
+  }
+  HOST_TEST_CHECK((now == TEST_SHOCK_WINDOW_MIN) && (test_window.duration_ms == TEST_SHOCK_WINDOW_MIN));
+  HOST_TEST_CHECK((test_window.shock_nb == 1U) && (test_window.shock_first_ms == 500U));
+  HOST_TEST_CHECK((test_window.shock_max_mg >= 1900.0f) && (test_window.shock_max_mg <= 2100.0f));
+
+  /* shock on each accelerometer read: one window per shock_window_min_ms */
+  test_run(now, now + TEST_SHOCK_TIME, true, &result);
+  (void)printf("shock every %lu ms during %lu s: %lu windows of %lu to %lu ms\n", (unsigned long)TEST_SHOCK_PERIOD,
+               (unsigned long)(TEST_SHOCK_TIME / 1000U), (unsigned long)result.windows,
+               (unsigned long)result.duration_min, (unsigned long)result.duration_max);
+  HOST_TEST_CHECK(result.windows == (TEST_SHOCK_TIME / TEST_SHOCK_WINDOW_MIN));
+  HOST_TEST_CHECK(result.shock_windows == result.windows);
+  HOST_TEST_CHECK((result.duration_min == TEST_SHOCK_WINDOW_MIN) && (result.duration_max == TEST_SHOCK_WINDOW_MIN));
+  HOST_TEST_CHECK(test_window.shock_nb == (TEST_SHOCK_WINDOW_MIN / TEST_SHOCK_PERIOD));
+
+  /* no shock: back to the window period */
+  now += TEST_SHOCK_TIME;
+  test_run(now, now + (3U * TEST_PERIOD), false, &result);
+  HOST_TEST_CHECK((result.windows >= 2U) && (result.shock_windows == 0U) && (result.duration_max == TEST_PERIOD));
+}
+
+int main(void)
+{
+  test_cadence();
+  test_late();
+  test_batch();
+  test_shock();
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
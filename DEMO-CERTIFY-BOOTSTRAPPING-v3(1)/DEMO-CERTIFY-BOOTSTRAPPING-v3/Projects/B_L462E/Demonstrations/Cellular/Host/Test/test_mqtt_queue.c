@@ -0,0 +1,158 @@
+/**
+  ******************************************************************************
+  * @file    test_mqtt_queue.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test of the mqtt-c message queue ring: QoS1 publishes of
+  *          varied sizes are packed, acknowledged in order a few at a time and
+  *          removed. A message in flight never moves and keeps its bytes while
+  *          the data and the mqtt_queued_message rings wrap, and mqtt_mq_find
+  *          finds it by packet id on both sides of the wrap.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mqtt.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_PUBLISH_NB       (20000U) /* per buffer size */
+#define TEST_PAYLOAD_MAX      (64U)
+#define TEST_FILLER_MAX       (40U)
+#define TEST_BUFFER_MAX       (16384U)
+
+/* Private variables ---------------------------------------------------------*/
+static const size_t test_buffer_sizes[] = { 512U, 2048U, 16384U };
+static uint8_t test_buffer[TEST_BUFFER_MAX];
+
+/* Private functions ---------------------------------------------------------*/
+/* Payload of the publish number k: "k|" then a filler of its own size and letter */
+static size_t test_payload(uint8_t *p_payload, uint32_t k)
+{
+  size_t size;
+  size_t filler = (size_t)rand() % TEST_FILLER_MAX;
+
+  size = (size_t)snprintf((char *)p_payload, TEST_PAYLOAD_MAX, "%lu|", (unsigned long)k);
+  (void)memset(&p_payload[size], (int)('a' + (k % 26U)), filler);
+
+  return (size + filler);
+}
+
+/* Check that the packed bytes of a queued message are still those of the publish number k */
+static bool test_message_intact(const struct mqtt_queued_message *p_msg, uint32_t k)
+{
+  const uint8_t *p_packet = p_msg->start;
+  size_t remaining = 0U;
+  size_t header = 1U;
+  size_t topic_size;
+  size_t payload_size;
+  const uint8_t *p_payload;
+  char *p_end;
+  bool intact;
+  size_t i;
+
+  do
+  {
+    remaining |= (size_t)(p_packet[header] & 0x7FU) << (7U * (header - 1U));
+    header++;
+  } while ((p_packet[header - 1U] & 0x80U) != 0U);
+  topic_size = ((size_t)p_packet[header] << 8) | p_packet[header + 1U];
+  p_payload = &p_packet[header + 2U + topic_size + 2U];
+  payload_size = remaining - (2U + topic_size + 2U);
+
+  intact = ((p_packet[0] >> 4) == (uint8_t)MQTT_CONTROL_PUBLISH) && ((header + remaining) == p_msg->size)
+           && (strtoul((const char *)p_payload, &p_end, 10) == k) && (*p_end == '|');
+  for (i = (size_t)(p_end + 1 - (const char *)p_payload); (i < payload_size) && intact; i++)
+  {
+    intact = (p_payload[i] == (uint8_t)('a' + (k % 26U)));
+  }
+
+  return (intact);
+}
+
+/* Publish through a queue of size bytes, at most a random number of messages in flight:
+   returns the number of times the queue was full */
+static uint32_t test_queue(size_t size)
+{
+  struct mqtt_message_queue mq;
+  struct mqtt_queued_message *p_msg;
+  uint8_t payload[TEST_PAYLOAD_MAX];
+  uint32_t acked = 0U;
+  uint32_t full = 0U;
+  uint32_t in_flight_max;
+  uint32_t k;
+  uint16_t packet_id;
+  ssize_t rv;
+
+  mqtt_mq_init(&mq, test_buffer, size);
+  for (k = 0U; k < TEST_PUBLISH_NB; k++)
+  {
+    packet_id = (uint16_t)((k % 0xFFFFU) + 1U);
+    rv = mqtt_pack_publish_request(mq.curr, mq.curr_sz, "Temperature", packet_id, payload, test_payload(payload, k),
+                                   (uint8_t)MQTT_PUBLISH_QOS_1);
+    while (rv == 0)
+    {
+      /* no room: remove the messages acknowledged, else wait for the oldest one */
+      mqtt_mq_clean(&mq);
+      rv = mqtt_pack_publish_request(mq.curr, mq.curr_sz, "Temperature", packet_id, payload,
+                                     test_payload(payload, k), (uint8_t)MQTT_PUBLISH_QOS_1);
+      if ((rv == 0) && (acked < k))
+      {
+        full++;
+        packet_id = (uint16_t)((acked % 0xFFFFU) + 1U);
+        p_msg = mqtt_mq_find(&mq, MQTT_CONTROL_PUBLISH, &packet_id);
+        HOST_TEST_CHECK((p_msg != NULL) && (test_message_intact(p_msg, acked) == true));
+        p_msg->state = MQTT_QUEUED_COMPLETE;
+        acked++;
+        packet_id = (uint16_t)((k % 0xFFFFU) + 1U);
+      }
+    }
+    HOST_TEST_CHECK(rv > 0);
+    p_msg = mqtt_mq_register(&mq, (size_t)rv);
+    p_msg->control_type = MQTT_CONTROL_PUBLISH;
+    p_msg->packet_id = packet_id;
+    p_msg->state = MQTT_QUEUED_AWAITING_ACK;
+
+    /* PUBACK of the oldest messages, in order */
+    in_flight_max = ((uint32_t)rand() % 16U) + 1U;
+    while ((k + 1U - acked) > in_flight_max)
+    {
+      packet_id = (uint16_t)((acked % 0xFFFFU) + 1U);
+      p_msg = mqtt_mq_find(&mq, MQTT_CONTROL_PUBLISH, &packet_id);
+      HOST_TEST_CHECK((p_msg != NULL) && (test_message_intact(p_msg, acked) == true));
+      if (p_msg == NULL)
+      {
+        return (full);
+      }
+      p_msg->state = MQTT_QUEUED_COMPLETE;
+      acked++;
+    }
+    mqtt_mq_clean(&mq);
+    HOST_TEST_CHECK(mqtt_mq_length(&mq) == (ssize_t)(k + 1U - acked));
+    /* the first message left is the oldest not acknowledged */
+    HOST_TEST_CHECK(test_message_intact(mqtt_mq_get(&mq, 0), acked) == true);
+  }
+
+  return (full);
+}
+
+int main(void)
+{
+  uint32_t full;
+  uint32_t i;
+
+  srand(1U);
+  for (i = 0U; i < (sizeof(test_buffer_sizes) / sizeof(test_buffer_sizes[0])); i++)
+  {
+    full = test_queue(test_buffer_sizes[i]);
+    (void)printf("%5lu bytes queue: %lu publishes acknowledged in order, %lu waits for a PUBACK\n",
+                 (unsigned long)test_buffer_sizes[i], (unsigned long)TEST_PUBLISH_NB, (unsigned long)full);
+  }
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,301 @@
+/**
+  ******************************************************************************
+  * @file    test_mqtt_send.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test of the gathered sends of mqtt-c __mqtt_send with the
+  *          simulated Type1SC modem bridged to a broker on the local host:
+  *          the humidity, temperature and pressure messages of a publish
+  *          cycle reach the broker in order, in one %SOCKETDATA="SEND"
+  *          transaction. AT transactions and time per cycle are printed, and
+  *          compared with one send per message as before the gathering.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "rtosal.h"
+#include "dc_common.h"
+#include "cellular_datacache.h"
+#include "cellular_mngt.h"
+#include "com_sockets.h"
+#include "ipc_sim.h"
+#include "mqtt.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_ATTACH_TIMEOUT   (30000U) /* in ms */
+#define TEST_CYCLES_NB        (20U)    /* per send mode */
+#define TEST_TOPICS_NB        (3U)
+#define TEST_PAYLOAD_SIZE     (24U)
+#define TEST_PACKET_SIZE      (64U)
+#define TEST_BUFFER_SIZE      (1024U)
+
+/* Private variables ---------------------------------------------------------*/
+static const char *const test_topics[TEST_TOPICS_NB] = { "Humidity", "Temperature", "Pressure" };
+
+static int test_server_fd;
+static uint32_t test_broker_publish;   /* PUBLISH received by the broker */
+static uint32_t test_broker_unordered; /* PUBLISH not in the topic order */
+
+static struct mqtt_client test_client; /* static: the PAL creates its mutex when the handle is still 0 */
+static struct mqtt_client test_client; /* static: the PAL creates its mutex when the handle is still 0 */
+static uint8_t test_sendbuf[TEST_BUFFER_SIZE];
+static uint8_t test_recvbuf[TEST_BUFFER_SIZE];
+
+/* Private functions ---------------------------------------------------------*/
+static bool test_wait_network(void)
+{
+  dc_nifman_info_t nifman_info;
+  uint32_t waited = 0U;
+  bool up = false;
+
+  while ((up == false) && (waited < TEST_ATTACH_TIMEOUT))
+  {
+    (void)dc_com_read(&dc_com_db, DC_CELLULAR_NIFMAN_INFO, (void *)&nifman_info, sizeof(nifman_info));
+    if (nifman_info.rt_state == DC_SERVICE_ON)
+    {
+      up = true;
+    }
+    else
+    {
+      (void)rtosalDelay(10U);
+      waited += 10U;
+    }
+  }
+
+  return (up);
+}
+
+/* Read one MQTT packet: returns its type, 0 when the connection is closed */
+static uint8_t test_broker_read(int fd, uint8_t *p_packet, uint32_t *p_size)
+{
+  uint32_t remaining = 0U;
+  uint32_t shift = 0U;
+  uint8_t header;
+  uint8_t byte;
+
+  if (recv(fd, &header, 1U, MSG_WAITALL) != 1)
+  {
+    return (0U);
+  }
+  do
+  {
+    if (recv(fd, &byte, 1U, MSG_WAITALL) != 1)
+    {
+      return (0U);
+    }
+    remaining |= (uint32_t)(byte & 0x7FU) << shift;
+    shift += 7U;
+  } while ((byte & 0x80U) != 0U);
+  HOST_TEST_CHECK(remaining <= TEST_BUFFER_SIZE);
+  if ((remaining > TEST_BUFFER_SIZE)
+      || ((remaining != 0U) && (recv(fd, p_packet, remaining, MSG_WAITALL) != (ssize_t)remaining)))
+  {
+    return (0U);
+  }
+  *p_size = remaining;
+
+  return (header >> 4);
+}
+
+/* Local host broker: accepts the CONNECT, then checks the PUBLISH order until the client disconnects */
+static void *test_broker(void *p_arg)
+{
+  static const uint8_t connack[] = { 0x20U, 0x02U, 0x00U, 0x00U };
+  static uint8_t packet[TEST_BUFFER_SIZE];
+  uint32_t size;
+  uint32_t topic_size;
+  uint8_t type;
+  int fd;
+
+  (void)p_arg;
+  fd = accept(test_server_fd, NULL, NULL);
+  HOST_TEST_CHECK(fd >= 0);
+  HOST_TEST_CHECK(test_broker_read(fd, packet, &size) == (uint8_t)MQTT_CONTROL_CONNECT);
+  HOST_TEST_CHECK(send(fd, connack, sizeof(connack), MSG_NOSIGNAL) == (ssize_t)sizeof(connack));
+  do
+  {
+    type = test_broker_read(fd, packet, &size);
+    if (type == (uint8_t)MQTT_CONTROL_PUBLISH)
+    {
+      topic_size = ((uint32_t)packet[0] << 8) | packet[1];
+      if ((topic_size != strlen(test_topics[test_broker_publish % TEST_TOPICS_NB]))
+          || (memcmp(&packet[2], test_topics[test_broker_publish % TEST_TOPICS_NB], topic_size) != 0))
+      {
+        test_broker_unordered++;
+      }
+      test_broker_publish++;
+    }
+  } while ((type != 0U) && (type != (uint8_t)MQTT_CONTROL_DISCONNECT));
+  (void)close(fd);
+
+  return (NULL);
+}
+
+static uint16_t test_broker_start(pthread_t *p_thread)
+{
+  struct sockaddr_in address;
+  socklen_t len = (socklen_t)sizeof(address);
+
+  test_server_fd = socket(AF_INET, SOCK_STREAM, 0);
+  (void)memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0U; /* any free port */
+  HOST_TEST_CHECK(bind(test_server_fd, (struct sockaddr *)&address, len) == 0);
+  HOST_TEST_CHECK(listen(test_server_fd, 1) == 0);
+  HOST_TEST_CHECK(getsockname(test_server_fd, (struct sockaddr *)&address, &len) == 0);
+  HOST_TEST_CHECK(pthread_create(p_thread, NULL, test_broker, NULL) == 0);
+
+  return (ntohs(address.sin_port));
+}
+
+static int32_t test_open(uint16_t port)
+{
+  com_sockaddr_in_t address;
+  com_ip_addr_t remote_ip;
+  int32_t sock;
+
+  sock = com_socket(COM_AF_INET, COM_SOCK_STREAM, COM_IPPROTO_TCP);
+  HOST_TEST_CHECK(sock >= 0);
+  (void)memset(&address, 0, sizeof(address));
+  address.sin_family = (uint8_t)COM_AF_INET;
+  address.sin_port   = COM_HTONS(port);
+  COM_IP4_ADDR(&remote_ip, 10U, 0U, 0U, 1U); /* IPC_SIM_REMOTE_IP_ADDR */
+  address.sin_addr.s_addr = remote_ip.addr;
+  HOST_TEST_CHECK(com_connect(sock, (com_sockaddr_t const *)&address, (int32_t)sizeof(com_sockaddr_in_t))
+                  == COM_SOCKETS_ERR_OK);
+
+  return (sock);
+}
+
+static void test_publish_response(void **p_state, struct mqtt_response_publish *p_publish)
+{
+  UNUSED(p_state);
+  UNUSED(p_publish);
+}
+
+/* Sensor values of a publish cycle */
+static void test_payload(uint8_t *p_payload, uint32_t cycle, uint32_t topic)
+{
+  (void)memset(p_payload, 0, TEST_PAYLOAD_SIZE);
+  (void)snprintf((char *)p_payload, TEST_PAYLOAD_SIZE, "%lu.%02lu", (unsigned long)(cycle + (10U * topic)),
+                 (unsigned long)(cycle % 100U));
+}
+
+/* Publish cycles with mqtt-c: the queued messages are sent by mqtt_sync - returns the time in ms */
+static uint32_t test_cycles_gathered(struct mqtt_client *p_client)
+{
+  uint8_t payload[TEST_PAYLOAD_SIZE];
+  uint32_t start = rtosalGetSysTimerCount();
+  uint32_t cycle;
+  uint32_t topic;
+
+  for (cycle = 0U; cycle < TEST_CYCLES_NB; cycle++)
+  {
+    for (topic = 0U; topic < TEST_TOPICS_NB; topic++)
+    {
+      test_payload(payload, cycle, topic);
+      HOST_TEST_CHECK(mqtt_publish(p_client, test_topics[topic], payload, TEST_PAYLOAD_SIZE,
+                                   (uint8_t)MQTT_PUBLISH_QOS_0) == MQTT_OK);
+    }
+    HOST_TEST_CHECK(mqtt_sync(p_client) == MQTT_OK);
+  }
+
+  return (rtosalGetSysTimerCount() - start);
+}
+
+/* Same publish cycles, one socket write per message as __mqtt_send did before - returns the time in ms */
+static uint32_t test_cycles_per_message(int32_t sock)
+{
+  uint8_t payload[TEST_PAYLOAD_SIZE];
+  uint8_t packet[TEST_PACKET_SIZE];
+  uint32_t start = rtosalGetSysTimerCount();
+  ssize_t size;
+  uint32_t cycle;
+  uint32_t topic;
+
+  for (cycle = 0U; cycle < TEST_CYCLES_NB; cycle++)
+  {
+    for (topic = 0U; topic < TEST_TOPICS_NB; topic++)
+    {
+      test_payload(payload, cycle, topic);
+      size = mqtt_pack_publish_request(packet, sizeof(packet), test_topics[topic], 0U, payload, TEST_PAYLOAD_SIZE,
+                                       (uint8_t)MQTT_PUBLISH_QOS_0);
+      HOST_TEST_CHECK(size > 0);
+      HOST_TEST_CHECK(mqtt_pal_sendall(sock, packet, (size_t)size, 0) == size);
+    }
+  }
+
+  return (rtosalGetSysTimerCount() - start);
+}
+
+int main(void)
+{
+  dc_cellular_params_t cellular_params;
+  IPC_SIM_Statistics_t before;
+  IPC_SIM_Statistics_t after;
+  pthread_t broker;
+  uint32_t sends_gathered;
+  uint32_t sends_per_message;
+  uint32_t ms_gathered;
+  uint32_t ms_per_message;
+  int32_t sock;
+
+  (void)rtosalKernelInitialize();
+  (void)rtosalKernelStart();
+
+  cellular_init();
+  (void)dc_com_read(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_set_default_setup_config(&cellular_params);
+  (void)dc_com_write(&dc_com_db, DC_CELLULAR_CONFIG, (void *)&cellular_params, sizeof(cellular_params));
+  cellular_start();
+
+  HOST_TEST_CHECK(test_wait_network() == true);
+  if (HOST_TEST_RESULT() == 0)
+  {
+    sock = test_open(test_broker_start(&broker));
+    HOST_TEST_CHECK(mqtt_init(&test_client, sock, test_sendbuf, sizeof(test_sendbuf), test_recvbuf, sizeof(test_recvbuf),
+                              test_publish_response) == MQTT_OK);
+    /* MQTT_PAL_TIME is in ms on this PAL: the longest keep alive sends no PINGREQ within a publish cycle */
+    HOST_TEST_CHECK(mqtt_connect(&test_client, "test_mqtt_send", NULL, NULL, 0U, NULL, NULL,
+                                 (uint8_t)MQTT_CONNECT_CLEAN_SESSION, 0xFFFFU) == MQTT_OK);
+    HOST_TEST_CHECK(mqtt_sync(&test_client) == MQTT_OK);
+
+    IPC_SIM_getStatistics(&before);
+    ms_gathered = test_cycles_gathered(&test_client);
+    IPC_SIM_getStatistics(&after);
+    sends_gathered = after.tx_count - before.tx_count;
+
+    IPC_SIM_getStatistics(&before);
+    ms_per_message = test_cycles_per_message(sock);
+    IPC_SIM_getStatistics(&after);
+    sends_per_message = after.tx_count - before.tx_count;
+
+    HOST_TEST_CHECK(mqtt_disconnect(&test_client) == MQTT_OK);
+    HOST_TEST_CHECK(mqtt_sync(&test_client) == MQTT_OK);
+    HOST_TEST_CHECK(pthread_join(broker, NULL) == 0);
+    (void)close(test_server_fd);
+    HOST_TEST_CHECK(com_closesocket(sock) == COM_SOCKETS_ERR_OK);
+
+    (void)printf("%u messages per publish cycle: %.2f -> %.2f AT sends, %.1f -> %.1f ms per cycle\n",
+                 TEST_TOPICS_NB, (double)sends_per_message / (double)TEST_CYCLES_NB,
+                 (double)sends_gathered / (double)TEST_CYCLES_NB,
+                 (double)ms_per_message / (double)TEST_CYCLES_NB, (double)ms_gathered / (double)TEST_CYCLES_NB);
+    HOST_TEST_CHECK(test_broker_publish == (2U * TEST_CYCLES_NB * TEST_TOPICS_NB));
+    HOST_TEST_CHECK(test_broker_unordered == 0U);
+    HOST_TEST_CHECK(sends_gathered == TEST_CYCLES_NB);
+    HOST_TEST_CHECK(sends_per_message == (TEST_CYCLES_NB * TEST_TOPICS_NB));
+  }
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
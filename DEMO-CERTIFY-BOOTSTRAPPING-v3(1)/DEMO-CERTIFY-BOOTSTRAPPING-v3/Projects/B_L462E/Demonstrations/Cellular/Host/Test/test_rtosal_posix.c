@@ -0,0 +1,132 @@
+/**
+  ******************************************************************************
+  * @file    test_rtosal_posix.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test of rtosal_posix.c: thread objects are released when the
+  *          thread function returns, timers deleted from any thread while
+  *          they fire are never accessed after release (run with ASan).
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "rtosal.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_THREADS_NB   (64U)
+#define TEST_TIMERS_NB    (32U)
+#define TEST_LOOPS_NB     (50U)
+
+/* Private variables ---------------------------------------------------------*/
+static osSemaphoreId test_thread_done;
+static volatile uint32_t test_timer_calls;
+static osMessageQId test_queue; /* rtosal has no queue deletion */
+
+/* Private functions ---------------------------------------------------------*/
+static void test_thread(void const *p_arg)
+{
+  (void)p_arg;
+  (void)rtosalSemaphoreRelease(test_thread_done);
+}
+
+static void test_timer(void const *p_arg)
+{
+  (void)p_arg;
+  __atomic_add_fetch(&test_timer_calls, 1U, __ATOMIC_RELAXED);
+}
+
+static void test_threads(void)
+{
+  uint32_t i;
+
+  test_thread_done = rtosalSemaphoreNew(NULL, TEST_THREADS_NB);
+  HOST_TEST_CHECK(test_thread_done != NULL);
+  for (i = 0U; i < TEST_THREADS_NB; i++)
+  {
+    HOST_TEST_CHECK(rtosalSemaphoreAcquire(test_thread_done, 0U) == osOK);
+  }
+  /* Threads end by returning: their objects must be released (LeakSanitizer) */
+  for (i = 0U; i < TEST_THREADS_NB; i++)
+  {
+    HOST_TEST_CHECK(rtosalThreadNew((const rtosal_char_t *)"TestThreadName", test_thread,
+                                    osPriorityNormal, 256U, NULL) != NULL);
+  }
+  for (i = 0U; i < TEST_THREADS_NB; i++)
+  {
+    HOST_TEST_CHECK(rtosalSemaphoreAcquire(test_thread_done, 1000U) == osOK);
+  }
+  /* Let the last threads exit */
+  (void)rtosalDelay(50U);
+  (void)rtosalSemaphoreDelete(test_thread_done);
+}
+
+static void test_timers(void)
+{
+  osTimerId timers[TEST_TIMERS_NB];
+  uint32_t calls;
+  uint32_t loop;
+  uint32_t i;
+
+  for (loop = 0U; loop < TEST_LOOPS_NB; loop++)
+  {
+    for (i = 0U; i < TEST_TIMERS_NB; i++)
+    {
+      timers[i] = rtosalTimerNew(NULL, test_timer, osTimerPeriodic, NULL);
+      HOST_TEST_CHECK(timers[i] != NULL);
+      HOST_TEST_CHECK(rtosalTimerStart(timers[i], 1U) == osOK);
+    }
+    (void)rtosalDelay(2U);
+    /* Deleted while expirations are pending in the daemon */
+    for (i = 0U; i < TEST_TIMERS_NB; i++)
+    {
+      HOST_TEST_CHECK(rtosalTimerDelete(timers[i]) == osOK);
+    }
+  }
+  HOST_TEST_CHECK(test_timer_calls != 0U);
+
+  /* No callback once deleted */
+  (void)rtosalDelay(10U);
+  calls = test_timer_calls;
+  (void)rtosalDelay(20U);
+  HOST_TEST_CHECK(calls == test_timer_calls);
+}
+
+static void test_sync(void)
+{
+  osMutexId mutex = rtosalMutexNew(NULL);
+  uint32_t msg = 0U;
+  uint32_t start;
+
+  HOST_TEST_CHECK(rtosalMutexAcquire(mutex, RTOSAL_WAIT_FOREVER) == osOK);
+  start = rtosalGetSysTimerCount();
+  HOST_TEST_CHECK(rtosalMutexAcquire(mutex, 20U) == osErrorOS);
+  HOST_TEST_CHECK((rtosalGetSysTimerCount() - start) >= 20U);
+  HOST_TEST_CHECK(rtosalMutexRelease(mutex) == osOK);
+  HOST_TEST_CHECK(rtosalMutexDelete(mutex) == osOK);
+
+  test_queue = rtosalMessageQueueNew(NULL, 2U);
+  HOST_TEST_CHECK(rtosalMessageQueuePut(test_queue, 1U, 0U) == osOK);
+  HOST_TEST_CHECK(rtosalMessageQueuePut(test_queue, 2U, 0U) == osOK);
+  HOST_TEST_CHECK(rtosalMessageQueuePut(test_queue, 3U, 0U) == osErrorOS);
+  HOST_TEST_CHECK(rtosalMessageQueueGet(test_queue, &msg, 0U) == osEventMessage);
+  HOST_TEST_CHECK(msg == 1U);
+  HOST_TEST_CHECK(rtosalMessageQueueGet(test_queue, &msg, 0U) == osEventMessage);
+  HOST_TEST_CHECK(msg == 2U);
+  HOST_TEST_CHECK(rtosalMessageQueueGet(test_queue, &msg, 10U) == osEventTimeout);
+}
+
+int main(void)
+{
+  (void)rtosalKernelInitialize();
+  (void)rtosalKernelStart();
+
+  test_sync();
+  test_threads();
+  test_timers();
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
@@ -0,0 +1,161 @@
+/**
+  ******************************************************************************
+  * @file    test_trace_ring.c
+  * @author  artworkTrackingMAP
+  * @brief   Host test of the deferred UART traces of trace_interface.c:
+  *          several threads trace on the same channel, the output of the
+  *          trace thread must contain each trace entire, in order for each
+  *          thread, and the traces not received must be reported as dropped.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "rtosal.h"
+#include "trace_interface.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_PRODUCERS_NB     (4U)
+#define TEST_TRACES_NB        (20000U) /* per producer */
+#define TEST_TRACE_SIZE       (12U)    /* "[t0 000000]\n" */
+#define TEST_DROP_FORMAT      "\r\n<%lu traces dropped on channel %u>\r\n"
+
+/* Private variables ---------------------------------------------------------*/
+static osSemaphoreId test_done;
+
+/* Private functions ---------------------------------------------------------*/
+static void test_producer(void const *p_arg)
+{
+  uint8_t trace[32];
+  uint32_t id = (uint32_t)(uintptr_t)p_arg;
+  uint32_t seq;
+
+  for (seq = 0U; seq < TEST_TRACES_NB; seq++)
+  {
+    (void)snprintf((char *)trace, sizeof(trace), "[t%lu %06lu]\n", (unsigned long)id, (unsigned long)seq);
+    traceIF_uartPrint((uint8_t)DBG_CHAN_TEST, (uint8_t)DBL_LVL_P0, trace, (uint16_t)TEST_TRACE_SIZE);
+    if ((seq % 8U) == 7U)
+    {
+      /* let the trace thread drain the ring */
+      (void)rtosalDelay(1U);
+    }
+  }
+  (void)rtosalSemaphoreRelease(test_done);
+}
+
+/* Check the output of the trace thread: returns the number of traces received */
+static uint32_t test_check_output(const char *p_out, size_t size, uint32_t *p_dropped)
+{
+  long next[TEST_PRODUCERS_NB] = { 0 };
+  unsigned long id;
+  unsigned long seq;
+  unsigned long dropped;
+  unsigned int channel;
+  uint32_t received = 0U;
+  uint32_t corrupted = 0U;
+  size_t pos = 0U;
+  int len;
+  char end;
+
+  *p_dropped = 0U;
+  while (pos < size)
+  {
+    len = 0;
+    if (((size - pos) >= TEST_TRACE_SIZE)
+        && (sscanf(&p_out[pos], "[t%1lu %6lu]%c%n", &id, &seq, &end, &len) == 3)
+        && (len == (int)TEST_TRACE_SIZE) && (end == '\n') && (id < TEST_PRODUCERS_NB) && ((long)seq >= next[id]))
+    {
+      next[id] = (long)seq + 1;
+      received++;
+      pos += TEST_TRACE_SIZE;
+    }
+    else if ((sscanf(&p_out[pos], TEST_DROP_FORMAT "%n", &dropped, &channel, &len) == 2) && (len != 0)
+             && (channel == (unsigned int)DBG_CHAN_TEST))
+    {
+      *p_dropped += (uint32_t)dropped;
+      pos += (size_t)len;
+    }
+    else
+    {
+      /* mixed or cut trace: skip the line */
+      corrupted++;
+      while ((pos < size) && (p_out[pos] != '\n'))
+      {
+        pos++;
+      }
+      pos++;
+    }
+  }
+  HOST_TEST_CHECK(corrupted == 0U);
+
+  return (received);
+}
+
+int main(void)
+{
+  FILE *p_file;
+  char *p_out;
+  long size;
+  int saved_stdout;
+  uint32_t received;
+  uint32_t dropped;
+  uint32_t i;
+
+  /* trace UART is stdout: captured in a file */
+  p_file = tmpfile();
+  HOST_TEST_CHECK(p_file != NULL);
+  (void)fflush(stdout);
+  saved_stdout = dup(STDOUT_FILENO);
+  (void)dup2(fileno(p_file), STDOUT_FILENO);
+
+  (void)rtosalKernelInitialize();
+  (void)rtosalKernelStart();
+  traceIF_init();
+  traceIF_start();
+
+  test_done = rtosalSemaphoreNew(NULL, TEST_PRODUCERS_NB);
+  for (i = 0U; i < TEST_PRODUCERS_NB; i++)
+  {
+    (void)rtosalSemaphoreAcquire(test_done, 0U);
+  }
+  for (i = 0U; i < TEST_PRODUCERS_NB; i++)
+  {
+    (void)rtosalThreadNew((const rtosal_char_t *)"TestProducer", test_producer, osPriorityNormal, 1024U,
+                          (void *)(uintptr_t)i);
+  }
+  for (i = 0U; i < TEST_PRODUCERS_NB; i++)
+  {
+    (void)rtosalSemaphoreAcquire(test_done, RTOSAL_WAIT_FOREVER);
+  }
+  /* last traces and drop report sent by the trace thread */
+  (void)rtosalDelay(200U);
+
+  (void)fflush(stdout);
+  (void)dup2(saved_stdout, STDOUT_FILENO);
+  size = ftell(p_file);
+  p_out = (char *)malloc((size_t)size + 1U);
+  HOST_TEST_CHECK((size > 0) && (p_out != NULL));
+  if ((size > 0) && (p_out != NULL))
+  {
+    (void)fseek(p_file, 0L, SEEK_SET);
+    HOST_TEST_CHECK(fread(p_out, 1U, (size_t)size, p_file) == (size_t)size);
+    p_out[size] = '\0';
+
+    received = test_check_output(p_out, (size_t)size, &dropped);
+    (void)printf("%lu producers: %lu traces received, %lu dropped\n", (unsigned long)TEST_PRODUCERS_NB,
+                 (unsigned long)received, (unsigned long)dropped);
+    HOST_TEST_CHECK((received + dropped) == (TEST_PRODUCERS_NB * TEST_TRACES_NB));
+    HOST_TEST_CHECK(received != 0U);
+    free(p_out);
+  }
+  (void)fclose(p_file);
+
+  return (HOST_TEST_RESULT());
+}
+
+/******************************** END OF FILE *********************************/
@@ -176,6 +176,16 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+#if ((USE_STACK_ANALYSIS == 1) && (STACK_ANALYSIS_SAMPLER_PERIOD != 0U))
+/* Run time statistics: CPU load of each thread computed by the stack analysis sampler */
+#define configGENERATE_RUN_TIME_STATS            1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() stackAnalysis_runtime_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()         stackAnalysis_runtime_get()
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void stackAnalysis_runtime_init(void);
+uint32_t stackAnalysis_runtime_get(void);
+#endif /* (__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__) */
+#endif /* (USE_STACK_ANALYSIS == 1) && (STACK_ANALYSIS_SAMPLER_PERIOD != 0U) */
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
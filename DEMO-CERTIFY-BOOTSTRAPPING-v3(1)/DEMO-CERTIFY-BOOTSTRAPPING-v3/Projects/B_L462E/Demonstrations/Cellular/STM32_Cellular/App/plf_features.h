@@ -157,6 +157,11 @@ extern "C" {
 #define USE_CMD_CONSOLE            (1) /* 0: not activated, 1: activated */
 #endif /* !defined USE_CMD_CONSOLE */
 
+/* To record the timings of the AT commands in RAM (dump with the "atrec" console command) */
+#if !defined USE_AT_RECORDER
+#define USE_AT_RECORDER            (0) /* 0: not activated, 1: activated */
+#endif /* !defined USE_AT_RECORDER */
+
 #if !defined USE_DEFAULT_SETUP
 #define USE_DEFAULT_SETUP          (0) /* 0: Use setup menu,
                                           1: Use default parameters, no setup menu */
@@ -181,6 +186,13 @@ extern "C" {
 */
 #define STACK_ANALYSIS_TIMER       (0U) /* default configuration: no thread stack display every x ms */
 #endif /* !defined STACK_ANALYSIS_TIMER */
+#if !defined STACK_ANALYSIS_SAMPLER_PERIOD
+/* Period of the task sampler: CPU load, stack and heap usage of each thread
+   published in the Data Cache (DC_COM_TASK_STAT entry)
+   unit is ms - must be less than 50000 (wrap of the DWT cycle counter at 80MHz)
+   value 0U means sampler not activated */
+#define STACK_ANALYSIS_SAMPLER_PERIOD (0U) /* default configuration: no sampler */
+#endif /* !defined STACK_ANALYSIS_SAMPLER_PERIOD */
 #endif /* USE_STACK_ANALYSIS == 1 */
 /* End Stack analysis tools configuration */
 
@@ -197,6 +209,11 @@ extern "C" {
 #define USE_LINK_UART              (0) /* 0: not activated, 1: activated */
 #endif /* !defined USE_LINK_UART */
 
+/* use a simulated modem instead of the modem UART (throughput tests without SIM nor network) */
+#if !defined USE_MODEM_SIMULATOR
+#define USE_MODEM_SIMULATOR        (0) /* 0: not activated, 1: activated */
+#endif /* !defined USE_MODEM_SIMULATOR */
+
 /* ======================================= */
 /* END   -  Miscellaneous functionalities  */
 /* ======================================= */
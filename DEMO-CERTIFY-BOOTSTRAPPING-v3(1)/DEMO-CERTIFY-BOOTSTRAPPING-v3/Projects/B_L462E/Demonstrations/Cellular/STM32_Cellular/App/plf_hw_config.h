@@ -114,11 +114,19 @@ extern "C" {
 #define MODEM_UART_INSTANCE     USART3
 #define MODEM_UART_AUTOBAUD     (0)
 #define MODEM_UART_IRQN         USART3_IRQn
+#define MODEM_UART_DMA_RX_CHANNEL     DMA1_Channel3 /* used if IPC_USE_UART_DMA == 1 */
+#define MODEM_UART_DMA_RX_REQUEST     DMA_REQUEST_2
+#define MODEM_UART_DMA_RX_IRQN        DMA1_Channel3_IRQn
+#define MODEM_UART_DMA_RX_IRQHANDLER  DMA1_Channel3_IRQHandler
 #else /* HW_SETUP == USE_NUCLEO_64 */
 #define MODEM_UART_HANDLE       huart2
 #define MODEM_UART_INSTANCE     USART2
 #define MODEM_UART_AUTOBAUD     (0)
 #define MODEM_UART_IRQN         USART2_IRQn
+#define MODEM_UART_DMA_RX_CHANNEL     DMA1_Channel6 /* used if IPC_USE_UART_DMA == 1 */
+#define MODEM_UART_DMA_RX_REQUEST     DMA_REQUEST_2
+#define MODEM_UART_DMA_RX_IRQN        DMA1_Channel6_IRQn
+#define MODEM_UART_DMA_RX_IRQHANDLER  DMA1_Channel6_IRQHandler
 #endif /* HW_SETUP == USE_DISCO_L462 */
 
 #define MODEM_UART_BAUDRATE     (CONFIG_MODEM_UART_BAUDRATE)
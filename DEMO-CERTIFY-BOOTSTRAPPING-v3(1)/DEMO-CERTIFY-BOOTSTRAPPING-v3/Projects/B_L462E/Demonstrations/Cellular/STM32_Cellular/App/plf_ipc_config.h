@@ -53,6 +53,48 @@ extern "C" {
 #define IPC_USE_SPI  (0U) /* SPI NOT SUPPORTED YET */
 #define IPC_USE_I2C  (0U) /* I2C NOT SUPPORTED YET */
 
+/* UART reception mode
+ * 0: one interrupt per char received
+ * 1: circular DMA + idle line detection, chars are written by blocks in the RX FIFO.
+ *    Requires a modem whose end of message detection only depends on <CR> and <LF>
+ *    (socket data received in HEX format, as TYPE1SC).
+ */
+#if !defined IPC_USE_UART_DMA
+#define IPC_USE_UART_DMA        (0U)
+#endif /* !defined IPC_USE_UART_DMA */
+#define IPC_UART_DMA_RXBUF_SIZE ((uint16_t) 256U) /* DMA circular buffer size (per IPC device) */
+
+/* Modem simulator tuning parameters (used only if USE_MODEM_SIMULATOR == 1) */
+#if !defined IPC_SIM_BAUDRATE
+#define IPC_SIM_BAUDRATE            (115200U) /* simulated UART speed, 0: no speed limitation */
+#endif /* !defined IPC_SIM_BAUDRATE */
+#if !defined IPC_SIM_RESPONSE_LATENCY
+#define IPC_SIM_RESPONSE_LATENCY    (5U)      /* delay before answering an AT command (in ms) */
+#endif /* !defined IPC_SIM_RESPONSE_LATENCY */
+#if !defined IPC_SIM_NETWORK_LATENCY
+#define IPC_SIM_NETWORK_LATENCY     (50U)     /* delay before socket data sent is echoed back (in ms) */
+#endif /* !defined IPC_SIM_NETWORK_LATENCY */
+#if !defined IPC_SIM_LOSS_PER_MILLE
+#define IPC_SIM_LOSS_PER_MILLE      (0U)      /* socket packets dropped by the simulated network (per mille) */
+#endif /* !defined IPC_SIM_LOSS_PER_MILLE */
+#if !defined IPC_SIM_MAX_SOCKETS
+#define IPC_SIM_MAX_SOCKETS         (2U)      /* number of simulated modem sockets */
+#endif /* !defined IPC_SIM_MAX_SOCKETS */
+#if !defined IPC_SIM_SOCKET_RXBUF_SIZE
+#define IPC_SIM_SOCKET_RXBUF_SIZE   ((uint16_t) 1500U) /* echo buffer size per simulated socket */
+#endif /* !defined IPC_SIM_SOCKET_RXBUF_SIZE */
+#define IPC_SIM_CMD_MAXSIZE         ((uint16_t) ((2U * IPC_SIM_SOCKET_RXBUF_SIZE) + 128U)) /* hex encoded data */
+#define IPC_SIM_IP_ADDR_MAXSIZE     (40U)
+#define IPC_SIM_LOCAL_IP_ADDR       "10.0.0.2"
+#define IPC_SIM_REMOTE_IP_ADDR      "10.0.0.1"
+/* TCP bridge (POSIX host build only): a simulated socket is connected to the server listening on
+ * IPC_SIM_BRIDGE_IP_ADDR at the remote port requested; echo is used when no server listens there */
+#if !defined IPC_SIM_TCP_BRIDGE
+#define IPC_SIM_TCP_BRIDGE          (0U)      /* 0: echo only, 1: bridge to local host servers */
+#endif /* !defined IPC_SIM_TCP_BRIDGE */
+#define IPC_SIM_BRIDGE_IP_ADDR      "127.0.0.1"
+#define IPC_SIM_BRIDGE_POLL_PERIOD  (2U)      /* bridged sockets reception polling period (in ms) */
+
 /* Debug flags */
 #define DBG_IPC_RX_FIFO  (0U)             /* additional debug infos */
 #define DBG_QUEUE_SIZE ((uint16_t) 1000U) /* debug message history depth */
@@ -74,12 +74,32 @@ if COM_SOCKETS_STATISTIC_PERIOD != 0:
 sockets statistic displayed on command request
 and every COM_SOCKETS_STATISTIC_PERIOD value in min.
 */
+#if !defined COM_SOCKETS_STATISTIC_PERIOD
 #define COM_SOCKETS_STATISTIC_PERIOD (1U) /* in min. */
+#endif /* !defined COM_SOCKETS_STATISTIC_PERIOD */
+
+/* DNS cache of com_gethostbyname (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM):
+   number of host names kept (0: no cache) and minimum time an address is kept,
+   the modem does not provide the DNS TTL. Cache is flushed when the network is lost */
+#if !defined COM_DNS_CACHE_NB
+#define COM_DNS_CACHE_NB             (4U)
+#endif /* !defined COM_DNS_CACHE_NB */
+#if !defined COM_DNS_CACHE_TTL_MIN
+#define COM_DNS_CACHE_TTL_MIN        (300U) /* in s. */
+#endif /* !defined COM_DNS_CACHE_TTL_MIN */
+
+/* Receive read-ahead of a TCP socket (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM):
+   a com_recv smaller than this size reads up to this size from the modem and the next
+   com_recv are served from RAM - one buffer per modem socket (0: no read-ahead) */
+#if !defined COM_RCV_AHEAD_SIZE
+#define COM_RCV_AHEAD_SIZE           (512U)
+#endif /* !defined COM_RCV_AHEAD_SIZE */
 
 /* FLASH config mapping */
 #define FEEPROM_UTILS_FLASH_USED      (1)
 #define FEEPROM_UTILS_LAST_PAGE_ADDR  (FLASH_LAST_PAGE_ADDR)
 #define FEEPROM_UTILS_APPLI_MAX       5
+#define FEEPROM_RING_PAGES            (16U) /* flash pages below the FEEPROM_UTILS pages for feeprom_ring */
 
 /* behaviour at boot selection */
 #define USE_BOOT_BEHAVIOUR_CONFIG     0  /* 0: automatic boot - 1: boot behaviour selection by boot menu */
@@ -185,6 +205,17 @@ and every COM_SOCKETS_STATISTIC_PERIOD value in min.
 #define USE_TRACE_ERROR_HANDLER       (0U) /* DO NOT MODIFY THIS VALUE */
 #endif /* SW_DEBUG_VERSION*/
 
+/* UART traces are queued and sent by a low priority thread (1) or sent by the caller (0) */
+#if !defined TRACE_IF_DEFERRED
+#define TRACE_IF_DEFERRED             (1U)
+#endif /* !defined TRACE_IF_DEFERRED */
+
+/* Traces using TRACE_TOKEN (ATCore) are sent as format string ID + binary arguments (1)
+   decode them with Core/Trace/Utilities/trace_token_decode.py and the ELF file */
+#if !defined TRACE_IF_TOKENIZED
+#define TRACE_IF_TOKENIZED            (0U)
+#endif /* !defined TRACE_IF_TOKENIZED */
+
 /* ===================*/
 /* END - Trace flags  */
 /* ===================*/
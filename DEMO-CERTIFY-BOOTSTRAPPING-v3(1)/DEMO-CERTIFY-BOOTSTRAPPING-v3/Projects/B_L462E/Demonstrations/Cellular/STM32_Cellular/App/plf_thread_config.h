@@ -48,12 +48,18 @@ extern "C" {
 #define UICLIENT_THREAD_PRIO               osPriorityNormal
 #define CMD_THREAD_PRIO                    osPriorityBelowNormal
 #define MQTTCLIENT_THREAD_PRIO             osPriorityNormal
+#if (USE_MODEM_SIMULATOR == 1)
+#define IPC_SIM_THREAD_PRIO                osPriorityRealtime
+#endif /* (USE_MODEM_SIMULATOR == 1) */
 #if (USE_NETWORK_LIBRARY == 1)
 #define NET_CELLULAR_THREAD_PRIO           osPriorityAboveNormal
 #endif /* (USE_NETWORK_LIBRARY == 1) */
-#if ((USE_STACK_ANALYSIS == 1) && (STACK_ANALYSIS_TIMER != 0U))
+#if ((TRACE_IF_DEFERRED == 1U) && (TRACE_IF_TRACES_UART == 1U))
+#define TRACE_IF_THREAD_PRIO               osPriorityLow
+#endif /* (TRACE_IF_DEFERRED == 1U) && (TRACE_IF_TRACES_UART == 1U) */
+#if ((USE_STACK_ANALYSIS == 1) && ((STACK_ANALYSIS_TIMER != 0U) || (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)))
 #define STACK_ANALYSIS_THREAD_PRIO         osPriorityNormal
-#endif /* (USE_STACK_ANALYSIS == 1) && (STACK_ANALYSIS_TIMER != 0U) */
+#endif /* (USE_STACK_ANALYSIS == 1) && ((STACK_ANALYSIS_TIMER != 0U) || (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)) */
 
 /* ========================*/
 /* END - Stack Priority    */
@@ -137,9 +143,17 @@ extern "C" {
 #define NET_CELLULAR_BASE_THREAD_STACK_SIZE  DEFAULT_THREAD_STACK_SIZE
 #endif /* (USE_NETWORK_LIBRARY == 1) */
 
-#if ((USE_STACK_ANALYSIS == 1) && (STACK_ANALYSIS_TIMER != 0U))
+#if ((TRACE_IF_DEFERRED == 1U) && (TRACE_IF_TRACES_UART == 1U))
+#define TRACE_IF_THREAD_STACK_SIZE          (384U)
+#endif /* (TRACE_IF_DEFERRED == 1U) && (TRACE_IF_TRACES_UART == 1U) */
+
+#if ((USE_STACK_ANALYSIS == 1) && ((STACK_ANALYSIS_TIMER != 0U) || (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)))
 #define STACK_ANALYSIS_THREAD_STACK_SIZE    (384U)
-#endif /* (USE_STACK_ANALYSIS == 1) && (STACK_ANALYSIS_TIMER != 0U) */
+#endif /* (USE_STACK_ANALYSIS == 1) && ((STACK_ANALYSIS_TIMER != 0U) || (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)) */
+
+#if (USE_MODEM_SIMULATOR == 1)
+#define IPC_SIM_THREAD_STACK_SIZE           (384U)
+#endif /* (USE_MODEM_SIMULATOR == 1) */
 
 /* ========================*/
 /* END - Stack Size        */
@@ -258,13 +272,29 @@ extern "C" {
 #define USED_NET_CELLULAR_THREAD                 0
 #endif /* (USE_NETWORK_LIBRARY == 1) */
 
-#if ((USE_STACK_ANALYSIS == 1) && (STACK_ANALYSIS_TIMER != 0U))
+#if ((USE_STACK_ANALYSIS == 1) && ((STACK_ANALYSIS_TIMER != 0U) || (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)))
 #define USED_STACK_ANALYSIS_THREAD_STACK_SIZE    STACK_ANALYSIS_THREAD_STACK_SIZE
 #define USED_STACK_ANALYSIS_THREAD               1
 #else
 #define USED_STACK_ANALYSIS_THREAD_STACK_SIZE    0U
 #define USED_STACK_ANALYSIS_THREAD               0
-#endif /* (USE_STACK_ANALYSIS == 1) && (STACK_ANALYSIS_TIMER != 0U) */
+#endif /* (USE_STACK_ANALYSIS == 1) && ((STACK_ANALYSIS_TIMER != 0U) || (STACK_ANALYSIS_SAMPLER_PERIOD != 0U)) */
+
+#if ((TRACE_IF_DEFERRED == 1U) && (TRACE_IF_TRACES_UART == 1U))
+#define USED_TRACE_IF_THREAD_STACK_SIZE          TRACE_IF_THREAD_STACK_SIZE
+#define USED_TRACE_IF_THREAD                     1
+#else
+#define USED_TRACE_IF_THREAD_STACK_SIZE          0U
+#define USED_TRACE_IF_THREAD                     0
+#endif /* (TRACE_IF_DEFERRED == 1U) && (TRACE_IF_TRACES_UART == 1U) */
+
+#if (USE_MODEM_SIMULATOR == 1)
+#define USED_IPC_SIM_THREAD_STACK_SIZE           IPC_SIM_THREAD_STACK_SIZE
+#define USED_IPC_SIM_THREAD                      1
+#else
+#define USED_IPC_SIM_THREAD_STACK_SIZE           0U
+#define USED_IPC_SIM_THREAD                      0
+#endif /* (USE_MODEM_SIMULATOR == 1) */
 
 /* ============================================*/
 /* BEGIN - Total Stack Size/Number Calculation */
@@ -289,7 +319,9 @@ extern "C" {
            +USED_MQTTCLIENT_THREAD_STACK_SIZE           \
            +USED_UICLIENT_THREAD_STACK_SIZE             \
            +USED_NET_CELLULAR_THREAD_STACK_SIZE         \
-           +USED_STACK_ANALYSIS_THREAD_STACK_SIZE)
+           +USED_STACK_ANALYSIS_THREAD_STACK_SIZE       \
+           +USED_TRACE_IF_THREAD_STACK_SIZE             \
+           +USED_IPC_SIM_THREAD_STACK_SIZE)
 
 #define THREAD_NUMBER                \
   (uint8_t)(USED_TCPIP_THREAD        \
@@ -310,7 +342,9 @@ extern "C" {
             +USED_MQTTCLIENT_THREAD            \
             +USED_UICLIENT_THREAD              \
             +USED_NET_CELLULAR_THREAD          \
-            +USED_STACK_ANALYSIS_THREAD)
+            +USED_STACK_ANALYSIS_THREAD        \
+            +USED_TRACE_IF_THREAD              \
+            +USED_IPC_SIM_THREAD)
 
 #ifndef APPLICATION_HEAP_SIZE
 #define APPLICATION_HEAP_SIZE       (0U)
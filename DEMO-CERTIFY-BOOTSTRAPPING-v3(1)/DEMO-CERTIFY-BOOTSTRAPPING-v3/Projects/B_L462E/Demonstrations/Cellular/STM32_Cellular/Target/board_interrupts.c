@@ -92,6 +92,16 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
   }
 }
 
+#if (IPC_USE_UART_DMA == 1U)
+void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance == MODEM_UART_INSTANCE)
+  {
+    IPC_UART_RxHalfCpltCallback(huart);
+  }
+}
+#endif /* IPC_USE_UART_DMA == 1U */
+
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
   if (huart->Instance == MODEM_UART_INSTANCE)
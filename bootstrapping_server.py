@@ -9,7 +9,6 @@ import socket
 import time
 import threading
 import signal
-import re
 import struct
 from Device import Device
 from urllib.parse import urlparse
@@ -160,14 +159,13 @@ def start_tcp_data_server():
                         break
                     buffer += data
                     try:
-                        messages = re.split(r'(?<=\})', buffer.decode('utf-8'))
-                        print("messages: ")
-                        print(messages)
-                        process_json_message(messages)
-                        buffer = messages[-1].encode('utf-8')
-                    except UnicodeDecodeError:
-                        print("Received non-decodable bytes. Skipping.")
+                        data_points, buffer = decode_telemetry_stream(buffer)
+                    except ValueError as e:
+                        print("Invalid telemetry frame:", e)
                         buffer = b""
+                        continue
+                    if data_points:
+                        write_data_points(data_points)
 
 def start_tcp_mudlink_server():
     print("Starting TCP MUD link server...")
@@ -207,17 +205,83 @@ def start_tcp_mudlink_server():
                         conn.sendto(struct.pack('!H', ERROR_PORT), addr)
                         print(f"Sent port {ERROR_PORT} back to the sender {addr}.")
 
-def process_json_message(message):
+TELEMETRY_VERSION = 0x01
+TELEMETRY_HEADER_SIZE = 6
+TASK_STAT_FORMAT = 0x10
+
+# Frames sent by the Custom client, see custom_telemetry.h and stack_analysis_sampler.h
+def read_varint(buffer, offset):
+    value = 0
+    for i in range(5):
+        if offset + i >= len(buffer):
+            return None, offset
+        value |= (buffer[offset + i] & 0x7F) << (7 * i)
+        if buffer[offset + i] & 0x80 == 0:
+            return value, offset + i + 1
+    raise ValueError("varint longer than 5 bytes")
+
+def decode_telemetry_frame(buffer):
+    """Returns (samples, frame length), (None, 0) while the frame is incomplete."""
+    if len(buffer) < TELEMETRY_HEADER_SIZE:
+        return None, 0
+    count = buffer[1]
+    time_ms = struct.unpack_from('<I', buffer, 2)[0]
+    offset = TELEMETRY_HEADER_SIZE
+    samples = []
+    for _ in range(count):
+        delta, offset = read_varint(buffer, offset)
+        if delta is None or offset + 5 > len(buffer):
+            return None, 0
+        time_ms = (time_ms + delta) & 0xFFFFFFFF
+        temperature, humidity, dbm = struct.unpack_from('<hhb', buffer, offset)
+        offset += 5
+        samples.append({"time": str(time_ms), "dbm": str(dbm),
+                        "temperature": f"{temperature / 100:.2f}", "humidity": f"{humidity / 100:.2f}"})
+    return samples, offset
+
+def decode_task_stat_frame(buffer):
+    """Returns (statistics, frame length), (None, 0) while the frame is incomplete."""
+    if len(buffer) < TELEMETRY_HEADER_SIZE:
+        return None, 0
+    count = buffer[1]
+    stat = {"time": struct.unpack_from('<I', buffer, 2)[0], "threads": []}
+    offset = TELEMETRY_HEADER_SIZE
+    for field in ("heap_free", "heap_free_min", "cpu_permille"):
+        stat[field], offset = read_varint(buffer, offset)
+        if stat[field] is None:
+            return None, 0
+    for _ in range(count):
+        if offset + 5 > len(buffer):
+            return None, 0
+        thread = {"number": buffer[offset], "name": buffer[offset + 1:offset + 5].rstrip(b"\0").decode('ascii', 'replace')}
+        offset += 5
+        for field in ("cpu_permille", "stack_free_min", "stack_size"):
+            thread[field], offset = read_varint(buffer, offset)
+            if thread[field] is None:
+                return None, 0
+        stat["threads"].append(thread)
+    return stat, offset
+
+def decode_telemetry_stream(buffer):
+    """Decodes the complete frames of buffer: returns (samples, bytes left for the next recv)."""
     data_points = []
-    for msg in message:
-        try:
-            if msg == "":
-                continue
-            data_points.append(json.loads(msg))
-        except json.JSONDecodeError:
-            print("JSON decode error. Skipping message:", msg)
-            continue
-    print("Received message:", message)
+    while buffer:
+        if buffer[0] == TELEMETRY_VERSION:
+            samples, length = decode_telemetry_frame(buffer)
+            if samples is not None:
+                data_points.extend(samples)
+        elif buffer[0] == TASK_STAT_FORMAT:
+            stat, length = decode_task_stat_frame(buffer)
+            if stat is not None:
+                print("Task statistics:", stat)
+        else:
+            raise ValueError(f"unknown frame format 0x{buffer[0]:02x}")
+        if length == 0:
+            break
+        buffer = buffer[length:]
+    return data_points, buffer
+
+def write_data_points(data_points):
     print("Received data:", data_points)
     latest_time = int(data_points[-1]['time'])
     current_rtc = datetime.now()